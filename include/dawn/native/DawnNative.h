@@ -236,6 +236,22 @@ DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(
     uint32_t layerCount,
     WGPUTextureAspect aspect = WGPUTextureAspect_All);
 
+// Statistics of the staging buffers used by Queue::WriteBuffer and Queue::WriteTexture.
+struct DAWN_NATIVE_EXPORT UploadStagingStatistics {
+    // The number of staging buffers created and the number of large uploads that reused one.
+    uint64_t stagingBufferCreationCount = 0;
+    uint64_t stagingBufferReuseCount = 0;
+    // The size of the ring buffers used for small uploads.
+    uint64_t ringBufferSize = 0;
+    // The size of the large staging buffers kept for reuse.
+    uint64_t pooledSize = 0;
+};
+DAWN_NATIVE_EXPORT UploadStagingStatistics GetUploadStagingStatistics(WGPUDevice device);
+
+// Sets the maximum total size of the large staging buffers kept for reuse by uploads. Setting it
+// to 0 releases them as soon as the uploads using them are completed.
+DAWN_NATIVE_EXPORT void SetUploadStagingPoolLimit(WGPUDevice device, uint64_t limit);
+
 // Backdoor to get the order of the ProcMap for testing
 DAWN_NATIVE_EXPORT std::vector<const char*> GetProcMapNamesForTesting();
 
@@ -28,6 +28,69 @@ DAWN_NATIVE_EXPORT VkInstance GetInstance(WGPUDevice device);
 
 DAWN_NATIVE_EXPORT PFN_vkVoidFunction GetInstanceProcAddr(WGPUDevice device, const char* pName);
 
+// Returns the number of vkCmdPipelineBarrier recorded by the device so far.
+DAWN_NATIVE_EXPORT size_t GetPipelineBarrierCountForTesting(WGPUDevice device);
+
+// Statistics of the memory allocated by a device in one of the VkMemoryHeaps.
+struct DAWN_NATIVE_EXPORT MemoryHeapStatistics {
+    // VkDeviceMemory allocated for a single resource.
+    uint64_t directAllocationCount = 0;
+    uint64_t directAllocatedSize = 0;
+
+    // VkDeviceMemory allocated as blocks that resources are suballocated in.
+    uint64_t blockCount = 0;
+    uint64_t blockAllocatedSize = 0;
+
+    // The part of the blocks used by the suballocated resources, including the padding added by
+    // the suballocator. The rest of the blocks is free, possibly fragmented, space.
+    uint64_t subAllocationCount = 0;
+    uint64_t subAllocatedSize = 0;
+};
+
+// Returns the statistics of each of the VkMemoryHeaps of the device, in the same order as in
+// VkPhysicalDeviceMemoryProperties.
+DAWN_NATIVE_EXPORT std::vector<MemoryHeapStatistics> GetMemoryHeapStatistics(WGPUDevice device);
+
+// A pipeline of a CreatePipelinesBatchAsync call, with the arguments of the corresponding
+// CreateRenderPipelineAsync or CreateComputePipelineAsync call.
+struct DAWN_NATIVE_EXPORT RenderPipelineBatchEntry {
+    const WGPURenderPipelineDescriptor* descriptor = nullptr;
+    WGPUCreateRenderPipelineAsyncCallback callback = nullptr;
+    void* userdata = nullptr;
+};
+
+struct DAWN_NATIVE_EXPORT ComputePipelineBatchEntry {
+    const WGPUComputePipelineDescriptor* descriptor = nullptr;
+    WGPUCreateComputePipelineAsyncCallback callback = nullptr;
+    void* userdata = nullptr;
+};
+
+using PipelinesBatchDoneCallback = void (*)(void* userdata);
+
+struct DAWN_NATIVE_EXPORT PipelinesBatchDescriptor {
+    // Identifies the pipeline cache of the batch in the device's BlobCache. A batch starts from
+    // the pipeline cache stored by the previous batch with the same name, if any.
+    const char* cacheName = nullptr;
+
+    size_t renderPipelineCount = 0;
+    const RenderPipelineBatchEntry* renderPipelines = nullptr;
+    size_t computePipelineCount = 0;
+    const ComputePipelineBatchEntry* computePipelines = nullptr;
+
+    // Optional. Called once all the pipelines are compiled and the pipeline cache of the batch
+    // is stored in the BlobCache.
+    PipelinesBatchDoneCallback doneCallback = nullptr;
+    void* doneUserdata = nullptr;
+};
+
+// Creates all the pipelines of the batch asynchronously, like CreateRenderPipelineAsync and
+// CreateComputePipelineAsync do, with their compilations running concurrently on the worker
+// threads of the platform. Instead of a VkPipelineCache per pipeline, the compilations use a
+// few VkPipelineCaches that are merged once all the pipelines are compiled and stored as a
+// single blob in the BlobCache.
+DAWN_NATIVE_EXPORT void CreatePipelinesBatchAsync(WGPUDevice device,
+                                                  const PipelinesBatchDescriptor* descriptor);
+
 struct DAWN_NATIVE_EXPORT PhysicalDeviceDiscoveryOptions
     : public PhysicalDeviceDiscoveryOptionsBase {
     PhysicalDeviceDiscoveryOptions();
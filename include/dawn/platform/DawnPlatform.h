@@ -50,11 +50,23 @@ class DAWN_PLATFORM_EXPORT CachingInterface {
                            const void* value,
                            size_t valueSize) = 0;
 
+    // Returns true if LoadData and StoreData can be called concurrently from multiple threads.
+    // Dawn serializes the calls to caching interfaces that are not thread-safe.
+    virtual bool IsThreadSafe() const;
+
   private:
     CachingInterface(const CachingInterface&) = delete;
     CachingInterface& operator=(const CachingInterface&) = delete;
 };
 
+// Creates a thread-safe CachingInterface that persists its entries in files in |directory|, which
+// is created if it doesn't exist. The least recently used entries are evicted when the total size
+// of the entries exceeds |maxSizeInBytes|. Returns nullptr if the cache files can't be opened or
+// if file-backed caching isn't supported on the platform.
+DAWN_PLATFORM_EXPORT std::unique_ptr<CachingInterface> CreateFileCachingInterface(
+    const char* directory,
+    uint64_t maxSizeInBytes);
+
 class DAWN_PLATFORM_EXPORT WaitableEvent {
   public:
     WaitableEvent() = default;
@@ -0,0 +1,68 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
+#define INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
+
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::wire {
+
+class CommandCompressor;
+class CommandDecompressor;
+
+// Optional compression of the wire commands, for transports where bandwidth matters more than a
+// little CPU time. Each command is encoded relative to the previous command of the same type, so
+// that long runs of similar commands (like SetBindGroup and Draw in a render pass) only send the
+// object IDs and integers that changed, as small deltas.
+//
+// Compression is set up by wrapping the client's CommandSerializer in a
+// CompressingCommandSerializer, and the WireServer in a DecompressingCommandHandler that receives
+// the commands from the transport. The compressed stream starts with a header, so a decompressor
+// rejects commands that weren't compressed instead of misinterpreting them.
+
+class DAWN_WIRE_EXPORT CompressingCommandSerializer : public CommandSerializer {
+  public:
+    // |serializer| must outlive the CompressingCommandSerializer.
+    explicit CompressingCommandSerializer(CommandSerializer* serializer);
+    ~CompressingCommandSerializer() override;
+
+    // Commands are compressed when the next command is allocated or when flushing, so Flush()
+    // must be called on the CompressingCommandSerializer and not on the wrapped serializer.
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+    size_t GetMaximumAllocationSize() const override;
+    void OnSerializeError() override;
+
+  private:
+    std::unique_ptr<CommandCompressor> mImpl;
+};
+
+class DAWN_WIRE_EXPORT DecompressingCommandHandler : public CommandHandler {
+  public:
+    // |handler| must outlive the DecompressingCommandHandler.
+    explicit DecompressingCommandHandler(CommandHandler* handler);
+    ~DecompressingCommandHandler() override;
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override;
+
+  private:
+    std::unique_ptr<CommandDecompressor> mImpl;
+};
+
+}  // namespace dawn::wire
+
+#endif  // INCLUDE_DAWN_WIRE_WIRECOMPRESSION_H_
@@ -29,6 +29,7 @@
 #include "src/tint/lang/wgsl/ast/transform/substitute_override.h"
 #include "src/tint/lang/wgsl/ast/transform/vertex_pulling.h"
 #include "src/tint/lang/wgsl/helpers/flatten_bindings.h"
+#include "src/tint/lang/wgsl/helpers/split_entry_points.h"
 #include "src/tint/lang/wgsl/inspector/inspector.h"
 #include "src/tint/utils/diagnostic/formatter.h"
 #include "src/tint/utils/diagnostic/printer.h"
@@ -65,6 +66,15 @@
 #include "src/tint/lang/glsl/writer/writer.h"
 #endif  // TINT_BUILD_GLSL_WRITER
 
+#if TINT_BUILD_IR
+#include "src/tint/lang/core/ir/interpreter.h"
+#include "src/tint/lang/core/ir/module.h"
+#endif  // TINT_BUILD_IR
+
+#if TINT_BUILD_IR && TINT_BUILD_WGSL_READER
+#include "src/tint/lang/wgsl/reader/program_to_ir/program_to_ir.h"
+#endif  // TINT_BUILD_IR && TINT_BUILD_WGSL_READER
+
 namespace tint {
 
 /// Initialize initializes the Tint library. Call before using the Tint API.
@@ -15,42 +15,83 @@
 #ifndef SRC_DAWN_COMMON_CONCURRENTCACHE_H_
 #define SRC_DAWN_COMMON_CONCURRENTCACHE_H_
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <utility>
 
 #include "dawn/common/NonCopyable.h"
 
 namespace dawn {
+namespace detail {
 
+// Number of independently locked shards in the concurrent caches. Must be a power of two.
+static constexpr size_t kConcurrentCacheShardCount = 16;
+static_assert((kConcurrentCacheShardCount & (kConcurrentCacheShardCount - 1)) == 0);
+
+// Picks the shard of a value from its hash. The hash functions of cached types are often weak (for
+// example the identity of an integer), so the bits are mixed before selecting the shard. The top
+// bits of the product are used so that the shard doesn't correlate with the bucket that the
+// unordered_set of the shard picks from the low bits of the same hash.
+inline size_t GetConcurrentCacheShardIndex(size_t hash) {
+    uint64_t mixed = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+    return static_cast<size_t>(mixed >> 60) & (kConcurrentCacheShardCount - 1);
+}
+
+// A shard of a concurrent cache. Shards are aligned to distinct cache lines so that threads
+// operating on different shards don't contend on the same line.
+template <typename Set>
+struct alignas(64) ConcurrentCacheShard {
+    std::shared_mutex mutex;
+    Set set;
+};
+
+}  // namespace detail
+
+// A thread-safe set of objects, used to deduplicate objects. Entries are split across independently
+// locked shards selected by the hash of the object so that operations on different objects rarely
+// contend. Lookups only take a shared lock on their shard, so concurrent lookups of cached objects,
+// which is the common case, don't serialize.
 template <typename T>
 class ConcurrentCache : public NonMovable {
   public:
     ConcurrentCache() = default;
 
     T* Find(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto iter = mCache.find(object);
-        if (iter == mCache.end()) {
+        Shard& shard = GetShard(object);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto iter = shard.set.find(object);
+        if (iter == shard.set.end()) {
             return nullptr;
         }
         return *iter;
     }
 
     std::pair<T*, bool> Insert(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto [value, inserted] = mCache.insert(object);
+        Shard& shard = GetShard(object);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto [value, inserted] = shard.set.insert(object);
         return {*value, inserted};
     }
 
     size_t Erase(T* object) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.erase(object);
+        Shard& shard = GetShard(object);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.set.erase(object);
     }
 
   private:
-    std::mutex mMutex;
-    std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc> mCache;
+    using Shard = detail::ConcurrentCacheShard<
+        std::unordered_set<T*, typename T::HashFunc, typename T::EqualityFunc>>;
+
+    Shard& GetShard(const T* object) {
+        return mShards[detail::GetConcurrentCacheShardIndex(typename T::HashFunc()(object))];
+    }
+
+    std::array<Shard, detail::kConcurrentCacheShardCount> mShards;
 };
 
 }  // namespace dawn
@@ -15,13 +15,16 @@
 #ifndef SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 #define SRC_DAWN_COMMON_CONTENTLESSOBJECTCACHE_H_
 
+#include <array>
 #include <mutex>
+#include <shared_mutex>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <variant>
 
+#include "dawn/common/ConcurrentCache.h"
 #include "dawn/common/ContentLessObjectCacheable.h"
 #include "dawn/common/Ref.h"
 #include "dawn/common/RefCounted.h"
@@ -157,10 +160,11 @@ class ContentLessObjectCache {
     // inserted or existing object, and the second is a bool that is true if we inserted
     // `object` and false otherwise.
     std::pair<Ref<RefCountedT>, bool> Insert(RefCountedT* obj) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        detail::WeakRefAndHash<RefCountedT> weakref =
-            std::make_pair(GetWeakRef(obj), typename RefCountedT::HashFunc()(obj));
-        auto [it, inserted] = mCache.insert(weakref);
+        size_t hash = typename RefCountedT::HashFunc()(obj);
+        Shard& shard = GetShard(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        detail::WeakRefAndHash<RefCountedT> weakref = std::make_pair(GetWeakRef(obj), hash);
+        auto [it, inserted] = shard.set.insert(weakref);
         if (inserted) {
             obj->mCache = this;
             return {obj, inserted};
@@ -172,8 +176,8 @@ class ContentLessObjectCache {
             if (ref != nullptr) {
                 return {ref, false};
             } else {
-                mCache.erase(it);
-                auto result = mCache.insert(weakref);
+                shard.set.erase(it);
+                auto result = shard.set.insert(weakref);
                 ASSERT(result.second);
                 obj->mCache = this;
                 return {obj, true};
@@ -182,10 +186,14 @@ class ContentLessObjectCache {
     }
 
     // Returns a valid Ref<T> if we can Promote the underlying WeakRef. Returns nullptr otherwise.
+    // Lookups only take a shared lock so that concurrent lookups of cached objects don't
+    // serialize. Promoting the WeakRefs in the set is thread-safe since it only atomically
+    // increments the refcount of the objects.
     Ref<RefCountedT> Find(RefCountedT* blueprint) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto it = mCache.find(blueprint);
-        if (it != mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(blueprint));
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.set.find(blueprint);
+        if (it != shard.set.end()) {
             return std::get<detail::WeakRefAndHash<RefCountedT>>(*it).first.Promote();
         }
         return nullptr;
@@ -194,27 +202,39 @@ class ContentLessObjectCache {
     // Erases the object from the cache if it exists and are pointer equal. Otherwise does not
     // modify the cache.
     void Erase(RefCountedT* obj) {
-        std::lock_guard<std::mutex> lock(mMutex);
-        auto it = mCache.find(detail::ForErase<RefCountedT>(obj));
-        if (it == mCache.end()) {
+        Shard& shard = GetShard(typename RefCountedT::HashFunc()(obj));
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.set.find(detail::ForErase<RefCountedT>(obj));
+        if (it == shard.set.end()) {
             return;
         }
         obj->mCache = nullptr;
-        mCache.erase(it);
+        shard.set.erase(it);
     }
 
     // Returns true iff the cache is empty.
     bool Empty() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mCache.empty();
+        for (Shard& shard : mShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (!shard.set.empty()) {
+                return false;
+            }
+        }
+        return true;
     }
 
   private:
-    std::mutex mMutex;
-    std::unordered_set<detail::ContentLessObjectCacheKey<RefCountedT>,
-                       typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::HashFunc,
-                       typename detail::ContentLessObjectCacheKeyFuncs<RefCountedT>::EqualityFunc>
-        mCache;
+    // The entries are split across shards selected by their hash, each with its own lock, so that
+    // operations on unrelated objects don't contend on a single lock.
+    using KeyFuncs = detail::ContentLessObjectCacheKeyFuncs<RefCountedT>;
+    using Shard = detail::ConcurrentCacheShard<
+        std::unordered_set<detail::ContentLessObjectCacheKey<RefCountedT>,
+                           typename KeyFuncs::HashFunc,
+                           typename KeyFuncs::EqualityFunc>>;
+
+    Shard& GetShard(size_t hash) { return mShards[detail::GetConcurrentCacheShardIndex(hash)]; }
+
+    std::array<Shard, detail::kConcurrentCacheShardCount> mShards;
 };
 
 }  // namespace dawn
@@ -0,0 +1,245 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_COMMON_FLATPOINTERMAP_H_
+#define SRC_DAWN_COMMON_FLATPOINTERMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn {
+
+// FlatPointerMap is a map keyed by pointers that is made for the small, short-lived maps built
+// on hot paths, like the tracking of the resources used in a pass:
+//  - The entries are stored contiguously in insertion order, so iterating them is cheap and
+//    deterministic. There is no erasure of single entries.
+//  - The first InlineCapacity entries are stored inline, without heap allocations, and are looked
+//    up with a linear search.
+//  - Larger maps move their entries to the heap and look them up with an open-addressed table of
+//    entry indices using linear probing.
+//  - clear() keeps the heap allocations so that a map can be reused without allocations.
+template <typename Key, typename Value, size_t InlineCapacity = 8>
+class FlatPointerMap {
+    static_assert(InlineCapacity > 0);
+
+  public:
+    using value_type = std::pair<Key*, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    FlatPointerMap() = default;
+    FlatPointerMap(const FlatPointerMap&) = delete;
+    FlatPointerMap& operator=(const FlatPointerMap&) = delete;
+
+    FlatPointerMap(FlatPointerMap&& other) { MoveFrom(&other); }
+    FlatPointerMap& operator=(FlatPointerMap&& other) {
+        if (this != &other) {
+            Reset();
+            MoveFrom(&other);
+        }
+        return *this;
+    }
+
+    ~FlatPointerMap() { Reset(); }
+
+    // Returns a pointer to the value for |key|, constructing it from |args| if |key| wasn't in
+    // the map, and whether it was inserted.
+    template <typename... Args>
+    std::pair<Value*, bool> TryEmplace(Key* key, Args&&... args) {
+        size_t index = FindIndex(key);
+        if (index != kNotFound) {
+            return {&Data()[index].second, false};
+        }
+
+        if (!mUsesHeap && mSize == InlineCapacity) {
+            MoveInlineEntriesToHeap();
+        }
+
+        value_type* entry;
+        if (mUsesHeap) {
+            mHeapEntries.emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+            entry = &mHeapEntries.back();
+        } else {
+            entry = new (&InlineEntries()[mSize])
+                value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        mSize++;
+
+        if (mSize > InlineCapacity) {
+            if (mSize * 2 > mSlots.size()) {
+                RebuildSlots(static_cast<size_t>(NextPowerOfTwo(mSize * 4)));
+            } else {
+                InsertSlot(key, static_cast<uint32_t>(mSize - 1));
+            }
+        }
+        return {&entry->second, true};
+    }
+
+    // Returns the value for |key|, value-initializing it if |key| wasn't in the map.
+    Value& operator[](Key* key) { return *TryEmplace(key).first; }
+
+    // Returns the value for |key|, or nullptr if |key| isn't in the map.
+    Value* Find(Key* key) {
+        size_t index = FindIndex(key);
+        return index == kNotFound ? nullptr : &Data()[index].second;
+    }
+    const Value* Find(Key* key) const {
+        size_t index = FindIndex(key);
+        return index == kNotFound ? nullptr : &Data()[index].second;
+    }
+
+    bool Contains(Key* key) const { return FindIndex(key) != kNotFound; }
+
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    iterator begin() { return Data(); }
+    iterator end() { return Data() + mSize; }
+    const_iterator begin() const { return Data(); }
+    const_iterator end() const { return Data() + mSize; }
+
+    void clear() {
+        if (mUsesHeap) {
+            mHeapEntries.clear();
+        } else {
+            DestroyInlineEntries();
+        }
+        mSlots.clear();
+        mSize = 0;
+    }
+
+  private:
+    static constexpr size_t kNotFound = ~size_t(0);
+    static constexpr uint32_t kEmptySlot = ~uint32_t(0);
+
+    static size_t HashKey(Key* key) {
+        // Objects are at least 8-byte aligned so the low bits of their address carry no
+        // information. Multiply to spread the remaining ones over the bits used by the mask.
+        uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key) >> 3);
+        hash *= uint64_t(0x9E3779B97F4A7C15);
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    value_type* InlineEntries() { return std::launder(reinterpret_cast<value_type*>(mInline)); }
+    const value_type* InlineEntries() const {
+        return std::launder(reinterpret_cast<const value_type*>(mInline));
+    }
+
+    value_type* Data() { return mUsesHeap ? mHeapEntries.data() : InlineEntries(); }
+    const value_type* Data() const { return mUsesHeap ? mHeapEntries.data() : InlineEntries(); }
+
+    size_t FindIndex(Key* key) const {
+        const value_type* entries = Data();
+        if (mSize <= InlineCapacity) {
+            for (size_t i = 0; i < mSize; i++) {
+                if (entries[i].first == key) {
+                    return i;
+                }
+            }
+            return kNotFound;
+        }
+
+        size_t mask = mSlots.size() - 1;
+        for (size_t slot = HashKey(key) & mask;; slot = (slot + 1) & mask) {
+            uint32_t index = mSlots[slot];
+            if (index == kEmptySlot) {
+                return kNotFound;
+            }
+            if (entries[index].first == key) {
+                return index;
+            }
+        }
+    }
+
+    void InsertSlot(Key* key, uint32_t index) {
+        size_t mask = mSlots.size() - 1;
+        size_t slot = HashKey(key) & mask;
+        while (mSlots[slot] != kEmptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        mSlots[slot] = index;
+    }
+
+    void RebuildSlots(size_t slotCount) {
+        ASSERT(IsPowerOfTwo(slotCount) && slotCount >= mSize * 2);
+        mSlots.assign(slotCount, kEmptySlot);
+        const value_type* entries = Data();
+        for (size_t i = 0; i < mSize; i++) {
+            InsertSlot(entries[i].first, static_cast<uint32_t>(i));
+        }
+    }
+
+    void MoveInlineEntriesToHeap() {
+        ASSERT(!mUsesHeap);
+        mHeapEntries.reserve(InlineCapacity * 2);
+        value_type* entries = InlineEntries();
+        for (size_t i = 0; i < mSize; i++) {
+            mHeapEntries.push_back(std::move(entries[i]));
+        }
+        DestroyInlineEntries();
+        mUsesHeap = true;
+    }
+
+    void DestroyInlineEntries() {
+        value_type* entries = InlineEntries();
+        for (size_t i = 0; i < mSize; i++) {
+            entries[i].~value_type();
+        }
+    }
+
+    // Destroys the entries and releases the heap allocations.
+    void Reset() {
+        clear();
+        std::vector<value_type>().swap(mHeapEntries);
+        std::vector<uint32_t>().swap(mSlots);
+        mUsesHeap = false;
+    }
+
+    void MoveFrom(FlatPointerMap* other) {
+        ASSERT(mSize == 0 && !mUsesHeap);
+        if (other->mUsesHeap) {
+            mHeapEntries = std::move(other->mHeapEntries);
+            mSlots = std::move(other->mSlots);
+            mUsesHeap = true;
+        } else {
+            value_type* entries = other->InlineEntries();
+            for (size_t i = 0; i < other->mSize; i++) {
+                new (&InlineEntries()[i]) value_type(std::move(entries[i]));
+            }
+        }
+        mSize = other->mSize;
+        other->Reset();
+    }
+
+    alignas(value_type) std::byte mInline[sizeof(value_type) * InlineCapacity];
+    std::vector<value_type> mHeapEntries;
+    // The open-addressed table of indices in the entries, only used when there are more than
+    // InlineCapacity entries. Its size is a power of two that is at least twice the entry count.
+    std::vector<uint32_t> mSlots;
+    size_t mSize = 0;
+    bool mUsesHeap = false;
+};
+
+}  // namespace dawn
+
+#endif  // SRC_DAWN_COMMON_FLATPOINTERMAP_H_
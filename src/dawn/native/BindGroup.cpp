@@ -548,4 +548,10 @@ void BindGroupBase::ForEachUnverifiedBufferBindingIndex(
     ForEachUnverifiedBufferBindingIndexImpl(mLayout.Get(), fn);
 }
 
+bool BindGroupBase::TagWithSyncScope(uint64_t syncScopeId) {
+    // Only the thread using the tracker with that ID stores it, so seeing it means that this
+    // thread added the bind group to that sync scope.
+    return mLastSyncScopeId.exchange(syncScopeId, std::memory_order_relaxed) != syncScopeId;
+}
+
 }  // namespace dawn::native
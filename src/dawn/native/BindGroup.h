@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_BINDGROUP_H_
 
 #include <array>
+#include <atomic>
 #include <vector>
 
 #include "dawn/common/Constants.h"
@@ -58,6 +59,10 @@ class BindGroupBase : public ApiObjectBase {
 
     void ForEachUnverifiedBufferBindingIndex(std::function<void(BindingIndex, uint32_t)> fn) const;
 
+    // Tags the bind group as added to the sync scope with ID |syncScopeId| (see
+    // SyncScopeUsageTracker). Returns false if it was already tagged with that ID.
+    bool TagWithSyncScope(uint64_t syncScopeId);
+
   protected:
     // To save memory, the size of a bind group is dynamically determined and the bind group is
     // placement-allocated into memory big enough to hold the bind group with its
@@ -92,6 +97,10 @@ class BindGroupBase : public ApiObjectBase {
     // TODO(dawn:1293): Store external textures in
     // BindGroupLayoutBase::BindingDataPointers::bindings
     std::vector<Ref<ExternalTextureBase>> mBoundExternalTextures;
+
+    // Bind groups can be used by encoders on multiple threads. A stale value only causes the
+    // resources of the bind group to be added to the sync scope again.
+    std::atomic<uint64_t> mLastSyncScopeId{0};
 };
 
 }  // namespace dawn::native
@@ -25,14 +25,22 @@
 namespace dawn::native {
 
 BlobCache::BlobCache(dawn::platform::CachingInterface* cachingInterface)
-    : mCache(cachingInterface) {}
+    : mCache(cachingInterface),
+      mCacheIsThreadSafe(cachingInterface != nullptr && cachingInterface->IsThreadSafe()) {}
 
 Blob BlobCache::Load(const CacheKey& key) {
+    if (mCacheIsThreadSafe) {
+        return LoadInternal(key);
+    }
     std::lock_guard<std::mutex> lock(mMutex);
     return LoadInternal(key);
 }
 
 void BlobCache::Store(const CacheKey& key, size_t valueSize, const void* value) {
+    if (mCacheIsThreadSafe) {
+        StoreInternal(key, valueSize, value);
+        return;
+    }
     std::lock_guard<std::mutex> lock(mMutex);
     StoreInternal(key, valueSize, value);
 }
@@ -52,7 +60,12 @@ Blob BlobCache::LoadInternal(const CacheKey& key) {
         Blob result = CreateBlob(expectedSize);
         const size_t actualSize =
             mCache->LoadData(key.data(), key.size(), result.Data(), expectedSize);
-        ASSERT(expectedSize == actualSize);
+        if (actualSize != expectedSize) {
+            // Thread-safe caches aren't locked between the two calls to LoadData, so the entry
+            // may have been evicted or replaced in between.
+            ASSERT(mCacheIsThreadSafe);
+            return Blob();
+        }
         return result;
     }
     return Blob();
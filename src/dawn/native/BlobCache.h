@@ -54,7 +54,8 @@ class BlobCache {
 
   private:
     // Non-thread safe internal implementations of load and store. Exposed callers that use
-    // these helpers need to make sure that these are entered with `mMutex` held.
+    // these helpers need to make sure that these are entered with `mMutex` held, unless the
+    // caching interface is thread-safe.
     Blob LoadInternal(const CacheKey& key);
     void StoreInternal(const CacheKey& key, size_t valueSize, const void* value);
 
@@ -62,9 +63,11 @@ class BlobCache {
     // that the cache key contains the dawn version string in it.
     bool ValidateCacheKey(const CacheKey& key);
 
-    // Protects thread safety of access to mCache.
+    // Protects thread safety of access to mCache. Only used if mCache isn't thread-safe itself, so
+    // that concurrent loads from thread-safe caches don't serialize.
     std::mutex mMutex;
     dawn::platform::CachingInterface* mCache;
+    const bool mCacheIsThreadSafe;
 };
 
 }  // namespace dawn::native
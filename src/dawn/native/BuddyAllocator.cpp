@@ -35,6 +35,10 @@ BuddyAllocator::~BuddyAllocator() {
     }
 }
 
+uint64_t BuddyAllocator::GetUsedSize() const {
+    return mUsedSize;
+}
+
 uint64_t BuddyAllocator::ComputeTotalNumOfFreeBlocksForTesting() const {
     return ComputeNumOfFreeBlocks(mRoot);
 }
@@ -195,6 +199,7 @@ uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
     // Remove curr block from free-list (now allocated).
     RemoveFreeBlock(currBlock, currBlockLevel);
     currBlock->mState = BlockState::Allocated;
+    mUsedSize += currBlock->mSize;
 
     return currBlock->mOffset;
 }
@@ -225,6 +230,7 @@ void BuddyAllocator::Deallocate(uint64_t offset) {
 
     // Mark curr free so we can merge.
     curr->mState = BlockState::Free;
+    mUsedSize -= curr->mSize;
 
     // Merge the buddies (LevelN-to-Level0).
     while (currBlockLevel > 0 && curr->pBuddy->mState == BlockState::Free) {
@@ -42,6 +42,10 @@ class BuddyAllocator {
     uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
     void Deallocate(uint64_t offset);
 
+    // Sum of the sizes of the allocated blocks, which are the allocation sizes rounded up to a
+    // power of two.
+    uint64_t GetUsedSize() const;
+
     // For testing purposes only.
     uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
 
@@ -106,6 +110,7 @@ class BuddyAllocator {
     BuddyBlock* mRoot = nullptr;  // Used to deallocate non-free blocks.
 
     uint64_t mMaxBlockSize = 0;
+    uint64_t mUsedSize = 0;
 
     // List of linked-lists of free blocks where the index is a level that
     // corresponds to a power-of-two sized block.
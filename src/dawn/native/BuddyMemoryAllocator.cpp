@@ -111,6 +111,10 @@ uint64_t BuddyMemoryAllocator::GetMemoryBlockSize() const {
     return mMemoryBlockSize;
 }
 
+uint64_t BuddyMemoryAllocator::GetUsedSize() const {
+    return mBuddyBlockAllocator.GetUsedSize();
+}
+
 uint64_t BuddyMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
     uint64_t count = 0;
     for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
@@ -48,6 +48,7 @@ class BuddyMemoryAllocator {
     void Deallocate(const ResourceMemoryAllocation& allocation);
 
     uint64_t GetMemoryBlockSize() const;
+    uint64_t GetUsedSize() const;
 
     // For testing purposes.
     uint64_t ComputeTotalNumOfHeapsForTesting() const;
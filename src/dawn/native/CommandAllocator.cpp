@@ -24,6 +24,128 @@
 
 namespace dawn::native {
 
+namespace {
+
+void FreeBlocks(CommandBlockPool* pool, CommandBlocks* blocks) {
+    for (BlockDef& block : *blocks) {
+        if (pool != nullptr) {
+            pool->Deallocate(block);
+        } else {
+            free(block.block);
+        }
+    }
+    blocks->clear();
+}
+
+}  // anonymous namespace
+
+// CommandBlockPool
+
+CommandBlockPool::CommandBlockPool() = default;
+
+CommandBlockPool::~CommandBlockPool() {
+    for (SizeClass& sizeClass : mSizeClasses) {
+        for (uint8_t* block : sizeClass.freeBlocks) {
+            free(block);
+        }
+    }
+}
+
+BlockDef CommandBlockPool::Allocate(size_t minimumSize) {
+    if (minimumSize > kMaxPooledBlockSize) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mAllocationCount++;
+        }
+        return {minimumSize, static_cast<uint8_t*>(malloc(minimumSize))};
+    }
+
+    size_t sizeClassIndex = Log2Ceil(std::max(minimumSize, kMinPooledBlockSize)) -
+                            ConstexprLog2(kMinPooledBlockSize);
+    size_t size = kMinPooledBlockSize << sizeClassIndex;
+    SizeClass& sizeClass = mSizeClasses[sizeClassIndex];
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mAllocationCount++;
+        sizeClass.inUseCount++;
+        sizeClass.highWaterMark = std::max(sizeClass.highWaterMark, sizeClass.inUseCount);
+        if (!sizeClass.freeBlocks.empty()) {
+            uint8_t* block = sizeClass.freeBlocks.back();
+            sizeClass.freeBlocks.pop_back();
+            mReusedAllocationCount++;
+            return {size, block};
+        }
+    }
+
+    uint8_t* block = static_cast<uint8_t*>(malloc(size));
+    if (DAWN_UNLIKELY(block == nullptr)) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        sizeClass.inUseCount--;
+    }
+    return {size, block};
+}
+
+void CommandBlockPool::Deallocate(const BlockDef& block) {
+    // Blocks that don't exactly match a size class are the unpooled large blocks.
+    if (block.size > kMaxPooledBlockSize || block.size < kMinPooledBlockSize ||
+        !IsPowerOfTwo(block.size)) {
+        free(block.block);
+        return;
+    }
+
+    size_t sizeClassIndex = Log2(uint64_t(block.size)) - ConstexprLog2(kMinPooledBlockSize);
+    SizeClass& sizeClass = mSizeClasses[sizeClassIndex];
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ASSERT(sizeClass.inUseCount > 0);
+    sizeClass.inUseCount--;
+    sizeClass.freeBlocks.push_back(block.block);
+}
+
+void CommandBlockPool::Trim() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (SizeClass& sizeClass : mSizeClasses) {
+        size_t maxFreeBlocks = sizeClass.highWaterMark - sizeClass.inUseCount;
+        while (sizeClass.freeBlocks.size() > maxFreeBlocks) {
+            free(sizeClass.freeBlocks.back());
+            sizeClass.freeBlocks.pop_back();
+        }
+        sizeClass.highWaterMark = sizeClass.inUseCount;
+    }
+}
+
+void CommandBlockPool::Tick() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (++mTicksSinceTrim < kTicksPerTrim) {
+            return;
+        }
+        mTicksSinceTrim = 0;
+    }
+    Trim();
+}
+
+uint64_t CommandBlockPool::GetAllocationCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAllocationCount;
+}
+
+uint64_t CommandBlockPool::GetReusedAllocationCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mReusedAllocationCount;
+}
+
+size_t CommandBlockPool::GetCachedSize() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t cachedSize = 0;
+    for (size_t i = 0; i < kSizeClassCount; ++i) {
+        cachedSize += mSizeClasses[i].freeBlocks.size() * (kMinPooledBlockSize << i);
+    }
+    return cachedSize;
+}
+
+// CommandIterator
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -37,6 +159,7 @@ CommandIterator::~CommandIterator() {
 CommandIterator::CommandIterator(CommandIterator&& other) {
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mPool = other.mPool;
         other.Reset();
     }
     Reset();
@@ -46,13 +169,15 @@ CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
     ASSERT(IsEmpty());
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mPool = other.mPool;
         other.Reset();
     }
     Reset();
     return *this;
 }
 
-CommandIterator::CommandIterator(CommandAllocator allocator) : mBlocks(allocator.AcquireBlocks()) {
+CommandIterator::CommandIterator(CommandAllocator allocator)
+    : mBlocks(allocator.AcquireBlocks()), mPool(allocator.mPool) {
     Reset();
 }
 
@@ -62,6 +187,8 @@ void CommandIterator::AcquireCommandBlocks(std::vector<CommandAllocator> allocat
     for (CommandAllocator& allocator : allocators) {
         CommandBlocks blocks = allocator.AcquireBlocks();
         if (!blocks.empty()) {
+            ASSERT(mBlocks.empty() || mPool == allocator.mPool);
+            mPool = allocator.mPool;
             mBlocks.reserve(mBlocks.size() + blocks.size());
             for (BlockDef& block : blocks) {
                 mBlocks.push_back(std::move(block));
@@ -102,10 +229,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
         return;
     }
 
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(mPool, &mBlocks);
     Reset();
     ASSERT(IsEmpty());
 }
@@ -124,16 +248,24 @@ bool CommandIterator::IsEmpty() const {
 //  - Better block allocation, maybe have Dawn API to say command buffer is going to have size
 //    close to another
 
+// CommandAllocator
+
 CommandAllocator::CommandAllocator() {
     ResetPointers();
 }
 
+CommandAllocator::CommandAllocator(CommandBlockPool* pool) : mPool(pool) {
+    ResetPointers();
+}
+
 CommandAllocator::~CommandAllocator() {
     Reset();
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mPool(other.mPool),
+      mLastAllocationSize(other.mLastAllocationSize) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -146,6 +278,7 @@ CommandAllocator::CommandAllocator(CommandAllocator&& other)
 
 CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
     Reset();
+    mPool = other.mPool;
     if (!other.IsEmpty()) {
         std::swap(mBlocks, other.mBlocks);
         mLastAllocationSize = other.mLastAllocationSize;
@@ -157,10 +290,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 }
 
 void CommandAllocator::Reset() {
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
-    mBlocks.clear();
+    FreeBlocks(mPool, &mBlocks);
     mLastAllocationSize = kDefaultBaseAllocationSize;
     ResetPointers();
 }
@@ -207,14 +337,19 @@ bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
     mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-    uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
-    if (DAWN_UNLIKELY(block == nullptr)) {
+    BlockDef block;
+    if (mPool != nullptr) {
+        block = mPool->Allocate(mLastAllocationSize);
+    } else {
+        block = {mLastAllocationSize, static_cast<uint8_t*>(malloc(mLastAllocationSize))};
+    }
+    if (DAWN_UNLIKELY(block.block == nullptr)) {
         return false;
     }
 
-    mBlocks.push_back({mLastAllocationSize, block});
-    mCurrentPtr = AlignPtr(block, alignof(uint32_t));
-    mEndPtr = block + mLastAllocationSize;
+    mBlocks.push_back(block);
+    mCurrentPtr = AlignPtr(block.block, alignof(uint32_t));
+    mEndPtr = block.block + block.size;
     return true;
 }
 
@@ -15,9 +15,11 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 #define SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <mutex>
 #include <vector>
 
 #include "dawn/common/Assert.h"
@@ -61,6 +63,54 @@ struct BlockDef {
 };
 using CommandBlocks = std::vector<BlockDef>;
 
+// A pool of command blocks shared by the CommandAllocators of a device, so that the blocks freed
+// when a command buffer is destroyed are reused by the next command encoders instead of going
+// through malloc and free for each block. Blocks are pooled per power-of-two size class, up to
+// kMaxPooledBlockSize. Larger blocks, only used for very large commands, aren't pooled.
+//
+// The pool is thread-safe since command buffers can be encoded and destroyed on any thread.
+class CommandBlockPool : public NonCopyable {
+  public:
+    static constexpr size_t kMinPooledBlockSize = 2048;
+    static constexpr size_t kMaxPooledBlockSize = 16384;
+
+    CommandBlockPool();
+    ~CommandBlockPool();
+
+    // Returns a block of at least |minimumSize| bytes, or a block with a null pointer on OOM.
+    BlockDef Allocate(size_t minimumSize);
+    void Deallocate(const BlockDef& block);
+
+    // Frees the cached blocks that weren't needed since the last call to Trim: for each size
+    // class, the pool keeps enough blocks to reach the highest number of blocks in use since the
+    // last trim.
+    void Trim();
+    // Called on each device tick, trims the pool every kTicksPerTrim ticks. Devices tick after
+    // each submit, so the high-water mark needs to cover many ticks to span whole frames.
+    void Tick();
+
+    uint64_t GetAllocationCount() const;
+    uint64_t GetReusedAllocationCount() const;
+    size_t GetCachedSize() const;
+
+  private:
+    static constexpr size_t kSizeClassCount = 4;
+    static constexpr uint32_t kTicksPerTrim = 64;
+    static_assert(kMinPooledBlockSize << (kSizeClassCount - 1) == kMaxPooledBlockSize);
+
+    struct SizeClass {
+        std::vector<uint8_t*> freeBlocks;
+        size_t inUseCount = 0;
+        size_t highWaterMark = 0;
+    };
+
+    mutable std::mutex mMutex;
+    std::array<SizeClass, kSizeClassCount> mSizeClasses;
+    uint64_t mAllocationCount = 0;
+    uint64_t mReusedAllocationCount = 0;
+    uint32_t mTicksSinceTrim = 0;
+};
+
 namespace detail {
 constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
 constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
@@ -79,6 +129,8 @@ class CommandIterator : public NonCopyable {
     // Shorthand constructor for acquiring CommandBlocks from a single CommandAllocator.
     explicit CommandIterator(CommandAllocator allocator);
 
+    // All the allocators must use the same CommandBlockPool, if any, since the blocks are returned
+    // to it when the iterator is emptied.
     void AcquireCommandBlocks(std::vector<CommandAllocator> allocators);
 
     template <typename E>
@@ -141,6 +193,7 @@ class CommandIterator : public NonCopyable {
     }
 
     CommandBlocks mBlocks;
+    CommandBlockPool* mPool = nullptr;
     uint8_t* mCurrentPtr = nullptr;
     size_t mCurrentBlock = 0;
     // Used to avoid a special case for empty iterators.
@@ -150,9 +203,13 @@ class CommandIterator : public NonCopyable {
 class CommandAllocator : public NonCopyable {
   public:
     CommandAllocator();
+    // Allocates the blocks from |pool| instead of malloc. The pool must outlive the allocator and
+    // the CommandIterators its commands are moved to.
+    explicit CommandAllocator(CommandBlockPool* pool);
     ~CommandAllocator();
 
-    // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
+    // NOTE: A moved-from CommandAllocator is reset to its initial empty state, but keeps using
+    // the same CommandBlockPool.
     CommandAllocator(CommandAllocator&&);
     CommandAllocator& operator=(CommandAllocator&&);
 
@@ -253,6 +310,7 @@ class CommandAllocator : public NonCopyable {
     void ResetPointers();
 
     CommandBlocks mBlocks;
+    CommandBlockPool* mPool = nullptr;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
@@ -20,6 +20,7 @@
 #include "dawn/native/BindGroupLayout.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/Device.h"
+#include "dawn/native/DynamicUploader.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Texture.h"
 #include "dawn/platform/DawnPlatform.h"
@@ -245,6 +246,25 @@ size_t GetDeprecationWarningCountForTesting(WGPUDevice device) {
     return FromAPI(device)->GetDeprecationWarningCountForTesting();
 }
 
+UploadStagingStatistics GetUploadStagingStatistics(WGPUDevice device) {
+    DeviceBase* deviceBase = FromAPI(device);
+    auto deviceLock(deviceBase->GetScopedLock());
+    DynamicUploader::Statistics statistics = deviceBase->GetDynamicUploader()->GetStatistics();
+
+    UploadStagingStatistics result;
+    result.stagingBufferCreationCount = statistics.stagingBufferCreationCount;
+    result.stagingBufferReuseCount = statistics.stagingBufferReuseCount;
+    result.ringBufferSize = statistics.ringBufferSize;
+    result.pooledSize = statistics.pooledSize;
+    return result;
+}
+
+void SetUploadStagingPoolLimit(WGPUDevice device, uint64_t limit) {
+    DeviceBase* deviceBase = FromAPI(device);
+    auto deviceLock(deviceBase->GetScopedLock());
+    deviceBase->GetDynamicUploader()->SetStagingBufferPoolLimit(limit);
+}
+
 size_t GetPhysicalDeviceCountForTesting(WGPUInstance instance) {
     return FromAPI(instance)->GetPhysicalDeviceCountForTesting();
 }
@@ -1315,6 +1315,8 @@ bool DeviceBase::APITick() {
 }
 
 MaybeError DeviceBase::Tick() {
+    mCommandBlockPool.Tick();
+
     if (IsLost() || !HasScheduledCommands()) {
         return {};
     }
@@ -1825,6 +1827,10 @@ DynamicUploader* DeviceBase::GetDynamicUploader() const {
     return mDynamicUploader.get();
 }
 
+CommandBlockPool* DeviceBase::GetCommandBlockPool() {
+    return &mCommandBlockPool;
+}
+
 // The Toggle device facility
 
 std::vector<const char*> DeviceBase::GetTogglesUsed() const {
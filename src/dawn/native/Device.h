@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_DEVICE_H_
 #define SRC_DAWN_NATIVE_DEVICE_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -24,6 +25,7 @@
 #include "dawn/common/ContentLessObjectCache.h"
 #include "dawn/common/Mutex.h"
 #include "dawn/native/CacheKey.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/ComputePipeline.h"
 #include "dawn/native/Error.h"
@@ -326,6 +328,7 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
                                         const Extent3D& copySizePixels);
 
     DynamicUploader* GetDynamicUploader() const;
+    CommandBlockPool* GetCommandBlockPool();
 
     // The device state which is a combination of creation state and loss state.
     //
@@ -545,6 +548,9 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
                                                     const TextureCopy& dst,
                                                     const Extent3D& copySizePixels) = 0;
 
+    // Declared first so that it is destroyed after all the members that could hold commands.
+    CommandBlockPool mCommandBlockPool;
+
     wgpu::ErrorCallback mUncapturedErrorCallback = nullptr;
     void* mUncapturedErrorUserdata = nullptr;
 
@@ -585,7 +591,8 @@ class DeviceBase : public RefCountedWithExternalCount, public ExecutionQueueBase
 
     TogglesState mToggles;
 
-    size_t mLazyClearCountForTesting = 0;
+    // Atomic because the Vulkan backend can record command buffers on several threads.
+    std::atomic<size_t> mLazyClearCountForTesting{0};
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
 
     CombinedLimits mLimits;
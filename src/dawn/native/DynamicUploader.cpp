@@ -14,6 +14,8 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "dawn/common/Math.h"
@@ -23,33 +25,61 @@
 namespace dawn::native {
 
 DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
-    mRingBuffers.emplace_back(
-        std::unique_ptr<RingBuffer>(new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+    mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+        new RingBuffer{nullptr, RingBufferAllocator(kMinRingBufferSize)}));
 }
 
 void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
     mReleasedStagingBuffers.Enqueue(std::move(stagingBuffer), mDevice->GetPendingCommandSerial());
 }
 
+ResultOrError<Ref<BufferBase>> DynamicUploader::CreateStagingBuffer(uint64_t size) {
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    bufferDesc.size = Align(size, 4);
+    bufferDesc.mappedAtCreation = true;
+    bufferDesc.label = "Dawn_DynamicUploaderStaging";
+
+    IgnoreLazyClearCountScope scope(mDevice);
+    Ref<BufferBase> stagingBuffer;
+    DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+    mStagingBufferCreationCount++;
+    return stagingBuffer;
+}
+
+ResultOrError<Ref<BufferBase>> DynamicUploader::AcquireLargeStagingBuffer(
+    uint64_t allocationSize) {
+    // Round the size up to one of eight size classes per power of two so that buffers can be
+    // reused by uploads of similar sizes while wasting at most an eighth of their memory.
+    const uint64_t size = Align(Align(allocationSize, 4), NextPowerOfTwo(allocationSize) / 8);
+
+    // Staging buffers stay mapped, so a pooled buffer can be written to again right away. Prefer
+    // the most recently used one.
+    for (auto it = mPooledStagingBuffers.rbegin(); it != mPooledStagingBuffers.rend(); ++it) {
+        if ((*it)->GetSize() == size) {
+            Ref<BufferBase> stagingBuffer = std::move(*it);
+            mPooledStagingBuffers.erase(std::next(it).base());
+            mPooledSize -= size;
+            mStagingBufferReuseCount++;
+            return stagingBuffer;
+        }
+    }
+    return CreateStagingBuffer(size);
+}
+
 ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                               ExecutionSerial serial) {
     // Disable further sub-allocation should the request be too large.
-    if (allocationSize > kRingBufferSize) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(allocationSize, 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
+    if (allocationSize > kMaxRingBufferSize) {
         Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+        DAWN_TRY_ASSIGN(stagingBuffer, AcquireLargeStagingBuffer(allocationSize));
 
         UploadHandle uploadHandle;
         uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
         uploadHandle.stagingBuffer = stagingBuffer.Get();
 
-        ReleaseStagingBuffer(std::move(stagingBuffer));
+        mLargeStagingBuffersInFlight.Enqueue(std::move(stagingBuffer),
+                                             mDevice->GetPendingCommandSerial());
         return uploadHandle;
     }
 
@@ -74,10 +104,14 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     }
 
     // Upon failure, append a newly created ring buffer to fulfill the
-    // request.
+    // request. It is twice as large as the last one so that sustained uploads need fewer ring
+    // buffers.
     if (startOffset == RingBufferAllocator::kInvalidOffset) {
+        const uint64_t ringBufferSize =
+            std::max(NextPowerOfTwo(allocationSize),
+                     std::min(2 * mRingBuffers.back()->mAllocator.GetSize(), kMaxRingBufferSize));
         mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+            new RingBuffer{nullptr, RingBufferAllocator(ringBufferSize)}));
 
         targetRingBuffer = mRingBuffers.back().get();
         startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
@@ -88,16 +122,8 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     // Allocate the staging buffer backing the ringbuffer.
     // Note: the first ringbuffer will be lazily created.
     if (targetRingBuffer->mStagingBuffer == nullptr) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(targetRingBuffer->mAllocator.GetSize(), 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
-        Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
-        targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+        DAWN_TRY_ASSIGN(targetRingBuffer->mStagingBuffer,
+                        CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
     }
 
     ASSERT(targetRingBuffer->mStagingBuffer != nullptr);
@@ -124,6 +150,31 @@ void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
         }
     }
     mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+    // Large staging buffers of completed uploads are kept for reuse instead of being destroyed.
+    for (Ref<BufferBase>& stagingBuffer :
+         mLargeStagingBuffersInFlight.IterateUpTo(lastCompletedSerial)) {
+        mPooledSize += stagingBuffer->GetSize();
+        mPooledStagingBuffers.push_back(std::move(stagingBuffer));
+    }
+    mLargeStagingBuffersInFlight.ClearUpTo(lastCompletedSerial);
+    EvictPooledStagingBuffers();
+}
+
+void DynamicUploader::EvictPooledStagingBuffers() {
+    size_t evictedCount = 0;
+    while (mPooledSize > mStagingBufferPoolLimit) {
+        ASSERT(evictedCount < mPooledStagingBuffers.size());
+        mPooledSize -= mPooledStagingBuffers[evictedCount]->GetSize();
+        evictedCount++;
+    }
+    mPooledStagingBuffers.erase(mPooledStagingBuffers.begin(),
+                                mPooledStagingBuffers.begin() + evictedCount);
+}
+
+void DynamicUploader::SetStagingBufferPoolLimit(uint64_t limit) {
+    mStagingBufferPoolLimit = limit;
+    EvictPooledStagingBuffers();
 }
 
 // TODO(dawn:512): Optimize this function so that it doesn't allocate additional memory
@@ -153,6 +204,11 @@ uint64_t DynamicUploader::GetTotalAllocatedSize() {
     for (const auto& buffer : mReleasedStagingBuffers.IterateAll()) {
         size += buffer->GetSize();
     }
+    // Pooled staging buffers aren't counted since they don't hold pending uploads: flushing
+    // wouldn't release them.
+    for (const auto& buffer : mLargeStagingBuffersInFlight.IterateAll()) {
+        size += buffer->GetSize();
+    }
     for (const auto& buffer : mRingBuffers) {
         if (buffer->mStagingBuffer != nullptr) {
             size += buffer->mStagingBuffer->GetSize();
@@ -161,4 +217,17 @@ uint64_t DynamicUploader::GetTotalAllocatedSize() {
     return size;
 }
 
+DynamicUploader::Statistics DynamicUploader::GetStatistics() const {
+    Statistics statistics;
+    statistics.stagingBufferCreationCount = mStagingBufferCreationCount;
+    statistics.stagingBufferReuseCount = mStagingBufferReuseCount;
+    for (const auto& buffer : mRingBuffers) {
+        if (buffer->mStagingBuffer != nullptr) {
+            statistics.ringBufferSize += buffer->mStagingBuffer->GetSize();
+        }
+    }
+    statistics.pooledSize = mPooledSize;
+    return statistics;
+}
+
 }  // namespace dawn::native
@@ -54,8 +54,25 @@ class DynamicUploader {
 
     bool ShouldFlush();
 
+    // Sets the maximum total size of the large staging buffers kept for reuse once the uploads
+    // using them are completed. The least recently used ones are released first.
+    void SetStagingBufferPoolLimit(uint64_t limit);
+
+    struct Statistics {
+        uint64_t stagingBufferCreationCount = 0;
+        uint64_t stagingBufferReuseCount = 0;
+        uint64_t ringBufferSize = 0;
+        uint64_t pooledSize = 0;
+    };
+    Statistics GetStatistics() const;
+
   private:
-    static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
+    // Ring buffers start at kMinRingBufferSize and double in size, up to kMaxRingBufferSize, when
+    // they are full. Larger allocations use dedicated staging buffers that are pooled by size
+    // class once they are no longer in use.
+    static constexpr uint64_t kMinRingBufferSize = 4 * 1024 * 1024;
+    static constexpr uint64_t kMaxRingBufferSize = 32 * 1024 * 1024;
+    static constexpr uint64_t kDefaultStagingBufferPoolLimit = 256 * 1024 * 1024;
     uint64_t GetTotalAllocatedSize();
 
     struct RingBuffer {
@@ -64,9 +81,23 @@ class DynamicUploader {
     };
 
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize, ExecutionSerial serial);
+    ResultOrError<Ref<BufferBase>> AcquireLargeStagingBuffer(uint64_t allocationSize);
+    ResultOrError<Ref<BufferBase>> CreateStagingBuffer(uint64_t size);
+    void EvictPooledStagingBuffers();
 
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
     SerialQueue<ExecutionSerial, Ref<BufferBase>> mReleasedStagingBuffers;
+
+    // Large staging buffers in use by pending uploads, and the ones that can be reused, from the
+    // least to the most recently used.
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mLargeStagingBuffersInFlight;
+    std::vector<Ref<BufferBase>> mPooledStagingBuffers;
+    uint64_t mPooledSize = 0;
+    uint64_t mStagingBufferPoolLimit = kDefaultStagingBufferPoolLimit;
+
+    uint64_t mStagingBufferCreationCount = 0;
+    uint64_t mStagingBufferReuseCount = 0;
+
     DeviceBase* mDevice;
 };
 }  // namespace dawn::native
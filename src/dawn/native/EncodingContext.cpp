@@ -28,6 +28,7 @@ EncodingContext::EncodingContext(DeviceBase* device, const ApiObjectBase* initia
     : mDevice(device),
       mTopLevelEncoder(initialEncoder),
       mCurrentEncoder(initialEncoder),
+      mPendingCommands(device->GetCommandBlockPool()),
       mDestroyed(device->IsLost()) {}
 
 EncodingContext::~EncodingContext() {
@@ -14,6 +14,7 @@
 
 #include "dawn/native/PassResourceUsageTracker.h"
 
+#include <atomic>
 #include <utility>
 
 #include "dawn/native/BindGroup.h"
@@ -26,16 +27,44 @@
 
 namespace dawn::native {
 
-SyncScopeUsageTracker::SyncScopeUsageTracker() = default;
+namespace {
 
-SyncScopeUsageTracker::SyncScopeUsageTracker(SyncScopeUsageTracker&&) = default;
+// IDs are never reused so that a bind group tagged by a tracker that has since been emptied or
+// destroyed can't be mistaken for being in the current sync scope of another one.
+uint64_t AcquireSyncScopeId() {
+    static std::atomic<uint64_t> sNextId{1};
+    return sNextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // anonymous namespace
+
+SyncScopeUsageTracker::SyncScopeUsageTracker() : mId(AcquireSyncScopeId()) {}
+
+SyncScopeUsageTracker::SyncScopeUsageTracker(SyncScopeUsageTracker&& other)
+    : mBufferUsages(std::move(other.mBufferUsages)),
+      mTextureUsages(std::move(other.mTextureUsages)),
+      mExternalTextureUsages(std::move(other.mExternalTextureUsages)),
+      mId(other.mId) {
+    other.mExternalTextureUsages.clear();
+    other.mId = AcquireSyncScopeId();
+}
 
 SyncScopeUsageTracker::~SyncScopeUsageTracker() = default;
 
-SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&) = default;
+SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&& other) {
+    if (this != &other) {
+        mBufferUsages = std::move(other.mBufferUsages);
+        mTextureUsages = std::move(other.mTextureUsages);
+        mExternalTextureUsages = std::move(other.mExternalTextureUsages);
+        mId = other.mId;
+        other.mExternalTextureUsages.clear();
+        other.mId = AcquireSyncScopeId();
+    }
+    return *this;
+}
 
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-    // std::map's operator[] will create the key and return 0 if the key didn't exist
+    // FlatPointerMap's operator[] will create the key and return 0 if the key didn't exist
     // before.
     mBufferUsages[buffer] |= usage;
 }
@@ -46,11 +75,11 @@ void SyncScopeUsageTracker::TextureViewUsedAs(TextureViewBase* view, wgpu::Textu
 
     // Get or create a new TextureSubresourceUsage for that texture (initially filled with
     // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage& textureUsage = it.first->second;
+    TextureSubresourceUsage& textureUsage =
+        *mTextureUsages
+             .TryEmplace(texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
+                         texture->GetNumMipLevels(), wgpu::TextureUsage::None)
+             .first;
 
     textureUsage.Update(range, [usage](const SubresourceRange&, wgpu::TextureUsage* storedUsage) {
         // TODO(crbug.com/dawn/1001): Consider optimizing to have fewer
@@ -72,11 +101,11 @@ void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
     const TextureSubresourceUsage& textureUsage) {
     // Get or create a new TextureSubresourceUsage for that texture (initially filled with
     // wgpu::TextureUsage::None)
-    auto it = mTextureUsages.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(), wgpu::TextureUsage::None));
-    TextureSubresourceUsage* passTextureUsage = &it.first->second;
+    TextureSubresourceUsage* passTextureUsage =
+        mTextureUsages
+            .TryEmplace(texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
+                        texture->GetNumMipLevels(), wgpu::TextureUsage::None)
+            .first;
 
     passTextureUsage->Merge(textureUsage,
                             [](const SubresourceRange&, wgpu::TextureUsage* storedUsage,
@@ -87,6 +116,12 @@ void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
 }
 
 void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
+    // Adding the resources of a bind group is idempotent so there is nothing to do if it was
+    // already added to this sync scope, like when a render pass sets it repeatedly.
+    if (!group->TagWithSyncScope(mId)) {
+        return;
+    }
+
     for (BindingIndex bindingIndex{0}; bindingIndex < group->GetLayout()->GetBindingCount();
          ++bindingIndex) {
         const BindingInfo& bindingInfo = group->GetLayout()->GetBindingInfo(bindingIndex);
@@ -176,6 +211,7 @@ SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
     mBufferUsages.clear();
     mTextureUsages.clear();
     mExternalTextureUsages.clear();
+    mId = AcquireSyncScopeId();
 
     return result;
 }
@@ -19,6 +19,7 @@
 #include <set>
 #include <vector>
 
+#include "dawn/common/FlatPointerMap.h"
 #include "dawn/native/PassResourceUsage.h"
 
 #include "dawn/native/dawn_platform.h"
@@ -54,9 +55,19 @@ class SyncScopeUsageTracker {
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-    std::map<TextureBase*, TextureSubresourceUsage> mTextureUsages;
+    // The resources are tracked in flat maps that are iterated in the order they were first used.
+    // Most sync scopes (like the ones for each dispatch) only use a few resources, that are
+    // stored inline.
+    static constexpr size_t kInlineResourceCount = 8;
+
+    FlatPointerMap<BufferBase, wgpu::BufferUsage, kInlineResourceCount> mBufferUsages;
+    FlatPointerMap<TextureBase, TextureSubresourceUsage, kInlineResourceCount> mTextureUsages;
     std::set<ExternalTextureBase*> mExternalTextureUsages;
+
+    // A unique ID for the current content of the tracker, that bind groups are tagged with when
+    // they are added so that adding them again to the same sync scope can be skipped. A new ID is
+    // taken whenever the tracker is emptied.
+    uint64_t mId;
 };
 
 // Helper class to build ComputePassResourceUsages
@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -168,6 +170,89 @@ class ErrorQueue : public QueueBase {
         UNREACHABLE();
     }
 };
+
+// The number of resource usages that a range of command buffers must have at least to be
+// validated on a worker thread at Queue::Submit, to amortize the cost of posting the task.
+constexpr size_t kMinResourceUsageCountPerValidationTask = 4096;
+
+size_t GetResourceUsageCount(const CommandBufferResourceUsage& usages) {
+    size_t count = usages.topLevelBuffers.size() + usages.topLevelTextures.size() +
+                   usages.usedQuerySets.size();
+    for (const SyncScopeResourceUsage& scope : usages.renderPasses) {
+        count += scope.buffers.size() + scope.textures.size() + scope.externalTextures.size();
+    }
+    for (const ComputePassResourceUsage& pass : usages.computePasses) {
+        count += pass.referencedBuffers.size() + pass.referencedTextures.size() +
+                 pass.referencedExternalTextures.size();
+    }
+    return count;
+}
+
+MaybeError ValidateCommandBufferForSubmit(DeviceBase* device, CommandBufferBase* commandBuffer) {
+    DAWN_TRY(device->ValidateObject(commandBuffer));
+    DAWN_TRY(commandBuffer->ValidateCanUseInSubmitNow());
+    const CommandBufferResourceUsage& usages = commandBuffer->GetResourceUsages();
+
+    for (const BufferBase* buffer : usages.topLevelBuffers) {
+        DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
+    }
+
+    // Maybe track last usage for other resources, and use it to release resources earlier?
+    for (const SyncScopeResourceUsage& scope : usages.renderPasses) {
+        for (const BufferBase* buffer : scope.buffers) {
+            DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
+        }
+
+        for (const TextureBase* texture : scope.textures) {
+            DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+        }
+
+        for (const ExternalTextureBase* externalTexture : scope.externalTextures) {
+            DAWN_TRY(externalTexture->ValidateCanUseInSubmitNow());
+        }
+    }
+
+    for (const ComputePassResourceUsage& pass : usages.computePasses) {
+        for (const BufferBase* buffer : pass.referencedBuffers) {
+            DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
+        }
+        for (const TextureBase* texture : pass.referencedTextures) {
+            DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+        }
+        for (const ExternalTextureBase* externalTexture : pass.referencedExternalTextures) {
+            DAWN_TRY(externalTexture->ValidateCanUseInSubmitNow());
+        }
+    }
+
+    for (const TextureBase* texture : usages.topLevelTextures) {
+        DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+    }
+    for (const QuerySetBase* querySet : usages.usedQuerySets) {
+        DAWN_TRY(querySet->ValidateCanUseInSubmitNow());
+    }
+
+    return {};
+}
+
+// A contiguous range of the submitted command buffers, validated on its own thread.
+struct SubmitValidationTask {
+    DeviceBase* device;
+    CommandBufferBase* const* commands;
+    uint32_t commandCount;
+    MaybeError result;
+};
+
+void DoSubmitValidationTask(void* userdata) {
+    SubmitValidationTask* task = static_cast<SubmitValidationTask*>(userdata);
+    for (uint32_t i = 0; i < task->commandCount; ++i) {
+        MaybeError result = ValidateCommandBufferForSubmit(task->device, task->commands[i]);
+        if (result.IsError()) {
+            task->result = std::move(result);
+            return;
+        }
+    }
+}
+
 }  // namespace
 
 void TrackTaskCallback::SetFinishedSerial(ExecutionSerial serial) {
@@ -451,51 +536,66 @@ MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
     TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "Queue::ValidateSubmit");
     DAWN_TRY(GetDevice()->ValidateObject(this));
 
+    // Validating the command buffers only reads the state of the objects they use, so when they
+    // use a lot of them, contiguous ranges of command buffers are validated in parallel.
+    std::vector<size_t> usageCounts(commandCount);
+    size_t totalUsageCount = 0;
     for (uint32_t i = 0; i < commandCount; ++i) {
-        DAWN_TRY(GetDevice()->ValidateObject(commands[i]));
-        DAWN_TRY(commands[i]->ValidateCanUseInSubmitNow());
-        const CommandBufferResourceUsage& usages = commands[i]->GetResourceUsages();
+        usageCounts[i] = GetResourceUsageCount(commands[i]->GetResourceUsages());
+        totalUsageCount += usageCounts[i];
+    }
 
-        for (const BufferBase* buffer : usages.topLevelBuffers) {
-            DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
+    size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t taskCount = std::min({static_cast<size_t>(commandCount), threadCount,
+                                 totalUsageCount / kMinResourceUsageCountPerValidationTask});
+    dawn::platform::WorkerTaskPool* taskPool = GetDevice()->GetWorkerTaskPool();
+    if (taskCount <= 1 || taskPool == nullptr) {
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            DAWN_TRY(ValidateCommandBufferForSubmit(GetDevice(), commands[i]));
         }
+        return {};
+    }
 
-        // Maybe track last usage for other resources, and use it to release resources earlier?
-        for (const SyncScopeResourceUsage& scope : usages.renderPasses) {
-            for (const BufferBase* buffer : scope.buffers) {
-                DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
-            }
-
-            for (const TextureBase* texture : scope.textures) {
-                DAWN_TRY(texture->ValidateCanUseInSubmitNow());
-            }
-
-            for (const ExternalTextureBase* externalTexture : scope.externalTextures) {
-                DAWN_TRY(externalTexture->ValidateCanUseInSubmitNow());
-            }
+    // Split the command buffers in ranges with about the same number of resource usages.
+    std::vector<SubmitValidationTask> tasks;
+    tasks.reserve(taskCount);
+    uint32_t firstCommand = 0;
+    size_t rangeUsageCount = 0;
+    for (uint32_t i = 0; i < commandCount; ++i) {
+        rangeUsageCount += usageCounts[i];
+        if (rangeUsageCount >= totalUsageCount / taskCount && tasks.size() + 1 < taskCount) {
+            tasks.push_back({GetDevice(), commands + firstCommand, i + 1 - firstCommand, {}});
+            firstCommand = i + 1;
+            rangeUsageCount = 0;
         }
+    }
+    if (firstCommand < commandCount) {
+        tasks.push_back({GetDevice(), commands + firstCommand, commandCount - firstCommand, {}});
+    }
 
-        for (const ComputePassResourceUsage& pass : usages.computePasses) {
-            for (const BufferBase* buffer : pass.referencedBuffers) {
-                DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
-            }
-            for (const TextureBase* texture : pass.referencedTextures) {
-                DAWN_TRY(texture->ValidateCanUseInSubmitNow());
-            }
-            for (const ExternalTextureBase* externalTexture : pass.referencedExternalTextures) {
-                DAWN_TRY(externalTexture->ValidateCanUseInSubmitNow());
-            }
-        }
+    // The first range is validated on the current thread while the workers validate the others.
+    std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> events;
+    for (size_t i = 1; i < tasks.size(); ++i) {
+        events.push_back(taskPool->PostWorkerTask(DoSubmitValidationTask, &tasks[i]));
+    }
+    DoSubmitValidationTask(&tasks[0]);
+    for (auto& event : events) {
+        event->Wait();
+    }
 
-        for (const TextureBase* texture : usages.topLevelTextures) {
-            DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+    // Return the error of the first invalid command buffer, like the serial validation would.
+    MaybeError result;
+    for (SubmitValidationTask& task : tasks) {
+        if (!task.result.IsError()) {
+            continue;
         }
-        for (const QuerySetBase* querySet : usages.usedQuerySets) {
-            DAWN_TRY(querySet->ValidateCanUseInSubmitNow());
+        if (result.IsError()) {
+            task.result.AcquireError();
+        } else {
+            result = std::move(task.result);
         }
     }
-
-    return {};
+    return result;
 }
 
 MaybeError QueueBase::ValidateOnSubmittedWorkDone(uint64_t signalValue,
@@ -16,9 +16,12 @@
 #define SRC_DAWN_NATIVE_SUBRESOURCESTORAGE_H_
 
 #include <array>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "dawn/common/Assert.h"
@@ -54,39 +57,48 @@ namespace dawn::native {
 //      // `data`.
 //   });
 //
-// SubresourceStorage internally tracks compression state per aspect and then per layer of each
-// aspect. This means that a 2-aspect texture can have the following compression state:
+// SubresourceStorage internally tracks compression state per aspect and then per run of
+// consecutive layers of each aspect (or per layer for small arrays, see below). This means that a
+// 2-aspect texture can have the following compression state:
 //
 //  - Aspect 0 is fully compressed.
 //  - Aspect 1 is partially compressed:
+//    - Aspect 1 layers 0-2 and 4-42 are compressed, as two runs with different values.
 //    - Aspect 1 layer 3 is decompressed.
-//    - Aspect 1 layer 0-2 and 4-42 are compressed.
 //
 // A useful model to reason about SubresourceStorage is to represent is as a tree:
 //
 //  - SubresourceStorage is the root.
 //    |-> Nodes 1 deep represent each aspect. If an aspect is compressed, its node doesn't have
 //       any children because the data is constant across all of the subtree.
-//      |-> Nodes 2 deep represent layers (for uncompressed aspects). If a layer is compressed,
-//         its node doesn't have any children because the data is constant across all of the
-//         subtree.
-//        |-> Nodes 3 deep represent individial mip levels (for uncompressed layers).
+//      |-> Nodes 2 deep represent runs of consecutive layers that have the same data (for
+//         uncompressed aspects). If a run is compressed, its node doesn't have any children
+//         because the data is constant across all of the subtree.
+//        |-> Nodes 3 deep represent individial mip levels (for uncompressed runs).
 //
 // The concept of recompression is the removal of all child nodes of a non-leaf node when the
-// data is constant across them. Decompression is the addition of child nodes to a leaf node
-// and copying of its data to all its children.
+// data is constant across them, and the merging of adjacent runs that have the same data.
+// Decompression is the addition of child nodes to a leaf node and copying of its data to all
+// its children, and the splitting of runs at the boundaries of the updated layers.
 //
 // The choice of having secondary compression for array layers is to optimize for the cases
 // where transfer operations are used to update specific layers of texture with render or
 // transfer operations, while the rest is untouched. It seems much less likely that there
 // would be operations that touch all Nth mips of a 2D array texture without touching the
-// others.
+// others. The runs are kept in an ordered map keyed by their first layer so that updating a
+// few layers of a texture with thousands of them only looks up and splits O(log n) runs, and
+// only the runs around the updated layers are recompressed after the update.
+//
+// Arrays with at most kMaxFlatArrayLayerCount layers don't use runs: each layer of a decompressed
+// aspect is tracked on its own, with a compression flag and the data for all its mip levels, in
+// flat arrays allocated once for all the aspects. Scanning a few layers is cheaper than looking
+// up, splitting and allocating runs in the map, and most textures only have a few layers.
 //
 // There are several hot code paths that create new SubresourceStorage like the tracking of
 // resource usage per-pass. We don't want to allocate a container for the decompressed data
 // unless we have to because it would dramatically lower performance. Instead
 // SubresourceStorage contains an inline array that contains the per-aspect compressed data
-// and only allocates a per-subresource on aspect decompression.
+// and only allocates runs on aspect decompression.
 //
 // T must be a copyable type that supports equality comparison with ==.
 //
@@ -180,20 +192,53 @@ class SubresourceStorage {
     //
     //  - UpdateTo(Range, T) that updates the range to a constant value.
 
+    // Arrays with more layers than this track their decompressed aspects with runs of layers.
+    static constexpr uint32_t kMaxFlatArrayLayerCount = 16;
+
     // Methods to query the internal state of SubresourceStorage for testing.
     Aspect GetAspectsForTesting() const;
     uint32_t GetArrayLayerCountForTesting() const;
     uint32_t GetMipLevelCountForTesting() const;
     bool IsAspectCompressedForTesting(Aspect aspect) const;
     bool IsLayerCompressedForTesting(Aspect aspect, uint32_t layer) const;
+    uint32_t GetLayerRunCountForTesting(Aspect aspect) const;
 
   private:
     template <typename U>
     friend class SubresourceStorage;
 
+    // A run of consecutive layers of an aspect that have the same data, starting at the layer
+    // used as its key in LayerRuns. The run is compressed when its data is the same for all
+    // mip levels, in which case levelData is null. Otherwise levelData holds the data of each of
+    // the mMipLevelCount mip levels.
+    struct LayerRun {
+        uint32_t layerEnd;
+        T data;
+        std::unique_ptr<T[]> levelData;
+
+        bool IsCompressed() const;
+        bool HasSameData(const LayerRun& other, uint32_t levelCount) const;
+    };
+    using LayerRuns = std::map<uint32_t, LayerRun>;
+
+    // Returns whether the decompressed aspects are tracked with runs of layers, instead of with
+    // the flat per-layer arrays.
+    bool UsesLayerRuns() const;
+
+    // Implementations of Update() and Merge() for a single decompressed aspect.
+    template <typename F>
+    void UpdateFlatLayers(Aspect aspect, const SubresourceRange& range, F&& updateFunc);
+    template <typename F>
+    void UpdateLayerRuns(Aspect aspect, const SubresourceRange& range, F&& updateFunc);
+    template <typename U, typename F>
+    void MergeFlatLayers(Aspect aspect, const SubresourceStorage<U>& other, F&& mergeFunc);
+    template <typename U, typename F>
+    void MergeLayerRuns(Aspect aspect, const SubresourceStorage<U>& other, F&& mergeFunc);
+
     void DecompressAspect(uint32_t aspectIndex);
     void RecompressAspect(uint32_t aspectIndex);
 
+    // Used for the flat per-layer arrays.
     void DecompressLayer(uint32_t aspectIndex, uint32_t layer);
     void RecompressLayer(uint32_t aspectIndex, uint32_t layer);
 
@@ -204,8 +249,32 @@ class SubresourceStorage {
     bool& LayerCompressed(uint32_t aspectIndex, uint32_t layerIndex);
     bool LayerCompressed(uint32_t aspectIndex, uint32_t layerIndex) const;
 
-    // Return references to the data for a compressed plane / layer or subresource.
-    // Each variant should be called exactly under the correct compression level.
+    // Used for the runs of layers.
+
+    void DecompressLayerRun(LayerRun* run);
+    void RecompressLayerRun(LayerRun* run);
+
+    // Splits the runs of the aspect so that runs start at layerStart and layerEnd, and returns
+    // the range of runs that cover [layerStart, layerEnd).
+    std::pair<typename LayerRuns::iterator, typename LayerRuns::iterator>
+    SplitLayerRuns(uint32_t aspectIndex, uint32_t layerStart, uint32_t layerEnd);
+    typename LayerRuns::iterator SplitLayerRunAt(uint32_t aspectIndex, uint32_t layer);
+
+    // Merges the adjacent runs with the same data around and inside [layerStart, layerEnd), then
+    // recompresses the aspect if a single compressed run is left.
+    void RecompactLayerRuns(uint32_t aspectIndex, uint32_t layerStart, uint32_t layerEnd);
+
+    // Returns the run containing the layer. The aspect must not be compressed.
+    const LayerRun& FindLayerRun(uint32_t aspectIndex, uint32_t layer) const;
+    typename LayerRuns::iterator FindLayerRunIterator(uint32_t aspectIndex, uint32_t layer);
+
+    SubresourceRange GetLayerRunRange(Aspect aspect,
+                                      uint32_t layerStart,
+                                      const LayerRun& run) const;
+
+    // Return references to the data for a compressed aspect, or for a compressed layer or
+    // subresource in the flat per-layer arrays. Each variant should be called exactly under the
+    // correct compression level.
     T& DataInline(uint32_t aspectIndex);
     T& Data(uint32_t aspectIndex, uint32_t layer, uint32_t level = 0);
     const T& DataInline(uint32_t aspectIndex) const;
@@ -215,19 +284,21 @@ class SubresourceStorage {
     uint8_t mMipLevelCount;
     uint16_t mArrayLayerCount;
 
-    // Invariant: if an aspect is marked compressed, then all it's layers are marked as
-    // compressed.
+    // Invariant: if an aspect is marked compressed, then all its layers are marked as compressed
+    // in the flat arrays, or it doesn't have any runs. Otherwise its runs cover all its layers.
     static constexpr size_t kMaxAspects = 2;
     std::array<bool, kMaxAspects> mAspectCompressed;
     std::array<T, kMaxAspects> mInlineAspectData;
 
+    // The flat per-layer arrays, allocated the first time an aspect is decompressed.
     // Indexed as mLayerCompressed[aspectIndex * mArrayLayerCount + layer].
     std::unique_ptr<bool[]> mLayerCompressed;
-
     // Indexed as mData[(aspectIndex * mArrayLayerCount + layer) * mMipLevelCount + level].
-    // The data for a compressed aspect is stored in the slot for (aspect, 0, 0). Similarly
-    // the data for a compressed layer of aspect if in the slot for (aspect, layer, 0).
+    // The data for a compressed layer of an aspect is in the slot for (aspect, layer, 0).
     std::unique_ptr<T[]> mData;
+
+    // The runs of layers of each decompressed aspect, for arrays that don't use the flat arrays.
+    std::array<LayerRuns, kMaxAspects> mLayerRuns;
 };
 
 template <typename T>
@@ -256,9 +327,8 @@ void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc
     ASSERT(range.baseMipLevel < mMipLevelCount &&
            range.baseMipLevel + range.levelCount <= mMipLevelCount);
 
-    bool fullLayers = range.baseMipLevel == 0 && range.levelCount == mMipLevelCount;
-    bool fullAspects =
-        range.baseArrayLayer == 0 && range.layerCount == mArrayLayerCount && fullLayers;
+    bool fullAspects = range.baseArrayLayer == 0 && range.layerCount == mArrayLayerCount &&
+                       range.baseMipLevel == 0 && range.levelCount == mMipLevelCount;
 
     for (Aspect aspect : IterateEnumMask(range.aspects)) {
         uint32_t aspectIndex = GetAspectIndex(aspect);
@@ -275,40 +345,99 @@ void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc
             DecompressAspect(aspectIndex);
         }
 
-        uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
-        for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++) {
-            // Call the updateFunc once for the whole layer if possible or decompress and
-            // fallback to per-level handling.
-            if (LayerCompressed(aspectIndex, layer)) {
-                if (fullLayers) {
-                    SubresourceRange updateRange = GetFullLayerRange(aspect, layer);
-                    updateFunc(updateRange, &Data(aspectIndex, layer));
-                    continue;
-                }
-                DecompressLayer(aspectIndex, layer);
-            }
+        if (UsesLayerRuns()) {
+            UpdateLayerRuns(aspect, range, updateFunc);
+        } else {
+            UpdateFlatLayers(aspect, range, updateFunc);
+        }
+    }
+}
 
-            // Worst case: call updateFunc per level.
-            uint32_t levelEnd = range.baseMipLevel + range.levelCount;
-            for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
-                SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
-                updateFunc(updateRange, &Data(aspectIndex, layer, level));
+template <typename T>
+template <typename F>
+void SubresourceStorage<T>::UpdateFlatLayers(Aspect aspect,
+                                             const SubresourceRange& range,
+                                             F&& updateFunc) {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    bool fullLayers = range.baseMipLevel == 0 && range.levelCount == mMipLevelCount;
+    bool fullAspects =
+        range.baseArrayLayer == 0 && range.layerCount == mArrayLayerCount && fullLayers;
+
+    uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
+    for (uint32_t layer = range.baseArrayLayer; layer < layerEnd; layer++) {
+        // Call the updateFunc once for the whole layer if possible or decompress and
+        // fallback to per-level handling.
+        if (LayerCompressed(aspectIndex, layer)) {
+            if (fullLayers) {
+                SubresourceRange updateRange = GetFullLayerRange(aspect, layer);
+                updateFunc(updateRange, &Data(aspectIndex, layer));
+                continue;
             }
+            DecompressLayer(aspectIndex, layer);
+        }
+
+        // Worst case: call updateFunc per level.
+        uint32_t levelEnd = range.baseMipLevel + range.levelCount;
+        for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
+            SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
+            updateFunc(updateRange, &Data(aspectIndex, layer, level));
+        }
+
+        // If the range has fullLayers then it is likely we can recompress after the calls
+        // to updateFunc (this branch is skipped if updateFunc was called for the whole
+        // layer).
+        if (fullLayers) {
+            RecompressLayer(aspectIndex, layer);
+        }
+    }
+
+    // If the range has fullAspects then it is likely we can recompress after the calls to
+    // updateFunc (this branch is skipped if updateFunc was called for the whole aspect).
+    if (fullAspects) {
+        RecompressAspect(aspectIndex);
+    }
+}
+
+template <typename T>
+template <typename F>
+void SubresourceStorage<T>::UpdateLayerRuns(Aspect aspect,
+                                            const SubresourceRange& range,
+                                            F&& updateFunc) {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    bool fullLayers = range.baseMipLevel == 0 && range.levelCount == mMipLevelCount;
+    uint32_t layerEnd = range.baseArrayLayer + range.layerCount;
+    uint32_t levelEnd = range.baseMipLevel + range.levelCount;
+
+    auto [runsBegin, runsEnd] = SplitLayerRuns(aspectIndex, range.baseArrayLayer, layerEnd);
+    for (auto it = runsBegin; it != runsEnd; ++it) {
+        uint32_t runStart = it->first;
+        LayerRun& run = it->second;
 
-            // If the range has fullLayers then it is likely we can recompress after the calls
-            // to updateFunc (this branch is skipped if updateFunc was called for the whole
-            // layer).
+        // Call the updateFunc once for the whole run if possible or decompress and fallback
+        // to per-level handling.
+        if (run.IsCompressed()) {
             if (fullLayers) {
-                RecompressLayer(aspectIndex, layer);
+                updateFunc(GetLayerRunRange(aspect, runStart, run), &run.data);
+                continue;
             }
+            DecompressLayerRun(&run);
         }
 
-        // If the range has fullAspects then it is likely we can recompress after the calls to
-        // updateFunc (this branch is skipped if updateFunc was called for the whole aspect).
-        if (fullAspects) {
-            RecompressAspect(aspectIndex);
+        // Worst case: call updateFunc per level.
+        for (uint32_t level = range.baseMipLevel; level < levelEnd; level++) {
+            SubresourceRange updateRange(aspect, {runStart, run.layerEnd - runStart}, {level, 1});
+            updateFunc(updateRange, &run.levelData[level]);
+        }
+
+        // If the range has fullLayers then it is likely we can recompress after the calls
+        // to updateFunc (this branch is skipped if updateFunc was called for the whole run).
+        if (fullLayers) {
+            RecompressLayerRun(&run);
         }
     }
+
+    // The updated runs might now have the same data as their neighbors.
+    RecompactLayerRuns(aspectIndex, range.baseArrayLayer, layerEnd);
 }
 
 template <typename T>
@@ -338,33 +467,83 @@ void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other, F&& mergeF
             DecompressAspect(aspectIndex);
         }
 
-        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-            // Similarly to above, use a fast path if other's layer is compressed.
-            if (other.LayerCompressed(aspectIndex, layer)) {
-                const U& otherData = other.Data(aspectIndex, layer);
-                Update(GetFullLayerRange(aspect, layer),
-                       [&](const SubresourceRange& subrange, T* data) {
-                           mergeFunc(subrange, data, otherData);
-                       });
+        // Both storages have the same number of layers so they use the same representation.
+        if (UsesLayerRuns()) {
+            MergeLayerRuns(aspect, other, mergeFunc);
+        } else {
+            MergeFlatLayers(aspect, other, mergeFunc);
+        }
+    }
+}
+
+template <typename T>
+template <typename U, typename F>
+void SubresourceStorage<T>::MergeFlatLayers(Aspect aspect,
+                                            const SubresourceStorage<U>& other,
+                                            F&& mergeFunc) {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
+        bool otherLayerCompressed = other.LayerCompressed(aspectIndex, layer);
+
+        // Fast path, both layers are compressed.
+        if (otherLayerCompressed && LayerCompressed(aspectIndex, layer)) {
+            mergeFunc(GetFullLayerRange(aspect, layer), &Data(aspectIndex, layer),
+                      other.Data(aspectIndex, layer));
+            continue;
+        }
+
+        // Sad case, one of the layers is decompressed, do per-level merging.
+        if (LayerCompressed(aspectIndex, layer)) {
+            DecompressLayer(aspectIndex, layer);
+        }
+
+        for (uint32_t level = 0; level < mMipLevelCount; level++) {
+            SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
+            mergeFunc(updateRange, &Data(aspectIndex, layer, level),
+                      otherLayerCompressed ? other.Data(aspectIndex, layer)
+                                           : other.Data(aspectIndex, layer, level));
+        }
+
+        RecompressLayer(aspectIndex, layer);
+    }
+
+    RecompressAspect(aspectIndex);
+}
+
+template <typename T>
+template <typename U, typename F>
+void SubresourceStorage<T>::MergeLayerRuns(Aspect aspect,
+                                           const SubresourceStorage<U>& other,
+                                           F&& mergeFunc) {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    for (const auto& [otherStart, otherRun] : other.mLayerRuns[aspectIndex]) {
+        auto [runsBegin, runsEnd] = SplitLayerRuns(aspectIndex, otherStart, otherRun.layerEnd);
+        for (auto it = runsBegin; it != runsEnd; ++it) {
+            uint32_t runStart = it->first;
+            LayerRun& run = it->second;
+
+            // Fast path, both runs are compressed.
+            if (run.IsCompressed() && otherRun.IsCompressed()) {
+                mergeFunc(GetLayerRunRange(aspect, runStart, run), &run.data, otherRun.data);
                 continue;
             }
 
-            // Sad case, other is decompressed for this layer, do per-level merging.
-            if (LayerCompressed(aspectIndex, layer)) {
-                DecompressLayer(aspectIndex, layer);
+            // Sad case, one of the runs is decompressed, do per-level merging.
+            if (run.IsCompressed()) {
+                DecompressLayerRun(&run);
             }
-
             for (uint32_t level = 0; level < mMipLevelCount; level++) {
-                SubresourceRange updateRange = SubresourceRange::MakeSingle(aspect, layer, level);
-                mergeFunc(updateRange, &Data(aspectIndex, layer, level),
-                          other.Data(aspectIndex, layer, level));
+                SubresourceRange updateRange(aspect, {runStart, run.layerEnd - runStart},
+                                             {level, 1});
+                mergeFunc(updateRange, &run.levelData[level],
+                          otherRun.IsCompressed() ? otherRun.data : otherRun.levelData[level]);
             }
 
-            RecompressLayer(aspectIndex, layer);
+            RecompressLayerRun(&run);
         }
-
-        RecompressAspect(aspectIndex);
     }
+
+    RecompactLayerRuns(aspectIndex, 0, mArrayLayerCount);
 }
 
 template <typename T>
@@ -389,25 +568,51 @@ R SubresourceStorage<T>::Iterate(F&& iterateFunc) const {
             continue;
         }
 
-        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-            // Fast path, call iterateFunc on the whole array layer at once.
-            if (LayerCompressed(aspectIndex, layer)) {
-                SubresourceRange range = GetFullLayerRange(aspect, layer);
+        if (!UsesLayerRuns()) {
+            for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
+                // Fast path, call iterateFunc on the whole array layer at once.
+                if (LayerCompressed(aspectIndex, layer)) {
+                    SubresourceRange range = GetFullLayerRange(aspect, layer);
+                    if constexpr (mayError) {
+                        DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer)));
+                    } else {
+                        iterateFunc(range, Data(aspectIndex, layer));
+                    }
+                    continue;
+                }
+
+                // Slow path, call iterateFunc for each mip level.
+                for (uint32_t level = 0; level < mMipLevelCount; level++) {
+                    SubresourceRange range = SubresourceRange::MakeSingle(aspect, layer, level);
+                    if constexpr (mayError) {
+                        DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer, level)));
+                    } else {
+                        iterateFunc(range, Data(aspectIndex, layer, level));
+                    }
+                }
+            }
+            continue;
+        }
+
+        for (const auto& [runStart, run] : mLayerRuns[aspectIndex]) {
+            // Fast path, call iterateFunc on the whole run of array layers at once.
+            if (run.IsCompressed()) {
+                SubresourceRange range = GetLayerRunRange(aspect, runStart, run);
                 if constexpr (mayError) {
-                    DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer)));
+                    DAWN_TRY(iterateFunc(range, run.data));
                 } else {
-                    iterateFunc(range, Data(aspectIndex, layer));
+                    iterateFunc(range, run.data);
                 }
                 continue;
             }
 
             // Slow path, call iterateFunc for each mip level.
             for (uint32_t level = 0; level < mMipLevelCount; level++) {
-                SubresourceRange range = SubresourceRange::MakeSingle(aspect, layer, level);
+                SubresourceRange range(aspect, {runStart, run.layerEnd - runStart}, {level, 1});
                 if constexpr (mayError) {
-                    DAWN_TRY(iterateFunc(range, Data(aspectIndex, layer, level)));
+                    DAWN_TRY(iterateFunc(range, run.levelData[level]));
                 } else {
-                    iterateFunc(range, Data(aspectIndex, layer, level));
+                    iterateFunc(range, run.levelData[level]);
                 }
             }
         }
@@ -429,12 +634,21 @@ const T& SubresourceStorage<T>::Get(Aspect aspect, uint32_t arrayLayer, uint32_t
         return DataInline(aspectIndex);
     }
 
-    // Fast path, the array layer is compressed.
-    if (LayerCompressed(aspectIndex, arrayLayer)) {
-        return Data(aspectIndex, arrayLayer);
+    if (!UsesLayerRuns()) {
+        // Fast path, the array layer is compressed.
+        if (LayerCompressed(aspectIndex, arrayLayer)) {
+            return Data(aspectIndex, arrayLayer);
+        }
+        return Data(aspectIndex, arrayLayer, mipLevel);
+    }
+
+    // Fast path, the run of array layers is compressed.
+    const LayerRun& run = FindLayerRun(aspectIndex, arrayLayer);
+    if (run.IsCompressed()) {
+        return run.data;
     }
 
-    return Data(aspectIndex, arrayLayer, mipLevel);
+    return run.levelData[mipLevel];
 }
 
 template <typename T>
@@ -459,55 +673,124 @@ bool SubresourceStorage<T>::IsAspectCompressedForTesting(Aspect aspect) const {
 
 template <typename T>
 bool SubresourceStorage<T>::IsLayerCompressedForTesting(Aspect aspect, uint32_t layer) const {
-    return mAspectCompressed[GetAspectIndex(aspect)] ||
-           mLayerCompressed[GetAspectIndex(aspect) * mArrayLayerCount + layer];
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    if (mAspectCompressed[aspectIndex]) {
+        return true;
+    }
+    if (!UsesLayerRuns()) {
+        return LayerCompressed(aspectIndex, layer);
+    }
+    return FindLayerRun(aspectIndex, layer).IsCompressed();
+}
+
+template <typename T>
+uint32_t SubresourceStorage<T>::GetLayerRunCountForTesting(Aspect aspect) const {
+    uint32_t aspectIndex = GetAspectIndex(aspect);
+    if (mAspectCompressed[aspectIndex]) {
+        return 1;
+    }
+    // The flat arrays track each layer separately.
+    if (!UsesLayerRuns()) {
+        return mArrayLayerCount;
+    }
+    return static_cast<uint32_t>(mLayerRuns[aspectIndex].size());
+}
+
+template <typename T>
+bool SubresourceStorage<T>::UsesLayerRuns() const {
+    return mArrayLayerCount > kMaxFlatArrayLayerCount;
+}
+
+template <typename T>
+bool SubresourceStorage<T>::LayerRun::IsCompressed() const {
+    return levelData == nullptr;
+}
+
+template <typename T>
+bool SubresourceStorage<T>::LayerRun::HasSameData(const LayerRun& other,
+                                                  uint32_t levelCount) const {
+    if (IsCompressed() != other.IsCompressed()) {
+        return false;
+    }
+    if (IsCompressed()) {
+        return data == other.data;
+    }
+    for (uint32_t level = 0; level < levelCount; level++) {
+        if (!(levelData[level] == other.levelData[level])) {
+            return false;
+        }
+    }
+    return true;
 }
 
 template <typename T>
 void SubresourceStorage<T>::DecompressAspect(uint32_t aspectIndex) {
     ASSERT(mAspectCompressed[aspectIndex]);
-    const T& aspectData = DataInline(aspectIndex);
-    mAspectCompressed[aspectIndex] = false;
+    if (!UsesLayerRuns()) {
+        const T& aspectData = DataInline(aspectIndex);
+        mAspectCompressed[aspectIndex] = false;
 
-    // Extra allocations are only needed when aspects are decompressed. Create them lazily.
-    if (mData == nullptr) {
-        ASSERT(mLayerCompressed == nullptr);
+        // Extra allocations are only needed when aspects are decompressed. Create them lazily.
+        if (mData == nullptr) {
+            ASSERT(mLayerCompressed == nullptr);
 
-        uint32_t aspectCount = GetAspectCount(mAspects);
-        mLayerCompressed = std::make_unique<bool[]>(aspectCount * mArrayLayerCount);
-        mData = std::make_unique<T[]>(aspectCount * mArrayLayerCount * mMipLevelCount);
+            uint32_t aspectCount = GetAspectCount(mAspects);
+            mLayerCompressed = std::make_unique<bool[]>(aspectCount * mArrayLayerCount);
+            mData = std::make_unique<T[]>(aspectCount * mArrayLayerCount * mMipLevelCount);
 
-        for (uint32_t layerIndex = 0; layerIndex < aspectCount * mArrayLayerCount; layerIndex++) {
-            mLayerCompressed[layerIndex] = true;
+            for (uint32_t layerIndex = 0; layerIndex < aspectCount * mArrayLayerCount;
+                 layerIndex++) {
+                mLayerCompressed[layerIndex] = true;
+            }
         }
-    }
 
-    ASSERT(LayerCompressed(aspectIndex, 0));
-    for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-        Data(aspectIndex, layer) = aspectData;
-        ASSERT(LayerCompressed(aspectIndex, layer));
+        ASSERT(LayerCompressed(aspectIndex, 0));
+        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
+            Data(aspectIndex, layer) = aspectData;
+            ASSERT(LayerCompressed(aspectIndex, layer));
+        }
+        return;
     }
+
+    ASSERT(mLayerRuns[aspectIndex].empty());
+    mLayerRuns[aspectIndex].emplace(0, LayerRun{mArrayLayerCount, DataInline(aspectIndex), nullptr});
+    mAspectCompressed[aspectIndex] = false;
 }
 
 template <typename T>
 void SubresourceStorage<T>::RecompressAspect(uint32_t aspectIndex) {
     ASSERT(!mAspectCompressed[aspectIndex]);
-    // All layers of the aspect must be compressed for the aspect to possibly recompress.
-    for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
-        if (!LayerCompressed(aspectIndex, layer)) {
-            return;
+    if (!UsesLayerRuns()) {
+        // All layers of the aspect must be compressed for the aspect to possibly recompress.
+        for (uint32_t layer = 0; layer < mArrayLayerCount; layer++) {
+            if (!LayerCompressed(aspectIndex, layer)) {
+                return;
+            }
         }
-    }
 
-    T layer0Data = Data(aspectIndex, 0);
-    for (uint32_t layer = 1; layer < mArrayLayerCount; layer++) {
-        if (!(Data(aspectIndex, layer) == layer0Data)) {
-            return;
+        T layer0Data = Data(aspectIndex, 0);
+        for (uint32_t layer = 1; layer < mArrayLayerCount; layer++) {
+            if (!(Data(aspectIndex, layer) == layer0Data)) {
+                return;
+            }
         }
+
+        mAspectCompressed[aspectIndex] = true;
+        DataInline(aspectIndex) = layer0Data;
+        return;
+    }
+
+    LayerRuns& runs = mLayerRuns[aspectIndex];
+
+    // The aspect can only be recompressed if a single compressed run covers all its layers.
+    if (runs.size() != 1 || !runs.begin()->second.IsCompressed()) {
+        return;
     }
+    ASSERT(runs.begin()->first == 0 && runs.begin()->second.layerEnd == mArrayLayerCount);
 
     mAspectCompressed[aspectIndex] = true;
-    DataInline(aspectIndex) = layer0Data;
+    DataInline(aspectIndex) = std::move(runs.begin()->second.data);
+    runs.clear();
 }
 
 template <typename T>
@@ -556,6 +839,126 @@ bool SubresourceStorage<T>::LayerCompressed(uint32_t aspectIndex, uint32_t layer
     return mLayerCompressed[aspectIndex * mArrayLayerCount + layer];
 }
 
+template <typename T>
+void SubresourceStorage<T>::DecompressLayerRun(LayerRun* run) {
+    ASSERT(run->IsCompressed());
+    run->levelData = std::make_unique<T[]>(mMipLevelCount);
+    for (uint32_t level = 0; level < mMipLevelCount; level++) {
+        run->levelData[level] = run->data;
+    }
+}
+
+template <typename T>
+void SubresourceStorage<T>::RecompressLayerRun(LayerRun* run) {
+    ASSERT(!run->IsCompressed());
+    const T& level0Data = run->levelData[0];
+
+    for (uint32_t level = 1; level < mMipLevelCount; level++) {
+        if (!(run->levelData[level] == level0Data)) {
+            return;
+        }
+    }
+
+    run->data = level0Data;
+    run->levelData = nullptr;
+}
+
+template <typename T>
+std::pair<typename SubresourceStorage<T>::LayerRuns::iterator,
+          typename SubresourceStorage<T>::LayerRuns::iterator>
+SubresourceStorage<T>::SplitLayerRuns(uint32_t aspectIndex,
+                                      uint32_t layerStart,
+                                      uint32_t layerEnd) {
+    ASSERT(layerStart < layerEnd && layerEnd <= mArrayLayerCount);
+    typename LayerRuns::iterator begin = SplitLayerRunAt(aspectIndex, layerStart);
+    typename LayerRuns::iterator end = layerEnd == mArrayLayerCount
+                                           ? mLayerRuns[aspectIndex].end()
+                                           : SplitLayerRunAt(aspectIndex, layerEnd);
+    return {begin, end};
+}
+
+template <typename T>
+typename SubresourceStorage<T>::LayerRuns::iterator SubresourceStorage<T>::SplitLayerRunAt(
+    uint32_t aspectIndex,
+    uint32_t layer) {
+    typename LayerRuns::iterator it = FindLayerRunIterator(aspectIndex, layer);
+    if (it->first == layer) {
+        return it;
+    }
+
+    // The second half of the run starts with a copy of its data.
+    const LayerRun& firstHalf = it->second;
+    LayerRun secondHalf{firstHalf.layerEnd, firstHalf.data, nullptr};
+    if (!firstHalf.IsCompressed()) {
+        secondHalf.levelData = std::make_unique<T[]>(mMipLevelCount);
+        for (uint32_t level = 0; level < mMipLevelCount; level++) {
+            secondHalf.levelData[level] = firstHalf.levelData[level];
+        }
+    }
+    it->second.layerEnd = layer;
+    return mLayerRuns[aspectIndex].emplace_hint(std::next(it), layer, std::move(secondHalf));
+}
+
+template <typename T>
+void SubresourceStorage<T>::RecompactLayerRuns(uint32_t aspectIndex,
+                                               uint32_t layerStart,
+                                               uint32_t layerEnd) {
+    LayerRuns& runs = mLayerRuns[aspectIndex];
+
+    // Start from the run before layerStart since it might have the same data as the first run
+    // of the range, and stop after the run starting at layerEnd for the same reason.
+    typename LayerRuns::iterator it =
+        FindLayerRunIterator(aspectIndex, layerStart == 0 ? 0 : layerStart - 1);
+    while (true) {
+        typename LayerRuns::iterator next = std::next(it);
+        if (next == runs.end() || next->first > layerEnd) {
+            break;
+        }
+        if (it->second.HasSameData(next->second, mMipLevelCount)) {
+            it->second.layerEnd = next->second.layerEnd;
+            runs.erase(next);
+        } else {
+            it = next;
+        }
+    }
+
+    RecompressAspect(aspectIndex);
+}
+
+template <typename T>
+const typename SubresourceStorage<T>::LayerRun& SubresourceStorage<T>::FindLayerRun(
+    uint32_t aspectIndex,
+    uint32_t layer) const {
+    ASSERT(!mAspectCompressed[aspectIndex]);
+    // The run containing the layer is the last one starting at or before it.
+    const LayerRuns& runs = mLayerRuns[aspectIndex];
+    auto it = runs.upper_bound(layer);
+    ASSERT(it != runs.begin());
+    --it;
+    ASSERT(it->first <= layer && layer < it->second.layerEnd);
+    return it->second;
+}
+
+template <typename T>
+typename SubresourceStorage<T>::LayerRuns::iterator SubresourceStorage<T>::FindLayerRunIterator(
+    uint32_t aspectIndex,
+    uint32_t layer) {
+    ASSERT(!mAspectCompressed[aspectIndex]);
+    LayerRuns& runs = mLayerRuns[aspectIndex];
+    typename LayerRuns::iterator it = runs.upper_bound(layer);
+    ASSERT(it != runs.begin());
+    --it;
+    ASSERT(it->first <= layer && layer < it->second.layerEnd);
+    return it;
+}
+
+template <typename T>
+SubresourceRange SubresourceStorage<T>::GetLayerRunRange(Aspect aspect,
+                                                         uint32_t layerStart,
+                                                         const LayerRun& run) const {
+    return {aspect, {layerStart, run.layerEnd - layerStart}, {0, mMipLevelCount}};
+}
+
 template <typename T>
 T& SubresourceStorage<T>::DataInline(uint32_t aspectIndex) {
     ASSERT(mAspectCompressed[aspectIndex]);
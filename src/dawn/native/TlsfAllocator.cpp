@@ -0,0 +1,295 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/TlsfAllocator.h"
+
+#include <algorithm>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::native {
+
+namespace {
+
+uint32_t ScanForward64(uint64_t bits) {
+    ASSERT(bits != 0);
+    uint32_t low = static_cast<uint32_t>(bits);
+    if (low != 0) {
+        return ScanForward(low);
+    }
+    return 32 + ScanForward(static_cast<uint32_t>(bits >> 32));
+}
+
+}  // anonymous namespace
+
+TlsfAllocator::TlsfAllocator(uint64_t size) : mSize(size) {
+    ASSERT(size != 0);
+
+    mFirstBlock = new Block{/*offset*/ 0, size};
+    InsertFreeBlock(mFirstBlock);
+}
+
+TlsfAllocator::~TlsfAllocator() {
+    Block* block = mFirstBlock;
+    while (block != nullptr) {
+        Block* next = block->nextPhysical;
+        delete block;
+        block = next;
+    }
+}
+
+// static
+TlsfAllocator::SizeClass TlsfAllocator::ComputeSizeClass(uint64_t size) {
+    ASSERT(size != 0);
+    if (size < kSecondLevelCount) {
+        return {0, static_cast<uint32_t>(size)};
+    }
+
+    // The second level is given by the kSecondLevelBits bits after the most significant one.
+    uint32_t log2Size = Log2(size);
+    uint32_t secondLevel =
+        static_cast<uint32_t>(size >> (log2Size - kSecondLevelBits)) - kSecondLevelCount;
+    return {log2Size - kSecondLevelBits + 1, secondLevel};
+}
+
+TlsfAllocator::Block* TlsfAllocator::FindFreeBlock(uint64_t minimumSize) const {
+    ASSERT(minimumSize != 0 && minimumSize <= mSize);
+
+    // Blocks in a free list have sizes anywhere in the range of its size class, so round up the
+    // size to the next size class to be sure that any block found is large enough.
+    if (minimumSize >= kSecondLevelCount) {
+        minimumSize += (uint64_t(1) << (Log2(minimumSize) - kSecondLevelBits)) - 1;
+    }
+    SizeClass sizeClass = ComputeSizeClass(minimumSize);
+    if (sizeClass.firstLevel >= kFirstLevelCount) {
+        return nullptr;
+    }
+
+    // Look for a non-empty list in the same first level first, then in the larger ones.
+    uint32_t secondLevelBitmap =
+        mSecondLevelBitmaps[sizeClass.firstLevel] & (~0u << sizeClass.secondLevel);
+    if (secondLevelBitmap == 0) {
+        if (sizeClass.firstLevel + 1 >= kFirstLevelCount) {
+            return nullptr;
+        }
+        uint64_t firstLevelBitmap =
+            mFirstLevelBitmap & (~uint64_t(0) << (sizeClass.firstLevel + 1));
+        if (firstLevelBitmap == 0) {
+            return nullptr;
+        }
+        sizeClass.firstLevel = ScanForward64(firstLevelBitmap);
+        secondLevelBitmap = mSecondLevelBitmaps[sizeClass.firstLevel];
+    }
+
+    ASSERT(secondLevelBitmap != 0);
+    Block* block = mFreeLists[sizeClass.firstLevel][ScanForward(secondLevelBitmap)];
+    ASSERT(block != nullptr && block->isFree);
+    return block;
+}
+
+void TlsfAllocator::InsertFreeBlock(Block* block) {
+    SizeClass sizeClass = ComputeSizeClass(block->size);
+    Block*& head = mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel];
+
+    block->isFree = true;
+    block->prevFree = nullptr;
+    block->nextFree = head;
+    if (head != nullptr) {
+        head->prevFree = block;
+    }
+    head = block;
+
+    mSecondLevelBitmaps[sizeClass.firstLevel] |= 1u << sizeClass.secondLevel;
+    mFirstLevelBitmap |= uint64_t(1) << sizeClass.firstLevel;
+}
+
+void TlsfAllocator::RemoveFreeBlock(Block* block) {
+    ASSERT(block->isFree);
+    SizeClass sizeClass = ComputeSizeClass(block->size);
+
+    if (block->prevFree != nullptr) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        ASSERT(mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel] == block);
+        mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel] = block->nextFree;
+    }
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    block->prevFree = nullptr;
+    block->nextFree = nullptr;
+    block->isFree = false;
+
+    if (mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel] == nullptr) {
+        mSecondLevelBitmaps[sizeClass.firstLevel] &= ~(1u << sizeClass.secondLevel);
+        if (mSecondLevelBitmaps[sizeClass.firstLevel] == 0) {
+            mFirstLevelBitmap &= ~(uint64_t(1) << sizeClass.firstLevel);
+        }
+    }
+}
+
+uint64_t TlsfAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
+    ASSERT(IsPowerOfTwo(alignment));
+    if (allocationSize == 0 || allocationSize > mSize) {
+        return kInvalidOffset;
+    }
+
+    auto FitsInBlock = [&](const Block* block) {
+        return Align(block->offset, alignment) + allocationSize <= block->offset + block->size;
+    };
+
+    // Most free blocks are already aligned because the allocations of a given allocator usually
+    // have the same alignment. Only when the block found doesn't fit the aligned allocation,
+    // look for a block large enough for any alignment of the allocation.
+    Block* block = FindFreeBlock(allocationSize);
+    if (block != nullptr && !FitsInBlock(block)) {
+        block = nullptr;
+        if (alignment - 1 <= mSize - allocationSize) {
+            block = FindFreeBlock(allocationSize + alignment - 1);
+        }
+    }
+
+    // FindFreeBlock skips the size class of the allocation because it contains blocks that are
+    // too small, but it can also contain blocks that fit, like the whole free allocator when
+    // allocating its size. Look for them as a last resort.
+    if (block == nullptr) {
+        SizeClass sizeClass = ComputeSizeClass(allocationSize);
+        for (Block* candidate = mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel];
+             candidate != nullptr; candidate = candidate->nextFree) {
+            if (FitsInBlock(candidate)) {
+                block = candidate;
+                break;
+            }
+        }
+    }
+    if (block == nullptr) {
+        return kInvalidOffset;
+    }
+    ASSERT(FitsInBlock(block));
+
+    RemoveFreeBlock(block);
+
+    // Split the start of the block that's skipped for alignment in a free block. There is no
+    // need to merge it since the previous block can't be free: it would have been merged with
+    // this block.
+    uint64_t alignedOffset = Align(block->offset, alignment);
+    if (alignedOffset != block->offset) {
+        ASSERT(block->prevPhysical == nullptr || !block->prevPhysical->isFree);
+        Block* padding = new Block{block->offset, alignedOffset - block->offset};
+        padding->prevPhysical = block->prevPhysical;
+        padding->nextPhysical = block;
+        if (block->prevPhysical != nullptr) {
+            block->prevPhysical->nextPhysical = padding;
+        } else {
+            mFirstBlock = padding;
+        }
+        block->prevPhysical = padding;
+        block->offset = alignedOffset;
+        block->size -= padding->size;
+        InsertFreeBlock(padding);
+    }
+
+    // Split the end of the block that isn't needed for the allocation in a free block. The same
+    // way, the next block can't be free.
+    if (block->size > allocationSize) {
+        ASSERT(block->nextPhysical == nullptr || !block->nextPhysical->isFree);
+        Block* remainder = new Block{block->offset + allocationSize, block->size - allocationSize};
+        remainder->prevPhysical = block;
+        remainder->nextPhysical = block->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = remainder;
+        }
+        block->nextPhysical = remainder;
+        block->size = allocationSize;
+        InsertFreeBlock(remainder);
+    }
+
+    mAllocatedBlocks[block->offset] = block;
+    mUsedSize += block->size;
+    return block->offset;
+}
+
+void TlsfAllocator::Deallocate(uint64_t offset) {
+    auto it = mAllocatedBlocks.find(offset);
+    ASSERT(it != mAllocatedBlocks.end());
+    Block* block = it->second;
+    mAllocatedBlocks.erase(it);
+
+    ASSERT(!block->isFree);
+    mUsedSize -= block->size;
+
+    // Merge the block with the free blocks around it.
+    Block* prev = block->prevPhysical;
+    if (prev != nullptr && prev->isFree) {
+        RemoveFreeBlock(prev);
+        prev->size += block->size;
+        prev->nextPhysical = block->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = prev;
+        }
+        delete block;
+        block = prev;
+    }
+
+    Block* next = block->nextPhysical;
+    if (next != nullptr && next->isFree) {
+        RemoveFreeBlock(next);
+        block->size += next->size;
+        block->nextPhysical = next->nextPhysical;
+        if (next->nextPhysical != nullptr) {
+            next->nextPhysical->prevPhysical = block;
+        }
+        delete next;
+    }
+
+    InsertFreeBlock(block);
+}
+
+uint64_t TlsfAllocator::GetSize() const {
+    return mSize;
+}
+
+uint64_t TlsfAllocator::GetUsedSize() const {
+    return mUsedSize;
+}
+
+uint64_t TlsfAllocator::ComputeLargestFreeBlockSize() const {
+    if (mFirstLevelBitmap == 0) {
+        return 0;
+    }
+
+    // The largest free block is in the last non-empty free list, but the blocks in a list can
+    // have any size in its size class.
+    uint32_t firstLevel = Log2(mFirstLevelBitmap);
+    uint32_t secondLevel = Log2(mSecondLevelBitmaps[firstLevel]);
+    uint64_t largestSize = 0;
+    for (const Block* block = mFreeLists[firstLevel][secondLevel]; block != nullptr;
+         block = block->nextFree) {
+        largestSize = std::max(largestSize, block->size);
+    }
+    return largestSize;
+}
+
+uint64_t TlsfAllocator::ComputeTotalNumOfFreeBlocksForTesting() const {
+    uint64_t count = 0;
+    for (const Block* block = mFirstBlock; block != nullptr; block = block->nextPhysical) {
+        if (block->isFree) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace dawn::native
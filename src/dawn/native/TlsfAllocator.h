@@ -0,0 +1,106 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace dawn::native {
+
+// TLSF allocator uses the two-level segregated fit technique to satisfy an allocation request
+// in a range of offsets [0, size). Unlike the BuddyAllocator, blocks are split to exactly the
+// allocation size so there is no internal fragmentation for sizes that aren't powers of two.
+//
+// Free blocks are kept in segregated free lists indexed by two levels: the first level is the
+// power-of-two range the size of the block falls in, and the second level linearly subdivides
+// that range in kSecondLevelCount classes. Bitmaps of the non-empty lists make finding a free
+// block large enough for an allocation, and inserting or removing a free block, O(1). Blocks are
+// also linked in offset order so that free blocks are merged with their neighbors on
+// deallocation.
+class TlsfAllocator {
+  public:
+    explicit TlsfAllocator(uint64_t size);
+    ~TlsfAllocator();
+
+    TlsfAllocator(const TlsfAllocator&) = delete;
+    TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+
+    // Required methods.
+    uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
+    void Deallocate(uint64_t offset);
+
+    uint64_t GetSize() const;
+    // Sum of the sizes of the live allocations.
+    uint64_t GetUsedSize() const;
+    // Size of the largest allocation with an alignment of 1 that would currently succeed.
+    uint64_t ComputeLargestFreeBlockSize() const;
+
+    // For testing purposes only.
+    uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
+
+    static constexpr uint64_t kInvalidOffset = std::numeric_limits<uint64_t>::max();
+
+  private:
+    static constexpr uint32_t kSecondLevelBits = 4;
+    static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelBits;
+    // Sizes smaller than kSecondLevelCount all go in the first level 0, with one second level
+    // per size. Larger sizes go in the first level Log2(size) - kSecondLevelBits + 1.
+    static constexpr uint32_t kFirstLevelCount = 64 - kSecondLevelBits + 1;
+
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+        bool isFree = true;
+
+        // Neighbors in offset order, used to merge free blocks.
+        Block* prevPhysical = nullptr;
+        Block* nextPhysical = nullptr;
+
+        // Links in the free list of the block's size class, only valid when the block is free.
+        Block* prevFree = nullptr;
+        Block* nextFree = nullptr;
+    };
+
+    struct SizeClass {
+        uint32_t firstLevel;
+        uint32_t secondLevel;
+    };
+    static SizeClass ComputeSizeClass(uint64_t size);
+
+    Block* FindFreeBlock(uint64_t minimumSize) const;
+    void InsertFreeBlock(Block* block);
+    void RemoveFreeBlock(Block* block);
+
+    uint64_t mSize = 0;
+    uint64_t mUsedSize = 0;
+
+    // The block at offset 0, to walk over all the blocks.
+    Block* mFirstBlock = nullptr;
+
+    // Bit N of mFirstLevelBitmap is set iff mSecondLevelBitmaps[N] is non-zero, and bit M of
+    // mSecondLevelBitmaps[N] is set iff mFreeLists[N][M] is non-empty.
+    uint64_t mFirstLevelBitmap = 0;
+    std::array<uint32_t, kFirstLevelCount> mSecondLevelBitmaps = {};
+    std::array<std::array<Block*, kSecondLevelCount>, kFirstLevelCount> mFreeLists = {};
+
+    std::unordered_map<uint64_t, Block*> mAllocatedBlocks;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
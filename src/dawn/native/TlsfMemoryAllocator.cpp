@@ -0,0 +1,219 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/native/TlsfMemoryAllocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/native/ResourceHeapAllocator.h"
+
+namespace dawn::native {
+
+TlsfMemoryAllocator::TlsfMemoryAllocator(uint64_t maxSystemSize,
+                                         uint64_t memoryBlockSize,
+                                         ResourceHeapAllocator* heapAllocator)
+    : mMemoryBlockSize(memoryBlockSize),
+      mMaxBlockCount(maxSystemSize / memoryBlockSize),
+      mHeapAllocator(heapAllocator) {
+    ASSERT(memoryBlockSize != 0);
+    ASSERT(memoryBlockSize <= maxSystemSize);
+}
+
+TlsfMemoryAllocator::~TlsfMemoryAllocator() = default;
+
+ResultOrError<ResourceMemoryAllocation> TlsfMemoryAllocator::Allocate(uint64_t allocationSize,
+                                                                      uint64_t alignment) {
+    if (allocationSize == 0 || allocationSize > mMemoryBlockSize) {
+        return ResourceMemoryAllocation{};
+    }
+
+    // Try the memory blocks in order so that allocations are packed in the first ones and the
+    // last ones have more chances to become empty and be released.
+    uint64_t unusedBlockIndex = kInvalidBlockIndex;
+    for (uint64_t i = 0; i < mMemoryBlocks.size(); ++i) {
+        if (mMemoryBlocks[i].allocator == nullptr) {
+            unusedBlockIndex = std::min(unusedBlockIndex, i);
+            continue;
+        }
+        ResourceMemoryAllocation allocation = AllocateInBlock(i, allocationSize, alignment);
+        if (allocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            return allocation;
+        }
+    }
+
+    if (unusedBlockIndex == kInvalidBlockIndex) {
+        if (mMemoryBlocks.size() >= mMaxBlockCount) {
+            return ResourceMemoryAllocation{};
+        }
+        unusedBlockIndex = mMemoryBlocks.size();
+        mMemoryBlocks.emplace_back();
+    }
+
+    // Transfer ownership to this allocator
+    MemoryBlock& block = mMemoryBlocks[unusedBlockIndex];
+    DAWN_TRY_ASSIGN(block.heap, mHeapAllocator->AllocateResourceHeap(mMemoryBlockSize));
+    block.allocator = std::make_unique<TlsfAllocator>(mMemoryBlockSize);
+    mBlockCount++;
+    mEmptyBlockCount++;
+
+    ResourceMemoryAllocation allocation =
+        AllocateInBlock(unusedBlockIndex, allocationSize, alignment);
+    ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+    return allocation;
+}
+
+ResourceMemoryAllocation TlsfMemoryAllocator::AllocateForRelocation(uint64_t allocationSize,
+                                                                    uint64_t alignment,
+                                                                    uint64_t excludedBlockIndex) {
+    if (allocationSize == 0 || allocationSize > mMemoryBlockSize) {
+        return ResourceMemoryAllocation{};
+    }
+
+    for (uint64_t i = 0; i < mMemoryBlocks.size(); ++i) {
+        // Moving allocations to an empty block wouldn't reduce the number of blocks.
+        const MemoryBlock& block = mMemoryBlocks[i];
+        if (i == excludedBlockIndex || block.allocator == nullptr ||
+            block.allocator->GetUsedSize() == 0) {
+            continue;
+        }
+        ResourceMemoryAllocation allocation = AllocateInBlock(i, allocationSize, alignment);
+        if (allocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            return allocation;
+        }
+    }
+    return ResourceMemoryAllocation{};
+}
+
+ResourceMemoryAllocation TlsfMemoryAllocator::AllocateInBlock(uint64_t blockIndex,
+                                                              uint64_t allocationSize,
+                                                              uint64_t alignment) {
+    MemoryBlock& block = mMemoryBlocks[blockIndex];
+    bool wasEmpty = block.allocator->GetUsedSize() == 0;
+
+    const uint64_t offset = block.allocator->Allocate(allocationSize, alignment);
+    if (offset == TlsfAllocator::kInvalidOffset) {
+        return ResourceMemoryAllocation{};
+    }
+
+    if (wasEmpty) {
+        ASSERT(mEmptyBlockCount > 0);
+        mEmptyBlockCount--;
+    }
+    mUsedSize += allocationSize;
+
+    AllocationInfo info;
+    info.mBlockOffset = blockIndex * mMemoryBlockSize + offset;
+    info.mMethod = AllocationMethod::kSubAllocated;
+
+    // Allocation offset is always local to the memory.
+    return ResourceMemoryAllocation{info, offset, block.heap.get()};
+}
+
+void TlsfMemoryAllocator::Deallocate(const ResourceMemoryAllocation& allocation) {
+    const AllocationInfo info = allocation.GetInfo();
+    ASSERT(info.mMethod == AllocationMethod::kSubAllocated);
+
+    const uint64_t blockIndex = GetBlockIndex(allocation);
+    MemoryBlock& block = mMemoryBlocks[blockIndex];
+    ASSERT(block.allocator != nullptr && block.heap.get() == allocation.GetResourceHeap());
+
+    uint64_t usedSizeBefore = block.allocator->GetUsedSize();
+    block.allocator->Deallocate(allocation.GetOffset());
+    mUsedSize -= usedSizeBefore - block.allocator->GetUsedSize();
+
+    if (block.allocator->GetUsedSize() != 0) {
+        return;
+    }
+
+    // Keep a single empty block around for the next allocations.
+    if (mEmptyBlockCount == 0) {
+        mEmptyBlockCount++;
+        return;
+    }
+
+    mHeapAllocator->DeallocateResourceHeap(std::move(block.heap));
+    block.allocator = nullptr;
+    mBlockCount--;
+}
+
+void TlsfMemoryAllocator::ReleaseEmptyBlocks() {
+    for (MemoryBlock& block : mMemoryBlocks) {
+        if (block.allocator != nullptr && block.allocator->GetUsedSize() == 0) {
+            mHeapAllocator->DeallocateResourceHeap(std::move(block.heap));
+            block.allocator = nullptr;
+            mBlockCount--;
+            mEmptyBlockCount--;
+        }
+    }
+    ASSERT(mEmptyBlockCount == 0);
+}
+
+uint64_t TlsfMemoryAllocator::FindBlockToEvacuate() const {
+    uint64_t leastUsedBlockIndex = kInvalidBlockIndex;
+    uint64_t leastUsedSize = mMemoryBlockSize;
+    uint64_t totalFreeSize = 0;
+    for (uint64_t i = 0; i < mMemoryBlocks.size(); ++i) {
+        const MemoryBlock& block = mMemoryBlocks[i];
+        if (block.allocator == nullptr || block.allocator->GetUsedSize() == 0) {
+            continue;
+        }
+        uint64_t usedSize = block.allocator->GetUsedSize();
+        totalFreeSize += mMemoryBlockSize - usedSize;
+        if (usedSize < leastUsedSize) {
+            leastUsedSize = usedSize;
+            leastUsedBlockIndex = i;
+        }
+    }
+
+    if (leastUsedBlockIndex == kInvalidBlockIndex) {
+        return kInvalidBlockIndex;
+    }
+
+    // The free space of the least used block itself doesn't count.
+    uint64_t otherFreeSize = totalFreeSize - (mMemoryBlockSize - leastUsedSize);
+    if (leastUsedSize > otherFreeSize) {
+        return kInvalidBlockIndex;
+    }
+    return leastUsedBlockIndex;
+}
+
+uint64_t TlsfMemoryAllocator::GetBlockIndex(const ResourceMemoryAllocation& allocation) const {
+    ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+    return allocation.GetInfo().mBlockOffset / mMemoryBlockSize;
+}
+
+uint64_t TlsfMemoryAllocator::GetMemoryBlockSize() const {
+    return mMemoryBlockSize;
+}
+
+uint64_t TlsfMemoryAllocator::GetBlockCount() const {
+    return mBlockCount;
+}
+
+uint64_t TlsfMemoryAllocator::GetUsedSize() const {
+    return mUsedSize;
+}
+
+uint64_t TlsfMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
+    uint64_t count = 0;
+    for (const MemoryBlock& block : mMemoryBlocks) {
+        if (block.heap != nullptr) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,98 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "dawn/native/Error.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
+#include "dawn/native/TlsfAllocator.h"
+
+namespace dawn::native {
+
+class ResourceHeapAllocator;
+
+// TlsfMemoryAllocator sub-allocates blocks of device memory created by ResourceHeapAllocator
+// clients, using a TlsfAllocator per memory block. Allocations are made in the first memory
+// block that has room for them, and a new memory block is created when none does.
+//
+// A memory block is released as soon as it becomes empty, except for one empty block that is
+// kept to avoid repeatedly creating and releasing memory when a single resource is created and
+// destroyed in a loop.
+//
+// Like for the BuddyMemoryAllocator, the block offset of the allocations is the offset in the
+// memory block plus the index of the memory block times the memory block size.
+class TlsfMemoryAllocator {
+  public:
+    TlsfMemoryAllocator(uint64_t maxSystemSize,
+                        uint64_t memoryBlockSize,
+                        ResourceHeapAllocator* heapAllocator);
+    ~TlsfMemoryAllocator();
+
+    ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize, uint64_t alignment);
+    void Deallocate(const ResourceMemoryAllocation& allocation);
+
+    // Releases the empty memory block kept for the next allocations, if any.
+    void ReleaseEmptyBlocks();
+
+    // Allocates only in the memory blocks that are in use, other than excludedBlockIndex. Returns
+    // an invalid allocation if none has room for it. Used to move allocations out of the memory
+    // block returned by FindBlockToEvacuate.
+    ResourceMemoryAllocation AllocateForRelocation(uint64_t allocationSize,
+                                                   uint64_t alignment,
+                                                   uint64_t excludedBlockIndex);
+
+    // Returns the index of the least used memory block if its allocations could fit in the free
+    // space of the other memory blocks in use, or kInvalidBlockIndex.
+    uint64_t FindBlockToEvacuate() const;
+    uint64_t GetBlockIndex(const ResourceMemoryAllocation& allocation) const;
+
+    uint64_t GetMemoryBlockSize() const;
+    uint64_t GetBlockCount() const;
+    uint64_t GetUsedSize() const;
+
+    // For testing purposes.
+    uint64_t ComputeTotalNumOfHeapsForTesting() const;
+
+    static constexpr uint64_t kInvalidBlockIndex = std::numeric_limits<uint64_t>::max();
+
+  private:
+    struct MemoryBlock {
+        // Both are null when the memory block isn't allocated.
+        std::unique_ptr<TlsfAllocator> allocator;
+        std::unique_ptr<ResourceHeapBase> heap;
+    };
+
+    ResourceMemoryAllocation AllocateInBlock(uint64_t blockIndex,
+                                             uint64_t allocationSize,
+                                             uint64_t alignment);
+
+    uint64_t mMemoryBlockSize = 0;
+    uint64_t mMaxBlockCount = 0;
+
+    ResourceHeapAllocator* mHeapAllocator;
+
+    std::vector<MemoryBlock> mMemoryBlocks;
+    uint64_t mBlockCount = 0;
+    uint64_t mEmptyBlockCount = 0;
+    uint64_t mUsedSize = 0;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
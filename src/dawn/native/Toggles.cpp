@@ -449,6 +449,31 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
       "Create D3D12 heap with D3D12_HEAP_FLAG_CREATE_NOT_ZEROED when it is supported. It is safe "
       "because in Dawn we always clear the resources manually when needed.",
       "https://crbug.com/dawn/484", ToggleStage::Device}},
+    {Toggle::NullExecuteComputeOnCPU,
+     {"null_execute_compute_on_cpu",
+      "Execute compute passes and buffer-to-buffer copies on the CPU in the Null backend, using a "
+      "reference interpreter of the shader. Workgroups are distributed over the worker task pool. "
+      "This makes the Null backend produce real results for compute workloads.",
+      "https://bugs.chromium.org/p/dawn/issues/list?q=null_execute_compute_on_cpu",
+      ToggleStage::Device}},
+    {Toggle::VulkanRecordCommandBuffersInParallel,
+     {"vulkan_record_command_buffers_in_parallel",
+      "Record the command buffers of a Queue::Submit into separate VkCommandBuffers on the worker "
+      "task pool when they don't use any resource in common. The VkCommandBuffers are submitted "
+      "in the order of the command buffers so the result is the same as recording serially.",
+      "https://crbug.com/dawn/1662", ToggleStage::Device}},
+    {Toggle::VulkanUseTlsfSuballocation,
+     {"vulkan_use_tlsf_suballocation",
+      "Suballocate resources in memory blocks with a two-level segregated fit allocator instead "
+      "of a buddy allocator. Resources whose sizes aren't powers of two waste less memory, and the "
+      "memory blocks are released when they become empty instead of being kept in a pool.",
+      "https://crbug.com/dawn/849", ToggleStage::Device}},
+    {Toggle::VulkanDefragmentBufferMemory,
+     {"vulkan_defragment_buffer_memory",
+      "When the device is idle, move the suballocated buffers out of the least used memory block "
+      "into the other memory blocks so that it can be released. Only has an effect when "
+      "vulkan_use_tlsf_suballocation is enabled.",
+      "https://crbug.com/dawn/849", ToggleStage::Device}},
     {Toggle::NoWorkaroundSampleMaskBecomesZeroForAllButLastColorTarget,
      {"no_workaround_sample_mask_becomes_zero_for_all_but_last_color_target",
       "MacOS 12.0+ Intel has a bug where the sample mask is only applied for the last color "
@@ -104,6 +104,10 @@ enum class Toggle {
     D3D12Use64KBAlignedMSAATexture,
     ResolveMultipleAttachmentInSeparatePasses,
     D3D12CreateNotZeroedHeap,
+    NullExecuteComputeOnCPU,
+    VulkanRecordCommandBuffersInParallel,
+    VulkanUseTlsfSuballocation,
+    VulkanDefragmentBufferMemory,
 
     // Unresolved issues.
     NoWorkaroundSampleMaskBecomesZeroForAllButLastColorTarget,
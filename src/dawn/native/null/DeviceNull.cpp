@@ -14,15 +14,19 @@
 
 #include "dawn/native/null/DeviceNull.h"
 
+#include <algorithm>
 #include <limits>
+#include <thread>
 #include <utility>
 
+#include "dawn/common/BitSetIterator.h"
 #include "dawn/native/BackendConnection.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/ErrorData.h"
 #include "dawn/native/Instance.h"
 #include "dawn/native/Surface.h"
 #include "dawn/native/TintUtils.h"
+#include "dawn/platform/DawnPlatform.h"
 
 #include "tint/tint.h"
 
@@ -69,7 +73,12 @@ MaybeError PhysicalDevice::InitializeSupportedLimitsImpl(CombinedLimits* limits)
 
 void PhysicalDevice::SetupBackendAdapterToggles(TogglesState* adpterToggles) const {}
 
-void PhysicalDevice::SetupBackendDeviceToggles(TogglesState* deviceToggles) const {}
+void PhysicalDevice::SetupBackendDeviceToggles(TogglesState* deviceToggles) const {
+#if !TINT_BUILD_IR
+    // Executing compute passes on the CPU requires the Tint IR interpreter.
+    deviceToggles->ForceSet(Toggle::NullExecuteComputeOnCPU, false);
+#endif  // !TINT_BUILD_IR
+}
 
 ResultOrError<Ref<DeviceBase>> PhysicalDevice::CreateDeviceImpl(AdapterBase* adapter,
                                                                 const DeviceDescriptor* descriptor,
@@ -318,7 +327,7 @@ BindGroupLayout::BindGroupLayout(DeviceBase* device, const BindGroupLayoutDescri
 
 Buffer::Buffer(Device* device, const BufferDescriptor* descriptor)
     : BufferBase(device, descriptor) {
-    mBackingData = std::unique_ptr<uint8_t[]>(new uint8_t[GetSize()]);
+    mBackingData = std::unique_ptr<uint8_t[]>(new uint8_t[GetSize()]());
     mAllocatedSize = GetSize();
 }
 
@@ -354,6 +363,10 @@ void* Buffer::GetMappedPointer() {
     return mBackingData.get();
 }
 
+uint8_t* Buffer::GetBackingData() {
+    return mBackingData.get();
+}
+
 void Buffer::UnmapImpl() {}
 
 void Buffer::DestroyImpl() {
@@ -366,6 +379,213 @@ void Buffer::DestroyImpl() {
 CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
     : CommandBufferBase(encoder, descriptor) {}
 
+MaybeError CommandBuffer::Execute() {
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::BeginComputePass: {
+                mCommands.NextCommand<BeginComputePassCmd>();
+                DAWN_TRY(ExecuteComputePass());
+                break;
+            }
+
+            case Command::CopyBufferToBuffer: {
+                CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
+                if (copy->size == 0) {
+                    break;
+                }
+                memmove(ToBackend(copy->destination)->GetBackingData() + copy->destinationOffset,
+                        ToBackend(copy->source)->GetBackingData() + copy->sourceOffset,
+                        copy->size);
+                break;
+            }
+
+            case Command::ClearBuffer: {
+                ClearBufferCmd* cmd = mCommands.NextCommand<ClearBufferCmd>();
+                if (cmd->size == 0) {
+                    break;
+                }
+                memset(ToBackend(cmd->buffer)->GetBackingData() + cmd->offset, 0, cmd->size);
+                break;
+            }
+
+            case Command::WriteBuffer: {
+                WriteBufferCmd* write = mCommands.NextCommand<WriteBufferCmd>();
+                // The inlined data is recorded even for empty writes.
+                uint8_t* data = mCommands.NextData<uint8_t>(write->size);
+                if (write->size == 0) {
+                    break;
+                }
+                memcpy(ToBackend(write->buffer)->GetBackingData() + write->offset, data,
+                       write->size);
+                break;
+            }
+
+            case Command::InsertDebugMarker:
+            case Command::PopDebugGroup:
+            case Command::PushDebugGroup:
+                SkipCommand(&mCommands, type);
+                break;
+
+            case Command::BeginRenderPass:
+                return DAWN_UNIMPLEMENTED_ERROR("Render passes cannot be executed on the CPU.");
+
+            case Command::CopyBufferToTexture:
+            case Command::CopyTextureToBuffer:
+            case Command::CopyTextureToTexture:
+                return DAWN_UNIMPLEMENTED_ERROR("Texture copies cannot be executed on the CPU.");
+
+            case Command::ResolveQuerySet:
+            case Command::WriteTimestamp:
+                return DAWN_UNIMPLEMENTED_ERROR("Queries cannot be executed on the CPU.");
+
+            default:
+                UNREACHABLE();
+        }
+    }
+    return {};
+}
+
+MaybeError CommandBuffer::ExecuteComputePass() {
+#if TINT_BUILD_IR
+    struct BoundGroup {
+        Ref<BindGroupBase> group;
+        std::vector<uint32_t> dynamicOffsets;
+    };
+    ityp::array<BindGroupIndex, BoundGroup, kMaxBindGroups> bindGroups = {};
+    ComputePipeline* lastPipeline = nullptr;
+
+    auto DoDispatch = [&](uint32_t x, uint32_t y, uint32_t z) -> MaybeError {
+        tint::ir::Interpreter* interpreter = lastPipeline->GetInterpreter();
+        ASSERT(interpreter != nullptr);
+
+        tint::ir::Interpreter::DispatchOptions options;
+        const auto& layoutsMask = lastPipeline->GetLayout()->GetBindGroupLayoutsMask();
+        for (BindGroupIndex groupIndex : IterateBitSet(layoutsMask)) {
+            BindGroupBase* group = bindGroups[groupIndex].group.Get();
+            const std::vector<uint32_t>& dynamicOffsets = bindGroups[groupIndex].dynamicOffsets;
+            for (BindingIndex bindingIndex{0}; bindingIndex < group->GetLayout()->GetBindingCount();
+                 ++bindingIndex) {
+                const BindingInfo& bindingInfo = group->GetLayout()->GetBindingInfo(bindingIndex);
+                if (bindingInfo.bindingType != BindingInfoType::Buffer) {
+                    continue;
+                }
+                BufferBinding binding = group->GetBindingAsBufferBinding(bindingIndex);
+                uint64_t offset = binding.offset;
+                if (bindingInfo.buffer.hasDynamicOffset) {
+                    // Dynamic buffers are packed at the front of BindingIndices.
+                    offset += dynamicOffsets[static_cast<uint32_t>(bindingIndex)];
+                }
+                options.bindings.Add(
+                    tint::BindingPoint{static_cast<uint32_t>(groupIndex),
+                                       static_cast<uint32_t>(bindingInfo.binding)},
+                    tint::ir::Interpreter::Binding{
+                        ToBackend(binding.buffer)->GetBackingData() + offset,
+                        static_cast<size_t>(binding.size)});
+            }
+        }
+
+        // Distribute the workgroups over the worker task pool.
+        dawn::platform::WorkerTaskPool* taskPool = GetDevice()->GetWorkerTaskPool();
+        options.max_concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+        options.task_runner = [taskPool](uint32_t count,
+                                         const std::function<void(uint32_t)>& task) {
+            struct Task {
+                const std::function<void(uint32_t)>* function;
+                uint32_t index;
+            };
+            std::vector<Task> tasks(count);
+            std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> events;
+            for (uint32_t i = 0; i < count; ++i) {
+                tasks[i] = {&task, i};
+                events.push_back(taskPool->PostWorkerTask(
+                    [](void* userdata) {
+                        Task* t = static_cast<Task*>(userdata);
+                        (*t->function)(t->index);
+                    },
+                    &tasks[i]));
+            }
+            for (auto& event : events) {
+                event->Wait();
+            }
+        };
+
+        auto result = interpreter->Dispatch(
+            lastPipeline->GetStage(SingleShaderStage::Compute).entryPoint, {x, y, z}, options);
+        if (!result) {
+            return DAWN_FORMAT_INTERNAL_ERROR("Failed to execute dispatch on the CPU: %s",
+                                              result.Failure());
+        }
+        return {};
+    };
+
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::EndComputePass: {
+                mCommands.NextCommand<EndComputePassCmd>();
+                return {};
+            }
+
+            case Command::Dispatch: {
+                DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
+                DAWN_TRY(DoDispatch(dispatch->x, dispatch->y, dispatch->z));
+                break;
+            }
+
+            case Command::DispatchIndirect: {
+                DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
+                uint32_t workgroupCount[3];
+                memcpy(workgroupCount,
+                       ToBackend(dispatch->indirectBuffer)->GetBackingData() +
+                           dispatch->indirectOffset,
+                       sizeof(workgroupCount));
+                DAWN_TRY(DoDispatch(workgroupCount[0], workgroupCount[1], workgroupCount[2]));
+                break;
+            }
+
+            case Command::SetComputePipeline: {
+                SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
+                lastPipeline = ToBackend(cmd->pipeline).Get();
+                break;
+            }
+
+            case Command::SetBindGroup: {
+                SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
+                BoundGroup& bound = bindGroups[cmd->index];
+                bound.group = cmd->group;
+                bound.dynamicOffsets.clear();
+                if (cmd->dynamicOffsetCount > 0) {
+                    uint32_t* dynamicOffsets =
+                        mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    bound.dynamicOffsets.assign(dynamicOffsets,
+                                                dynamicOffsets + cmd->dynamicOffsetCount);
+                }
+                break;
+            }
+
+            case Command::InsertDebugMarker:
+            case Command::PopDebugGroup:
+            case Command::PushDebugGroup:
+                SkipCommand(&mCommands, type);
+                break;
+
+            case Command::WriteTimestamp:
+                return DAWN_UNIMPLEMENTED_ERROR("Queries cannot be executed on the CPU.");
+
+            default:
+                UNREACHABLE();
+        }
+    }
+
+    // EndComputePass should have been called
+    UNREACHABLE();
+#else
+    // The NullExecuteComputeOnCPU toggle is force disabled when the Tint IR is not built.
+    UNREACHABLE();
+#endif  // TINT_BUILD_IR
+}
+
 // QuerySet
 
 QuerySet::QuerySet(Device* device, const QuerySetDescriptor* descriptor)
@@ -377,11 +597,17 @@ Queue::Queue(Device* device, const QueueDescriptor* descriptor) : QueueBase(devi
 
 Queue::~Queue() {}
 
-MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
+MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
     Device* device = ToBackend(GetDevice());
 
     DAWN_TRY(device->SubmitPendingOperations());
 
+    if (device->IsToggleEnabled(Toggle::NullExecuteComputeOnCPU)) {
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            DAWN_TRY(ToBackend(commands[i])->Execute());
+        }
+    }
+
     return {};
 }
 
@@ -427,9 +653,27 @@ MaybeError ComputePipeline::Initialize() {
         _, ValidateComputeStageWorkgroupSize(*program, computeStage.entryPoint.c_str(),
                                              LimitsForCompilationRequest::Create(limits.v1)));
 
+#if TINT_BUILD_IR
+    if (GetDevice()->IsToggleEnabled(Toggle::NullExecuteComputeOnCPU)) {
+        auto ir = tint::wgsl::reader::ProgramToIR(program);
+        if (!ir) {
+            return DAWN_FORMAT_INTERNAL_ERROR("Failed to convert the compute stage to IR: %s",
+                                              ir.Failure());
+        }
+        mIR = std::make_unique<tint::ir::Module>(ir.Move());
+        mInterpreter = std::make_unique<tint::ir::Interpreter>(*mIR);
+    }
+#endif  // TINT_BUILD_IR
+
     return {};
 }
 
+ComputePipeline::~ComputePipeline() = default;
+
+tint::ir::Interpreter* ComputePipeline::GetInterpreter() const {
+    return mInterpreter.get();
+}
+
 // RenderPipeline
 MaybeError RenderPipeline::Initialize() {
     return {};
@@ -38,6 +38,11 @@
 #include "dawn/native/ToBackend.h"
 #include "dawn/native/dawn_platform.h"
 
+namespace tint::ir {
+class Interpreter;
+class Module;
+}  // namespace tint::ir
+
 namespace dawn::native::null {
 
 class BindGroup;
@@ -240,6 +245,8 @@ class Buffer final : public BufferBase {
 
     void DoWriteBuffer(uint64_t bufferOffset, const void* data, size_t size);
 
+    uint8_t* GetBackingData();
+
   private:
     MaybeError MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) override;
     void UnmapImpl() override;
@@ -254,6 +261,13 @@ class Buffer final : public BufferBase {
 class CommandBuffer final : public CommandBufferBase {
   public:
     CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
+
+    // Executes the compute passes and buffer-to-buffer copies of the command buffer on the CPU.
+    // Only used when the NullExecuteComputeOnCPU toggle is enabled.
+    MaybeError Execute();
+
+  private:
+    MaybeError ExecuteComputePass();
 };
 
 class QuerySet final : public QuerySetBase {
@@ -279,6 +293,16 @@ class ComputePipeline final : public ComputePipelineBase {
     using ComputePipelineBase::ComputePipelineBase;
 
     MaybeError Initialize() override;
+
+    // The CPU interpreter of the compute stage. Only set when the NullExecuteComputeOnCPU toggle
+    // is enabled.
+    tint::ir::Interpreter* GetInterpreter() const;
+
+  private:
+    ~ComputePipeline() override;
+
+    std::unique_ptr<tint::ir::Module> mIR;
+    std::unique_ptr<tint::ir::Interpreter> mInterpreter;
 };
 
 class RenderPipeline final : public RenderPipelineBase {
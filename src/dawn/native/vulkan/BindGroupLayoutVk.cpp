@@ -14,8 +14,9 @@
 
 #include "dawn/native/vulkan/BindGroupLayoutVk.h"
 
-#include <map>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/ityp_vector.h"
@@ -122,14 +123,21 @@ MaybeError BindGroupLayout::Initialize() {
                                                                  nullptr, &*mHandle),
                             "CreateDescriptorSetLayout"));
 
-    // Compute the size of descriptor pools used for this layout.
-    std::map<VkDescriptorType, uint32_t> descriptorCountPerType;
+    // Compute the number of descriptors of each type in a descriptor set of this layout. There
+    // are only a few descriptor types so a flat vector is used.
+    std::vector<VkDescriptorPoolSize> descriptorCountPerType;
 
     for (BindingIndex bindingIndex{0}; bindingIndex < GetBindingCount(); ++bindingIndex) {
         VkDescriptorType vulkanType = VulkanDescriptorType(GetBindingInfo(bindingIndex));
 
-        // map::operator[] will return 0 if the key doesn't exist.
-        descriptorCountPerType[vulkanType]++;
+        auto it = std::find_if(
+            descriptorCountPerType.begin(), descriptorCountPerType.end(),
+            [&](const VkDescriptorPoolSize& poolSize) { return poolSize.type == vulkanType; });
+        if (it == descriptorCountPerType.end()) {
+            descriptorCountPerType.push_back(VkDescriptorPoolSize{vulkanType, 1});
+        } else {
+            it->descriptorCount++;
+        }
     }
 
     // TODO(enga): Consider deduping allocators for layouts with the same descriptor type
@@ -65,6 +65,8 @@ BindGroup::BindGroup(Device* device,
         switch (bindingInfo.bindingType) {
             case BindingInfoType::Buffer: {
                 BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
+                // Prevent the relocation of the buffer while the descriptor set references it.
+                ToBackend(binding.buffer)->AddDescriptorSetReference();
 
                 VkBuffer handle = ToBackend(binding.buffer)->GetHandle();
                 if (handle == VK_NULL_HANDLE) {
@@ -152,6 +154,10 @@ BindGroup::BindGroup(Device* device,
 BindGroup::~BindGroup() = default;
 
 void BindGroup::DestroyImpl() {
+    for (BindingIndex bindingIndex{0}; bindingIndex < GetLayout()->GetBufferCount();
+         ++bindingIndex) {
+        ToBackend(GetBindingAsBufferBinding(bindingIndex).buffer)->RemoveDescriptorSetReference();
+    }
     BindGroupBase::DestroyImpl();
     ToBackend(GetLayout()->GetInternalBindGroupLayout())
         ->DeallocateBindGroup(this, &mDescriptorSetAllocation);
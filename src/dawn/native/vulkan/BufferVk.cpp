@@ -181,17 +181,7 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
         return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
     }
 
-    VkBufferCreateInfo createInfo;
-    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    createInfo.pNext = nullptr;
-    createInfo.flags = 0;
-    createInfo.size = mAllocatedSize;
-    // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
-    // and robust resource initialization.
-    createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
-    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    createInfo.queueFamilyIndexCount = 0;
-    createInfo.pQueueFamilyIndices = 0;
+    VkBufferCreateInfo createInfo = GetCreateInfo();
 
     Device* device = ToBackend(GetDevice());
     DAWN_TRY(CheckVkOOMThenSuccess(
@@ -218,6 +208,8 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
                                     mMemoryAllocation.GetOffset()),
         "vkBindBufferMemory"));
 
+    device->GetResourceMemoryAllocator()->TrackBufferForDefragmentation(this);
+
     // The buffers with mappedAtCreation == true will be initialized in
     // BufferBase::MapAtCreation().
     if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
@@ -242,6 +234,28 @@ MaybeError Buffer::Initialize(bool mappedAtCreation) {
     return {};
 }
 
+VkBufferCreateInfo Buffer::GetCreateInfo() const {
+    wgpu::BufferUsage usage = GetUsage();
+    // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
+    // and robust resource initialization.
+    usage |= wgpu::BufferUsage::CopyDst;
+    // Add CopySrc for the copy of the buffer's data when it is relocated.
+    if (ToBackend(GetDevice())->GetResourceMemoryAllocator()->IsDefragmentationEnabled()) {
+        usage |= wgpu::BufferUsage::CopySrc;
+    }
+
+    VkBufferCreateInfo createInfo;
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.size = mAllocatedSize;
+    createInfo.usage = VulkanBufferUsage(usage);
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices = 0;
+    return createInfo;
+}
+
 Buffer::~Buffer() = default;
 
 VkBuffer Buffer::GetHandle() const {
@@ -257,9 +271,10 @@ void Buffer::TransitionUsageNow(CommandRecordingContext* recordingContext,
     if (TrackUsageAndGetResourceBarrier(recordingContext, usage, &barrier, &srcStages,
                                         &dstStages)) {
         ASSERT(srcStages != 0 && dstStages != 0);
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 1u, &barrier, 0, nullptr);
+        Device* device = ToBackend(GetDevice());
+        device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
+                                      nullptr, 1u, &barrier, 0, nullptr);
+        device->IncrementPipelineBarrierCountForTesting();
     }
 }
 
@@ -367,6 +382,7 @@ void* Buffer::GetMappedPointer() {
 void Buffer::DestroyImpl() {
     BufferBase::DestroyImpl();
 
+    ToBackend(GetDevice())->GetResourceMemoryAllocator()->UntrackBufferForDefragmentation(this);
     ToBackend(GetDevice())->GetResourceMemoryAllocator()->Deallocate(&mMemoryAllocation);
 
     if (mHandle != VK_NULL_HANDLE) {
@@ -375,6 +391,86 @@ void Buffer::DestroyImpl() {
     }
 }
 
+const ResourceMemoryAllocation& Buffer::GetMemoryAllocation() const {
+    return mMemoryAllocation;
+}
+
+void Buffer::AddDescriptorSetReference() {
+    mDescriptorSetReferenceCount++;
+}
+
+void Buffer::RemoveDescriptorSetReference() {
+    ASSERT(mDescriptorSetReferenceCount > 0);
+    mDescriptorSetReferenceCount--;
+}
+
+bool Buffer::CanBeRelocated() const {
+    return mHandle != VK_NULL_HANDLE && mDescriptorSetReferenceCount == 0 &&
+           APIGetMapState() == wgpu::BufferMapState::Unmapped;
+}
+
+ResultOrError<bool> Buffer::Relocate() {
+    ASSERT(CanBeRelocated());
+    Device* device = ToBackend(GetDevice());
+    ResourceMemoryAllocator* allocator = device->GetResourceMemoryAllocator();
+
+    // A VkBuffer can't be bound to other memory, so create a new one. It has the same memory
+    // requirements as the current one since it is created with the same parameters.
+    VkBufferCreateInfo createInfo = GetCreateInfo();
+    VkBuffer handle = VK_NULL_HANDLE;
+    DAWN_TRY(CheckVkOOMThenSuccess(
+        device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*handle),
+        "vkCreateBuffer"));
+
+    VkMemoryRequirements requirements;
+    device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), handle, &requirements);
+
+    // The new VkBuffer isn't used by any command yet so it can be destroyed immediately.
+    ResourceMemoryAllocation allocation =
+        allocator->AllocateForRelocation(requirements, mMemoryAllocation);
+    if (allocation.GetInfo().mMethod == AllocationMethod::kInvalid) {
+        device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+        return false;
+    }
+
+    DAWN_TRY_WITH_CLEANUP(
+        CheckVkSuccess(device->fn.BindBufferMemory(
+                           device->GetVkDevice(), handle,
+                           ToBackend(allocation.GetResourceHeap())->GetMemory(),
+                           allocation.GetOffset()),
+                       "vkBindBufferMemory"),
+        {
+            device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+            allocator->Deallocate(&allocation);
+        });
+
+    // Copy the data to the new VkBuffer. Uninitialized buffers will be cleared on first use
+    // anyway so they don't need the copy.
+    wgpu::BufferUsage lastUsage = wgpu::BufferUsage::None;
+    if (IsDataInitialized()) {
+        CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+        TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+
+        VkBufferCopy copy;
+        copy.srcOffset = 0;
+        copy.dstOffset = 0;
+        copy.size = GetAllocatedSize();
+        device->fn.CmdCopyBuffer(recordingContext->commandBuffer, mHandle, handle, 1, &copy);
+        lastUsage = wgpu::BufferUsage::CopyDst;
+    }
+
+    // The previous VkBuffer and memory are released once the copy is done executing.
+    device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
+    allocator->Deallocate(&mMemoryAllocation);
+
+    mHandle = handle;
+    mMemoryAllocation = allocation;
+    mLastUsage = lastUsage;
+    SetLabelImpl();
+
+    return true;
+}
+
 bool Buffer::EnsureDataInitialized(CommandRecordingContext* recordingContext) {
     if (!NeedsInitialization()) {
         return false;
@@ -448,6 +544,7 @@ void Buffer::TransitionMappableBuffersEagerly(const VulkanFunctions& fn,
     ASSERT(srcStages != 0 && dstStages != 0);
     fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0, nullptr,
                           barriers.size(), barriers.data(), 0, nullptr);
+    ToBackend((*buffers.begin())->GetDevice())->IncrementPipelineBarrierCountForTesting();
 }
 
 void Buffer::SetLabelImpl() {
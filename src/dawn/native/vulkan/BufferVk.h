@@ -15,6 +15,7 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_BUFFERVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_BUFFERVK_H_
 
+#include <atomic>
 #include <set>
 
 #include "dawn/native/Buffer.h"
@@ -60,11 +61,25 @@ class Buffer final : public BufferBase {
                                                  CommandRecordingContext* recordingContext,
                                                  const std::set<Ref<Buffer>>& buffers);
 
+    const ResourceMemoryAllocation& GetMemoryAllocation() const;
+
+    // The VkBuffer is referenced by the descriptor sets of the bind groups using the buffer, so
+    // it can't be replaced while they are alive.
+    void AddDescriptorSetReference();
+    void RemoveDescriptorSetReference();
+
+    // Moves the buffer to memory in another memory block, with a new VkBuffer, for the
+    // defragmentation of the buffer memory. Returns false if there wasn't enough space in the
+    // other memory blocks.
+    bool CanBeRelocated() const;
+    ResultOrError<bool> Relocate();
+
   private:
     ~Buffer() override;
     using BufferBase::BufferBase;
 
     MaybeError Initialize(bool mappedAtCreation);
+    VkBufferCreateInfo GetCreateInfo() const;
     void InitializeToZero(CommandRecordingContext* recordingContext);
     void ClearBuffer(CommandRecordingContext* recordingContext,
                      uint32_t clearValue,
@@ -82,6 +97,8 @@ class Buffer final : public BufferBase {
     ResourceMemoryAllocation mMemoryAllocation;
 
     wgpu::BufferUsage mLastUsage = wgpu::BufferUsage::None;
+
+    std::atomic<uint32_t> mDescriptorSetReferenceCount{0};
 };
 
 }  // namespace dawn::native::vulkan
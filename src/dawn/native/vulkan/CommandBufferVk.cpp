@@ -15,6 +15,7 @@
 #include "dawn/native/vulkan/CommandBufferVk.h"
 
 #include <algorithm>
+#include <mutex>
 #include <vector>
 
 #include "dawn/native/BindGroupTracker.h"
@@ -194,6 +195,7 @@ MaybeError TransitionAndClearForSyncScope(Device* device,
         device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                       nullptr, bufferBarriers.size(), bufferBarriers.data(),
                                       imageBarriers.size(), imageBarriers.data());
+        device->IncrementPipelineBarrierCountForTesting();
     }
     return {};
 }
@@ -320,6 +322,7 @@ MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
 
         // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
         // commands currently being recorded are finished.
+        std::lock_guard<std::mutex> lock(device->GetParallelRecordingMutex());
         device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
     }
 
@@ -431,6 +434,267 @@ void RecordResolveQuerySetCmd(VkCommandBuffer commands,
     }
 }
 
+bool RangesOverlap(uint64_t offsetA, uint64_t sizeA, uint64_t offsetB, uint64_t sizeB) {
+    return offsetA < offsetB + sizeB && offsetB < offsetA + sizeA;
+}
+
+bool SubresourcesOverlap(const SubresourceRange& a, const SubresourceRange& b) {
+    return RangesOverlap(a.baseMipLevel, a.levelCount, b.baseMipLevel, b.levelCount) &&
+           RangesOverlap(a.baseArrayLayer, a.layerCount, b.baseArrayLayer, b.layerCount);
+}
+
+bool SameSubresources(const SubresourceRange& a, const SubresourceRange& b) {
+    return a.aspects == b.aspects && a.baseMipLevel == b.baseMipLevel &&
+           a.levelCount == b.levelCount && a.baseArrayLayer == b.baseArrayLayer &&
+           a.layerCount == b.layerCount;
+}
+
+bool TexelBoxesOverlap(const Origin3D& originA,
+                       const Extent3D& sizeA,
+                       const Origin3D& originB,
+                       const Extent3D& sizeB) {
+    return RangesOverlap(originA.x, sizeA.width, originB.x, sizeB.width) &&
+           RangesOverlap(originA.y, sizeA.height, originB.y, sizeB.height) &&
+           RangesOverlap(originA.z, sizeA.depthOrArrayLayers, originB.z,
+                         sizeB.depthOrArrayLayers);
+}
+
+void RecordCopyBufferToBuffer(Device* device,
+                              VkCommandBuffer commands,
+                              const CopyBufferToBufferCmd* copy) {
+    VkBufferCopy region;
+    region.srcOffset = copy->sourceOffset;
+    region.dstOffset = copy->destinationOffset;
+    region.size = copy->size;
+
+    VkBuffer srcHandle = ToBackend(copy->source)->GetHandle();
+    VkBuffer dstHandle = ToBackend(copy->destination)->GetHandle();
+    device->fn.CmdCopyBuffer(commands, srcHandle, dstHandle, 1, &region);
+}
+
+void RecordCopyBufferToTexture(Device* device,
+                               VkCommandBuffer commands,
+                               const CopyBufferToTextureCmd* copy) {
+    VkBufferImageCopy region =
+        ComputeBufferImageCopyRegion(copy->source, copy->destination, copy->copySize);
+    VkBuffer srcBuffer = ToBackend(copy->source.buffer)->GetHandle();
+    VkImage dstImage = ToBackend(copy->destination.texture)->GetHandle();
+
+    // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
+    // copy command.
+    device->fn.CmdCopyBufferToImage(commands, srcBuffer, dstImage,
+                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+}
+
+void RecordCopyTextureToBuffer(Device* device,
+                               VkCommandBuffer commands,
+                               const CopyTextureToBufferCmd* copy) {
+    VkBufferImageCopy region =
+        ComputeBufferImageCopyRegion(copy->destination, copy->source, copy->copySize);
+    VkImage srcImage = ToBackend(copy->source.texture)->GetHandle();
+    VkBuffer dstBuffer = ToBackend(copy->destination.buffer)->GetHandle();
+
+    // The Dawn CopySrc usage is always mapped to GENERAL
+    device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL, dstBuffer, 1,
+                                    &region);
+}
+
+void RecordCopyTextureToTexture(Device* device,
+                                VkCommandBuffer commands,
+                                const CopyTextureToTextureCmd* copy) {
+    const TextureCopy& src = copy->source;
+    const TextureCopy& dst = copy->destination;
+    VkImage srcImage = ToBackend(src.texture)->GetHandle();
+    VkImage dstImage = ToBackend(dst.texture)->GetHandle();
+    Aspect aspects = ToBackend(src.texture)->GetDisjointVulkanAspects();
+
+    for (Aspect aspect : IterateEnumMask(aspects)) {
+        VkImageCopy region = ComputeImageCopyRegion(src, dst, copy->copySize, aspect);
+
+        // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the copy command.
+        device->fn.CmdCopyImage(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL, dstImage,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+}
+
+// Records runs of consecutive copy commands with a single vkCmdPipelineBarrier for all the
+// transitions they need, followed by the copies, instead of one barrier per copied resource.
+// The copies of a batch must not need barriers between each other: a copy that writes memory
+// accessed by a previous copy of the batch, or that accesses memory written by it, or that uses
+// a resource with a different usage, flushes the batch first.
+class CopyBatch {
+  public:
+    CopyBatch(Device* device, CommandRecordingContext* recordingContext)
+        : mDevice(device), mRecordingContext(recordingContext) {}
+
+    // Returns whether the next copy can use [offset, offset + size) of the buffer as `usage`
+    // without a barrier after the copies already in the batch.
+    bool CanUseWithoutBarrier(Buffer* buffer,
+                              wgpu::BufferUsage usage,
+                              uint64_t offset,
+                              uint64_t size) const {
+        for (const BufferAccess& access : mBufferAccesses) {
+            if (access.buffer != buffer) {
+                continue;
+            }
+            if (access.usage != usage) {
+                return false;
+            }
+            if (usage == wgpu::BufferUsage::CopyDst &&
+                RangesOverlap(access.offset, access.size, offset, size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns whether the next copy can use the texels of `range` in the box at `origin` of
+    // `size` as `usage` without a barrier after the copies already in the batch.
+    bool CanUseWithoutBarrier(Texture* texture,
+                              wgpu::TextureUsage usage,
+                              const SubresourceRange& range,
+                              const Origin3D& origin,
+                              const Extent3D& size) const {
+        for (const TextureAccess& access : mTextureAccesses) {
+            if (access.texture != texture || !SubresourcesOverlap(access.range, range)) {
+                continue;
+            }
+            if (access.usage != usage) {
+                return false;
+            }
+            // Writes to the same subresources are only batched if they are to disjoint texels,
+            // in which case the subresources don't need to be transitioned again.
+            if (usage == wgpu::TextureUsage::CopyDst &&
+                (!SameSubresources(access.range, range) ||
+                 TexelBoxesOverlap(access.origin, access.size, origin, size))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TransitionUsage(Buffer* buffer, wgpu::BufferUsage usage, uint64_t offset, uint64_t size) {
+        bool alreadyTransitioned = false;
+        for (const BufferAccess& access : mBufferAccesses) {
+            if (access.buffer == buffer) {
+                ASSERT(access.usage == usage);
+                alreadyTransitioned = true;
+                break;
+            }
+        }
+        mBufferAccesses.push_back({buffer, usage, offset, size});
+        if (alreadyTransitioned) {
+            return;
+        }
+
+        VkBufferMemoryBarrier barrier;
+        if (buffer->TrackUsageAndGetResourceBarrier(mRecordingContext, usage, &barrier,
+                                                    &mSrcStages, &mDstStages)) {
+            mBufferBarriers.push_back(barrier);
+        }
+    }
+
+    void TransitionUsage(Texture* texture,
+                         wgpu::TextureUsage usage,
+                         const SubresourceRange& range,
+                         const Origin3D& origin,
+                         const Extent3D& size) {
+        bool alreadyTransitioned = false;
+        for (const TextureAccess& access : mTextureAccesses) {
+            if (access.texture == texture && SameSubresources(access.range, range)) {
+                ASSERT(access.usage == usage);
+                alreadyTransitioned = true;
+                break;
+            }
+        }
+        mTextureAccesses.push_back({texture, usage, range, origin, size});
+        if (alreadyTransitioned) {
+            return;
+        }
+
+        texture->TrackUsageAndGetResourceBarriers(mRecordingContext, usage, range,
+                                                  &mImageBarriers, &mSrcStages, &mDstStages);
+    }
+
+    // Adds a copy that is recorded after the barriers of the batch.
+    void AddCopy(Command type, const void* cmd) { mCopies.push_back({type, cmd}); }
+
+    // Records the barriers and the copies of the batch, and starts a new one.
+    void Flush() {
+        VkCommandBuffer commands = mRecordingContext->commandBuffer;
+
+        if (!mBufferBarriers.empty() || !mImageBarriers.empty()) {
+            ASSERT(mSrcStages != 0 && mDstStages != 0);
+            mDevice->fn.CmdPipelineBarrier(commands, mSrcStages, mDstStages, 0, 0, nullptr,
+                                           mBufferBarriers.size(), mBufferBarriers.data(),
+                                           mImageBarriers.size(), mImageBarriers.data());
+            mDevice->IncrementPipelineBarrierCountForTesting();
+        }
+
+        for (const BatchedCopy& copy : mCopies) {
+            switch (copy.type) {
+                case Command::CopyBufferToBuffer:
+                    RecordCopyBufferToBuffer(
+                        mDevice, commands, static_cast<const CopyBufferToBufferCmd*>(copy.cmd));
+                    break;
+                case Command::CopyBufferToTexture:
+                    RecordCopyBufferToTexture(
+                        mDevice, commands, static_cast<const CopyBufferToTextureCmd*>(copy.cmd));
+                    break;
+                case Command::CopyTextureToBuffer:
+                    RecordCopyTextureToBuffer(
+                        mDevice, commands, static_cast<const CopyTextureToBufferCmd*>(copy.cmd));
+                    break;
+                case Command::CopyTextureToTexture:
+                    RecordCopyTextureToTexture(
+                        mDevice, commands, static_cast<const CopyTextureToTextureCmd*>(copy.cmd));
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        mSrcStages = 0;
+        mDstStages = 0;
+        mBufferBarriers.clear();
+        mImageBarriers.clear();
+        mBufferAccesses.clear();
+        mTextureAccesses.clear();
+        mCopies.clear();
+    }
+
+  private:
+    struct BufferAccess {
+        Buffer* buffer;
+        wgpu::BufferUsage usage;
+        uint64_t offset;
+        uint64_t size;
+    };
+    struct TextureAccess {
+        Texture* texture;
+        wgpu::TextureUsage usage;
+        SubresourceRange range;
+        Origin3D origin;
+        Extent3D size;
+    };
+    struct BatchedCopy {
+        Command type;
+        const void* cmd;
+    };
+
+    Device* mDevice;
+    CommandRecordingContext* mRecordingContext;
+
+    VkPipelineStageFlags mSrcStages = 0;
+    VkPipelineStageFlags mDstStages = 0;
+    std::vector<VkBufferMemoryBarrier> mBufferBarriers;
+    std::vector<VkImageMemoryBarrier> mImageBarriers;
+
+    std::vector<BufferAccess> mBufferAccesses;
+    std::vector<TextureAccess> mTextureAccesses;
+    std::vector<BatchedCopy> mCopies;
+};
+
 }  // anonymous namespace
 
 // static
@@ -466,7 +730,10 @@ MaybeError CommandBuffer::RecordCopyImageWithTemporaryBuffer(
 
     Device* device = ToBackend(GetDevice());
     Ref<BufferBase> tempBufferBase;
-    DAWN_TRY_ASSIGN(tempBufferBase, device->CreateBuffer(&tempBufferDescriptor));
+    {
+        std::lock_guard<std::mutex> lock(device->GetParallelRecordingMutex());
+        DAWN_TRY_ASSIGN(tempBufferBase, device->CreateBuffer(&tempBufferDescriptor));
+    }
     Buffer* tempBuffer = ToBackend(tempBufferBase.Get());
 
     BufferCopy tempBufferCopy;
@@ -529,8 +796,23 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
     // VulkanSplitCommandBufferOnComputePassAfterRenderPass workaround.
     bool hasRecordedRenderPassInCurrentCommandBuffer = false;
 
+    // Consecutive copies are recorded in batches that share a single pipeline barrier. The batch
+    // is flushed before recording any other command.
+    CopyBatch copyBatch(device, recordingContext);
+
     Command type;
     while (mCommands.NextCommandId(&type)) {
+        switch (type) {
+            case Command::CopyBufferToBuffer:
+            case Command::CopyBufferToTexture:
+            case Command::CopyTextureToBuffer:
+            case Command::CopyTextureToTexture:
+                break;
+            default:
+                copyBatch.Flush();
+                break;
+        }
+
         switch (type) {
             case Command::CopyBufferToBuffer: {
                 CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
@@ -542,21 +824,22 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 Buffer* srcBuffer = ToBackend(copy->source.Get());
                 Buffer* dstBuffer = ToBackend(copy->destination.Get());
 
+                if (!copyBatch.CanUseWithoutBarrier(srcBuffer, wgpu::BufferUsage::CopySrc,
+                                                    copy->sourceOffset, copy->size) ||
+                    !copyBatch.CanUseWithoutBarrier(dstBuffer, wgpu::BufferUsage::CopyDst,
+                                                    copy->destinationOffset, copy->size)) {
+                    copyBatch.Flush();
+                }
+
                 srcBuffer->EnsureDataInitialized(recordingContext);
                 dstBuffer->EnsureDataInitializedAsDestination(recordingContext,
                                                               copy->destinationOffset, copy->size);
 
-                srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
-                VkBufferCopy region;
-                region.srcOffset = copy->sourceOffset;
-                region.dstOffset = copy->destinationOffset;
-                region.size = copy->size;
-
-                VkBuffer srcHandle = srcBuffer->GetHandle();
-                VkBuffer dstHandle = dstBuffer->GetHandle();
-                device->fn.CmdCopyBuffer(commands, srcHandle, dstHandle, 1, &region);
+                copyBatch.TransitionUsage(srcBuffer, wgpu::BufferUsage::CopySrc,
+                                          copy->sourceOffset, copy->size);
+                copyBatch.TransitionUsage(dstBuffer, wgpu::BufferUsage::CopyDst,
+                                          copy->destinationOffset, copy->size);
+                copyBatch.AddCopy(type, copy);
                 break;
             }
 
@@ -569,34 +852,34 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 }
                 auto& src = copy->source;
                 auto& dst = copy->destination;
-
-                ToBackend(src.buffer)->EnsureDataInitialized(recordingContext);
-
-                VkBufferImageCopy region = ComputeBufferImageCopyRegion(src, dst, copy->copySize);
-                VkImageSubresourceLayers subresource = region.imageSubresource;
+                Buffer* srcBuffer = ToBackend(src.buffer.Get());
+                Texture* dstTexture = ToBackend(dst.texture.Get());
 
                 SubresourceRange range =
                     GetSubresourcesAffectedByCopy(copy->destination, copy->copySize);
 
-                if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
-                                                  subresource.mipLevel)) {
+                if (!copyBatch.CanUseWithoutBarrier(srcBuffer, wgpu::BufferUsage::CopySrc, 0,
+                                                    srcBuffer->GetSize()) ||
+                    !copyBatch.CanUseWithoutBarrier(dstTexture, wgpu::TextureUsage::CopyDst,
+                                                    range, dst.origin, copy->copySize)) {
+                    copyBatch.Flush();
+                }
+
+                srcBuffer->EnsureDataInitialized(recordingContext);
+
+                if (IsCompleteSubresourceCopiedTo(dstTexture, copy->copySize, dst.mipLevel)) {
                     // Since texture has been overwritten, it has been "initialized"
-                    dst.texture->SetIsSubresourceContentInitialized(true, range);
+                    dstTexture->SetIsSubresourceContentInitialized(true, range);
                 } else {
-                    DAWN_TRY(ToBackend(dst.texture)
-                                 ->EnsureSubresourceContentInitialized(recordingContext, range));
+                    DAWN_TRY(dstTexture->EnsureSubresourceContentInitialized(recordingContext,
+                                                                             range));
                 }
-                ToBackend(src.buffer)
-                    ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
-                ToBackend(dst.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, range);
-                VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
-                VkImage dstImage = ToBackend(dst.texture)->GetHandle();
-
-                // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
-                // copy command.
-                device->fn.CmdCopyBufferToImage(commands, srcBuffer, dstImage,
-                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+                copyBatch.TransitionUsage(srcBuffer, wgpu::BufferUsage::CopySrc, 0,
+                                          srcBuffer->GetSize());
+                copyBatch.TransitionUsage(dstTexture, wgpu::TextureUsage::CopyDst, range,
+                                          dst.origin, copy->copySize);
+                copyBatch.AddCopy(type, copy);
                 break;
             }
 
@@ -609,27 +892,30 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 }
                 auto& src = copy->source;
                 auto& dst = copy->destination;
-
-                ToBackend(dst.buffer)->EnsureDataInitializedAsDestination(recordingContext, copy);
-
-                VkBufferImageCopy region = ComputeBufferImageCopyRegion(dst, src, copy->copySize);
+                Texture* srcTexture = ToBackend(src.texture.Get());
+                Buffer* dstBuffer = ToBackend(dst.buffer.Get());
 
                 SubresourceRange range =
                     GetSubresourcesAffectedByCopy(copy->source, copy->copySize);
 
-                DAWN_TRY(ToBackend(src.texture)
-                             ->EnsureSubresourceContentInitialized(recordingContext, range));
+                // The whole destination buffer is considered written as the exact range written
+                // depends on the layout of the copy.
+                if (!copyBatch.CanUseWithoutBarrier(srcTexture, wgpu::TextureUsage::CopySrc,
+                                                    range, src.origin, copy->copySize) ||
+                    !copyBatch.CanUseWithoutBarrier(dstBuffer, wgpu::BufferUsage::CopyDst, 0,
+                                                    dstBuffer->GetSize())) {
+                    copyBatch.Flush();
+                }
+
+                dstBuffer->EnsureDataInitializedAsDestination(recordingContext, copy);
 
-                ToBackend(src.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc, range);
-                ToBackend(dst.buffer)
-                    ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+                DAWN_TRY(srcTexture->EnsureSubresourceContentInitialized(recordingContext, range));
 
-                VkImage srcImage = ToBackend(src.texture)->GetHandle();
-                VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
-                // The Dawn CopySrc usage is always mapped to GENERAL
-                device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
-                                                dstBuffer, 1, &region);
+                copyBatch.TransitionUsage(srcTexture, wgpu::TextureUsage::CopySrc, range,
+                                          src.origin, copy->copySize);
+                copyBatch.TransitionUsage(dstBuffer, wgpu::BufferUsage::CopyDst, 0,
+                                          dstBuffer->GetSize());
+                copyBatch.AddCopy(type, copy);
                 break;
             }
 
@@ -642,34 +928,11 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 }
                 TextureCopy& src = copy->source;
                 TextureCopy& dst = copy->destination;
+                Texture* srcTexture = ToBackend(src.texture.Get());
+                Texture* dstTexture = ToBackend(dst.texture.Get());
                 SubresourceRange srcRange = GetSubresourcesAffectedByCopy(src, copy->copySize);
                 SubresourceRange dstRange = GetSubresourcesAffectedByCopy(dst, copy->copySize);
 
-                DAWN_TRY(ToBackend(src.texture)
-                             ->EnsureSubresourceContentInitialized(recordingContext, srcRange));
-                if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
-                                                  dst.mipLevel)) {
-                    // Since destination texture has been overwritten, it has been "initialized"
-                    dst.texture->SetIsSubresourceContentInitialized(true, dstRange);
-                } else {
-                    DAWN_TRY(ToBackend(dst.texture)
-                                 ->EnsureSubresourceContentInitialized(recordingContext, dstRange));
-                }
-
-                if (src.texture.Get() == dst.texture.Get() && src.mipLevel == dst.mipLevel) {
-                    // When there are overlapped subresources, the layout of the overlapped
-                    // subresources should all be GENERAL instead of what we set now. Currently
-                    // it is not allowed to copy with overlapped subresources, but we still
-                    // add the ASSERT here as a reminder for this possible misuse.
-                    ASSERT(!IsRangeOverlapped(src.origin.z, dst.origin.z,
-                                              copy->copySize.depthOrArrayLayers));
-                }
-
-                ToBackend(src.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc, srcRange);
-                ToBackend(dst.texture)
-                    ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, dstRange);
-
                 // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                 // because as Vulkan SPEC always validates image copies with the virtual size of
                 // the image subresource, when the extent that fits in the copy region of one
@@ -687,22 +950,42 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                     src.texture->GetFormat().isCompressed &&
                     !HasSameTextureCopyExtent(src, dst, copy->copySize);
 
+                if (copyUsingTemporaryBuffer ||
+                    !copyBatch.CanUseWithoutBarrier(srcTexture, wgpu::TextureUsage::CopySrc,
+                                                    srcRange, src.origin, copy->copySize) ||
+                    !copyBatch.CanUseWithoutBarrier(dstTexture, wgpu::TextureUsage::CopyDst,
+                                                    dstRange, dst.origin, copy->copySize)) {
+                    copyBatch.Flush();
+                }
+
+                DAWN_TRY(srcTexture->EnsureSubresourceContentInitialized(recordingContext,
+                                                                         srcRange));
+                if (IsCompleteSubresourceCopiedTo(dstTexture, copy->copySize, dst.mipLevel)) {
+                    // Since destination texture has been overwritten, it has been "initialized"
+                    dstTexture->SetIsSubresourceContentInitialized(true, dstRange);
+                } else {
+                    DAWN_TRY(dstTexture->EnsureSubresourceContentInitialized(recordingContext,
+                                                                             dstRange));
+                }
+
+                if (srcTexture == dstTexture && src.mipLevel == dst.mipLevel) {
+                    // When there are overlapped subresources, the layout of the overlapped
+                    // subresources should all be GENERAL instead of what we set now. Currently
+                    // it is not allowed to copy with overlapped subresources, but we still
+                    // add the ASSERT here as a reminder for this possible misuse.
+                    ASSERT(!IsRangeOverlapped(src.origin.z, dst.origin.z,
+                                              copy->copySize.depthOrArrayLayers));
+                }
+
+                copyBatch.TransitionUsage(srcTexture, wgpu::TextureUsage::CopySrc, srcRange,
+                                          src.origin, copy->copySize);
+                copyBatch.TransitionUsage(dstTexture, wgpu::TextureUsage::CopyDst, dstRange,
+                                          dst.origin, copy->copySize);
+
                 if (!copyUsingTemporaryBuffer) {
-                    VkImage srcImage = ToBackend(src.texture)->GetHandle();
-                    VkImage dstImage = ToBackend(dst.texture)->GetHandle();
-                    Aspect aspects = ToBackend(src.texture)->GetDisjointVulkanAspects();
-
-                    for (Aspect aspect : IterateEnumMask(aspects)) {
-                        VkImageCopy region =
-                            ComputeImageCopyRegion(src, dst, copy->copySize, aspect);
-
-                        // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after
-                        // the copy command.
-                        device->fn.CmdCopyImage(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
-                                                dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                                                &region);
-                    }
+                    copyBatch.AddCopy(type, copy);
                 } else {
+                    copyBatch.Flush();
                     DAWN_TRY(RecordCopyImageWithTemporaryBuffer(recordingContext, src, dst,
                                                                 copy->copySize));
                 }
@@ -871,9 +1154,12 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 uint8_t* data = mCommands.NextData<uint8_t>(size);
 
                 UploadHandle uploadHandle;
-                DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
-                                                  size, device->GetPendingCommandSerial(),
-                                                  kCopyBufferToBufferOffsetAlignment));
+                {
+                    std::lock_guard<std::mutex> lock(device->GetParallelRecordingMutex());
+                    DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                                      size, device->GetPendingCommandSerial(),
+                                                      kCopyBufferToBufferOffsetAlignment));
+                }
                 ASSERT(uploadHandle.mappedBuffer != nullptr);
                 memcpy(uploadHandle.mappedBuffer, data, size);
 
@@ -896,6 +1182,7 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                 break;
         }
     }
+    copyBatch.Flush();
 
     return {};
 }
@@ -39,6 +39,10 @@ Ref<ComputePipeline> ComputePipeline::CreateUninitialized(
 
 MaybeError ComputePipeline::Initialize() {
     Device* device = ToBackend(GetDevice());
+
+    // The batch is only needed for the compilation.
+    Ref<PipelineCacheBatch> batch = std::move(mPipelineCacheBatch);
+
     const PipelineLayout* layout = ToBackend(GetLayout());
 
     // Vulkan devices need cache UUID field to be serialized into pipeline cache keys.
@@ -86,6 +90,21 @@ MaybeError ComputePipeline::Initialize() {
     StreamIn(&mCacheKey, createInfo, layout,
              stream::Iterable(moduleAndSpirv.spirv, moduleAndSpirv.wordCount));
 
+    // The pipelines of a batch use the pipeline cache of the batch, which is stored once all of
+    // them are compiled, instead of a pipeline cache per pipeline.
+    if (batch != nullptr) {
+        VkPipelineCache cacheHandle = batch->AcquireHandle();
+        MaybeError maybeError = CheckVkSuccess(
+            device->fn.CreateComputePipelines(device->GetVkDevice(), cacheHandle, 1, &createInfo,
+                                              nullptr, &*mHandle),
+            "CreateComputePipelines");
+        batch->ReleaseHandle(cacheHandle);
+        DAWN_TRY(std::move(maybeError));
+
+        SetLabelImpl();
+        return {};
+    }
+
     // Try to see if we have anything in the blob cache.
     platform::metrics::DawnHistogramTimer cacheTimer(GetDevice()->GetPlatform());
     Ref<PipelineCache> cache = ToBackend(GetDevice()->GetOrCreatePipelineCache(GetCacheKey()));
@@ -133,6 +152,14 @@ VkPipeline ComputePipeline::GetHandle() const {
 void ComputePipeline::InitializeAsync(Ref<ComputePipelineBase> computePipeline,
                                       WGPUCreateComputePipelineAsyncCallback callback,
                                       void* userdata) {
+    // Pipelines created by CreatePipelinesBatchAsync share the pipeline cache of the batch.
+    Ref<PipelineCacheBatch> batch =
+        ToBackend(computePipeline->GetDevice())->GetCurrentPipelineCacheBatch();
+    if (batch != nullptr) {
+        batch->WrapCallback(&callback, &userdata);
+        ToBackend(computePipeline.Get())->mPipelineCacheBatch = std::move(batch);
+    }
+
     std::unique_ptr<CreateComputePipelineAsyncTask> asyncTask =
         std::make_unique<CreateComputePipelineAsyncTask>(std::move(computePipeline), callback,
                                                          userdata);
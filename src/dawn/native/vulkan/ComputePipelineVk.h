@@ -23,6 +23,7 @@
 namespace dawn::native::vulkan {
 
 class Device;
+class PipelineCacheBatch;
 
 class ComputePipeline final : public ComputePipelineBase {
   public:
@@ -45,6 +46,10 @@ class ComputePipeline final : public ComputePipelineBase {
     using ComputePipelineBase::ComputePipelineBase;
 
     VkPipeline mHandle = VK_NULL_HANDLE;
+
+    // Set when the pipeline is compiled as part of a CreatePipelinesBatchAsync call, until it
+    // is compiled.
+    Ref<PipelineCacheBatch> mPipelineCacheBatch;
 };
 
 }  // namespace dawn::native::vulkan
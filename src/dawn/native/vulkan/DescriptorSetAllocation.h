@@ -19,11 +19,9 @@
 
 namespace dawn::native::vulkan {
 
-// Contains a descriptor set along with data necessary to track its allocation.
+// Contains a descriptor set allocated by a DescriptorSetAllocator.
 struct DescriptorSetAllocation {
     VkDescriptorSet set = VK_NULL_HANDLE;
-    uint32_t poolIndex;
-    uint16_t setIndex;
 };
 
 }  // namespace dawn::native::vulkan
@@ -23,84 +23,55 @@
 
 namespace dawn::native::vulkan {
 
-// TODO(enga): Figure out this value.
-static constexpr uint32_t kMaxDescriptorsPerPool = 512;
+// The first descriptor pool of an allocator has room for kMinDescriptorsPerPool descriptors, and
+// each new pool has twice as many as the previous one, up to kMaxDescriptorsPerPool. This keeps
+// the memory used by layouts with few bind groups small, while bind-group-heavy workloads quickly
+// get large pools, with all their sets allocated in a single vkAllocateDescriptorSets.
+static constexpr uint32_t kMinDescriptorsPerPool = 512;
+static constexpr uint32_t kMaxDescriptorsPerPool = 8192;
 
 // static
 Ref<DescriptorSetAllocator> DescriptorSetAllocator::Create(
     BindGroupLayout* layout,
-    std::map<VkDescriptorType, uint32_t> descriptorCountPerType) {
-    return AcquireRef(new DescriptorSetAllocator(layout, descriptorCountPerType));
+    std::vector<VkDescriptorPoolSize> descriptorCountPerType) {
+    return AcquireRef(new DescriptorSetAllocator(layout, std::move(descriptorCountPerType)));
 }
 
 DescriptorSetAllocator::DescriptorSetAllocator(
     BindGroupLayout* layout,
-    std::map<VkDescriptorType, uint32_t> descriptorCountPerType)
-    : ObjectBase(layout->GetDevice()), mLayout(layout) {
+    std::vector<VkDescriptorPoolSize> descriptorCountPerType)
+    : ObjectBase(layout->GetDevice()),
+      mLayout(layout),
+      mDescriptorCountPerType(std::move(descriptorCountPerType)) {
     ASSERT(layout != nullptr);
 
     // Compute the total number of descriptors for this layout.
-    uint32_t totalDescriptorCount = 0;
-    mPoolSizes.reserve(descriptorCountPerType.size());
-    for (const auto& [type, count] : descriptorCountPerType) {
-        ASSERT(count > 0);
-        totalDescriptorCount += count;
-        mPoolSizes.push_back(VkDescriptorPoolSize{type, count});
-    }
-
-    if (totalDescriptorCount == 0) {
-        // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
-        // number of pools, each of which has non-zero descriptor counts.
-        // Since the descriptor set layout is empty, we should be able to allocate
-        // |kMaxDescriptorsPerPool| sets from this 1-sized descriptor pool.
-        // The type of this descriptor pool doesn't matter because it is never used.
-        mPoolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
-        mMaxSets = kMaxDescriptorsPerPool;
-    } else {
-        ASSERT(totalDescriptorCount <= kMaxBindingsPerPipelineLayout);
-        static_assert(kMaxBindingsPerPipelineLayout <= kMaxDescriptorsPerPool);
-
-        // Compute the total number of descriptors sets that fits given the max.
-        mMaxSets = kMaxDescriptorsPerPool / totalDescriptorCount;
-        ASSERT(mMaxSets > 0);
-
-        // Grow the number of desciptors in the pool to fit the computed |mMaxSets|.
-        for (auto& poolSize : mPoolSizes) {
-            poolSize.descriptorCount *= mMaxSets;
-        }
+    for (const VkDescriptorPoolSize& poolSize : mDescriptorCountPerType) {
+        ASSERT(poolSize.descriptorCount > 0);
+        mTotalDescriptorCount += poolSize.descriptorCount;
     }
+    ASSERT(mTotalDescriptorCount <= kMaxBindingsPerPipelineLayout);
+    static_assert(kMaxBindingsPerPipelineLayout <= kMinDescriptorsPerPool);
 }
 
 DescriptorSetAllocator::~DescriptorSetAllocator() {
-    for (auto& pool : mDescriptorPools) {
-        ASSERT(pool.freeSetIndices.size() == mMaxSets);
-        if (pool.vkPool != VK_NULL_HANDLE) {
-            Device* device = ToBackend(GetDevice());
-            device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
-        }
+    ASSERT(mFreeSets.size() == mTotalSetCount);
+    Device* device = ToBackend(GetDevice());
+    for (VkDescriptorPool pool : mDescriptorPools) {
+        device->GetFencedDeleter()->DeleteWhenUnused(pool);
     }
 }
 
 ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate() {
-    if (mAvailableDescriptorPoolIndices.empty()) {
+    if (mFreeSets.empty()) {
         DAWN_TRY(AllocateDescriptorPool());
     }
 
-    ASSERT(!mAvailableDescriptorPoolIndices.empty());
-
-    const PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
-    DescriptorPool* pool = &mDescriptorPools[poolIndex];
-
-    ASSERT(!pool->freeSetIndices.empty());
-
-    SetIndex setIndex = pool->freeSetIndices.back();
-    pool->freeSetIndices.pop_back();
-
-    if (pool->freeSetIndices.empty()) {
-        mAvailableDescriptorPoolIndices.pop_back();
-    }
+    ASSERT(!mFreeSets.empty());
+    VkDescriptorSet set = mFreeSets.back();
+    mFreeSets.pop_back();
 
-    return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
+    return DescriptorSetAllocation{set};
 }
 
 void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo) {
@@ -112,7 +83,7 @@ void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo)
     // host execution of the command and the end of the draw/dispatch.
     Device* device = ToBackend(GetDevice());
     const ExecutionSerial serial = device->GetPendingCommandSerial();
-    mPendingDeallocations.Enqueue({allocationInfo->poolIndex, allocationInfo->setIndex}, serial);
+    mPendingDeallocations.Enqueue(allocationInfo->set, serial);
 
     if (mLastDeallocationSerial != serial) {
         device->EnqueueDeferredDeallocation(this);
@@ -124,26 +95,48 @@ void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo)
 }
 
 void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial) {
-    for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
-        ASSERT(dealloc.poolIndex < mDescriptorPools.size());
-
-        auto& freeSetIndices = mDescriptorPools[dealloc.poolIndex].freeSetIndices;
-        if (freeSetIndices.empty()) {
-            mAvailableDescriptorPoolIndices.emplace_back(dealloc.poolIndex);
-        }
-        freeSetIndices.emplace_back(dealloc.setIndex);
+    for (VkDescriptorSet set : mPendingDeallocations.IterateUpTo(completedSerial)) {
+        mFreeSets.push_back(set);
     }
     mPendingDeallocations.ClearUpTo(completedSerial);
 }
 
 MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+    // Double the size of the pools with each new pool, up to kMaxDescriptorsPerPool.
+    uint32_t descriptorCount = kMinDescriptorsPerPool;
+    for (size_t i = 0; i < mDescriptorPools.size() && descriptorCount < kMaxDescriptorsPerPool;
+         ++i) {
+        descriptorCount *= 2;
+    }
+
+    uint32_t setCount;
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    if (mTotalDescriptorCount == 0) {
+        // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
+        // number of pools, each of which has non-zero descriptor counts.
+        // Since the descriptor set layout is empty, we should be able to allocate
+        // |descriptorCount| sets from this 1-sized descriptor pool.
+        // The type of this descriptor pool doesn't matter because it is never used.
+        setCount = descriptorCount;
+        poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
+    } else {
+        // Compute the total number of descriptors sets that fits given the max, and grow the
+        // number of descriptors in the pool to fit them.
+        setCount = descriptorCount / mTotalDescriptorCount;
+        ASSERT(setCount > 0);
+        poolSizes = mDescriptorCountPerType;
+        for (VkDescriptorPoolSize& poolSize : poolSizes) {
+            poolSize.descriptorCount *= setCount;
+        }
+    }
+
     VkDescriptorPoolCreateInfo createInfo;
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     createInfo.pNext = nullptr;
     createInfo.flags = 0;
-    createInfo.maxSets = mMaxSets;
-    createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
-    createInfo.pPoolSizes = mPoolSizes.data();
+    createInfo.maxSets = setCount;
+    createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
 
     Device* device = ToBackend(GetDevice());
 
@@ -152,36 +145,31 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
                                                             nullptr, &*descriptorPool),
                             "CreateDescriptorPool"));
 
-    std::vector<VkDescriptorSetLayout> layouts(mMaxSets, mLayout->GetHandle());
+    std::vector<VkDescriptorSetLayout> layouts(setCount, mLayout->GetHandle());
 
     VkDescriptorSetAllocateInfo allocateInfo;
     allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocateInfo.pNext = nullptr;
     allocateInfo.descriptorPool = descriptorPool;
-    allocateInfo.descriptorSetCount = mMaxSets;
+    allocateInfo.descriptorSetCount = setCount;
     allocateInfo.pSetLayouts = AsVkArray(layouts.data());
 
-    std::vector<VkDescriptorSet> sets(mMaxSets);
-    MaybeError result =
-        CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
-                                                         AsVkArray(sets.data())),
-                       "AllocateDescriptorSets");
+    // Allocate all the sets of the pool directly at the end of the free list.
+    size_t freeSetCount = mFreeSets.size();
+    mFreeSets.resize(freeSetCount + setCount);
+    MaybeError result = CheckVkSuccess(
+        device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
+                                          AsVkArray(mFreeSets.data() + freeSetCount)),
+        "AllocateDescriptorSets");
     if (result.IsError()) {
         // On an error we can destroy the pool immediately because no command references it.
+        mFreeSets.resize(freeSetCount);
         device->fn.DestroyDescriptorPool(device->GetVkDevice(), descriptorPool, nullptr);
         DAWN_TRY(std::move(result));
     }
 
-    std::vector<SetIndex> freeSetIndices;
-    freeSetIndices.reserve(mMaxSets);
-
-    for (SetIndex i = 0; i < mMaxSets; ++i) {
-        freeSetIndices.push_back(i);
-    }
-
-    mAvailableDescriptorPoolIndices.push_back(mDescriptorPools.size());
-    mDescriptorPools.emplace_back(
-        DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
+    mDescriptorPools.push_back(descriptorPool);
+    mTotalSetCount += setCount;
 
     return {};
 }
@@ -15,7 +15,6 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 #define SRC_DAWN_NATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 
-#include <map>
 #include <vector>
 
 #include "dawn/common/SerialQueue.h"
@@ -29,14 +28,16 @@ namespace dawn::native::vulkan {
 
 class BindGroupLayout;
 
+// Allocates the descriptor sets of a bind group layout. The sets are allocated in bulk, a whole
+// descriptor pool at a time, and pools get larger as more sets are needed. The free sets of all
+// the pools are kept in a single flat list so that allocation and deallocation are a push / pop.
+// Deallocated sets are put back in the free list when the serial they were last used with
+// completes.
 class DescriptorSetAllocator : public ObjectBase {
-    using PoolIndex = uint32_t;
-    using SetIndex = uint16_t;
-
   public:
     static Ref<DescriptorSetAllocator> Create(
         BindGroupLayout* layout,
-        std::map<VkDescriptorType, uint32_t> descriptorCountPerType);
+        std::vector<VkDescriptorPoolSize> descriptorCountPerType);
 
     ResultOrError<DescriptorSetAllocation> Allocate();
     void Deallocate(DescriptorSetAllocation* allocationInfo);
@@ -44,30 +45,24 @@ class DescriptorSetAllocator : public ObjectBase {
 
   private:
     DescriptorSetAllocator(BindGroupLayout* layout,
-                           std::map<VkDescriptorType, uint32_t> descriptorCountPerType);
+                           std::vector<VkDescriptorPoolSize> descriptorCountPerType);
     ~DescriptorSetAllocator() override;
 
     MaybeError AllocateDescriptorPool();
 
     const BindGroupLayout* mLayout;
 
-    std::vector<VkDescriptorPoolSize> mPoolSizes;
-    SetIndex mMaxSets;
+    // The number of descriptors of each type in one descriptor set.
+    std::vector<VkDescriptorPoolSize> mDescriptorCountPerType;
+    uint32_t mTotalDescriptorCount = 0;
 
-    struct DescriptorPool {
-        VkDescriptorPool vkPool;
-        std::vector<VkDescriptorSet> sets;
-        std::vector<SetIndex> freeSetIndices;
-    };
+    std::vector<VkDescriptorPool> mDescriptorPools;
+    size_t mTotalSetCount = 0;
 
-    std::vector<PoolIndex> mAvailableDescriptorPoolIndices;
-    std::vector<DescriptorPool> mDescriptorPools;
+    // The free sets of all the pools, the last deallocated sets are reused first.
+    std::vector<VkDescriptorSet> mFreeSets;
 
-    struct Deallocation {
-        PoolIndex poolIndex;
-        SetIndex setIndex;
-    };
-    SerialQueue<ExecutionSerial, Deallocation> mPendingDeallocations;
+    SerialQueue<ExecutionSerial, VkDescriptorSet> mPendingDeallocations;
     ExecutionSerial mLastDeallocationSerial = ExecutionSerial(0);
 };
 
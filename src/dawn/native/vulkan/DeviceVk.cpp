@@ -237,6 +237,12 @@ MaybeError Device::TickImpl() {
     mDeleter->Tick(completedSerial);
     mDescriptorAllocatorsPendingDeallocation.ClearUpTo(completedSerial);
 
+    // Only move buffers while the GPU is idle and no commands using them are pending, so that
+    // the copies of their data are the only commands referencing the previous VkBuffers.
+    if (!mRecordingContext.used && completedSerial == GetLastSubmittedCommandSerial()) {
+        DAWN_TRY(mResourceMemoryAllocator->Defragment());
+    }
+
     if (mRecordingContext.needsSubmit) {
         DAWN_TRY(SubmitPendingCommands());
     }
@@ -304,6 +310,14 @@ void Device::ForceEventualFlushOfCommands() {
     mRecordingContext.needsSubmit |= mRecordingContext.used;
 }
 
+size_t Device::GetPipelineBarrierCountForTesting() const {
+    return mPipelineBarrierCountForTesting;
+}
+
+void Device::IncrementPipelineBarrierCountForTesting() {
+    ++mPipelineBarrierCountForTesting;
+}
+
 MaybeError Device::SubmitPendingCommands() {
     if (!mRecordingContext.needsSubmit) {
         return {};
@@ -679,6 +693,85 @@ MaybeError Device::SplitRecordingContext(CommandRecordingContext* recordingConte
     return {};
 }
 
+ResultOrError<CommandRecordingContext> Device::CreateParallelRecordingContext() {
+    CommandPoolAndBuffer commands;
+    DAWN_TRY_ASSIGN(commands, BeginVkCommandBuffer());
+
+    CommandRecordingContext recordingContext;
+    recordingContext.commandBuffer = commands.commandBuffer;
+    recordingContext.commandPool = commands.pool;
+    recordingContext.commandBufferList.push_back(commands.commandBuffer);
+    recordingContext.commandPoolList.push_back(commands.pool);
+    return recordingContext;
+}
+
+// Appends the commands of the parallel recording contexts after the commands currently in the
+// pending recording context. The current command buffer of the pending recording context is ended
+// and a new one is begun after the merged command buffers so that the commands recorded later
+// (like the eager transitions of SubmitPendingCommands) are executed after them.
+MaybeError Device::MergeParallelRecordingContexts(std::vector<CommandRecordingContext> contexts) {
+    ASSERT(mRecordingContext.commandBuffer != VK_NULL_HANDLE);
+
+    for (CommandRecordingContext& context : contexts) {
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(fn.EndCommandBuffer(context.commandBuffer), "vkEndCommandBuffer"),
+            { DiscardParallelRecordingContexts(contexts); });
+    }
+    DAWN_TRY_WITH_CLEANUP(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
+                                         "vkEndCommandBuffer"),
+                          { DiscardParallelRecordingContexts(contexts); });
+
+    for (CommandRecordingContext& context : contexts) {
+        CommandRecordingContext* pending = &mRecordingContext;
+        pending->commandBufferList.insert(pending->commandBufferList.end(),
+                                          context.commandBufferList.begin(),
+                                          context.commandBufferList.end());
+        pending->commandPoolList.insert(pending->commandPoolList.end(),
+                                        context.commandPoolList.begin(),
+                                        context.commandPoolList.end());
+        pending->waitSemaphores.insert(pending->waitSemaphores.end(),
+                                       context.waitSemaphores.begin(),
+                                       context.waitSemaphores.end());
+        pending->signalSemaphores.insert(pending->signalSemaphores.end(),
+                                         context.signalSemaphores.begin(),
+                                         context.signalSemaphores.end());
+        for (Ref<Buffer>& buffer : context.tempBuffers) {
+            pending->tempBuffers.push_back(std::move(buffer));
+        }
+        pending->externalTexturesForEagerTransition.merge(
+            context.externalTexturesForEagerTransition);
+        pending->mappableBuffersForEagerTransition.merge(
+            context.mappableBuffersForEagerTransition);
+        pending->needsSubmit |= context.needsSubmit;
+        pending->used |= context.used;
+    }
+
+    CommandPoolAndBuffer commands;
+    DAWN_TRY_ASSIGN(commands, BeginVkCommandBuffer());
+
+    mRecordingContext.commandBuffer = commands.commandBuffer;
+    mRecordingContext.commandPool = commands.pool;
+    mRecordingContext.commandBufferList.push_back(commands.commandBuffer);
+    mRecordingContext.commandPoolList.push_back(commands.pool);
+
+    return {};
+}
+
+void Device::DiscardParallelRecordingContexts(
+    const std::vector<CommandRecordingContext>& contexts) {
+    // The command pools are reset before being reused so the command buffers don't need to be
+    // ended.
+    for (const CommandRecordingContext& context : contexts) {
+        for (size_t i = 0; i < context.commandPoolList.size(); ++i) {
+            mUnusedCommands.push_back({context.commandPoolList[i], context.commandBufferList[i]});
+        }
+    }
+}
+
+std::mutex& Device::GetParallelRecordingMutex() {
+    return mParallelRecordingMutex;
+}
+
 ResultOrError<CommandPoolAndBuffer> Device::BeginVkCommandBuffer() {
     CommandPoolAndBuffer commands;
 
@@ -872,6 +965,37 @@ bool Device::SignalAndExportExternalTexture(
     }());
 }
 
+void Device::CreatePipelinesBatchAsync(const PipelinesBatchDescriptor* descriptor) {
+    std::function<void()> doneCallback;
+    if (descriptor->doneCallback != nullptr) {
+        doneCallback = [callback = descriptor->doneCallback,
+                        userdata = descriptor->doneUserdata] { callback(userdata); };
+    }
+
+    ASSERT(mCurrentPipelineCacheBatch == nullptr);
+    mCurrentPipelineCacheBatch = PipelineCacheBatch::Create(
+        this, descriptor->cacheName != nullptr ? descriptor->cacheName : "",
+        std::move(doneCallback));
+
+    // The pipelines that are initialized asynchronously take a reference to the batch, so it is
+    // stored once they are all compiled. The other ones, like those that fail validation or are
+    // already in the cache of pipelines, don't need it.
+    for (size_t i = 0; i < descriptor->renderPipelineCount; ++i) {
+        const RenderPipelineBatchEntry& entry = descriptor->renderPipelines[i];
+        APICreateRenderPipelineAsync(FromAPI(entry.descriptor), entry.callback, entry.userdata);
+    }
+    for (size_t i = 0; i < descriptor->computePipelineCount; ++i) {
+        const ComputePipelineBatchEntry& entry = descriptor->computePipelines[i];
+        APICreateComputePipelineAsync(FromAPI(entry.descriptor), entry.callback, entry.userdata);
+    }
+
+    mCurrentPipelineCacheBatch = nullptr;
+}
+
+Ref<PipelineCacheBatch> Device::GetCurrentPipelineCacheBatch() const {
+    return mCurrentPipelineCacheBatch;
+}
+
 TextureBase* Device::CreateTextureWrappingVulkanImage(
     const ExternalImageDescriptorVk* descriptor,
     ExternalMemoryHandle memoryHandle,
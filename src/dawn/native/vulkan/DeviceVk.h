@@ -15,7 +15,9 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_DEVICEVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_DEVICEVK_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <utility>
@@ -38,6 +40,7 @@ namespace dawn::native::vulkan {
 
 class BufferUploader;
 class FencedDeleter;
+class PipelineCacheBatch;
 class RenderPassCache;
 class ResourceMemoryAllocator;
 
@@ -70,6 +73,16 @@ class Device final : public DeviceBase {
     MaybeError SplitRecordingContext(CommandRecordingContext* recordingContext);
     MaybeError SubmitPendingCommands();
 
+    // Command buffers can be recorded on several threads, each in its own recording context
+    // created with CreateParallelRecordingContext. The contexts are then appended in order to the
+    // pending recording context with MergeParallelRecordingContexts, or discarded on errors. The
+    // recording of the parallel contexts must hold GetParallelRecordingMutex() when using device
+    // objects that aren't thread-safe (like the FencedDeleter or the DynamicUploader).
+    ResultOrError<CommandRecordingContext> CreateParallelRecordingContext();
+    MaybeError MergeParallelRecordingContexts(std::vector<CommandRecordingContext> contexts);
+    void DiscardParallelRecordingContexts(const std::vector<CommandRecordingContext>& contexts);
+    std::mutex& GetParallelRecordingMutex();
+
     void EnqueueDeferredDeallocation(DescriptorSetAllocator* allocator);
 
     // Dawn Native API
@@ -82,6 +95,11 @@ class Device final : public DeviceBase {
                                         VkImageLayout desiredLayout,
                                         ExternalImageExportInfoVk* info,
                                         std::vector<ExternalSemaphoreHandle>* semaphoreHandle);
+    void CreatePipelinesBatchAsync(const PipelinesBatchDescriptor* descriptor);
+
+    // The pipelines initialized asynchronously while a batch is current are compiled with its
+    // pipeline cache. A batch is only current during CreatePipelinesBatchAsync.
+    Ref<PipelineCacheBatch> GetCurrentPipelineCacheBatch() const;
 
     ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
         CommandEncoder* encoder,
@@ -117,6 +135,11 @@ class Device final : public DeviceBase {
 
     void ForceEventualFlushOfCommands() override;
 
+    // The number of vkCmdPipelineBarrier recorded by the device, used to check that barriers are
+    // batched.
+    size_t GetPipelineBarrierCountForTesting() const;
+    void IncrementPipelineBarrierCountForTesting();
+
   private:
     Device(AdapterBase* adapter,
            const DeviceDescriptor* descriptor,
@@ -184,6 +207,7 @@ class Device final : public DeviceBase {
     std::unique_ptr<FencedDeleter> mDeleter;
     std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
     std::unique_ptr<RenderPassCache> mRenderPassCache;
+    Ref<PipelineCacheBatch> mCurrentPipelineCacheBatch;
 
     std::unique_ptr<external_memory::Service> mExternalMemoryService;
     std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
@@ -213,6 +237,10 @@ class Device final : public DeviceBase {
     // There is always a valid recording context stored in mRecordingContext
     CommandRecordingContext mRecordingContext;
 
+    std::mutex mParallelRecordingMutex;
+
+    std::atomic<size_t> mPipelineBarrierCountForTesting{0};
+
     MaybeError ImportExternalImage(const ExternalImageDescriptorVk* descriptor,
                                    ExternalMemoryHandle memoryHandle,
                                    VkImage image,
@@ -15,7 +15,9 @@
 #include "dawn/native/vulkan/PipelineCacheVk.h"
 
 #include <memory>
+#include <utility>
 
+#include "dawn/native/CallbackTaskManager.h"
 #include "dawn/native/Device.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/vulkan/DeviceVk.h"
@@ -97,4 +99,109 @@ void PipelineCache::Initialize() {
     }
 }
 
+// static
+Ref<PipelineCacheBatch> PipelineCacheBatch::Create(Device* device,
+                                                   const std::string& name,
+                                                   std::function<void()> doneCallback) {
+    CacheKey key;
+    StreamIn(&key, device->GetCacheKey(), device->GetDeviceInfo().properties.pipelineCacheUUID,
+             name);
+    Ref<PipelineCacheBatch> batch =
+        AcquireRef(new PipelineCacheBatch(device, key, std::move(doneCallback)));
+    batch->mInitialData = batch->Initialize();
+    return batch;
+}
+
+PipelineCacheBatch::PipelineCacheBatch(Device* device,
+                                       const CacheKey& key,
+                                       std::function<void()> doneCallback)
+    : PipelineCacheBase(device->GetBlobCache(), key),
+      mDevice(device),
+      mDoneCallback(std::move(doneCallback)) {}
+
+PipelineCacheBatch::~PipelineCacheBatch() {
+    ASSERT(mAvailableHandles.size() == mHandles.size());
+
+    MaybeError maybeError = Flush();
+    if (maybeError.IsError()) {
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        mDevice->EmitLog(WGPULoggingType_Info, error->GetFormattedMessage().c_str());
+    }
+
+    for (VkPipelineCache handle : mHandles) {
+        mDevice->fn.DestroyPipelineCache(mDevice->GetVkDevice(), handle, nullptr);
+    }
+
+    if (mDoneCallback) {
+        mDevice->GetCallbackTaskManager()->AddCallbackTask(std::move(mDoneCallback));
+    }
+}
+
+VkPipelineCache PipelineCacheBatch::AcquireHandle() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mAvailableHandles.empty()) {
+        VkPipelineCache handle = mAvailableHandles.back();
+        mAvailableHandles.pop_back();
+        return handle;
+    }
+
+    VkPipelineCacheCreateInfo createInfo;
+    createInfo.flags = 0;
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.initialDataSize = mInitialData.Size();
+    createInfo.pInitialData = mInitialData.Data();
+
+    // Like for PipelineCache, failing to create the pipeline cache only makes the compilation
+    // slower so the error is only logged.
+    VkPipelineCache handle = VK_NULL_HANDLE;
+    MaybeError maybeError = CheckVkSuccess(
+        mDevice->fn.CreatePipelineCache(mDevice->GetVkDevice(), &createInfo, nullptr, &*handle),
+        "CreatePipelineCache");
+    if (maybeError.IsError()) {
+        std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+        mDevice->EmitLog(WGPULoggingType_Info, error->GetFormattedMessage().c_str());
+        return VK_NULL_HANDLE;
+    }
+    mHandles.push_back(handle);
+    return handle;
+}
+
+void PipelineCacheBatch::ReleaseHandle(VkPipelineCache handle) {
+    if (handle == VK_NULL_HANDLE) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAvailableHandles.push_back(handle);
+}
+
+MaybeError PipelineCacheBatch::SerializeToBlobImpl(Blob* blob) {
+    if (mHandles.empty()) {
+        // No pipeline was compiled in the batch, or all the pipeline cache creations failed.
+        return {};
+    }
+
+    VkPipelineCache mergedHandle = mHandles[0];
+    if (mHandles.size() > 1) {
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.MergePipelineCaches(mDevice->GetVkDevice(), mergedHandle,
+                                            static_cast<uint32_t>(mHandles.size() - 1),
+                                            AsVkArray(mHandles.data() + 1)),
+            "MergePipelineCaches"));
+    }
+
+    size_t bufferSize;
+    DAWN_TRY(CheckVkSuccess(mDevice->fn.GetPipelineCacheData(mDevice->GetVkDevice(), mergedHandle,
+                                                             &bufferSize, nullptr),
+                            "GetPipelineCacheData"));
+    if (bufferSize == 0) {
+        return {};
+    }
+    *blob = CreateBlob(bufferSize);
+    DAWN_TRY(CheckVkSuccess(mDevice->fn.GetPipelineCacheData(mDevice->GetVkDevice(), mergedHandle,
+                                                             &bufferSize, blob->Data()),
+                            "GetPipelineCacheData"));
+    return {};
+}
+
 }  // namespace dawn::native::vulkan
@@ -15,6 +15,12 @@
 #ifndef SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 #define SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "dawn/native/ObjectBase.h"
 #include "dawn/native/PipelineCache.h"
 
@@ -26,6 +32,8 @@ class DeviceBase;
 
 namespace dawn::native::vulkan {
 
+class Device;
+
 class PipelineCache final : public PipelineCacheBase {
   public:
     static Ref<PipelineCache> Create(DeviceBase* device, const CacheKey& key);
@@ -44,6 +52,67 @@ class PipelineCache final : public PipelineCacheBase {
     VkPipelineCache mHandle = VK_NULL_HANDLE;
 };
 
+// The pipeline cache shared by the pipelines of a CreatePipelinesBatchAsync call, which are
+// compiled concurrently on the worker threads. Each compilation gets a VkPipelineCache that isn't
+// used by the other compilations at the same time, so that they don't contend on the internal
+// lock of the VkPipelineCache. All the VkPipelineCaches start from the blob stored by the
+// previous batch with the same name. They are merged with vkMergePipelineCaches and stored back
+// as a single blob when the batch is destroyed, which happens once all its pipelines are
+// compiled since they hold a reference to it until then.
+class PipelineCacheBatch final : public PipelineCacheBase {
+  public:
+    static Ref<PipelineCacheBatch> Create(Device* device,
+                                          const std::string& name,
+                                          std::function<void()> doneCallback);
+
+    // Returns a VkPipelineCache that isn't used by other threads, which may be VK_NULL_HANDLE
+    // if it couldn't be created. It must be given back with ReleaseHandle.
+    VkPipelineCache AcquireHandle();
+    void ReleaseHandle(VkPipelineCache handle);
+
+    // Makes the callback of a pipeline of the batch keep a reference to the batch until it is
+    // called, so that the done callback of the batch is called after those of its pipelines.
+    template <typename Pipeline>
+    using Callback = void (*)(WGPUCreatePipelineAsyncStatus status,
+                              Pipeline pipeline,
+                              const char* message,
+                              void* userdata);
+    template <typename Pipeline>
+    void WrapCallback(Callback<Pipeline>* callback, void** userdata);
+
+  private:
+    PipelineCacheBatch(Device* device, const CacheKey& key, std::function<void()> doneCallback);
+    ~PipelineCacheBatch() override;
+
+    MaybeError SerializeToBlobImpl(Blob* blob) override;
+
+    template <typename Pipeline>
+    struct WrappedCallback {
+        Callback<Pipeline> callback;
+        void* userdata;
+        Ref<PipelineCacheBatch> batch;
+    };
+
+    Ref<Device> mDevice;
+    Blob mInitialData;
+    std::function<void()> mDoneCallback;
+
+    std::mutex mMutex;
+    std::vector<VkPipelineCache> mHandles;
+    std::vector<VkPipelineCache> mAvailableHandles;
+};
+
+template <typename Pipeline>
+void PipelineCacheBatch::WrapCallback(Callback<Pipeline>* callback, void** userdata) {
+    *userdata = new WrappedCallback<Pipeline>{*callback, *userdata, this};
+    *callback = [](WGPUCreatePipelineAsyncStatus status, Pipeline pipeline, const char* message,
+                   void* userdata) {
+        std::unique_ptr<WrappedCallback<Pipeline>> wrapped(
+            static_cast<WrappedCallback<Pipeline>*>(userdata));
+        wrapped->callback(status, pipeline, message, wrapped->userdata);
+    };
+}
+
 }  // namespace dawn::native::vulkan
 
 #endif  // SRC_DAWN_NATIVE_VULKAN_PIPELINECACHEVK_H_
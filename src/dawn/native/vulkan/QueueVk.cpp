@@ -14,6 +14,13 @@
 
 #include "dawn/native/vulkan/QueueVk.h"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "dawn/common/Math.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/CommandValidation.h"
@@ -28,6 +35,70 @@
 
 namespace dawn::native::vulkan {
 
+namespace {
+
+// Returns whether the command buffers don't use any resource in common. The barriers and lazy
+// clears recorded for a resource depend on the commands recorded before for it, so only
+// independent command buffers can be recorded in parallel.
+bool AreIndependent(uint32_t commandCount, CommandBufferBase* const* commands) {
+    std::unordered_set<const void*> usedObjects;
+    std::unordered_set<const void*> commandBufferObjects;
+    for (uint32_t i = 0; i < commandCount; ++i) {
+        const CommandBufferResourceUsage& usages = commands[i]->GetResourceUsages();
+
+        // The same command buffer can be submitted multiple times, it can't be recorded on
+        // different threads at once.
+        commandBufferObjects.clear();
+        commandBufferObjects.insert(commands[i]);
+        commandBufferObjects.insert(usages.topLevelBuffers.begin(), usages.topLevelBuffers.end());
+        commandBufferObjects.insert(usages.topLevelTextures.begin(),
+                                    usages.topLevelTextures.end());
+        commandBufferObjects.insert(usages.usedQuerySets.begin(), usages.usedQuerySets.end());
+        for (const RenderPassResourceUsage& pass : usages.renderPasses) {
+            commandBufferObjects.insert(pass.buffers.begin(), pass.buffers.end());
+            commandBufferObjects.insert(pass.textures.begin(), pass.textures.end());
+            commandBufferObjects.insert(pass.externalTextures.begin(), pass.externalTextures.end());
+            commandBufferObjects.insert(pass.querySets.begin(), pass.querySets.end());
+        }
+        for (const ComputePassResourceUsage& pass : usages.computePasses) {
+            commandBufferObjects.insert(pass.referencedBuffers.begin(),
+                                        pass.referencedBuffers.end());
+            commandBufferObjects.insert(pass.referencedTextures.begin(),
+                                        pass.referencedTextures.end());
+            commandBufferObjects.insert(pass.referencedExternalTextures.begin(),
+                                        pass.referencedExternalTextures.end());
+        }
+
+        for (const void* object : commandBufferObjects) {
+            if (!usedObjects.insert(object).second) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A contiguous range of the submitted command buffers, recorded in its own recording context.
+struct RecordingTask {
+    CommandBufferBase* const* commands;
+    uint32_t commandCount;
+    CommandRecordingContext* recordingContext;
+    MaybeError result;
+};
+
+void DoRecordingTask(void* userdata) {
+    RecordingTask* task = static_cast<RecordingTask*>(userdata);
+    for (uint32_t i = 0; i < task->commandCount; ++i) {
+        MaybeError result = ToBackend(task->commands[i])->RecordCommands(task->recordingContext);
+        if (result.IsError()) {
+            task->result = std::move(result);
+            return;
+        }
+    }
+}
+
+}  // anonymous namespace
+
 // static
 Ref<Queue> Queue::Create(Device* device, const QueueDescriptor* descriptor) {
     Ref<Queue> queue = AcquireRef(new Queue(device, descriptor));
@@ -48,8 +119,12 @@ MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* co
 
     TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
     CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
-    for (uint32_t i = 0; i < commandCount; ++i) {
-        DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+    if (CanRecordInParallel(commandCount, commands)) {
+        DAWN_TRY(RecordCommandsInParallel(commandCount, commands));
+    } else {
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+        }
     }
     TRACE_EVENT_END0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
 
@@ -58,6 +133,79 @@ MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* co
     return {};
 }
 
+bool Queue::CanRecordInParallel(uint32_t commandCount, CommandBufferBase* const* commands) const {
+    const Device* device = ToBackend(GetDevice());
+    // The split of the command buffers for the driver workaround happens in the pending recording
+    // context.
+    return commandCount > 1 &&
+           device->IsToggleEnabled(Toggle::VulkanRecordCommandBuffersInParallel) &&
+           !device->IsToggleEnabled(Toggle::VulkanSplitCommandBufferOnComputePassAfterRenderPass) &&
+           device->GetWorkerTaskPool() != nullptr && AreIndependent(commandCount, commands);
+}
+
+// Splits the command buffers in contiguous ranges that are each recorded in a separate recording
+// context, on the worker task pool and the current thread. The recording contexts are then merged
+// in order in the pending recording context so the GPU executes the commands in the same order.
+MaybeError Queue::RecordCommandsInParallel(uint32_t commandCount,
+                                           CommandBufferBase* const* commands) {
+    Device* device = ToBackend(GetDevice());
+
+    uint32_t taskCount = std::min(commandCount, std::max(std::thread::hardware_concurrency(), 1u));
+    std::vector<CommandRecordingContext> recordingContexts;
+    recordingContexts.reserve(taskCount);
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        CommandRecordingContext recordingContext;
+        DAWN_TRY_ASSIGN_WITH_CLEANUP(
+            recordingContext, device->CreateParallelRecordingContext(),
+            { device->DiscardParallelRecordingContexts(recordingContexts); });
+        recordingContexts.push_back(std::move(recordingContext));
+    }
+
+    std::vector<RecordingTask> tasks(taskCount);
+    uint32_t firstCommand = 0;
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        // Distribute the remainder of the division over the first tasks.
+        uint32_t taskCommandCount =
+            commandCount / taskCount + (i < commandCount % taskCount ? 1 : 0);
+        tasks[i].commands = commands + firstCommand;
+        tasks[i].commandCount = taskCommandCount;
+        tasks[i].recordingContext = &recordingContexts[i];
+        firstCommand += taskCommandCount;
+    }
+    ASSERT(firstCommand == commandCount);
+
+    // The first range is recorded on the current thread while the workers record the others.
+    dawn::platform::WorkerTaskPool* taskPool = device->GetWorkerTaskPool();
+    std::vector<std::unique_ptr<dawn::platform::WaitableEvent>> events;
+    for (uint32_t i = 1; i < taskCount; ++i) {
+        events.push_back(taskPool->PostWorkerTask(DoRecordingTask, &tasks[i]));
+    }
+    DoRecordingTask(&tasks[0]);
+    for (auto& event : events) {
+        event->Wait();
+    }
+
+    // Return the error of the first command buffer that failed to be recorded, like the serial
+    // recording would.
+    MaybeError result;
+    for (RecordingTask& task : tasks) {
+        if (!task.result.IsError()) {
+            continue;
+        }
+        if (result.IsError()) {
+            task.result.AcquireError();
+        } else {
+            result = std::move(task.result);
+        }
+    }
+    if (result.IsError()) {
+        device->DiscardParallelRecordingContexts(recordingContexts);
+        return result;
+    }
+
+    return device->MergeParallelRecordingContexts(std::move(recordingContexts));
+}
+
 void Queue::SetLabelImpl() {
     Device* device = ToBackend(GetDevice());
     // TODO(crbug.com/dawn/1344): When we start using multiple queues this needs to be adjusted
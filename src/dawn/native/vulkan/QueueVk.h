@@ -33,6 +33,8 @@ class Queue final : public QueueBase {
     void Initialize();
 
     MaybeError SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) override;
+    bool CanRecordInParallel(uint32_t commandCount, CommandBufferBase* const* commands) const;
+    MaybeError RecordCommandsInParallel(uint32_t commandCount, CommandBufferBase* const* commands);
 
     // Dawn API
     void SetLabelImpl() override;
@@ -14,8 +14,11 @@
 
 #include "dawn/native/vulkan/RenderPassCache.h"
 
+#include <utility>
+
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/HashUtils.h"
+#include "dawn/common/Math.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
 #include "dawn/native/vulkan/VulkanError.h"
@@ -50,6 +53,24 @@ VkAttachmentStoreOp VulkanAttachmentStoreOp(wgpu::StoreOp op) {
     }
     UNREACHABLE();
 }
+
+// The parts of a RenderPassCacheQuery that contribute to its key. Each part is hashed separately
+// and the results are XOR-ed so that the key doesn't depend on the order of the calls to the
+// helpers.
+enum class QueryPart : uint8_t {
+    Color,
+    DepthStencil,
+    SampleCount,
+};
+
+template <typename... Args>
+uint64_t HashQueryPart(QueryPart part, const Args&... args) {
+    size_t hash = Hash(part);
+    HashCombine(&hash, args...);
+    return hash;
+}
+
+constexpr size_t kInitialTableSlotCount = 16;
 }  // anonymous namespace
 
 // RenderPassCacheQuery
@@ -64,6 +85,8 @@ void RenderPassCacheQuery::SetColor(ColorAttachmentIndex index,
     colorLoadOp[index] = loadOp;
     colorStoreOp[index] = storeOp;
     resolveTargetMask[index] = hasResolveTarget;
+    key ^= HashQueryPart(QueryPart::Color, static_cast<uint8_t>(index), format, loadOp, storeOp,
+                         hasResolveTarget);
 }
 
 void RenderPassCacheQuery::SetDepthStencil(wgpu::TextureFormat format,
@@ -79,35 +102,89 @@ void RenderPassCacheQuery::SetDepthStencil(wgpu::TextureFormat format,
     stencilLoadOp = stencilLoadOpIn;
     stencilStoreOp = stencilStoreOpIn;
     readOnlyDepthStencil = readOnly;
+    key ^= HashQueryPart(QueryPart::DepthStencil, format, depthLoadOpIn, depthStoreOpIn,
+                         stencilLoadOpIn, stencilStoreOpIn, readOnly);
 }
 
 void RenderPassCacheQuery::SetSampleCount(uint32_t sampleCountIn) {
     sampleCount = sampleCountIn;
+    key ^= HashQueryPart(QueryPart::SampleCount, sampleCountIn);
 }
 
 // RenderPassCache
 
-RenderPassCache::RenderPassCache(Device* device) : mDevice(device) {}
+RenderPassCache::Table::Table(size_t slotCountIn)
+    : slotCount(slotCountIn), slots(new std::atomic<const Entry*>[slotCountIn]) {
+    ASSERT(IsPowerOfTwo(slotCount));
+    for (size_t i = 0; i < slotCount; i++) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+const RenderPassCache::Entry* RenderPassCache::Table::Find(
+    const RenderPassCacheQuery& query) const {
+    for (size_t i = CacheFuncs()(query) & (slotCount - 1);; i = (i + 1) & (slotCount - 1)) {
+        const Entry* entry = slots[i].load(std::memory_order_acquire);
+        if (entry == nullptr || CacheFuncs()(entry->query, query)) {
+            return entry;
+        }
+    }
+}
+
+void RenderPassCache::Table::Insert(const Entry* entry) {
+    for (size_t i = CacheFuncs()(entry->query) & (slotCount - 1);; i = (i + 1) & (slotCount - 1)) {
+        if (slots[i].load(std::memory_order_relaxed) == nullptr) {
+            slots[i].store(entry, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+RenderPassCache::RenderPassCache(Device* device) : mDevice(device) {
+    mTables.push_back(std::make_unique<Table>(kInitialTableSlotCount));
+    mTable.store(mTables.back().get(), std::memory_order_release);
+}
 
 RenderPassCache::~RenderPassCache() {
     std::lock_guard<std::mutex> lock(mMutex);
-    for (auto [_, renderPass] : mCache) {
-        mDevice->fn.DestroyRenderPass(mDevice->GetVkDevice(), renderPass, nullptr);
+    for (const std::unique_ptr<Entry>& entry : mEntries) {
+        mDevice->fn.DestroyRenderPass(mDevice->GetVkDevice(), entry->renderPass, nullptr);
     }
 
-    mCache.clear();
+    mTable.store(nullptr, std::memory_order_release);
+    mTables.clear();
+    mEntries.clear();
 }
 
 ResultOrError<VkRenderPass> RenderPassCache::GetRenderPass(const RenderPassCacheQuery& query) {
+    if (const Entry* entry = mTable.load(std::memory_order_acquire)->Find(query)) {
+        return VkRenderPass(entry->renderPass);
+    }
+
     std::lock_guard<std::mutex> lock(mMutex);
-    auto it = mCache.find(query);
-    if (it != mCache.end()) {
-        return VkRenderPass(it->second);
+
+    // Another thread might have added the render pass while we were waiting for the lock.
+    Table* table = mTables.back().get();
+    if (const Entry* entry = table->Find(query)) {
+        return VkRenderPass(entry->renderPass);
     }
 
     VkRenderPass renderPass;
     DAWN_TRY_ASSIGN(renderPass, CreateRenderPassForQuery(query));
-    mCache.emplace(query, renderPass);
+    mEntries.push_back(std::make_unique<Entry>(Entry{query, renderPass}));
+
+    // Keep the table at most half full. A larger table is only visible to lookups once all the
+    // entries are added to it.
+    if (2 * mEntries.size() > table->slotCount) {
+        mTables.push_back(std::make_unique<Table>(2 * table->slotCount));
+        table = mTables.back().get();
+        for (const std::unique_ptr<Entry>& entry : mEntries) {
+            table->Insert(entry.get());
+        }
+        mTable.store(table, std::memory_order_release);
+    } else {
+        table->Insert(mEntries.back().get());
+    }
     return renderPass;
 }
 
@@ -252,27 +329,16 @@ ResultOrError<VkRenderPass> RenderPassCache::CreateRenderPassForQuery(
 // RenderPassCache
 
 size_t RenderPassCache::CacheFuncs::operator()(const RenderPassCacheQuery& query) const {
-    size_t hash = Hash(query.colorMask);
-
-    HashCombine(&hash, Hash(query.resolveTargetMask));
-
-    for (ColorAttachmentIndex i : IterateBitSet(query.colorMask)) {
-        HashCombine(&hash, query.colorFormats[i], query.colorLoadOp[i], query.colorStoreOp[i]);
-    }
-
-    HashCombine(&hash, query.hasDepthStencil);
-    if (query.hasDepthStencil) {
-        HashCombine(&hash, query.depthStencilFormat, query.depthLoadOp, query.depthStoreOp,
-                    query.stencilLoadOp, query.stencilStoreOp, query.readOnlyDepthStencil);
-    }
-
-    HashCombine(&hash, query.sampleCount);
-
-    return hash;
+    return static_cast<size_t>(query.key);
 }
 
 bool RenderPassCache::CacheFuncs::operator()(const RenderPassCacheQuery& a,
                                              const RenderPassCacheQuery& b) const {
+    // Most different queries have different keys, so check it first.
+    if (a.key != b.key) {
+        return false;
+    }
+
     if (a.colorMask != b.colorMask) {
         return false;
     }
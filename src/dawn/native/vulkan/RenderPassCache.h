@@ -16,9 +16,11 @@
 #define SRC_DAWN_NATIVE_VULKAN_RENDERPASSCACHE_H_
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <vector>
 
 #include "dawn/common/Constants.h"
 #include "dawn/common/ityp_array.h"
@@ -66,13 +68,18 @@ struct RenderPassCacheQuery {
     bool readOnlyDepthStencil;
 
     uint32_t sampleCount;
+
+    // A 64-bit hash of the query, updated by the helpers so that lookups in the cache don't need
+    // to hash every attachment. Queries with different keys are always different.
+    uint64_t key = 0;
 };
 
 // Caches VkRenderPasses so that we don't create duplicate ones for every RenderPipeline or
 // render pass. We always arrange the order of attachments in "color-depthstencil-resolve" order
 // when creating render pass and framebuffer so that we can always make sure the order of
 // attachments in the rendering pipeline matches the one of the framebuffer.
-// All the operations on RenderPassCache are guaranteed to be thread-safe.
+// All the operations on RenderPassCache are guaranteed to be thread-safe, and lookups of render
+// passes that are already in the cache don't take any lock.
 // TODO(cwallez@chromium.org): Make it an LRU cache somehow?
 class RenderPassCache {
   public:
@@ -85,18 +92,42 @@ class RenderPassCache {
     // Does the actual VkRenderPass creation on a cache miss.
     ResultOrError<VkRenderPass> CreateRenderPassForQuery(const RenderPassCacheQuery& query) const;
 
-    // Implements the functors necessary for to use RenderPassCacheQueries as unordered_map
-    // keys.
+    // Implements the functors necessary to hash and compare RenderPassCacheQueries.
     struct CacheFuncs {
         size_t operator()(const RenderPassCacheQuery& query) const;
         bool operator()(const RenderPassCacheQuery& a, const RenderPassCacheQuery& b) const;
     };
-    using Cache = std::unordered_map<RenderPassCacheQuery, VkRenderPass, CacheFuncs, CacheFuncs>;
+
+    // A render pass of the cache. Entries are immutable and live as long as the cache.
+    struct Entry {
+        RenderPassCacheQuery query;
+        VkRenderPass renderPass;
+    };
+
+    // An open-addressing hash table of pointers to entries, using linear probing. Slots only ever
+    // change from nullptr to an entry so lookups can probe them while an entry is inserted. The
+    // table is kept at most half full so that probing always reaches an empty slot.
+    struct Table {
+        explicit Table(size_t slotCountIn);
+
+        const Entry* Find(const RenderPassCacheQuery& query) const;
+        void Insert(const Entry* entry);
+
+        size_t slotCount;
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
 
     Device* mDevice = nullptr;
 
+    // Lookups load the current table atomically and don't take any lock. Insertions take mMutex
+    // and add the entry to the current table, so entries are never copied. When the table is full,
+    // a table twice as large is filled with the entries and published instead. Lookups can still
+    // be using the previous tables so they are only deleted with the cache, but each is half the
+    // size of the next so together they are smaller than the current table.
+    std::atomic<const Table*> mTable;
     std::mutex mMutex;
-    Cache mCache;
+    std::vector<std::unique_ptr<Entry>> mEntries;
+    std::vector<std::unique_ptr<Table>> mTables;
 };
 
 }  // namespace dawn::native::vulkan
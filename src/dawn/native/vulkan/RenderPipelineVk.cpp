@@ -340,6 +340,10 @@ Ref<RenderPipeline> RenderPipeline::CreateUninitialized(
 
 MaybeError RenderPipeline::Initialize() {
     Device* device = ToBackend(GetDevice());
+
+    // The batch is only needed for the compilation.
+    Ref<PipelineCacheBatch> batch = std::move(mPipelineCacheBatch);
+
     const PipelineLayout* layout = ToBackend(GetLayout());
 
     // Vulkan devices need cache UUID field to be serialized into pipeline cache keys.
@@ -558,6 +562,21 @@ MaybeError RenderPipeline::Initialize() {
     // Record cache key information now since createInfo is not stored.
     StreamIn(&mCacheKey, createInfo, layout->GetCacheKey());
 
+    // The pipelines of a batch use the pipeline cache of the batch, which is stored once all of
+    // them are compiled, instead of a pipeline cache per pipeline.
+    if (batch != nullptr) {
+        VkPipelineCache cacheHandle = batch->AcquireHandle();
+        MaybeError maybeError = CheckVkSuccess(
+            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), cacheHandle, 1, &createInfo,
+                                               nullptr, &*mHandle),
+            "CreateGraphicsPipelines");
+        batch->ReleaseHandle(cacheHandle);
+        DAWN_TRY(std::move(maybeError));
+
+        SetLabelImpl();
+        return {};
+    }
+
     // Try to see if we have anything in the blob cache.
     platform::metrics::DawnHistogramTimer cacheTimer(GetDevice()->GetPlatform());
     Ref<PipelineCache> cache = ToBackend(GetDevice()->GetOrCreatePipelineCache(GetCacheKey()));
@@ -647,6 +666,14 @@ VkPipeline RenderPipeline::GetHandle() const {
 void RenderPipeline::InitializeAsync(Ref<RenderPipelineBase> renderPipeline,
                                      WGPUCreateRenderPipelineAsyncCallback callback,
                                      void* userdata) {
+    // Pipelines created by CreatePipelinesBatchAsync share the pipeline cache of the batch.
+    Ref<PipelineCacheBatch> batch =
+        ToBackend(renderPipeline->GetDevice())->GetCurrentPipelineCacheBatch();
+    if (batch != nullptr) {
+        batch->WrapCallback(&callback, &userdata);
+        ToBackend(renderPipeline.Get())->mPipelineCacheBatch = std::move(batch);
+    }
+
     std::unique_ptr<CreateRenderPipelineAsyncTask> asyncTask =
         std::make_unique<CreateRenderPipelineAsyncTask>(std::move(renderPipeline), callback,
                                                         userdata);
@@ -23,6 +23,7 @@
 namespace dawn::native::vulkan {
 
 class Device;
+class PipelineCacheBatch;
 
 class RenderPipeline final : public RenderPipelineBase {
   public:
@@ -52,6 +53,10 @@ class RenderPipeline final : public RenderPipelineBase {
         PipelineVertexInputStateCreateInfoTemporaryAllocations* temporaryAllocations);
 
     VkPipeline mHandle = VK_NULL_HANDLE;
+
+    // Set when the pipeline is compiled as part of a CreatePipelinesBatchAsync call, until it
+    // is compiled.
+    Ref<PipelineCacheBatch> mPipelineCacheBatch;
 };
 
 }  // namespace dawn::native::vulkan
@@ -16,8 +16,8 @@
 
 namespace dawn::native::vulkan {
 
-ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType)
-    : mMemory(memory), mMemoryType(memoryType) {}
+ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType, uint64_t size)
+    : mMemory(memory), mMemoryType(memoryType), mSize(size) {}
 
 VkDeviceMemory ResourceHeap::GetMemory() const {
     return mMemory;
@@ -27,4 +27,8 @@ size_t ResourceHeap::GetMemoryType() const {
     return mMemoryType;
 }
 
+uint64_t ResourceHeap::GetSize() const {
+    return mSize;
+}
+
 }  // namespace dawn::native::vulkan
@@ -23,15 +23,17 @@ namespace dawn::native::vulkan {
 // Wrapper for physical memory used with or without a resource object.
 class ResourceHeap : public ResourceHeapBase {
   public:
-    ResourceHeap(VkDeviceMemory memory, size_t memoryType);
+    ResourceHeap(VkDeviceMemory memory, size_t memoryType, uint64_t size);
     ~ResourceHeap() override = default;
 
     VkDeviceMemory GetMemory() const;
     size_t GetMemoryType() const;
+    uint64_t GetSize() const;
 
   private:
     VkDeviceMemory mMemory = VK_NULL_HANDLE;
     size_t mMemoryType = 0;
+    uint64_t mSize = 0;
 };
 
 }  // namespace dawn::native::vulkan
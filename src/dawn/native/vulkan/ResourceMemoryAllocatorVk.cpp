@@ -20,6 +20,8 @@
 #include "dawn/common/Math.h"
 #include "dawn/native/BuddyMemoryAllocator.h"
 #include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TlsfMemoryAllocator.h"
+#include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
@@ -38,6 +40,10 @@ constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
 // size
 constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
 
+// The amount of buffer data copied by ResourceMemoryAllocator::Defragment when called. Large
+// enough to evacuate a memory block at once.
+constexpr uint64_t kMaxDefragmentationSizePerTick = kBuddyHeapsSize;
+
 bool IsMemoryKindMappable(MemoryKind memoryKind) {
     switch (memoryKind) {
         case MemoryKind::LinearReadMappable:
@@ -56,40 +62,141 @@ bool IsMemoryKindMappable(MemoryKind memoryKind) {
 
 }  // anonymous namespace
 
-// SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
-// service suballocation requests, but for a single Vulkan memory type.
+// SingleTypeAllocator is a combination of a BuddyMemoryAllocator, or a TlsfMemoryAllocator, and
+// its client and can service suballocation requests, but for a single Vulkan memory type. It also
+// keeps the statistics of the memory allocated for this memory type.
 
 class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
   public:
-    SingleTypeAllocator(Device* device, size_t memoryTypeIndex, VkDeviceSize memoryHeapSize)
+    SingleTypeAllocator(Device* device,
+                        size_t memoryTypeIndex,
+                        VkDeviceSize memoryHeapSize,
+                        bool useTlsfSuballocation)
         : mDevice(device),
           mMemoryTypeIndex(memoryTypeIndex),
           mMemoryHeapSize(memoryHeapSize),
-          mPooledMemoryAllocator(this),
-          mBuddySystem(
-              // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
-              // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
-              uint64_t(1) << Log2(mMemoryHeapSize),
-              // Take the min in the very unlikely case the memory heap is tiny.
-              std::min(uint64_t(1) << Log2(mMemoryHeapSize), kBuddyHeapsSize),
-              &mPooledMemoryAllocator) {
+          mPooledMemoryAllocator(this) {
         ASSERT(IsPowerOfTwo(kBuddyHeapsSize));
+
+        // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
+        // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
+        uint64_t maxSystemSize = uint64_t(1) << Log2(mMemoryHeapSize);
+        // Take the min in the very unlikely case the memory heap is tiny.
+        uint64_t memoryBlockSize = std::min(maxSystemSize, kBuddyHeapsSize);
+
+        if (useTlsfSuballocation) {
+            // The TLSF memory blocks aren't pooled so that the memory of the blocks emptied by
+            // the defragmentation is given back to the driver.
+            mTlsfSystem =
+                std::make_unique<TlsfMemoryAllocator>(maxSystemSize, memoryBlockSize, this);
+        } else {
+            mBuddySystem = std::make_unique<BuddyMemoryAllocator>(maxSystemSize, memoryBlockSize,
+                                                                  &mPooledMemoryAllocator);
+        }
     }
     ~SingleTypeAllocator() override = default;
 
-    void DestroyPool() { mPooledMemoryAllocator.DestroyPool(); }
+    void DestroyPool() {
+        if (mTlsfSystem != nullptr) {
+            mTlsfSystem->ReleaseEmptyBlocks();
+        }
+        mPooledMemoryAllocator.DestroyPool();
+    }
 
     ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
-        return mBuddySystem.Allocate(size, alignment);
+        ResourceMemoryAllocation allocation;
+        if (mTlsfSystem != nullptr) {
+            DAWN_TRY_ASSIGN(allocation, mTlsfSystem->Allocate(size, alignment));
+        } else {
+            DAWN_TRY_ASSIGN(allocation, mBuddySystem->Allocate(size, alignment));
+        }
+        if (allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+            mSubAllocationCount++;
+        }
+        return allocation;
     }
 
     void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
-        mBuddySystem.Deallocate(allocation);
+        ASSERT(mSubAllocationCount > 0);
+        mSubAllocationCount--;
+        if (mTlsfSystem != nullptr) {
+            mTlsfSystem->Deallocate(allocation);
+        } else {
+            mBuddySystem->Deallocate(allocation);
+        }
+    }
+
+    // Memory allocated for a single resource.
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateDirectMemory(uint64_t size) {
+        std::unique_ptr<ResourceHeapBase> heap;
+        DAWN_TRY_ASSIGN(heap, AllocateVkMemory(size));
+        mDirectAllocationCount++;
+        mDirectAllocatedSize += size;
+        return heap;
+    }
+
+    void DeallocateDirectMemory(std::unique_ptr<ResourceHeapBase> heap) {
+        ASSERT(mDirectAllocationCount > 0);
+        mDirectAllocationCount--;
+        mDirectAllocatedSize -= ToBackend(heap.get())->GetSize();
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(heap.get())->GetMemory());
+    }
+
+    // Relocation is only supported by the TLSF memory allocator.
+    uint64_t FindBlockToEvacuate() const {
+        if (mTlsfSystem == nullptr) {
+            return TlsfMemoryAllocator::kInvalidBlockIndex;
+        }
+        return mTlsfSystem->FindBlockToEvacuate();
+    }
+
+    uint64_t GetBlockIndex(const ResourceMemoryAllocation& allocation) const {
+        ASSERT(mTlsfSystem != nullptr);
+        return mTlsfSystem->GetBlockIndex(allocation);
+    }
+
+    ResourceMemoryAllocation AllocateForRelocation(uint64_t size,
+                                                   uint64_t alignment,
+                                                   const ResourceMemoryAllocation& allocation) {
+        ASSERT(mTlsfSystem != nullptr);
+        ResourceMemoryAllocation relocated =
+            mTlsfSystem->AllocateForRelocation(size, alignment, GetBlockIndex(allocation));
+        if (relocated.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+            mSubAllocationCount++;
+        }
+        return relocated;
+    }
+
+    void AccumulateStatistics(MemoryHeapStatistics* statistics) const {
+        statistics->directAllocationCount += mDirectAllocationCount;
+        statistics->directAllocatedSize += mDirectAllocatedSize;
+        statistics->blockCount += mBlockCount;
+        statistics->blockAllocatedSize += mBlockAllocatedSize;
+        statistics->subAllocationCount += mSubAllocationCount;
+        statistics->subAllocatedSize +=
+            mTlsfSystem != nullptr ? mTlsfSystem->GetUsedSize() : mBuddySystem->GetUsedSize();
     }
 
     // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
+    // and TlsfMemoryAllocator, for the memory blocks resources are suballocated in.
 
     ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
+        std::unique_ptr<ResourceHeapBase> heap;
+        DAWN_TRY_ASSIGN(heap, AllocateVkMemory(size));
+        mBlockCount++;
+        mBlockAllocatedSize += size;
+        return heap;
+    }
+
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+        ASSERT(mBlockCount > 0);
+        mBlockCount--;
+        mBlockAllocatedSize -= ToBackend(allocation.get())->GetSize();
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
+    }
+
+  private:
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateVkMemory(uint64_t size) {
         if (size > mMemoryHeapSize) {
             return DAWN_OUT_OF_MEMORY_ERROR("Allocation size too large");
         }
@@ -109,19 +216,22 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
                                   "vkAllocateMemory"));
 
         ASSERT(allocatedMemory != VK_NULL_HANDLE);
-        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+        return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex, size)};
     }
 
-    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
-        mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
-    }
-
-  private:
     Device* mDevice;
     size_t mMemoryTypeIndex;
     VkDeviceSize mMemoryHeapSize;
     PooledResourceMemoryAllocator mPooledMemoryAllocator;
-    BuddyMemoryAllocator mBuddySystem;
+    // Only one of them is used, depending on the vulkan_use_tlsf_suballocation toggle.
+    std::unique_ptr<BuddyMemoryAllocator> mBuddySystem;
+    std::unique_ptr<TlsfMemoryAllocator> mTlsfSystem;
+
+    uint64_t mDirectAllocationCount = 0;
+    uint64_t mDirectAllocatedSize = 0;
+    uint64_t mBlockCount = 0;
+    uint64_t mBlockAllocatedSize = 0;
+    uint64_t mSubAllocationCount = 0;
 };
 
 // Implementation of ResourceMemoryAllocator
@@ -130,9 +240,14 @@ ResourceMemoryAllocator::ResourceMemoryAllocator(Device* device) : mDevice(devic
     const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
     mAllocatorsPerType.reserve(info.memoryTypes.size());
 
+    bool useTlsfSuballocation = mDevice->IsToggleEnabled(Toggle::VulkanUseTlsfSuballocation);
+    mDefragmentationEnabled =
+        useTlsfSuballocation && mDevice->IsToggleEnabled(Toggle::VulkanDefragmentBufferMemory);
+
     for (size_t i = 0; i < info.memoryTypes.size(); i++) {
         mAllocatorsPerType.emplace_back(std::make_unique<SingleTypeAllocator>(
-            mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
+            mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size,
+            useTlsfSuballocation));
     }
 }
 
@@ -154,24 +269,10 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
     if (!forceDisableSubAllocation && requirements.size < kMaxSizeForSubAllocation &&
         !IsMemoryKindMappable(kind) &&
         !mDevice->IsToggleEnabled(Toggle::DisableResourceSuballocation)) {
-        // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
-        // hardware puts information on the memory's page table entry and allocating a linear
-        // resource in the same page as a non-linear (aka opaque) resource can cause issues.
-        // Probably because some texture compression flags are stored on the page table entry,
-        // and allocating a linear resource removes these flags.
-        //
-        // Anyway, just to be safe we ask that all sub-allocated resources are allocated with at
-        // least this alignment. TODO(crbug.com/dawn/849): this is suboptimal because multiple
-        // linear (resp. opaque) resources can coexist in the same page. In particular Nvidia
-        // GPUs often use a granularity of 64k which will lead to a lot of wasted spec. Revisit
-        // with a more efficient algorithm later.
-        uint64_t alignment =
-            std::max(requirements.alignment,
-                     mDevice->GetDeviceInfo().properties.limits.bufferImageGranularity);
-
         ResourceMemoryAllocation subAllocation;
-        DAWN_TRY_ASSIGN(subAllocation, mAllocatorsPerType[memoryType]->AllocateMemory(
-                                           requirements.size, alignment));
+        DAWN_TRY_ASSIGN(subAllocation,
+                        mAllocatorsPerType[memoryType]->AllocateMemory(
+                            requirements.size, GetSubAllocationAlignment(requirements)));
         if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
             return std::move(subAllocation);
         }
@@ -179,7 +280,7 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
 
     // If sub-allocation failed, allocate memory just for it.
     std::unique_ptr<ResourceHeapBase> resourceHeap;
-    DAWN_TRY_ASSIGN(resourceHeap, mAllocatorsPerType[memoryType]->AllocateResourceHeap(size));
+    DAWN_TRY_ASSIGN(resourceHeap, mAllocatorsPerType[memoryType]->AllocateDirectMemory(size));
 
     void* mappedPointer = nullptr;
     if (IsMemoryKindMappable(kind)) {
@@ -188,7 +289,7 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
                                                  ToBackend(resourceHeap.get())->GetMemory(), 0,
                                                  size, 0, &mappedPointer),
                            "vkMapMemory"),
-            { mAllocatorsPerType[memoryType]->DeallocateResourceHeap(std::move(resourceHeap)); });
+            { mAllocatorsPerType[memoryType]->DeallocateDirectMemory(std::move(resourceHeap)); });
     }
 
     AllocationInfo info;
@@ -209,8 +310,8 @@ void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
         case AllocationMethod::kDirect: {
             ResourceHeap* heap = ToBackend(allocation->GetResourceHeap());
             allocation->Invalidate();
-            mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
-            delete heap;
+            mAllocatorsPerType[heap->GetMemoryType()]->DeallocateDirectMemory(
+                std::unique_ptr<ResourceHeapBase>(heap));
             break;
         }
 
@@ -244,6 +345,103 @@ void ResourceMemoryAllocator::Tick(ExecutionSerial completedSerial) {
     mSubAllocationsToDelete.ClearUpTo(completedSerial);
 }
 
+uint64_t ResourceMemoryAllocator::GetSubAllocationAlignment(
+    const VkMemoryRequirements& requirements) const {
+    // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
+    // hardware puts information on the memory's page table entry and allocating a linear
+    // resource in the same page as a non-linear (aka opaque) resource can cause issues.
+    // Probably because some texture compression flags are stored on the page table entry,
+    // and allocating a linear resource removes these flags.
+    //
+    // Anyway, just to be safe we ask that all sub-allocated resources are allocated with at
+    // least this alignment. TODO(crbug.com/dawn/849): this is suboptimal because multiple
+    // linear (resp. opaque) resources can coexist in the same page. In particular Nvidia
+    // GPUs often use a granularity of 64k which will lead to a lot of wasted spec. Revisit
+    // with a more efficient algorithm later.
+    return std::max(requirements.alignment,
+                    mDevice->GetDeviceInfo().properties.limits.bufferImageGranularity);
+}
+
+std::vector<MemoryHeapStatistics> ResourceMemoryAllocator::GetMemoryHeapStatistics() const {
+    const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
+    std::vector<MemoryHeapStatistics> statistics(info.memoryHeaps.size());
+    for (size_t i = 0; i < info.memoryTypes.size(); i++) {
+        mAllocatorsPerType[i]->AccumulateStatistics(&statistics[info.memoryTypes[i].heapIndex]);
+    }
+    return statistics;
+}
+
+bool ResourceMemoryAllocator::IsDefragmentationEnabled() const {
+    return mDefragmentationEnabled;
+}
+
+void ResourceMemoryAllocator::TrackBufferForDefragmentation(Buffer* buffer) {
+    if (mDefragmentationEnabled &&
+        buffer->GetMemoryAllocation().GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+        mBuffersTrackedForDefragmentation.insert(buffer);
+    }
+}
+
+void ResourceMemoryAllocator::UntrackBufferForDefragmentation(Buffer* buffer) {
+    mBuffersTrackedForDefragmentation.erase(buffer);
+}
+
+ResourceMemoryAllocation ResourceMemoryAllocator::AllocateForRelocation(
+    const VkMemoryRequirements& requirements,
+    const ResourceMemoryAllocation& allocation) {
+    ASSERT(mDefragmentationEnabled);
+    ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
+
+    size_t memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
+    return mAllocatorsPerType[memoryType]->AllocateForRelocation(
+        requirements.size, GetSubAllocationAlignment(requirements), allocation);
+}
+
+MaybeError ResourceMemoryAllocator::Defragment() {
+    if (!mDefragmentationEnabled) {
+        return {};
+    }
+
+    // Evacuate at most one memory block per memory type at a time.
+    std::vector<uint64_t> blocksToEvacuate(mAllocatorsPerType.size());
+    bool hasBlockToEvacuate = false;
+    for (size_t i = 0; i < mAllocatorsPerType.size(); i++) {
+        blocksToEvacuate[i] = mAllocatorsPerType[i]->FindBlockToEvacuate();
+        hasBlockToEvacuate |= blocksToEvacuate[i] != TlsfMemoryAllocator::kInvalidBlockIndex;
+    }
+    if (!hasBlockToEvacuate) {
+        return {};
+    }
+
+    // Relocating a buffer doesn't change the set of tracked buffers so it's safe to iterate on
+    // it directly.
+    uint64_t relocatedSize = 0;
+    for (Buffer* buffer : mBuffersTrackedForDefragmentation) {
+        const ResourceMemoryAllocation& allocation = buffer->GetMemoryAllocation();
+        size_t memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
+        if (blocksToEvacuate[memoryType] == TlsfMemoryAllocator::kInvalidBlockIndex ||
+            mAllocatorsPerType[memoryType]->GetBlockIndex(allocation) !=
+                blocksToEvacuate[memoryType] ||
+            !buffer->CanBeRelocated()) {
+            continue;
+        }
+
+        bool relocated = false;
+        DAWN_TRY_ASSIGN(relocated, buffer->Relocate());
+        if (relocated) {
+            relocatedSize += buffer->GetAllocatedSize();
+        }
+
+        // Limit the amount of data copied at once so that the device doesn't stay busy for too
+        // long when the application needs it again.
+        if (relocatedSize >= kMaxDefragmentationSizePerTick) {
+            break;
+        }
+    }
+
+    return {};
+}
+
 int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind) {
     const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
     bool mappable = IsMemoryKindMappable(kind);
@@ -16,6 +16,7 @@
 #define SRC_DAWN_NATIVE_VULKAN_RESOURCEMEMORYALLOCATORVK_H_
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "dawn/common/SerialQueue.h"
@@ -24,9 +25,11 @@
 #include "dawn/native/IntegerTypes.h"
 #include "dawn/native/PooledResourceMemoryAllocator.h"
 #include "dawn/native/ResourceMemoryAllocation.h"
+#include "dawn/native/VulkanBackend.h"
 
 namespace dawn::native::vulkan {
 
+class Buffer;
 class Device;
 
 // Various kinds of memory that influence the result of the allocation. For example, to take
@@ -55,13 +58,37 @@ class ResourceMemoryAllocator {
 
     int FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind);
 
+    std::vector<MemoryHeapStatistics> GetMemoryHeapStatistics() const;
+
+    // Defragmentation of the buffer memory, only enabled with the vulkan_use_tlsf_suballocation
+    // and vulkan_defragment_buffer_memory toggles. Buffers that are suballocated are tracked so
+    // that the ones in the least used memory block can be relocated to the other memory blocks.
+    bool IsDefragmentationEnabled() const;
+    void TrackBufferForDefragmentation(Buffer* buffer);
+    void UntrackBufferForDefragmentation(Buffer* buffer);
+
+    // Allocates memory for `allocation`'s resource in another memory block that's already in use.
+    // Returns an invalid allocation when there isn't enough space in the other memory blocks.
+    ResourceMemoryAllocation AllocateForRelocation(const VkMemoryRequirements& requirements,
+                                                   const ResourceMemoryAllocation& allocation);
+
+    // Relocates some of the tracked buffers. Must only be called when the GPU is idle and no
+    // commands are recorded in the pending recording context, since they could reference the
+    // VkBuffers that are replaced.
+    MaybeError Defragment();
+
   private:
+    uint64_t GetSubAllocationAlignment(const VkMemoryRequirements& requirements) const;
+
     Device* mDevice;
 
     class SingleTypeAllocator;
     std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
     SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
+
+    bool mDefragmentationEnabled = false;
+    std::unordered_set<Buffer*> mBuffersTrackedForDefragmentation;
 };
 
 }  // namespace dawn::native::vulkan
@@ -14,6 +14,7 @@
 
 #include "dawn/native/vulkan/TextureVk.h"
 
+#include <mutex>
 #include <utility>
 
 #include "dawn/common/Assert.h"
@@ -911,6 +912,7 @@ void Texture::TransitionEagerlyForExport(CommandRecordingContext* recordingConte
 
     device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
                                   nullptr, 0, nullptr, 1, &barrier);
+    device->IncrementPipelineBarrierCountForTesting();
 }
 
 std::vector<VkSemaphore> Texture::AcquireWaitRequirements() {
@@ -1184,17 +1186,29 @@ void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
     VkPipelineStageFlags srcStages = 0;
     VkPipelineStageFlags dstStages = 0;
 
-    TransitionUsageAndGetResourceBarrier(usage, range, &barriers, &srcStages, &dstStages);
-
-    if (mExternalState != ExternalState::InternalOnly) {
-        TweakTransitionForExternalUsage(recordingContext, &barriers, 0);
-    }
+    TrackUsageAndGetResourceBarriers(recordingContext, usage, range, &barriers, &srcStages,
+                                     &dstStages);
 
     if (!barriers.empty()) {
         ASSERT(srcStages != 0 && dstStages != 0);
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, barriers.size(), barriers.data());
+        Device* device = ToBackend(GetDevice());
+        device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
+                                      nullptr, 0, nullptr, barriers.size(), barriers.data());
+        device->IncrementPipelineBarrierCountForTesting();
+    }
+}
+
+void Texture::TrackUsageAndGetResourceBarriers(CommandRecordingContext* recordingContext,
+                                               wgpu::TextureUsage usage,
+                                               const SubresourceRange& range,
+                                               std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                               VkPipelineStageFlags* srcStages,
+                                               VkPipelineStageFlags* dstStages) {
+    size_t transitionBarrierStart = imageBarriers->size();
+    TransitionUsageAndGetResourceBarrier(usage, range, imageBarriers, srcStages, dstStages);
+
+    if (mExternalState != ExternalState::InternalOnly) {
+        TweakTransitionForExternalUsage(recordingContext, imageBarriers, transitionBarrierStart);
     }
 }
 
@@ -1271,9 +1285,12 @@ MaybeError Texture::ClearTexture(CommandRecordingContext* recordingContext,
                               largestMipSize.depthOrArrayLayers;
         DynamicUploader* uploader = device->GetDynamicUploader();
         UploadHandle uploadHandle;
-        DAWN_TRY_ASSIGN(
-            uploadHandle,
-            uploader->Allocate(bufferSize, device->GetPendingCommandSerial(), blockInfo.byteSize));
+        {
+            std::lock_guard<std::mutex> lock(device->GetParallelRecordingMutex());
+            DAWN_TRY_ASSIGN(uploadHandle, uploader->Allocate(bufferSize,
+                                                             device->GetPendingCommandSerial(),
+                                                             blockInfo.byteSize));
+        }
         memset(uploadHandle.mappedBuffer, uClearColor, bufferSize);
 
         std::vector<VkBufferImageCopy> regions;
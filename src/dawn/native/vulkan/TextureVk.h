@@ -74,6 +74,14 @@ class Texture final : public TextureBase {
     void TransitionUsageNow(CommandRecordingContext* recordingContext,
                             wgpu::TextureUsage usage,
                             const SubresourceRange& range);
+    // Same as TransitionUsageNow but appends the barriers to `imageBarriers` so that they can be
+    // recorded together with the barriers of other resources.
+    void TrackUsageAndGetResourceBarriers(CommandRecordingContext* recordingContext,
+                                          wgpu::TextureUsage usage,
+                                          const SubresourceRange& range,
+                                          std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                          VkPipelineStageFlags* srcStages,
+                                          VkPipelineStageFlags* dstStages);
     void TransitionUsageForPass(CommandRecordingContext* recordingContext,
                                 const TextureSubresourceUsage& textureUsages,
                                 std::vector<VkImageMemoryBarrier>* imageBarriers,
@@ -22,6 +22,7 @@
 #include "dawn/native/VulkanBackend.h"
 
 #include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
 
 namespace dawn::native::vulkan {
@@ -36,6 +37,22 @@ DAWN_NATIVE_EXPORT PFN_vkVoidFunction GetInstanceProcAddr(WGPUDevice device, con
     return (*backendDevice->fn.GetInstanceProcAddr)(backendDevice->GetVkInstance(), pName);
 }
 
+size_t GetPipelineBarrierCountForTesting(WGPUDevice device) {
+    return ToBackend(FromAPI(device))->GetPipelineBarrierCountForTesting();
+}
+
+std::vector<MemoryHeapStatistics> GetMemoryHeapStatistics(WGPUDevice device) {
+    Device* backendDevice = ToBackend(FromAPI(device));
+    auto deviceLock(backendDevice->GetScopedLock());
+    return backendDevice->GetResourceMemoryAllocator()->GetMemoryHeapStatistics();
+}
+
+void CreatePipelinesBatchAsync(WGPUDevice device, const PipelinesBatchDescriptor* descriptor) {
+    Device* backendDevice = ToBackend(FromAPI(device));
+    auto deviceLock(backendDevice->GetScopedLock());
+    backendDevice->CreatePipelinesBatchAsync(descriptor);
+}
+
 PhysicalDeviceDiscoveryOptions::PhysicalDeviceDiscoveryOptions()
     : PhysicalDeviceDiscoveryOptionsBase(WGPUBackendType_Vulkan) {}
 
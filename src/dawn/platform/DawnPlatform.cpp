@@ -25,6 +25,10 @@ CachingInterface::CachingInterface() = default;
 
 CachingInterface::~CachingInterface() = default;
 
+bool CachingInterface::IsThreadSafe() const {
+    return false;
+}
+
 Platform::Platform() = default;
 
 Platform::~Platform() = default;
@@ -0,0 +1,704 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/platform/caching/FileCachingInterface.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dawn::platform {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+namespace {
+
+constexpr char kPackFileName[] = "cache.pack";
+constexpr char kIndexFileName[] = "cache.index";
+constexpr char kLockFileName[] = "cache.lock";
+constexpr char kTemporarySuffix[] = ".tmp";
+
+constexpr char kPackMagic[8] = {'D', 'A', 'W', 'N', 'P', 'A', 'K', '1'};
+constexpr char kIndexMagic[8] = {'D', 'A', 'W', 'N', 'I', 'D', 'X', '1'};
+constexpr uint32_t kRecordMagic = 0x44434552;  // "RECD" in little-endian
+
+// The smallest mapping of the pack file, to avoid remapping while the cache is small.
+constexpr uint64_t kMinMappingSize = 1 << 20;
+// The pack file isn't compacted before it holds at least this many bytes of dead records.
+constexpr uint64_t kMinCompactionSize = 1 << 20;
+
+struct PackHeader {
+    char magic[8];
+    // Incremented each time the pack file is rewritten, to detect stale index files.
+    uint64_t generation;
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t keySize;
+    uint64_t valueSize;
+    // Checksum of the key and the value, used to detect torn records.
+    uint64_t checksum;
+};
+
+struct IndexHeader {
+    char magic[8];
+    uint64_t generation;
+    // The size of the pack file that the index describes. Records after it are found by scanning.
+    uint64_t packSize;
+    uint64_t entryCount;
+};
+
+// The entries of the index are the offsets of the live records, from least to most recently used.
+using IndexEntry = uint64_t;
+
+// 64-bit FNV-1a.
+uint64_t Checksum(const void* key, size_t keySize, const void* value, uint64_t valueSize) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto Accumulate = [&hash](const void* data, uint64_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (uint64_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    };
+    Accumulate(key, keySize);
+    Accumulate(value, valueSize);
+    return hash;
+}
+
+uint64_t GetRecordSize(uint64_t keySize, uint64_t valueSize) {
+    return sizeof(RecordHeader) + keySize + valueSize;
+}
+
+// Returns true if |record| is a valid record for |key| with a value of |valueSize| bytes.
+bool IsValidRecord(const uint8_t* record, const std::string& key, uint64_t valueSize) {
+    RecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    const uint8_t* recordKey = record + sizeof(RecordHeader);
+    return header.magic == kRecordMagic && header.keySize == key.size() &&
+           header.valueSize == valueSize && memcmp(recordKey, key.data(), key.size()) == 0 &&
+           Checksum(recordKey, header.keySize, recordKey + header.keySize, header.valueSize) ==
+               header.checksum;
+}
+
+bool WriteAll(int fd, const void* data, uint64_t size, uint64_t offset) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        offset += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool ReadAll(int fd, void* data, uint64_t size, uint64_t offset) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t read = pread(fd, bytes, size, static_cast<off_t>(offset));
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (read == 0) {
+            return false;
+        }
+        bytes += read;
+        offset += read;
+        size -= read;
+    }
+    return true;
+}
+
+std::optional<uint64_t> GetFileSize(int fd) {
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(info.st_size);
+}
+
+// Makes the renames in |directory| durable.
+void SyncDirectory(const std::string& directory) {
+    int fd = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+// Atomically replaces the file at |path| with |data|: the data is written to a temporary file
+// that is renamed over |path| once it is durable.
+bool ReplaceFile(const std::string& directory,
+                 const std::string& path,
+                 const void* data,
+                 uint64_t size) {
+    std::string temporaryPath = path + kTemporarySuffix;
+    int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool success = WriteAll(fd, data, size, 0) && fsync(fd) == 0;
+    close(fd);
+    if (!success || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    SyncDirectory(directory);
+    return true;
+}
+
+}  // anonymous namespace
+
+FileCachingInterface::Entry::Entry(uint64_t offset,
+                                   uint64_t valueSize,
+                                   uint64_t recordSize,
+                                   uint64_t lastUse,
+                                   bool verified)
+    : offset(offset),
+      valueSize(valueSize),
+      recordSize(recordSize),
+      lastUse(lastUse),
+      verified(verified) {}
+
+// static
+std::unique_ptr<FileCachingInterface> FileCachingInterface::Create(const std::string& directory,
+                                                                   uint64_t maxSize) {
+    std::unique_ptr<FileCachingInterface> cache(new FileCachingInterface(directory, maxSize));
+    if (!cache->Initialize()) {
+        return nullptr;
+    }
+    return cache;
+}
+
+FileCachingInterface::FileCachingInterface(std::string directory, uint64_t maxSize)
+    : mDirectory(std::move(directory)), mMaxSize(maxSize) {}
+
+FileCachingInterface::~FileCachingInterface() {
+    if (mMapping != nullptr && !mReadOnly) {
+        std::unique_lock<std::shared_mutex> lock(mMutex);
+        if (mIndexDirty) {
+            FlushInternal();
+        }
+    }
+    UnmapPack();
+    if (mPackFd >= 0) {
+        close(mPackFd);
+    }
+    // Release the lock last, once the index is written.
+    if (mLockFd >= 0) {
+        close(mLockFd);
+    }
+}
+
+bool FileCachingInterface::Initialize() {
+    if (mkdir(mDirectory.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+
+    // The lock is taken on a separate file because compaction replaces the pack file. The lock is
+    // released when the file is closed, including when the process crashes.
+    mLockFd = open(LockPath().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mLockFd < 0) {
+        return false;
+    }
+    if (flock(mLockFd, LOCK_EX | LOCK_NB) != 0) {
+        if (errno != EWOULDBLOCK) {
+            return false;
+        }
+        mReadOnly = true;
+    }
+
+    // A read-only cache never modifies the files. The process that holds the lock only appends
+    // records after the ones that are valid, or replaces the pack file, so the records of the
+    // mapping stay valid.
+    mPackFd = mReadOnly ? open(PackPath().c_str(), O_RDONLY | O_CLOEXEC)
+                        : open(PackPath().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (mPackFd < 0) {
+        return false;
+    }
+    std::optional<uint64_t> fileSize = GetFileSize(mPackFd);
+    if (!fileSize) {
+        return false;
+    }
+
+    PackHeader header;
+    if (*fileSize < sizeof(PackHeader) || !ReadAll(mPackFd, &header, sizeof(header), 0) ||
+        memcmp(header.magic, kPackMagic, sizeof(kPackMagic)) != 0) {
+        if (mReadOnly || !CreateEmptyPack()) {
+            return false;
+        }
+        fileSize = sizeof(PackHeader);
+    } else {
+        mGeneration = header.generation;
+    }
+
+    if (!MapPack(*fileSize)) {
+        return false;
+    }
+
+    // Recover the entries from the index, then the records appended after the index was written.
+    // The pack file is truncated after the last valid record to drop a record torn by a crash.
+    uint64_t scanOffset = sizeof(PackHeader);
+    uint64_t indexedPackSize = 0;
+    if (ReadIndex(&indexedPackSize)) {
+        scanOffset = indexedPackSize;
+    }
+    mPackSize = ScanPack(scanOffset, *fileSize);
+    if (!mReadOnly && mPackSize < *fileSize &&
+        ftruncate(mPackFd, static_cast<off_t>(mPackSize)) != 0) {
+        return false;
+    }
+    mIndexDirty = mPackSize != indexedPackSize;
+
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+    EvictIfNeeded();
+    return true;
+}
+
+bool FileCachingInterface::CreateEmptyPack() {
+    // Remove the index first so that it can never describe the new pack file.
+    if (unlink(IndexPath().c_str()) != 0 && errno != ENOENT) {
+        return false;
+    }
+    PackHeader header;
+    memcpy(header.magic, kPackMagic, sizeof(kPackMagic));
+    header.generation = 0;
+    mGeneration = 0;
+    return ftruncate(mPackFd, 0) == 0 && WriteAll(mPackFd, &header, sizeof(header), 0);
+}
+
+bool FileCachingInterface::ReadIndex(uint64_t* indexedPackSize) {
+    int fd = open(IndexPath().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    std::optional<uint64_t> indexSize = GetFileSize(fd);
+    std::vector<uint8_t> data(indexSize.value_or(0));
+    bool readSuccess = indexSize && ReadAll(fd, data.data(), data.size(), 0);
+    close(fd);
+    if (!readSuccess || data.size() < sizeof(IndexHeader)) {
+        return false;
+    }
+
+    IndexHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    std::optional<uint64_t> packFileSize = GetFileSize(mPackFd);
+    if (memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        header.generation != mGeneration || !packFileSize || header.packSize > *packFileSize ||
+        header.packSize < sizeof(PackHeader) ||
+        header.entryCount != (data.size() - sizeof(IndexHeader)) / sizeof(IndexEntry)) {
+        return false;
+    }
+
+    // The index is only written once the pack file is durable, so the records it points to are
+    // only checked for consistency here. Their checksum is verified when they are first loaded.
+    for (uint64_t i = 0; i < header.entryCount; ++i) {
+        IndexEntry offset;
+        memcpy(&offset, data.data() + sizeof(IndexHeader) + i * sizeof(IndexEntry),
+               sizeof(offset));
+
+        RecordHeader record;
+        if (offset < sizeof(PackHeader) || offset > header.packSize ||
+            header.packSize - offset < sizeof(RecordHeader)) {
+            break;
+        }
+        memcpy(&record, mMapping + offset, sizeof(record));
+        uint64_t recordSize = GetRecordSize(record.keySize, record.valueSize);
+        if (record.magic != kRecordMagic || record.valueSize > header.packSize ||
+            recordSize > header.packSize - offset) {
+            break;
+        }
+        std::string key(reinterpret_cast<const char*>(mMapping + offset + sizeof(RecordHeader)),
+                        record.keySize);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end()) {
+            RemoveEntry(it);
+        }
+        AddEntry(std::move(key), offset, record.valueSize, recordSize, /*verified=*/false);
+    }
+
+    if (mEntries.size() != header.entryCount) {
+        mEntries.clear();
+        mLiveSize = 0;
+        return false;
+    }
+    *indexedPackSize = header.packSize;
+    return true;
+}
+
+bool FileCachingInterface::WriteIndex() {
+    std::vector<std::pair<uint64_t, uint64_t>> entriesByUse;
+    entriesByUse.reserve(mEntries.size());
+    for (const auto& [key, entry] : mEntries) {
+        entriesByUse.emplace_back(entry.lastUse.load(std::memory_order_relaxed), entry.offset);
+    }
+    std::sort(entriesByUse.begin(), entriesByUse.end());
+
+    IndexHeader header;
+    memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.generation = mGeneration;
+    header.packSize = mPackSize;
+    header.entryCount = entriesByUse.size();
+
+    std::vector<uint8_t> data(sizeof(IndexHeader) + entriesByUse.size() * sizeof(IndexEntry));
+    memcpy(data.data(), &header, sizeof(header));
+    for (size_t i = 0; i < entriesByUse.size(); ++i) {
+        IndexEntry offset = entriesByUse[i].second;
+        memcpy(data.data() + sizeof(IndexHeader) + i * sizeof(IndexEntry), &offset,
+               sizeof(offset));
+    }
+    return ReplaceFile(mDirectory, IndexPath(), data.data(), data.size());
+}
+
+uint64_t FileCachingInterface::ScanPack(uint64_t offset, uint64_t packFileSize) {
+    while (packFileSize - offset >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        memcpy(&record, mMapping + offset, sizeof(record));
+        if (record.magic != kRecordMagic || record.valueSize > packFileSize) {
+            break;
+        }
+        uint64_t recordSize = GetRecordSize(record.keySize, record.valueSize);
+        if (recordSize > packFileSize - offset) {
+            break;
+        }
+        const uint8_t* key = mMapping + offset + sizeof(RecordHeader);
+        const uint8_t* value = key + record.keySize;
+        if (Checksum(key, record.keySize, value, record.valueSize) != record.checksum) {
+            break;
+        }
+
+        std::string keyString(reinterpret_cast<const char*>(key), record.keySize);
+        auto it = mEntries.find(keyString);
+        if (it != mEntries.end()) {
+            RemoveEntry(it);
+        }
+        AddEntry(std::move(keyString), offset, record.valueSize, recordSize, /*verified=*/true);
+        offset += recordSize;
+    }
+    return offset;
+}
+
+bool FileCachingInterface::MapPack(uint64_t minSize) {
+    uint64_t mappingSize = std::max(kMinMappingSize, NextPowerOfTwo(minSize));
+    if (mappingSize > std::numeric_limits<size_t>::max()) {
+        return false;
+    }
+    // Map the new range before unmapping the old one so that a failure leaves the previous mapping
+    // usable.
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, mPackFd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    UnmapPack();
+    mMapping = static_cast<uint8_t*>(mapping);
+    mMappingSize = mappingSize;
+    return true;
+}
+
+void FileCachingInterface::UnmapPack() {
+    if (mMapping != nullptr) {
+        munmap(mMapping, mMappingSize);
+        mMapping = nullptr;
+        mMappingSize = 0;
+    }
+}
+
+size_t FileCachingInterface::LoadData(const void* key,
+                                      size_t keySize,
+                                      void* valueOut,
+                                      size_t valueSize) {
+    std::string keyString(static_cast<const char*>(key), keySize);
+
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+    auto it = mEntries.find(keyString);
+    if (it == mEntries.end()) {
+        return 0;
+    }
+    Entry& entry = it->second;
+
+    // Check that the record wasn't corrupted on disk before returning its value for the first
+    // time. Corrupted records are removed.
+    if (!entry.verified.load(std::memory_order_acquire)) {
+        if (!IsValidRecord(mMapping + entry.offset, keyString, entry.valueSize)) {
+            uint64_t offset = entry.offset;
+            lock.unlock();
+            std::unique_lock<std::shared_mutex> exclusiveLock(mMutex);
+            it = mEntries.find(keyString);
+            if (it != mEntries.end() && it->second.offset == offset) {
+                RemoveEntry(it);
+            }
+            return 0;
+        }
+        entry.verified.store(true, std::memory_order_release);
+    }
+
+    entry.lastUse.store(mUseCounter.fetch_add(1, std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+    mIndexDirty.store(true, std::memory_order_relaxed);
+
+    if (valueOut == nullptr) {
+        ASSERT(valueSize == 0);
+        return entry.valueSize;
+    }
+    if (valueSize < entry.valueSize) {
+        return 0;
+    }
+    memcpy(valueOut, mMapping + entry.offset + sizeof(RecordHeader) + keySize, entry.valueSize);
+    return entry.valueSize;
+}
+
+void FileCachingInterface::StoreData(const void* key,
+                                     size_t keySize,
+                                     const void* value,
+                                     size_t valueSize) {
+    uint64_t recordSize = GetRecordSize(keySize, valueSize);
+    if (mReadOnly || keySize > std::numeric_limits<uint32_t>::max() || recordSize > mMaxSize) {
+        return;
+    }
+
+    // Build the record outside of the lock.
+    RecordHeader header;
+    header.magic = kRecordMagic;
+    header.keySize = static_cast<uint32_t>(keySize);
+    header.valueSize = valueSize;
+    header.checksum = Checksum(key, keySize, value, valueSize);
+    std::vector<uint8_t> record(recordSize);
+    memcpy(record.data(), &header, sizeof(header));
+    memcpy(record.data() + sizeof(header), key, keySize);
+    memcpy(record.data() + sizeof(header) + keySize, value, valueSize);
+    std::string keyString(static_cast<const char*>(key), keySize);
+
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+    uint64_t offset = mPackSize;
+    if (!WriteAll(mPackFd, record.data(), recordSize, offset) ||
+        (offset + recordSize > mMappingSize && !MapPack(offset + recordSize))) {
+        // Drop the partially written record so that it isn't mistaken for a torn record.
+        ftruncate(mPackFd, static_cast<off_t>(offset));
+        return;
+    }
+    mPackSize += recordSize;
+
+    auto it = mEntries.find(keyString);
+    if (it != mEntries.end()) {
+        RemoveEntry(it);
+    }
+    AddEntry(std::move(keyString), offset, valueSize, recordSize, /*verified=*/true);
+
+    EvictIfNeeded();
+    if (GetDeadSize() > std::max(mLiveSize, kMinCompactionSize)) {
+        Compact();
+    }
+}
+
+bool FileCachingInterface::IsThreadSafe() const {
+    return true;
+}
+
+bool FileCachingInterface::IsReadOnly() const {
+    return mReadOnly;
+}
+
+void FileCachingInterface::Flush() {
+    if (mReadOnly) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+    FlushInternal();
+}
+
+size_t FileCachingInterface::GetEntryCount() {
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+uint64_t FileCachingInterface::GetLiveSize() {
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+    return mLiveSize;
+}
+
+uint64_t FileCachingInterface::GetPackFileSize() {
+    std::shared_lock<std::shared_mutex> lock(mMutex);
+    return mPackSize;
+}
+
+void FileCachingInterface::AddEntry(std::string key,
+                                    uint64_t offset,
+                                    uint64_t valueSize,
+                                    uint64_t recordSize,
+                                    bool verified) {
+    uint64_t lastUse = mUseCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+    mEntries.emplace(std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                     std::forward_as_tuple(offset, valueSize, recordSize, lastUse, verified));
+    mLiveSize += recordSize;
+    mIndexDirty = true;
+}
+
+void FileCachingInterface::RemoveEntry(std::unordered_map<std::string, Entry>::iterator it) {
+    mLiveSize -= it->second.recordSize;
+    mEntries.erase(it);
+    mIndexDirty = true;
+}
+
+uint64_t FileCachingInterface::GetDeadSize() const {
+    return mPackSize - sizeof(PackHeader) - mLiveSize;
+}
+
+void FileCachingInterface::EvictIfNeeded() {
+    if (mLiveSize <= mMaxSize) {
+        return;
+    }
+
+    // Evict down to a fraction of the maximum size so that the cost of sorting the entries is
+    // amortized over multiple stores.
+    std::vector<std::pair<uint64_t, std::unordered_map<std::string, Entry>::iterator>> entriesByUse;
+    entriesByUse.reserve(mEntries.size());
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        entriesByUse.emplace_back(it->second.lastUse.load(std::memory_order_relaxed), it);
+    }
+    std::sort(entriesByUse.begin(), entriesByUse.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    const uint64_t targetSize = mMaxSize - mMaxSize / 4;
+    for (auto& [lastUse, it] : entriesByUse) {
+        if (mLiveSize <= targetSize) {
+            break;
+        }
+        RemoveEntry(it);
+    }
+}
+
+bool FileCachingInterface::Compact() {
+    // Copy the live records, in pack order, to a new pack file that replaces the current one once
+    // it is durable. The generation is incremented so that the current index is ignored if we
+    // crash before writing the new one.
+    std::string temporaryPath = PackPath() + kTemporarySuffix;
+    int fd = open(temporaryPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::vector<Entry*> entries;
+    entries.reserve(mEntries.size());
+    for (auto& [key, entry] : mEntries) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry* a, const Entry* b) { return a->offset < b->offset; });
+
+    PackHeader header;
+    memcpy(header.magic, kPackMagic, sizeof(kPackMagic));
+    header.generation = mGeneration + 1;
+    bool success = WriteAll(fd, &header, sizeof(header), 0);
+
+    std::vector<uint64_t> newOffsets;
+    newOffsets.reserve(entries.size());
+    uint64_t offset = sizeof(PackHeader);
+    for (const Entry* entry : entries) {
+        if (!success) {
+            break;
+        }
+        success = WriteAll(fd, mMapping + entry->offset, entry->recordSize, offset);
+        newOffsets.push_back(offset);
+        offset += entry->recordSize;
+    }
+
+    success = success && fsync(fd) == 0 && rename(temporaryPath.c_str(), PackPath().c_str()) == 0;
+    if (!success) {
+        close(fd);
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    SyncDirectory(mDirectory);
+
+    // The new pack file must be mapped before the offsets can be updated. If this fails, the
+    // cache is emptied since its entries point into the previous pack file.
+    UnmapPack();
+    close(mPackFd);
+    mPackFd = fd;
+    mGeneration = header.generation;
+    mPackSize = offset;
+    if (!MapPack(mPackSize)) {
+        mEntries.clear();
+        mLiveSize = 0;
+        CreateEmptyPack();
+        mPackSize = sizeof(PackHeader);
+        return false;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entries[i]->offset = newOffsets[i];
+    }
+    return WriteIndex();
+}
+
+void FileCachingInterface::FlushInternal() {
+    if (fsync(mPackFd) == 0 && WriteIndex()) {
+        mIndexDirty = false;
+    }
+}
+
+std::string FileCachingInterface::PackPath() const {
+    return mDirectory + "/" + kPackFileName;
+}
+
+std::string FileCachingInterface::IndexPath() const {
+    return mDirectory + "/" + kIndexFileName;
+}
+
+std::string FileCachingInterface::LockPath() const {
+    return mDirectory + "/" + kLockFileName;
+}
+
+std::unique_ptr<CachingInterface> CreateFileCachingInterface(const char* directory,
+                                                             uint64_t maxSizeInBytes) {
+    return FileCachingInterface::Create(directory, maxSizeInBytes);
+}
+
+#else  // DAWN_PLATFORM_IS(POSIX)
+
+std::unique_ptr<CachingInterface> CreateFileCachingInterface(const char* directory,
+                                                             uint64_t maxSizeInBytes) {
+    // The file-backed cache relies on POSIX file and memory mapping APIs.
+    return nullptr;
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // namespace dawn::platform
@@ -0,0 +1,146 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_PLATFORM_CACHING_FILECACHINGINTERFACE_H_
+#define SRC_DAWN_PLATFORM_CACHING_FILECACHINGINTERFACE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/dawn_platform_export.h"
+
+namespace dawn::platform {
+
+// A CachingInterface that persists its entries in a directory on disk.
+//
+// Entries are appended as checksummed records to a pack file. The location of the live records is
+// kept in an in-memory index that is written to an index file when the cache is destroyed or
+// compacted. Records appended after the last index write are recovered by scanning the tail of the
+// pack file, and a torn record left by a crash is detected by its checksum and truncated. The
+// records found through the index have their checksum verified the first time they are loaded. A
+// crash can lose recently stored entries but never returns corrupted ones.
+//
+// Only one process at a time can write to the cache files, which is ensured by an exclusive lock
+// on a lock file in the directory. When another process holds the lock, the cache is opened
+// read-only: the entries that are on disk can be loaded, but stores are dropped.
+//
+// Loads copy out of a read-only memory mapping of the pack file and only take a shared lock, so
+// they can happen concurrently. Stores take an exclusive lock. When the size of the live records
+// exceeds the maximum size, the least recently used entries are evicted, and the pack file is
+// compacted once it is mostly made of dead records.
+class DAWN_PLATFORM_EXPORT FileCachingInterface final : public CachingInterface, public NonMovable {
+  public:
+    // Opens the cache stored in |directory|, creating the directory and the cache files if needed.
+    // Returns nullptr if the cache files can't be opened.
+    static std::unique_ptr<FileCachingInterface> Create(const std::string& directory,
+                                                        uint64_t maxSize);
+
+    ~FileCachingInterface() override;
+
+    size_t LoadData(const void* key, size_t keySize, void* valueOut, size_t valueSize) override;
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override;
+    bool IsThreadSafe() const override;
+
+    // Returns true if another process holds the lock of the cache directory, in which case the
+    // cache can't be stored to.
+    bool IsReadOnly() const;
+
+    // Makes the stored entries durable and writes the index so that the next open doesn't have to
+    // scan the pack file.
+    void Flush();
+
+    // Accessors used for testing.
+    size_t GetEntryCount();
+    uint64_t GetLiveSize();
+    uint64_t GetPackFileSize();
+
+  private:
+    struct Entry {
+        Entry(uint64_t offset,
+              uint64_t valueSize,
+              uint64_t recordSize,
+              uint64_t lastUse,
+              bool verified);
+
+        // Offset of the record in the pack file.
+        uint64_t offset;
+        uint64_t valueSize;
+        uint64_t recordSize;
+        // The value of mUseCounter the last time the entry was stored or loaded.
+        std::atomic<uint64_t> lastUse;
+        // Whether the checksum of the record was verified.
+        std::atomic<bool> verified;
+    };
+
+    FileCachingInterface(std::string directory, uint64_t maxSize);
+
+    bool Initialize();
+    bool ReadIndex(uint64_t* indexedPackSize);
+    bool WriteIndex();
+    uint64_t ScanPack(uint64_t offset, uint64_t packFileSize);
+    bool CreateEmptyPack();
+    bool MapPack(uint64_t minSize);
+    void UnmapPack();
+
+    // All the functions below must be called with mMutex held exclusively.
+    void AddEntry(std::string key,
+                  uint64_t offset,
+                  uint64_t valueSize,
+                  uint64_t recordSize,
+                  bool verified);
+    void RemoveEntry(std::unordered_map<std::string, Entry>::iterator it);
+    uint64_t GetDeadSize() const;
+    void EvictIfNeeded();
+    bool Compact();
+    void FlushInternal();
+
+    std::string PackPath() const;
+    std::string IndexPath() const;
+    std::string LockPath() const;
+
+    const std::string mDirectory;
+    const uint64_t mMaxSize;
+
+    std::shared_mutex mMutex;
+    std::unordered_map<std::string, Entry> mEntries;
+    std::atomic<uint64_t> mUseCounter = 0;
+
+    // The lock file, which is locked exclusively unless the cache is read-only.
+    int mLockFd = -1;
+    bool mReadOnly = false;
+
+    int mPackFd = -1;
+    uint64_t mGeneration = 0;
+    uint64_t mPackSize = 0;
+    // The size of the records of the entries in mEntries. The rest of the pack file after its
+    // header is made of dead records.
+    uint64_t mLiveSize = 0;
+    // Whether the entries or their use order changed since the index was last written.
+    std::atomic<bool> mIndexDirty = false;
+
+    // The mapping of the pack file. It is larger than the pack file so that appended records are
+    // visible without remapping.
+    uint8_t* mMapping = nullptr;
+    uint64_t mMappingSize = 0;
+};
+
+}  // namespace dawn::platform
+
+#endif  // SRC_DAWN_PLATFORM_CACHING_FILECACHINGINTERFACE_H_
@@ -0,0 +1,160 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/ConcurrentCache.h"
+#include "dawn/common/ContentLessObjectCache.h"
+#include "dawn/common/Ref.h"
+#include "dawn/common/RefCounted.h"
+
+namespace dawn {
+namespace {
+
+// Benchmarks for the contention of the thread-safe caches used to deduplicate frontend objects.
+// Each benchmark is run with an increasing number of threads operating on the same cache.
+
+constexpr size_t kNumKeys = 1024;
+// Offset between the keys used by each thread in benchmarks where threads use disjoint keys.
+constexpr size_t kThreadKeyStride = 1 << 20;
+
+class SimpleCachedObject {
+  public:
+    explicit SimpleCachedObject(size_t value) : mValue(value) {}
+
+    struct EqualityFunc {
+        bool operator()(const SimpleCachedObject* a, const SimpleCachedObject* b) const {
+            return a->mValue == b->mValue;
+        }
+    };
+
+    struct HashFunc {
+        size_t operator()(const SimpleCachedObject* obj) const { return obj->mValue; }
+    };
+
+  private:
+    size_t mValue;
+};
+
+class CacheableObject : public RefCounted, public ContentLessObjectCacheable<CacheableObject> {
+  public:
+    explicit CacheableObject(size_t value) : mValue(value) {}
+
+    // Like the cached frontend objects, remove the object from its cache when the last reference
+    // is released.
+    void DeleteThis() override {
+        Uncache();
+        RefCounted::DeleteThis();
+    }
+
+    struct EqualityFunc {
+        bool operator()(const CacheableObject* a, const CacheableObject* b) const {
+            return a->mValue == b->mValue;
+        }
+    };
+
+    struct HashFunc {
+        size_t operator()(const CacheableObject* obj) const { return obj->mValue; }
+    };
+
+  private:
+    size_t mValue;
+};
+
+// A ContentLessObjectCache along with the references keeping its entries alive.
+struct PopulatedContentLessObjectCache {
+    PopulatedContentLessObjectCache() {
+        for (size_t i = 0; i < kNumKeys; ++i) {
+            Ref<CacheableObject> object = AcquireRef(new CacheableObject(i));
+            cache.Insert(object.Get());
+            objects.push_back(std::move(object));
+        }
+    }
+
+    ContentLessObjectCache<CacheableObject> cache;
+    std::vector<Ref<CacheableObject>> objects;
+};
+
+// Looks up objects that are already in a ConcurrentCache, which is the common case of creating an
+// object that was already created.
+void ConcurrentCacheFind(benchmark::State& state) {
+    static ConcurrentCache<SimpleCachedObject>* cache = [] {
+        auto* cache = new ConcurrentCache<SimpleCachedObject>();
+        for (size_t i = 0; i < kNumKeys; ++i) {
+            cache->Insert(new SimpleCachedObject(i));
+        }
+        return cache;
+    }();
+
+    size_t key = state.thread_index();
+    for (auto _ : state) {
+        SimpleCachedObject blueprint(key);
+        benchmark::DoNotOptimize(cache->Find(&blueprint));
+        key = (key + 1) % kNumKeys;
+    }
+}
+BENCHMARK(ConcurrentCacheFind)->Threads(1)->Threads(4)->Threads(16)->Threads(32);
+
+// Inserts and erases objects in a ConcurrentCache, each thread using its own keys.
+void ConcurrentCacheInsertErase(benchmark::State& state) {
+    static ConcurrentCache<SimpleCachedObject> cache;
+
+    std::vector<SimpleCachedObject> objects;
+    objects.reserve(kNumKeys);
+    for (size_t i = 0; i < kNumKeys; ++i) {
+        objects.emplace_back(state.thread_index() * kThreadKeyStride + i);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.Insert(&objects[i]));
+        cache.Erase(&objects[i]);
+        i = (i + 1) % kNumKeys;
+    }
+}
+BENCHMARK(ConcurrentCacheInsertErase)->Threads(1)->Threads(4)->Threads(16)->Threads(32);
+
+// Looks up live objects in a ContentLessObjectCache, as done when getting or creating frontend
+// objects that are already cached.
+void ContentLessObjectCacheFind(benchmark::State& state) {
+    static PopulatedContentLessObjectCache* populated = new PopulatedContentLessObjectCache();
+
+    size_t key = state.thread_index();
+    for (auto _ : state) {
+        CacheableObject blueprint(key);
+        benchmark::DoNotOptimize(populated->cache.Find(&blueprint));
+        key = (key + 1) % kNumKeys;
+    }
+}
+BENCHMARK(ContentLessObjectCacheFind)->Threads(1)->Threads(4)->Threads(16)->Threads(32);
+
+// Creates, caches and releases objects in a ContentLessObjectCache, each thread using its own keys.
+// Releasing the last reference of an object uncaches it.
+void ContentLessObjectCacheInsertRelease(benchmark::State& state) {
+    static ContentLessObjectCache<CacheableObject> cache;
+
+    size_t i = 0;
+    for (auto _ : state) {
+        Ref<CacheableObject> object =
+            AcquireRef(new CacheableObject(state.thread_index() * kThreadKeyStride + i));
+        benchmark::DoNotOptimize(cache.Insert(object.Get()));
+        i = (i + 1) % kNumKeys;
+    }
+}
+BENCHMARK(ContentLessObjectCacheInsertRelease)->Threads(1)->Threads(4)->Threads(16)->Threads(32);
+
+}  // anonymous namespace
+}  // namespace dawn
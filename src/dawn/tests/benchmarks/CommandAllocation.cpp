@@ -0,0 +1,119 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/CommandAllocator.h"
+
+namespace dawn::native {
+namespace {
+
+// Benchmarks the recording and destruction of the commands of a frame made of several command
+// buffers, with the command blocks allocated with malloc or from a CommandBlockPool
+// (state.range(0)), and state.range(1) draws per command buffer.
+
+constexpr uint32_t kCommandBuffersPerFrame = 8;
+
+// Commands with the same layout as the SetBindGroupCmd and DrawCmd of dawn::native.
+enum class Command {
+    SetBindGroup,
+    Draw,
+};
+
+struct SetBindGroupCmd {
+    uint32_t index;
+    void* group;
+    uint32_t dynamicOffsetCount;
+};
+
+struct DrawCmd {
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+void RecordDraws(CommandAllocator* allocator, uint32_t drawCount) {
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        SetBindGroupCmd* setBindGroup =
+            allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+        setBindGroup->index = 0;
+        setBindGroup->group = nullptr;
+        setBindGroup->dynamicOffsetCount = 1;
+        *allocator->AllocateData<uint32_t>(1) = i * 256;
+
+        DrawCmd* draw = allocator->Allocate<DrawCmd>(Command::Draw);
+        draw->vertexCount = 36;
+        draw->instanceCount = 1;
+        draw->firstVertex = 0;
+        draw->firstInstance = i;
+    }
+}
+
+// Iterates over the commands like the backends do when submitting them, and frees them.
+void ConsumeCommands(CommandIterator* commands) {
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        switch (type) {
+            case Command::SetBindGroup: {
+                SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                benchmark::DoNotOptimize(commands->NextData<uint32_t>(cmd->dynamicOffsetCount));
+                break;
+            }
+            case Command::Draw:
+                benchmark::DoNotOptimize(commands->NextCommand<DrawCmd>());
+                break;
+        }
+    }
+    commands->MakeEmptyAsDataWasDestroyed();
+}
+
+void RecordAndFreeFrames(benchmark::State& state) {
+    std::unique_ptr<CommandBlockPool> pool;
+    if (state.range(0) != 0) {
+        pool = std::make_unique<CommandBlockPool>();
+    }
+    uint32_t drawCount = static_cast<uint32_t>(state.range(1));
+
+    std::vector<CommandIterator> frame(kCommandBuffersPerFrame);
+    for (auto _ : state) {
+        for (CommandIterator& commands : frame) {
+            CommandAllocator allocator(pool.get());
+            RecordDraws(&allocator, drawCount);
+            commands = CommandIterator(std::move(allocator));
+        }
+        for (CommandIterator& commands : frame) {
+            ConsumeCommands(&commands);
+        }
+        if (pool != nullptr) {
+            pool->Tick();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kCommandBuffersPerFrame * drawCount);
+    if (pool != nullptr) {
+        state.counters["block_reuse_rate"] =
+            static_cast<double>(pool->GetReusedAllocationCount()) / pool->GetAllocationCount();
+    }
+}
+BENCHMARK(RecordAndFreeFrames)
+    ->ArgNames({"pooled", "draws"})
+    ->ArgsProduct({{0, 1}, {10, 100, 1000}});
+
+}  // anonymous namespace
+}  // namespace dawn::native
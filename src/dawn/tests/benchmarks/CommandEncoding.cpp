@@ -0,0 +1,267 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <vector>
+
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr uint32_t kBindGroupCount = 16;
+constexpr uint32_t kUniformSize = 256;
+constexpr uint64_t kUniformBufferSize = 64 * 1024;
+constexpr uint32_t kDynamicOffsetCount = kUniformBufferSize / kUniformSize;
+
+// Benchmarks for the CPU cost of encoding and submitting commands in Dawn. They run on the Null
+// backend so that they measure the frontend (validation, command recording and resource tracking)
+// and can track regressions of the per-draw CPU cost without a GPU.
+class CommandEncoding : public NullDeviceBenchmarkFixture {
+  public:
+    void SetUp(const benchmark::State& state) override {
+        NullDeviceBenchmarkFixture::SetUp(state);
+
+        mRenderPass = utils::CreateBasicRenderPass(device, 16, 16);
+
+        mUniformBuffer = CreateBuffer(kUniformBufferSize,
+                                      wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst);
+        mVertexBuffer = CreateBuffer(1024, wgpu::BufferUsage::Vertex);
+
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform, true}});
+        for (uint32_t i = 0; i < kBindGroupCount; ++i) {
+            mBindGroups.push_back(
+                utils::MakeBindGroup(device, bgl, {{0, mUniformBuffer, 0, kUniformSize}}));
+        }
+
+        utils::ComboRenderPipelineDescriptor pipelineDesc;
+        pipelineDesc.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+        pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+            @group(0) @binding(0) var<uniform> offset: vec4f;
+            @vertex fn main(@location(0) position: vec4f) -> @builtin(position) vec4f {
+                return position + offset;
+            })");
+        pipelineDesc.vertex.bufferCount = 1;
+        pipelineDesc.cBuffers[0].arrayStride = 4 * sizeof(float);
+        pipelineDesc.cBuffers[0].attributeCount = 1;
+        pipelineDesc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+        pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+            @fragment fn main() -> @location(0) vec4f {
+                return vec4f(0.0, 1.0, 0.0, 1.0);
+            })");
+        pipelineDesc.cTargets[0].format = mRenderPass.colorFormat;
+        mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        mPipeline = nullptr;
+        mBindGroups.clear();
+        mVertexBuffer = nullptr;
+        mUniformBuffer = nullptr;
+        mRenderPass = {};
+        NullDeviceBenchmarkFixture::TearDown(state);
+    }
+
+  protected:
+    // Encodes |drawCount| draws. With |churnBindGroups|, each draw uses a different bind group
+    // and dynamic offset, otherwise the bind group is only set once.
+    template <typename Encoder>
+    void EncodeDraws(const Encoder& encoder, uint32_t drawCount, bool churnBindGroups) {
+        encoder.SetPipeline(mPipeline);
+        encoder.SetVertexBuffer(0, mVertexBuffer);
+        uint32_t offset = 0;
+        encoder.SetBindGroup(0, mBindGroups[0], 1, &offset);
+        for (uint32_t i = 0; i < drawCount; ++i) {
+            if (churnBindGroups) {
+                offset = (i % kDynamicOffsetCount) * kUniformSize;
+                encoder.SetBindGroup(0, mBindGroups[i % kBindGroupCount], 1, &offset);
+            }
+            encoder.Draw(3, 1, 0, i);
+        }
+    }
+
+    wgpu::CommandBuffer EncodeRenderPass(uint32_t drawCount, bool churnBindGroups) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        EncodeDraws(pass, drawCount, churnBindGroups);
+        pass.End();
+        return encoder.Finish();
+    }
+
+    wgpu::Buffer CreateBuffer(uint64_t size, wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor desc = {};
+        desc.size = size;
+        desc.usage = usage;
+        return device.CreateBuffer(&desc);
+    }
+
+    utils::BasicRenderPass mRenderPass;
+    wgpu::Buffer mUniformBuffer;
+    wgpu::Buffer mVertexBuffer;
+    std::vector<wgpu::BindGroup> mBindGroups;
+    wgpu::RenderPipeline mPipeline;
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override { return {}; }
+};
+
+// Encodes render passes with state.range(0) draws using the same bind group.
+BENCHMARK_DEFINE_F(CommandEncoding, RenderPassDraws)
+(benchmark::State& state) {
+    uint32_t drawCount = state.range(0);
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(drawCount, false);
+        benchmark::DoNotOptimize(commands.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, RenderPassDraws)->Arg(10)->Arg(100)->Arg(1000);
+
+// Encodes render passes with state.range(0) draws, each with a new bind group and dynamic offset.
+BENCHMARK_DEFINE_F(CommandEncoding, BindGroupChurn)
+(benchmark::State& state) {
+    uint32_t drawCount = state.range(0);
+    for (auto _ : state) {
+        wgpu::CommandBuffer commands = EncodeRenderPass(drawCount, true);
+        benchmark::DoNotOptimize(commands.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, BindGroupChurn)->Arg(10)->Arg(100)->Arg(1000);
+
+// Encodes render passes with state.range(0) draws that each use a distinct bind group with its own
+// buffer, like a scene with many objects. Each bind group is set state.range(1) times, so that the
+// tracking of the resources used by the pass sees both new and repeated bind groups.
+BENCHMARK_DEFINE_F(CommandEncoding, DistinctBindGroups)
+(benchmark::State& state) {
+    uint32_t bindGroupCount = state.range(0);
+    uint32_t setsPerBindGroup = state.range(1);
+
+    wgpu::BindGroupLayout bgl = mPipeline.GetBindGroupLayout(0);
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < bindGroupCount; ++i) {
+        buffers.push_back(CreateBuffer(kUniformSize, wgpu::BufferUsage::Uniform));
+        bindGroups.push_back(
+            utils::MakeBindGroup(device, bgl, {{0, buffers.back(), 0, kUniformSize}}));
+    }
+
+    uint32_t offset = 0;
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        pass.SetPipeline(mPipeline);
+        pass.SetVertexBuffer(0, mVertexBuffer);
+        for (uint32_t i = 0; i < setsPerBindGroup; ++i) {
+            for (const wgpu::BindGroup& bindGroup : bindGroups) {
+                pass.SetBindGroup(0, bindGroup, 1, &offset);
+                pass.Draw(3);
+            }
+        }
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        benchmark::DoNotOptimize(commands.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * bindGroupCount * setsPerBindGroup);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, DistinctBindGroups)
+    ->ArgNames({"bind_groups", "sets"})
+    ->Args({16, 1})
+    ->Args({1000, 1})
+    ->Args({5000, 1})
+    ->Args({1000, 4});
+
+// Measures only CommandEncoder::Finish, which validates the resource usages of the passes, for
+// render passes with state.range(0) draws.
+BENCHMARK_DEFINE_F(CommandEncoding, Finish)
+(benchmark::State& state) {
+    uint32_t drawCount = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        EncodeDraws(pass, drawCount, true);
+        pass.End();
+        state.ResumeTiming();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        benchmark::DoNotOptimize(commands.Get());
+    }
+}
+BENCHMARK_REGISTER_F(CommandEncoding, Finish)->Arg(100)->Arg(1000);
+
+// Measures only Queue::Submit of command buffers with a render pass of state.range(0) draws.
+BENCHMARK_DEFINE_F(CommandEncoding, Submit)
+(benchmark::State& state) {
+    uint32_t drawCount = state.range(0);
+    wgpu::Queue queue = device.GetQueue();
+    for (auto _ : state) {
+        state.PauseTiming();
+        wgpu::CommandBuffer commands = EncodeRenderPass(drawCount, true);
+        state.ResumeTiming();
+
+        queue.Submit(1, &commands);
+    }
+}
+BENCHMARK_REGISTER_F(CommandEncoding, Submit)->Arg(100)->Arg(1000);
+
+// Writes state.range(0) bytes to a buffer with Queue::WriteBuffer.
+BENCHMARK_DEFINE_F(CommandEncoding, WriteBuffer)
+(benchmark::State& state) {
+    // Tick regularly so that the staging memory of the completed writes is reclaimed.
+    constexpr uint32_t kWritesPerTick = 64;
+
+    std::vector<uint8_t> data(state.range(0), 0x42);
+    wgpu::Queue queue = device.GetQueue();
+    uint32_t writeCount = 0;
+    for (auto _ : state) {
+        queue.WriteBuffer(mUniformBuffer, 0, data.data(), data.size());
+        if (++writeCount % kWritesPerTick == 0) {
+            device.Tick();
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK_REGISTER_F(CommandEncoding, WriteBuffer)->Arg(256)->Arg(4096)->Arg(kUniformBufferSize);
+
+// Encodes render passes that execute a render bundle of state.range(0) draws.
+BENCHMARK_DEFINE_F(CommandEncoding, RenderBundleReplay)
+(benchmark::State& state) {
+    uint32_t drawCount = state.range(0);
+
+    wgpu::RenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.colorFormats = &mRenderPass.colorFormat;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    EncodeDraws(bundleEncoder, drawCount, true);
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+    for (auto _ : state) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &bundle);
+        pass.End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        benchmark::DoNotOptimize(commands.Get());
+    }
+    state.SetItemsProcessed(state.iterations() * drawCount);
+}
+BENCHMARK_REGISTER_F(CommandEncoding, RenderBundleReplay)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,97 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <dawn/webgpu_cpp.h>
+#include <vector>
+
+#include "dawn/tests/benchmarks/NullDeviceSetup.h"
+
+namespace dawn {
+namespace {
+
+// Benchmarks Queue::Submit of many command buffers that each use their own set of buffers, which
+// is dominated by the validation of their resource usages on the Null backend. With enough
+// resources used, the command buffers are validated in parallel.
+class QueueSubmit : public NullDeviceBenchmarkFixture {
+  public:
+    void TearDown(const benchmark::State& state) override {
+        mBuffers.clear();
+        NullDeviceBenchmarkFixture::TearDown(state);
+    }
+
+  protected:
+    // Creates the buffers used by commandBufferCount command buffers that each copy between
+    // buffersPerCommandBuffer buffers.
+    void CreateBuffers(uint32_t commandBufferCount, uint32_t buffersPerCommandBuffer) {
+        wgpu::BufferDescriptor desc = {};
+        desc.size = 4;
+        desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+        mBuffers.resize(commandBufferCount);
+        for (std::vector<wgpu::Buffer>& buffers : mBuffers) {
+            for (uint32_t i = 0; i < buffersPerCommandBuffer; ++i) {
+                buffers.push_back(device.CreateBuffer(&desc));
+            }
+        }
+    }
+
+    std::vector<wgpu::CommandBuffer> EncodeCommandBuffers() {
+        std::vector<wgpu::CommandBuffer> commands;
+        for (const std::vector<wgpu::Buffer>& buffers : mBuffers) {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            for (size_t i = 0; i + 1 < buffers.size(); i += 2) {
+                encoder.CopyBufferToBuffer(buffers[i], 0, buffers[i + 1], 0, 4);
+            }
+            commands.push_back(encoder.Finish());
+        }
+        return commands;
+    }
+
+  private:
+    wgpu::DeviceDescriptor GetDeviceDescriptor() const override { return {}; }
+
+    std::vector<std::vector<wgpu::Buffer>> mBuffers;
+};
+
+// Submits state.range(0) command buffers that each use state.range(1) buffers.
+BENCHMARK_DEFINE_F(QueueSubmit, ManyCommandBuffers)
+(benchmark::State& state) {
+    uint32_t commandBufferCount = state.range(0);
+    uint32_t buffersPerCommandBuffer = state.range(1);
+    CreateBuffers(commandBufferCount, buffersPerCommandBuffer);
+
+    wgpu::Queue queue = device.GetQueue();
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<wgpu::CommandBuffer> commands = EncodeCommandBuffers();
+        state.ResumeTiming();
+
+        queue.Submit(commands.size(), commands.data());
+    }
+    state.SetItemsProcessed(state.iterations() * commandBufferCount * buffersPerCommandBuffer);
+}
+// A single command buffer is always validated on the submitting thread, which is the baseline
+// for the same number of buffers split across command buffers.
+BENCHMARK_REGISTER_F(QueueSubmit, ManyCommandBuffers)
+    ->ArgNames({"command_buffers", "buffers"})
+    ->Args({1, 1024})
+    ->Args({32, 32})
+    ->Args({1, 32768})
+    ->Args({32, 1024})
+    ->Args({64, 1024})
+    ->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn
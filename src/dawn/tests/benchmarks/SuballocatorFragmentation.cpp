@@ -0,0 +1,110 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "dawn/common/Math.h"
+#include "dawn/native/BuddyAllocator.h"
+#include "dawn/native/TlsfAllocator.h"
+
+namespace dawn::native {
+namespace {
+
+// Benchmarks the buddy and TLSF sub-allocators on a memory block of the size used by the Vulkan
+// backend, with a random sequence of allocations and deallocations of buffer-like sizes. Besides
+// the time taken, it reports how much of the memory block was used by live allocations when
+// allocations started failing, which is what matters to limit the number of memory blocks.
+
+constexpr uint64_t kMemoryBlockSize = 8 * 1024 * 1024;
+constexpr uint64_t kAlignment = 256;
+constexpr uint32_t kOperationCount = 10000;
+
+// The buddy allocator only handles power of two sizes, like in BuddyMemoryAllocator.
+uint64_t AllocateInBlock(BuddyAllocator* allocator, uint64_t size) {
+    return allocator->Allocate(NextPowerOfTwo(size), kAlignment);
+}
+
+uint64_t AllocateInBlock(TlsfAllocator* allocator, uint64_t size) {
+    return allocator->Allocate(size, kAlignment);
+}
+
+template <typename Allocator>
+void RandomAllocations(benchmark::State& state) {
+    uint64_t maxAllocationSize = static_cast<uint64_t>(state.range(0));
+
+    struct Allocation {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    uint64_t failureCount = 0;
+    uint64_t sizeAtFailureSum = 0;
+    for (auto _ : state) {
+        Allocator allocator(kMemoryBlockSize);
+        std::vector<Allocation> allocations;
+        uint64_t liveSize = 0;
+
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<uint64_t> sizeDistribution(1, maxAllocationSize);
+        for (uint32_t i = 0; i < kOperationCount; ++i) {
+            // Free allocations less often than making them so that the memory block fills up.
+            if (!allocations.empty() && generator() % 3 == 0) {
+                size_t index = generator() % allocations.size();
+                allocator.Deallocate(allocations[index].offset);
+                liveSize -= allocations[index].size;
+                allocations[index] = allocations.back();
+                allocations.pop_back();
+                continue;
+            }
+
+            uint64_t size = Align(sizeDistribution(generator), kAlignment);
+            uint64_t offset = AllocateInBlock(&allocator, size);
+            if (offset == Allocator::kInvalidOffset) {
+                failureCount++;
+                sizeAtFailureSum += liveSize;
+                continue;
+            }
+            allocations.push_back({offset, size});
+            liveSize += size;
+        }
+
+        for (const Allocation& allocation : allocations) {
+            allocator.Deallocate(allocation.offset);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kOperationCount);
+    state.counters["failure_rate"] =
+        static_cast<double>(failureCount) / (state.iterations() * kOperationCount);
+    if (failureCount != 0) {
+        state.counters["utilization_at_failure"] =
+            static_cast<double>(sizeAtFailureSum) / (failureCount * kMemoryBlockSize);
+    }
+}
+BENCHMARK_TEMPLATE(RandomAllocations, BuddyAllocator)
+    ->ArgName("max_size")
+    ->Arg(64 * 1024)
+    ->Arg(1024 * 1024)
+    ->Arg(4 * 1024 * 1024);
+BENCHMARK_TEMPLATE(RandomAllocations, TlsfAllocator)
+    ->ArgName("max_size")
+    ->Arg(64 * 1024)
+    ->Arg(1024 * 1024)
+    ->Arg(4 * 1024 * 1024);
+
+}  // anonymous namespace
+}  // namespace dawn::native
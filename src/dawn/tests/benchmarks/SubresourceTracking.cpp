@@ -0,0 +1,109 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "dawn/native/SubresourceStorage.h"
+#include "dawn/webgpu_cpp.h"
+
+namespace dawn::native {
+namespace {
+
+// Benchmarks the subresource tracking done for a large 2D array texture that has its layers
+// uploaded and their mipmaps generated one after the other, like SubresourceTrackingPerf but
+// without a GPU, so that the texture can have thousands of layers. Each pass creates its own usage
+// storage that is then merged into the state of the whole texture.
+void GenerateMipmapsPerLayer(benchmark::State& state) {
+    const uint32_t layerCount = static_cast<uint32_t>(state.range(0));
+    const uint32_t levelCount = static_cast<uint32_t>(state.range(1));
+
+    SubresourceStorage<wgpu::TextureUsage> textureUsages(Aspect::Color, layerCount, levelCount);
+    auto mergeUsages = [](const SubresourceRange&, wgpu::TextureUsage* usage,
+                          const wgpu::TextureUsage& passUsage) {
+        if (passUsage != wgpu::TextureUsage::None) {
+            *usage = passUsage;
+        }
+    };
+
+    uint32_t layer = 0;
+    for (auto _ : state) {
+        // Copy into the layer.
+        {
+            SubresourceStorage<wgpu::TextureUsage> passUsages(Aspect::Color, layerCount,
+                                                              levelCount);
+            passUsages.Update({Aspect::Color, {layer, 1}, {0, 1}},
+                              [](const SubresourceRange&, wgpu::TextureUsage* usage) {
+                                  *usage |= wgpu::TextureUsage::CopyDst;
+                              });
+            textureUsages.Merge(passUsages, mergeUsages);
+        }
+
+        // Render each mip level of the layer from the previous one.
+        for (uint32_t level = 1; level < levelCount; level++) {
+            SubresourceStorage<wgpu::TextureUsage> passUsages(Aspect::Color, layerCount,
+                                                              levelCount);
+            passUsages.Update(SubresourceRange::MakeSingle(Aspect::Color, layer, level - 1),
+                              [](const SubresourceRange&, wgpu::TextureUsage* usage) {
+                                  *usage |= wgpu::TextureUsage::TextureBinding;
+                              });
+            passUsages.Update(SubresourceRange::MakeSingle(Aspect::Color, layer, level),
+                              [](const SubresourceRange&, wgpu::TextureUsage* usage) {
+                                  *usage |= wgpu::TextureUsage::RenderAttachment;
+                              });
+            textureUsages.Merge(passUsages, mergeUsages);
+        }
+
+        layer = (layer + 1) % layerCount;
+    }
+
+    state.SetItemsProcessed(state.iterations() * levelCount);
+}
+BENCHMARK(GenerateMipmapsPerLayer)
+    ->ArgNames({"layers", "mips"})
+    ->Args({16, 8})
+    ->Args({256, 8})
+    ->Args({256, 14})
+    ->Args({2048, 8})
+    ->Args({2048, 14});
+
+// Benchmarks updating the subresource state for a sampled view of all the layers of the texture
+// after some of its layers were rendered to, which is where runs of layers get recompressed.
+void SampleAfterRenderingToLayers(benchmark::State& state) {
+    const uint32_t layerCount = static_cast<uint32_t>(state.range(0));
+    const uint32_t levelCount = static_cast<uint32_t>(state.range(1));
+
+    SubresourceStorage<wgpu::TextureUsage> textureUsages(Aspect::Color, layerCount, levelCount);
+    uint32_t layer = 0;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < 8; i++) {
+            textureUsages.Update(SubresourceRange::MakeSingle(Aspect::Color, layer, 0),
+                                 [](const SubresourceRange&, wgpu::TextureUsage* usage) {
+                                     *usage = wgpu::TextureUsage::RenderAttachment;
+                                 });
+            layer = (layer + 7) % layerCount;
+        }
+        textureUsages.Update(SubresourceRange::MakeFull(Aspect::Color, layerCount, levelCount),
+                             [](const SubresourceRange&, wgpu::TextureUsage* usage) {
+                                 *usage = wgpu::TextureUsage::TextureBinding;
+                             });
+    }
+}
+BENCHMARK(SampleAfterRenderingToLayers)
+    ->ArgNames({"layers", "mips"})
+    ->Args({16, 8})
+    ->Args({256, 14})
+    ->Args({2048, 14});
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -0,0 +1,216 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "dawn/dawn_proc_table.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCompression.h"
+
+namespace dawn {
+namespace {
+
+// Benchmarks for the compression of wire commands, on the render passes with many
+// SetBindGroup/Draw commands that dominate the wire traffic of typical applications. The commands
+// are serialized by a real wire client, without a server.
+
+constexpr uint32_t kDrawsPerPass = 1000;
+constexpr uint32_t kBindGroupCount = 16;
+
+// Stores the flushed commands so that their size can be measured and they can be replayed.
+class CaptureSerializer : public wire::CommandSerializer {
+  public:
+    size_t GetMaximumAllocationSize() const override { return 1 << 20; }
+
+    void* GetCmdSpace(size_t size) override {
+        size_t offset = mBuffer.size();
+        mBuffer.resize(offset + size);
+        return mBuffer.data() + offset;
+    }
+
+    bool Flush() override {
+        mFlushed.insert(mFlushed.end(), mBuffer.begin(), mBuffer.end());
+        mBuffer.clear();
+        return true;
+    }
+
+    const std::vector<char>& GetFlushed() const { return mFlushed; }
+    void ClearFlushed() { mFlushed.clear(); }
+
+  private:
+    std::vector<char> mBuffer;
+    std::vector<char> mFlushed;
+};
+
+class NullCommandHandler : public wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        return commands + size;
+    }
+};
+
+// A wire client and the objects used to record the render passes.
+class RenderPassRecorder {
+  public:
+    explicit RenderPassRecorder(wire::CommandSerializer* serializer)
+        : mProcs(wire::client::GetProcs()) {
+        wire::WireClientDescriptor desc = {};
+        desc.serializer = serializer;
+        mClient = std::make_unique<wire::WireClient>(desc);
+        mDevice = mClient->ReserveDevice().device;
+
+        WGPUTextureDescriptor textureDesc = {};
+        textureDesc.usage = WGPUTextureUsage_RenderAttachment;
+        textureDesc.dimension = WGPUTextureDimension_2D;
+        textureDesc.size = {256, 256, 1};
+        textureDesc.format = WGPUTextureFormat_RGBA8Unorm;
+        textureDesc.mipLevelCount = 1;
+        textureDesc.sampleCount = 1;
+        mTexture = mProcs.deviceCreateTexture(mDevice, &textureDesc);
+        mView = mProcs.textureCreateView(mTexture, nullptr);
+
+        WGPUBufferDescriptor bufferDesc = {};
+        bufferDesc.usage = WGPUBufferUsage_Uniform;
+        bufferDesc.size = 64 * 1024;
+        mBuffer = mProcs.deviceCreateBuffer(mDevice, &bufferDesc);
+
+        WGPUBindGroupLayoutEntry layoutEntry = {};
+        layoutEntry.binding = 0;
+        layoutEntry.visibility = WGPUShaderStage_Vertex;
+        layoutEntry.buffer.type = WGPUBufferBindingType_Uniform;
+        layoutEntry.buffer.hasDynamicOffset = true;
+        WGPUBindGroupLayoutDescriptor layoutDesc = {};
+        layoutDesc.entryCount = 1;
+        layoutDesc.entries = &layoutEntry;
+        mLayout = mProcs.deviceCreateBindGroupLayout(mDevice, &layoutDesc);
+
+        for (uint32_t i = 0; i < kBindGroupCount; ++i) {
+            WGPUBindGroupEntry entry = {};
+            entry.binding = 0;
+            entry.buffer = mBuffer;
+            entry.size = 256;
+            WGPUBindGroupDescriptor bindGroupDesc = {};
+            bindGroupDesc.layout = mLayout;
+            bindGroupDesc.entryCount = 1;
+            bindGroupDesc.entries = &entry;
+            mBindGroups.push_back(mProcs.deviceCreateBindGroup(mDevice, &bindGroupDesc));
+        }
+    }
+
+    ~RenderPassRecorder() {
+        for (WGPUBindGroup bindGroup : mBindGroups) {
+            mProcs.bindGroupRelease(bindGroup);
+        }
+        mProcs.bindGroupLayoutRelease(mLayout);
+        mProcs.bufferRelease(mBuffer);
+        mProcs.textureViewRelease(mView);
+        mProcs.textureRelease(mTexture);
+    }
+
+    // Records a render pass drawing many objects, each with its own bind group and uniform offset.
+    void RecordPass() {
+        WGPURenderPassColorAttachment attachment = {};
+        attachment.view = mView;
+        attachment.loadOp = WGPULoadOp_Clear;
+        attachment.storeOp = WGPUStoreOp_Store;
+        WGPURenderPassDescriptor passDesc = {};
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &attachment;
+
+        WGPUCommandEncoder encoder = mProcs.deviceCreateCommandEncoder(mDevice, nullptr);
+        WGPURenderPassEncoder pass = mProcs.commandEncoderBeginRenderPass(encoder, &passDesc);
+        for (uint32_t i = 0; i < kDrawsPerPass; ++i) {
+            uint32_t offset = (i % 256) * 256;
+            mProcs.renderPassEncoderSetBindGroup(pass, 0, mBindGroups[i % kBindGroupCount], 1,
+                                                 &offset);
+            mProcs.renderPassEncoderDraw(pass, 36, 1, 0, i);
+        }
+        mProcs.renderPassEncoderEnd(pass);
+        WGPUCommandBuffer commands = mProcs.commandEncoderFinish(encoder, nullptr);
+        mProcs.commandBufferRelease(commands);
+        mProcs.renderPassEncoderRelease(pass);
+        mProcs.commandEncoderRelease(encoder);
+    }
+
+  private:
+    const DawnProcTable& mProcs;
+    std::unique_ptr<wire::WireClient> mClient;
+    WGPUDevice mDevice;
+    WGPUTexture mTexture;
+    WGPUTextureView mView;
+    WGPUBuffer mBuffer;
+    WGPUBindGroupLayout mLayout;
+    std::vector<WGPUBindGroup> mBindGroups;
+};
+
+// Serializes render passes with and without compression (state.range(0)), and reports the number
+// of bytes sent per draw.
+void SerializeRenderPass(benchmark::State& state) {
+    CaptureSerializer capture;
+    std::unique_ptr<wire::CompressingCommandSerializer> compressor;
+    wire::CommandSerializer* serializer = &capture;
+    if (state.range(0) != 0) {
+        compressor = std::make_unique<wire::CompressingCommandSerializer>(&capture);
+        serializer = compressor.get();
+    }
+    RenderPassRecorder recorder(serializer);
+    serializer->Flush();
+    capture.ClearFlushed();
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        recorder.RecordPass();
+        serializer->Flush();
+        bytes += capture.GetFlushed().size();
+        capture.ClearFlushed();
+    }
+    state.SetItemsProcessed(state.iterations() * kDrawsPerPass);
+    state.counters["bytes_per_draw"] =
+        static_cast<double>(bytes) / (state.iterations() * kDrawsPerPass);
+}
+BENCHMARK(SerializeRenderPass)->ArgName("compressed")->Arg(0)->Arg(1);
+
+// Decompresses a stream of render passes.
+void DecompressRenderPass(benchmark::State& state) {
+    constexpr uint32_t kPassCount = 4;
+    CaptureSerializer capture;
+    {
+        wire::CompressingCommandSerializer compressor(&capture);
+        RenderPassRecorder recorder(&compressor);
+        for (uint32_t i = 0; i < kPassCount; ++i) {
+            recorder.RecordPass();
+        }
+        compressor.Flush();
+    }
+    const std::vector<char>& stream = capture.GetFlushed();
+
+    NullCommandHandler handler;
+    for (auto _ : state) {
+        // The decompressor needs to see the whole stream, starting with its header.
+        wire::DecompressingCommandHandler decompressor(&handler);
+        if (decompressor.HandleCommands(stream.data(), stream.size()) == nullptr) {
+            state.SkipWithError("Failed to decompress the commands");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kPassCount * kDrawsPerPass);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(DecompressRenderPass);
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,131 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "dawn/utils/SharedMemoryCommandBuffer.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+
+namespace dawn {
+namespace {
+
+// Benchmarks for the throughput of the transports that carry wire commands from the client to the
+// server. Each benchmark serializes commands of state.range(0) bytes and flushes every
+// kCommandsPerFlush commands, like a client flushing once per frame.
+
+constexpr size_t kCommandsPerFlush = 64;
+constexpr size_t kRingCapacity = 4 * 1024 * 1024;
+
+// Walks the commands like the wire server does, without doing anything for them. Commands start
+// with their size, like the wire's CmdHeader.
+class CommandCounter : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        const volatile char* end = commands + size;
+        while (commands < end) {
+            uint64_t commandSize = *reinterpret_cast<const volatile uint64_t*>(commands);
+            if (commandSize == 0 || commandSize > size_t(end - commands)) {
+                return nullptr;
+            }
+            commands += commandSize;
+            ++mCommandCount;
+        }
+        return commands;
+    }
+
+    size_t GetCommandCount() const { return mCommandCount; }
+
+  private:
+    size_t mCommandCount = 0;
+};
+
+bool SerializeCommand(dawn::wire::CommandSerializer* serializer, uint64_t size) {
+    char* space = static_cast<char*>(serializer->GetCmdSpace(size));
+    if (space == nullptr) {
+        return false;
+    }
+    std::memcpy(space, &size, sizeof(size));
+    std::memset(space + sizeof(size), 0xAB, size - sizeof(size));
+    return true;
+}
+
+void SetCounters(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * kCommandsPerFlush);
+    state.SetBytesProcessed(state.iterations() * kCommandsPerFlush * state.range(0));
+}
+
+// The in-process transport used by the tests, where the server handles the commands synchronously
+// during the flush.
+void TerribleCommandBufferThroughput(benchmark::State& state) {
+    CommandCounter counter;
+    auto buffer = std::make_unique<utils::TerribleCommandBuffer>(&counter);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kCommandsPerFlush; ++i) {
+            if (!SerializeCommand(buffer.get(), state.range(0))) {
+                state.SkipWithError("GetCmdSpace failed");
+                return;
+            }
+        }
+        if (!buffer->Flush()) {
+            state.SkipWithError("Flush failed");
+            return;
+        }
+    }
+    SetCounters(state);
+}
+BENCHMARK(TerribleCommandBufferThroughput)->Arg(64)->Arg(1024)->Arg(16 * 1024)->UseRealTime();
+
+// The shared memory transport, with the server handling the commands on another thread like it
+// would in another process.
+void SharedMemoryCommandBufferThroughput(benchmark::State& state) {
+    auto ring = utils::SharedMemoryCommandRing::Create(kRingCapacity);
+    if (ring == nullptr) {
+        state.SkipWithError("Failed to create the shared memory");
+        return;
+    }
+
+    CommandCounter counter;
+    std::thread server([&] {
+        utils::SharedMemoryCommandReceiver receiver(ring.get(), &counter);
+        while (receiver.WaitAndHandleCommands()) {
+        }
+    });
+
+    utils::SharedMemoryCommandSerializer serializer(ring.get());
+    for (auto _ : state) {
+        for (size_t i = 0; i < kCommandsPerFlush; ++i) {
+            if (!SerializeCommand(&serializer, state.range(0))) {
+                state.SkipWithError("GetCmdSpace failed");
+                break;
+            }
+        }
+        serializer.Flush();
+    }
+    // Wait for the server to handle the last commands so that they can be checked.
+    ring->Close();
+    server.join();
+    if (counter.GetCommandCount() != state.iterations() * kCommandsPerFlush) {
+        state.SkipWithError("The server didn't handle all the commands");
+    }
+    SetCounters(state);
+}
+BENCHMARK(SharedMemoryCommandBufferThroughput)->Arg(64)->Arg(1024)->Arg(16 * 1024)->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn
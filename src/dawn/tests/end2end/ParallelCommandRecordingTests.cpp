@@ -0,0 +1,255 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/DawnTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+// More command buffers than the number of threads of most machines, so that some of the threads
+// record several command buffers.
+constexpr uint32_t kCommandBufferCount = 24;
+
+// Tests for the submission of many command buffers at once. When they don't use any resource in
+// common, the Vulkan backend can record them in parallel with the
+// vulkan_record_command_buffers_in_parallel toggle and the results must be the same as when they
+// are recorded serially.
+class ParallelCommandRecordingTests : public DawnTest {
+  protected:
+    wgpu::Buffer CreateBuffer(uint64_t size, wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    void Submit(const std::vector<wgpu::CommandBuffer>& commands) {
+        queue.Submit(commands.size(), commands.data());
+    }
+};
+
+// Test copies between different buffers in each command buffer.
+TEST_P(ParallelCommandRecordingTests, IndependentBufferCopies) {
+    std::vector<wgpu::Buffer> destinations;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::Buffer source = utils::CreateBufferFromData(device, wgpu::BufferUsage::CopySrc,
+                                                          {i, i + 1, i + 2, i + 3});
+        wgpu::Buffer destination = CreateBuffer(
+            4 * sizeof(uint32_t), wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 0, 4 * sizeof(uint32_t));
+        commands.push_back(encoder.Finish());
+        destinations.push_back(destination);
+    }
+    Submit(commands);
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        uint32_t expected[] = {i, i + 1, i + 2, i + 3};
+        EXPECT_BUFFER_U32_RANGE_EQ(expected, destinations[i], 0, 4);
+    }
+}
+
+// Test that the lazy clears of the buffers are recorded in the command buffer that uses them.
+TEST_P(ParallelCommandRecordingTests, IndependentBufferLazyClears) {
+    std::vector<wgpu::Buffer> destinations;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::Buffer source = CreateBuffer(4 * sizeof(uint32_t), wgpu::BufferUsage::CopySrc);
+        wgpu::Buffer destination = CreateBuffer(
+            4 * sizeof(uint32_t), wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+        // Copy the uninitialized source buffer to half of the destination buffer.
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 2 * sizeof(uint32_t),
+                                   2 * sizeof(uint32_t));
+        commands.push_back(encoder.Finish());
+        destinations.push_back(destination);
+    }
+    Submit(commands);
+
+    constexpr uint32_t kExpected[] = {0, 0, 0, 0};
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        EXPECT_BUFFER_U32_RANGE_EQ(kExpected, destinations[i], 0, 4);
+    }
+}
+
+// Test copies to a part of different textures in each command buffer, with the rest of the
+// textures lazily cleared.
+TEST_P(ParallelCommandRecordingTests, IndependentTextureCopies) {
+    constexpr uint32_t kSize = 4;
+
+    std::vector<wgpu::Texture> textures;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        utils::RGBA8 color(i, 0, 0, 255);
+        wgpu::Buffer source =
+            utils::CreateBufferFromData(device, &color, sizeof(color), wgpu::BufferUsage::CopySrc);
+
+        wgpu::TextureDescriptor descriptor;
+        descriptor.size = {kSize, kSize};
+        descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        descriptor.usage = wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst;
+        wgpu::Texture texture = device.CreateTexture(&descriptor);
+
+        wgpu::ImageCopyBuffer imageCopyBuffer = utils::CreateImageCopyBuffer(source, 0);
+        wgpu::ImageCopyTexture imageCopyTexture = utils::CreateImageCopyTexture(texture, 0, {1, 1});
+        wgpu::Extent3D copySize = {1, 1};
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToTexture(&imageCopyBuffer, &imageCopyTexture, &copySize);
+        commands.push_back(encoder.Finish());
+        textures.push_back(texture);
+    }
+    Submit(commands);
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        std::vector<utils::RGBA8> expected(kSize * kSize, utils::RGBA8(0, 0, 0, 0));
+        expected[1 * kSize + 1] = utils::RGBA8(i, 0, 0, 255);
+        EXPECT_TEXTURE_EQ(expected.data(), textures[i], {0, 0}, {kSize, kSize});
+    }
+}
+
+// Test render passes to different attachments in each command buffer.
+TEST_P(ParallelCommandRecordingTests, IndependentRenderPasses) {
+    std::vector<utils::BasicRenderPass> renderPasses;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, 1, 1);
+        renderPass.renderPassInfo.cColorAttachments[0].clearValue = {i / 255.0, 0.0, 0.0, 1.0};
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.End();
+        commands.push_back(encoder.Finish());
+        renderPasses.push_back(renderPass);
+    }
+    Submit(commands);
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8(i, 0, 0, 255), renderPasses[i].color, 0, 0);
+    }
+}
+
+// Test compute passes that share the same pipeline but write different storage buffers in each
+// command buffer.
+TEST_P(ParallelCommandRecordingTests, IndependentComputePasses) {
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.compute.module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<uniform> input : u32;
+        @group(0) @binding(1) var<storage, read_write> output : u32;
+
+        @compute @workgroup_size(1) fn main() {
+            output = input * 2u;
+        })");
+    pipelineDescriptor.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    std::vector<wgpu::Buffer> outputs;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::Buffer input = utils::CreateBufferFromData(device, wgpu::BufferUsage::Uniform, {i});
+        wgpu::Buffer output =
+            CreateBuffer(sizeof(uint32_t), wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc);
+        wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                                         {{0, input}, {1, output}});
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.DispatchWorkgroups(1);
+        pass.End();
+        commands.push_back(encoder.Finish());
+        outputs.push_back(output);
+    }
+    Submit(commands);
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        EXPECT_BUFFER_U32_EQ(i * 2, outputs[i], 0);
+    }
+}
+
+// Test command buffers that depend on each other: each one copies the buffer written by the
+// previous one. They must be executed in order.
+TEST_P(ParallelCommandRecordingTests, DependentCommandBuffers) {
+    constexpr uint32_t kData[] = {1, 2, 3, 4};
+
+    std::vector<wgpu::Buffer> buffers;
+    buffers.push_back(
+        utils::CreateBufferFromData(device, kData, sizeof(kData), wgpu::BufferUsage::CopySrc));
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        buffers.push_back(
+            CreateBuffer(sizeof(kData), wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst));
+    }
+
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(buffers[i], 0, buffers[i + 1], 0, sizeof(kData));
+        commands.push_back(encoder.Finish());
+    }
+    Submit(commands);
+
+    EXPECT_BUFFER_U32_RANGE_EQ(kData, buffers.back(), 0, 4);
+}
+
+// Test that commands recorded on the queue before the submit are executed before the command
+// buffers, and that the command buffers are executed before the commands recorded after it.
+TEST_P(ParallelCommandRecordingTests, OrderWithQueueWrites) {
+    std::vector<wgpu::Buffer> sources;
+    std::vector<wgpu::Buffer> destinations;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::Buffer source =
+            CreateBuffer(sizeof(uint32_t), wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+        wgpu::Buffer destination =
+            CreateBuffer(sizeof(uint32_t), wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+        queue.WriteBuffer(source, 0, &i, sizeof(i));
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 0, sizeof(uint32_t));
+        commands.push_back(encoder.Finish());
+        sources.push_back(source);
+        destinations.push_back(destination);
+    }
+    Submit(commands);
+
+    // Overwrite the sources after the copies.
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        uint32_t data = i + 100;
+        queue.WriteBuffer(sources[i], 0, &data, sizeof(data));
+    }
+
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        EXPECT_BUFFER_U32_EQ(i, destinations[i], 0);
+        EXPECT_BUFFER_U32_EQ(i + 100, sources[i], 0);
+    }
+}
+
+DAWN_INSTANTIATE_TEST(ParallelCommandRecordingTests,
+                      D3D11Backend(),
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_record_command_buffers_in_parallel"}));
+
+}  // anonymous namespace
+}  // namespace dawn
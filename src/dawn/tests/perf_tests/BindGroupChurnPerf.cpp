@@ -0,0 +1,134 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sstream>
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 50;
+constexpr uint32_t kBindGroupsPerIteration = 1000;
+// Each binding uses its own part of the buffer, at an offset aligned to
+// minUniformBufferOffsetAlignment.
+constexpr uint64_t kUniformSize = 256;
+
+struct BindGroupChurnParams : AdapterTestParam {
+    BindGroupChurnParams(const AdapterTestParam& param, uint32_t bindingCount)
+        : AdapterTestParam(param), bindingCount(bindingCount) {}
+
+    uint32_t bindingCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupChurnParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.bindingCount << "_bindings";
+    return ostream;
+}
+
+// Test the performance of creating a lot of short-lived bind groups, each used by a single
+// dispatch and then released. This stresses the allocation and recycling of the bind groups in
+// the backends, like the descriptor sets in Vulkan. The bind groups have bindingCount uniform
+// buffer bindings.
+class BindGroupChurnPerf : public DawnPerfTestWithParams<BindGroupChurnParams> {
+  public:
+    BindGroupChurnPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~BindGroupChurnPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mUniformBuffer;
+    wgpu::BindGroupLayout mBindGroupLayout;
+    std::vector<wgpu::BindGroupEntry> mBindGroupEntries;
+    wgpu::ComputePipeline mPipeline;
+};
+
+void BindGroupChurnPerf::SetUp() {
+    DawnPerfTestWithParams<BindGroupChurnParams>::SetUp();
+    const BindGroupChurnParams& params = GetParam();
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = kUniformSize * params.bindingCount;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    std::vector<wgpu::BindGroupLayoutEntry> layoutEntries(params.bindingCount);
+    std::ostringstream shader;
+    shader << "struct Data { value : vec4u }\n";
+    for (uint32_t i = 0; i < params.bindingCount; ++i) {
+        layoutEntries[i].binding = i;
+        layoutEntries[i].visibility = wgpu::ShaderStage::Compute;
+        layoutEntries[i].buffer.type = wgpu::BufferBindingType::Uniform;
+
+        mBindGroupEntries.push_back({});
+        mBindGroupEntries[i].binding = i;
+        mBindGroupEntries[i].buffer = mUniformBuffer;
+        mBindGroupEntries[i].offset = i * kUniformSize;
+        mBindGroupEntries[i].size = kUniformSize;
+
+        shader << "@group(0) @binding(" << i << ") var<uniform> data" << i << " : Data;\n";
+    }
+    shader << "@compute @workgroup_size(1) fn main() {\n";
+    for (uint32_t i = 0; i < params.bindingCount; ++i) {
+        shader << "    _ = data" << i << ";\n";
+    }
+    shader << "}\n";
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc;
+    layoutDesc.entryCount = layoutEntries.size();
+    layoutDesc.entries = layoutEntries.data();
+    mBindGroupLayout = device.CreateBindGroupLayout(&layoutDesc);
+
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.layout = utils::MakeBasicPipelineLayout(device, &mBindGroupLayout);
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, shader.str().c_str());
+    pipelineDesc.compute.entryPoint = "main";
+    mPipeline = device.CreateComputePipeline(&pipelineDesc);
+}
+
+void BindGroupChurnPerf::Step() {
+    wgpu::BindGroupDescriptor bindGroupDesc;
+    bindGroupDesc.layout = mBindGroupLayout;
+    bindGroupDesc.entryCount = mBindGroupEntries.size();
+    bindGroupDesc.entries = mBindGroupEntries.data();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(mPipeline);
+    for (uint32_t i = 0; i < kBindGroupsPerIteration; ++i) {
+        wgpu::BindGroup bindGroup = device.CreateBindGroup(&bindGroupDesc);
+        pass.SetBindGroup(0, bindGroup);
+        pass.DispatchWorkgroups(1);
+    }
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+TEST_P(BindGroupChurnPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupChurnPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1u, 4u, 12u});
+
+}  // anonymous namespace
+}  // namespace dawn
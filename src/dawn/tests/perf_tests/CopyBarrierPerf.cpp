@@ -0,0 +1,195 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/common/Constants.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+#include "dawn/native/VulkanBackend.h"
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumSubmits = 10;
+
+// Each copy uploads either 256 bytes to a buffer, or a 16x16 RGBA8 tile to a texture.
+constexpr uint64_t kBufferChunkSize = 256;
+constexpr uint32_t kTextureTileSize = 16;
+constexpr uint32_t kTextureTileBytesPerRow = kTextureBytesPerRowAlignment;
+constexpr uint64_t kTextureTileChunkSize = kTextureTileBytesPerRow * kTextureTileSize;
+
+enum class CopyType {
+    BufferToBuffer,
+    BufferToTexture,
+};
+
+struct CopyBarrierParams : AdapterTestParam {
+    CopyBarrierParams(const AdapterTestParam& param, CopyType copyType, uint32_t copiesPerSubmit)
+        : AdapterTestParam(param), copyType(copyType), copiesPerSubmit(copiesPerSubmit) {}
+
+    CopyType copyType;
+    uint32_t copiesPerSubmit;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const CopyBarrierParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+
+    switch (param.copyType) {
+        case CopyType::BufferToBuffer:
+            ostream << "_BufferToBuffer";
+            break;
+        case CopyType::BufferToTexture:
+            ostream << "_BufferToTexture";
+            break;
+    }
+
+    ostream << "_" << param.copiesPerSubmit << "_copies";
+    return ostream;
+}
+
+// Test a streaming workload that uploads many small chunks of data per submit, each with its own
+// copy from a staging buffer to a different region of the same destination. The copies don't
+// depend on each other so they should be recorded with a single pipeline barrier per submit, the
+// number of barriers is reported as barriers_per_submit.
+class CopyBarrierPerf : public DawnPerfTestWithParams<CopyBarrierParams> {
+  public:
+    CopyBarrierPerf() : DawnPerfTestWithParams(kNumSubmits, 1) {}
+    ~CopyBarrierPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    size_t GetPipelineBarrierCount() const;
+
+    size_t mBarrierCountBefore = 0;
+    size_t mSubmitCount = 0;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mStaging;
+    wgpu::Buffer mDstBuffer;
+    wgpu::Texture mDstTexture;
+    uint64_t mChunkSize = 0;
+    uint32_t mTilesPerRow = 0;
+};
+
+void CopyBarrierPerf::SetUp() {
+    // Unlike other perf tests, CPU adapters like SwiftShader are supported because the number of
+    // barriers doesn't depend on the adapter.
+    DawnTestWithParams<CopyBarrierParams>::SetUp();
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    const CopyBarrierParams& params = GetParam();
+
+    switch (params.copyType) {
+        case CopyType::BufferToBuffer: {
+            mChunkSize = kBufferChunkSize;
+
+            wgpu::BufferDescriptor desc = {};
+            desc.size = params.copiesPerSubmit * mChunkSize;
+            desc.usage = wgpu::BufferUsage::CopyDst;
+            mDstBuffer = device.CreateBuffer(&desc);
+            break;
+        }
+
+        case CopyType::BufferToTexture: {
+            mChunkSize = kTextureTileChunkSize;
+
+            // The tiles are laid out in a square grid.
+            mTilesPerRow = 1;
+            while (mTilesPerRow * mTilesPerRow < params.copiesPerSubmit) {
+                mTilesPerRow *= 2;
+            }
+
+            wgpu::TextureDescriptor desc = {};
+            desc.size = {mTilesPerRow * kTextureTileSize, mTilesPerRow * kTextureTileSize};
+            desc.format = wgpu::TextureFormat::RGBA8Unorm;
+            desc.usage = wgpu::TextureUsage::CopyDst;
+            mDstTexture = device.CreateTexture(&desc);
+            break;
+        }
+    }
+
+    std::vector<uint8_t> data(params.copiesPerSubmit * mChunkSize, 0x42);
+    mStaging = utils::CreateBufferFromData(device, data.data(), data.size(),
+                                           wgpu::BufferUsage::CopySrc);
+
+    // Make sure the initialization of the resources isn't counted.
+    queue.Submit(0, nullptr);
+    mBarrierCountBefore = GetPipelineBarrierCount();
+}
+
+size_t CopyBarrierPerf::GetPipelineBarrierCount() const {
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+    if (IsVulkan()) {
+        return native::vulkan::GetPipelineBarrierCountForTesting(device.Get());
+    }
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+    return 0;
+}
+
+void CopyBarrierPerf::Step() {
+    const CopyBarrierParams& params = GetParam();
+
+    for (unsigned int i = 0; i < kNumSubmits; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t copy = 0; copy < params.copiesPerSubmit; ++copy) {
+            uint64_t offset = copy * mChunkSize;
+            switch (params.copyType) {
+                case CopyType::BufferToBuffer:
+                    encoder.CopyBufferToBuffer(mStaging, offset, mDstBuffer, offset,
+                                               kBufferChunkSize);
+                    break;
+
+                case CopyType::BufferToTexture: {
+                    wgpu::ImageCopyBuffer src = utils::CreateImageCopyBuffer(
+                        mStaging, offset, kTextureTileBytesPerRow, kTextureTileSize);
+                    wgpu::ImageCopyTexture dst = utils::CreateImageCopyTexture(
+                        mDstTexture, 0,
+                        {(copy % mTilesPerRow) * kTextureTileSize,
+                         (copy / mTilesPerRow) * kTextureTileSize, 0});
+                    wgpu::Extent3D size = {kTextureTileSize, kTextureTileSize, 1};
+                    encoder.CopyBufferToTexture(&src, &dst, &size);
+                    break;
+                }
+            }
+        }
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+    mSubmitCount += kNumSubmits;
+}
+
+TEST_P(CopyBarrierPerf, Run) {
+    RunTest();
+
+    if (mSubmitCount != 0) {
+        size_t barrierCount = GetPipelineBarrierCount() - mBarrierCountBefore;
+        PrintResult("barriers_per_submit", static_cast<double>(barrierCount) / mSubmitCount,
+                    "count", true);
+    }
+}
+
+DAWN_INSTANTIATE_TEST_P(CopyBarrierPerf,
+                        {VulkanBackend()},
+                        {CopyType::BufferToBuffer, CopyType::BufferToTexture},
+                        {16u, 256u});
+
+}  // anonymous namespace
+}  // namespace dawn
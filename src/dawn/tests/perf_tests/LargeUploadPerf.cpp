@@ -0,0 +1,162 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/native/DawnNative.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumIterations = 4;
+
+// Textures are uploaded with rows of this many RGBA8 texels.
+constexpr uint32_t kTextureWidth = 8192;
+constexpr uint32_t kBytesPerTexel = 4;
+
+enum class UploadMethod {
+    WriteBuffer,
+    WriteTexture,
+};
+
+struct LargeUploadParams : AdapterTestParam {
+    LargeUploadParams(const AdapterTestParam& param,
+                      UploadMethod uploadMethod,
+                      uint32_t uploadSizeInMiB)
+        : AdapterTestParam(param), uploadMethod(uploadMethod), uploadSizeInMiB(uploadSizeInMiB) {}
+
+    UploadMethod uploadMethod;
+    uint32_t uploadSizeInMiB;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const LargeUploadParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+
+    switch (param.uploadMethod) {
+        case UploadMethod::WriteBuffer:
+            ostream << "_WriteBuffer";
+            break;
+        case UploadMethod::WriteTexture:
+            ostream << "_WriteTexture";
+            break;
+    }
+
+    ostream << "_" << param.uploadSizeInMiB << "MiB";
+    return ostream;
+}
+
+// Test uploading assets larger than the ring buffers of the DynamicUploader, which use dedicated
+// staging buffers. Besides the time taken, it reports how often these staging buffers are created
+// rather than reused from the pool of the DynamicUploader.
+class LargeUploadPerf : public DawnPerfTestWithParams<LargeUploadParams> {
+  public:
+    LargeUploadPerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mData(static_cast<size_t>(GetParam().uploadSizeInMiB) * 1024 * 1024) {}
+    ~LargeUploadPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    uint64_t mUploadCount = 0;
+    native::UploadStagingStatistics mStatisticsBefore;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mBuffer;
+    wgpu::Texture mTexture;
+    std::vector<uint8_t> mData;
+};
+
+void LargeUploadPerf::SetUp() {
+    DawnPerfTestWithParams<LargeUploadParams>::SetUp();
+
+    // The statistics of the staging buffers are only available with dawn_native.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    switch (GetParam().uploadMethod) {
+        case UploadMethod::WriteBuffer: {
+            wgpu::BufferDescriptor desc = {};
+            desc.size = mData.size();
+            desc.usage = wgpu::BufferUsage::CopyDst;
+            mBuffer = device.CreateBuffer(&desc);
+            break;
+        }
+
+        case UploadMethod::WriteTexture: {
+            wgpu::TextureDescriptor desc = {};
+            desc.size = {kTextureWidth,
+                         static_cast<uint32_t>(mData.size() / (kTextureWidth * kBytesPerTexel))};
+            desc.format = wgpu::TextureFormat::RGBA8Unorm;
+            desc.usage = wgpu::TextureUsage::CopyDst;
+            mTexture = device.CreateTexture(&desc);
+            break;
+        }
+    }
+
+    mStatisticsBefore = native::GetUploadStagingStatistics(device.Get());
+}
+
+void LargeUploadPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        switch (GetParam().uploadMethod) {
+            case UploadMethod::WriteBuffer:
+                queue.WriteBuffer(mBuffer, 0, mData.data(), mData.size());
+                break;
+
+            case UploadMethod::WriteTexture: {
+                wgpu::ImageCopyTexture imageCopyTexture = utils::CreateImageCopyTexture(mTexture);
+                wgpu::TextureDataLayout textureDataLayout =
+                    utils::CreateTextureDataLayout(0, kTextureWidth * kBytesPerTexel);
+                wgpu::Extent3D copySize = {kTextureWidth, mTexture.GetHeight()};
+                queue.WriteTexture(&imageCopyTexture, mData.data(), mData.size(),
+                                   &textureDataLayout, &copySize);
+                break;
+            }
+        }
+        // Submit each upload like an application streaming assets would.
+        queue.Submit(0, nullptr);
+    }
+    mUploadCount += kNumIterations;
+}
+
+TEST_P(LargeUploadPerf, Run) {
+    RunTest();
+
+    if (mUploadCount != 0) {
+        native::UploadStagingStatistics statistics =
+            native::GetUploadStagingStatistics(device.Get());
+        uint64_t createdCount =
+            statistics.stagingBufferCreationCount - mStatisticsBefore.stagingBufferCreationCount;
+        uint64_t reusedCount =
+            statistics.stagingBufferReuseCount - mStatisticsBefore.stagingBufferReuseCount;
+        PrintResult("staging_buffers_created_per_upload",
+                    static_cast<double>(createdCount) / mUploadCount, "count", true);
+        PrintResult("staging_buffers_reused_per_upload",
+                    static_cast<double>(reusedCount) / mUploadCount, "count", true);
+        PrintResult("staging_pool_size",
+                    static_cast<double>(statistics.pooledSize) / (1024 * 1024), "MiB", false);
+    }
+}
+
+DAWN_INSTANTIATE_TEST_P(LargeUploadPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {UploadMethod::WriteBuffer, UploadMethod::WriteTexture},
+                        {32u, 64u, 128u, 256u});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,117 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/ComboRenderBundleEncoderDescriptor.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+constexpr unsigned int kNumSubmits = 10;
+constexpr uint32_t kDrawsPerCommandBuffer = 1000;
+constexpr uint32_t kRenderTargetSize = 16;
+
+struct ParallelRecordingParams : AdapterTestParam {
+    ParallelRecordingParams(const AdapterTestParam& param, uint32_t commandBufferCount)
+        : AdapterTestParam(param), commandBufferCount(commandBufferCount) {}
+
+    uint32_t commandBufferCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const ParallelRecordingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_" << param.commandBufferCount << "_command_buffers";
+    return ostream;
+}
+
+// Test the scaling of Queue::Submit with the number of command buffers submitted at once. Each
+// command buffer renders to its own render target so they are independent and can be recorded in
+// parallel with the vulkan_record_command_buffers_in_parallel toggle. The draws are in render
+// bundles so that most of the CPU time is spent recording the commands in the backend, not
+// encoding them.
+class ParallelRecordingPerf : public DawnPerfTestWithParams<ParallelRecordingParams> {
+  public:
+    ParallelRecordingPerf() : DawnPerfTestWithParams(kNumSubmits, 1) {}
+    ~ParallelRecordingPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    std::vector<utils::BasicRenderPass> mRenderPasses;
+    wgpu::RenderBundle mRenderBundle;
+};
+
+void ParallelRecordingPerf::SetUp() {
+    DawnPerfTestWithParams<ParallelRecordingParams>::SetUp();
+
+    for (uint32_t i = 0; i < GetParam().commandBufferCount; ++i) {
+        mRenderPasses.push_back(
+            utils::CreateBasicRenderPass(device, kRenderTargetSize, kRenderTargetSize));
+    }
+
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        @vertex fn main(@builtin(vertex_index) index : u32) -> @builtin(position) vec4f {
+            var pos = array(vec2f(-1.0, -1.0), vec2f(3.0, -1.0), vec2f(-1.0, 3.0));
+            return vec4f(pos[index], 0.0, 1.0);
+        })");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        @fragment fn main() -> @location(0) vec4f {
+            return vec4f(0.0, 1.0, 0.0, 1.0);
+        })");
+    pipelineDesc.cTargets[0].format = utils::BasicRenderPass::kDefaultColorFormat;
+    wgpu::RenderPipeline pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc;
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.cColorFormats[0] = utils::BasicRenderPass::kDefaultColorFormat;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    bundleEncoder.SetPipeline(pipeline);
+    for (uint32_t i = 0; i < kDrawsPerCommandBuffer; ++i) {
+        bundleEncoder.Draw(3);
+    }
+    mRenderBundle = bundleEncoder.Finish();
+}
+
+void ParallelRecordingPerf::Step() {
+    for (unsigned int i = 0; i < kNumSubmits; ++i) {
+        std::vector<wgpu::CommandBuffer> commands;
+        for (utils::BasicRenderPass& renderPass : mRenderPasses) {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+            pass.ExecuteBundles(1, &mRenderBundle);
+            pass.End();
+            commands.push_back(encoder.Finish());
+        }
+        queue.Submit(commands.size(), commands.data());
+    }
+}
+
+TEST_P(ParallelRecordingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ParallelRecordingPerf,
+                        {VulkanBackend(),
+                         VulkanBackend({"vulkan_record_command_buffers_in_parallel"})},
+                        {1u, 4u, 16u, 32u});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -500,4 +500,123 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Records |count| draws with the allocator, checks them when iterating and frees them.
+void RecordAndCheckDraws(CommandAllocator allocator, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = i;
+        draw->count = i * 3;
+    }
+
+    CommandIterator iterator(std::move(allocator));
+    CommandType type;
+    uint32_t numCommands = 0;
+    while (iterator.NextCommandId(&type)) {
+        ASSERT_EQ(type, CommandType::Draw);
+        CommandDraw* draw = iterator.NextCommand<CommandDraw>();
+        ASSERT_EQ(draw->first, numCommands);
+        ASSERT_EQ(draw->count, numCommands * 3);
+        numCommands++;
+    }
+    ASSERT_EQ(numCommands, count);
+    iterator.MakeEmptyAsDataWasDestroyed();
+}
+
+// Test that the blocks freed by a CommandIterator are reused by the next CommandAllocators.
+TEST(CommandBlockPool, BlocksAreReused) {
+    CommandBlockPool pool;
+
+    RecordAndCheckDraws(CommandAllocator(&pool), 10000);
+    uint64_t allocationCount = pool.GetAllocationCount();
+    EXPECT_GT(allocationCount, 1u);
+    EXPECT_EQ(pool.GetReusedAllocationCount(), 0u);
+    EXPECT_GT(pool.GetCachedSize(), 0u);
+
+    RecordAndCheckDraws(CommandAllocator(&pool), 10000);
+    EXPECT_EQ(pool.GetAllocationCount(), 2 * allocationCount);
+    EXPECT_EQ(pool.GetReusedAllocationCount(), allocationCount);
+}
+
+// Test that the blocks of several allocators acquired by one iterator are returned to the pool.
+TEST(CommandBlockPool, AcquireCommandBlocks) {
+    CommandBlockPool pool;
+
+    std::vector<CommandAllocator> allocators;
+    for (uint32_t i = 0; i < 3; ++i) {
+        allocators.emplace_back(&pool);
+        allocators.back().Allocate<CommandDraw>(CommandType::Draw);
+    }
+    CommandIterator iterator;
+    iterator.AcquireCommandBlocks(std::move(allocators));
+    EXPECT_EQ(pool.GetCachedSize(), 0u);
+    iterator.MakeEmptyAsDataWasDestroyed();
+
+    RecordAndCheckDraws(CommandAllocator(&pool), 1);
+    RecordAndCheckDraws(CommandAllocator(&pool), 1);
+    EXPECT_EQ(pool.GetReusedAllocationCount(), 2u);
+}
+
+// Test that the blocks of a reset allocator are returned to the pool.
+TEST(CommandBlockPool, AllocatorReset) {
+    CommandBlockPool pool;
+
+    CommandAllocator allocator(&pool);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    EXPECT_EQ(pool.GetCachedSize(), 0u);
+    allocator.Reset();
+    EXPECT_GT(pool.GetCachedSize(), 0u);
+
+    // The moved-to allocator keeps using the pool.
+    CommandAllocator movedTo = std::move(allocator);
+    movedTo.Allocate<CommandDraw>(CommandType::Draw);
+    movedTo.Reset();
+    EXPECT_EQ(pool.GetReusedAllocationCount(), 1u);
+}
+
+// Test that the blocks of large commands aren't pooled.
+TEST(CommandBlockPool, LargeCommandsAreNotPooled) {
+    CommandBlockPool pool;
+
+    CommandAllocator allocator(&pool);
+    allocator.Allocate<CommandBig>(CommandType::Big);
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+
+    EXPECT_EQ(pool.GetAllocationCount(), 1u);
+    EXPECT_EQ(pool.GetCachedSize(), 0u);
+}
+
+// Test that trimming keeps the blocks needed to reach the high-water mark since the last trim.
+TEST(CommandBlockPool, Trim) {
+    CommandBlockPool pool;
+
+    // Use two allocators at the same time, then only one of them.
+    {
+        CommandAllocator allocatorA(&pool);
+        CommandAllocator allocatorB(&pool);
+        allocatorA.Allocate<CommandDraw>(CommandType::Draw);
+        allocatorB.Allocate<CommandDraw>(CommandType::Draw);
+    }
+    size_t twoAllocatorsSize = pool.GetCachedSize();
+    RecordAndCheckDraws(CommandAllocator(&pool), 1);
+
+    // The high-water mark since the last trim is two blocks.
+    pool.Trim();
+    EXPECT_EQ(pool.GetCachedSize(), twoAllocatorsSize);
+
+    // Only one block is used before the next trim.
+    RecordAndCheckDraws(CommandAllocator(&pool), 1);
+    pool.Trim();
+    EXPECT_EQ(pool.GetCachedSize(), twoAllocatorsSize / 2);
+
+    // Blocks still in use are kept, and no block is used before the next trim.
+    CommandAllocator allocator(&pool);
+    allocator.Allocate<CommandDraw>(CommandType::Draw);
+    pool.Trim();
+    pool.Trim();
+    EXPECT_EQ(pool.GetCachedSize(), 0u);
+    allocator.Reset();
+    EXPECT_EQ(pool.GetCachedSize(), twoAllocatorsSize / 2);
+}
+
 }  // namespace dawn::native
@@ -209,5 +209,52 @@ TEST(ContentLessObjectCacheTest, InsertDeleting) {
     EXPECT_TRUE(object2.Get() == cached.Get());
 }
 
+// Many threads inserting and finding objects with keys spread across the whole cache agree on a
+// single cached object per key.
+TEST(ContentLessObjectCacheTest, ConcurrentInsertAndFindManyKeys) {
+    constexpr size_t kNumThreads = 8;
+    constexpr size_t kNumKeys = 256;
+
+    ContentLessObjectCache<CacheableT> cache;
+    std::vector<std::vector<Ref<CacheableT>>> results(kNumThreads);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kNumKeys; ++i) {
+                // Visit the keys in a different order on each thread.
+                size_t key = (i * (2 * t + 1)) % kNumKeys;
+                CacheableT blueprint(key);
+                Ref<CacheableT> cached = cache.Find(&blueprint);
+                if (cached == nullptr) {
+                    Ref<CacheableT> object =
+                        AcquireRef(new CacheableT(key, [&](CacheableT* x) { cache.Erase(x); }));
+                    cached = cache.Insert(object.Get()).first;
+                }
+                results[t].push_back(cached);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < kNumKeys; ++i) {
+        CacheableT blueprint(i);
+        Ref<CacheableT> cached = cache.Find(&blueprint);
+        ASSERT_TRUE(cached != nullptr);
+        for (size_t t = 0; t < kNumThreads; ++t) {
+            size_t index = 0;
+            while ((index * (2 * t + 1)) % kNumKeys != i) {
+                index++;
+            }
+            EXPECT_TRUE(results[t][index].Get() == cached.Get());
+        }
+    }
+
+    results.clear();
+    EXPECT_TRUE(cache.Empty());
+}
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -0,0 +1,291 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dawn/common/Platform.h"
+#include "dawn/platform/caching/FileCachingInterface.h"
+#include "gtest/gtest.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+namespace dawn::platform {
+namespace {
+
+#if DAWN_PLATFORM_IS(POSIX)
+
+class FileCachingInterfaceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        std::string pattern = testing::TempDir() + "dawn_file_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern.data()), nullptr);
+        mDirectory = pattern;
+    }
+
+    void TearDown() override {
+        for (const char* name : {"cache.pack", "cache.index", "cache.lock"}) {
+            unlink((mDirectory + "/" + name).c_str());
+        }
+        rmdir(mDirectory.c_str());
+    }
+
+    std::unique_ptr<FileCachingInterface> Open(uint64_t maxSize = 1 << 20) {
+        return FileCachingInterface::Create(mDirectory, maxSize);
+    }
+
+    static void Store(FileCachingInterface* cache,
+                      const std::string& key,
+                      const std::string& value) {
+        cache->StoreData(key.data(), key.size(), value.data(), value.size());
+    }
+
+    // Returns the value stored for |key| or an empty string if it isn't in the cache.
+    static std::string Load(FileCachingInterface* cache, const std::string& key) {
+        size_t size = cache->LoadData(key.data(), key.size(), nullptr, 0);
+        std::string value(size, '\0');
+        if (size > 0) {
+            EXPECT_EQ(cache->LoadData(key.data(), key.size(), value.data(), size), size);
+        }
+        return value;
+    }
+
+    std::string mDirectory;
+};
+
+// Test that stored entries can be loaded, and that missing entries aren't found.
+TEST_F(FileCachingInterfaceTests, StoreAndLoad) {
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_TRUE(cache->IsThreadSafe());
+
+    Store(cache.get(), "key1", "value1");
+    Store(cache.get(), "key2", "value2");
+    EXPECT_EQ(Load(cache.get(), "key1"), "value1");
+    EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+    EXPECT_EQ(Load(cache.get(), "key3"), "");
+
+    // Storing an existing key replaces its value.
+    Store(cache.get(), "key1", "another value");
+    EXPECT_EQ(Load(cache.get(), "key1"), "another value");
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+}
+
+// Test that entries persist when the cache is reopened, with and without an index.
+TEST_F(FileCachingInterfaceTests, Persistence) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "key1", "value1");
+        Store(cache.get(), "key2", "value2");
+        Store(cache.get(), "key1", "value3");
+    }
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        EXPECT_EQ(cache->GetEntryCount(), 2u);
+        EXPECT_EQ(Load(cache.get(), "key1"), "value3");
+        EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+    }
+
+    // Without the index, the entries are recovered by scanning the pack file.
+    ASSERT_EQ(unlink((mDirectory + "/cache.index").c_str()), 0);
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load(cache.get(), "key1"), "value3");
+    EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+}
+
+// Test that a record torn by a crash is dropped while the records before it are recovered.
+TEST_F(FileCachingInterfaceTests, RecoverTornRecord) {
+    uint64_t packSize = 0;
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "key1", "value1");
+        Store(cache.get(), "key2", "value2");
+        Store(cache.get(), "key3", "value3");
+        packSize = cache->GetPackFileSize();
+    }
+
+    // Simulate a crash in the middle of writing the last record, before the index was written.
+    std::string packPath = mDirectory + "/cache.pack";
+    ASSERT_EQ(unlink((mDirectory + "/cache.index").c_str()), 0);
+    ASSERT_EQ(truncate(packPath.c_str(), packSize - 3), 0);
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load(cache.get(), "key1"), "value1");
+    EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+    EXPECT_EQ(Load(cache.get(), "key3"), "");
+    cache.reset();
+
+    // Garbage after the records described by the index is dropped as well.
+    int fd = open(packPath.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    const char garbage[] = "not a record, just some garbage";
+    ASSERT_EQ(write(fd, garbage, sizeof(garbage)), static_cast<ssize_t>(sizeof(garbage)));
+    close(fd);
+
+    cache = Open();
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+    Store(cache.get(), "key3", "value3");
+    EXPECT_EQ(Load(cache.get(), "key3"), "value3");
+}
+
+// Test that a record corrupted on disk is detected when it is first loaded, even though the index
+// describing it is intact.
+TEST_F(FileCachingInterfaceTests, CorruptedRecord) {
+    {
+        std::unique_ptr<FileCachingInterface> cache = Open();
+        Store(cache.get(), "key1", "value1");
+        Store(cache.get(), "key2", "value2");
+    }
+
+    // Flip a byte in the value of key1.
+    std::string packPath = mDirectory + "/cache.pack";
+    std::ifstream packFile(packPath, std::ios::binary);
+    std::string pack((std::istreambuf_iterator<char>(packFile)), std::istreambuf_iterator<char>());
+    size_t valueOffset = pack.find("value1");
+    ASSERT_NE(valueOffset, std::string::npos);
+    int fd = open(packPath.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, "V", 1, valueOffset), 1);
+    close(fd);
+
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load(cache.get(), "key1"), "");
+    EXPECT_EQ(Load(cache.get(), "key2"), "value2");
+    EXPECT_EQ(cache->GetEntryCount(), 1u);
+}
+
+// Test that a cache opened while another one holds the lock on the directory is read-only.
+TEST_F(FileCachingInterfaceTests, ReadOnlyWhenLocked) {
+    // A read-only cache can't create the pack file.
+    {
+        std::unique_ptr<FileCachingInterface> writer = Open();
+        ASSERT_NE(writer, nullptr);
+        EXPECT_FALSE(writer->IsReadOnly());
+        ASSERT_EQ(unlink((mDirectory + "/cache.pack").c_str()), 0);
+        EXPECT_EQ(Open(), nullptr);
+    }
+
+    std::unique_ptr<FileCachingInterface> writer = Open();
+    Store(writer.get(), "key1", "value1");
+    writer->Flush();
+
+    std::unique_ptr<FileCachingInterface> reader = Open();
+    ASSERT_NE(reader, nullptr);
+    EXPECT_TRUE(reader->IsReadOnly());
+    EXPECT_EQ(Load(reader.get(), "key1"), "value1");
+
+    // Stores to the read-only cache are dropped.
+    Store(reader.get(), "key2", "value2");
+    EXPECT_EQ(Load(reader.get(), "key2"), "");
+    reader.reset();
+    EXPECT_EQ(Load(writer.get(), "key2"), "");
+
+    // The lock is released when the cache is destroyed.
+    writer.reset();
+    writer = Open();
+    EXPECT_FALSE(writer->IsReadOnly());
+    EXPECT_EQ(Load(writer.get(), "key1"), "value1");
+}
+
+// Test that the least recently used entries are evicted when the cache is full.
+TEST_F(FileCachingInterfaceTests, EvictLeastRecentlyUsed) {
+    const std::string value(1000, 'x');
+    // Room for four entries. Evicting down to three quarters of the size leaves three entries.
+    std::unique_ptr<FileCachingInterface> cache = Open(4 * (value.size() + 64));
+
+    Store(cache.get(), "key1", value);
+    Store(cache.get(), "key2", value);
+    Store(cache.get(), "key3", value);
+    Store(cache.get(), "key4", value);
+    EXPECT_EQ(cache->GetEntryCount(), 4u);
+
+    // Use key1 and key2 so that key3 and key4 are the least recently used ones.
+    EXPECT_EQ(Load(cache.get(), "key2"), value);
+    EXPECT_EQ(Load(cache.get(), "key1"), value);
+    Store(cache.get(), "key5", value);
+
+    EXPECT_LE(cache->GetLiveSize(), 4 * (value.size() + 64));
+    EXPECT_EQ(Load(cache.get(), "key3"), "");
+    EXPECT_EQ(Load(cache.get(), "key4"), "");
+    EXPECT_EQ(Load(cache.get(), "key1"), value);
+    EXPECT_EQ(Load(cache.get(), "key5"), value);
+
+    // Evicted entries stay evicted when the cache is reopened.
+    cache.reset();
+    cache = Open(4 * (value.size() + 64));
+    EXPECT_EQ(Load(cache.get(), "key3"), "");
+    EXPECT_EQ(Load(cache.get(), "key1"), value);
+}
+
+// Test that the pack file is compacted once it is mostly made of dead records.
+TEST_F(FileCachingInterfaceTests, Compaction) {
+    const std::string value(64 * 1024, 'x');
+    std::unique_ptr<FileCachingInterface> cache = Open(1 << 22);
+    for (uint32_t i = 0; i < 64; ++i) {
+        Store(cache.get(), "key" + std::to_string(i % 4), value + std::to_string(i));
+    }
+
+    EXPECT_LT(cache->GetPackFileSize(), 2 * (1u << 20));
+    EXPECT_EQ(cache->GetEntryCount(), 4u);
+    EXPECT_EQ(Load(cache.get(), "key3"), value + "63");
+
+    cache.reset();
+    cache = Open(1 << 22);
+    EXPECT_EQ(cache->GetEntryCount(), 4u);
+    EXPECT_EQ(Load(cache.get(), "key0"), value + "60");
+}
+
+// Test concurrent loads and stores.
+TEST_F(FileCachingInterfaceTests, ConcurrentLoadsAndStores) {
+    constexpr uint32_t kNumThreads = 8;
+    constexpr uint32_t kNumKeys = 64;
+    std::unique_ptr<FileCachingInterface> cache = Open();
+    for (uint32_t i = 0; i < kNumKeys; ++i) {
+        Store(cache.get(), "key" + std::to_string(i), "value" + std::to_string(i));
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint32_t i = 0; i < kNumKeys; ++i) {
+                std::string key = "key" + std::to_string((i + t) % kNumKeys);
+                EXPECT_EQ(Load(cache.get(), key), "value" + std::to_string((i + t) % kNumKeys));
+                Store(cache.get(), "thread" + std::to_string(t) + key, key);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(cache->GetEntryCount(), kNumKeys * (kNumThreads + 1));
+    EXPECT_EQ(Load(cache.get(), "thread3key7"), "key7");
+}
+
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // anonymous namespace
+}  // namespace dawn::platform
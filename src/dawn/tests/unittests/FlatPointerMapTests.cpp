@@ -0,0 +1,140 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/FlatPointerMap.h"
+#include "gtest/gtest.h"
+
+namespace dawn {
+namespace {
+
+constexpr size_t kInlineCapacity = 4;
+using TestMap = FlatPointerMap<int, int, kInlineCapacity>;
+
+// Checks that the map contains exactly |keys|, in this order, with the values |values|.
+template <typename Map>
+void CheckContents(const Map& map, const std::vector<int*>& keys, const std::vector<int>& values) {
+    ASSERT_EQ(map.size(), keys.size());
+    size_t i = 0;
+    for (const auto& [key, value] : map) {
+        EXPECT_EQ(key, keys[i]);
+        EXPECT_EQ(value, values[i]);
+        EXPECT_TRUE(map.Contains(key));
+        i++;
+    }
+}
+
+// Test inserting and finding entries while the map is small enough to be stored inline.
+TEST(FlatPointerMapTests, InlineEntries) {
+    int objects[kInlineCapacity];
+    TestMap map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.Find(&objects[0]), nullptr);
+
+    for (size_t i = 0; i < kInlineCapacity; i++) {
+        auto [value, inserted] = map.TryEmplace(&objects[i], static_cast<int>(i));
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(*value, static_cast<int>(i));
+    }
+
+    // Emplacing an existing key returns its value without changing it.
+    auto [value, inserted] = map.TryEmplace(&objects[1], 42);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 1);
+
+    map[&objects[2]] += 10;
+    CheckContents(map, {&objects[0], &objects[1], &objects[2], &objects[3]}, {0, 1, 12, 3});
+}
+
+// Test that entries are kept in insertion order and can be found when the map grows past its
+// inline capacity and its hash table is resized.
+TEST(FlatPointerMapTests, GrowPastInlineCapacity) {
+    constexpr size_t kCount = 1000;
+    std::vector<std::unique_ptr<int>> objects;
+    std::vector<int*> keys;
+    std::vector<int> values;
+    for (size_t i = 0; i < kCount; i++) {
+        objects.push_back(std::make_unique<int>());
+        keys.push_back(objects.back().get());
+        values.push_back(static_cast<int>(i));
+    }
+
+    TestMap map;
+    for (size_t i = 0; i < kCount; i++) {
+        EXPECT_TRUE(map.TryEmplace(keys[i], values[i]).second);
+        EXPECT_FALSE(map.TryEmplace(keys[i / 2], -1).second);
+    }
+    CheckContents(map, keys, values);
+
+    int notInMap;
+    EXPECT_EQ(map.Find(&notInMap), nullptr);
+    for (size_t i = 0; i < kCount; i++) {
+        ASSERT_NE(map.Find(keys[i]), nullptr);
+        EXPECT_EQ(*map.Find(keys[i]), values[i]);
+    }
+}
+
+// Test that a map can be reused after being cleared, both when small and large.
+TEST(FlatPointerMapTests, Clear) {
+    int objects[64];
+    TestMap map;
+    for (size_t count : {2u, 64u, 3u, 64u}) {
+        std::vector<int*> keys;
+        std::vector<int> values;
+        for (size_t i = 0; i < count; i++) {
+            map[&objects[i]] = static_cast<int>(count + i);
+            keys.push_back(&objects[i]);
+            values.push_back(static_cast<int>(count + i));
+        }
+        CheckContents(map, keys, values);
+
+        map.clear();
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.Find(&objects[0]), nullptr);
+    }
+}
+
+// Test moving maps that store their entries inline or on the heap.
+TEST(FlatPointerMapTests, Move) {
+    int objects[16];
+    for (size_t count : {3u, 16u}) {
+        FlatPointerMap<int, std::unique_ptr<int>, kInlineCapacity> map;
+        for (size_t i = 0; i < count; i++) {
+            map.TryEmplace(&objects[i], std::make_unique<int>(static_cast<int>(i)));
+        }
+
+        FlatPointerMap<int, std::unique_ptr<int>, kInlineCapacity> moved(std::move(map));
+        EXPECT_EQ(moved.size(), count);
+        EXPECT_EQ(**moved.Find(&objects[count - 1]), static_cast<int>(count - 1));
+
+        FlatPointerMap<int, std::unique_ptr<int>, kInlineCapacity> assigned;
+        assigned.TryEmplace(&objects[0], std::make_unique<int>(42));
+        assigned = std::move(moved);
+        EXPECT_EQ(assigned.size(), count);
+        EXPECT_EQ(**assigned.Find(&objects[0]), 0);
+        EXPECT_EQ(**assigned.Find(&objects[count - 1]), static_cast<int>(count - 1));
+
+        // The moved-from map is empty and can be reused.
+        EXPECT_TRUE(moved.empty());
+        moved.TryEmplace(&objects[0], std::make_unique<int>(7));
+        EXPECT_EQ(**moved.Find(&objects[0]), 7);
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn
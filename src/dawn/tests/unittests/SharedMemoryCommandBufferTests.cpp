@@ -0,0 +1,203 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/utils/SharedMemoryCommandBuffer.h"
+
+namespace dawn::utils {
+namespace {
+
+// A handler that records each command, assuming that commands are a uint32_t size followed by
+// bytes with the value of the command index.
+class RecordingHandler : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        const volatile char* end = commands + size;
+        while (commands < end) {
+            uint32_t commandSize;
+            std::memcpy(&commandSize, const_cast<const char*>(commands), sizeof(commandSize));
+            if (commandSize < sizeof(commandSize) || commandSize > size_t(end - commands)) {
+                return nullptr;
+            }
+            std::vector<char> command(commandSize - sizeof(commandSize));
+            std::memcpy(command.data(), const_cast<const char*>(commands) + sizeof(commandSize),
+                        command.size());
+            received.push_back(std::move(command));
+            commands += commandSize;
+        }
+        return commands;
+    }
+
+    std::vector<std::vector<char>> received;
+};
+
+bool WriteCommand(SharedMemoryCommandSerializer* serializer, uint32_t index, uint32_t size) {
+    char* space = static_cast<char*>(serializer->GetCmdSpace(size));
+    if (space == nullptr) {
+        return false;
+    }
+    std::memcpy(space, &size, sizeof(size));
+    std::memset(space + sizeof(size), static_cast<char>(index), size - sizeof(size));
+    return true;
+}
+
+void ExpectCommand(const std::vector<char>& command, uint32_t index, uint32_t size) {
+    ASSERT_EQ(command.size(), size - sizeof(size));
+    for (char c : command) {
+        ASSERT_EQ(c, static_cast<char>(index));
+    }
+}
+
+// Test that commands are only received after a flush, and that multiple commands flushed together
+// are received in order.
+TEST(SharedMemoryCommandBufferTests, FlushMakesCommandsVisible) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandSerializer serializer(ring.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(ring.get(), &handler);
+
+    ASSERT_TRUE(WriteCommand(&serializer, 0, 12));
+    ASSERT_TRUE(WriteCommand(&serializer, 1, 7));
+    ASSERT_TRUE(receiver.HandleAvailableCommands());
+    EXPECT_TRUE(handler.received.empty());
+
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(receiver.HandleAvailableCommands());
+    ASSERT_EQ(handler.received.size(), 2u);
+    ExpectCommand(handler.received[0], 0, 12);
+    ExpectCommand(handler.received[1], 1, 7);
+}
+
+// Test that allocations larger than the maximum allocation size fail.
+TEST(SharedMemoryCommandBufferTests, AllocationTooLarge) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandSerializer serializer(ring.get());
+
+    size_t maxSize = serializer.GetMaximumAllocationSize();
+    EXPECT_NE(serializer.GetCmdSpace(maxSize), nullptr);
+    EXPECT_EQ(serializer.GetCmdSpace(maxSize + 1), nullptr);
+}
+
+// Test that commands wrap around the end of the ring many times while a consumer thread handles
+// them, with the producer waiting for space.
+TEST(SharedMemoryCommandBufferTests, WrapAroundWithConsumerThread) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    RecordingHandler handler;
+    std::thread consumer([&] {
+        SharedMemoryCommandReceiver receiver(ring.get(), &handler);
+        while (receiver.WaitAndHandleCommands()) {
+        }
+    });
+
+    constexpr uint32_t kCommandCount = 2000;
+    SharedMemoryCommandSerializer serializer(ring.get());
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        ASSERT_TRUE(WriteCommand(&serializer, i, 4 + (i * 37) % 500));
+        if (i % 3 == 0) {
+            ASSERT_TRUE(serializer.Flush());
+        }
+    }
+    ASSERT_TRUE(serializer.Flush());
+    ring->Close();
+    consumer.join();
+
+    ASSERT_EQ(handler.received.size(), kCommandCount);
+    for (uint32_t i = 0; i < kCommandCount; ++i) {
+        ExpectCommand(handler.received[i], i, 4 + (i * 37) % 500);
+    }
+}
+
+// Test that a ring can be imported from duplicated handles, like a ring created by another process.
+TEST(SharedMemoryCommandBufferTests, Import) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandRing::Handles handles = ring->GetHandles();
+    handles.memoryFd = dup(handles.memoryFd);
+    handles.commandsAvailableFd = dup(handles.commandsAvailableFd);
+    handles.spaceAvailableFd = dup(handles.spaceAvailableFd);
+    auto imported = SharedMemoryCommandRing::Import(handles);
+    ASSERT_NE(imported, nullptr);
+    EXPECT_EQ(imported->GetCapacity(), ring->GetCapacity());
+
+    SharedMemoryCommandSerializer serializer(ring.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(imported.get(), &handler);
+    ASSERT_TRUE(WriteCommand(&serializer, 3, 100));
+    ASSERT_TRUE(serializer.Flush());
+    ASSERT_TRUE(receiver.HandleAvailableCommands());
+    ASSERT_EQ(handler.received.size(), 1u);
+    ExpectCommand(handler.received[0], 3, 100);
+}
+
+// Test that memory that isn't sealed against resizing is rejected, since the process that created
+// it could truncate it while it is mapped.
+TEST(SharedMemoryCommandBufferTests, ImportUnsealedMemory) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandRing::Handles handles = ring->GetHandles();
+    handles.memoryFd = memfd_create("unsealed", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    ASSERT_GE(handles.memoryFd, 0);
+    ASSERT_EQ(ftruncate(handles.memoryFd, 2 * 4096), 0);
+    handles.commandsAvailableFd = dup(handles.commandsAvailableFd);
+    handles.spaceAvailableFd = dup(handles.spaceAvailableFd);
+    EXPECT_EQ(SharedMemoryCommandRing::Import(handles), nullptr);
+}
+
+// Test that a closed ring stops the consumer once the flushed commands are handled.
+TEST(SharedMemoryCommandBufferTests, Close) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandSerializer serializer(ring.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(ring.get(), &handler);
+
+    ASSERT_TRUE(WriteCommand(&serializer, 0, 8));
+    ASSERT_TRUE(serializer.Flush());
+    ring->Close();
+    EXPECT_FALSE(serializer.Flush());
+
+    EXPECT_TRUE(receiver.WaitAndHandleCommands());
+    EXPECT_EQ(handler.received.size(), 1u);
+    EXPECT_FALSE(receiver.WaitAndHandleCommands());
+}
+
+// Test that a corrupted block header is rejected instead of being read out of bounds.
+TEST(SharedMemoryCommandBufferTests, CorruptedBlockHeader) {
+    auto ring = SharedMemoryCommandRing::Create(4096);
+    ASSERT_NE(ring, nullptr);
+    SharedMemoryCommandSerializer serializer(ring.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(ring.get(), &handler);
+
+    char* space = static_cast<char*>(serializer.GetCmdSpace(8));
+    ASSERT_NE(space, nullptr);
+    ASSERT_TRUE(serializer.Flush());
+    uint64_t hugeSize = ring->GetCapacity();
+    std::memcpy(space - sizeof(hugeSize), &hugeSize, sizeof(hugeSize));
+    EXPECT_FALSE(receiver.HandleAvailableCommands());
+}
+
+}  // anonymous namespace
+}  // namespace dawn::utils
@@ -197,10 +197,13 @@ void CheckLayerCompressed(const SubresourceStorage<T>& s,
 
     uint32_t levelCount = s.GetMipLevelCountForTesting();
 
+    // The layer is compressed if it is part of a run of layers that is iterated on with all its
+    // mip levels at once.
     bool seen = false;
     s.Iterate([&](const SubresourceRange& range, const T&) {
-        if (range.aspects == aspect && range.layerCount == 1 && range.levelCount == levelCount &&
-            range.baseArrayLayer == layer && range.baseMipLevel == 0) {
+        if (range.aspects == aspect && range.baseArrayLayer <= layer &&
+            layer < range.baseArrayLayer + range.layerCount && range.levelCount == levelCount &&
+            range.baseMipLevel == 0) {
             seen = true;
         }
     });
@@ -372,6 +375,43 @@ TEST(SubresourceStorageTest, UpdateStipple) {
     CheckAspectCompressed(s, Aspect::Stencil, true);
 }
 
+// Test the same stipple pattern on an array large enough to be tracked with runs of layers.
+TEST(SubresourceStorageTest, UpdateStippleWithLayerRuns) {
+    const uint32_t kLayers = SubresourceStorage<int>::kMaxFlatArrayLayerCount + 6;
+    const uint32_t kLevels = 7;
+    SubresourceStorage<int> s(Aspect::Depth | Aspect::Stencil, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Depth | Aspect::Stencil, kLayers, kLevels);
+
+    // Update with a stipple.
+    for (uint32_t layer = 0; layer < kLayers; layer++) {
+        for (uint32_t level = 0; level < kLevels; level++) {
+            if ((layer + level) % 2 == 0) {
+                SubresourceRange range = SubresourceRange::MakeSingle(Aspect::Depth, layer, level);
+                CallUpdateOnBoth(&s, &f, range,
+                                 [](const SubresourceRange&, int* data) { *data += 17; });
+            }
+        }
+    }
+
+    // Adjacent layers have different data so each one is in its own run.
+    CheckAspectCompressed(s, Aspect::Stencil, true);
+    CheckAspectCompressed(s, Aspect::Depth, false);
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Depth), kLayers);
+    for (uint32_t layer = 0; layer < kLayers; layer++) {
+        CheckLayerCompressed(s, Aspect::Depth, layer, false);
+    }
+
+    // Update completely with a single value. Recompression should happen!
+    {
+        SubresourceRange fullRange =
+            SubresourceRange::MakeFull(Aspect::Depth | Aspect::Stencil, kLayers, kLevels);
+        CallUpdateOnBoth(&s, &f, fullRange, [](const SubresourceRange&, int* data) { *data = 31; });
+    }
+
+    CheckAspectCompressed(s, Aspect::Depth, true);
+    CheckAspectCompressed(s, Aspect::Stencil, true);
+}
+
 // Test updating as a crossing band pattern:
 //  - The first band is full layers [2, 3] on both aspects
 //  - The second band is full mips [5, 6] on one aspect.
@@ -543,6 +583,32 @@ TEST(SubresourceStorageTest, MergeFullWithFullMultiAspect) {
     CheckAspectCompressed(s, Aspect::Stencil, true);
 }
 
+// Test updating and merging from bool storages that track runs of layers with per-level data.
+TEST(SubresourceStorageTest, MergeWithBoolLayerRuns) {
+    const uint32_t kLayers = SubresourceStorage<bool>::kMaxFlatArrayLayerCount + 4;
+    const uint32_t kLevels = 5;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+
+    // Set a band of mip levels on a range of layers, which decompresses that run of layers.
+    SubresourceStorage<bool> other(Aspect::Color, kLayers, kLevels, false);
+    other.Update(SubresourceRange(Aspect::Color, {3, 10}, {1, 2}),
+                 [](const SubresourceRange&, bool* data) { *data = true; });
+    EXPECT_TRUE(other.Get(Aspect::Color, 4, 2));
+    EXPECT_FALSE(other.Get(Aspect::Color, 4, 3));
+    EXPECT_EQ(other.GetLayerRunCountForTesting(Aspect::Color), 3u);
+    CheckLayerCompressed(other, Aspect::Color, 5, false);
+
+    CallMergeOnBoth(&s, &f, other, [](const SubresourceRange&, int* data, bool other) {
+        if (other) {
+            *data = 13;
+        }
+    });
+    EXPECT_EQ(s.Get(Aspect::Color, 4, 2), 13);
+    EXPECT_EQ(s.Get(Aspect::Color, 4, 3), 0);
+    EXPECT_EQ(s.Get(Aspect::Color, 13, 1), 0);
+}
+
 // Test merging a fully compressed resource in a resource with the "cross band" pattern.
 //  - The first band is full layers [2, 3] on both aspects
 //  - The second band is full mips [5, 6] on one aspect.
@@ -697,6 +763,87 @@ TEST(SubresourceStorageTest, AspectDecompressionUpdatesLayer0) {
     EXPECT_EQ(3, s.Get(Aspect::Color, 0, 1));
 }
 
+// Test that consecutive layers with the same data are tracked as a single run, split when a
+// layer in the middle is updated, and merged back when it gets the same data again.
+TEST(SubresourceStorageTest, LayerRunsSplitAndMerge) {
+    const uint32_t kLayers = 2048;
+    const uint32_t kLevels = 14;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+
+    // Updating a single mip level of a layer splits the aspect in three runs, only the middle
+    // one being decompressed.
+    {
+        SubresourceRange range = SubresourceRange::MakeSingle(Aspect::Color, 1000, 3);
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 7; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 3u);
+    CheckLayerCompressed(s, Aspect::Color, 999, true);
+    CheckLayerCompressed(s, Aspect::Color, 1000, false);
+    CheckLayerCompressed(s, Aspect::Color, 1001, true);
+
+    // Updating the next layers the same way extends the middle run.
+    {
+        SubresourceRange range(Aspect::Color, {1001, 47}, {3, 1});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 7; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 3u);
+
+    // Updating full layers in the middle of the run splits it around them.
+    {
+        SubresourceRange range(Aspect::Color, {1010, 10}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 1; });
+    }
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 5u);
+    CheckLayerCompressed(s, Aspect::Color, 1010, true);
+    CheckLayerCompressed(s, Aspect::Color, 1020, false);
+
+    // Restoring the initial value recompresses the runs and then the aspect.
+    {
+        SubresourceRange range(Aspect::Color, {1000, 48}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 0; });
+    }
+    CheckAspectCompressed(s, Aspect::Color, true);
+}
+
+// Test merging storages whose runs of layers have different boundaries.
+TEST(SubresourceStorageTest, MergeLayerRunsWithDifferentBoundaries) {
+    const uint32_t kLayers = 2048;
+    const uint32_t kLevels = 14;
+    SubresourceStorage<int> s(Aspect::Color, kLayers, kLevels);
+    FakeStorage<int> f(Aspect::Color, kLayers, kLevels);
+    SubresourceStorage<int> other(Aspect::Color, kLayers, kLevels);
+
+    {
+        SubresourceRange range(Aspect::Color, {100, 900}, {0, kLevels});
+        CallUpdateOnBoth(&s, &f, range, [](const SubresourceRange&, int* data) { *data = 2; });
+    }
+    other.Update({Aspect::Color, {500, 1000}, {0, kLevels}},
+                 [](const SubresourceRange&, int* data) { *data = 3; });
+    other.Update({Aspect::Color, {1500, 10}, {5, 2}},
+                 [](const SubresourceRange&, int* data) { *data = 4; });
+
+    CallMergeOnBoth(&s, &f, other,
+                    [](const SubresourceRange&, int* data, int other) { *data += other; });
+
+    // The runs are [0, 100), [100, 500), [500, 1000), [1000, 1500), [1500, 1510), [1510, 2048).
+    EXPECT_EQ(s.GetLayerRunCountForTesting(Aspect::Color), 6u);
+    CheckLayerCompressed(s, Aspect::Color, 1499, true);
+    CheckLayerCompressed(s, Aspect::Color, 1500, false);
+    CheckLayerCompressed(s, Aspect::Color, 1510, true);
+
+    // Merging the opposite values makes the aspect uniform again.
+    SubresourceStorage<int> opposite(Aspect::Color, kLayers, kLevels);
+    s.Iterate([&](const SubresourceRange& range, const int& data) {
+        opposite.Update(range, [&](const SubresourceRange&, int* oppositeData) {
+            *oppositeData = -data;
+        });
+    });
+    CallMergeOnBoth(&s, &f, opposite,
+                    [](const SubresourceRange&, int* data, int other) { *data += other; });
+    CheckAspectCompressed(s, Aspect::Color, true);
+}
+
 // Bugs found while testing:
 //  - mLayersCompressed not initialized to true.
 //  - DecompressLayer setting Compressed to true instead of false.
@@ -0,0 +1,180 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <vector>
+
+#include "dawn/native/TlsfAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+
+constexpr uint64_t TlsfAllocator::kInvalidOffset;
+
+// Verify the TLSF allocator with a basic test.
+TEST(TlsfAllocatorTests, SingleBlock) {
+    constexpr uint64_t size = 32;
+    TlsfAllocator allocator(size);
+
+    // Check that we cannot allocate a oversized block.
+    ASSERT_EQ(allocator.Allocate(size * 2), TlsfAllocator::kInvalidOffset);
+
+    // Check that we cannot allocate a zero sized block.
+    ASSERT_EQ(allocator.Allocate(0u), TlsfAllocator::kInvalidOffset);
+
+    // Allocate the block.
+    uint64_t offset = allocator.Allocate(size);
+    ASSERT_EQ(offset, 0u);
+    ASSERT_EQ(allocator.GetUsedSize(), size);
+
+    // Check that we are full.
+    ASSERT_EQ(allocator.Allocate(1), TlsfAllocator::kInvalidOffset);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), 0u);
+
+    // Deallocate the block.
+    allocator.Deallocate(offset);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), size);
+    ASSERT_EQ(allocator.GetUsedSize(), 0u);
+}
+
+// Verify that allocations are split to their exact size, unlike in the buddy allocator.
+TEST(TlsfAllocatorTests, NonPowerOfTwoSizes) {
+    constexpr uint64_t size = 1000;
+    TlsfAllocator allocator(size);
+
+    // Ten allocations of 100 bytes fill the allocator exactly.
+    for (uint64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(allocator.Allocate(100), i * 100);
+    }
+    ASSERT_EQ(allocator.GetUsedSize(), size);
+    ASSERT_EQ(allocator.Allocate(1), TlsfAllocator::kInvalidOffset);
+}
+
+// Verify that free blocks are merged with both of their neighbors.
+TEST(TlsfAllocatorTests, MergeFreeBlocks) {
+    constexpr uint64_t size = 300;
+    TlsfAllocator allocator(size);
+
+    uint64_t offset1 = allocator.Allocate(100);
+    uint64_t offset2 = allocator.Allocate(100);
+    uint64_t offset3 = allocator.Allocate(100);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+
+    // Freeing the first and last allocations make two free blocks that aren't contiguous.
+    allocator.Deallocate(offset1);
+    allocator.Deallocate(offset3);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 2u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), 100u);
+    ASSERT_EQ(allocator.Allocate(200), TlsfAllocator::kInvalidOffset);
+
+    // Freeing the middle allocation merges all of them.
+    allocator.Deallocate(offset2);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), size);
+    ASSERT_EQ(allocator.Allocate(size), 0u);
+}
+
+// Verify that freed blocks are reused for allocations of the same size.
+TEST(TlsfAllocatorTests, ReuseFreedBlock) {
+    constexpr uint64_t size = 1024;
+    TlsfAllocator allocator(size);
+
+    uint64_t offset1 = allocator.Allocate(100);
+    uint64_t offset2 = allocator.Allocate(100);
+    ASSERT_NE(allocator.Allocate(100), TlsfAllocator::kInvalidOffset);
+
+    allocator.Deallocate(offset2);
+    ASSERT_EQ(allocator.Allocate(100), offset2);
+
+    allocator.Deallocate(offset1);
+    ASSERT_EQ(allocator.Allocate(100), offset1);
+}
+
+// Verify the alignment of allocations, and that the space skipped for the alignment can be used
+// by other allocations.
+TEST(TlsfAllocatorTests, Alignment) {
+    constexpr uint64_t size = 1024;
+    TlsfAllocator allocator(size);
+
+    ASSERT_EQ(allocator.Allocate(10), 0u);
+
+    // The second allocation is aligned to 256 which leaves a free block in [10, 256).
+    ASSERT_EQ(allocator.Allocate(100, 256), 256u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 2u);
+
+    // The free block before the aligned allocation is used for allocations that fit in it.
+    ASSERT_EQ(allocator.Allocate(200, 2), 10u);
+
+    // Allocations that can't be aligned in the remaining space fail.
+    ASSERT_EQ(allocator.Allocate(512, 512), 512u);
+    ASSERT_EQ(allocator.Allocate(200, 512), TlsfAllocator::kInvalidOffset);
+}
+
+// Verify that a random sequence of allocations and deallocations never produces overlapping
+// allocations, and that everything is merged back at the end.
+TEST(TlsfAllocatorTests, RandomAllocations) {
+    constexpr uint64_t size = 1 << 20;
+    TlsfAllocator allocator(size);
+
+    struct Allocation {
+        uint64_t offset;
+        uint64_t size;
+    };
+    std::vector<Allocation> allocations;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint64_t> sizeDistribution(1, 10000);
+    std::uniform_int_distribution<uint32_t> alignmentDistribution(0, 8);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        if (!allocations.empty() && generator() % 3 == 0) {
+            size_t index = generator() % allocations.size();
+            allocator.Deallocate(allocations[index].offset);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+            continue;
+        }
+
+        uint64_t allocationSize = sizeDistribution(generator);
+        uint64_t alignment = uint64_t(1) << alignmentDistribution(generator);
+        uint64_t offset = allocator.Allocate(allocationSize, alignment);
+        if (offset == TlsfAllocator::kInvalidOffset) {
+            continue;
+        }
+
+        ASSERT_EQ(offset % alignment, 0u);
+        ASSERT_LE(offset + allocationSize, size);
+        for (const Allocation& allocation : allocations) {
+            ASSERT_TRUE(offset + allocationSize <= allocation.offset ||
+                        allocation.offset + allocation.size <= offset);
+        }
+        allocations.push_back({offset, allocationSize});
+    }
+
+    uint64_t usedSize = 0;
+    for (const Allocation& allocation : allocations) {
+        usedSize += allocation.size;
+    }
+    ASSERT_EQ(allocator.GetUsedSize(), usedSize);
+
+    for (const Allocation& allocation : allocations) {
+        allocator.Deallocate(allocation.offset);
+    }
+    ASSERT_EQ(allocator.GetUsedSize(), 0u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), size);
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,160 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TlsfMemoryAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+class CountingResourceHeapAllocator : public ResourceHeapAllocator {
+  public:
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
+        mHeapCount++;
+        return std::make_unique<ResourceHeapBase>();
+    }
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+        mHeapCount--;
+    }
+
+    uint64_t GetHeapCount() const { return mHeapCount; }
+
+  private:
+    uint64_t mHeapCount = 0;
+};
+
+class TlsfMemoryAllocatorTests : public testing::Test {
+  protected:
+    static constexpr uint64_t kBlockSize = 1024;
+    static constexpr uint64_t kMaxSystemSize = 4 * kBlockSize;
+
+    ResourceMemoryAllocation Allocate(uint64_t allocationSize, uint64_t alignment = 1) {
+        ResultOrError<ResourceMemoryAllocation> result =
+            mAllocator.Allocate(allocationSize, alignment);
+        return (result.IsSuccess()) ? result.AcquireSuccess() : ResourceMemoryAllocation{};
+    }
+
+    CountingResourceHeapAllocator mHeapAllocator;
+    TlsfMemoryAllocator mAllocator{kMaxSystemSize, kBlockSize, &mHeapAllocator};
+};
+
+// Verify a single resource allocation in a single heap.
+TEST_F(TlsfMemoryAllocatorTests, SingleHeap) {
+    // Cannot allocate greater than the block size.
+    ResourceMemoryAllocation invalidAllocation = Allocate(kBlockSize * 2);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    ResourceMemoryAllocation allocation = Allocate(kBlockSize);
+    ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(allocation.GetInfo().mBlockOffset, 0u);
+    ASSERT_EQ(allocation.GetOffset(), 0u);
+    ASSERT_EQ(mAllocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    ASSERT_EQ(mAllocator.GetUsedSize(), kBlockSize);
+
+    // The single empty block is kept for the next allocations.
+    mAllocator.Deallocate(allocation);
+    ASSERT_EQ(mAllocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    ASSERT_EQ(mAllocator.GetUsedSize(), 0u);
+
+    allocation = Allocate(kBlockSize);
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 1u);
+    mAllocator.Deallocate(allocation);
+
+    mAllocator.ReleaseEmptyBlocks();
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 0u);
+    ASSERT_EQ(mAllocator.GetBlockCount(), 0u);
+}
+
+// Verify that allocations that don't fit in a heap are made in new heaps, and that at most one
+// empty heap is kept.
+TEST_F(TlsfMemoryAllocatorTests, MultipleHeaps) {
+    std::vector<ResourceMemoryAllocation> allocations;
+    for (uint64_t i = 0; i < 4; ++i) {
+        ResourceMemoryAllocation allocation = Allocate(600);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        ASSERT_EQ(allocation.GetInfo().mBlockOffset, i * kBlockSize);
+        ASSERT_EQ(mAllocator.GetBlockIndex(allocation), i);
+        allocations.push_back(allocation);
+    }
+    ASSERT_EQ(mAllocator.GetBlockCount(), 4u);
+
+    // The maximum number of heaps is reached.
+    ResourceMemoryAllocation invalidAllocation = Allocate(600);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    // But smaller allocations fit in the existing heaps.
+    ResourceMemoryAllocation smallAllocation = Allocate(400);
+    ASSERT_EQ(smallAllocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(smallAllocation.GetResourceHeap(), allocations[0].GetResourceHeap());
+    ASSERT_EQ(smallAllocation.GetOffset(), 600u);
+
+    for (uint64_t i = 1; i < 4; ++i) {
+        mAllocator.Deallocate(allocations[i]);
+    }
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 2u);
+    ASSERT_EQ(mAllocator.GetBlockCount(), 2u);
+
+    mAllocator.Deallocate(allocations[0]);
+    mAllocator.Deallocate(smallAllocation);
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 1u);
+    ASSERT_EQ(mAllocator.GetUsedSize(), 0u);
+}
+
+// Verify the choice of the heap to evacuate and the relocation of its allocations.
+TEST_F(TlsfMemoryAllocatorTests, Relocation) {
+    // Nothing to evacuate without allocations.
+    ASSERT_EQ(mAllocator.FindBlockToEvacuate(), TlsfMemoryAllocator::kInvalidBlockIndex);
+
+    ResourceMemoryAllocation allocation1 = Allocate(800);
+    ResourceMemoryAllocation allocation2 = Allocate(800);
+    ResourceMemoryAllocation allocation3 = Allocate(100);
+    ASSERT_EQ(mAllocator.GetBlockIndex(allocation1), 0u);
+    ASSERT_EQ(mAllocator.GetBlockIndex(allocation2), 1u);
+    ASSERT_EQ(mAllocator.GetBlockIndex(allocation3), 0u);
+
+    // Each heap has more used space than the free space of the other one.
+    ASSERT_EQ(mAllocator.FindBlockToEvacuate(), TlsfMemoryAllocator::kInvalidBlockIndex);
+
+    // After freeing the first allocation, the first heap can be moved to the second one.
+    mAllocator.Deallocate(allocation1);
+    ASSERT_EQ(mAllocator.FindBlockToEvacuate(), 0u);
+
+    // Relocation never uses the excluded heap nor creates new heaps.
+    ResourceMemoryAllocation invalidAllocation = mAllocator.AllocateForRelocation(300, 1, 0u);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    ResourceMemoryAllocation relocated = mAllocator.AllocateForRelocation(100, 1, 0u);
+    ASSERT_EQ(relocated.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(mAllocator.GetBlockIndex(relocated), 1u);
+
+    // Once the allocation is relocated, the first heap is empty and kept for later allocations.
+    mAllocator.Deallocate(allocation3);
+    ASSERT_EQ(mAllocator.FindBlockToEvacuate(), TlsfMemoryAllocator::kInvalidBlockIndex);
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 2u);
+
+    // Relocation doesn't use the empty heap.
+    invalidAllocation = mAllocator.AllocateForRelocation(800, 1, 1u);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    mAllocator.Deallocate(allocation2);
+    mAllocator.Deallocate(relocated);
+    ASSERT_EQ(mHeapAllocator.GetHeapCount(), 1u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
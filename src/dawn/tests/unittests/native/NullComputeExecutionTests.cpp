@@ -0,0 +1,186 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/tests/unittests/validation/ValidationTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+class NullComputeExecutionTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice(native::Adapter dawnAdapter,
+                                wgpu::DeviceDescriptor deviceDescriptor) override {
+        const char* enabledToggles[] = {"null_execute_compute_on_cpu"};
+
+        wgpu::DawnTogglesDescriptor deviceTogglesDesc;
+        deviceTogglesDesc.enabledToggles = enabledToggles;
+        deviceTogglesDesc.enabledTogglesCount = 1;
+        deviceDescriptor.nextInChain = &deviceTogglesDesc;
+
+        return dawnAdapter.CreateDevice(&deviceDescriptor);
+    }
+
+    void SetUp() override {
+        ValidationTest::SetUp();
+        DAWN_SKIP_TEST_IF(!HasToggleEnabled("null_execute_compute_on_cpu"));
+    }
+
+    wgpu::Buffer CreateBuffer(uint64_t size, wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    // Copies the contents of |buffer| to a mappable buffer and returns them.
+    std::vector<uint32_t> ReadBuffer(const wgpu::Buffer& buffer, uint64_t size) {
+        wgpu::Buffer readback =
+            CreateBuffer(size, wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst);
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(buffer, 0, readback, 0, size);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        device.GetQueue().Submit(1, &commands);
+
+        bool mapped = false;
+        readback.MapAsync(
+            wgpu::MapMode::Read, 0, size,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                EXPECT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                *static_cast<bool*>(userdata) = true;
+            },
+            &mapped);
+        WaitForAllOperations(device);
+        EXPECT_TRUE(mapped);
+
+        std::vector<uint32_t> data(size / sizeof(uint32_t));
+        memcpy(data.data(), readback.GetConstMappedRange(), size);
+        readback.Unmap();
+        return data;
+    }
+};
+
+// Test that a dispatch writes the expected values to a storage buffer.
+TEST_F(NullComputeExecutionTest, Dispatch) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : array<u32>;
+
+        @compute @workgroup_size(4)
+        fn main(@builtin(global_invocation_id) id : vec3u) {
+            data[id.x] = id.x * 2u;
+        })");
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.module = module;
+    pipelineDesc.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    constexpr uint64_t kSize = 16 * sizeof(uint32_t);
+    wgpu::Buffer buffer =
+        CreateBuffer(kSize, wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc);
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.DispatchWorkgroups(4);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+
+    std::vector<uint32_t> data = ReadBuffer(buffer, kSize);
+    for (uint32_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data[i], i * 2u);
+    }
+}
+
+// Test that indirect dispatches and dynamic offsets are applied.
+TEST_F(NullComputeExecutionTest, DispatchIndirectWithDynamicOffset) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : array<atomic<u32>, 4>;
+
+        @compute @workgroup_size(8)
+        fn main(@builtin(workgroup_id) id : vec3u) {
+            atomicAdd(&data[id.x], 1u);
+        })");
+
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage, true}});
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.layout = utils::MakeBasicPipelineLayout(device, &layout);
+    pipelineDesc.compute.module = module;
+    pipelineDesc.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    constexpr uint64_t kOffset = 256;
+    constexpr uint64_t kSize = kOffset + 4 * sizeof(uint32_t);
+    wgpu::Buffer buffer =
+        CreateBuffer(kSize, wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc);
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, buffer, 0, 16}});
+
+    uint32_t workgroupCount[3] = {3, 2, 1};
+    wgpu::Buffer indirect = utils::CreateBufferFromData(
+        device, workgroupCount, sizeof(workgroupCount), wgpu::BufferUsage::Indirect);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    uint32_t dynamicOffset = kOffset;
+    pass.SetBindGroup(0, bindGroup, 1, &dynamicOffset);
+    pass.DispatchWorkgroupsIndirect(indirect, 0);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+
+    std::vector<uint32_t> data = ReadBuffer(buffer, kSize);
+    const uint32_t* result = data.data() + kOffset / sizeof(uint32_t);
+    EXPECT_EQ(result[0], 16u);
+    EXPECT_EQ(result[1], 16u);
+    EXPECT_EQ(result[2], 16u);
+    EXPECT_EQ(result[3], 0u);
+    EXPECT_EQ(data[0], 0u);
+}
+
+// Test that ClearBuffer and WriteBuffer commands are executed in order with the copies.
+TEST_F(NullComputeExecutionTest, ClearAndWriteBuffer) {
+    constexpr uint64_t kSize = 8 * sizeof(uint32_t);
+    std::vector<uint32_t> initialData(8, 0xFFFFFFFF);
+    wgpu::Buffer buffer = utils::CreateBufferFromData(
+        device, initialData.data(), kSize, wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+    const uint32_t writeData[2] = {7, 9};
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.ClearBuffer(buffer, 0, 4 * sizeof(uint32_t));
+    encoder.WriteBuffer(buffer, 2 * sizeof(uint32_t), reinterpret_cast<const uint8_t*>(writeData),
+                        sizeof(writeData));
+    encoder.WriteBuffer(buffer, 0, reinterpret_cast<const uint8_t*>(writeData), 0);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    device.GetQueue().Submit(1, &commands);
+
+    std::vector<uint32_t> data = ReadBuffer(buffer, kSize);
+    EXPECT_EQ(data[0], 0u);
+    EXPECT_EQ(data[1], 0u);
+    EXPECT_EQ(data[2], 7u);
+    EXPECT_EQ(data[3], 9u);
+    for (uint32_t i = 4; i < data.size(); ++i) {
+        EXPECT_EQ(data[i], 0xFFFFFFFF);
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <vector>
+
 #include "dawn/tests/unittests/validation/ValidationTest.h"
 
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -20,6 +23,8 @@
 namespace dawn {
 namespace {
 
+using ::testing::HasSubstr;
+
 class QueueSubmitValidationTest : public ValidationTest {};
 
 // Test submitting with a mapped buffer is disallowed
@@ -363,5 +368,56 @@ TEST_F(QueueSubmitValidationTest, SubmitWithUnusedComputeTextures) {
     }
 }
 
+// Test that submitting command buffers that use enough resources for their validation to be
+// done in parallel reports the error of the first invalid command buffer.
+TEST_F(QueueSubmitValidationTest, ManyCommandBuffersWithManyResources) {
+    constexpr uint32_t kCommandBufferCount = 16;
+    constexpr uint32_t kCopiesPerCommandBuffer = 512;
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+    // Each command buffer copies between its own buffers.
+    std::vector<std::vector<wgpu::Buffer>> buffers(kCommandBufferCount);
+    auto EncodeCommandBuffers = [&]() {
+        std::vector<wgpu::CommandBuffer> commands;
+        for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+            if (buffers[i].empty()) {
+                for (uint32_t j = 0; j < 2 * kCopiesPerCommandBuffer; ++j) {
+                    std::string label = "buffer " + std::to_string(i) + "-" + std::to_string(j);
+                    descriptor.label = label.c_str();
+                    buffers[i].push_back(device.CreateBuffer(&descriptor));
+                }
+            }
+
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            for (uint32_t j = 0; j < kCopiesPerCommandBuffer; ++j) {
+                encoder.CopyBufferToBuffer(buffers[i][2 * j], 0, buffers[i][2 * j + 1], 0, 4);
+            }
+            commands.push_back(encoder.Finish());
+        }
+        return commands;
+    };
+
+    wgpu::Queue queue = device.GetQueue();
+
+    // All the command buffers are valid.
+    {
+        std::vector<wgpu::CommandBuffer> commands = EncodeCommandBuffers();
+        queue.Submit(commands.size(), commands.data());
+    }
+
+    // Buffers used by two of the command buffers are destroyed, only the error of the first one
+    // is reported.
+    {
+        std::vector<wgpu::CommandBuffer> commands = EncodeCommandBuffers();
+        buffers[11][7].Destroy();
+        buffers[3][100].Destroy();
+        ASSERT_DEVICE_ERROR(queue.Submit(commands.size(), commands.data()),
+                            HasSubstr("buffer 3-100"));
+    }
+}
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -0,0 +1,214 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+
+#include "dawn/dawn_proc_table.h"
+#include "dawn/wire/WireClient.h"
+#include "dawn/wire/WireCompression.h"
+#include "gtest/gtest.h"
+
+namespace dawn::wire {
+namespace {
+
+// A serializer that stores the commands until they are flushed to its handler.
+class BufferingSerializer : public CommandSerializer {
+  public:
+    explicit BufferingSerializer(CommandHandler* handler = nullptr) : mHandler(handler) {}
+
+    size_t GetMaximumAllocationSize() const override { return 1 << 20; }
+
+    void* GetCmdSpace(size_t size) override {
+        // Note: This returns non-null even if size is zero.
+        size_t offset = mBuffer.size();
+        mBuffer.reserve(offset + size + 1);
+        mBuffer.resize(offset + size);
+        return mBuffer.data() + offset;
+    }
+
+    bool Flush() override {
+        mFlushedSize += mBuffer.size();
+        bool success = true;
+        if (mHandler != nullptr) {
+            success = mHandler->HandleCommands(mBuffer.data(), mBuffer.size()) != nullptr;
+        }
+        mBuffer.clear();
+        return success;
+    }
+
+    size_t GetFlushedSize() const { return mFlushedSize; }
+
+  private:
+    CommandHandler* mHandler;
+    std::vector<char> mBuffer;
+    size_t mFlushedSize = 0;
+};
+
+// A handler that stores all the commands it receives.
+class RecordingHandler : public CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        const char* data = const_cast<const char*>(commands);
+        received.insert(received.end(), data, data + size);
+        return commands + size;
+    }
+
+    std::vector<char> received;
+};
+
+// Writes a fake command that has a header, a command ID and a payload of |words|.
+void WriteCommand(CommandSerializer* serializer, uint32_t commandId, std::vector<uint32_t> words) {
+    uint64_t size = sizeof(uint64_t) + sizeof(uint32_t) * (1 + words.size());
+    char* space = static_cast<char*>(serializer->GetCmdSpace(size));
+    ASSERT_NE(space, nullptr);
+    memcpy(space, &size, sizeof(size));
+    memcpy(space + sizeof(size), &commandId, sizeof(commandId));
+    memcpy(space + sizeof(size) + sizeof(commandId), words.data(), words.size() * sizeof(uint32_t));
+}
+
+class WireCompressionTests : public testing::Test {
+  protected:
+    // Writes the same commands compressed and uncompressed, and checks that the decompressed
+    // commands are identical to the uncompressed ones.
+    template <typename F>
+    void ExpectRoundtrip(F&& writeCommands) {
+        RecordingHandler expected;
+        BufferingSerializer uncompressed(&expected);
+        writeCommands(&uncompressed);
+        ASSERT_TRUE(uncompressed.Flush());
+
+        RecordingHandler actual;
+        DecompressingCommandHandler decompressor(&actual);
+        BufferingSerializer transport(&decompressor);
+        CompressingCommandSerializer compressor(&transport);
+        writeCommands(&compressor);
+        ASSERT_TRUE(compressor.Flush());
+
+        EXPECT_EQ(expected.received, actual.received);
+        uncompressedSize = uncompressed.GetFlushedSize();
+        compressedSize = transport.GetFlushedSize();
+    }
+
+    size_t uncompressedSize = 0;
+    size_t compressedSize = 0;
+};
+
+// Test that repeated commands with small changes are compressed and decompressed correctly.
+TEST_F(WireCompressionTests, RepeatedCommands) {
+    ExpectRoundtrip([](CommandSerializer* serializer) {
+        for (uint32_t i = 0; i < 100; ++i) {
+            WriteCommand(serializer, 3, {42, 7, 0, i});
+            WriteCommand(serializer, 5, {3, 1, 0, 0});
+            WriteCommand(serializer, 3, {43 + i % 4, 7, 0xFFFFFFFF - i, i});
+        }
+    });
+    EXPECT_LT(compressedSize * 4, uncompressedSize);
+}
+
+// Test deltas of commands that have more words than fit in a single byte of the mask.
+TEST_F(WireCompressionTests, LargeCommands) {
+    ExpectRoundtrip([](CommandSerializer* serializer) {
+        std::vector<uint32_t> words(37, 5);
+        for (uint32_t i = 0; i < 100; ++i) {
+            words[i % words.size()] += i;
+            words[(i * 7) % words.size()] -= 1000;
+            WriteCommand(serializer, 7, words);
+        }
+    });
+    EXPECT_LT(compressedSize * 4, uncompressedSize);
+}
+
+// Test that commands of different sizes and unaligned allocations are sent as literals.
+TEST_F(WireCompressionTests, DifferentSizes) {
+    ExpectRoundtrip([](CommandSerializer* serializer) {
+        WriteCommand(serializer, 3, {1});
+        WriteCommand(serializer, 3, {1, 2});
+        WriteCommand(serializer, 3, {1, 2, 3});
+        WriteCommand(serializer, 3, {1, 2, 4});
+        WriteCommand(serializer, 1000, {1, 2, 4});
+        WriteCommand(serializer, 1000, {1, 2, 4});
+
+        char* data = static_cast<char*>(serializer->GetCmdSpace(3));
+        memcpy(data, "abc", 3);
+        EXPECT_NE(serializer->GetCmdSpace(0), nullptr);
+    });
+}
+
+// Test that commands serialized by the wire client roundtrip.
+TEST_F(WireCompressionTests, WireClientCommands) {
+    ExpectRoundtrip([](CommandSerializer* serializer) {
+        WireClientDescriptor desc = {};
+        desc.serializer = serializer;
+        WireClient client(desc);
+        const DawnProcTable& procs = client::GetProcs();
+
+        WGPUDevice device = client.ReserveDevice().device;
+        WGPUBufferDescriptor bufferDesc = {};
+        bufferDesc.size = 256;
+        bufferDesc.usage = WGPUBufferUsage_Uniform;
+        WGPUBuffer buffer = procs.deviceCreateBuffer(device, &bufferDesc);
+        WGPUCommandEncoder encoder = procs.deviceCreateCommandEncoder(device, nullptr);
+        WGPUComputePassEncoder pass = procs.commandEncoderBeginComputePass(encoder, nullptr);
+        for (uint32_t i = 0; i < 50; ++i) {
+            procs.computePassEncoderDispatchWorkgroups(pass, i, 1, 1);
+        }
+        procs.computePassEncoderEnd(pass);
+        procs.computePassEncoderRelease(pass);
+        procs.commandEncoderRelease(encoder);
+        procs.bufferRelease(buffer);
+    });
+    EXPECT_LT(compressedSize * 2, uncompressedSize);
+}
+
+// Test that a stream that wasn't compressed is rejected.
+TEST_F(WireCompressionTests, MissingStreamHeader) {
+    RecordingHandler handler;
+    DecompressingCommandHandler decompressor(&handler);
+    BufferingSerializer transport(&decompressor);
+    WriteCommand(&transport, 3, {1, 2, 3});
+    EXPECT_FALSE(transport.Flush());
+}
+
+// Test that truncated streams and deltas without a reference are rejected.
+TEST_F(WireCompressionTests, Malformed) {
+    RecordingHandler recorder;
+    BufferingSerializer capture(&recorder);
+    CompressingCommandSerializer compressor(&capture);
+    WriteCommand(&compressor, 3, {1, 2, 3});
+    WriteCommand(&compressor, 3, {1, 2, 4});
+    ASSERT_TRUE(compressor.Flush());
+    const std::vector<char>& compressed = recorder.received;
+
+    {
+        RecordingHandler handler;
+        DecompressingCommandHandler decompressor(&handler);
+        EXPECT_EQ(decompressor.HandleCommands(compressed.data(), compressed.size() - 1), nullptr);
+    }
+
+    // The stream header is 4 bytes, followed by the 1-byte tag and the 24 bytes of the first
+    // command, and the delta of the second command.
+    constexpr size_t kFirstRecordEnd = 4 + 1 + 24;
+    ASSERT_GT(compressed.size(), kFirstRecordEnd);
+    std::vector<char> deltaOnly(compressed.begin(), compressed.begin() + 4);
+    deltaOnly.insert(deltaOnly.end(), compressed.begin() + kFirstRecordEnd, compressed.end());
+    {
+        RecordingHandler handler;
+        DecompressingCommandHandler decompressor(&handler);
+        EXPECT_EQ(decompressor.HandleCommands(deltaOnly.data(), deltaOnly.size()), nullptr);
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
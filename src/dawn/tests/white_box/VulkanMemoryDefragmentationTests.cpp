@@ -0,0 +1,134 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dawn/tests/DawnTest.h"
+
+#include "dawn/native/VulkanBackend.h"
+#include "dawn/native/vulkan/BufferVk.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+// Large enough that only two of these buffers fit in a memory block of the allocator.
+constexpr uint64_t kBufferSize = 3 * 1024 * 1024;
+
+class VulkanMemoryDefragmentationTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    wgpu::Buffer CreateBuffer() {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = kBufferSize;
+        descriptor.usage =
+            wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    const ResourceHeapBase* GetResourceHeap(const wgpu::Buffer& buffer) {
+        return ToBackend(FromAPI(buffer.Get()))->GetMemoryAllocation().GetResourceHeap();
+    }
+
+    // Submits the pending commands and lets the device run its idle tasks a few times.
+    void TickUntilIdle() {
+        queue.Submit(0, nullptr);
+        for (uint32_t i = 0; i < 5; ++i) {
+            WaitForAllOperations();
+            device.Tick();
+        }
+    }
+
+    // Creates four buffers in two memory blocks, then destroys one buffer in each block so that
+    // the remaining ones could fit in a single memory block. Returns the remaining buffers.
+    std::vector<wgpu::Buffer> CreateFragmentedBuffers() {
+        std::vector<wgpu::Buffer> buffers;
+        for (uint32_t i = 0; i < 4; ++i) {
+            buffers.push_back(CreateBuffer());
+        }
+        EXPECT_EQ(GetResourceHeap(buffers[0]), GetResourceHeap(buffers[1]));
+        EXPECT_EQ(GetResourceHeap(buffers[2]), GetResourceHeap(buffers[3]));
+        EXPECT_NE(GetResourceHeap(buffers[0]), GetResourceHeap(buffers[3]));
+
+        buffers[1].Destroy();
+        buffers[2].Destroy();
+        return {buffers[0], buffers[3]};
+    }
+};
+
+// Test that the memory heap statistics account for the sub-allocated buffers.
+TEST_P(VulkanMemoryDefragmentationTests, MemoryHeapStatistics) {
+    wgpu::Buffer buffer = CreateBuffer();
+
+    uint64_t blockCount = 0;
+    uint64_t blockAllocatedSize = 0;
+    uint64_t subAllocatedSize = 0;
+    for (const MemoryHeapStatistics& statistics : GetMemoryHeapStatistics(device.Get())) {
+        blockCount += statistics.blockCount;
+        blockAllocatedSize += statistics.blockAllocatedSize;
+        subAllocatedSize += statistics.subAllocatedSize;
+    }
+    EXPECT_GE(blockCount, 1u);
+    EXPECT_GE(subAllocatedSize, kBufferSize);
+    EXPECT_GE(blockAllocatedSize, subAllocatedSize);
+}
+
+// Test that the buffers of a fragmented memory block are moved to another memory block when the
+// device is idle, with their contents preserved.
+TEST_P(VulkanMemoryDefragmentationTests, BuffersAreRelocated) {
+    std::vector<wgpu::Buffer> buffers = CreateFragmentedBuffers();
+
+    std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t));
+    for (uint32_t i = 0; i < data.size(); ++i) {
+        data[i] = i;
+    }
+    queue.WriteBuffer(buffers[0], 0, data.data(), kBufferSize);
+
+    TickUntilIdle();
+    EXPECT_EQ(GetResourceHeap(buffers[0]), GetResourceHeap(buffers[1]));
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffers[0], 0, data.size());
+}
+
+// Test that the buffers referenced by bind groups aren't relocated since the descriptor sets
+// contain their VkBuffer.
+TEST_P(VulkanMemoryDefragmentationTests, BuffersInBindGroupsAreNotRelocated) {
+    std::vector<wgpu::Buffer> buffers = CreateFragmentedBuffers();
+    const ResourceHeapBase* heaps[] = {GetResourceHeap(buffers[0]), GetResourceHeap(buffers[1])};
+
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage},
+                 {1, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, layout, {{0, buffers[0]}, {1, buffers[1]}});
+
+    TickUntilIdle();
+    EXPECT_EQ(GetResourceHeap(buffers[0]), heaps[0]);
+    EXPECT_EQ(GetResourceHeap(buffers[1]), heaps[1]);
+
+    // The buffers can be relocated once the bind group is released.
+    bindGroup = nullptr;
+    TickUntilIdle();
+    EXPECT_EQ(GetResourceHeap(buffers[0]), GetResourceHeap(buffers[1]));
+}
+
+DAWN_INSTANTIATE_TEST(VulkanMemoryDefragmentationTests,
+                      VulkanBackend({"vulkan_use_tlsf_suballocation",
+                                     "vulkan_defragment_buffer_memory"}));
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,186 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/native/VulkanBackend.h"
+#include "dawn/tests/DawnTest.h"
+#include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+using ::testing::NiceMock;
+
+constexpr uint32_t kComputePipelineCount = 8;
+
+class VulkanPipelinesBatchTests : public DawnTest {
+  protected:
+    std::unique_ptr<platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnCachingMockPlatform>(&mMockCache);
+    }
+
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    struct BatchResult {
+        std::atomic<uint32_t> successCount{0};
+        std::atomic<uint32_t> errorCount{0};
+        std::atomic<bool> done{false};
+        // The number of pipeline callbacks called before the done callback.
+        uint32_t callbackCountWhenDone = 0;
+    };
+
+    static void OnComputePipelineCreated(WGPUCreatePipelineAsyncStatus status,
+                                         WGPUComputePipeline pipeline,
+                                         const char* message,
+                                         void* userdata) {
+        BatchResult* result = static_cast<BatchResult*>(userdata);
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            wgpuComputePipelineRelease(pipeline);
+            result->successCount++;
+        } else {
+            result->errorCount++;
+        }
+    }
+
+    static void OnRenderPipelineCreated(WGPUCreatePipelineAsyncStatus status,
+                                        WGPURenderPipeline pipeline,
+                                        const char* message,
+                                        void* userdata) {
+        BatchResult* result = static_cast<BatchResult*>(userdata);
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            wgpuRenderPipelineRelease(pipeline);
+            result->successCount++;
+        } else {
+            result->errorCount++;
+        }
+    }
+
+    static void OnBatchDone(void* userdata) {
+        BatchResult* result = static_cast<BatchResult*>(userdata);
+        result->callbackCountWhenDone = result->successCount + result->errorCount;
+        result->done = true;
+    }
+
+    // Creates kComputePipelineCount compute pipelines from distinct shader modules, plus
+    // additionalRenderPipelines, in a batch, and waits for it to be done.
+    void CreateBatch(wgpu::Device targetDevice,
+                     BatchResult* result,
+                     const std::vector<const wgpu::RenderPipelineDescriptor*>&
+                         additionalRenderPipelines = {}) {
+        std::vector<wgpu::ShaderModule> modules;
+        std::vector<wgpu::ComputePipelineDescriptor> descriptors(kComputePipelineCount);
+        std::vector<ComputePipelineBatchEntry> computeEntries(kComputePipelineCount);
+        for (uint32_t i = 0; i < kComputePipelineCount; ++i) {
+            std::string shader =
+                "@compute @workgroup_size(" + std::to_string(i + 1) + ") fn main() {}";
+            modules.push_back(utils::CreateShaderModule(targetDevice, shader.c_str()));
+            descriptors[i].compute.module = modules.back();
+            descriptors[i].compute.entryPoint = "main";
+
+            computeEntries[i].descriptor =
+                reinterpret_cast<const WGPUComputePipelineDescriptor*>(&descriptors[i]);
+            computeEntries[i].callback = OnComputePipelineCreated;
+            computeEntries[i].userdata = result;
+        }
+
+        std::vector<RenderPipelineBatchEntry> renderEntries;
+        for (const wgpu::RenderPipelineDescriptor* descriptor : additionalRenderPipelines) {
+            renderEntries.push_back(
+                {reinterpret_cast<const WGPURenderPipelineDescriptor*>(descriptor),
+                 OnRenderPipelineCreated, result});
+        }
+
+        PipelinesBatchDescriptor batch;
+        batch.cacheName = "warm-up";
+        batch.computePipelineCount = computeEntries.size();
+        batch.computePipelines = computeEntries.data();
+        batch.renderPipelineCount = renderEntries.size();
+        batch.renderPipelines = renderEntries.data();
+        batch.doneCallback = OnBatchDone;
+        batch.doneUserdata = result;
+        CreatePipelinesBatchAsync(targetDevice.Get(), &batch);
+
+        while (!result->done) {
+            targetDevice.Tick();
+            WaitABit();
+        }
+    }
+
+    NiceMock<CachingInterfaceMock> mMockCache;
+};
+
+// Test that all the pipelines of a batch are created, and that the batch is done after their
+// callbacks are called.
+TEST_P(VulkanPipelinesBatchTests, AllPipelinesAreCreated) {
+    utils::ComboRenderPipelineDescriptor renderDescriptor;
+    renderDescriptor.vertex.module = utils::CreateShaderModule(device, R"(
+        @vertex fn main() -> @builtin(position) vec4f {
+            return vec4f(0.0, 0.0, 0.0, 1.0);
+        })");
+    renderDescriptor.vertex.entryPoint = "main";
+    renderDescriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+        @fragment fn main() -> @location(0) vec4f {
+            return vec4f(0.1, 0.2, 0.3, 0.4);
+        })");
+    renderDescriptor.cFragment.entryPoint = "main";
+
+    // An invalid pipeline reports its error without preventing the batch from being done.
+    utils::ComboRenderPipelineDescriptor invalidDescriptor;
+    invalidDescriptor.vertex.module = renderDescriptor.vertex.module;
+    invalidDescriptor.vertex.entryPoint = "main";
+    invalidDescriptor.cFragment.module = renderDescriptor.cFragment.module;
+    invalidDescriptor.cFragment.entryPoint = "missing";
+
+    BatchResult result;
+    CreateBatch(device, &result, {&renderDescriptor, &invalidDescriptor});
+    EXPECT_EQ(result.successCount, kComputePipelineCount + 1);
+    EXPECT_EQ(result.errorCount, 1u);
+    EXPECT_EQ(result.callbackCountWhenDone, kComputePipelineCount + 2);
+}
+
+// Test that the pipelines of a batch are stored as a single pipeline cache blob, which is used
+// by the next batch with the same name.
+TEST_P(VulkanPipelinesBatchTests, SinglePipelineCacheBlob) {
+    // Each shader module is stored in its own blob, but there is a single blob for the pipelines.
+    {
+        wgpu::Device device = CreateDevice();
+        BatchResult result;
+        EXPECT_CACHE_STATS(mMockCache, Hit(0), Add(kComputePipelineCount + 1),
+                           CreateBatch(device, &result));
+        EXPECT_EQ(result.successCount, kComputePipelineCount);
+    }
+
+    // The second batch, on another device to skip the frontend cache, hits all the blobs.
+    {
+        wgpu::Device device = CreateDevice();
+        BatchResult result;
+        EXPECT_CACHE_STATS(mMockCache, Hit(kComputePipelineCount + 1), Add(0),
+                           CreateBatch(device, &result));
+        EXPECT_EQ(result.successCount, kComputePipelineCount);
+    }
+}
+
+DAWN_INSTANTIATE_TEST(VulkanPipelinesBatchTests, VulkanBackend());
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,327 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/utils/SharedMemoryCommandBuffer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "dawn/common/Math.h"
+
+namespace dawn::utils {
+
+namespace {
+
+// The header of a block is the size of its commands, or kWrapMarker if the commands continue at
+// the beginning of the ring.
+using BlockHeader = uint64_t;
+constexpr BlockHeader kWrapMarker = std::numeric_limits<BlockHeader>::max();
+constexpr size_t kBlockAlignment = sizeof(BlockHeader);
+
+// The control structure and the commands are in separate pages of the mapping.
+constexpr size_t kControlSize = 4096;
+
+// The seals that prevent the other process from resizing the memory under the mapping, which would
+// make accesses past the new end of the file fault. F_SEAL_SEAL prevents the seals from being
+// removed.
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+void CloseFd(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void RingDoorbell(int fd) {
+    uint64_t value = 1;
+    while (write(fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+    }
+}
+
+void WaitForDoorbell(int fd) {
+    uint64_t value;
+    while (read(fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+    }
+}
+
+}  // anonymous namespace
+
+// The state shared by both processes, at the start of the mapping. The producer and consumer
+// state are in different cache lines to avoid false sharing.
+struct SharedMemoryCommandRing::Control {
+    // Offset of the end of the last flushed block.
+    alignas(64) std::atomic<uint64_t> writeOffset;
+    std::atomic<uint32_t> consumerWaiting;
+    // Offset of the end of the last handled block.
+    alignas(64) std::atomic<uint64_t> readOffset;
+    std::atomic<uint32_t> producerWaiting;
+    alignas(64) std::atomic<uint32_t> closed;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "atomics in shared memory must be lock-free to work across processes");
+
+// static
+std::unique_ptr<SharedMemoryCommandRing> SharedMemoryCommandRing::Create(size_t capacity) {
+    static_assert(sizeof(Control) <= kControlSize);
+    size_t mappingSize = kControlSize + Align(std::max(capacity, kControlSize), kControlSize);
+
+    Handles handles;
+    handles.memoryFd = memfd_create("dawn_wire_commands", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    handles.commandsAvailableFd = eventfd(0, EFD_CLOEXEC);
+    handles.spaceAvailableFd = eventfd(0, EFD_CLOEXEC);
+    if (handles.memoryFd < 0 || handles.commandsAvailableFd < 0 || handles.spaceAvailableFd < 0 ||
+        ftruncate(handles.memoryFd, mappingSize) != 0 ||
+        fcntl(handles.memoryFd, F_ADD_SEALS, kRequiredSeals) != 0) {
+        CloseFd(handles.memoryFd);
+        CloseFd(handles.commandsAvailableFd);
+        CloseFd(handles.spaceAvailableFd);
+        return nullptr;
+    }
+
+    // The mapping starts zeroed, which is the initial state of the control structure.
+    return Import(handles);
+}
+
+// static
+std::unique_ptr<SharedMemoryCommandRing> SharedMemoryCommandRing::Import(const Handles& handles) {
+    // Only map memory whose size can't change, since the other process could otherwise truncate it
+    // while it is in use.
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    int seals = fcntl(handles.memoryFd, F_GET_SEALS);
+    if (seals >= 0 && (seals & kRequiredSeals) == kRequiredSeals &&
+        fstat(handles.memoryFd, &info) == 0 && info.st_size > static_cast<off_t>(kControlSize) &&
+        info.st_size % kControlSize == 0) {
+        mapping = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, handles.memoryFd,
+                       0);
+    }
+    if (mapping == MAP_FAILED) {
+        CloseFd(handles.memoryFd);
+        CloseFd(handles.commandsAvailableFd);
+        CloseFd(handles.spaceAvailableFd);
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryCommandRing>(
+        new SharedMemoryCommandRing(handles, mapping, info.st_size));
+}
+
+SharedMemoryCommandRing::SharedMemoryCommandRing(const Handles& handles,
+                                                 void* mapping,
+                                                 size_t mappingSize)
+    : mHandles(handles),
+      mMapping(mapping),
+      mMappingSize(mappingSize),
+      mControl(static_cast<Control*>(mapping)),
+      mData(static_cast<volatile char*>(mapping) + kControlSize),
+      mCapacity(mappingSize - kControlSize) {}
+
+SharedMemoryCommandRing::~SharedMemoryCommandRing() {
+    munmap(mMapping, mMappingSize);
+    CloseFd(mHandles.memoryFd);
+    CloseFd(mHandles.commandsAvailableFd);
+    CloseFd(mHandles.spaceAvailableFd);
+}
+
+SharedMemoryCommandRing::Handles SharedMemoryCommandRing::GetHandles() const {
+    return mHandles;
+}
+
+size_t SharedMemoryCommandRing::GetCapacity() const {
+    return mCapacity;
+}
+
+void SharedMemoryCommandRing::Close() {
+    mControl->closed.store(1);
+    RingDoorbell(mHandles.commandsAvailableFd);
+    RingDoorbell(mHandles.spaceAvailableFd);
+}
+
+bool SharedMemoryCommandRing::IsClosed() const {
+    return mControl->closed.load() != 0;
+}
+
+void SharedMemoryCommandRing::WaitWhile(int fd,
+                                        std::atomic<uint32_t>* waiting,
+                                        const std::atomic<uint64_t>& offset,
+                                        uint64_t value) {
+    // The waiting flag is set before checking the offset again, and the other side updates the
+    // offset before checking the flag, so at least one of them sees the other's store and the
+    // doorbell can't be missed.
+    waiting->store(1);
+    if (offset.load() == value && !IsClosed()) {
+        WaitForDoorbell(fd);
+    }
+    waiting->store(0);
+}
+
+// SharedMemoryCommandSerializer
+
+SharedMemoryCommandSerializer::SharedMemoryCommandSerializer(SharedMemoryCommandRing* ring)
+    : mRing(ring),
+      mCursor(ring->mControl->writeOffset.load()),
+      mCachedReadOffset(ring->mControl->readOffset.load()) {}
+
+SharedMemoryCommandSerializer::~SharedMemoryCommandSerializer() = default;
+
+size_t SharedMemoryCommandSerializer::GetMaximumAllocationSize() const {
+    // Leave room for the block header and for the unused end of the ring when wrapping around, so
+    // that a maximum allocation can't wait for space that never gets freed.
+    return mRing->mCapacity / 4;
+}
+
+void* SharedMemoryCommandSerializer::GetCmdSpace(size_t size) {
+    // Note: This returns non-null even if size is zero.
+    if (size > GetMaximumAllocationSize()) {
+        return nullptr;
+    }
+    const uint64_t capacity = mRing->mCapacity;
+
+    // Append to the current block when it fits before the end of the ring and the consumer has
+    // already freed the space.
+    if (mBlockOpen) {
+        uint64_t end = mCursor + size;
+        if (mCursor % capacity + size <= capacity && HasSpace(Align(end, kBlockAlignment))) {
+            void* result = const_cast<char*>(mRing->mData + mCursor % capacity);
+            mCursor = end;
+            return result;
+        }
+        // Make the block visible before waiting so the consumer can free the space.
+        if (!Flush()) {
+            return nullptr;
+        }
+    }
+
+    uint64_t blockStart = mCursor;
+    bool wrap = blockStart % capacity + sizeof(BlockHeader) + size > capacity;
+    if (wrap) {
+        blockStart = (blockStart / capacity + 1) * capacity;
+    }
+    uint64_t end = blockStart + sizeof(BlockHeader) + size;
+    if (!WaitForSpace(Align(end, kBlockAlignment))) {
+        return nullptr;
+    }
+    if (wrap) {
+        *reinterpret_cast<volatile BlockHeader*>(mRing->mData + mCursor % capacity) = kWrapMarker;
+    }
+
+    mBlockStart = blockStart;
+    mCursor = end;
+    mBlockOpen = true;
+    return const_cast<char*>(mRing->mData + blockStart % capacity + sizeof(BlockHeader));
+}
+
+bool SharedMemoryCommandSerializer::Flush() {
+    if (mBlockOpen) {
+        BlockHeader size = mCursor - mBlockStart - sizeof(BlockHeader);
+        *reinterpret_cast<volatile BlockHeader*>(mRing->mData + mBlockStart % mRing->mCapacity) =
+            size;
+        mCursor = Align(mCursor, kBlockAlignment);
+        mBlockOpen = false;
+
+        SharedMemoryCommandRing::Control* control = mRing->mControl;
+        control->writeOffset.store(mCursor);
+        if (control->consumerWaiting.load() != 0) {
+            RingDoorbell(mRing->mHandles.commandsAvailableFd);
+        }
+    }
+    return !mRing->IsClosed();
+}
+
+bool SharedMemoryCommandSerializer::HasSpace(uint64_t end) {
+    if (end - mCachedReadOffset <= mRing->mCapacity) {
+        return true;
+    }
+    mCachedReadOffset = mRing->mControl->readOffset.load(std::memory_order_acquire);
+    return end - mCachedReadOffset <= mRing->mCapacity;
+}
+
+bool SharedMemoryCommandSerializer::WaitForSpace(uint64_t end) {
+    SharedMemoryCommandRing::Control* control = mRing->mControl;
+    while (!HasSpace(end)) {
+        if (mRing->IsClosed()) {
+            return false;
+        }
+        mRing->WaitWhile(mRing->mHandles.spaceAvailableFd, &control->producerWaiting,
+                         control->readOffset, mCachedReadOffset);
+    }
+    return true;
+}
+
+// SharedMemoryCommandReceiver
+
+SharedMemoryCommandReceiver::SharedMemoryCommandReceiver(SharedMemoryCommandRing* ring,
+                                                         dawn::wire::CommandHandler* handler)
+    : mRing(ring), mHandler(handler), mReadOffset(ring->mControl->readOffset.load()) {}
+
+bool SharedMemoryCommandReceiver::HandleAvailableCommands() {
+    SharedMemoryCommandRing::Control* control = mRing->mControl;
+    const uint64_t capacity = mRing->mCapacity;
+
+    uint64_t writeOffset = control->writeOffset.load(std::memory_order_acquire);
+    while (mReadOffset != writeOffset) {
+        // The producer is another process so its data is validated before being used.
+        uint64_t position = mReadOffset % capacity;
+        if (writeOffset - mReadOffset < sizeof(BlockHeader) ||
+            capacity - position < sizeof(BlockHeader)) {
+            return false;
+        }
+        BlockHeader header =
+            *reinterpret_cast<const volatile BlockHeader*>(mRing->mData + position);
+
+        if (header == kWrapMarker) {
+            mReadOffset = (mReadOffset / capacity + 1) * capacity;
+        } else {
+            uint64_t available = std::min(writeOffset - mReadOffset, capacity - position);
+            if (header > available - sizeof(BlockHeader)) {
+                return false;
+            }
+            const volatile char* commands = mRing->mData + position + sizeof(BlockHeader);
+            if (mHandler->HandleCommands(commands, header) == nullptr) {
+                return false;
+            }
+            mReadOffset = Align(mReadOffset + sizeof(BlockHeader) + header, kBlockAlignment);
+        }
+        if (mReadOffset > writeOffset) {
+            return false;
+        }
+
+        // Free the space as soon as each block is handled so that the producer can keep going.
+        control->readOffset.store(mReadOffset);
+        if (control->producerWaiting.load() != 0) {
+            RingDoorbell(mRing->mHandles.spaceAvailableFd);
+        }
+    }
+    return true;
+}
+
+bool SharedMemoryCommandReceiver::WaitAndHandleCommands() {
+    SharedMemoryCommandRing::Control* control = mRing->mControl;
+    while (control->writeOffset.load(std::memory_order_acquire) == mReadOffset) {
+        if (mRing->IsClosed()) {
+            return false;
+        }
+        mRing->WaitWhile(mRing->mHandles.commandsAvailableFd, &control->consumerWaiting,
+                         control->writeOffset, mReadOffset);
+    }
+    return HandleAvailableCommands();
+}
+
+}  // namespace dawn::utils
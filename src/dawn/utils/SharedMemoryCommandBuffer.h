@@ -0,0 +1,135 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYCOMMANDBUFFER_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYCOMMANDBUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::utils {
+
+// A single-producer single-consumer ring buffer of wire commands in a shared memory region, used
+// to exchange commands between a wire client and server that live in different processes without
+// copying them. The region is a memfd, and each side sleeps on an eventfd "doorbell" that is only
+// rung when the other side is waiting, so a busy producer and consumer don't make any syscalls.
+//
+// Commands are written in blocks. A block is a 64-bit header containing the size of the commands
+// that follow it, and never wraps around the end of the ring: when a block doesn't fit before the
+// end, a wrap marker is written instead and the block starts at the beginning of the ring.
+class SharedMemoryCommandRing {
+  public:
+    // The file descriptors to send to the other process (for example with SCM_RIGHTS) so that it
+    // can Import() the ring.
+    struct Handles {
+        int memoryFd = -1;
+        int commandsAvailableFd = -1;
+        int spaceAvailableFd = -1;
+    };
+
+    // Creates a ring that can hold at least |capacity| bytes of commands. Returns nullptr on
+    // failure.
+    static std::unique_ptr<SharedMemoryCommandRing> Create(size_t capacity);
+    // Maps a ring created by another process. Takes ownership of the file descriptors. Returns
+    // nullptr on failure, including when the memory isn't sealed against resizing.
+    static std::unique_ptr<SharedMemoryCommandRing> Import(const Handles& handles);
+
+    ~SharedMemoryCommandRing();
+    SharedMemoryCommandRing(const SharedMemoryCommandRing&) = delete;
+    SharedMemoryCommandRing& operator=(const SharedMemoryCommandRing&) = delete;
+
+    // The returned file descriptors are still owned by the ring.
+    Handles GetHandles() const;
+    size_t GetCapacity() const;
+
+    // Makes both sides of the ring stop waiting. The consumer still handles the commands that were
+    // flushed before the ring was closed.
+    void Close();
+
+  private:
+    friend class SharedMemoryCommandSerializer;
+    friend class SharedMemoryCommandReceiver;
+    struct Control;
+
+    SharedMemoryCommandRing(const Handles& handles, void* mapping, size_t mappingSize);
+
+    bool IsClosed() const;
+    // Blocks on |fd| until it is signaled, |offset| stops being |value| or the ring is closed.
+    void WaitWhile(int fd,
+                   std::atomic<uint32_t>* waiting,
+                   const std::atomic<uint64_t>& offset,
+                   uint64_t value);
+
+    Handles mHandles;
+    void* mMapping;
+    size_t mMappingSize;
+    Control* mControl;
+    volatile char* mData;
+    uint64_t mCapacity;
+};
+
+// Writes commands to a SharedMemoryCommandRing. Flush() makes the commands visible to the
+// consumer. Allocations block while the ring is full.
+class SharedMemoryCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    explicit SharedMemoryCommandSerializer(SharedMemoryCommandRing* ring);
+    ~SharedMemoryCommandSerializer() override;
+
+    size_t GetMaximumAllocationSize() const override;
+
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+  private:
+    // Returns whether the ring has room for the commands up to |end|, without waiting.
+    bool HasSpace(uint64_t end);
+    // Blocks until the ring has room for the commands up to |end|. Returns false if the ring is
+    // closed.
+    bool WaitForSpace(uint64_t end);
+
+    SharedMemoryCommandRing* mRing;
+    // The offsets are positions in the infinite stream of commands, the offset in the ring is
+    // |offset % capacity|.
+    uint64_t mBlockStart = 0;
+    uint64_t mCursor = 0;
+    uint64_t mCachedReadOffset = 0;
+    bool mBlockOpen = false;
+};
+
+// Reads the commands of a SharedMemoryCommandRing and passes them to a CommandHandler directly
+// from the shared memory.
+class SharedMemoryCommandReceiver {
+  public:
+    SharedMemoryCommandReceiver(SharedMemoryCommandRing* ring, dawn::wire::CommandHandler* handler);
+
+    // Handles all the commands that were flushed. Returns false if the commands are malformed or
+    // the handler fails.
+    bool HandleAvailableCommands();
+    // Waits until commands are flushed and handles them. Returns false if the ring was closed and
+    // all its commands were handled, or on the same failures as HandleAvailableCommands().
+    bool WaitAndHandleCommands();
+
+  private:
+    SharedMemoryCommandRing* mRing;
+    dawn::wire::CommandHandler* mHandler;
+    uint64_t mReadOffset = 0;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYCOMMANDBUFFER_H_
@@ -0,0 +1,375 @@
+// Copyright 2023 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/wire/WireCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/wire/WireCmd_autogen.h"
+
+namespace dawn::wire {
+
+// The compressed stream is the stream header followed by one record per allocation of the
+// uncompressed stream. Allocations are commands, or chunks of commands that are larger than the
+// maximum allocation size. Each record starts with a varint tag containing the size of the
+// allocation and whether it is a literal or a delta:
+//
+//  - Literal records contain the bytes of the allocation.
+//  - Delta records encode an allocation relative to the previous allocation with the same
+//    command ID and size. They contain the command ID as a varint, a bitmask of the 32-bit words
+//    that changed, the zigzag varint difference of each of these words, and finally the bytes
+//    after the last whole word.
+//
+// Both sides remember the previous allocation for each command ID, so the encoder and decoder
+// agree on the reference of every delta record.
+
+namespace {
+
+constexpr uint8_t kStreamHeader[] = {'D', 'W', 'C', 1};
+constexpr uint64_t kDeltaFlag = 1;
+// Command IDs above this are sent as literals, which keeps the tables of previous commands small.
+constexpr uint32_t kMaxDeltaCommandId = 256;
+// The maximum number of bytes a record adds to its allocation: the varint tag, and the stream
+// header before the first record.
+constexpr size_t kMaxRecordOverhead = 10 + sizeof(kStreamHeader);
+constexpr size_t kMinDeltaSize = sizeof(CmdHeader) + sizeof(uint32_t);
+
+// Returns whether the allocation could be the reference of a delta record, and its command ID.
+bool GetDeltaCommandId(const char* data, size_t size, uint32_t* commandId) {
+    if (size < kMinDeltaSize) {
+        return false;
+    }
+    memcpy(commandId, data + sizeof(CmdHeader), sizeof(*commandId));
+    return *commandId < kMaxDeltaCommandId;
+}
+
+void WriteVarint(std::vector<uint8_t>* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t ZigZag(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+uint32_t UnZigZag(uint32_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+// Reads the compressed stream. The stream may be in memory shared with another process, so each
+// byte is only read once.
+class RecordReader {
+  public:
+    RecordReader(const volatile char* data, size_t size) : mData(data), mSize(size) {}
+
+    bool IsEmpty() const { return mOffset == mSize; }
+    size_t GetRemainingSize() const { return mSize - mOffset; }
+
+    bool ReadByte(uint8_t* value) {
+        if (mOffset == mSize) {
+            return false;
+        }
+        *value = static_cast<uint8_t>(mData[mOffset++]);
+        return true;
+    }
+
+    bool ReadVarint(uint64_t* value) {
+        *value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!ReadByte(&byte)) {
+                return false;
+            }
+            *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadBytes(char* out, size_t size) {
+        if (size > mSize - mOffset) {
+            return false;
+        }
+        memcpy(out, const_cast<const char*>(mData + mOffset), size);
+        mOffset += size;
+        return true;
+    }
+
+  private:
+    const volatile char* mData;
+    size_t mSize;
+    size_t mOffset = 0;
+};
+
+}  // anonymous namespace
+
+class CommandCompressor {
+  public:
+    explicit CommandCompressor(CommandSerializer* serializer)
+        : mSerializer(serializer), mPrevious(kMaxDeltaCommandId) {}
+
+    void* GetCmdSpace(size_t size) {
+        if (!CommitPendingCommand()) {
+            return nullptr;
+        }
+        // Note: This returns non-null even if size is zero.
+        if (mPending.size() < size || mPending.empty()) {
+            mPending.resize(std::max(size, size_t(1)));
+        }
+        // Clear the space so that the padding bytes that commands don't write are deterministic
+        // and compress as unchanged.
+        memset(mPending.data(), 0, size);
+        mPendingSize = size;
+        mHasPending = true;
+        return mPending.data();
+    }
+
+    bool Flush() {
+        if (!CommitPendingCommand()) {
+            return false;
+        }
+        return mSerializer->Flush();
+    }
+
+    size_t GetMaximumAllocationSize() const {
+        return mSerializer->GetMaximumAllocationSize() - kMaxRecordOverhead;
+    }
+
+    void OnSerializeError() {
+        mHasPending = false;
+        mSerializer->OnSerializeError();
+    }
+
+  private:
+    bool CommitPendingCommand() {
+        if (!mHasPending) {
+            return true;
+        }
+        mHasPending = false;
+
+        mEncoded.clear();
+        if (!mWroteStreamHeader) {
+            mEncoded.insert(mEncoded.end(), std::begin(kStreamHeader), std::end(kStreamHeader));
+            mWroteStreamHeader = true;
+        }
+
+        const char* data = mPending.data();
+        size_t size = mPendingSize;
+        uint32_t commandId;
+        bool hasCommandId = GetDeltaCommandId(data, size, &commandId);
+        if (!hasCommandId || mPrevious[commandId].size() != size || !EncodeDelta(commandId)) {
+            WriteVarint(&mEncoded, uint64_t(size) << 1);
+            mEncoded.insert(mEncoded.end(), data, data + size);
+        }
+        if (hasCommandId) {
+            mPrevious[commandId].assign(data, data + size);
+        }
+
+        void* dst = mSerializer->GetCmdSpace(mEncoded.size());
+        if (dst == nullptr) {
+            return false;
+        }
+        memcpy(dst, mEncoded.data(), mEncoded.size());
+        return true;
+    }
+
+    // Appends the delta record of the pending command to mEncoded. Returns false and leaves
+    // mEncoded unchanged if the delta isn't smaller than a literal.
+    bool EncodeDelta(uint32_t commandId) {
+        const char* data = mPending.data();
+        const char* previous = mPrevious[commandId].data();
+        size_t size = mPendingSize;
+        size_t wordCount = size / sizeof(uint32_t);
+        size_t recordStart = mEncoded.size();
+
+        WriteVarint(&mEncoded, (uint64_t(size) << 1) | kDeltaFlag);
+        WriteVarint(&mEncoded, commandId);
+        size_t maskStart = mEncoded.size();
+        mEncoded.resize(maskStart + (wordCount + 7) / 8, 0);
+        for (size_t i = 0; i < wordCount; ++i) {
+            uint32_t word;
+            uint32_t previousWord;
+            memcpy(&word, data + i * sizeof(uint32_t), sizeof(word));
+            memcpy(&previousWord, previous + i * sizeof(uint32_t), sizeof(previousWord));
+            if (word != previousWord) {
+                mEncoded[maskStart + i / 8] |= uint8_t(1) << (i % 8);
+                WriteVarint(&mEncoded, ZigZag(word - previousWord));
+            }
+        }
+        mEncoded.insert(mEncoded.end(), data + wordCount * sizeof(uint32_t), data + size);
+
+        if (mEncoded.size() - recordStart >= size + 1) {
+            mEncoded.resize(recordStart);
+            return false;
+        }
+        return true;
+    }
+
+    CommandSerializer* mSerializer;
+    std::vector<char> mPending;
+    size_t mPendingSize = 0;
+    bool mHasPending = false;
+    bool mWroteStreamHeader = false;
+    std::vector<uint8_t> mEncoded;
+    std::vector<std::vector<char>> mPrevious;
+};
+
+class CommandDecompressor {
+  public:
+    explicit CommandDecompressor(CommandHandler* handler)
+        : mHandler(handler), mPrevious(kMaxDeltaCommandId) {}
+
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) {
+        if (size == 0) {
+            return commands;
+        }
+        RecordReader reader(commands, size);
+        mDecoded.clear();
+
+        if (!mReadStreamHeader) {
+            char header[sizeof(kStreamHeader)];
+            if (!reader.ReadBytes(header, sizeof(header)) ||
+                memcmp(header, kStreamHeader, sizeof(header)) != 0) {
+                return nullptr;
+            }
+            mReadStreamHeader = true;
+        }
+
+        while (!reader.IsEmpty()) {
+            if (!DecodeRecord(&reader)) {
+                return nullptr;
+            }
+        }
+
+        if (!mDecoded.empty() &&
+            mHandler->HandleCommands(mDecoded.data(), mDecoded.size()) == nullptr) {
+            return nullptr;
+        }
+        return commands + size;
+    }
+
+  private:
+    bool DecodeRecord(RecordReader* reader) {
+        uint64_t tag;
+        if (!reader->ReadVarint(&tag)) {
+            return false;
+        }
+        uint64_t size = tag >> 1;
+        size_t start = mDecoded.size();
+
+        if ((tag & kDeltaFlag) == 0) {
+            // Check the size against the remaining data before allocating.
+            if (size > reader->GetRemainingSize()) {
+                return false;
+            }
+            mDecoded.resize(start + size);
+            if (!reader->ReadBytes(mDecoded.data() + start, size)) {
+                return false;
+            }
+        } else {
+            uint64_t commandId;
+            if (!reader->ReadVarint(&commandId) || commandId >= kMaxDeltaCommandId ||
+                mPrevious[commandId].size() != size || size < kMinDeltaSize) {
+                return false;
+            }
+            const std::vector<char>& previous = mPrevious[commandId];
+            mDecoded.insert(mDecoded.end(), previous.begin(), previous.end());
+
+            char* data = mDecoded.data() + start;
+            size_t wordCount = size / sizeof(uint32_t);
+            // The mask of the changed words comes first, followed by the delta of each word.
+            mMask.resize((wordCount + 7) / 8);
+            if (!reader->ReadBytes(reinterpret_cast<char*>(mMask.data()), mMask.size())) {
+                return false;
+            }
+            for (size_t i = 0; i < wordCount; ++i) {
+                if ((mMask[i / 8] & (uint8_t(1) << (i % 8))) == 0) {
+                    continue;
+                }
+                uint64_t delta;
+                if (!reader->ReadVarint(&delta) || delta > std::numeric_limits<uint32_t>::max()) {
+                    return false;
+                }
+                uint32_t word;
+                memcpy(&word, data + i * sizeof(uint32_t), sizeof(word));
+                word += UnZigZag(static_cast<uint32_t>(delta));
+                memcpy(data + i * sizeof(uint32_t), &word, sizeof(word));
+            }
+            size_t tailSize = size - wordCount * sizeof(uint32_t);
+            if (!reader->ReadBytes(data + wordCount * sizeof(uint32_t), tailSize)) {
+                return false;
+            }
+        }
+
+        uint32_t decodedCommandId;
+        if (GetDeltaCommandId(mDecoded.data() + start, size, &decodedCommandId)) {
+            mPrevious[decodedCommandId].assign(mDecoded.begin() + start, mDecoded.end());
+        }
+        return true;
+    }
+
+    CommandHandler* mHandler;
+    bool mReadStreamHeader = false;
+    std::vector<char> mDecoded;
+    std::vector<uint8_t> mMask;
+    std::vector<std::vector<char>> mPrevious;
+};
+
+// CompressingCommandSerializer
+
+CompressingCommandSerializer::CompressingCommandSerializer(CommandSerializer* serializer)
+    : mImpl(new CommandCompressor(serializer)) {
+    ASSERT(serializer->GetMaximumAllocationSize() > kMaxRecordOverhead);
+}
+
+CompressingCommandSerializer::~CompressingCommandSerializer() = default;
+
+void* CompressingCommandSerializer::GetCmdSpace(size_t size) {
+    return mImpl->GetCmdSpace(size);
+}
+
+bool CompressingCommandSerializer::Flush() {
+    return mImpl->Flush();
+}
+
+size_t CompressingCommandSerializer::GetMaximumAllocationSize() const {
+    return mImpl->GetMaximumAllocationSize();
+}
+
+void CompressingCommandSerializer::OnSerializeError() {
+    mImpl->OnSerializeError();
+}
+
+// DecompressingCommandHandler
+
+DecompressingCommandHandler::DecompressingCommandHandler(CommandHandler* handler)
+    : mImpl(new CommandDecompressor(handler)) {}
+
+DecompressingCommandHandler::~DecompressingCommandHandler() = default;
+
+const volatile char* DecompressingCommandHandler::HandleCommands(const volatile char* commands,
+                                                                 size_t size) {
+    return mImpl->HandleCommands(commands, size);
+}
+
+}  // namespace dawn::wire
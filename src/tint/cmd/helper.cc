@@ -119,7 +119,8 @@ ProgramInfo LoadProgramInfo(const LoadProgramOptions& opts) {
             }
             source_file = std::make_unique<tint::Source::File>(
                 opts.filename, std::string(data.begin(), data.end()));
-            program = std::make_unique<tint::Program>(tint::wgsl::reader::Parse(source_file.get()));
+            program = std::make_unique<tint::Program>(
+                tint::wgsl::reader::Parse(source_file.get(), opts.wgsl_reader_options));
             break;
 #else
             std::cerr << "Tint not built with the WGSL reader enabled" << std::endl;
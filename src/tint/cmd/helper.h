@@ -53,6 +53,10 @@ void PrintInspectorBindings(tint::inspector::Inspector& inspector);
 struct LoadProgramOptions {
     /// The file to be loaded
     std::string filename;
+#if TINT_BUILD_WGSL_READER
+    /// WGSL-reader options
+    tint::wgsl::reader::Options wgsl_reader_options;
+#endif
 #if TINT_BUILD_SPV_READER
     /// Spirv-reader options
     tint::spirv::reader::Options spirv_reader_options;
@@ -122,6 +122,8 @@ struct Options {
     bool emit_single_entry_point = false;
     std::string ep_name;
 
+    std::optional<uint32_t> jobs;
+
     bool rename_all = false;
 
 #if TINT_BUILD_SPV_READER
@@ -139,11 +141,17 @@ struct Options {
 #if TINT_BUILD_IR
     bool dump_ir = false;
     bool use_ir = false;
+    bool optimize_ir = false;
+    bool inline_functions = false;
 #endif  // TINT_BUILD_IR
 
 #if TINT_BUILD_SYNTAX_TREE_WRITER
     bool dump_ast = false;
 #endif  // TINT_BUILD_SYNTAX_TREE_WRITER
+
+    // If not null, the generated output is appended to this buffer instead of being written to
+    // the output file.
+    std::string* output_buffer = nullptr;
 };
 
 /// @param filename the filename to inspect
@@ -218,6 +226,14 @@ If not provided, will be inferred from output filename extension:
         }
     });
 
+    auto& jobs = options.Add<ValueOption<uint32_t>>(
+        "jobs", R"(Number of threads used to parse WGSL and generate the entry points.
+When specified without --entry-point, each entry point is
+generated separately, and written to <name>.<entry point>.<ext>
+when an output file name is provided. 0 uses all hardware threads)",
+        ShortName{"j"}, Parameter{"count"});
+    TINT_DEFER(opts->jobs = jobs.value);
+
     auto& output = options.Add<StringOption>("output-name", "Output file name", ShortName{"o"},
                                              Parameter{"name"});
     TINT_DEFER(opts->output_file = output.value.value_or(""));
@@ -253,6 +269,14 @@ When specified, automatically enables MSL validation)",
     auto& use_ir = options.Add<BoolOption>(
         "use-ir", "Use the IR for writers and transforms when possible", Default{false});
     TINT_DEFER(opts->use_ir = *use_ir.value);
+
+    auto& optimize_ir = options.Add<BoolOption>(
+        "optimize-ir", "Run the IR optimization passes when using the IR", Default{false});
+    TINT_DEFER(opts->optimize_ir = *optimize_ir.value);
+
+    auto& inline_functions = options.Add<BoolOption>(
+        "inline-functions", "Inline calls to small functions when using the IR", Default{false});
+    TINT_DEFER(opts->inline_functions = *inline_functions.value);
 #endif  // TINT_BUILD_IR
 
     auto& verbose =
@@ -457,6 +481,19 @@ bool WriteFile(const std::string& output_file, const std::string mode, const Con
     return true;
 }
 
+/// Writes the given `buffer` to the output of the program generated with `options`. The output is
+/// either `options.output_buffer`, if set, or the file named as `options.output_file`.
+/// @returns true on success
+template <typename ContainerT>
+bool WriteOutput(const Options& options, const std::string mode, const ContainerT& buffer) {
+    if (options.output_buffer) {
+        options.output_buffer->append(reinterpret_cast<const char*>(buffer.data()),
+                                      buffer.size() * sizeof(typename ContainerT::value_type));
+        return true;
+    }
+    return WriteFile(options.output_file, mode, buffer);
+}
+
 #if TINT_BUILD_SPV_WRITER
 std::string Disassemble(const std::vector<uint32_t>& data) {
     std::string spv_errors;
@@ -511,6 +548,8 @@ bool GenerateSpirv(const tint::Program* program, const Options& options) {
         tint::cmd::GenerateExternalTextureBindings(program);
 #if TINT_BUILD_IR
     gen_options.use_tint_ir = options.use_ir;
+    gen_options.optimize_ir = options.optimize_ir;
+    gen_options.inline_functions = options.inline_functions;
 #endif
     auto result = tint::spirv::writer::Generate(program, gen_options);
     if (!result) {
@@ -520,11 +559,11 @@ bool GenerateSpirv(const tint::Program* program, const Options& options) {
     }
 
     if (options.format == Format::kSpvAsm) {
-        if (!WriteFile(options.output_file, "w", Disassemble(result.Get().spirv))) {
+        if (!WriteOutput(options, "w", Disassemble(result.Get().spirv))) {
             return false;
         }
     } else {
-        if (!WriteFile(options.output_file, "wb", result.Get().spirv)) {
+        if (!WriteOutput(options, "wb", result.Get().spirv)) {
             return false;
         }
     }
@@ -570,7 +609,7 @@ bool GenerateWgsl(const tint::Program* program, const Options& options) {
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->wgsl)) {
+    if (!WriteOutput(options, "w", result->wgsl)) {
         return false;
     }
 
@@ -635,7 +674,7 @@ bool GenerateMsl(const tint::Program* program, const Options& options) {
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->msl)) {
+    if (!WriteOutput(options, "w", result->msl)) {
         return false;
     }
 
@@ -698,7 +737,7 @@ bool GenerateHlsl(const tint::Program* program, const Options& options) {
         return false;
     }
 
-    if (!WriteFile(options.output_file, "w", result->hlsl)) {
+    if (!WriteOutput(options, "w", result->hlsl)) {
         return false;
     }
 
@@ -839,7 +878,7 @@ bool GenerateGlsl(const tint::Program* program, const Options& options) {
             return false;
         }
 
-        if (!WriteFile(options.output_file, "w", result->glsl)) {
+        if (!WriteOutput(options, "w", result->glsl)) {
             return false;
         }
 
@@ -890,6 +929,88 @@ bool GenerateGlsl(const tint::Program* program, const Options& options) {
 #endif  // TINT_BUILD_GLSL_WRITER
 }
 
+/// Generate code for a program, in the output format.
+/// @param program the program to generate
+/// @param options the options that Tint was invoked with
+/// @returns true on success
+bool Generate(const tint::Program* program, const Options& options) {
+    switch (options.format) {
+        case Format::kSpirv:
+        case Format::kSpvAsm:
+            return GenerateSpirv(program, options);
+        case Format::kWgsl:
+            return GenerateWgsl(program, options);
+        case Format::kMsl:
+            return GenerateMsl(program, options);
+        case Format::kHlsl:
+            return GenerateHlsl(program, options);
+        case Format::kGlsl:
+            return GenerateGlsl(program, options);
+        case Format::kNone:
+            return false;
+        default:
+            std::cerr << "Unknown output format specified" << std::endl;
+            return false;
+    }
+}
+
+/// @param output_file the output file name
+/// @param entry_point the entry point name
+/// @returns the output file name with `.<entry_point>` inserted before the extension
+std::string EntryPointOutputFile(const std::string& output_file, const std::string& entry_point) {
+    if (output_file.empty() || output_file == "-") {
+        return output_file;
+    }
+    auto dot = output_file.find_last_of('.');
+    auto separator = output_file.find_last_of("/\\");
+    if (dot == std::string::npos || (separator != std::string::npos && dot < separator)) {
+        return output_file + "." + entry_point;
+    }
+    return output_file.substr(0, dot) + "." + entry_point + output_file.substr(dot);
+}
+
+/// Generate code for each entry point of a program separately, using up to `options.jobs`
+/// threads. The outputs are written in entry point order once all the entry points have been
+/// generated.
+/// @param program the program to generate
+/// @param options the options that Tint was invoked with
+/// @returns true on success
+bool GenerateEntryPoints(const tint::Program* program, const Options& options) {
+    tint::inspector::Inspector inspector(program);
+    tint::Vector<std::string, 8> entry_points;
+    for (auto& entry_point : inspector.GetEntryPoints()) {
+        entry_points.Push(entry_point.name);
+    }
+    if (entry_points.IsEmpty()) {
+        return Generate(program, options);
+    }
+
+    std::vector<std::string> outputs(entry_points.Length());
+    std::vector<char> succeeded(entry_points.Length(), false);
+    tint::writer::SplitEntryPoints(
+        *program, entry_points, *options.jobs, [&](size_t i, const tint::Program& single) {
+            if (!single.IsValid()) {
+                std::cerr << single.Diagnostics().str() << std::endl;
+                return;
+            }
+            Options entry_point_options = options;
+            entry_point_options.output_buffer = &outputs[i];
+            succeeded[i] = Generate(&single, entry_point_options);
+        });
+
+    bool success = true;
+    for (size_t i = 0; i < entry_points.Length(); i++) {
+        if (!succeeded[i]) {
+            std::cerr << "Failed to generate entry point '" << entry_points[i] << "'" << std::endl;
+            success = false;
+            continue;
+        }
+        auto output_file = EntryPointOutputFile(options.output_file, entry_points[i]);
+        success &= WriteFile(output_file, "wb", outputs[i]);
+    }
+    return success;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
@@ -1003,6 +1124,9 @@ int main(int argc, const char** argv) {
     {
         tint::cmd::LoadProgramOptions opts;
         opts.filename = options.input_filename;
+#if TINT_BUILD_WGSL_READER
+        opts.wgsl_reader_options.jobs = options.jobs.value_or(1);
+#endif
 #if TINT_BUILD_SPV_READER
         opts.spirv_reader_options = options.spirv_reader_options;
 #endif
@@ -1136,28 +1260,11 @@ int main(int argc, const char** argv) {
     *program = std::move(out);
 
     bool success = false;
-    switch (options.format) {
-        case Format::kSpirv:
-        case Format::kSpvAsm:
-            success = GenerateSpirv(program.get(), options);
-            break;
-        case Format::kWgsl:
-            success = GenerateWgsl(program.get(), options);
-            break;
-        case Format::kMsl:
-            success = GenerateMsl(program.get(), options);
-            break;
-        case Format::kHlsl:
-            success = GenerateHlsl(program.get(), options);
-            break;
-        case Format::kGlsl:
-            success = GenerateGlsl(program.get(), options);
-            break;
-        case Format::kNone:
-            break;
-        default:
-            std::cerr << "Unknown output format specified" << std::endl;
-            return 1;
+    if (options.jobs.has_value() && !options.emit_single_entry_point &&
+        options.format != Format::kNone) {
+        success = GenerateEntryPoints(program.get(), options);
+    } else {
+        success = Generate(program.get(), options);
     }
     if (!success) {
         return 1;
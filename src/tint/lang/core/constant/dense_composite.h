@@ -0,0 +1,197 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_CONSTANT_DENSE_COMPOSITE_H_
+#define SRC_TINT_LANG_CORE_CONSTANT_DENSE_COMPOSITE_H_
+
+#include <utility>
+
+#include "src/tint/lang/core/constant/manager.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/value.h"
+#include "src/tint/lang/core/number.h"
+#include "src/tint/lang/core/type/type.h"
+#include "src/tint/utils/containers/vector.h"
+#include "src/tint/utils/math/hash.h"
+#include "src/tint/utils/rtti/castable.h"
+
+namespace tint::core::constant {
+
+/// DenseCompositeBase is the base class of all DenseComposite<T> specializations.
+/// Used for querying whether a value is a dense composite.
+class DenseCompositeBase : public Castable<DenseCompositeBase, Value> {
+  public:
+    /// The smallest number of elements held by a dense composite. Composites with fewer scalar
+    /// elements are held by a Composite.
+    static constexpr size_t kMinElements = 16;
+
+    /// Constructor
+    /// @param mgr the constant manager that owns this dense composite
+    explicit DenseCompositeBase(Manager& mgr);
+
+    ~DenseCompositeBase() override;
+
+    /// @param other a dense composite with the same TypeInfo as this dense composite
+    /// @returns true if the element values of this dense composite and `other` are equal
+    virtual bool ElementsEqual(const DenseCompositeBase* other) const = 0;
+
+  protected:
+    /// The constant manager that owns this dense composite, and the scalars returned by Index().
+    /// Updated by the manager when it is moved.
+    mutable Manager* mgr_;
+
+  private:
+    friend class Manager;
+};
+
+/// DenseComposite holds the elements of an array, all of the same scalar type, in a flat buffer of
+/// values instead of a list of Scalar pointers. This makes large constant tables a fraction of
+/// the size of a Composite, and lets conversions and clones work on the values directly.
+/// Use Manager::Composite() or Manager::DenseComposite() to create the appropriate type.
+template <typename T>
+class DenseComposite : public Castable<DenseComposite<T>, DenseCompositeBase> {
+  public:
+    static_assert(!std::is_same_v<UnwrapNumber<T>, T> || std::is_same_v<T, bool>,
+                  "T must be a Number or bool");
+
+    /// Constructor
+    /// @param mgr the constant manager that owns this dense composite
+    /// @param t the composite type
+    /// @param el_t the element type
+    /// @param v the element values
+    DenseComposite(Manager& mgr,
+                   const core::type::Type* t,
+                   const core::type::Type* el_t,
+                   Vector<T, 0> v)
+        : Castable<DenseComposite<T>, DenseCompositeBase>(mgr),
+          type(t),
+          el_type(el_t),
+          values(std::move(v)),
+          all_zero(CalcAllZero()),
+          any_zero(CalcAnyZero()),
+          hash(CalcHash()) {
+        TINT_ASSERT(!values.IsEmpty());
+    }
+    ~DenseComposite() override = default;
+
+    /// @copydoc Value::Type()
+    const core::type::Type* Type() const override { return type; }
+
+    /// @copydoc Value::Index()
+    /// @note The element is returned as the Scalar owned by the manager that owns this dense
+    /// composite, which is created on the first request for the element value.
+    const Value* Index(size_t i) const override {
+        return i < values.Length() ? this->mgr_->DenseElement(el_type, values[i]) : nullptr;
+    }
+
+    /// @copydoc DenseCompositeBase::ElementsEqual()
+    bool ElementsEqual(const DenseCompositeBase* other) const override {
+        auto& other_values = static_cast<const DenseComposite*>(other)->values;
+        if (other_values.Length() != values.Length()) {
+            return false;
+        }
+        for (size_t i = 0; i < values.Length(); i++) {
+            if (!(values[i] == other_values[i])) {  // Considers sign bit
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @copydoc Value::NumElements()
+    size_t NumElements() const override { return values.Length(); }
+
+    /// @copydoc Value::AllZero()
+    bool AllZero() const override { return all_zero; }
+
+    /// @copydoc Value::AnyZero()
+    bool AnyZero() const override { return any_zero; }
+
+    /// @copydoc Value::Hash()
+    size_t Hash() const override { return hash; }
+
+    /// Clones the constant into the provided context
+    /// @param ctx the clone context
+    /// @returns the cloned node
+    const DenseComposite* Clone(CloneContext& ctx) const override {
+        auto* ty = type->Clone(ctx.type_ctx);
+        auto* el_ty = el_type->Clone(ctx.type_ctx);
+        return ctx.dst.template Get<DenseComposite<T>>(ctx.dst, ty, el_ty, values);
+    }
+
+    /// The composite type
+    core::type::Type const* const type;
+    /// The element type
+    core::type::Type const* const el_type;
+    /// The element values
+    const Vector<T, 0> values;
+    /// True if all elements are zero
+    const bool all_zero;
+    /// True if any element is zero
+    const bool any_zero;
+    /// The hash of the composite
+    const size_t hash;
+
+  protected:
+    /// @copydoc Value::InternalValue()
+    std::variant<std::monostate, AInt, AFloat> InternalValue() const override { return {}; }
+
+  private:
+    /// @returns the inner value of `v`, as returned by Scalar<T>::ValueOf()
+    static auto ValueOf(T v) {
+        if constexpr (std::is_same_v<UnwrapNumber<T>, T>) {
+            return v;
+        } else {
+            return v.value;
+        }
+    }
+
+    /// @returns true if `v` is a positive zero
+    static bool IsPositiveZero(T v) {
+        using N = UnwrapNumber<T>;
+        return Number<N>(v) == Number<N>(0);  // Considers sign bit
+    }
+
+    bool CalcAllZero() const {
+        for (auto v : values) {
+            if (!IsPositiveZero(v)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CalcAnyZero() const {
+        for (auto v : values) {
+            if (IsPositiveZero(v)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @returns the same hash as a Composite of the Scalar elements, so that equal constants have
+    /// equal hashes regardless of their representation.
+    size_t CalcHash() const {
+        auto h = tint::Hash(type, all_zero, any_zero);
+        for (auto v : values) {
+            h = HashCombine(h, tint::Hash(el_type, ValueOf(v)));
+        }
+        return h;
+    }
+};
+
+}  // namespace tint::core::constant
+
+#endif  // SRC_TINT_LANG_CORE_CONSTANT_DENSE_COMPOSITE_H_
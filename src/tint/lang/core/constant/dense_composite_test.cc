@@ -0,0 +1,157 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/constant/dense_composite.h"
+
+#include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/helper_test.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/splat.h"
+
+namespace tint::core::constant {
+namespace {
+
+using namespace tint::number_suffixes;  // NOLINT
+
+class ConstantTest_DenseComposite : public TestHelper {
+  protected:
+    /// @returns a composite of the array<f32, N> type with the elements `first`, `first + 1`, ...
+    template <size_t N>
+    const Value* Sequence(float first) {
+        Vector<const Value*, N> elements;
+        for (size_t i = 0; i < N; i++) {
+            elements.Push(constants.Get(f32(first + static_cast<float>(i))));
+        }
+        return constants.Composite(constants.types.array<f32, N>(), std::move(elements));
+    }
+};
+
+TEST_F(ConstantTest_DenseComposite, CreatedForLargeArrays) {
+    auto* dense = Sequence<DenseCompositeBase::kMinElements>(0);
+    EXPECT_TRUE(dense->Is<DenseComposite<f32>>());
+
+    auto* small = Sequence<DenseCompositeBase::kMinElements - 1>(0);
+    EXPECT_TRUE(small->Is<Composite>());
+}
+
+TEST_F(ConstantTest_DenseComposite, Unique) {
+    auto* a = Sequence<32>(1);
+    auto* b = Sequence<32>(1);
+    auto* c = Sequence<32>(2);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+}
+
+TEST_F(ConstantTest_DenseComposite, AllZero) {
+    auto* arr = constants.types.array<f32, 16>();
+    Vector<f32, 0> values;
+    values.Resize(16);
+    values[3] = 1_f;
+    auto* any = constants.DenseComposite(arr, constants.types.f32(), values);
+    values[3] = -0_f;
+    auto* neg = constants.DenseComposite(arr, constants.types.f32(), values);
+    values[3] = 0_f;
+    auto* all = constants.DenseComposite(arr, constants.types.f32(), values);
+
+    EXPECT_TRUE(any->Is<DenseComposite<f32>>());
+    EXPECT_FALSE(any->AllZero());
+    EXPECT_TRUE(any->AnyZero());
+
+    EXPECT_TRUE(neg->Is<DenseComposite<f32>>());
+    EXPECT_FALSE(neg->AllZero());
+    EXPECT_TRUE(neg->AnyZero());
+
+    // All the values are equal, so this is a splat.
+    EXPECT_TRUE(all->Is<Splat>());
+    EXPECT_TRUE(all->AllZero());
+}
+
+TEST_F(ConstantTest_DenseComposite, Index) {
+    auto* dense = Sequence<20>(10);
+    ASSERT_TRUE(dense->Is<DenseComposite<f32>>());
+    EXPECT_EQ(dense->NumElements(), 20u);
+    for (size_t i = 0; i < 20; i++) {
+        auto* el = dense->Index(i);
+        ASSERT_NE(el, nullptr);
+        ASSERT_TRUE(el->Is<Scalar<f32>>());
+        EXPECT_EQ(el->ValueAs<f32>(), f32(10.f + static_cast<float>(i)));
+        EXPECT_EQ(el->Type(), constants.types.f32());
+        EXPECT_EQ(el, constants.Get(f32(10.f + static_cast<float>(i))));
+    }
+    EXPECT_EQ(dense->Index(20), nullptr);
+}
+
+TEST_F(ConstantTest_DenseComposite, IndexAfterManagerMove) {
+    constant::Manager mgr;
+    Vector<i32, 0> values;
+    for (int32_t i = 1; i <= 20; i++) {
+        values.Push(i32(i));
+    }
+    auto* dense = mgr.DenseComposite(mgr.types.array<i32, 20>(), mgr.types.i32(), values);
+    ASSERT_TRUE(dense->Is<DenseComposite<i32>>());
+
+    // The elements are owned by the manager that the dense composite was moved to.
+    constant::Manager moved(std::move(mgr));
+    EXPECT_EQ(dense->Index(0), moved.Get(1_i));
+
+    constant::Manager assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(dense->Index(19), assigned.Get(20_i));
+}
+
+TEST_F(ConstantTest_DenseComposite, EqualToComposite) {
+    auto* dense = Sequence<20>(10);
+    ASSERT_TRUE(dense->Is<DenseComposite<f32>>());
+
+    Vector<const Value*, 20> elements;
+    for (size_t i = 0; i < 20; i++) {
+        elements.Push(constants.Get(f32(10.f + static_cast<float>(i))));
+    }
+    Composite composite(dense->Type(), std::move(elements), false, false);
+    EXPECT_EQ(dense->Hash(), composite.Hash());
+    EXPECT_TRUE(dense->Equal(&composite));
+    EXPECT_TRUE(composite.Equal(dense));
+
+    EXPECT_FALSE(dense->Equal(Sequence<20>(11)));
+}
+
+TEST_F(ConstantTest_DenseComposite, CompositeOfIndexedElements) {
+    auto* dense = Sequence<20>(10);
+    Vector<const Value*, 20> elements;
+    for (size_t i = 0; i < 20; i++) {
+        elements.Push(dense->Index(i));
+    }
+    EXPECT_EQ(constants.Composite(dense->Type(), std::move(elements)), dense);
+}
+
+TEST_F(ConstantTest_DenseComposite, Clone) {
+    auto* dense = Sequence<20>(10)->As<DenseComposite<f32>>();
+    ASSERT_NE(dense, nullptr);
+
+    constant::Manager mgr;
+    constant::CloneContext ctx{core::type::CloneContext{{nullptr}, {nullptr, &mgr.types}}, mgr};
+
+    auto* r = dense->Clone(ctx);
+    ASSERT_NE(r, nullptr);
+    EXPECT_TRUE(r->type->Is<core::type::Array>());
+    EXPECT_TRUE(r->el_type->Is<core::type::F32>());
+    EXPECT_FALSE(r->all_zero);
+    EXPECT_FALSE(r->any_zero);
+    ASSERT_EQ(r->values.Length(), 20u);
+    EXPECT_EQ(r->values[19], 29_f);
+    EXPECT_EQ(r->Index(19), mgr.Get(29_f));
+}
+
+}  // namespace
+}  // namespace tint::core::constant
@@ -15,6 +15,8 @@
 #include "src/tint/lang/core/constant/eval.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <optional>
@@ -23,6 +25,7 @@
 #include <utility>
 
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense_composite.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/constant/value.h"
@@ -236,82 +239,121 @@ struct ConvertContext {
     bool use_runtime_semantics;
 };
 
+/// Converts the scalar value `value` of type `FROM` to the type `TO`.
+/// @returns the converted value, or an empty optional on error.
+template <typename TO, typename FROM>
+std::optional<TO> ConvertScalarValue(FROM value,
+                                     const core::type::Type* target_ty,
+                                     ConvertContext& ctx) {
+    TINT_BEGIN_DISABLE_WARNING(UNREACHABLE_CODE);
+    if constexpr (std::is_same_v<TO, bool>) {
+        // [x -> bool]
+        using N = UnwrapNumber<FROM>;
+        return !(Number<N>(value) == Number<N>(0));  // Considers sign bit
+    } else if constexpr (std::is_same_v<FROM, bool>) {
+        // [bool -> x]
+        return TO(value ? 1 : 0);
+    } else if (auto conv = CheckedConvert<TO>(value)) {
+        // Conversion success
+        return conv.Get();
+        // --- Below this point are the failure cases ---
+    } else if constexpr (IsAbstract<FROM>) {
+        // [abstract-numeric -> x] - materialization failure
+        auto msg = OverflowErrorMessage(value, target_ty->FriendlyName());
+        if (ctx.use_runtime_semantics) {
+            ctx.diags.add_warning(tint::diag::System::Resolver, msg, ctx.source);
+            switch (conv.Failure()) {
+                case ConversionFailure::kExceedsNegativeLimit:
+                    return TO::Lowest();
+                case ConversionFailure::kExceedsPositiveLimit:
+                    return TO::Highest();
+            }
+        } else {
+            ctx.diags.add_error(tint::diag::System::Resolver, msg, ctx.source);
+            return std::nullopt;
+        }
+    } else if constexpr (IsFloatingPoint<TO>) {
+        // [x -> floating-point] - number not exactly representable
+        // https://www.w3.org/TR/WGSL/#floating-point-conversion
+        auto msg = OverflowErrorMessage(value, target_ty->FriendlyName());
+        if (ctx.use_runtime_semantics) {
+            ctx.diags.add_warning(tint::diag::System::Resolver, msg, ctx.source);
+            switch (conv.Failure()) {
+                case ConversionFailure::kExceedsNegativeLimit:
+                    return TO::Lowest();
+                case ConversionFailure::kExceedsPositiveLimit:
+                    return TO::Highest();
+            }
+        } else {
+            ctx.diags.add_error(tint::diag::System::Resolver, msg, ctx.source);
+            return std::nullopt;
+        }
+    } else if constexpr (IsFloatingPoint<FROM>) {
+        // [floating-point -> integer] - number not exactly representable
+        // https://www.w3.org/TR/WGSL/#floating-point-conversion
+        switch (conv.Failure()) {
+            case ConversionFailure::kExceedsNegativeLimit:
+                return TO::Lowest();
+            case ConversionFailure::kExceedsPositiveLimit:
+                return TO::Highest();
+        }
+    } else if constexpr (IsIntegral<FROM>) {
+        // [integer -> integer] - number not exactly representable
+        // Static cast
+        return static_cast<TO>(value);
+    }
+    TINT_UNREACHABLE() << "Expression is not constant";
+    return std::nullopt;
+    TINT_END_DISABLE_WARNING(UNREACHABLE_CODE);
+}
+
 /// Converts the constant scalar value to the target type.
 /// @returns the converted scalar, or nullptr on error.
 template <typename T>
 const ScalarBase* ScalarConvert(const Scalar<T>* scalar,
                                 const core::type::Type* target_ty,
                                 ConvertContext& ctx) {
-    TINT_BEGIN_DISABLE_WARNING(UNREACHABLE_CODE);
     if (target_ty == scalar->type) {
         // If the types are identical, then no conversion is needed.
         return scalar;
     }
     return ZeroTypeDispatch(target_ty, [&](auto zero_to) -> const ScalarBase* {
-        // `value` is the source value.
-        // `FROM` is the source type.
-        // `TO` is the target type.
         using TO = std::decay_t<decltype(zero_to)>;
-        using FROM = T;
-        if constexpr (std::is_same_v<TO, bool>) {
-            // [x -> bool]
-            return ctx.mgr.Get<Scalar<TO>>(target_ty, !scalar->IsPositiveZero());
-        } else if constexpr (std::is_same_v<FROM, bool>) {
-            // [bool -> x]
-            return ctx.mgr.Get<Scalar<TO>>(target_ty, TO(scalar->value ? 1 : 0));
-        } else if (auto conv = CheckedConvert<TO>(scalar->value)) {
-            // Conversion success
-            return ctx.mgr.Get<Scalar<TO>>(target_ty, conv.Get());
-            // --- Below this point are the failure cases ---
-        } else if constexpr (IsAbstract<FROM>) {
-            // [abstract-numeric -> x] - materialization failure
-            auto msg = OverflowErrorMessage(scalar->value, target_ty->FriendlyName());
-            if (ctx.use_runtime_semantics) {
-                ctx.diags.add_warning(tint::diag::System::Resolver, msg, ctx.source);
-                switch (conv.Failure()) {
-                    case ConversionFailure::kExceedsNegativeLimit:
-                        return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Lowest());
-                    case ConversionFailure::kExceedsPositiveLimit:
-                        return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Highest());
-                }
-            } else {
-                ctx.diags.add_error(tint::diag::System::Resolver, msg, ctx.source);
-                return nullptr;
-            }
-        } else if constexpr (IsFloatingPoint<TO>) {
-            // [x -> floating-point] - number not exactly representable
-            // https://www.w3.org/TR/WGSL/#floating-point-conversion
-            auto msg = OverflowErrorMessage(scalar->value, target_ty->FriendlyName());
-            if (ctx.use_runtime_semantics) {
-                ctx.diags.add_warning(tint::diag::System::Resolver, msg, ctx.source);
-                switch (conv.Failure()) {
-                    case ConversionFailure::kExceedsNegativeLimit:
-                        return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Lowest());
-                    case ConversionFailure::kExceedsPositiveLimit:
-                        return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Highest());
-                }
-            } else {
-                ctx.diags.add_error(tint::diag::System::Resolver, msg, ctx.source);
+        if (auto conv = ConvertScalarValue<TO>(scalar->value, target_ty, ctx)) {
+            return ctx.mgr.Get<Scalar<TO>>(target_ty, *conv);
+        }
+        return nullptr;
+    });
+}
+
+/// Converts the dense composite to the target type, converting the element values directly
+/// instead of creating a Scalar for each of the source and converted elements.
+/// @returns the converted value, or nullptr on error.
+template <typename T>
+const Value* DenseConvert(const DenseComposite<T>* dense,
+                          const core::type::Type* target_ty,
+                          ConvertContext& ctx) {
+    if (target_ty == dense->type) {
+        // If the types are identical, then no conversion is needed.
+        return dense;
+    }
+    auto* target_el_ty = target_ty->Elements(target_ty).type;
+    return ZeroTypeDispatch(target_el_ty, [&](auto zero_to) -> const Value* {
+        using TO = std::decay_t<decltype(zero_to)>;
+        const size_t count = dense->values.Length();
+        Vector<TO, 0> values;
+        values.Resize(count);
+        // Convert the last element first, matching the order of the diagnostics raised by the
+        // per-element conversion of ConvertInternal().
+        for (size_t i = count; i-- > 0;) {
+            auto conv = ConvertScalarValue<TO>(dense->values[i], target_el_ty, ctx);
+            if (!conv) {
                 return nullptr;
             }
-        } else if constexpr (IsFloatingPoint<FROM>) {
-            // [floating-point -> integer] - number not exactly representable
-            // https://www.w3.org/TR/WGSL/#floating-point-conversion
-            switch (conv.Failure()) {
-                case ConversionFailure::kExceedsNegativeLimit:
-                    return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Lowest());
-                case ConversionFailure::kExceedsPositiveLimit:
-                    return ctx.mgr.Get<Scalar<TO>>(target_ty, TO::Highest());
-            }
-        } else if constexpr (IsIntegral<FROM>) {
-            // [integer -> integer] - number not exactly representable
-            // Static cast
-            return ctx.mgr.Get<Scalar<TO>>(target_ty, static_cast<TO>(scalar->value));
+            values[i] = *conv;
         }
-        TINT_UNREACHABLE() << "Expression is not constant";
-        return nullptr;
+        return ctx.mgr.DenseComposite(target_ty, target_el_ty, std::move(values));
     });
-    TINT_END_DISABLE_WARNING(UNREACHABLE_CODE);
 }
 
 /// Converts the constant value to the target type.
@@ -423,6 +465,36 @@ const Value* ConvertInternal(const Value* root_value,
                 pending.Push(ActionConvert{splat->el, target_el_ty});
                 return true;
             },
+            [&](const DenseCompositeBase* dense) {
+                auto* converted = Switch(
+                    dense,
+                    [&](const DenseComposite<tint::AFloat>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<tint::AInt>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<tint::u32>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<tint::i32>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<tint::f32>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<tint::f16>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    },
+                    [&](const DenseComposite<bool>* val) {
+                        return DenseConvert(val, convert->target_ty, ctx);
+                    });
+                if (!converted) {
+                    return false;
+                }
+                value_stack.Push(converted);
+                return true;
+            },
             [&](const Composite* composite) {
                 const size_t el_count = composite->NumElements();
 
@@ -3806,6 +3878,39 @@ Eval::Result Eval::Convert(const core::type::Type* target_ty,
     return converted ? Result(converted) : tint::Failure;
 }
 
+Eval::Result Eval::Call(Function fn,
+                        const core::type::Type* ty,
+                        VectorRef<const Value*> args,
+                        const Source& source) {
+    CallKey key{fn, ty, args};
+    if (auto cached = calls_.Get(key)) {
+        return *cached;
+    }
+
+    size_t num_diags = diags.count();
+    auto result = (this->*fn)(ty, std::move(args), source);
+    // Only memoize values that were evaluated without raising a diagnostic, as the diagnostics
+    // would not be raised again for a later call.
+    if (result && result.Get() && diags.count() == num_diags) {
+        calls_.Add(std::move(key), result.Get());
+    }
+    return result;
+}
+
+size_t Eval::CallKey::Hasher::operator()(const CallKey& key) const {
+    // Member function pointers cannot be cast to an integer, so hash their bytes.
+    std::array<uint8_t, sizeof(Function)> fn_bytes;
+    memcpy(fn_bytes.data(), &key.fn, sizeof(Function));
+    size_t hash = tint::Hash(key.ty, key.args.Length());
+    for (auto byte : fn_bytes) {
+        hash = HashCombine(hash, byte);
+    }
+    for (auto* arg : key.args) {
+        hash = HashCombine(hash, arg);
+    }
+    return hash;
+}
+
 void Eval::AddError(const std::string& msg, const Source& source) const {
     if (use_runtime_semantics_) {
         diags.add_warning(diag::System::Constant, msg, source);
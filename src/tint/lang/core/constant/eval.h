@@ -21,6 +21,7 @@
 
 #include "src/tint/lang/core/number.h"
 #include "src/tint/lang/core/type/type.h"
+#include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/result/result.h"
 
@@ -103,6 +104,19 @@ class Eval {
     /// @return the converted value, or null if the value cannot be calculated
     Result Convert(const core::type::Type* ty, const Value* value, const Source& source);
 
+    /// Calls the constant evaluation function `fn`. If `fn` has already been called with the same
+    /// result type and arguments, and that call produced a value without raising any diagnostics,
+    /// then the value of the earlier call is returned without calling `fn` again.
+    /// @param fn the constant evaluation function
+    /// @param ty the result type
+    /// @param args the input arguments
+    /// @param source the source location
+    /// @return the result of calling `fn`
+    Result Call(Function fn,
+                const core::type::Type* ty,
+                VectorRef<const Value*> args,
+                const Source& source);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Constant value evaluation methods, to be indirectly called via the intrinsic table
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1266,9 +1280,33 @@ class Eval {
     Result Sub(const Source& source, const core::type::Type* ty, const Value* v1, const Value* v2);
 
   private:
+    /// The key of a memoized Call()
+    struct CallKey {
+        /// The constant evaluation function
+        Function fn;
+        /// The result type
+        const core::type::Type* ty;
+        /// The input arguments
+        Vector<const Value*, 4> args;
+
+        /// @param other the key to compare against
+        /// @returns true if this key is equal to `other`
+        bool operator==(const CallKey& other) const {
+            return fn == other.fn && ty == other.ty && args == other.args;
+        }
+
+        /// The hasher of CallKey
+        struct Hasher {
+            /// @param key the key to hash
+            /// @returns the hash of `key`
+            size_t operator()(const CallKey& key) const;
+        };
+    };
+
     Manager& mgr;
     diag::List& diags;
     bool use_runtime_semantics_ = false;
+    Hashmap<CallKey, const Value*, 8, CallKey::Hasher> calls_;
 };
 
 }  // namespace tint::core::constant
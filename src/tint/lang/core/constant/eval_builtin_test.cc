@@ -14,6 +14,9 @@
 
 #include "src/tint/lang/core/constant/eval_test.h"
 
+#include <cmath>
+
+#include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/utils/result/result.h"
 
 using namespace tint::number_suffixes;  // NOLINT
@@ -2888,5 +2891,32 @@ INSTANTIATE_TEST_SUITE_P(  //
     testing::Combine(testing::Values(core::Function::kQuantizeToF16),
                      testing::ValuesIn(QuantizeToF16Cases())));
 
+TEST_F(ConstEvalTest, Call_Memoized) {
+    Eval eval(constants, Diagnostics());
+    auto* a = constants.Get(1_f);
+    auto* b = constants.Get(2_f);
+    auto r1 = eval.Call(&Eval::atan2, a->Type(), Vector{a, b}, {});
+    auto r2 = eval.Call(&Eval::atan2, a->Type(), Vector{a, b}, {});
+    auto r3 = eval.Call(&Eval::atan2, a->Type(), Vector{b, a}, {});
+    ASSERT_TRUE(r1);
+    ASSERT_TRUE(r2);
+    ASSERT_TRUE(r3);
+    EXPECT_EQ(r1.Get(), r2.Get());
+    EXPECT_NE(r1.Get(), r3.Get());
+    EXPECT_FLOAT_EQ(r1.Get()->ValueAs<f32>(), std::atan2(1.f, 2.f));
+    EXPECT_FLOAT_EQ(r3.Get()->ValueAs<f32>(), std::atan2(2.f, 1.f));
+}
+
+TEST_F(ConstEvalTest, Call_ErrorNotMemoized) {
+    Eval eval(constants, Diagnostics());
+    auto* a = constants.Get(AInt::Highest());
+    auto* b = constants.Get(AInt(1));
+    EXPECT_FALSE(eval.Call(&Eval::Plus, a->Type(), Vector{a, b}, Source{{12, 34}}));
+    EXPECT_FALSE(eval.Call(&Eval::Plus, a->Type(), Vector{a, b}, Source{{56, 78}}));
+    EXPECT_EQ(Diagnostics().str(),
+              R"(12:34 error: '9223372036854775807 + 1' cannot be represented as 'abstract-int'
+56:78 error: '9223372036854775807 + 1' cannot be represented as 'abstract-int')");
+}
+
 }  // namespace
 }  // namespace tint::core::constant::test
@@ -14,6 +14,8 @@
 
 #include "src/tint/lang/core/constant/eval_test.h"
 
+#include "src/tint/lang/core/constant/dense_composite.h"
+
 namespace tint::core::constant::test {
 namespace {
 
@@ -1624,6 +1626,51 @@ TEST_F(ConstEvalTest, Array_f32_Elements) {
     EXPECT_EQ(sem->ConstantValue()->Index(3)->ValueAs<f32>(), 40_f);
 }
 
+TEST_F(ConstEvalTest, Array_Large_f32_Elements) {
+    Vector<const ast::Expression*, 32> args;
+    for (size_t i = 0; i < 32; i++) {
+        args.Push(Expr(f32(static_cast<float>(i) * 2.f)));
+    }
+    auto* expr = Call<array<f32, 32>>(std::move(args));
+    WrapInFunction(expr);
+
+    EXPECT_TRUE(r()->Resolve()) << r()->error();
+
+    auto* sem = Sem().Get(expr);
+    ASSERT_NE(sem, nullptr);
+    EXPECT_TYPE(sem->ConstantValue()->Type(), sem->Type());
+    // Arrays of many scalars are held by a DenseComposite.
+    auto* dense = sem->ConstantValue()->As<DenseComposite<f32>>();
+    ASSERT_NE(dense, nullptr);
+    EXPECT_TRUE(dense->AnyZero());
+    EXPECT_FALSE(dense->AllZero());
+    ASSERT_EQ(dense->NumElements(), 32u);
+    for (size_t i = 0; i < 32; i++) {
+        EXPECT_EQ(dense->Index(i)->ValueAs<f32>(), f32(static_cast<float>(i) * 2.f));
+    }
+}
+
+TEST_F(ConstEvalTest, Array_Large_AbstractFloat_Materialized) {
+    Vector<const ast::Expression*, 32> args;
+    for (size_t i = 0; i < 32; i++) {
+        args.Push(Expr(AFloat(static_cast<double>(i) + 0.5)));
+    }
+    GlobalConst("a", Call("array", std::move(args)));
+    auto* expr = Expr("a");
+    WrapInFunction(Var("v", ty.array<f32, 32>(), expr));
+
+    EXPECT_TRUE(r()->Resolve()) << r()->error();
+
+    auto* sem = Sem().GetVal(expr);
+    ASSERT_NE(sem, nullptr);
+    auto* dense = sem->ConstantValue()->As<DenseComposite<f32>>();
+    ASSERT_NE(dense, nullptr);
+    ASSERT_EQ(dense->values.Length(), 32u);
+    for (size_t i = 0; i < 32; i++) {
+        EXPECT_EQ(dense->values[i], f32(static_cast<float>(i) + 0.5f));
+    }
+}
+
 TEST_F(ConstEvalTest, Array_vec3_f32_Elements) {
     auto* expr =
         Call<array<vec3<f32>, 2>>(Call<vec3<f32>>(1_f, 2_f, 3_f), Call<vec3<f32>>(4_f, 5_f, 6_f));
@@ -14,6 +14,8 @@
 
 #include "src/tint/lang/core/constant/eval_test.h"
 
+#include "src/tint/lang/core/constant/scalar.h"
+
 namespace tint::core::constant::test {
 namespace {
 
@@ -276,6 +278,36 @@ TEST_F(ConstEvalTest, Array_vec3_f32_Index_OOB_Low) {
     EXPECT_EQ(r()->error(), "12:34 error: index -2 out of bounds [0..1]");
 }
 
+TEST_F(ConstEvalTest, Array_Large_i32_Index) {
+    Vector<const ast::Expression*, 64> args;
+    for (int32_t i = 0; i < 64; i++) {
+        args.Push(Expr(i32(i * 3)));
+    }
+    GlobalConst("a", Call<array<i32, 64>>(std::move(args)));
+    auto* expr = IndexAccessor("a", 21_i);
+    WrapInFunction(expr);
+
+    EXPECT_TRUE(r()->Resolve()) << r()->error();
+
+    auto* sem = Sem().Get(expr);
+    ASSERT_NE(sem, nullptr);
+    EXPECT_TRUE(sem->Type()->Is<core::type::I32>());
+    EXPECT_EQ(sem->ConstantValue(), static_cast<const constant::Value*>(constants.Get(63_i)));
+}
+
+TEST_F(ConstEvalTest, Array_Large_i32_Index_OOB_High) {
+    Vector<const ast::Expression*, 64> args;
+    for (int32_t i = 0; i < 64; i++) {
+        args.Push(Expr(i32(i * 3)));
+    }
+    GlobalConst("a", Call<array<i32, 64>>(std::move(args)));
+    auto* expr = IndexAccessor("a", Expr(Source{{12, 34}}, 64_i));
+    WrapInFunction(expr);
+
+    EXPECT_FALSE(r()->Resolve()) << r()->error();
+    EXPECT_EQ(r()->error(), "12:34 error: index 64 out of bounds [0..63]");
+}
+
 TEST_F(ConstEvalTest, RuntimeArray_vec3_f32_Index_OOB_Low) {
     auto* sb = GlobalVar("sb", ty.array<vec3<f32>>(), Group(0_a), Binding(0_a),
                          core::AddressSpace::kStorage);
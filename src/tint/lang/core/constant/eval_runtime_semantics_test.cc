@@ -573,5 +573,19 @@ TEST_F(ConstEvalRuntimeSemanticsTest, Vec_Overflow_SingleComponent) {
     EXPECT_EQ(error(), R"(warning: sqrt must be called with a value >= 0)");
 }
 
+TEST_F(ConstEvalRuntimeSemanticsTest, Call_WarningNotMemoized) {
+    auto* a = constants.Get(AInt::Highest());
+    auto* b = constants.Get(AInt(1));
+    auto r1 = eval.Call(&Eval::Plus, a->Type(), Vector{a, b}, {});
+    auto r2 = eval.Call(&Eval::Plus, a->Type(), Vector{a, b}, {});
+    ASSERT_TRUE(r1);
+    ASSERT_TRUE(r2);
+    EXPECT_EQ(r1.Get(), r2.Get());
+    // The warning is raised by each call.
+    EXPECT_EQ(error(),
+              R"(warning: '9223372036854775807 + 1' cannot be represented as 'abstract-int'
+warning: '9223372036854775807 + 1' cannot be represented as 'abstract-int')");
+}
+
 }  // namespace
 }  // namespace tint::core::constant::test
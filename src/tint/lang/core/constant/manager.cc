@@ -15,6 +15,7 @@
 #include "src/tint/lang/core/constant/manager.h"
 
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense_composite.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/type/abstract_float.h"
@@ -26,14 +27,44 @@
 #include "src/tint/lang/core/type/manager.h"
 #include "src/tint/lang/core/type/u32.h"
 #include "src/tint/utils/containers/predicates.h"
+#include "src/tint/utils/rtti/switch.h"
 
 namespace tint::core::constant {
+namespace {
+
+/// @returns a DenseComposite holding the values of `elements`, if they are all Scalar<T>s of the
+/// same type, otherwise nullptr.
+template <typename T>
+const Value* DenseCompositeOf(Manager& mgr,
+                              const core::type::Type* type,
+                              VectorRef<const Value*> elements) {
+    auto* el_type = elements.Front()->Type();
+    Vector<T, 0> values;
+    values.Reserve(elements.Length());
+    for (auto* el : elements) {
+        auto* scalar = el->As<Scalar<T>>();
+        if (!scalar || scalar->type != el_type) {
+            return nullptr;
+        }
+        values.Push(scalar->value);
+    }
+    return mgr.Get<DenseComposite<T>>(mgr, type, el_type, std::move(values));
+}
+
+}  // namespace
 
 Manager::Manager() = default;
 
-Manager::Manager(Manager&&) = default;
+Manager::Manager(Manager&& rhs) : types(std::move(rhs.types)), values_(std::move(rhs.values_)) {
+    AdoptDenseComposites();
+}
 
-Manager& Manager::operator=(Manager&& rhs) = default;
+Manager& Manager::operator=(Manager&& rhs) {
+    types = std::move(rhs.types);
+    values_ = std::move(rhs.values_);
+    AdoptDenseComposites();
+    return *this;
+}
 
 Manager::~Manager() = default;
 
@@ -65,9 +96,105 @@ const constant::Value* Manager::Composite(const core::type::Type* type,
         return Splat(type, elements.Front(), elements.Length());
     }
 
+    if (elements.Length() >= DenseCompositeBase::kMinElements) {
+        auto* dense = Switch(
+            first,  //
+            [&](const Scalar<AInt>*) { return DenseCompositeOf<AInt>(*this, type, elements); },
+            [&](const Scalar<AFloat>*) { return DenseCompositeOf<AFloat>(*this, type, elements); },
+            [&](const Scalar<i32>*) { return DenseCompositeOf<i32>(*this, type, elements); },
+            [&](const Scalar<u32>*) { return DenseCompositeOf<u32>(*this, type, elements); },
+            [&](const Scalar<f32>*) { return DenseCompositeOf<f32>(*this, type, elements); },
+            [&](const Scalar<f16>*) { return DenseCompositeOf<f16>(*this, type, elements); },
+            [&](const Scalar<bool>*) { return DenseCompositeOf<bool>(*this, type, elements); });
+        if (dense) {
+            return dense;
+        }
+    }
+
     return Get<constant::Composite>(type, std::move(elements), all_zero, any_zero);
 }
 
+template <typename T>
+const constant::Value* Manager::DenseComposite(const core::type::Type* type,
+                                               const core::type::Type* el_type,
+                                               Vector<T, 0> values) {
+    if (values.IsEmpty()) {
+        return nullptr;
+    }
+
+    bool all_equal = true;
+    for (auto v : values) {
+        if (!(v == values.Front())) {  // Considers sign bit
+            all_equal = false;
+            break;
+        }
+    }
+    if (all_equal) {
+        return Splat(type, Get<Scalar<T>>(el_type, values.Front()), values.Length());
+    }
+
+    if (values.Length() < DenseCompositeBase::kMinElements) {
+        Vector<const constant::Value*, DenseCompositeBase::kMinElements> elements;
+        bool all_zero = true;
+        bool any_zero = false;
+        for (auto v : values) {
+            auto* el = Get<Scalar<T>>(el_type, v);
+            all_zero = all_zero && el->AllZero();
+            any_zero = any_zero || el->AnyZero();
+            elements.Push(el);
+        }
+        return Get<constant::Composite>(type, std::move(elements), all_zero, any_zero);
+    }
+
+    return Get<constant::DenseComposite<T>>(*this, type, el_type, std::move(values));
+}
+
+// Explicit instantiations of Manager::DenseComposite() for each of the scalar types
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<AInt, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<AFloat, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<i32, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<u32, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<f32, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<f16, 0>);
+template const constant::Value* Manager::DenseComposite(const core::type::Type*,
+                                                        const core::type::Type*,
+                                                        Vector<bool, 0>);
+
+template <typename T>
+const Scalar<T>* Manager::DenseElement(const core::type::Type* el_type, T value) {
+    std::lock_guard<std::mutex> lock(dense_elements_mutex_);
+    return Get<Scalar<T>>(el_type, value);
+}
+
+// Explicit instantiations of Manager::DenseElement() for each of the scalar types
+template const Scalar<AInt>* Manager::DenseElement(const core::type::Type*, AInt);
+template const Scalar<AFloat>* Manager::DenseElement(const core::type::Type*, AFloat);
+template const Scalar<i32>* Manager::DenseElement(const core::type::Type*, i32);
+template const Scalar<u32>* Manager::DenseElement(const core::type::Type*, u32);
+template const Scalar<f32>* Manager::DenseElement(const core::type::Type*, f32);
+template const Scalar<f16>* Manager::DenseElement(const core::type::Type*, f16);
+template const Scalar<bool>* Manager::DenseElement(const core::type::Type*, bool);
+
+void Manager::AdoptDenseComposites() {
+    for (auto* value : values_) {
+        if (auto* dense = value->As<DenseCompositeBase>()) {
+            dense->mgr_ = this;
+        }
+    }
+}
+
 const constant::Splat* Manager::Splat(const core::type::Type* type,
                                       const constant::Value* element,
                                       size_t n) {
@@ -102,4 +229,14 @@ const Scalar<AInt>* Manager::Get(AInt value) {
     return Get<Scalar<AInt>>(types.AInt(), value);
 }
 
+bool Manager::Equal::operator()(const constant::Value& a, const constant::Value& b) const {
+    // A DenseComposite is equal to a Composite of the same elements, but the unique allocator
+    // returns the existing value cast to the type being created, so they must not be interchanged.
+    if (&a.TypeInfo() != &b.TypeInfo() &&
+        (a.Is<DenseCompositeBase>() || b.Is<DenseCompositeBase>())) {
+        return false;
+    }
+    return a.Equal(&b);
+}
+
 }  // namespace tint::core::constant
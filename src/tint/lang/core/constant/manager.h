@@ -15,17 +15,21 @@
 #ifndef SRC_TINT_LANG_CORE_CONSTANT_MANAGER_H_
 #define SRC_TINT_LANG_CORE_CONSTANT_MANAGER_H_
 
+#include <mutex>
 #include <utility>
 
 #include "src/tint/lang/core/constant/value.h"
 #include "src/tint/lang/core/number.h"
 #include "src/tint/lang/core/type/manager.h"
 #include "src/tint/utils/containers/unique_allocator.h"
+#include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/math/hash.h"
 
 namespace tint::core::constant {
 class Splat;
 
+template <typename T>
+class DenseComposite;
 template <typename T>
 class Scalar;
 }  // namespace tint::core::constant
@@ -62,6 +66,7 @@ class Manager final {
     /// @return the Manager that wraps `inner`
     static Manager Wrap(const Manager& inner) {
         Manager out;
+        std::lock_guard<std::mutex> lock(inner.dense_elements_mutex_);
         out.values_.Wrap(inner.values_);
         out.types = core::type::Manager::Wrap(inner.types);
         return out;
@@ -83,8 +88,8 @@ class Manager final {
 
     /// Constructs a constant of a vector, matrix or array type.
     ///
-    /// Examines the element values and will return either a constant::Composite or a
-    /// constant::Splat, depending on the element types and values.
+    /// Examines the element values and will return either a constant::Composite, a
+    /// constant::DenseComposite or a constant::Splat, depending on the element types and values.
     ///
     /// @param type the composite type
     /// @param elements the composite elements
@@ -92,6 +97,20 @@ class Manager final {
     const constant::Value* Composite(const core::type::Type* type,
                                      VectorRef<const constant::Value*> elements);
 
+    /// Constructs a constant of an array type from the values of its scalar elements.
+    ///
+    /// Returns a constant::Splat if all the values are equal, a constant::DenseComposite if there
+    /// are at least DenseCompositeBase::kMinElements values, otherwise a constant::Composite.
+    ///
+    /// @param type the array type
+    /// @param el_type the element type
+    /// @param values the element values
+    /// @returns the value pointer
+    template <typename T>
+    const constant::Value* DenseComposite(const core::type::Type* type,
+                                          const core::type::Type* el_type,
+                                          Vector<T, 0> values);
+
     /// Constructs a splat constant.
     /// @param type the splat type
     /// @param element the splat element
@@ -133,6 +152,21 @@ class Manager final {
     core::type::Manager types;
 
   private:
+    template <typename T>
+    friend class constant::DenseComposite;
+
+    /// Points the dense composites owned by this manager back at this manager, after a move.
+    void AdoptDenseComposites();
+
+    /// Constructs the element of a dense composite owned by this manager, as returned by
+    /// DenseComposite::Index(). Unlike Get(), DenseElement() may be called concurrently for the
+    /// dense composites of an immutable manager.
+    /// @param el_type the element type
+    /// @param value the element value
+    /// @returns the Scalar holding `value`
+    template <typename T>
+    const Scalar<T>* DenseElement(const core::type::Type* el_type, T value);
+
     /// A specialization of Hasher for constant::Value
     struct Hasher {
         /// @param value the value to hash
@@ -144,14 +178,15 @@ class Manager final {
     struct Equal {
         /// @param a the LHS value
         /// @param b the RHS value
-        /// @returns true if the two constants are equal
-        bool operator()(const constant::Value& a, const constant::Value& b) const {
-            return a.Equal(&b);
-        }
+        /// @returns true if the two constants are equal and can be used in place of each other
+        bool operator()(const constant::Value& a, const constant::Value& b) const;
     };
 
     /// Unique types owned by the manager
     UniqueAllocator<Value, Hasher, Equal> values_;
+
+    /// Guards the scalars created by DenseElement()
+    mutable std::mutex dense_elements_mutex_;
 };
 
 }  // namespace tint::core::constant
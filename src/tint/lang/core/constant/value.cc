@@ -14,6 +14,7 @@
 
 #include "src/tint/lang/core/constant/value.h"
 
+#include "src/tint/lang/core/constant/dense_composite.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/type/array.h"
 #include "src/tint/lang/core/type/matrix.h"
@@ -46,6 +47,13 @@ bool Value::Equal(const constant::Value* b) const {
             return true;
         }
 
+        // Compare the values of dense composites directly, without materializing their elements
+        if (&TypeInfo() == &b->TypeInfo()) {
+            if (auto* dense = As<DenseCompositeBase>()) {
+                return dense->ElementsEqual(b->As<DenseCompositeBase>());
+            }
+        }
+
         // Avoid per-element comparisons if the constants are splats
         bool a_is_splat = Is<Splat>();
         bool b_is_splat = b->Is<Splat>();
@@ -0,0 +1,927 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/binary/decode.h"
+
+#include <string_view>
+#include <utility>
+
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/binary/format.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/block_param.h"
+#include "src/tint/lang/core/ir/break_if.h"
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/discard.h"
+#include "src/tint/lang/core/ir/exit_if.h"
+#include "src/tint/lang/core/ir/exit_loop.h"
+#include "src/tint/lang/core/ir/exit_switch.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/instruction_result.h"
+#include "src/tint/lang/core/ir/intrinsic_call.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/next_iteration.h"
+#include "src/tint/lang/core/ir/return.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/switch.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/terminate_invocation.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/unreachable.h"
+#include "src/tint/lang/core/ir/user_call.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/abstract_float.h"
+#include "src/tint/lang/core/type/abstract_int.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/bool.h"
+#include "src/tint/lang/core/type/depth_multisampled_texture.h"
+#include "src/tint/lang/core/type/depth_texture.h"
+#include "src/tint/lang/core/type/external_texture.h"
+#include "src/tint/lang/core/type/f16.h"
+#include "src/tint/lang/core/type/f32.h"
+#include "src/tint/lang/core/type/i32.h"
+#include "src/tint/lang/core/type/matrix.h"
+#include "src/tint/lang/core/type/multisampled_texture.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+#include "src/tint/lang/core/type/sampler.h"
+#include "src/tint/lang/core/type/storage_texture.h"
+#include "src/tint/lang/core/type/struct.h"
+#include "src/tint/lang/core/type/u32.h"
+#include "src/tint/lang/core/type/vector.h"
+#include "src/tint/utils/memory/bitcast.h"
+
+namespace tint::ir::binary {
+namespace {
+
+/// The state used to decode a single module.
+///
+/// Every read is bounds checked. Once an error is raised, all further reads return zero values
+/// and the decoder unwinds by checking Failed() at the top of each loop.
+class Decoder {
+  public:
+    explicit Decoder(Slice<const uint8_t> data) : data_(data), b_(mod_) {}
+
+    tint::Result<Module, std::string> Run() {
+        for (uint8_t c : kMagic) {
+            if (U8() != c) {
+                return std::string("invalid magic number");
+            }
+        }
+        if (Varint() != kVersion) {
+            return std::string("unsupported version");
+        }
+
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            types_.Push(DecodeType());
+        }
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            constants_.Push(DecodeConstant());
+        }
+
+        // The functions are the first values, and are followed by their parameters.
+        auto num_functions = Count();
+        values_.Resize(num_functions);
+        for (uint64_t i = 0; i < num_functions && !Failed(); i++) {
+            values_[i] = DecodeFunction();
+        }
+
+        if (Bool()) {
+            DecodeBlock(b_.RootBlock());
+        }
+        for (auto* func : mod_.functions) {
+            DecodeBlock(func->Block());
+        }
+
+        if (!Failed() && offset_ != data_.Length()) {
+            Error("unexpected data after the module");
+        }
+        if (Failed()) {
+            return error_;
+        }
+        return std::move(mod_);
+    }
+
+  private:
+    bool Failed() const { return !error_.empty(); }
+
+    void Error(std::string msg) {
+        if (error_.empty()) {
+            error_ = std::move(msg);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Primitive reads
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    uint8_t U8() {
+        if (offset_ >= data_.Length()) {
+            Error("unexpected end of data");
+            return 0;
+        }
+        return data_[offset_++];
+    }
+
+    bool Bool() { return U8() != 0; }
+
+    uint64_t Varint() {
+        uint64_t v = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = U8();
+            v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return v;
+            }
+        }
+        Error("invalid varint");
+        return 0;
+    }
+
+    int64_t SignedVarint() {
+        uint64_t v = Varint();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    uint32_t U32() {
+        uint64_t v = Varint();
+        if (v > 0xffffffffu) {
+            Error("value out of range");
+            return 0;
+        }
+        return static_cast<uint32_t>(v);
+    }
+
+    /// Reads an element count, which cannot exceed the number of remaining bytes as every element
+    /// is at least one byte long.
+    uint64_t Count() {
+        uint64_t n = Varint();
+        if (n > data_.Length() - offset_) {
+            Error("invalid element count");
+            return 0;
+        }
+        return n;
+    }
+
+    template <typename T>
+    T Fixed() {
+        uint64_t v = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            v |= static_cast<uint64_t>(U8()) << (i * 8);
+        }
+        return static_cast<T>(v);
+    }
+
+    /// Reads an enum value, which must not be greater than @p last.
+    template <typename E>
+    E Enum(E last) {
+        uint64_t v = Varint();
+        if (v > static_cast<uint64_t>(last)) {
+            Error("enum value out of range");
+            return static_cast<E>(0);
+        }
+        return static_cast<E>(v);
+    }
+
+    std::string_view String() {
+        auto len = Count();
+        if (Failed()) {
+            return {};
+        }
+        std::string_view str(reinterpret_cast<const char*>(data_.data + offset_), len);
+        offset_ += len;
+        return str;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Types and constants
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const core::type::Type* TypeAt(uint64_t id) {
+        if (id >= types_.Length() || !types_[id]) {
+            Error("invalid type id");
+            return mod_.Types().void_();
+        }
+        return types_[id];
+    }
+
+    const core::type::Type* Type() { return TypeAt(Varint()); }
+
+    core::Interpolation Interpolation() {
+        core::Interpolation interp;
+        interp.type = Enum(core::InterpolationType::kPerspective);
+        interp.sampling = Enum(core::InterpolationSampling::kSample);
+        return interp;
+    }
+
+    const core::type::Type* DecodeType() {
+        auto& ty = mod_.Types();
+        auto dim = [&] { return Enum(core::type::TextureDimension::kNone); };
+        auto kind = Enum(TypeKind::kStorageTexture);
+        switch (kind) {
+            case TypeKind::kVoid:
+                return ty.void_();
+            case TypeKind::kBool:
+                return ty.bool_();
+            case TypeKind::kI32:
+                return ty.i32();
+            case TypeKind::kU32:
+                return ty.u32();
+            case TypeKind::kF32:
+                return ty.f32();
+            case TypeKind::kF16:
+                return ty.f16();
+            case TypeKind::kAbstractInt:
+                return ty.AInt();
+            case TypeKind::kAbstractFloat:
+                return ty.AFloat();
+            case TypeKind::kVector: {
+                auto* elem = Type();
+                auto width = U32();
+                bool packed = Bool();
+                if (!elem->Is<core::type::Scalar>() || width < 2 || width > 4) {
+                    Error("invalid vector type");
+                    return nullptr;
+                }
+                return packed ? ty.packed_vec(elem, width) : ty.vec(elem, width);
+            }
+            case TypeKind::kMatrix: {
+                auto* column = Type()->As<core::type::Vector>();
+                auto columns = U32();
+                if (!column || columns < 2 || columns > 4) {
+                    Error("invalid matrix type");
+                    return nullptr;
+                }
+                return ty.mat(column, columns);
+            }
+            case TypeKind::kArray:
+            case TypeKind::kRuntimeArray: {
+                auto* elem = Type();
+                const core::type::ArrayCount* count = nullptr;
+                if (kind == TypeKind::kRuntimeArray) {
+                    count = ty.Get<core::type::RuntimeArrayCount>();
+                } else {
+                    count = ty.Get<core::type::ConstantArrayCount>(U32());
+                }
+                auto align = U32();
+                auto size = U32();
+                auto stride = U32();
+                auto implicit_stride = U32();
+                return ty.Get<core::type::Array>(elem, count, align, size, stride, implicit_stride);
+            }
+            case TypeKind::kPointer: {
+                auto space = Enum(core::AddressSpace::kWorkgroup);
+                auto* store = Type();
+                auto access = Enum(core::Access::kWrite);
+                return ty.ptr(space, store, access);
+            }
+            case TypeKind::kAtomic:
+                return ty.atomic(Type());
+            case TypeKind::kStruct:
+                return DecodeStruct();
+            case TypeKind::kSampler:
+                return ty.Get<core::type::Sampler>(
+                    Enum(core::type::SamplerKind::kComparisonSampler));
+            case TypeKind::kDepthTexture:
+                return ty.Get<core::type::DepthTexture>(dim());
+            case TypeKind::kDepthMultisampledTexture:
+                return ty.Get<core::type::DepthMultisampledTexture>(dim());
+            case TypeKind::kExternalTexture:
+                return ty.Get<core::type::ExternalTexture>();
+            case TypeKind::kMultisampledTexture: {
+                auto d = dim();
+                return ty.Get<core::type::MultisampledTexture>(d, Type());
+            }
+            case TypeKind::kSampledTexture: {
+                auto d = dim();
+                return ty.Get<core::type::SampledTexture>(d, Type());
+            }
+            case TypeKind::kStorageTexture: {
+                auto d = dim();
+                auto format = Enum(core::TexelFormat::kRgba8Unorm);
+                auto access = Enum(core::Access::kWrite);
+                auto* subtype = core::type::StorageTexture::SubtypeFor(format, ty);
+                return ty.Get<core::type::StorageTexture>(d, format, access, subtype);
+            }
+        }
+        return nullptr;
+    }
+
+    const core::type::Type* DecodeStruct() {
+        auto& ty = mod_.Types();
+        auto name = Symbol(String());
+        auto align = U32();
+        auto size = U32();
+        auto size_no_padding = U32();
+        bool block = Bool();
+
+        Vector<const core::type::StructMember*, 8> members;
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            auto member_name = Symbol(String());
+            auto* type = Type();
+            auto index = U32();
+            auto offset = U32();
+            auto member_align = U32();
+            auto member_size = U32();
+            auto flags = U8();
+            core::type::StructMemberAttributes attrs;
+            if (flags & 1) {
+                attrs.location = U32();
+            }
+            if (flags & 2) {
+                attrs.index = U32();
+            }
+            if (flags & 4) {
+                attrs.builtin = Enum(core::BuiltinValue::kWorkgroupId);
+            }
+            if (flags & 8) {
+                attrs.interpolation = Interpolation();
+            }
+            attrs.invariant = (flags & 16) != 0;
+            members.Push(ty.Get<core::type::StructMember>(member_name, type, index, offset,
+                                                          member_align, member_size, attrs));
+        }
+
+        auto* str = ty.Get<core::type::Struct>(name, std::move(members), align, size,
+                                               size_no_padding);
+        if (block) {
+            str->SetStructFlag(core::type::StructFlag::kBlock);
+        }
+        return str;
+    }
+
+    const core::constant::Value* ConstantAt(uint64_t id) {
+        if (id >= constants_.Length() || !constants_[id]) {
+            Error("invalid constant id");
+            return nullptr;
+        }
+        return constants_[id];
+    }
+
+    const core::constant::Value* DecodeConstant() {
+        auto& cv = mod_.constant_values;
+        switch (Enum(ConstantKind::kDenseComposite)) {
+            case ConstantKind::kBool:
+                return cv.Get(Bool());
+            case ConstantKind::kI32:
+                return cv.Get(i32(static_cast<int32_t>(SignedVarint())));
+            case ConstantKind::kU32:
+                return cv.Get(u32(U32()));
+            case ConstantKind::kF32:
+                return cv.Get(f32(tint::Bitcast<float>(Fixed<uint32_t>())));
+            case ConstantKind::kF16:
+                return cv.Get(f16::FromBits(Fixed<uint16_t>()));
+            case ConstantKind::kAbstractInt:
+                return cv.Get(AInt(SignedVarint()));
+            case ConstantKind::kAbstractFloat:
+                return cv.Get(AFloat(tint::Bitcast<double>(Fixed<uint64_t>())));
+            case ConstantKind::kSplat: {
+                auto* type = Type();
+                auto* el = ConstantAt(Varint());
+                auto count = U32();
+                if (!el) {
+                    return nullptr;
+                }
+                return cv.Splat(type, el, count);
+            }
+            case ConstantKind::kComposite: {
+                auto* type = Type();
+                Vector<const core::constant::Value*, 8> elements;
+                for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+                    elements.Push(ConstantAt(Varint()));
+                }
+                if (Failed()) {
+                    return nullptr;
+                }
+                auto* value = cv.Composite(type, std::move(elements));
+                if (!value) {
+                    Error("invalid composite constant");
+                }
+                return value;
+            }
+            case ConstantKind::kDenseComposite: {
+                auto* type = Type();
+                auto count = Count();
+                if (Failed()) {
+                    return nullptr;
+                }
+                auto* el_type = type->Elements().type;
+                if (!el_type) {
+                    Error("invalid dense composite constant");
+                    return nullptr;
+                }
+                auto dense = [&](auto read) -> const core::constant::Value* {
+                    Vector<decltype(read()), 0> values;
+                    values.Reserve(count);
+                    for (uint64_t i = 0; i < count && !Failed(); i++) {
+                        values.Push(read());
+                    }
+                    if (Failed()) {
+                        return nullptr;
+                    }
+                    auto* value = cv.DenseComposite(type, el_type, std::move(values));
+                    if (!value) {
+                        Error("invalid dense composite constant");
+                    }
+                    return value;
+                };
+                return tint::Switch(
+                    el_type,  //
+                    [&](const core::type::Bool*) { return dense([&] { return Bool(); }); },
+                    [&](const core::type::I32*) {
+                        return dense([&] { return i32(static_cast<int32_t>(SignedVarint())); });
+                    },
+                    [&](const core::type::U32*) { return dense([&] { return u32(U32()); }); },
+                    [&](const core::type::F32*) {
+                        return dense([&] { return f32(tint::Bitcast<float>(Fixed<uint32_t>())); });
+                    },
+                    [&](const core::type::F16*) {
+                        return dense([&] { return f16::FromBits(Fixed<uint16_t>()); });
+                    },
+                    [&](const core::type::AbstractInt*) {
+                        return dense([&] { return AInt(SignedVarint()); });
+                    },
+                    [&](const core::type::AbstractFloat*) {
+                        return dense(
+                            [&] { return AFloat(tint::Bitcast<double>(Fixed<uint64_t>())); });
+                    },
+                    [&](Default) -> const core::constant::Value* {
+                        Error("invalid dense composite constant");
+                        return nullptr;
+                    });
+            }
+        }
+        return nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Values
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /// @returns the symbol for @p name, or an invalid symbol if @p name is empty
+    tint::Symbol Symbol(std::string_view name) {
+        return name.empty() ? tint::Symbol{} : mod_.symbols.Register(name);
+    }
+
+    /// Applies the decoded @p name to @p value
+    void SetName(ir::Value* value, std::string_view name) {
+        if (!name.empty()) {
+            mod_.SetName(value, Symbol(name));
+        }
+    }
+
+    ir::Value* Ref(ValueRef ref) {
+        if (ref == 0) {
+            return nullptr;
+        }
+        if (ref & 1) {
+            auto* value = ConstantAt(ref >> 1);
+            return value ? b_.Constant(value) : nullptr;
+        }
+        auto id = (ref >> 1) - 1;
+        if (id >= values_.Length()) {
+            Error("invalid value id");
+            return nullptr;
+        }
+        return values_[id];
+    }
+
+    std::optional<Location> DecodeLocation() {
+        if (!Bool()) {
+            return std::nullopt;
+        }
+        Location loc;
+        loc.value = U32();
+        if (Bool()) {
+            loc.interpolation = Interpolation();
+        }
+        return loc;
+    }
+
+    Function* DecodeFunction() {
+        auto name = String();
+        auto* return_type = Type();
+        auto stage = Enum(Function::PipelineStage::kVertex);
+        auto* func = mod_.values.Create<Function>(return_type, stage);
+        func->SetBlock(b_.Block());
+        mod_.functions.Push(func);
+        SetName(func, name);
+        if (Bool()) {
+            auto x = U32();
+            auto y = U32();
+            auto z = U32();
+            func->SetWorkgroupSize(x, y, z);
+        }
+        if (Bool()) {
+            func->SetReturnBuiltin(Enum(Function::ReturnBuiltin::kSampleMask));
+        }
+        if (auto loc = DecodeLocation()) {
+            func->SetReturnLocation(loc->value, loc->interpolation);
+        }
+        func->SetReturnInvariant(Bool());
+
+        Vector<FunctionParam*, 4> params;
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            auto param_name = String();
+            auto* param = mod_.values.Create<FunctionParam>(Type());
+            values_.Push(param);
+            SetName(param, param_name);
+            if (Bool()) {
+                param->SetBuiltin(Enum(FunctionParam::Builtin::kSampleMask));
+            }
+            if (auto loc = DecodeLocation()) {
+                param->SetLocation(loc->value, loc->interpolation);
+            }
+            param->SetInvariant(Bool());
+            if (Bool()) {
+                auto group = U32();
+                auto binding = U32();
+                param->SetBindingPoint(group, binding);
+            }
+            params.Push(param);
+        }
+        func->SetParams(std::move(params));
+        return func;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Blocks and instructions
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void DecodeBlock(ir::Block* block) {
+        if (auto* mib = block->As<MultiInBlock>()) {
+            Vector<BlockParam*, 4> params;
+            for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+                auto name = String();
+                auto* param = mod_.values.Create<BlockParam>(Type());
+                values_.Push(param);
+                SetName(param, name);
+                params.Push(param);
+            }
+            mib->SetParams(std::move(params));
+        }
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            if (auto* inst = DecodeInstruction(block)) {
+                block->Append(inst);
+            }
+        }
+    }
+
+    template <typename T>
+    T* ControlAt(uint64_t id) {
+        if (id >= controls_.Length()) {
+            Error("invalid control instruction id");
+            return nullptr;
+        }
+        auto* inst = controls_[id]->As<T>();
+        if (!inst) {
+            Error("exit does not match its control instruction");
+        }
+        return inst;
+    }
+
+    Instruction* DecodeInstruction(ir::Block* block) {
+        auto opcode = Enum(Opcode::kVar);
+
+        Vector<InstructionResult*, 2> results;
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            auto name = String();
+            auto* result = mod_.values.Create<InstructionResult>(Type());
+            values_.Push(result);
+            SetName(result, name);
+            results.Push(result);
+        }
+
+        Vector<ir::Value*, 4> operands;
+        for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+            auto* operand = Ref(Varint());
+            // Only a var's initializer operand may be null.
+            if (!operand && opcode != Opcode::kVar) {
+                Error("null operand");
+            }
+            operands.Push(operand);
+        }
+        if (Failed()) {
+            return nullptr;
+        }
+
+        auto expect = [&](size_t num_results, size_t min_operands, size_t max_operands) {
+            if (results.Length() != num_results || operands.Length() < min_operands ||
+                operands.Length() > max_operands) {
+                Error("invalid operands for opcode " + std::to_string(static_cast<int>(opcode)));
+                return false;
+            }
+            return !Failed();
+        };
+        auto args = [&](size_t start) {
+            Vector<ir::Value*, 4> out;
+            for (size_t i = start; i < operands.Length(); i++) {
+                out.Push(operands[i]);
+            }
+            return out;
+        };
+        constexpr size_t kAny = ~size_t(0);
+
+        switch (opcode) {
+            case Opcode::kAccess:
+                if (!expect(1, 1, kAny)) {
+                    return nullptr;
+                }
+                return Create<Access>(results[0], operands[0], args(1));
+            case Opcode::kBinary: {
+                auto kind = Enum(Binary::Kind::kShiftRight);
+                if (!expect(1, 2, 2)) {
+                    return nullptr;
+                }
+                return Create<Binary>(results[0], kind, operands[0], operands[1]);
+            }
+            case Opcode::kBitcast:
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                return Create<Bitcast>(results[0], operands[0]);
+            case Opcode::kBreakIf: {
+                auto* loop = ControlAt<Loop>(Varint());
+                if (!loop || !expect(0, 1, kAny)) {
+                    return nullptr;
+                }
+                return Create<BreakIf>(operands[0], loop, args(1));
+            }
+            case Opcode::kConstruct:
+                if (!expect(1, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<Construct>(results[0], args(0));
+            case Opcode::kContinue: {
+                auto* loop = ControlAt<Loop>(Varint());
+                if (!loop || !expect(0, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<Continue>(loop, args(0));
+            }
+            case Opcode::kConvert:
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                return Create<Convert>(results[0], operands[0]);
+            case Opcode::kCoreBuiltinCall: {
+                auto func = Enum(core::Function::kNone);
+                if (func == core::Function::kNone || func == core::Function::kTintMaterialize) {
+                    Error("invalid builtin function");
+                }
+                if (!expect(1, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<CoreBuiltinCall>(results[0], func, args(0));
+            }
+            case Opcode::kDiscard:
+                if (!expect(0, 0, 0)) {
+                    return nullptr;
+                }
+                return Create<Discard>();
+            case Opcode::kExitIf: {
+                auto* ctrl = ControlAt<If>(Varint());
+                if (!ctrl || !expect(0, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<ExitIf>(ctrl, args(0));
+            }
+            case Opcode::kExitLoop: {
+                auto* ctrl = ControlAt<Loop>(Varint());
+                if (!ctrl || !expect(0, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<ExitLoop>(ctrl, args(0));
+            }
+            case Opcode::kExitSwitch: {
+                auto* ctrl = ControlAt<Switch>(Varint());
+                if (!ctrl || !expect(0, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<ExitSwitch>(ctrl, args(0));
+            }
+            case Opcode::kIf: {
+                if (!expect(results.Length(), 1, 1)) {
+                    return nullptr;
+                }
+                auto* inst = Create<If>(operands[0], b_.Block(), b_.Block());
+                inst->SetResults(std::move(results));
+                controls_.Push(inst);
+                // Append before decoding the nested blocks, so that the instruction is owned by
+                // the block if an error is raised.
+                block->Append(inst);
+                DecodeBlock(inst->True());
+                DecodeBlock(inst->False());
+                return nullptr;
+            }
+            case Opcode::kIntrinsicCall: {
+                auto kind = Enum(IntrinsicCall::Kind::kSpirvVectorTimesScalar);
+                if (!expect(1, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<IntrinsicCall>(results[0], kind, args(0));
+            }
+            case Opcode::kLet:
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                return Create<Let>(results[0], operands[0]);
+            case Opcode::kLoad:
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                if (operands[0]->Type()->UnwrapPtr() == operands[0]->Type() ||
+                    operands[0]->Type()->UnwrapPtr() != results[0]->Type()) {
+                    Error("load source is not a pointer to the result type");
+                    return nullptr;
+                }
+                return Create<Load>(results[0], operands[0]);
+            case Opcode::kLoadVectorElement:
+                if (!expect(1, 2, 2)) {
+                    return nullptr;
+                }
+                return Create<LoadVectorElement>(results[0], operands[0], operands[1]);
+            case Opcode::kLoop: {
+                if (!expect(results.Length(), 0, 0)) {
+                    return nullptr;
+                }
+                auto* inst = Create<Loop>(b_.Block(), b_.MultiInBlock(), b_.MultiInBlock());
+                inst->SetResults(std::move(results));
+                controls_.Push(inst);
+                block->Append(inst);
+                DecodeBlock(inst->Initializer());
+                DecodeBlock(inst->Body());
+                DecodeBlock(inst->Continuing());
+                return nullptr;
+            }
+            case Opcode::kNextIteration: {
+                auto* loop = ControlAt<Loop>(Varint());
+                if (!loop || !expect(0, 0, kAny)) {
+                    return nullptr;
+                }
+                return Create<NextIteration>(loop, args(0));
+            }
+            case Opcode::kReturn: {
+                if (!expect(0, 1, 2)) {
+                    return nullptr;
+                }
+                auto* func = operands[0] ? operands[0]->As<Function>() : nullptr;
+                if (!func) {
+                    Error("return does not refer to a function");
+                    return nullptr;
+                }
+                if (operands.Length() == 2) {
+                    return Create<Return>(func, operands[1]);
+                }
+                return Create<Return>(func);
+            }
+            case Opcode::kStore:
+                if (!expect(0, 2, 2)) {
+                    return nullptr;
+                }
+                return Create<Store>(operands[0], operands[1]);
+            case Opcode::kStoreVectorElement:
+                if (!expect(0, 3, 3)) {
+                    return nullptr;
+                }
+                return Create<StoreVectorElement>(operands[0], operands[1], operands[2]);
+            case Opcode::kSwitch: {
+                if (!expect(results.Length(), 1, 1)) {
+                    return nullptr;
+                }
+                auto* inst = Create<Switch>(operands[0]);
+                inst->SetResults(std::move(results));
+                controls_.Push(inst);
+                block->Append(inst);
+                for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+                    Vector<Switch::CaseSelector, 4> selectors;
+                    for (uint64_t j = 0, m = Count(); j < m && !Failed(); j++) {
+                        // Selectors are either constants or null for the default selector.
+                        auto ref = Varint();
+                        Constant* selector = nullptr;
+                        if (ref != 0) {
+                            selector = As<Constant>(Ref(ref));
+                            if (!selector) {
+                                Error("switch case selector is not a constant");
+                            }
+                        }
+                        selectors.Push({selector});
+                    }
+                    DecodeBlock(b_.Case(inst, std::move(selectors)));
+                }
+                return nullptr;
+            }
+            case Opcode::kSwizzle: {
+                Vector<uint32_t, 4> indices;
+                for (uint64_t i = 0, n = Count(); i < n && !Failed(); i++) {
+                    indices.Push(U32());
+                }
+                if (indices.IsEmpty() || indices.Length() > 4 ||
+                    indices.Any([](uint32_t idx) { return idx >= 4; })) {
+                    Error("invalid swizzle indices");
+                }
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                return Create<Swizzle>(results[0], operands[0], std::move(indices));
+            }
+            case Opcode::kTerminateInvocation:
+                if (!expect(0, 0, 0)) {
+                    return nullptr;
+                }
+                return Create<TerminateInvocation>();
+            case Opcode::kUnary: {
+                auto kind = Enum(Unary::Kind::kNegation);
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                return Create<Unary>(results[0], kind, operands[0]);
+            }
+            case Opcode::kUnreachable:
+                if (!expect(0, 0, 0)) {
+                    return nullptr;
+                }
+                return Create<Unreachable>();
+            case Opcode::kUserCall: {
+                if (!expect(1, 1, kAny)) {
+                    return nullptr;
+                }
+                auto* func = operands[0] ? operands[0]->As<Function>() : nullptr;
+                if (!func) {
+                    Error("call does not refer to a function");
+                    return nullptr;
+                }
+                return Create<UserCall>(results[0], func, args(1));
+            }
+            case Opcode::kVar: {
+                bool has_binding_point = Bool();
+                uint32_t group = 0;
+                uint32_t binding = 0;
+                if (has_binding_point) {
+                    group = U32();
+                    binding = U32();
+                }
+                if (!expect(1, 1, 1)) {
+                    return nullptr;
+                }
+                if (!results[0]->Type()->Is<core::type::Pointer>()) {
+                    Error("var result is not a pointer");
+                    return nullptr;
+                }
+                auto* var = Create<Var>(results[0]);
+                var->SetInitializer(operands[0]);
+                if (has_binding_point) {
+                    var->SetBindingPoint(group, binding);
+                }
+                return var;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T, typename... ARGS>
+    T* Create(ARGS&&... args) {
+        return mod_.instructions.Create<T>(std::forward<ARGS>(args)...);
+    }
+
+    Slice<const uint8_t> data_;
+    size_t offset_ = 0;
+    std::string error_;
+
+    Module mod_;
+    Builder b_;
+
+    Vector<const core::type::Type*, 32> types_;
+    Vector<const core::constant::Value*, 32> constants_;
+    Vector<ir::Value*, 64> values_;
+    Vector<ControlInstruction*, 16> controls_;
+};
+
+}  // namespace
+
+tint::Result<Module, std::string> Decode(Slice<const uint8_t> data) {
+    return Decoder(data).Run();
+}
+
+}  // namespace tint::ir::binary
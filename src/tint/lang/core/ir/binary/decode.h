@@ -0,0 +1,39 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
+#define SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/utils/containers/slice.h"
+#include "src/tint/utils/result/result.h"
+
+namespace tint::ir::binary {
+
+/// Decodes a module encoded by Encode().
+/// @param data the encoded module
+/// @returns the `utils::Result` of decoding the module. The result will contain the `ir::Module`
+/// on success, otherwise the `std::string` error.
+///
+/// @note Decode() rejects truncated or malformed encodings, but it does not validate the decoded
+/// module. Data that may have been produced by another Tint revision must not be decoded, and
+/// the result should be passed to ir::Validate() if the data is not trusted.
+tint::Result<Module, std::string> Decode(Slice<const uint8_t> data);
+
+}  // namespace tint::ir::binary
+
+#endif  // SRC_TINT_LANG_CORE_IR_BINARY_DECODE_H_
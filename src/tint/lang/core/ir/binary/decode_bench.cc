@@ -0,0 +1,79 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/core/ir/binary/decode.h"
+#include "src/tint/lang/core/ir/binary/encode.h"
+#include "src/tint/lang/wgsl/reader/program_to_ir/program_to_ir.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+
+namespace tint::ir::binary {
+namespace {
+
+// Baseline: builds the IR module from the WGSL source, which is what a cache hit avoids. This
+// parses and resolves the source, then converts the resolved program to IR.
+void BuildIR(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (auto err = std::get_if<bench::Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        auto program = wgsl::reader::Parse(&file);
+        if (program.Diagnostics().contains_errors()) {
+            state.SkipWithError(program.Diagnostics().str().c_str());
+            return;
+        }
+        auto mod = wgsl::reader::ProgramToIR(&program);
+        if (!mod) {
+            state.SkipWithError(mod.Failure().c_str());
+        }
+    }
+}
+
+void DecodeIR(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadProgram(input_name);
+    if (auto err = std::get_if<bench::Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& program = std::get<bench::ProgramAndFile>(res).program;
+    auto mod = wgsl::reader::ProgramToIR(&program);
+    if (!mod) {
+        state.SkipWithError(mod.Failure().c_str());
+        return;
+    }
+    auto encoded = Encode(mod.Get());
+    if (!encoded) {
+        state.SkipWithError(encoded.Failure().c_str());
+        return;
+    }
+    auto& data = encoded.Get();
+    state.counters["encoded_bytes"] = static_cast<double>(data.size());
+    for (auto _ : state) {
+        auto decoded = Decode({data.data(), data.size(), data.size()});
+        if (!decoded) {
+            state.SkipWithError(decoded.Failure().c_str());
+        }
+    }
+}
+
+TINT_BENCHMARK_PROGRAMS(BuildIR);
+TINT_BENCHMARK_PROGRAMS(DecodeIR);
+
+}  // namespace
+}  // namespace tint::ir::binary
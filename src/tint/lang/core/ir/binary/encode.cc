@@ -0,0 +1,677 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/binary/encode.h"
+
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense_composite.h"
+#include "src/tint/lang/core/constant/scalar.h"
+#include "src/tint/lang/core/constant/splat.h"
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/binary/format.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/block_param.h"
+#include "src/tint/lang/core/ir/break_if.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/discard.h"
+#include "src/tint/lang/core/ir/exit_if.h"
+#include "src/tint/lang/core/ir/exit_loop.h"
+#include "src/tint/lang/core/ir/exit_switch.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/instruction_result.h"
+#include "src/tint/lang/core/ir/intrinsic_call.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/next_iteration.h"
+#include "src/tint/lang/core/ir/return.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/switch.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/terminate_invocation.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/unreachable.h"
+#include "src/tint/lang/core/ir/user_call.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/abstract_float.h"
+#include "src/tint/lang/core/type/abstract_int.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/atomic.h"
+#include "src/tint/lang/core/type/bool.h"
+#include "src/tint/lang/core/type/depth_multisampled_texture.h"
+#include "src/tint/lang/core/type/depth_texture.h"
+#include "src/tint/lang/core/type/external_texture.h"
+#include "src/tint/lang/core/type/f16.h"
+#include "src/tint/lang/core/type/f32.h"
+#include "src/tint/lang/core/type/i32.h"
+#include "src/tint/lang/core/type/matrix.h"
+#include "src/tint/lang/core/type/multisampled_texture.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+#include "src/tint/lang/core/type/sampler.h"
+#include "src/tint/lang/core/type/storage_texture.h"
+#include "src/tint/lang/core/type/struct.h"
+#include "src/tint/lang/core/type/u32.h"
+#include "src/tint/lang/core/type/vector.h"
+#include "src/tint/lang/core/type/void.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/rtti/switch.h"
+
+namespace tint::ir::binary {
+namespace {
+
+/// A growable byte buffer with helpers to append encoded values.
+class Writer {
+  public:
+    /// @param v the byte to append
+    void U8(uint8_t v) { bytes_.push_back(v); }
+
+    /// Appends @p v as a unsigned LEB128 varint
+    /// @param v the value to append
+    void Varint(uint64_t v) {
+        while (v >= 0x80) {
+            bytes_.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        bytes_.push_back(static_cast<uint8_t>(v));
+    }
+
+    /// Appends @p v as a zigzag encoded varint
+    /// @param v the value to append
+    void SignedVarint(int64_t v) {
+        Varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    }
+
+    /// Appends the little-endian bit pattern of @p v
+    /// @param v the value to append
+    template <typename T>
+    void Fixed(T v) {
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bytes_.push_back(static_cast<uint8_t>(static_cast<uint64_t>(v) >> (i * 8)));
+        }
+    }
+
+    /// @param v the enum value to append as a varint
+    template <typename E, typename = std::enable_if_t<std::is_enum_v<E>>>
+    void Enum(E v) {
+        Varint(static_cast<uint64_t>(v));
+    }
+
+    /// @param str the string to append
+    void String(std::string_view str) {
+        Varint(str.size());
+        bytes_.insert(bytes_.end(), str.begin(), str.end());
+    }
+
+    /// Appends the contents of @p other
+    /// @param other the writer to append
+    void Append(const Writer& other) {
+        bytes_.insert(bytes_.end(), other.bytes_.begin(), other.bytes_.end());
+    }
+
+    /// @returns the encoded bytes
+    std::vector<uint8_t> Take() { return std::move(bytes_); }
+
+  private:
+    std::vector<uint8_t> bytes_;
+};
+
+/// The state used to encode a single module.
+///
+/// The types and constant values are collected while the functions are encoded, so they are
+/// written to separate buffers that are stitched together once the whole module is encoded.
+class Encoder {
+  public:
+    explicit Encoder(Module& mod) : mod_(mod) {}
+
+    tint::Result<std::vector<uint8_t>, std::string> Run() {
+        // Encode all the types up front, so that the decoded type manager holds the types in the
+        // same order.
+        for (auto* type : mod_.Types()) {
+            TypeId(type);
+        }
+        for (auto* func : mod_.functions) {
+            DefineValue(func);
+        }
+
+        out_.Varint(mod_.functions.Length());
+        for (auto* func : mod_.functions) {
+            EncodeFunction(func);
+        }
+
+        out_.U8(mod_.root_block ? 1 : 0);
+        if (mod_.root_block) {
+            EncodeBlock(mod_.root_block);
+        }
+        for (auto* func : mod_.functions) {
+            EncodeBlock(func->Block());
+        }
+
+        if (!error_.empty()) {
+            return error_;
+        }
+
+        Writer result;
+        for (uint8_t c : kMagic) {
+            result.U8(c);
+        }
+        result.Varint(kVersion);
+        result.Varint(type_count_);
+        result.Append(types_);
+        result.Varint(constant_count_);
+        result.Append(constants_);
+        result.Append(out_);
+        return result.Take();
+    }
+
+  private:
+    void Error(std::string msg) {
+        if (error_.empty()) {
+            error_ = std::move(msg);
+        }
+    }
+
+    /// Assigns the next value id to @p value.
+    void DefineValue(Value* value) { value_ids_.Add(value, value_count_++); }
+
+    void EncodeName(Value* value) { out_.String(mod_.NameOf(value).NameView()); }
+
+    void EncodeLocation(const std::optional<Location>& loc) {
+        out_.U8(loc.has_value() ? 1 : 0);
+        if (loc) {
+            out_.Varint(loc->value);
+            out_.U8(loc->interpolation.has_value() ? 1 : 0);
+            if (loc->interpolation) {
+                out_.Enum(loc->interpolation->type);
+                out_.Enum(loc->interpolation->sampling);
+            }
+        }
+    }
+
+    void EncodeFunction(Function* func) {
+        EncodeName(func);
+        out_.Varint(TypeId(func->ReturnType()));
+        out_.Enum(func->Stage());
+        auto wg_size = func->WorkgroupSize();
+        out_.U8(wg_size.has_value() ? 1 : 0);
+        if (wg_size) {
+            for (uint32_t v : *wg_size) {
+                out_.Varint(v);
+            }
+        }
+        auto builtin = func->ReturnBuiltin();
+        out_.U8(builtin.has_value() ? 1 : 0);
+        if (builtin) {
+            out_.Enum(*builtin);
+        }
+        EncodeLocation(func->ReturnLocation());
+        out_.U8(func->ReturnInvariant() ? 1 : 0);
+
+        out_.Varint(func->Params().Length());
+        for (auto* param : func->Params()) {
+            DefineValue(param);
+            EncodeName(param);
+            out_.Varint(TypeId(param->Type()));
+            auto param_builtin = param->Builtin();
+            out_.U8(param_builtin.has_value() ? 1 : 0);
+            if (param_builtin) {
+                out_.Enum(*param_builtin);
+            }
+            EncodeLocation(param->Location());
+            out_.U8(param->Invariant() ? 1 : 0);
+            auto& bp = param->BindingPoint();
+            out_.U8(bp.has_value() ? 1 : 0);
+            if (bp) {
+                out_.Varint(bp->group);
+                out_.Varint(bp->binding);
+            }
+        }
+    }
+
+    void EncodeBlock(Block* block) {
+        if (auto* mib = block->As<MultiInBlock>()) {
+            out_.Varint(mib->Params().Length());
+            for (auto* param : mib->Params()) {
+                DefineValue(param);
+                EncodeName(param);
+                out_.Varint(TypeId(param->Type()));
+            }
+        }
+        out_.Varint(block->Length());
+        for (auto* inst : *block) {
+            EncodeInstruction(inst);
+        }
+    }
+
+    void EncodeInstruction(Instruction* inst) {
+        auto opcode = OpcodeOf(inst);
+        if (!opcode) {
+            Error("cannot encode instruction " + std::string(inst->TypeInfo().name));
+            return;
+        }
+        out_.Enum(*opcode);
+
+        // Results must be defined before any nested block is encoded.
+        auto results = inst->Results();
+        out_.Varint(results.Length());
+        for (auto* result : results) {
+            if (!result) {
+                Error("cannot encode a null instruction result");
+                return;
+            }
+            DefineValue(result);
+            EncodeName(result);
+            out_.Varint(TypeId(result->Type()));
+        }
+
+        auto operands = inst->Operands();
+        out_.Varint(operands.Length());
+        for (auto* operand : operands) {
+            out_.Varint(Ref(operand));
+        }
+
+        tint::Switch(
+            inst,  //
+            [&](Binary* b) { out_.Enum(b->Kind()); },
+            [&](Unary* u) { out_.Enum(u->Kind()); },
+            [&](CoreBuiltinCall* c) { out_.Enum(c->Func()); },
+            [&](IntrinsicCall* c) { out_.Enum(c->Kind()); },
+            [&](Swizzle* s) {
+                out_.Varint(s->Indices().Length());
+                for (uint32_t idx : s->Indices()) {
+                    out_.Varint(idx);
+                }
+            },
+            [&](Var* v) {
+                auto bp = v->BindingPoint();
+                out_.U8(bp.has_value() ? 1 : 0);
+                if (bp) {
+                    out_.Varint(bp->group);
+                    out_.Varint(bp->binding);
+                }
+            },
+            [&](If* i) {
+                control_ids_.Add(i, control_count_++);
+                EncodeBlock(i->True());
+                EncodeBlock(i->False());
+            },
+            [&](Loop* l) {
+                control_ids_.Add(l, control_count_++);
+                EncodeBlock(l->Initializer());
+                EncodeBlock(l->Body());
+                EncodeBlock(l->Continuing());
+            },
+            [&](Switch* s) {
+                control_ids_.Add(s, control_count_++);
+                out_.Varint(s->Cases().Length());
+                for (auto& c : s->Cases()) {
+                    out_.Varint(c.selectors.Length());
+                    for (auto& selector : c.selectors) {
+                        out_.Varint(selector.IsDefault() ? 0 : Ref(selector.val));
+                    }
+                    EncodeBlock(c.Block());
+                }
+            },
+            [&](Exit* e) { out_.Varint(ControlId(e->ControlInstruction())); },
+            [&](Continue* c) { out_.Varint(ControlId(c->Loop())); },
+            [&](NextIteration* n) { out_.Varint(ControlId(n->Loop())); },
+            [&](BreakIf* b) { out_.Varint(ControlId(b->Loop())); });
+    }
+
+    std::optional<Opcode> OpcodeOf(Instruction* inst) {
+        return tint::Switch<std::optional<Opcode>>(
+            inst,  //
+            [&](Access*) { return Opcode::kAccess; },
+            [&](Binary*) { return Opcode::kBinary; },
+            [&](Bitcast*) { return Opcode::kBitcast; },
+            [&](BreakIf*) { return Opcode::kBreakIf; },
+            [&](Construct*) { return Opcode::kConstruct; },
+            [&](Continue*) { return Opcode::kContinue; },
+            [&](Convert*) { return Opcode::kConvert; },
+            [&](CoreBuiltinCall*) { return Opcode::kCoreBuiltinCall; },
+            [&](Discard*) { return Opcode::kDiscard; },
+            [&](ExitIf*) { return Opcode::kExitIf; },
+            [&](ExitLoop*) { return Opcode::kExitLoop; },
+            [&](ExitSwitch*) { return Opcode::kExitSwitch; },
+            [&](If*) { return Opcode::kIf; },
+            [&](IntrinsicCall*) { return Opcode::kIntrinsicCall; },
+            [&](Let*) { return Opcode::kLet; },
+            [&](Load*) { return Opcode::kLoad; },
+            [&](LoadVectorElement*) { return Opcode::kLoadVectorElement; },
+            [&](Loop*) { return Opcode::kLoop; },
+            [&](NextIteration*) { return Opcode::kNextIteration; },
+            [&](Return*) { return Opcode::kReturn; },
+            [&](Store*) { return Opcode::kStore; },
+            [&](StoreVectorElement*) { return Opcode::kStoreVectorElement; },
+            [&](Switch*) { return Opcode::kSwitch; },
+            [&](Swizzle*) { return Opcode::kSwizzle; },
+            [&](TerminateInvocation*) { return Opcode::kTerminateInvocation; },
+            [&](Unary*) { return Opcode::kUnary; },
+            [&](Unreachable*) { return Opcode::kUnreachable; },
+            [&](UserCall*) { return Opcode::kUserCall; },
+            [&](Var*) { return Opcode::kVar; },
+            [&](Default) { return std::nullopt; });
+    }
+
+    uint64_t ControlId(ControlInstruction* inst) {
+        if (auto id = control_ids_.Get(inst)) {
+            return *id;
+        }
+        Error("exit from a control instruction that encloses it");
+        return 0;
+    }
+
+    ValueRef Ref(Value* value) {
+        if (!value) {
+            return 0;
+        }
+        if (auto* c = value->As<Constant>()) {
+            return (ConstantId(c->Value()) << 1) | 1;
+        }
+        if (auto id = value_ids_.Get(value)) {
+            return (*id + 1) << 1;
+        }
+        Error("value used before it is defined");
+        return 0;
+    }
+
+    uint64_t TypeId(const core::type::Type* type) {
+        if (!type) {
+            Error("cannot encode a null type");
+            return 0;
+        }
+        if (auto id = type_ids_.Get(type)) {
+            return *id;
+        }
+
+        // Dependencies are encoded first, so that the decoder can build types in order.
+        Writer w;
+        tint::Switch(
+            type,  //
+            [&](const core::type::Void*) { w.Enum(TypeKind::kVoid); },
+            [&](const core::type::Bool*) { w.Enum(TypeKind::kBool); },
+            [&](const core::type::I32*) { w.Enum(TypeKind::kI32); },
+            [&](const core::type::U32*) { w.Enum(TypeKind::kU32); },
+            [&](const core::type::F32*) { w.Enum(TypeKind::kF32); },
+            [&](const core::type::F16*) { w.Enum(TypeKind::kF16); },
+            [&](const core::type::AbstractInt*) { w.Enum(TypeKind::kAbstractInt); },
+            [&](const core::type::AbstractFloat*) { w.Enum(TypeKind::kAbstractFloat); },
+            [&](const core::type::Vector* v) {
+                auto elem = TypeId(v->type());
+                w.Enum(TypeKind::kVector);
+                w.Varint(elem);
+                w.Varint(v->Width());
+                w.U8(v->Packed() ? 1 : 0);
+            },
+            [&](const core::type::Matrix* m) {
+                auto column = TypeId(m->ColumnType());
+                w.Enum(TypeKind::kMatrix);
+                w.Varint(column);
+                w.Varint(m->columns());
+            },
+            [&](const core::type::Array* a) {
+                auto elem = TypeId(a->ElemType());
+                auto count = a->ConstantCount();
+                if (count) {
+                    w.Enum(TypeKind::kArray);
+                    w.Varint(elem);
+                    w.Varint(*count);
+                } else if (a->Count()->Is<core::type::RuntimeArrayCount>()) {
+                    w.Enum(TypeKind::kRuntimeArray);
+                    w.Varint(elem);
+                } else {
+                    Error("cannot encode array count " + a->FriendlyName());
+                    return;
+                }
+                w.Varint(a->Align());
+                w.Varint(a->Size());
+                w.Varint(a->Stride());
+                w.Varint(a->ImplicitStride());
+            },
+            [&](const core::type::Pointer* p) {
+                auto store = TypeId(p->StoreType());
+                w.Enum(TypeKind::kPointer);
+                w.Enum(p->AddressSpace());
+                w.Varint(store);
+                w.Enum(p->Access());
+            },
+            [&](const core::type::Atomic* a) {
+                auto elem = TypeId(a->Type());
+                w.Enum(TypeKind::kAtomic);
+                w.Varint(elem);
+            },
+            [&](const core::type::Struct* s) {
+                Vector<uint64_t, 8> member_types;
+                for (auto* member : s->Members()) {
+                    member_types.Push(TypeId(member->Type()));
+                }
+                w.Enum(TypeKind::kStruct);
+                w.String(s->Name().NameView());
+                w.Varint(s->Align());
+                w.Varint(s->Size());
+                w.Varint(s->SizeNoPadding());
+                w.U8(s->StructFlags().Contains(core::type::StructFlag::kBlock) ? 1 : 0);
+                w.Varint(s->Members().Length());
+                for (size_t i = 0; i < s->Members().Length(); i++) {
+                    auto* member = s->Members()[i];
+                    auto& attrs = member->Attributes();
+                    w.String(member->Name().NameView());
+                    w.Varint(member_types[i]);
+                    w.Varint(member->Index());
+                    w.Varint(member->Offset());
+                    w.Varint(member->Align());
+                    w.Varint(member->Size());
+                    w.U8((attrs.location ? 1u : 0u) | (attrs.index ? 2u : 0u) |
+                         (attrs.builtin ? 4u : 0u) | (attrs.interpolation ? 8u : 0u) |
+                         (attrs.invariant ? 16u : 0u));
+                    if (attrs.location) {
+                        w.Varint(*attrs.location);
+                    }
+                    if (attrs.index) {
+                        w.Varint(*attrs.index);
+                    }
+                    if (attrs.builtin) {
+                        w.Enum(*attrs.builtin);
+                    }
+                    if (attrs.interpolation) {
+                        w.Enum(attrs.interpolation->type);
+                        w.Enum(attrs.interpolation->sampling);
+                    }
+                }
+            },
+            [&](const core::type::Sampler* s) {
+                w.Enum(TypeKind::kSampler);
+                w.Enum(s->kind());
+            },
+            [&](const core::type::DepthTexture* t) {
+                w.Enum(TypeKind::kDepthTexture);
+                w.Enum(t->dim());
+            },
+            [&](const core::type::DepthMultisampledTexture* t) {
+                w.Enum(TypeKind::kDepthMultisampledTexture);
+                w.Enum(t->dim());
+            },
+            [&](const core::type::ExternalTexture*) { w.Enum(TypeKind::kExternalTexture); },
+            [&](const core::type::MultisampledTexture* t) {
+                auto elem = TypeId(t->type());
+                w.Enum(TypeKind::kMultisampledTexture);
+                w.Enum(t->dim());
+                w.Varint(elem);
+            },
+            [&](const core::type::SampledTexture* t) {
+                auto elem = TypeId(t->type());
+                w.Enum(TypeKind::kSampledTexture);
+                w.Enum(t->dim());
+                w.Varint(elem);
+            },
+            [&](const core::type::StorageTexture* t) {
+                w.Enum(TypeKind::kStorageTexture);
+                w.Enum(t->dim());
+                w.Enum(t->texel_format());
+                w.Enum(t->access());
+            },
+            [&](Default) { Error("cannot encode type " + type->FriendlyName()); });
+
+        types_.Append(w);
+        auto id = type_count_++;
+        type_ids_.Add(type, id);
+        return id;
+    }
+
+    uint64_t ConstantId(const core::constant::Value* value) {
+        if (auto id = constant_ids_.Get(value)) {
+            return *id;
+        }
+
+        Writer w;
+        tint::Switch(
+            value,  //
+            [&](const core::constant::Scalar<bool>* s) {
+                w.Enum(ConstantKind::kBool);
+                w.U8(s->ValueOf() ? 1 : 0);
+            },
+            [&](const core::constant::Scalar<i32>* s) {
+                w.Enum(ConstantKind::kI32);
+                w.SignedVarint(s->ValueOf());
+            },
+            [&](const core::constant::Scalar<u32>* s) {
+                w.Enum(ConstantKind::kU32);
+                w.Varint(s->ValueOf());
+            },
+            [&](const core::constant::Scalar<f32>* s) {
+                w.Enum(ConstantKind::kF32);
+                w.Fixed(tint::Bitcast<uint32_t>(static_cast<float>(s->ValueOf())));
+            },
+            [&](const core::constant::Scalar<f16>* s) {
+                w.Enum(ConstantKind::kF16);
+                w.Fixed(s->value.BitsRepresentation());
+            },
+            [&](const core::constant::Scalar<AInt>* s) {
+                w.Enum(ConstantKind::kAbstractInt);
+                w.SignedVarint(s->ValueOf());
+            },
+            [&](const core::constant::Scalar<AFloat>* s) {
+                w.Enum(ConstantKind::kAbstractFloat);
+                w.Fixed(tint::Bitcast<uint64_t>(static_cast<double>(s->ValueOf())));
+            },
+            [&](const core::constant::Splat* s) {
+                auto type = TypeId(s->Type());
+                auto elem = ConstantId(s->el);
+                w.Enum(ConstantKind::kSplat);
+                w.Varint(type);
+                w.Varint(elem);
+                w.Varint(s->count);
+            },
+            [&](const core::constant::Composite* c) {
+                auto type = TypeId(c->Type());
+                Vector<uint64_t, 8> elements;
+                for (auto* el : c->elements) {
+                    elements.Push(ConstantId(el));
+                }
+                w.Enum(ConstantKind::kComposite);
+                w.Varint(type);
+                w.Varint(elements.Length());
+                for (auto el : elements) {
+                    w.Varint(el);
+                }
+            },
+            [&](const core::constant::DenseCompositeBase* c) {
+                // Dense composites are encoded as their element values, so that neither the
+                // encoder nor the decoder creates a Scalar for each element.
+                auto type = TypeId(c->Type());
+                w.Enum(ConstantKind::kDenseComposite);
+                w.Varint(type);
+                w.Varint(c->NumElements());
+                tint::Switch(
+                    c,  //
+                    [&](const core::constant::DenseComposite<bool>* d) {
+                        for (auto v : d->values) {
+                            w.U8(v ? 1 : 0);
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<i32>* d) {
+                        for (auto v : d->values) {
+                            w.SignedVarint(v.value);
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<u32>* d) {
+                        for (auto v : d->values) {
+                            w.Varint(v.value);
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<f32>* d) {
+                        for (auto v : d->values) {
+                            w.Fixed(tint::Bitcast<uint32_t>(static_cast<float>(v.value)));
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<f16>* d) {
+                        for (auto v : d->values) {
+                            w.Fixed(v.BitsRepresentation());
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<AInt>* d) {
+                        for (auto v : d->values) {
+                            w.SignedVarint(v.value);
+                        }
+                    },
+                    [&](const core::constant::DenseComposite<AFloat>* d) {
+                        for (auto v : d->values) {
+                            w.Fixed(tint::Bitcast<uint64_t>(static_cast<double>(v.value)));
+                        }
+                    });
+            },
+            [&](Default) { Error("cannot encode constant " + value->Type()->FriendlyName()); });
+
+        constants_.Append(w);
+        auto id = constant_count_++;
+        constant_ids_.Add(value, id);
+        return id;
+    }
+
+    Module& mod_;
+    std::string error_;
+
+    Writer out_;
+    Writer types_;
+    Writer constants_;
+
+    Hashmap<const core::type::Type*, uint64_t, 32> type_ids_;
+    uint64_t type_count_ = 0;
+    Hashmap<const core::constant::Value*, uint64_t, 32> constant_ids_;
+    uint64_t constant_count_ = 0;
+    Hashmap<Value*, uint64_t, 64> value_ids_;
+    uint64_t value_count_ = 0;
+    Hashmap<ControlInstruction*, uint64_t, 16> control_ids_;
+    uint64_t control_count_ = 0;
+};
+
+}  // namespace
+
+tint::Result<std::vector<uint8_t>, std::string> Encode(Module& module) {
+    return Encoder(module).Run();
+}
+
+}  // namespace tint::ir::binary
@@ -0,0 +1,131 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
+#define SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
+
+#include <cstdint>
+
+/// The binary encoding of an ir::Module.
+///
+/// All integers are encoded as unsigned LEB128 varints, except for the bit patterns of floating
+/// point values which are encoded as little-endian fixed-width integers. Strings are encoded as a
+/// varint length followed by the characters. An encoded module is laid out as:
+///
+///   magic   : kMagic
+///   version : varint (kVersion)
+///   types   : varint count, followed by `count` types. A type only refers to types before it.
+///   consts  : varint count, followed by `count` constant values. A constant value only refers to
+///             types and constant values before it.
+///   funcs   : varint count, followed by `count` function declarations.
+///   root    : u8 flag, followed by the root block if the flag is 1.
+///   bodies  : the body block of each function, in declaration order.
+///
+/// Values are numbered in the order they are defined: the functions first, then the function
+/// parameters, then block parameters and instruction results in the order they appear. Operands
+/// refer to values with a ValueRef. Control instructions are numbered in the order they appear,
+/// and exit instructions refer to the control instruction they exit by that number.
+///
+/// The encoding is not stable across Tint revisions, and callers that persist it must key it on
+/// the Tint version.
+namespace tint::ir::binary {
+
+/// The magic number at the start of an encoded module.
+static constexpr uint8_t kMagic[4] = {'T', 'I', 'R', 'B'};
+
+/// The version of the encoding. Must be incremented when the encoding changes.
+static constexpr uint32_t kVersion = 2;
+
+/// A ValueRef is a varint that refers to a value operand:
+/// * 0 is a null operand
+/// * an odd number `n` is the constant value `n >> 1`
+/// * an even number `n` is the value `(n >> 1) - 1`
+using ValueRef = uint64_t;
+
+/// The kind of an encoded type
+enum class TypeKind : uint8_t {
+    kVoid,
+    kBool,
+    kI32,
+    kU32,
+    kF32,
+    kF16,
+    kAbstractInt,
+    kAbstractFloat,
+    kVector,
+    kMatrix,
+    kArray,
+    kRuntimeArray,
+    kPointer,
+    kAtomic,
+    kStruct,
+    kSampler,
+    kDepthTexture,
+    kDepthMultisampledTexture,
+    kExternalTexture,
+    kMultisampledTexture,
+    kSampledTexture,
+    kStorageTexture,
+};
+
+/// The kind of an encoded constant value
+enum class ConstantKind : uint8_t {
+    kBool,
+    kI32,
+    kU32,
+    kF32,
+    kF16,
+    kAbstractInt,
+    kAbstractFloat,
+    kSplat,
+    kComposite,
+    kDenseComposite,
+};
+
+/// The opcode of an encoded instruction
+enum class Opcode : uint8_t {
+    kAccess,
+    kBinary,
+    kBitcast,
+    kBreakIf,
+    kConstruct,
+    kContinue,
+    kConvert,
+    kCoreBuiltinCall,
+    kDiscard,
+    kExitIf,
+    kExitLoop,
+    kExitSwitch,
+    kIf,
+    kIntrinsicCall,
+    kLet,
+    kLoad,
+    kLoadVectorElement,
+    kLoop,
+    kNextIteration,
+    kReturn,
+    kStore,
+    kStoreVectorElement,
+    kSwitch,
+    kSwizzle,
+    kTerminateInvocation,
+    kUnary,
+    kUnreachable,
+    kUserCall,
+    kVar,
+};
+
+}  // namespace tint::ir::binary
+
+#endif  // SRC_TINT_LANG_CORE_IR_BINARY_FORMAT_H_
@@ -0,0 +1,300 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/tint/lang/core/constant/dense_composite.h"
+#include "src/tint/lang/core/ir/binary/decode.h"
+#include "src/tint/lang/core/ir/binary/encode.h"
+#include "src/tint/lang/core/ir/disassembler.h"
+#include "src/tint/lang/core/ir/ir_helper_test.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/type/depth_texture.h"
+#include "src/tint/lang/core/type/sampled_texture.h"
+#include "src/tint/lang/core/type/storage_texture.h"
+
+namespace tint::ir::binary {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+class IR_BinaryRoundtripTest : public IRTestHelper {
+  protected:
+    /// Encodes the module, decodes it, and checks that the decoded module is valid and identical
+    /// to the original.
+    void RunTest() {
+        auto validated = ir::Validate(mod);
+        ASSERT_TRUE(validated) << validated.Failure().str();
+
+        auto expected = Disassembler(mod).Disassemble();
+        auto encoded = Encode(mod);
+        ASSERT_TRUE(encoded) << encoded.Failure();
+        data = std::move(encoded.Get());
+
+        auto decoded = Decode(Data());
+        ASSERT_TRUE(decoded) << decoded.Failure();
+        auto decoded_validated = ir::Validate(decoded.Get());
+        ASSERT_TRUE(decoded_validated) << decoded_validated.Failure().str();
+        EXPECT_EQ(expected, Disassembler(decoded.Get()).Disassemble());
+    }
+
+    /// @returns the encoded module
+    Slice<const uint8_t> Data() const { return {data.data(), data.size(), data.size()}; }
+
+    /// The encoded module
+    std::vector<uint8_t> data;
+};
+
+TEST_F(IR_BinaryRoundtripTest, EmptyModule) {
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, RootBlockVars) {
+    core::type::StructMemberAttributes attrs;
+    attrs.location = 2u;
+    auto* str = ty.Struct(mod.symbols.New("S"), {
+                                                    {mod.symbols.New("a"), ty.vec3<f32>()},
+                                                    {mod.symbols.New("b"), ty.mat3x2<f32>(), attrs},
+                                                    {mod.symbols.New("c"), ty.array<u32, 4>()},
+                                                    {mod.symbols.New("d"), ty.array<i32>()},
+                                                });
+    b.Append(b.RootBlock(), [&] {
+        auto* buffer = b.Var("buffer", ty.ptr(storage, str, read));
+        buffer->SetBindingPoint(0, 1);
+        b.Var("counter", ty.ptr(workgroup, ty.atomic<u32>()));
+        auto* init = b.Var("init", ty.ptr<private_, vec4<f32>>());
+        init->SetInitializer(b.Splat(ty.vec4<f32>(), 1_f, 4));
+        auto* tex = b.Var("tex", ty.ptr(handle, ty.Get<core::type::SampledTexture>(
+                                                    core::type::TextureDimension::k2d, ty.f32())));
+        tex->SetBindingPoint(1, 0);
+        auto* depth = b.Var("depth", ty.ptr(handle, ty.Get<core::type::DepthTexture>(
+                                                        core::type::TextureDimension::kCube)));
+        depth->SetBindingPoint(1, 1);
+        auto* sampler = b.Var("sampler", ty.ptr(handle, ty.comparison_sampler()));
+        sampler->SetBindingPoint(1, 2);
+        auto format = core::TexelFormat::kRgba8Unorm;
+        auto* storage_tex = b.Var(
+            "storage_tex",
+            ty.ptr(handle, ty.Get<core::type::StorageTexture>(
+                               core::type::TextureDimension::k2dArray, format, core::Access::kWrite,
+                               core::type::StorageTexture::SubtypeFor(format, ty))));
+        storage_tex->SetBindingPoint(1, 3);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, EntryPointAttributes) {
+    auto* position = b.FunctionParam("position", ty.vec4<f32>());
+    position->SetBuiltin(FunctionParam::Builtin::kPosition);
+    position->SetInvariant(true);
+    auto* color = b.FunctionParam("color", ty.vec4<f32>());
+    color->SetLocation(1, core::Interpolation{core::InterpolationType::kLinear,
+                                              core::InterpolationSampling::kCentroid});
+    auto* func = b.Function("frag", ty.vec4<f32>(), Function::PipelineStage::kFragment);
+    func->SetParams({position, color});
+    func->SetReturnLocation(0, {});
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Add(ty.vec4<f32>(), position, color));
+    });
+
+    auto* local_id = b.FunctionParam("local_id", ty.vec3<u32>());
+    local_id->SetBuiltin(FunctionParam::Builtin::kLocalInvocationId);
+    auto* compute = b.Function("comp", ty.void_(), Function::PipelineStage::kCompute,
+                               std::array<uint32_t, 3>{8, 4, 1});
+    compute->SetParams({local_id});
+    b.Append(compute->Block(), [&] {  //
+        b.Return(compute);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, Constants) {
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        b.Let("a", -42_i);
+        b.Let("b", 0xffffffff_u);
+        b.Let("c", 1.5_f);
+        b.Let("d", 0.25_h);
+        b.Let("e", true);
+        b.Let("f", b.Splat(ty.vec3<i32>(), -1_i, 3));
+        b.Let("g", b.Composite(ty.vec2<f32>(), 1_f, 2_f));
+        b.Let("h", b.Composite(ty.array<u32, 3>(), 1_u, 2_u, 3_u));
+        auto* col0 = b.Composite(ty.vec2<f32>(), 1_f, 0_f)->Value();
+        auto* col1 = b.Composite(ty.vec2<f32>(), 0_f, 1_f)->Value();
+        b.Let("i", b.Constant(mod.constant_values.Composite(ty.mat2x2<f32>(), Vector{col0, col1})));
+        b.Return(func);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, DenseConstants) {
+    auto dense = [&](auto first, auto el_ty) {
+        using T = decltype(first);
+        Vector<T, 0> values;
+        for (uint32_t i = 0; i < 20; i++) {
+            values.Push(T(first + T(i)));
+        }
+        auto* value = mod.constant_values.DenseComposite(ty.array(el_ty, 20), el_ty, values);
+        EXPECT_TRUE(value->template Is<core::constant::DenseCompositeBase>());
+        return b.Constant(value);
+    };
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        b.Let("a", dense(-10_i, ty.i32()));
+        b.Let("b", dense(0xfffffff0_u, ty.u32()));
+        b.Let("c", dense(0.5_f, ty.f32()));
+        b.Let("d", dense(0.25_h, ty.f16()));
+        b.Let("e", b.Constant(mod.constant_values.DenseComposite(
+                        ty.array<bool, 16>(), ty.bool_(),
+                        Vector<bool, 0>{true, false, true, true, false, false, true, false, true,
+                                        true, true, false, false, false, false, true})));
+        b.Return(func);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, Instructions) {
+    auto* helper = b.Function("helper", ty.f32());
+    auto* x = b.FunctionParam("x", ty.f32());
+    helper->SetParams({x});
+    b.Append(helper->Block(), [&] {  //
+        b.Return(helper, b.Multiply(ty.f32(), x, 2_f));
+    });
+
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, vec4<f32>>());
+        auto* loaded = b.Load(v);
+        auto* swizzled = b.Swizzle(ty.vec2<f32>(), loaded, {2, 0});
+        auto* elem = b.Access(ty.f32(), swizzled, 1_u);
+        b.StoreVectorElement(v, 3_u, elem);
+        auto* lve = b.LoadVectorElement(v, 0_u);
+        auto* neg = b.Negation(ty.f32(), lve);
+        auto* call = b.Call(ty.f32(), helper, neg);
+        auto* built = b.Call(ty.f32(), core::Function::kMax, call, 1_f);
+        auto* bits = b.Bitcast(ty.u32(), built);
+        auto* conv = b.Convert(ty.i32(), bits);
+        auto* cmp = b.Complement(ty.i32(), conv);
+        auto* vec = b.Construct(ty.vec4<f32>(), b.Convert(ty.f32(), cmp), 0_f, 0_f, 1_f);
+        b.Store(v, vec);
+        b.Return(func);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, ControlFlow) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* sel = b.FunctionParam("sel", ty.i32());
+    auto* func = b.Function("foo", ty.i32(), Function::PipelineStage::kFragment);
+    func->SetParams({cond, sel});
+    func->SetReturnLocation(0, {});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        auto* if_result = b.InstructionResult(ty.i32());
+        ifelse->SetResults(Vector{if_result});
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, 1_i);
+        });
+        b.Append(ifelse->False(), [&] {
+            b.Discard();
+            b.ExitIf(ifelse, 2_i);
+        });
+
+        auto* loop = b.Loop();
+        auto* loop_result = b.InstructionResult(ty.i32());
+        loop->SetResults(Vector{loop_result});
+        b.Append(loop->Initializer(), [&] {  //
+            b.NextIteration(loop, if_result);
+        });
+        auto* param = b.BlockParam("i", ty.i32());
+        loop->Body()->SetParams({param});
+        b.Append(loop->Body(), [&] {
+            auto* inner = b.If(b.Equal(ty.bool_(), param, 10_i));
+            b.Append(inner->True(), [&] {  //
+                b.ExitLoop(loop, param);
+            });
+            b.Continue(loop);
+        });
+        b.Append(loop->Continuing(), [&] {  //
+            b.BreakIf(loop, cond, 0_i);
+        });
+
+        auto* s = b.Switch(sel);
+        auto* switch_result = b.InstructionResult(ty.i32());
+        s->SetResults(Vector{switch_result});
+        b.Append(b.Case(s, {Switch::CaseSelector{b.Constant(1_i)},
+                            Switch::CaseSelector{b.Constant(2_i)}}),
+                 [&] {  //
+                     b.ExitSwitch(s, loop_result);
+                 });
+        b.Append(b.Case(s, {Switch::CaseSelector{}}), [&] {  //
+            b.ExitSwitch(s, 3_i);
+        });
+        b.Return(func, switch_result);
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, Terminators) {
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kFragment);
+    b.Append(func->Block(), [&] {  //
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {  //
+            b.TerminateInvocation();
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.Unreachable();
+        });
+        b.Unreachable();
+    });
+    RunTest();
+}
+
+TEST_F(IR_BinaryRoundtripTest, TruncatedData) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        auto* v = b.Var("v", ty.ptr<function, i32>());
+        v->SetInitializer(b.Constant(1_i));
+        b.Return(func, b.Add(ty.i32(), b.Load(v), 2_i));
+    });
+    RunTest();
+
+    // Every strict prefix of the encoding must be rejected without crashing.
+    for (size_t len = 0; len < data.size(); len++) {
+        auto decoded = Decode(Data().Truncate(len));
+        EXPECT_FALSE(decoded) << "prefix of length " << len << " was decoded";
+    }
+}
+
+TEST_F(IR_BinaryRoundtripTest, InvalidHeader) {
+    RunTest();
+
+    auto bad_magic = data;
+    bad_magic[0] = 'X';
+    auto result = Decode({bad_magic.data(), bad_magic.size(), bad_magic.size()});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.Failure(), "invalid magic number");
+
+    auto bad_version = data;
+    bad_version[4] = 0x7f;
+    result = Decode({bad_version.data(), bad_version.size(), bad_version.size()});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.Failure(), "unsupported version");
+}
+
+}  // namespace
+}  // namespace tint::ir::binary
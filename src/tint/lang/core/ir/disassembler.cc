@@ -16,6 +16,7 @@
 
 #include "src//tint/lang/core/ir/unary.h"
 #include "src/tint/lang/core/constant/composite.h"
+#include "src/tint/lang/core/constant/dense_composite.h"
 #include "src/tint/lang/core/constant/scalar.h"
 #include "src/tint/lang/core/constant/splat.h"
 #include "src/tint/lang/core/ir/access.h"
@@ -404,6 +405,45 @@ void Disassembler::EmitValue(Value* val) {
                                 need_comma = true;
                             }
                             out_ << ")";
+                        },
+                        [&](const core::constant::DenseCompositeBase* dense) {
+                            // Emit the element values directly, without creating their scalars.
+                            out_ << dense->Type()->FriendlyName() << "(";
+                            auto emit_values = [&](auto* d, const char* suffix) {
+                                for (size_t i = 0; i < d->values.Length(); i++) {
+                                    if (i > 0) {
+                                        out_ << ", ";
+                                    }
+                                    out_ << d->values[i].value << suffix;
+                                }
+                            };
+                            tint::Switch(
+                                dense,
+                                [&](const core::constant::DenseComposite<AFloat>* d) {
+                                    emit_values(d, "");
+                                },
+                                [&](const core::constant::DenseComposite<AInt>* d) {
+                                    emit_values(d, "");
+                                },
+                                [&](const core::constant::DenseComposite<i32>* d) {
+                                    emit_values(d, "i");
+                                },
+                                [&](const core::constant::DenseComposite<u32>* d) {
+                                    emit_values(d, "u");
+                                },
+                                [&](const core::constant::DenseComposite<f32>* d) {
+                                    emit_values(d, "f");
+                                },
+                                [&](const core::constant::DenseComposite<f16>* d) {
+                                    emit_values(d, "h");
+                                },
+                                [&](const core::constant::DenseComposite<bool>* d) {
+                                    for (size_t i = 0; i < d->values.Length(); i++) {
+                                        out_ << (i > 0 ? ", " : "")
+                                             << (d->values[i] ? "true" : "false");
+                                    }
+                                });
+                            out_ << ")";
                         });
                 };
             emit(constant->Value());
@@ -0,0 +1,1979 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/interpreter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "src/tint/lang/core/constant/value.h"
+#include "src/tint/lang/core/ir/access.h"
+#include "src/tint/lang/core/ir/binary.h"
+#include "src/tint/lang/core/ir/bitcast.h"
+#include "src/tint/lang/core/ir/block_param.h"
+#include "src/tint/lang/core/ir/break_if.h"
+#include "src/tint/lang/core/ir/constant.h"
+#include "src/tint/lang/core/ir/construct.h"
+#include "src/tint/lang/core/ir/continue.h"
+#include "src/tint/lang/core/ir/convert.h"
+#include "src/tint/lang/core/ir/core_builtin_call.h"
+#include "src/tint/lang/core/ir/exit_if.h"
+#include "src/tint/lang/core/ir/exit_loop.h"
+#include "src/tint/lang/core/ir/exit_switch.h"
+#include "src/tint/lang/core/ir/function.h"
+#include "src/tint/lang/core/ir/function_param.h"
+#include "src/tint/lang/core/ir/if.h"
+#include "src/tint/lang/core/ir/instruction_result.h"
+#include "src/tint/lang/core/ir/let.h"
+#include "src/tint/lang/core/ir/load.h"
+#include "src/tint/lang/core/ir/load_vector_element.h"
+#include "src/tint/lang/core/ir/loop.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/multi_in_block.h"
+#include "src/tint/lang/core/ir/next_iteration.h"
+#include "src/tint/lang/core/ir/return.h"
+#include "src/tint/lang/core/ir/store.h"
+#include "src/tint/lang/core/ir/store_vector_element.h"
+#include "src/tint/lang/core/ir/swizzle.h"
+#include "src/tint/lang/core/ir/switch.h"
+#include "src/tint/lang/core/ir/unary.h"
+#include "src/tint/lang/core/ir/user_call.h"
+#include "src/tint/lang/core/ir/var.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/atomic.h"
+#include "src/tint/lang/core/type/bool.h"
+#include "src/tint/lang/core/type/f16.h"
+#include "src/tint/lang/core/type/f32.h"
+#include "src/tint/lang/core/type/i32.h"
+#include "src/tint/lang/core/type/matrix.h"
+#include "src/tint/lang/core/type/pointer.h"
+#include "src/tint/lang/core/type/sampler.h"
+#include "src/tint/lang/core/type/scalar.h"
+#include "src/tint/lang/core/type/struct.h"
+#include "src/tint/lang/core/type/texture.h"
+#include "src/tint/lang/core/type/u32.h"
+#include "src/tint/lang/core/type/vector.h"
+#include "src/tint/utils/rtti/switch.h"
+#include "src/tint/utils/text/string_stream.h"
+
+namespace tint::ir {
+namespace {
+
+/// A pointer value. Pointers carry the end of the memory region that they point into, so that
+/// every memory access can be bounds checked.
+struct Pointer {
+    /// The address of the pointee
+    uint8_t* ptr = nullptr;
+    /// The end of the memory region that holds the pointee
+    uint8_t* end = nullptr;
+
+    /// @param size the number of bytes to access
+    /// @returns true if @p size bytes can be accessed through this pointer
+    bool CanAccess(size_t size) const {
+        return ptr != nullptr && ptr <= end && static_cast<size_t>(end - ptr) >= size;
+    }
+};
+
+/// The bytes of a value. Non-pointer values are held in the host-shareable memory layout of their
+/// type, pointer values hold a Pointer.
+using Bytes = Vector<uint8_t, 16>;
+
+/// The kind of a scalar
+enum class ScalarKind : uint8_t { kBool, kI32, kU32, kF32, kF16 };
+
+/// A scalar value, widened to a 32-bit host type.
+struct Scalar {
+    /// The kind of the scalar
+    ScalarKind kind = ScalarKind::kU32;
+    /// The value of the scalar
+    union {
+        uint32_t u = 0;
+        int32_t i;
+        float f;
+    };
+};
+
+Scalar MakeBool(bool v) {
+    Scalar s;
+    s.kind = ScalarKind::kBool;
+    s.u = v ? 1u : 0u;
+    return s;
+}
+
+Scalar MakeI32(int32_t v) {
+    Scalar s;
+    s.kind = ScalarKind::kI32;
+    s.i = v;
+    return s;
+}
+
+Scalar MakeU32(uint32_t v) {
+    Scalar s;
+    s.kind = ScalarKind::kU32;
+    s.u = v;
+    return s;
+}
+
+Scalar MakeFloat(ScalarKind kind, float v) {
+    Scalar s;
+    s.kind = kind;
+    s.f = kind == ScalarKind::kF16 ? static_cast<float>(f16(v)) : v;
+    return s;
+}
+
+bool IsFloat(ScalarKind kind) {
+    return kind == ScalarKind::kF32 || kind == ScalarKind::kF16;
+}
+
+/// @returns the scalar kind of the scalar type @p ty
+ScalarKind KindOf(const core::type::Type* ty) {
+    return tint::Switch(
+        ty,  //
+        [&](const core::type::Bool*) { return ScalarKind::kBool; },
+        [&](const core::type::I32*) { return ScalarKind::kI32; },
+        [&](const core::type::F32*) { return ScalarKind::kF32; },
+        [&](const core::type::F16*) { return ScalarKind::kF16; },
+        [&](const core::type::Atomic* a) { return KindOf(a->Type()); },
+        [&](Default) { return ScalarKind::kU32; });
+}
+
+/// @returns the scalar element type of the scalar, vector or matrix type @p ty
+const core::type::Type* ScalarTypeOf(const core::type::Type* ty) {
+    return tint::Switch(
+        ty,  //
+        [&](const core::type::Vector* v) { return v->type(); },
+        [&](const core::type::Matrix* m) { return m->type(); },
+        [&](Default) { return ty; });
+}
+
+/// @returns the number of scalar elements of the scalar, vector or matrix type @p ty
+uint32_t ElementCount(const core::type::Type* ty) {
+    return tint::Switch(
+        ty,  //
+        [&](const core::type::Vector* v) { return v->Width(); },
+        [&](const core::type::Matrix* m) { return m->columns() * m->rows(); },
+        [&](Default) { return 1u; });
+}
+
+/// @returns the byte offset of the scalar element @p i of the scalar, vector or matrix type @p ty.
+/// Matrix elements are numbered in column-major order.
+uint32_t ElementOffset(const core::type::Type* ty, uint32_t i) {
+    return tint::Switch(
+        ty,  //
+        [&](const core::type::Vector* v) { return i * v->type()->Size(); },
+        [&](const core::type::Matrix* m) {
+            return (i / m->rows()) * m->ColumnStride() + (i % m->rows()) * m->type()->Size();
+        },
+        [&](Default) { return 0u; });
+}
+
+/// @returns the number of bytes used to hold a value of type @p ty
+uint32_t ValueSize(const core::type::Type* ty) {
+    if (ty->Is<core::type::Pointer>()) {
+        return sizeof(Pointer);
+    }
+    return ty->Size();
+}
+
+Scalar ReadScalar(const uint8_t* ptr, ScalarKind kind) {
+    Scalar s;
+    s.kind = kind;
+    if (kind == ScalarKind::kF16) {
+        uint16_t bits = 0;
+        memcpy(&bits, ptr, sizeof(bits));
+        s.f = static_cast<float>(f16::FromBits(bits));
+    } else {
+        memcpy(&s.u, ptr, sizeof(s.u));
+        if (kind == ScalarKind::kBool) {
+            s.u = s.u != 0 ? 1u : 0u;
+        }
+    }
+    return s;
+}
+
+void WriteScalar(uint8_t* ptr, const Scalar& s) {
+    if (s.kind == ScalarKind::kF16) {
+        uint16_t bits = f16(s.f).BitsRepresentation();
+        memcpy(ptr, &bits, sizeof(bits));
+    } else {
+        memcpy(ptr, &s.u, sizeof(s.u));
+    }
+}
+
+/// @returns the scalar element @p i of the value @p bytes of type @p ty. If @p ty only has a single
+/// element, then that element is returned for every @p i.
+Scalar ReadElement(const Bytes& bytes, const core::type::Type* ty, uint32_t i) {
+    if (ElementCount(ty) == 1) {
+        i = 0;
+    }
+    return ReadScalar(bytes.begin() + ElementOffset(ty, i), KindOf(ScalarTypeOf(ty)));
+}
+
+Pointer AsPointer(const Bytes& bytes) {
+    Pointer p;
+    memcpy(&p, bytes.begin(), sizeof(p));
+    return p;
+}
+
+Bytes FromPointer(const Pointer& p) {
+    Bytes bytes;
+    bytes.Resize(sizeof(p));
+    memcpy(bytes.begin(), &p, sizeof(p));
+    return bytes;
+}
+
+Bytes Zero(const core::type::Type* ty) {
+    Bytes bytes;
+    bytes.Resize(ValueSize(ty), 0);
+    return bytes;
+}
+
+/// @returns @p v converted to the scalar kind @p to, using the WGSL conversion rules
+Scalar ConvertScalar(const Scalar& v, ScalarKind to) {
+    switch (to) {
+        case ScalarKind::kBool:
+            return MakeBool(IsFloat(v.kind) ? v.f != 0.0f : v.u != 0);
+        case ScalarKind::kF32:
+        case ScalarKind::kF16:
+            switch (v.kind) {
+                case ScalarKind::kI32:
+                    return MakeFloat(to, static_cast<float>(v.i));
+                case ScalarKind::kU32:
+                case ScalarKind::kBool:
+                    return MakeFloat(to, static_cast<float>(v.u));
+                default:
+                    return MakeFloat(to, v.f);
+            }
+        case ScalarKind::kI32:
+            if (IsFloat(v.kind)) {
+                // Float to integer conversions saturate.
+                if (std::isnan(v.f)) {
+                    return MakeI32(0);
+                }
+                constexpr float kLow = static_cast<float>(std::numeric_limits<int32_t>::min());
+                constexpr float kHigh = 2147483520.0f;  // Largest f32 below 2^31
+                return MakeI32(static_cast<int32_t>(std::min(std::max(v.f, kLow), kHigh)));
+            }
+            return MakeI32(static_cast<int32_t>(v.u));
+        case ScalarKind::kU32:
+            if (IsFloat(v.kind)) {
+                if (std::isnan(v.f)) {
+                    return MakeU32(0);
+                }
+                constexpr float kHigh = 4294967040.0f;  // Largest f32 below 2^32
+                return MakeU32(static_cast<uint32_t>(std::min(std::max(v.f, 0.0f), kHigh)));
+            }
+            return MakeU32(v.u);
+    }
+    return v;
+}
+
+/// @returns the result of the binary operation @p kind on the scalars @p a and @p b
+Scalar ScalarBinary(enum Binary::Kind kind, const Scalar& a, const Scalar& b) {
+    using Kind = enum Binary::Kind;
+    switch (kind) {
+        case Kind::kEqual:
+            return MakeBool(IsFloat(a.kind) ? a.f == b.f : a.u == b.u);
+        case Kind::kNotEqual:
+            return MakeBool(IsFloat(a.kind) ? a.f != b.f : a.u != b.u);
+        case Kind::kLessThan:
+        case Kind::kGreaterThan:
+        case Kind::kLessThanEqual:
+        case Kind::kGreaterThanEqual: {
+            int cmp = 0;
+            if (IsFloat(a.kind)) {
+                if (std::isnan(a.f) || std::isnan(b.f)) {
+                    return MakeBool(false);
+                }
+                cmp = a.f < b.f ? -1 : (a.f > b.f ? 1 : 0);
+            } else if (a.kind == ScalarKind::kI32) {
+                cmp = a.i < b.i ? -1 : (a.i > b.i ? 1 : 0);
+            } else {
+                cmp = a.u < b.u ? -1 : (a.u > b.u ? 1 : 0);
+            }
+            switch (kind) {
+                case Kind::kLessThan:
+                    return MakeBool(cmp < 0);
+                case Kind::kGreaterThan:
+                    return MakeBool(cmp > 0);
+                case Kind::kLessThanEqual:
+                    return MakeBool(cmp <= 0);
+                default:
+                    return MakeBool(cmp >= 0);
+            }
+        }
+        default:
+            break;
+    }
+
+    Scalar r;
+    r.kind = a.kind;
+    if (IsFloat(a.kind)) {
+        switch (kind) {
+            case Kind::kAdd:
+                return MakeFloat(a.kind, a.f + b.f);
+            case Kind::kSubtract:
+                return MakeFloat(a.kind, a.f - b.f);
+            case Kind::kMultiply:
+                return MakeFloat(a.kind, a.f * b.f);
+            case Kind::kDivide:
+                return MakeFloat(a.kind, a.f / b.f);
+            case Kind::kModulo:
+                return MakeFloat(a.kind, std::fmod(a.f, b.f));
+            default:
+                return r;
+        }
+    }
+
+    // Integer arithmetic is performed on unsigned values so that overflow wraps.
+    bool is_signed = a.kind == ScalarKind::kI32;
+    switch (kind) {
+        case Kind::kAdd:
+            r.u = a.u + b.u;
+            break;
+        case Kind::kSubtract:
+            r.u = a.u - b.u;
+            break;
+        case Kind::kMultiply:
+            r.u = a.u * b.u;
+            break;
+        case Kind::kDivide:
+            if (b.u == 0) {
+                r.u = a.u;
+            } else if (is_signed) {
+                bool overflow = a.i == std::numeric_limits<int32_t>::min() && b.i == -1;
+                r.i = overflow ? a.i : a.i / b.i;
+            } else {
+                r.u = a.u / b.u;
+            }
+            break;
+        case Kind::kModulo:
+            if (b.u == 0) {
+                r.u = 0;
+            } else if (is_signed) {
+                bool overflow = a.i == std::numeric_limits<int32_t>::min() && b.i == -1;
+                r.i = overflow ? 0 : a.i % b.i;
+            } else {
+                r.u = a.u % b.u;
+            }
+            break;
+        case Kind::kAnd:
+            r.u = a.u & b.u;
+            break;
+        case Kind::kOr:
+            r.u = a.u | b.u;
+            break;
+        case Kind::kXor:
+            r.u = a.u ^ b.u;
+            break;
+        case Kind::kShiftLeft:
+            r.u = a.u << (b.u & 31);
+            break;
+        case Kind::kShiftRight:
+            if (is_signed) {
+                r.i = a.i >> (b.u & 31);
+            } else {
+                r.u = a.u >> (b.u & 31);
+            }
+            break;
+        default:
+            break;
+    }
+    return r;
+}
+
+uint32_t CountLeadingZeros(uint32_t v) {
+    uint32_t count = 0;
+    for (uint32_t bit = 0x80000000u; bit != 0 && (v & bit) == 0; bit >>= 1) {
+        count++;
+    }
+    return count;
+}
+
+uint32_t CountTrailingZeros(uint32_t v) {
+    uint32_t count = 0;
+    for (uint32_t bit = 1; bit != 0 && (v & bit) == 0; bit <<= 1) {
+        count++;
+    }
+    return count;
+}
+
+/// The information about a module-scope variable.
+struct GlobalVar {
+    /// The variable
+    Var* var = nullptr;
+    /// The address space of the variable
+    core::AddressSpace address_space = core::AddressSpace::kUndefined;
+    /// The byte offset of the variable in the private or workgroup memory block
+    uint32_t offset = 0;
+    /// The size in bytes of the variable
+    uint32_t size = 0;
+};
+
+/// Describes where the value of an IR value is held during execution.
+struct OperandInfo {
+    /// The kind of value
+    enum class Kind : uint8_t {
+        /// The value is held in a slot of the call frame
+        kSlot,
+        /// The value is an encoded constant
+        kConstant,
+        /// The value is a pointer to a module-scope variable
+        kGlobal,
+    };
+    /// The kind of value
+    Kind kind = Kind::kSlot;
+    /// The index of the slot, constant or global
+    uint32_t index = 0;
+};
+
+/// The information about a function, computed ahead of execution.
+struct FunctionInfo {
+    /// The function
+    Function* func = nullptr;
+    /// The number of value slots used by the function
+    uint32_t num_slots = 0;
+    /// The number of bytes used by the function-scope variables
+    uint32_t locals_size = 0;
+};
+
+/// @returns @p size rounded up to a multiple of @p align
+uint32_t RoundUp(uint32_t size, uint32_t align) {
+    align = std::max(align, 1u);
+    return (size + align - 1) / align * align;
+}
+
+/// @returns the number of 64-bit words required to hold @p size bytes
+size_t WordsFor(uint32_t size) {
+    return (static_cast<size_t>(size) + 7) / 8;
+}
+
+/// The immutable information about a module, computed ahead of execution.
+struct PreparedModule {
+    /// Constructor
+    /// @param m the module
+    explicit PreparedModule(Module& m) : mod(m) {
+        if (mod.root_block) {
+            for (auto* inst : *mod.root_block) {
+                auto* var = inst->As<Var>();
+                if (!var) {
+                    Fail() << "unsupported module-scope instruction: " << inst->FriendlyName();
+                    continue;
+                }
+                auto* ptr = var->Result()->Type()->As<core::type::Pointer>();
+                GlobalVar global;
+                global.var = var;
+                global.address_space = ptr->AddressSpace();
+                global.size = ptr->StoreType()->Size();
+                if (global.address_space == core::AddressSpace::kPrivate) {
+                    private_size = RoundUp(private_size, ptr->StoreType()->Align());
+                    global.offset = private_size;
+                    private_size += global.size;
+                    if (auto* init = var->Initializer()) {
+                        if (auto* c = init->As<ir::Constant>()) {
+                            AddConstant(c);
+                        } else {
+                            Fail() << "module-scope initializers must be constants";
+                        }
+                    }
+                } else if (global.address_space == core::AddressSpace::kWorkgroup) {
+                    workgroup_size = RoundUp(workgroup_size, ptr->StoreType()->Align());
+                    global.offset = workgroup_size;
+                    workgroup_size += global.size;
+                }
+                operands.Add(var->Result(), OperandInfo{OperandInfo::Kind::kGlobal,
+                                                        static_cast<uint32_t>(globals.size())});
+                globals.push_back(global);
+            }
+        }
+
+        for (auto* func : mod.functions) {
+            FunctionInfo info;
+            info.func = func;
+            for (auto* param : func->Params()) {
+                AddSlot(param, info);
+            }
+            PrepareBlock(func->Block(), info);
+            function_indices.Add(func, static_cast<uint32_t>(functions.size()));
+            functions.push_back(info);
+        }
+    }
+
+    /// Assigns a frame slot to a value.
+    /// @param value the value
+    /// @param info the function that produces the value
+    void AddSlot(Value* value, FunctionInfo& info) {
+        if (value) {
+            operands.Add(value, OperandInfo{OperandInfo::Kind::kSlot, info.num_slots++});
+        }
+    }
+
+    /// Encodes a constant, if it has not already been encoded.
+    /// @param c the constant
+    void AddConstant(ir::Constant* c) {
+        if (operands.Find(c)) {
+            return;
+        }
+        Bytes bytes = Zero(c->Type());
+        Encode(c->Value(), bytes.begin());
+        operands.Add(c, OperandInfo{OperandInfo::Kind::kConstant,
+                                    static_cast<uint32_t>(constants.size())});
+        constants.push_back(std::move(bytes));
+    }
+
+    /// Writes the constant value @p value to @p out, using the host-shareable layout of its type.
+    /// @param value the constant value
+    /// @param out the memory to write to
+    void Encode(const core::constant::Value* value, uint8_t* out) {
+        tint::Switch(
+            value->Type(),  //
+            [&](const core::type::Vector* v) {
+                for (uint32_t i = 0; i < v->Width(); i++) {
+                    Encode(value->Index(i), out + i * v->type()->Size());
+                }
+            },
+            [&](const core::type::Matrix* m) {
+                for (uint32_t i = 0; i < m->columns(); i++) {
+                    Encode(value->Index(i), out + i * m->ColumnStride());
+                }
+            },
+            [&](const core::type::Array* a) {
+                for (size_t i = 0; i < value->NumElements(); i++) {
+                    Encode(value->Index(i), out + i * a->Stride());
+                }
+            },
+            [&](const core::type::Struct* s) {
+                for (auto* member : s->Members()) {
+                    Encode(value->Index(member->Index()), out + member->Offset());
+                }
+            },
+            [&](Default) {
+                Scalar s;
+                s.kind = KindOf(value->Type());
+                switch (s.kind) {
+                    case ScalarKind::kBool:
+                        s.u = value->ValueAs<bool>() ? 1u : 0u;
+                        break;
+                    case ScalarKind::kI32:
+                        s.i = value->ValueAs<int32_t>();
+                        break;
+                    case ScalarKind::kU32:
+                        s.u = value->ValueAs<uint32_t>();
+                        break;
+                    case ScalarKind::kF32:
+                    case ScalarKind::kF16:
+                        s.f = value->ValueAs<float>();
+                        break;
+                }
+                WriteScalar(out, s);
+            });
+    }
+
+    /// Assigns slots, local variable offsets and constants for all the instructions in a block.
+    /// @param block the block
+    /// @param info the function that contains the block
+    void PrepareBlock(Block* block, FunctionInfo& info) {
+        if (auto* mib = block->As<MultiInBlock>()) {
+            for (auto* param : mib->Params()) {
+                AddSlot(param, info);
+            }
+        }
+        for (auto* inst : *block) {
+            for (auto* operand : inst->Operands()) {
+                if (auto* c = As<ir::Constant>(operand)) {
+                    AddConstant(c);
+                }
+            }
+            for (auto* result : inst->Results()) {
+                AddSlot(result, info);
+            }
+            if (auto* var = inst->As<Var>()) {
+                auto* store_type = var->Result()->Type()->UnwrapPtr();
+                info.locals_size = RoundUp(info.locals_size, store_type->Align());
+                local_offsets.Add(var, info.locals_size);
+                info.locals_size += store_type->Size();
+            }
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* b) { PrepareBlock(b, info); });
+            }
+        }
+    }
+
+    /// Records a preparation error.
+    /// @returns the stream to write the error message to
+    StringStream& Fail() {
+        if (!error.str().empty()) {
+            error << "\n";
+        }
+        return error;
+    }
+
+    /// The module
+    Module& mod;
+    /// The map of IR value to where the value is held during execution
+    Hashmap<Value*, OperandInfo, 64> operands;
+    /// The byte offsets of the function-scope variables in the locals of their frame
+    Hashmap<Var*, uint32_t, 16> local_offsets;
+    /// The map of function to index in `functions`
+    Hashmap<Function*, uint32_t, 8> function_indices;
+    /// The information about each function
+    std::vector<FunctionInfo> functions;
+    /// The encoded constants
+    std::vector<Bytes> constants;
+    /// The module-scope variables
+    std::vector<GlobalVar> globals;
+    /// The size in bytes of the private memory block of an invocation
+    uint32_t private_size = 0;
+    /// The size in bytes of the workgroup memory block of a workgroup
+    uint32_t workgroup_size = 0;
+    /// Errors raised while preparing the module
+    StringStream error;
+};
+
+/// The state of a single dispatch, shared by all the tasks that execute it.
+struct DispatchState {
+    /// The entry point
+    Function* entry_point = nullptr;
+    /// The workgroup size
+    std::array<uint32_t, 3> workgroup_size{};
+    /// The number of workgroups in each dimension
+    std::array<uint32_t, 3> workgroup_count{};
+    /// The total number of workgroups
+    uint32_t total_workgroups = 0;
+    /// The pointer to each buffer variable, indexed by global variable index
+    std::vector<Pointer> buffers;
+    /// The mutex that makes atomic operations atomic
+    std::mutex atomic_mutex;
+    /// The index of the next workgroup to execute
+    std::atomic<uint32_t> next_workgroup{0};
+    /// True if any workgroup failed
+    std::atomic<bool> failed{false};
+    /// The mutex that guards `error`
+    std::mutex error_mutex;
+    /// The first error that was encountered
+    std::string error;
+};
+
+/// A call frame of an invocation.
+struct Frame {
+    /// The function being executed
+    const FunctionInfo* info = nullptr;
+    /// The values produced by the function
+    std::vector<Bytes> slots;
+    /// The memory of the function-scope variables
+    std::vector<uint64_t> locals;
+    /// The next instruction to execute. For a frame that is waiting for a call to return, this is
+    /// the call instruction.
+    Instruction* pc = nullptr;
+};
+
+/// The state of a single invocation.
+struct Invocation {
+    /// The local invocation ID
+    std::array<uint32_t, 3> local_id{};
+    /// The local invocation index
+    uint32_t local_index = 0;
+    /// The private memory of the invocation
+    std::vector<uint64_t> private_memory;
+    /// The pointer values of the module-scope variables
+    std::vector<Bytes> globals;
+    /// The call stack
+    std::vector<Frame> frames;
+    /// The number of times the invocation has yielded on the current barrier instruction
+    uint32_t barrier_phase = 0;
+    /// True once the entry point has returned
+    bool done = false;
+};
+
+/// The result of resuming an invocation.
+enum class Status {
+    /// The invocation is waiting on a barrier
+    kBarrier,
+    /// The invocation has returned from the entry point
+    kDone,
+    /// The invocation raised an error
+    kError,
+};
+
+/// Executor executes the workgroups claimed by a single task of a dispatch.
+class Executor {
+  public:
+    /// Constructor
+    /// @param state the interpreter state
+    /// @param dispatch the dispatch state
+    Executor(const PreparedModule& state, DispatchState& dispatch)
+        : state_(state), dispatch_(dispatch) {}
+
+    /// Executes workgroups until there are none left, or a workgroup fails.
+    void Run() {
+        while (!dispatch_.failed) {
+            uint32_t index = dispatch_.next_workgroup++;
+            if (index >= dispatch_.total_workgroups) {
+                return;
+            }
+            if (!ExecuteWorkgroup(index)) {
+                std::lock_guard<std::mutex> lock(dispatch_.error_mutex);
+                if (!dispatch_.failed) {
+                    dispatch_.error = error_.str();
+                    dispatch_.failed = true;
+                }
+                return;
+            }
+        }
+    }
+
+  private:
+    /// Executes all the invocations of a workgroup.
+    /// @param index the linear index of the workgroup
+    /// @returns true on success
+    bool ExecuteWorkgroup(uint32_t index) {
+        auto& count = dispatch_.workgroup_count;
+        workgroup_id_ = {index % count[0], (index / count[0]) % count[1],
+                         index / (count[0] * count[1])};
+
+        workgroup_memory_.assign(WordsFor(state_.workgroup_size), 0);
+
+        auto& size = dispatch_.workgroup_size;
+        invocations_.resize(size[0] * size[1] * size[2]);
+        for (uint32_t i = 0; i < invocations_.size(); i++) {
+            if (!Reset(invocations_[i], i)) {
+                return false;
+            }
+        }
+
+        while (true) {
+            uint32_t num_done = 0;
+            uint32_t num_waiting = 0;
+            for (auto& inv : invocations_) {
+                if (inv.done) {
+                    num_done++;
+                    continue;
+                }
+                switch (Resume(inv)) {
+                    case Status::kBarrier:
+                        num_waiting++;
+                        break;
+                    case Status::kDone:
+                        inv.done = true;
+                        num_done++;
+                        break;
+                    case Status::kError:
+                        return false;
+                }
+            }
+            if (num_waiting == 0) {
+                return true;
+            }
+            if (num_done != 0) {
+                error_ << "barrier reached in non-uniform control flow";
+                return false;
+            }
+            if (dispatch_.failed) {
+                // Another task failed, so abandon this workgroup.
+                return true;
+            }
+        }
+    }
+
+    /// Prepares an invocation to execute the entry point from the start.
+    /// @param inv the invocation
+    /// @param local_index the local invocation index
+    /// @returns true on success
+    bool Reset(Invocation& inv, uint32_t local_index) {
+        auto& size = dispatch_.workgroup_size;
+        inv.local_index = local_index;
+        inv.local_id = {local_index % size[0], (local_index / size[0]) % size[1],
+                        local_index / (size[0] * size[1])};
+        inv.barrier_phase = 0;
+        inv.done = false;
+
+        inv.private_memory.assign(WordsFor(state_.private_size), 0);
+        auto* private_base = reinterpret_cast<uint8_t*>(inv.private_memory.data());
+        auto* workgroup_base = reinterpret_cast<uint8_t*>(workgroup_memory_.data());
+
+        inv.globals.resize(state_.globals.size());
+        for (size_t i = 0; i < state_.globals.size(); i++) {
+            auto& global = state_.globals[i];
+            Pointer p;
+            switch (global.address_space) {
+                case core::AddressSpace::kPrivate:
+                    p.ptr = private_base + global.offset;
+                    p.end = p.ptr + global.size;
+                    if (auto* init = global.var->Initializer()) {
+                        auto& value = Get(inv, nullptr, init);
+                        memcpy(p.ptr, value.begin(), global.size);
+                    }
+                    break;
+                case core::AddressSpace::kWorkgroup:
+                    p.ptr = workgroup_base + global.offset;
+                    p.end = p.ptr + global.size;
+                    break;
+                default:
+                    p = dispatch_.buffers[i];
+                    break;
+            }
+            inv.globals[i] = FromPointer(p);
+        }
+
+        inv.frames.clear();
+        Frame& frame = PushFrame(inv, dispatch_.entry_point);
+        auto params = dispatch_.entry_point->Params();
+        for (size_t i = 0; i < params.Length(); i++) {
+            auto* param = params[i];
+            Bytes value = Zero(param->Type());
+            if (auto builtin = param->Builtin()) {
+                WriteBuiltin(inv, ToBuiltinValue(*builtin), value.begin());
+            } else if (auto* str = param->Type()->As<core::type::Struct>()) {
+                for (auto* member : str->Members()) {
+                    if (auto member_builtin = member->Attributes().builtin) {
+                        WriteBuiltin(inv, *member_builtin, value.begin() + member->Offset());
+                    }
+                }
+            }
+            frame.slots[Slot(param)] = std::move(value);
+        }
+        return true;
+    }
+
+    /// @returns the builtin value for the function parameter builtin @p builtin
+    static core::BuiltinValue ToBuiltinValue(enum FunctionParam::Builtin builtin) {
+        switch (builtin) {
+            case FunctionParam::Builtin::kLocalInvocationId:
+                return core::BuiltinValue::kLocalInvocationId;
+            case FunctionParam::Builtin::kLocalInvocationIndex:
+                return core::BuiltinValue::kLocalInvocationIndex;
+            case FunctionParam::Builtin::kGlobalInvocationId:
+                return core::BuiltinValue::kGlobalInvocationId;
+            case FunctionParam::Builtin::kWorkgroupId:
+                return core::BuiltinValue::kWorkgroupId;
+            case FunctionParam::Builtin::kNumWorkgroups:
+                return core::BuiltinValue::kNumWorkgroups;
+            default:
+                return core::BuiltinValue::kUndefined;
+        }
+    }
+
+    /// Writes the value of a compute shader builtin for an invocation.
+    /// @param inv the invocation
+    /// @param builtin the builtin value
+    /// @param out the memory to write to
+    void WriteBuiltin(const Invocation& inv, core::BuiltinValue builtin, uint8_t* out) {
+        std::array<uint32_t, 3> value{};
+        switch (builtin) {
+            case core::BuiltinValue::kLocalInvocationId:
+                value = inv.local_id;
+                break;
+            case core::BuiltinValue::kLocalInvocationIndex:
+                memcpy(out, &inv.local_index, sizeof(uint32_t));
+                return;
+            case core::BuiltinValue::kGlobalInvocationId:
+                for (size_t i = 0; i < 3; i++) {
+                    value[i] = workgroup_id_[i] * dispatch_.workgroup_size[i] + inv.local_id[i];
+                }
+                break;
+            case core::BuiltinValue::kWorkgroupId:
+                value = workgroup_id_;
+                break;
+            case core::BuiltinValue::kNumWorkgroups:
+                value = dispatch_.workgroup_count;
+                break;
+            default:
+                return;
+        }
+        memcpy(out, value.data(), sizeof(value));
+    }
+
+    /// Pushes a new call frame for @p func.
+    /// @param inv the invocation
+    /// @param func the function
+    /// @returns the new frame
+    Frame& PushFrame(Invocation& inv, Function* func) {
+        auto& info = state_.functions[*state_.function_indices.Get(func)];
+        Frame& frame = inv.frames.emplace_back();
+        frame.info = &info;
+        frame.slots.resize(info.num_slots);
+        frame.locals.assign(WordsFor(info.locals_size), 0);
+        frame.pc = func->Block()->Front();
+        return frame;
+    }
+
+    /// @returns the frame slot index of @p value
+    uint32_t Slot(Value* value) const { return state_.operands.Get(value)->index; }
+
+    /// @returns the bytes of the value @p value
+    /// @param inv the invocation
+    /// @param frame the current frame, or nullptr if evaluating a module-scope value
+    /// @param value the IR value
+    const Bytes& Get(const Invocation& inv, const Frame* frame, Value* value) const {
+        auto info = state_.operands.Get(value);
+        TINT_ASSERT(info);
+        switch (info->kind) {
+            case OperandInfo::Kind::kConstant:
+                return state_.constants[info->index];
+            case OperandInfo::Kind::kGlobal:
+                return inv.globals[info->index];
+            case OperandInfo::Kind::kSlot:
+                break;
+        }
+        return frame->slots[info->index];
+    }
+
+    /// Sets the value of an instruction result or block parameter.
+    /// @param frame the current frame
+    /// @param value the IR value
+    /// @param bytes the new value
+    void Set(Frame& frame, Value* value, Bytes bytes) {
+        if (value) {
+            frame.slots[Slot(value)] = std::move(bytes);
+        }
+    }
+
+    /// @returns an integer index held by @p value, or -1 if the index is negative
+    int64_t Index(const Invocation& inv, const Frame& frame, Value* value) const {
+        Scalar s = ReadScalar(Get(inv, &frame, value).begin(), KindOf(value->Type()));
+        if (s.kind == ScalarKind::kI32) {
+            return s.i;
+        }
+        return s.u;
+    }
+
+    /// Assigns @p args to the block parameters or control instruction results @p targets.
+    template <typename TARGETS>
+    void Assign(const Invocation& inv, Frame& frame, TARGETS&& targets, Slice<Value* const> args) {
+        // Evaluate all the arguments before assigning, as the targets may be used by the args.
+        Vector<Bytes, 4> values;
+        for (auto* arg : args) {
+            values.Push(Get(inv, &frame, arg));
+        }
+        for (size_t i = 0; i < values.Length() && i < targets.Length(); i++) {
+            Set(frame, targets[i], std::move(values[i]));
+        }
+    }
+
+    /// Executes an invocation until it reaches a barrier, returns from the entry point, or fails.
+    /// @param inv the invocation
+    /// @returns the status of the invocation
+    Status Resume(Invocation& inv) {
+        while (true) {
+            Frame& frame = inv.frames.back();
+            Instruction* inst = frame.pc;
+            if (!inst) {
+                error_ << "reached the end of a block without a terminator";
+                return Status::kError;
+            }
+
+            std::optional<Status> status;
+            bool ok = tint::Switch(
+                inst,  //
+                [&](Var* var) { return ExecVar(inv, frame, var); },
+                [&](Let* let) {
+                    Set(frame, let->Result(), Get(inv, &frame, let->Value()));
+                    frame.pc = let->next;
+                    return true;
+                },
+                [&](Load* load) { return ExecLoad(inv, frame, load); },
+                [&](Store* store) { return ExecStore(inv, frame, store); },
+                [&](LoadVectorElement* load) { return ExecLoadVectorElement(inv, frame, load); },
+                [&](StoreVectorElement* store) {
+                    return ExecStoreVectorElement(inv, frame, store);
+                },
+                [&](Access* access) { return ExecAccess(inv, frame, access); },
+                [&](Swizzle* swizzle) { return ExecSwizzle(inv, frame, swizzle); },
+                [&](Binary* binary) { return ExecBinary(inv, frame, binary); },
+                [&](Unary* unary) { return ExecUnary(inv, frame, unary); },
+                [&](Convert* convert) { return ExecConvert(inv, frame, convert); },
+                [&](Bitcast* bitcast) { return ExecBitcast(inv, frame, bitcast); },
+                [&](Construct* construct) { return ExecConstruct(inv, frame, construct); },
+                [&](CoreBuiltinCall* call) { return ExecBuiltin(inv, frame, call, status); },
+                [&](UserCall* call) {
+                    Vector<Bytes, 4> args;
+                    for (auto* arg : call->Args()) {
+                        args.Push(Get(inv, &frame, arg));
+                    }
+                    // Note: PushFrame() invalidates `frame`.
+                    Frame& callee = PushFrame(inv, call->Func());
+                    auto params = call->Func()->Params();
+                    for (size_t i = 0; i < params.Length(); i++) {
+                        Set(callee, params[i], std::move(args[i]));
+                    }
+                    return true;
+                },
+                [&](If* if_) {
+                    bool cond = ReadScalar(Get(inv, &frame, if_->Condition()).begin(),
+                                           ScalarKind::kBool)
+                                    .u != 0;
+                    auto* block = cond ? if_->True() : if_->False();
+                    // An empty block implicitly exits the if.
+                    frame.pc = block->IsEmpty() ? if_->next : block->Front();
+                    return true;
+                },
+                [&](Switch* switch_) { return ExecSwitch(inv, frame, switch_); },
+                [&](Loop* loop) {
+                    frame.pc = loop->HasInitializer() ? loop->Initializer()->Front()
+                                                      : loop->Body()->Front();
+                    return true;
+                },
+                [&](ExitIf* exit) {
+                    Assign(inv, frame, exit->If()->Results(), exit->Args());
+                    frame.pc = exit->If()->next;
+                    return true;
+                },
+                [&](ExitSwitch* exit) {
+                    Assign(inv, frame, exit->Switch()->Results(), exit->Args());
+                    frame.pc = exit->Switch()->next;
+                    return true;
+                },
+                [&](ExitLoop* exit) {
+                    Assign(inv, frame, exit->Loop()->Results(), exit->Args());
+                    frame.pc = exit->Loop()->next;
+                    return true;
+                },
+                [&](NextIteration* next) {
+                    Assign(inv, frame, next->Loop()->Body()->Params(), next->Args());
+                    frame.pc = next->Loop()->Body()->Front();
+                    return true;
+                },
+                [&](Continue* cont) {
+                    Assign(inv, frame, cont->Loop()->Continuing()->Params(), cont->Args());
+                    frame.pc = cont->Loop()->Continuing()->Front();
+                    return true;
+                },
+                [&](BreakIf* break_if) {
+                    bool cond = ReadScalar(Get(inv, &frame, break_if->Condition()).begin(),
+                                           ScalarKind::kBool)
+                                    .u != 0;
+                    if (cond) {
+                        frame.pc = break_if->Loop()->next;
+                    } else {
+                        Assign(inv, frame, break_if->Loop()->Body()->Params(), break_if->Args());
+                        frame.pc = break_if->Loop()->Body()->Front();
+                    }
+                    return true;
+                },
+                [&](Return* ret) {
+                    std::optional<Bytes> value;
+                    if (ret->Value()) {
+                        value = Get(inv, &frame, ret->Value());
+                    }
+                    inv.frames.pop_back();
+                    if (inv.frames.empty()) {
+                        status = Status::kDone;
+                        return true;
+                    }
+                    Frame& caller = inv.frames.back();
+                    if (value) {
+                        Set(caller, caller.pc->Result(0), std::move(*value));
+                    }
+                    caller.pc = caller.pc->next;
+                    return true;
+                },
+                [&](Default) {
+                    error_ << "unsupported instruction: " << inst->FriendlyName();
+                    return false;
+                });
+
+            if (!ok) {
+                return Status::kError;
+            }
+            if (status) {
+                return *status;
+            }
+        }
+    }
+
+    bool ExecVar(Invocation& inv, Frame& frame, Var* var) {
+        auto* store_type = var->Result()->Type()->UnwrapPtr();
+        Pointer p;
+        p.ptr = reinterpret_cast<uint8_t*>(frame.locals.data()) +
+                *state_.local_offsets.Get(var);
+        p.end = p.ptr + store_type->Size();
+        if (auto* init = var->Initializer()) {
+            memcpy(p.ptr, Get(inv, &frame, init).begin(), store_type->Size());
+        } else {
+            memset(p.ptr, 0, store_type->Size());
+        }
+        Set(frame, var->Result(), FromPointer(p));
+        frame.pc = var->next;
+        return true;
+    }
+
+    bool ExecLoad(Invocation& inv, Frame& frame, Load* load) {
+        auto* type = load->Result()->Type();
+        if (type->IsAnyOf<core::type::Texture, core::type::Sampler>()) {
+            error_ << "textures and samplers are not supported";
+            return false;
+        }
+        Pointer p = AsPointer(Get(inv, &frame, load->From()));
+        Bytes value = Zero(type);
+        if (p.CanAccess(value.Length())) {
+            memcpy(value.begin(), p.ptr, value.Length());
+        }
+        Set(frame, load->Result(), std::move(value));
+        frame.pc = load->next;
+        return true;
+    }
+
+    bool ExecStore(Invocation& inv, Frame& frame, Store* store) {
+        Pointer p = AsPointer(Get(inv, &frame, store->To()));
+        auto& value = Get(inv, &frame, store->From());
+        size_t size = store->From()->Type()->Size();
+        if (p.CanAccess(size)) {
+            memcpy(p.ptr, value.begin(), size);
+        }
+        frame.pc = store->next;
+        return true;
+    }
+
+    bool ExecLoadVectorElement(Invocation& inv, Frame& frame, LoadVectorElement* load) {
+        auto* vec = load->From()->Type()->UnwrapPtr()->As<core::type::Vector>();
+        Pointer p = AsPointer(Get(inv, &frame, load->From()));
+        int64_t index = Index(inv, frame, load->Index());
+        Bytes value = Zero(load->Result()->Type());
+        if (index >= 0 && index < vec->Width()) {
+            p.ptr += index * vec->type()->Size();
+            if (p.CanAccess(value.Length())) {
+                memcpy(value.begin(), p.ptr, value.Length());
+            }
+        }
+        Set(frame, load->Result(), std::move(value));
+        frame.pc = load->next;
+        return true;
+    }
+
+    bool ExecStoreVectorElement(Invocation& inv, Frame& frame, StoreVectorElement* store) {
+        auto* vec = store->To()->Type()->UnwrapPtr()->As<core::type::Vector>();
+        Pointer p = AsPointer(Get(inv, &frame, store->To()));
+        int64_t index = Index(inv, frame, store->Index());
+        size_t size = vec->type()->Size();
+        if (index >= 0 && index < vec->Width()) {
+            p.ptr += index * size;
+            if (p.CanAccess(size)) {
+                memcpy(p.ptr, Get(inv, &frame, store->Value()).begin(), size);
+            }
+        }
+        frame.pc = store->next;
+        return true;
+    }
+
+    bool ExecAccess(Invocation& inv, Frame& frame, Access* access) {
+        auto* object_type = access->Object()->Type();
+        auto* ptr = object_type->As<core::type::Pointer>();
+        const core::type::Type* type = ptr ? ptr->StoreType() : object_type;
+
+        uint64_t offset = 0;
+        bool out_of_bounds = false;
+        for (auto* index_value : access->Indices()) {
+            int64_t index = Index(inv, frame, index_value);
+            if (index < 0) {
+                out_of_bounds = true;
+                index = 0;
+            }
+            tint::Switch(
+                type,  //
+                [&](const core::type::Vector* v) {
+                    out_of_bounds |= index >= v->Width();
+                    offset += index * v->type()->Size();
+                    type = v->type();
+                },
+                [&](const core::type::Matrix* m) {
+                    out_of_bounds |= index >= m->columns();
+                    offset += index * m->ColumnStride();
+                    type = m->ColumnType();
+                },
+                [&](const core::type::Array* a) {
+                    if (auto count = a->ConstantCount()) {
+                        out_of_bounds |= index >= *count;
+                    }
+                    offset += index * a->Stride();
+                    type = a->ElemType();
+                },
+                [&](const core::type::Struct* s) {
+                    auto* member = s->Members()[static_cast<size_t>(index)];
+                    offset += member->Offset();
+                    type = member->Type();
+                });
+        }
+
+        auto& object = Get(inv, &frame, access->Object());
+        if (ptr) {
+            Pointer p = AsPointer(object);
+            if (out_of_bounds || !p.CanAccess(offset)) {
+                // Any access through the resulting pointer is out of bounds.
+                p.ptr = p.end;
+            } else {
+                p.ptr += offset;
+            }
+            Set(frame, access->Result(), FromPointer(p));
+        } else {
+            Bytes value = Zero(type);
+            if (!out_of_bounds && offset + value.Length() <= object.Length()) {
+                memcpy(value.begin(), object.begin() + offset, value.Length());
+            }
+            Set(frame, access->Result(), std::move(value));
+        }
+        frame.pc = access->next;
+        return true;
+    }
+
+    bool ExecSwizzle(Invocation& inv, Frame& frame, Swizzle* swizzle) {
+        auto* object_type = swizzle->Object()->Type();
+        auto* result_type = swizzle->Result()->Type();
+        auto& object = Get(inv, &frame, swizzle->Object());
+        Bytes value = Zero(result_type);
+        auto indices = swizzle->Indices();
+        for (uint32_t i = 0; i < indices.Length(); i++) {
+            WriteScalar(value.begin() + ElementOffset(result_type, i),
+                        ReadElement(object, object_type, indices[i]));
+        }
+        Set(frame, swizzle->Result(), std::move(value));
+        frame.pc = swizzle->next;
+        return true;
+    }
+
+    bool ExecBinary(Invocation& inv, Frame& frame, Binary* binary) {
+        auto* lhs_type = binary->LHS()->Type();
+        auto* rhs_type = binary->RHS()->Type();
+        auto* result_type = binary->Result()->Type();
+        auto& lhs = Get(inv, &frame, binary->LHS());
+        auto& rhs = Get(inv, &frame, binary->RHS());
+        Bytes value = Zero(result_type);
+
+        auto* lhs_mat = lhs_type->As<core::type::Matrix>();
+        auto* rhs_mat = rhs_type->As<core::type::Matrix>();
+        bool linear_algebra = binary->Kind() == Binary::Kind::kMultiply &&
+                              ((lhs_mat && !rhs_type->Is<core::type::Scalar>()) ||
+                               (rhs_mat && !lhs_type->Is<core::type::Scalar>()));
+        if (linear_algebra) {
+            // Matrix-vector, vector-matrix and matrix-matrix products.
+            uint32_t rows = lhs_mat ? lhs_mat->rows() : 1;
+            uint32_t inner = lhs_mat ? lhs_mat->columns() : ElementCount(lhs_type);
+            uint32_t cols = rhs_mat ? rhs_mat->columns() : 1;
+            auto kind = KindOf(ScalarTypeOf(result_type));
+            for (uint32_t c = 0; c < cols; c++) {
+                for (uint32_t r = 0; r < rows; r++) {
+                    float sum = 0;
+                    for (uint32_t k = 0; k < inner; k++) {
+                        float a = ReadElement(lhs, lhs_type, k * rows + r).f;
+                        float b = ReadElement(rhs, rhs_type, c * inner + k).f;
+                        sum += a * b;
+                    }
+                    WriteScalar(value.begin() + ElementOffset(result_type, c * rows + r),
+                                MakeFloat(kind, sum));
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < ElementCount(result_type); i++) {
+                WriteScalar(value.begin() + ElementOffset(result_type, i),
+                            ScalarBinary(binary->Kind(), ReadElement(lhs, lhs_type, i),
+                                         ReadElement(rhs, rhs_type, i)));
+            }
+        }
+        Set(frame, binary->Result(), std::move(value));
+        frame.pc = binary->next;
+        return true;
+    }
+
+    bool ExecUnary(Invocation& inv, Frame& frame, Unary* unary) {
+        auto* type = unary->Result()->Type();
+        auto& operand = Get(inv, &frame, unary->Val());
+        Bytes value = Zero(type);
+        for (uint32_t i = 0; i < ElementCount(type); i++) {
+            Scalar s = ReadElement(operand, type, i);
+            if (unary->Kind() == Unary::Kind::kComplement) {
+                s.u = ~s.u;
+            } else if (IsFloat(s.kind)) {
+                s.f = -s.f;
+            } else {
+                s.u = 0u - s.u;
+            }
+            WriteScalar(value.begin() + ElementOffset(type, i), s);
+        }
+        Set(frame, unary->Result(), std::move(value));
+        frame.pc = unary->next;
+        return true;
+    }
+
+    bool ExecConvert(Invocation& inv, Frame& frame, Convert* convert) {
+        auto* arg = convert->Args()[0];
+        auto* type = convert->Result()->Type();
+        auto& operand = Get(inv, &frame, arg);
+        auto kind = KindOf(ScalarTypeOf(type));
+        Bytes value = Zero(type);
+        for (uint32_t i = 0; i < ElementCount(type); i++) {
+            WriteScalar(value.begin() + ElementOffset(type, i),
+                        ConvertScalar(ReadElement(operand, arg->Type(), i), kind));
+        }
+        Set(frame, convert->Result(), std::move(value));
+        frame.pc = convert->next;
+        return true;
+    }
+
+    bool ExecBitcast(Invocation& inv, Frame& frame, Bitcast* bitcast) {
+        auto& operand = Get(inv, &frame, bitcast->Val());
+        Bytes value = Zero(bitcast->Result()->Type());
+        memcpy(value.begin(), operand.begin(), std::min(value.Length(), operand.Length()));
+        Set(frame, bitcast->Result(), std::move(value));
+        frame.pc = bitcast->next;
+        return true;
+    }
+
+    bool ExecConstruct(Invocation& inv, Frame& frame, Construct* construct) {
+        auto* type = construct->Result()->Type();
+        auto args = construct->Args();
+        Bytes value = Zero(type);
+        if (!args.IsEmpty()) {
+            tint::Switch(
+                type,  //
+                [&](const core::type::Array* a) {
+                    for (size_t i = 0; i < args.Length(); i++) {
+                        memcpy(value.begin() + i * a->Stride(), Get(inv, &frame, args[i]).begin(),
+                               a->ElemType()->Size());
+                    }
+                },
+                [&](const core::type::Struct* s) {
+                    auto members = s->Members();
+                    for (size_t i = 0; i < args.Length(); i++) {
+                        memcpy(value.begin() + members[i]->Offset(),
+                               Get(inv, &frame, args[i]).begin(), members[i]->Type()->Size());
+                    }
+                },
+                [&](Default) {
+                    // Scalars, vectors and matrices are built from the flattened list of the
+                    // scalar elements of the arguments. A single scalar argument is splatted.
+                    uint32_t count = ElementCount(type);
+                    uint32_t i = 0;
+                    for (auto* arg : args) {
+                        auto& bytes = Get(inv, &frame, arg);
+                        uint32_t arg_count = ElementCount(arg->Type());
+                        for (uint32_t j = 0; j < arg_count && i < count; j++, i++) {
+                            WriteScalar(value.begin() + ElementOffset(type, i),
+                                        ReadElement(bytes, arg->Type(), j));
+                        }
+                    }
+                    if (i == 1) {
+                        Scalar splat = ReadScalar(value.begin(), KindOf(ScalarTypeOf(type)));
+                        for (; i < count; i++) {
+                            WriteScalar(value.begin() + ElementOffset(type, i), splat);
+                        }
+                    }
+                });
+        }
+        Set(frame, construct->Result(), std::move(value));
+        frame.pc = construct->next;
+        return true;
+    }
+
+    bool ExecSwitch(Invocation& inv, Frame& frame, Switch* switch_) {
+        int64_t selector = Index(inv, frame, switch_->Condition());
+        Block* target = nullptr;
+        for (auto& c : switch_->Cases()) {
+            for (auto& sel : c.selectors) {
+                if (sel.IsDefault()) {
+                    if (!target) {
+                        target = c.Block();
+                    }
+                } else if (sel.val->Value()->ValueAs<int64_t>() == selector) {
+                    frame.pc = c.Block()->Front();
+                    return true;
+                }
+            }
+        }
+        if (!target) {
+            error_ << "switch has no matching case";
+            return false;
+        }
+        frame.pc = target->Front();
+        return true;
+    }
+
+    /// Evaluates a builtin element-wise.
+    /// @param inv the invocation
+    /// @param frame the current frame
+    /// @param call the builtin call
+    /// @param fn the function applied to each element, taking the element of each argument
+    template <typename FN>
+    void MapElements(const Invocation& inv, Frame& frame, CoreBuiltinCall* call, FN&& fn) {
+        auto* type = call->Result()->Type();
+        auto args = call->Args();
+        Bytes value = Zero(type);
+        for (uint32_t i = 0; i < ElementCount(type); i++) {
+            Scalar s[3];
+            for (size_t a = 0; a < args.Length() && a < 3; a++) {
+                s[a] = ReadElement(Get(inv, &frame, args[a]), args[a]->Type(), i);
+            }
+            WriteScalar(value.begin() + ElementOffset(type, i), fn(s));
+        }
+        Set(frame, call->Result(), std::move(value));
+    }
+
+    /// Evaluates a floating point builtin element-wise.
+    template <typename FN>
+    void MapFloat(const Invocation& inv, Frame& frame, CoreBuiltinCall* call, FN&& fn) {
+        MapElements(inv, frame, call, [&](const Scalar* s) {
+            return MakeFloat(s[0].kind, fn(s[0].f, s[1].f, s[2].f));
+        });
+    }
+
+    /// Writes a scalar to the result of a builtin call.
+    void SetScalar(Frame& frame, CoreBuiltinCall* call, const Scalar& s) {
+        Bytes value = Zero(call->Result()->Type());
+        WriteScalar(value.begin(), s);
+        Set(frame, call->Result(), std::move(value));
+    }
+
+    bool ExecAtomic(const Invocation& inv, Frame& frame, CoreBuiltinCall* call) {
+        auto args = call->Args();
+        Pointer p = AsPointer(Get(inv, &frame, args[0]));
+        auto kind = KindOf(args[0]->Type()->UnwrapPtr());
+        Scalar operand;
+        if (args.Length() > 1) {
+            operand = ReadScalar(Get(inv, &frame, args[1]).begin(), kind);
+        }
+
+        std::lock_guard<std::mutex> lock(dispatch_.atomic_mutex);
+        Scalar old;
+        old.kind = kind;
+        bool in_bounds = p.CanAccess(sizeof(uint32_t));
+        if (in_bounds) {
+            old = ReadScalar(p.ptr, kind);
+        }
+        Scalar result = old;
+        bool store = true;
+        switch (call->Func()) {
+            case core::Function::kAtomicLoad:
+                store = false;
+                break;
+            case core::Function::kAtomicStore:
+            case core::Function::kAtomicExchange:
+                result = operand;
+                break;
+            case core::Function::kAtomicAdd:
+                result.u = old.u + operand.u;
+                break;
+            case core::Function::kAtomicSub:
+                result.u = old.u - operand.u;
+                break;
+            case core::Function::kAtomicAnd:
+                result.u = old.u & operand.u;
+                break;
+            case core::Function::kAtomicOr:
+                result.u = old.u | operand.u;
+                break;
+            case core::Function::kAtomicXor:
+                result.u = old.u ^ operand.u;
+                break;
+            case core::Function::kAtomicMax:
+                if (kind == ScalarKind::kI32) {
+                    result.i = std::max(old.i, operand.i);
+                } else {
+                    result.u = std::max(old.u, operand.u);
+                }
+                break;
+            case core::Function::kAtomicMin:
+                if (kind == ScalarKind::kI32) {
+                    result.i = std::min(old.i, operand.i);
+                } else {
+                    result.u = std::min(old.u, operand.u);
+                }
+                break;
+            case core::Function::kAtomicCompareExchangeWeak: {
+                Scalar value = ReadScalar(Get(inv, &frame, args[2]).begin(), kind);
+                bool exchanged = old.u == operand.u;
+                if (exchanged) {
+                    result = value;
+                } else {
+                    store = false;
+                }
+                auto* str = call->Result()->Type()->As<core::type::Struct>();
+                Bytes out = Zero(str);
+                WriteScalar(out.begin() + str->Members()[0]->Offset(), old);
+                WriteScalar(out.begin() + str->Members()[1]->Offset(), MakeBool(exchanged));
+                Set(frame, call->Result(), std::move(out));
+                if (store && in_bounds) {
+                    WriteScalar(p.ptr, result);
+                }
+                return true;
+            }
+            default:
+                break;
+        }
+        if (store && in_bounds) {
+            WriteScalar(p.ptr, result);
+        }
+        if (call->Func() != core::Function::kAtomicStore) {
+            SetScalar(frame, call, old);
+        }
+        return true;
+    }
+
+    bool ExecBuiltin(Invocation& inv,
+                     Frame& frame,
+                     CoreBuiltinCall* call,
+                     std::optional<Status>& status) {
+        auto args = call->Args();
+        auto* result_type = call->Result()->Type();
+        auto arg = [&](size_t i) -> const Bytes& { return Get(inv, &frame, args[i]); };
+
+        switch (call->Func()) {
+            case core::Function::kWorkgroupBarrier:
+            case core::Function::kStorageBarrier:
+                // Yield once, so that all invocations of the workgroup reach the barrier before
+                // any of them continues.
+                if (inv.barrier_phase++ == 0) {
+                    status = Status::kBarrier;
+                    return true;
+                }
+                inv.barrier_phase = 0;
+                break;
+            case core::Function::kWorkgroupUniformLoad:
+                // Barrier, load, barrier.
+                switch (inv.barrier_phase++) {
+                    case 0:
+                        status = Status::kBarrier;
+                        return true;
+                    case 1: {
+                        Pointer p = AsPointer(arg(0));
+                        Bytes value = Zero(result_type);
+                        if (p.CanAccess(value.Length())) {
+                            memcpy(value.begin(), p.ptr, value.Length());
+                        }
+                        Set(frame, call->Result(), std::move(value));
+                        status = Status::kBarrier;
+                        return true;
+                    }
+                    default:
+                        inv.barrier_phase = 0;
+                        break;
+                }
+                break;
+            case core::Function::kAtomicLoad:
+            case core::Function::kAtomicStore:
+            case core::Function::kAtomicAdd:
+            case core::Function::kAtomicSub:
+            case core::Function::kAtomicMax:
+            case core::Function::kAtomicMin:
+            case core::Function::kAtomicAnd:
+            case core::Function::kAtomicOr:
+            case core::Function::kAtomicXor:
+            case core::Function::kAtomicExchange:
+            case core::Function::kAtomicCompareExchangeWeak:
+                ExecAtomic(inv, frame, call);
+                break;
+            case core::Function::kArrayLength: {
+                Pointer p = AsPointer(arg(0));
+                auto* arr = args[0]->Type()->UnwrapPtr()->As<core::type::Array>();
+                uint32_t length = 0;
+                if (p.ptr && p.end > p.ptr) {
+                    length = static_cast<uint32_t>((p.end - p.ptr) / arr->Stride());
+                }
+                SetScalar(frame, call, MakeU32(length));
+                break;
+            }
+            case core::Function::kAll:
+            case core::Function::kAny: {
+                bool all = true;
+                bool any = false;
+                for (uint32_t i = 0; i < ElementCount(args[0]->Type()); i++) {
+                    bool b = ReadElement(arg(0), args[0]->Type(), i).u != 0;
+                    all &= b;
+                    any |= b;
+                }
+                SetScalar(frame, call, MakeBool(call->Func() == core::Function::kAll ? all : any));
+                break;
+            }
+            case core::Function::kDot: {
+                auto* type = args[0]->Type();
+                Scalar sum = ReadElement(arg(0), type, 0);
+                sum.u = 0;
+                for (uint32_t i = 0; i < ElementCount(type); i++) {
+                    Scalar a = ReadElement(arg(0), type, i);
+                    Scalar b = ReadElement(arg(1), type, i);
+                    if (IsFloat(a.kind)) {
+                        sum.f += a.f * b.f;
+                    } else {
+                        sum.u += a.u * b.u;
+                    }
+                }
+                SetScalar(frame, call, sum);
+                break;
+            }
+            case core::Function::kLength:
+            case core::Function::kDistance: {
+                auto* type = args[0]->Type();
+                float sum = 0;
+                for (uint32_t i = 0; i < ElementCount(type); i++) {
+                    float v = ReadElement(arg(0), type, i).f;
+                    if (call->Func() == core::Function::kDistance) {
+                        v -= ReadElement(arg(1), type, i).f;
+                    }
+                    sum += v * v;
+                }
+                SetScalar(frame, call, MakeFloat(KindOf(result_type), std::sqrt(sum)));
+                break;
+            }
+            case core::Function::kNormalize: {
+                float sum = 0;
+                for (uint32_t i = 0; i < ElementCount(result_type); i++) {
+                    float v = ReadElement(arg(0), result_type, i).f;
+                    sum += v * v;
+                }
+                float len = std::sqrt(sum);
+                MapFloat(inv, frame, call, [&](float x, float, float) { return x / len; });
+                break;
+            }
+            case core::Function::kCross: {
+                float a[3], b[3];
+                for (uint32_t i = 0; i < 3; i++) {
+                    a[i] = ReadElement(arg(0), result_type, i).f;
+                    b[i] = ReadElement(arg(1), result_type, i).f;
+                }
+                float c[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+                              a[0] * b[1] - a[1] * b[0]};
+                auto kind = KindOf(ScalarTypeOf(result_type));
+                Bytes value = Zero(result_type);
+                for (uint32_t i = 0; i < 3; i++) {
+                    WriteScalar(value.begin() + ElementOffset(result_type, i),
+                                MakeFloat(kind, c[i]));
+                }
+                Set(frame, call->Result(), std::move(value));
+                break;
+            }
+            case core::Function::kSelect:
+                MapElements(inv, frame, call,
+                            [&](const Scalar* s) { return s[2].u != 0 ? s[1] : s[0]; });
+                break;
+            case core::Function::kAbs:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    if (IsFloat(r.kind)) {
+                        r.f = std::fabs(r.f);
+                    } else if (r.kind == ScalarKind::kI32 && r.i < 0) {
+                        r.u = 0u - r.u;
+                    }
+                    return r;
+                });
+                break;
+            case core::Function::kMin:
+            case core::Function::kMax: {
+                bool is_min = call->Func() == core::Function::kMin;
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    bool less = ScalarBinary(Binary::Kind::kLessThan, s[0], s[1]).u != 0;
+                    if (IsFloat(s[0].kind)) {
+                        return MakeFloat(s[0].kind, is_min ? std::fmin(s[0].f, s[1].f)
+                                                           : std::fmax(s[0].f, s[1].f));
+                    }
+                    return (less == is_min) ? s[0] : s[1];
+                });
+                break;
+            }
+            case core::Function::kClamp:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    if (IsFloat(s[0].kind)) {
+                        return MakeFloat(s[0].kind, std::fmin(std::fmax(s[0].f, s[1].f), s[2].f));
+                    }
+                    Scalar r = s[0];
+                    if (ScalarBinary(Binary::Kind::kLessThan, r, s[1]).u != 0) {
+                        r = s[1];
+                    }
+                    if (ScalarBinary(Binary::Kind::kGreaterThan, r, s[2]).u != 0) {
+                        r = s[2];
+                    }
+                    return r;
+                });
+                break;
+            case core::Function::kSign:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    if (IsFloat(s[0].kind)) {
+                        float f = s[0].f > 0 ? 1.0f : (s[0].f < 0 ? -1.0f : 0.0f);
+                        return MakeFloat(s[0].kind, f);
+                    }
+                    return MakeI32(s[0].i > 0 ? 1 : (s[0].i < 0 ? -1 : 0));
+                });
+                break;
+            case core::Function::kCountOneBits:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    r.u = 0;
+                    for (uint32_t v = s[0].u; v != 0; v &= v - 1) {
+                        r.u++;
+                    }
+                    return r;
+                });
+                break;
+            case core::Function::kCountLeadingZeros:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    r.u = CountLeadingZeros(s[0].u);
+                    return r;
+                });
+                break;
+            case core::Function::kCountTrailingZeros:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    r.u = CountTrailingZeros(s[0].u);
+                    return r;
+                });
+                break;
+            case core::Function::kReverseBits:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    r.u = 0;
+                    for (uint32_t i = 0; i < 32; i++) {
+                        r.u |= ((s[0].u >> i) & 1u) << (31 - i);
+                    }
+                    return r;
+                });
+                break;
+            case core::Function::kFirstLeadingBit:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    uint32_t v = (s[0].kind == ScalarKind::kI32 && s[0].i < 0) ? ~s[0].u : s[0].u;
+                    r.u = v == 0 ? 0xffffffffu : 31 - CountLeadingZeros(v);
+                    return r;
+                });
+                break;
+            case core::Function::kFirstTrailingBit:
+                MapElements(inv, frame, call, [&](const Scalar* s) {
+                    Scalar r = s[0];
+                    r.u = s[0].u == 0 ? 0xffffffffu : CountTrailingZeros(s[0].u);
+                    return r;
+                });
+                break;
+            case core::Function::kSqrt:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::sqrt(x); });
+                break;
+            case core::Function::kInverseSqrt:
+                MapFloat(inv, frame, call,
+                         [](float x, float, float) { return 1.0f / std::sqrt(x); });
+                break;
+            case core::Function::kFloor:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::floor(x); });
+                break;
+            case core::Function::kCeil:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::ceil(x); });
+                break;
+            case core::Function::kRound:
+                MapFloat(inv, frame, call,
+                         [](float x, float, float) { return std::nearbyint(x); });
+                break;
+            case core::Function::kTrunc:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::trunc(x); });
+                break;
+            case core::Function::kFract:
+                MapFloat(inv, frame, call,
+                         [](float x, float, float) { return x - std::floor(x); });
+                break;
+            case core::Function::kExp:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::exp(x); });
+                break;
+            case core::Function::kExp2:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::exp2(x); });
+                break;
+            case core::Function::kLog:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::log(x); });
+                break;
+            case core::Function::kLog2:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::log2(x); });
+                break;
+            case core::Function::kPow:
+                MapFloat(inv, frame, call, [](float x, float y, float) { return std::pow(x, y); });
+                break;
+            case core::Function::kSin:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::sin(x); });
+                break;
+            case core::Function::kCos:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::cos(x); });
+                break;
+            case core::Function::kTan:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::tan(x); });
+                break;
+            case core::Function::kAsin:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::asin(x); });
+                break;
+            case core::Function::kAcos:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::acos(x); });
+                break;
+            case core::Function::kAtan:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::atan(x); });
+                break;
+            case core::Function::kAtan2:
+                MapFloat(inv, frame, call,
+                         [](float y, float x, float) { return std::atan2(y, x); });
+                break;
+            case core::Function::kSinh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::sinh(x); });
+                break;
+            case core::Function::kCosh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::cosh(x); });
+                break;
+            case core::Function::kTanh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::tanh(x); });
+                break;
+            case core::Function::kAsinh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::asinh(x); });
+                break;
+            case core::Function::kAcosh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::acosh(x); });
+                break;
+            case core::Function::kAtanh:
+                MapFloat(inv, frame, call, [](float x, float, float) { return std::atanh(x); });
+                break;
+            case core::Function::kDegrees:
+                MapFloat(inv, frame, call,
+                         [](float x, float, float) { return x * 57.295779513082322865f; });
+                break;
+            case core::Function::kRadians:
+                MapFloat(inv, frame, call,
+                         [](float x, float, float) { return x * 0.017453292519943295474f; });
+                break;
+            case core::Function::kSaturate:
+                MapFloat(inv, frame, call, [](float x, float, float) {
+                    return std::fmin(std::fmax(x, 0.0f), 1.0f);
+                });
+                break;
+            case core::Function::kStep:
+                MapFloat(inv, frame, call,
+                         [](float edge, float x, float) { return x >= edge ? 1.0f : 0.0f; });
+                break;
+            case core::Function::kFma:
+                MapFloat(inv, frame, call,
+                         [](float a, float b, float c) { return std::fma(a, b, c); });
+                break;
+            case core::Function::kMix:
+                MapFloat(inv, frame, call,
+                         [](float a, float b, float t) { return a * (1.0f - t) + b * t; });
+                break;
+            case core::Function::kSmoothstep:
+                MapFloat(inv, frame, call, [](float low, float high, float x) {
+                    float t = std::fmin(std::fmax((x - low) / (high - low), 0.0f), 1.0f);
+                    return t * t * (3.0f - 2.0f * t);
+                });
+                break;
+            default:
+                error_ << "unsupported builtin: " << call->Func();
+                return false;
+        }
+        frame.pc = call->next;
+        return true;
+    }
+
+    /// The prepared module
+    const PreparedModule& state_;
+    /// The dispatch state
+    DispatchState& dispatch_;
+    /// The workgroup memory of the current workgroup
+    std::vector<uint64_t> workgroup_memory_;
+    /// The invocations of the current workgroup
+    std::vector<Invocation> invocations_;
+    /// The workgroup ID of the current workgroup
+    std::array<uint32_t, 3> workgroup_id_{};
+    /// The error raised by a failed workgroup
+    StringStream error_;
+};
+
+}  // namespace
+
+/// The state of the interpreter, computed when the interpreter is constructed.
+struct Interpreter::State : PreparedModule {
+    using PreparedModule::PreparedModule;
+};
+
+Interpreter::Interpreter(Module& mod) : state_(std::make_unique<State>(mod)) {}
+
+Interpreter::~Interpreter() = default;
+
+Result<SuccessType, std::string> Interpreter::Dispatch(
+    std::string_view entry_point,
+    const std::array<uint32_t, 3>& workgroup_count,
+    const DispatchOptions& options) {
+    if (!state_->error.str().empty()) {
+        return state_->error.str();
+    }
+
+    DispatchState dispatch;
+    for (auto* func : state_->mod.functions) {
+        if (func->Stage() == Function::PipelineStage::kCompute &&
+            state_->mod.NameOf(func).NameView() == entry_point) {
+            dispatch.entry_point = func;
+            break;
+        }
+    }
+    if (!dispatch.entry_point) {
+        return "compute entry point '" + std::string(entry_point) + "' not found";
+    }
+    auto wgsize = dispatch.entry_point->WorkgroupSize();
+    if (!wgsize) {
+        return "entry point '" + std::string(entry_point) + "' has no workgroup size";
+    }
+    dispatch.workgroup_size = *wgsize;
+    dispatch.workgroup_count = workgroup_count;
+
+    uint64_t total = uint64_t(workgroup_count[0]) * workgroup_count[1] * workgroup_count[2];
+    if (total > std::numeric_limits<uint32_t>::max()) {
+        return std::string("too many workgroups");
+    }
+    dispatch.total_workgroups = static_cast<uint32_t>(total);
+    if (total == 0) {
+        return Success;
+    }
+
+    dispatch.buffers.resize(state_->globals.size());
+    for (size_t i = 0; i < state_->globals.size(); i++) {
+        auto& global = state_->globals[i];
+        if (global.address_space != core::AddressSpace::kStorage &&
+            global.address_space != core::AddressSpace::kUniform) {
+            continue;
+        }
+        auto bp = global.var->BindingPoint();
+        auto binding = bp ? options.bindings.Get(*bp) : std::nullopt;
+        if (!binding) {
+            StringStream err;
+            err << "no buffer bound to module-scope variable '"
+                << state_->mod.NameOf(global.var).NameView() << "'";
+            return err.str();
+        }
+        dispatch.buffers[i] = Pointer{binding->data, binding->data + binding->size};
+    }
+
+    uint32_t num_tasks = std::min(std::max(options.max_concurrency, 1u), dispatch.total_workgroups);
+    auto task = [&](uint32_t) { Executor(*state_, dispatch).Run(); };
+    if (num_tasks == 1) {
+        task(0);
+    } else if (options.task_runner) {
+        options.task_runner(num_tasks, task);
+    } else {
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < num_tasks; i++) {
+            threads.emplace_back(task, i);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    if (dispatch.failed) {
+        return dispatch.error;
+    }
+    return Success;
+}
+
+}  // namespace tint::ir
@@ -0,0 +1,95 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_INTERPRETER_H_
+#define SRC_TINT_LANG_CORE_IR_INTERPRETER_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/result/result.h"
+#include "tint/binding_point.h"
+
+// Forward declarations
+namespace tint::ir {
+class Module;
+}  // namespace tint::ir
+
+namespace tint::ir {
+
+/// Interpreter is a CPU reference executor for the compute entry points of an IR module.
+///
+/// A dispatch executes every invocation of every workgroup. Workgroups are distributed across a
+/// configurable number of concurrent tasks, and the invocations of a single workgroup are executed
+/// cooperatively on one task so that `workgroupBarrier()` and `storageBarrier()` are honored.
+///
+/// The interpreter supports the subset of the IR used by compute shaders that operate on buffers.
+/// Textures, samplers and derivative builtins are reported as dispatch failures. Out-of-bounds
+/// memory accesses follow the WGSL robustness rules: loads return zero and stores are discarded.
+class Interpreter {
+  public:
+    /// A host memory range bound to a module-scope `storage` or `uniform` variable.
+    struct Binding {
+        /// The start of the bound memory
+        uint8_t* data = nullptr;
+        /// The size in bytes of the bound memory
+        size_t size = 0;
+    };
+
+    /// A function that calls `task(i)` for each `i` in `[0, count)`, possibly concurrently, and
+    /// returns once all the calls have completed.
+    using TaskRunner =
+        std::function<void(uint32_t count, const std::function<void(uint32_t)>& task)>;
+
+    /// The options for a single dispatch.
+    struct DispatchOptions {
+        /// The memory bound to the module-scope buffer variables, keyed by binding point.
+        Hashmap<BindingPoint, Binding, 8> bindings;
+        /// The maximum number of tasks used to execute workgroups concurrently.
+        uint32_t max_concurrency = 1;
+        /// The task runner used to execute workgroups concurrently. If not set, and
+        /// `max_concurrency` is greater than one, the interpreter spawns its own threads.
+        TaskRunner task_runner;
+    };
+
+    /// Constructor
+    /// @param mod the module to execute. The module must outlive the interpreter, and must not be
+    /// modified while the interpreter is alive.
+    explicit Interpreter(Module& mod);
+
+    /// Destructor
+    ~Interpreter();
+
+    /// Executes a dispatch of a compute entry point.
+    /// @param entry_point the name of the compute entry point
+    /// @param workgroup_count the number of workgroups in each dimension
+    /// @param options the dispatch options
+    /// @returns success, or a failure message describing the first error that was encountered
+    Result<SuccessType, std::string> Dispatch(std::string_view entry_point,
+                                              const std::array<uint32_t, 3>& workgroup_count,
+                                              const DispatchOptions& options);
+
+  private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace tint::ir
+
+#endif  // SRC_TINT_LANG_CORE_IR_INTERPRETER_H_
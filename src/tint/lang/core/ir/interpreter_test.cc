@@ -0,0 +1,221 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/interpreter.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "src/tint/lang/core/ir/ir_helper_test.h"
+
+namespace tint::ir {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+using IR_InterpreterTest = IRTestHelper;
+
+/// @returns dispatch options that bind @p data to binding point (0, 0)
+Interpreter::DispatchOptions BindBuffer(std::vector<uint32_t>& data) {
+    Interpreter::DispatchOptions options;
+    options.bindings.Add(BindingPoint{0, 0},
+                         Interpreter::Binding{reinterpret_cast<uint8_t*>(data.data()),
+                                              data.size() * sizeof(uint32_t)});
+    return options;
+}
+
+TEST_F(IR_InterpreterTest, GlobalInvocationId) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, array<u32>>());
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+
+    auto* gid = b.FunctionParam("gid", ty.vec3<u32>());
+    gid->SetBuiltin(FunctionParam::Builtin::kGlobalInvocationId);
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{4u, 1u, 1u});
+    func->SetParams({gid});
+    b.Append(func->Block(), [&] {
+        auto* idx = b.Access(ty.u32(), gid, 0_u);
+        auto* ptr = b.Access(ty.ptr<storage, u32>(), buffer, idx);
+        b.Store(ptr, b.Multiply(ty.u32(), idx, 2_u));
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(8, 0);
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {2u, 1u, 1u}, BindBuffer(data));
+    ASSERT_TRUE(result) << result.Failure();
+    EXPECT_THAT(data, testing::ElementsAre(0u, 2u, 4u, 6u, 8u, 10u, 12u, 14u));
+}
+
+TEST_F(IR_InterpreterTest, Loop) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, u32>());
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(func->Block(), [&] {
+        auto* sum = b.Var("sum", ty.ptr<function, u32>());
+        b.LoopRange(ty, 0_u, 10_u, 1_u, [&](Value* idx) {
+            b.Store(sum, b.Add(ty.u32(), b.Load(sum), idx));
+        });
+        b.Store(buffer, b.Load(sum));
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(1, 0);
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {1u, 1u, 1u}, BindBuffer(data));
+    ASSERT_TRUE(result) << result.Failure();
+    EXPECT_EQ(data[0], 45u);
+}
+
+TEST_F(IR_InterpreterTest, WorkgroupBarrier) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, array<u32>>());
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+    auto* shared = b.Var("shared", ty.ptr<workgroup, array<u32, 4>>());
+    b.RootBlock()->Append(shared);
+
+    auto* lid = b.FunctionParam("lid", ty.u32());
+    lid->SetBuiltin(FunctionParam::Builtin::kLocalInvocationIndex);
+    auto* wgid = b.FunctionParam("wgid", ty.vec3<u32>());
+    wgid->SetBuiltin(FunctionParam::Builtin::kWorkgroupId);
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{4u, 1u, 1u});
+    func->SetParams({lid, wgid});
+    b.Append(func->Block(), [&] {
+        auto* group = b.Access(ty.u32(), wgid, 0_u);
+        auto* value = b.Add(ty.u32(), b.Multiply(ty.u32(), group, 100_u), lid);
+        b.Store(b.Access(ty.ptr<workgroup, u32>(), shared, lid), value);
+        b.Call(ty.void_(), core::Function::kWorkgroupBarrier);
+        auto* reversed = b.Subtract(ty.u32(), 3_u, lid);
+        auto* load = b.Load(b.Access(ty.ptr<workgroup, u32>(), shared, reversed));
+        auto* out = b.Add(ty.u32(), b.Multiply(ty.u32(), group, 4_u), lid);
+        b.Store(b.Access(ty.ptr<storage, u32>(), buffer, out), load);
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(8, 0);
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {2u, 1u, 1u}, BindBuffer(data));
+    ASSERT_TRUE(result) << result.Failure();
+    EXPECT_THAT(data, testing::ElementsAre(3u, 2u, 1u, 0u, 103u, 102u, 101u, 100u));
+}
+
+TEST_F(IR_InterpreterTest, AtomicsWithConcurrency) {
+    auto* buffer = b.Var("buffer", ty.ptr(storage, ty.atomic<u32>()));
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{8u, 2u, 1u});
+    b.Append(func->Block(), [&] {
+        b.Call(ty.u32(), core::Function::kAtomicAdd, buffer, 1_u);
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(1, 0);
+    auto options = BindBuffer(data);
+    options.max_concurrency = 4;
+    uint32_t tasks_run = 0;
+    options.task_runner = [&](uint32_t count, const std::function<void(uint32_t)>& task) {
+        for (uint32_t i = 0; i < count; i++) {
+            task(i);
+            tasks_run++;
+        }
+    };
+
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {4u, 2u, 3u}, options);
+    ASSERT_TRUE(result) << result.Failure();
+    EXPECT_EQ(data[0], 8u * 2u * 4u * 2u * 3u);
+    EXPECT_EQ(tasks_run, 4u);
+}
+
+TEST_F(IR_InterpreterTest, OutOfBoundsStoreIsDiscarded) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, array<u32>>());
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(func->Block(), [&] {
+        auto* len = b.Call(ty.u32(), core::Function::kArrayLength, buffer);
+        b.Store(b.Access(ty.ptr<storage, u32>(), buffer, 0_u), len);
+        b.Store(b.Access(ty.ptr<storage, u32>(), buffer, 10_u), 42_u);
+        auto* oob = b.Load(b.Access(ty.ptr<storage, u32>(), buffer, 10_u));
+        b.Store(b.Access(ty.ptr<storage, u32>(), buffer, 1_u), oob);
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(4, 7);
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {1u, 1u, 1u}, BindBuffer(data));
+    ASSERT_TRUE(result) << result.Failure();
+    EXPECT_THAT(data, testing::ElementsAre(4u, 0u, 7u, 7u));
+}
+
+TEST_F(IR_InterpreterTest, Error_EntryPointNotFound) {
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {1u, 1u, 1u}, {});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.Failure(), "compute entry point 'main' not found");
+}
+
+TEST_F(IR_InterpreterTest, Error_MissingBinding) {
+    auto* buffer = b.Var("buffer", ty.ptr<storage, u32>());
+    buffer->SetBindingPoint(0, 1);
+    b.RootBlock()->Append(buffer);
+
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{1u, 1u, 1u});
+    b.Append(func->Block(), [&] {
+        b.Store(buffer, 1_u);
+        b.Return(func);
+    });
+
+    std::vector<uint32_t> data(1, 0);
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {1u, 1u, 1u}, BindBuffer(data));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.Failure(), "no buffer bound to module-scope variable 'buffer'");
+}
+
+TEST_F(IR_InterpreterTest, Error_NonUniformBarrier) {
+    auto* lid = b.FunctionParam("lid", ty.u32());
+    lid->SetBuiltin(FunctionParam::Builtin::kLocalInvocationIndex);
+    auto* func = b.Function("main", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array<uint32_t, 3>{2u, 1u, 1u});
+    func->SetParams({lid});
+    b.Append(func->Block(), [&] {
+        auto* if_ = b.If(b.Equal(ty.bool_(), lid, 0_u));
+        b.Append(if_->True(), [&] {
+            b.Call(ty.void_(), core::Function::kWorkgroupBarrier);
+            b.ExitIf(if_);
+        });
+        b.Append(if_->False(), [&] { b.ExitIf(if_); });
+        b.Return(func);
+    });
+
+    Interpreter interpreter(mod);
+    auto result = interpreter.Dispatch("main", {1u, 1u, 1u}, {});
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.Failure(), "barrier reached in non-uniform control flow");
+}
+
+}  // namespace
+}  // namespace tint::ir
@@ -0,0 +1,241 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/block_simplification.h"
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/utils/containers/hashset.h"
+
+namespace tint::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module* ir = nullptr;
+
+    /// Constructor
+    /// @param mod the module
+    explicit State(Module* mod) : ir(mod) {}
+
+    /// Process the module.
+    void Process() {
+        for (auto* func : ir->functions) {
+            ProcessBlock(func->Block());
+        }
+    }
+
+    /// Simplify the control instructions of a block, and of the blocks nested in it.
+    /// @param block the block to process
+    void ProcessBlock(Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            // As we're (potentially) replacing the instruction that we're iterating over, grab a
+            // pointer to the next instruction before we make any changes.
+            auto* next = inst->next;
+            TINT_DEFER(inst = next);
+
+            auto* ctrl = inst->As<ControlInstruction>();
+            if (!ctrl) {
+                continue;
+            }
+
+            // Simplify the nested control instructions first, which can make this one trivial.
+            ctrl->ForeachBlock([&](Block* blk) { ProcessBlock(blk); });
+
+            tint::Switch(
+                ctrl,  //
+                [&](If* ifelse) { SimplifyIf(ifelse); },
+                [&](Switch* swtch) { SimplifySwitch(swtch); });
+        }
+    }
+
+    /// Replace an if instruction with the instructions of one of its blocks, if possible.
+    /// @param ifelse the if instruction
+    void SimplifyIf(If* ifelse) {
+        if (auto* cond = ifelse->Condition()->As<ir::Constant>()) {
+            Inline(ifelse, cond->Value()->ValueAs<bool>() ? ifelse->True() : ifelse->False());
+            return;
+        }
+
+        // If both blocks do nothing but exit with the same values, then the condition does not
+        // matter.
+        auto* t = ifelse->True()->Front();
+        auto* f = ifelse->False()->Front();
+        if (ifelse->True()->Length() > 1 || ifelse->False()->Length() > 1) {
+            return;
+        }
+        if (t && f) {
+            auto* t_exit = t->As<ExitIf>();
+            auto* f_exit = f->As<ExitIf>();
+            if (!t_exit || !f_exit || t_exit->Args().Length() != f_exit->Args().Length()) {
+                return;
+            }
+            for (size_t i = 0; i < t_exit->Args().Length(); i++) {
+                if (t_exit->Args()[i] != f_exit->Args()[i]) {
+                    return;
+                }
+            }
+        } else if (t || f) {
+            // One of the blocks is empty, so the other must only contain an exit without values.
+            auto* exit = As<ExitIf>(t ? t : f);
+            if (!exit || !exit->Args().IsEmpty()) {
+                return;
+            }
+        }
+        Inline(ifelse, ifelse->True());
+    }
+
+    /// Replace a switch instruction with the instructions of one of its cases, if possible.
+    /// @param swtch the switch instruction
+    void SimplifySwitch(Switch* swtch) {
+        auto* cond = swtch->Condition()->As<ir::Constant>();
+        if (!cond) {
+            return;
+        }
+
+        // Find the case selected by the condition, falling back to the default case.
+        Block* selected = nullptr;
+        Block* default_block = nullptr;
+        for (auto& c : swtch->Cases()) {
+            for (auto& selector : c.selectors) {
+                if (selector.IsDefault()) {
+                    default_block = c.Block();
+                } else if (selector.val->Value()->Equal(cond->Value())) {
+                    selected = c.Block();
+                }
+            }
+        }
+        Inline(swtch, selected ? selected : default_block);
+    }
+
+    /// Replace a control instruction with the instructions of the block @p taken, if the block
+    /// exits the control instruction and no other exit or sibling branch would be removed.
+    /// @param ctrl the control instruction
+    /// @param taken the block of @p ctrl that is always executed
+    void Inline(ControlInstruction* ctrl, Block* taken) {
+        if (!taken) {
+            return;
+        }
+
+        // The block must exit the control instruction, rather than branch elsewhere.
+        auto* exit = taken->Terminator() ? taken->Terminator()->As<Exit>() : nullptr;
+        if (exit ? exit->ControlInstruction() != ctrl : !taken->IsEmpty() || ctrl->HasResults()) {
+            return;
+        }
+
+        // All the exits of the control instruction must be directly in its blocks, as the exits
+        // from nested instructions cannot be inlined.
+        for (auto* e : ctrl->Exits()) {
+            if (e->Block()->Parent() != ctrl) {
+                return;
+            }
+        }
+
+        // The blocks that are not taken must not contain branches to loops outside of them, as
+        // the target blocks keep track of those branches.
+        bool branches_out = false;
+        ctrl->ForeachBlock([&](Block* blk) {
+            if (blk != taken) {
+                Hashset<Loop*, 4> loops;
+                branches_out = branches_out || HasSiblingBranchOut(blk, loops);
+            }
+        });
+        if (branches_out) {
+            return;
+        }
+
+        // Move the instructions of the taken block in front of the control instruction, and
+        // replace the results of the control instruction with the values it exits with.
+        for (auto* inst = taken->Front(); inst && inst != exit;) {
+            auto* next = inst->next;
+            inst->Remove();
+            inst->InsertBefore(ctrl);
+            inst = next;
+        }
+        if (exit) {
+            auto results = ctrl->Results();
+            for (size_t i = 0; i < results.Length(); i++) {
+                results[i]->ReplaceAllUsesWith(exit->Args()[i]);
+            }
+        }
+
+        ctrl->ForeachBlock([&](Block* blk) { DestroyBlock(blk); });
+        ctrl->Destroy();
+    }
+
+    /// @param block the block to search
+    /// @param loops the loops that enclose @p block, within the block being searched
+    /// @returns true if @p block (transitively) contains a continue, next iteration or break-if
+    /// instruction that branches to a loop that is not in @p loops
+    bool HasSiblingBranchOut(Block* block, Hashset<Loop*, 4>& loops) {
+        for (auto* inst : *block) {
+            bool branches_out = tint::Switch(
+                inst,  //
+                [&](Continue* cont) { return !loops.Contains(cont->Loop()); },
+                [&](NextIteration* next) { return !loops.Contains(next->Loop()); },
+                [&](BreakIf* break_if) { return !loops.Contains(break_if->Loop()); },
+                [&](ControlInstruction* ctrl) {
+                    if (auto* loop = ctrl->As<Loop>()) {
+                        loops.Add(loop);
+                    }
+                    bool nested = false;
+                    ctrl->ForeachBlock([&](Block* blk) {
+                        nested = nested || HasSiblingBranchOut(blk, loops);
+                    });
+                    return nested;
+                },
+                [&](Default) { return false; });
+            if (branches_out) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Destroy all the instructions of a block, and of the blocks nested in it.
+    /// @param block the block
+    void DestroyBlock(Block* block) {
+        // Destroy the instructions in reverse order, so that the users of a result are destroyed
+        // before the instruction that produces it.
+        while (auto* inst = block->Back()) {
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                Vector<Block*, 4> blocks;
+                ctrl->ForeachBlock([&](Block* blk) { blocks.Push(blk); });
+                blocks.Reverse();
+                for (auto* blk : blocks) {
+                    DestroyBlock(blk);
+                }
+            }
+            inst->Destroy();
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType, std::string> BlockSimplification(Module* ir) {
+    auto result = ValidateAndDumpIfNeeded(*ir, "BlockSimplification transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::ir::transform
@@ -0,0 +1,41 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_BLOCK_SIMPLIFICATION_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_BLOCK_SIMPLIFICATION_H_
+
+#include <string>
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::ir {
+class Module;
+}
+
+namespace tint::ir::transform {
+
+/// BlockSimplification is a transform that removes trivial control flow. An if or switch
+/// instruction is replaced with the instructions of the block that it always branches to when:
+/// * its condition is a constant, or
+/// * all of its blocks are empty apart from an exit with the same arguments.
+/// The instructions are only moved if the block exits the if or switch, and is not branched out of
+/// from a nested instruction.
+/// @param module the module to transform
+/// @returns an error string on failure
+Result<SuccessType, std::string> BlockSimplification(Module* module);
+
+}  // namespace tint::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_BLOCK_SIMPLIFICATION_H_
@@ -0,0 +1,528 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/block_simplification.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+using IR_BlockSimplificationTest = TransformTest;
+
+TEST_F(IR_BlockSimplificationTest, NoModify_NonConstantCondition) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({cond});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, 1_i);
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, 2_i);
+        });
+        b.Return(func, ifelse->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func(%cond:bool):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = if %cond [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if 1i  # if_1
+      }
+      %b3 = block {  # false
+        exit_if 2i  # if_1
+      }
+    }
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, If_ConstantTrue) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({x});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(true);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Add(ty.i32(), x, 1_i));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, b.Subtract(ty.i32(), x, 1_i));
+        });
+        b.Return(func, b.Multiply(ty.i32(), ifelse->Result(0), 2_i));
+    });
+
+    auto* src = R"(
+%foo = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = if true [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %4:i32 = add %x, 1i
+        exit_if %4  # if_1
+      }
+      %b3 = block {  # false
+        %5:i32 = sub %x, 1i
+        exit_if %5  # if_1
+      }
+    }
+    %6:i32 = mul %3, 2i
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, If_ConstantFalse_EmptyFalseBlock) {
+    auto* var = b.Var("v", ty.ptr<private_, i32>());
+    b.RootBlock()->Append(var);
+
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(false);
+        b.Append(ifelse->True(), [&] {
+            auto* inner = b.If(true);
+            b.Append(inner->True(), [&] {
+                b.Store(var, 1_i);
+                b.ExitIf(inner);
+            });
+            b.ExitIf(ifelse);
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    if false [t: %b3] {  # if_1
+      %b3 = block {  # true
+        if true [t: %b4] {  # if_2
+          %b4 = block {  # true
+            store %v, 1i
+            exit_if  # if_2
+          }
+        }
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    ret
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, If_Nested) {
+    auto* var = b.Var("v", ty.ptr<private_, i32>());
+    b.RootBlock()->Append(var);
+
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {
+            auto* inner = b.If(false);
+            b.Append(inner->True(), [&] {
+                b.Store(var, 1_i);
+                b.ExitIf(inner);
+            });
+            b.Append(inner->False(), [&] {
+                b.Store(var, 2_i);
+                b.ExitIf(inner);
+            });
+            b.ExitIf(ifelse);
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    if true [t: %b3] {  # if_1
+      %b3 = block {  # true
+        if false [t: %b4, f: %b5] {  # if_2
+          %b4 = block {  # true
+            store %v, 1i
+            exit_if  # if_2
+          }
+          %b5 = block {  # false
+            store %v, 2i
+            exit_if  # if_2
+          }
+        }
+        exit_if  # if_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    store %v, 2i
+    ret
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, NoModify_If_ReturnInTakenBlock) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(true);
+        b.Append(ifelse->True(), [&] {  //
+            b.Return(func, 1_i);
+        });
+        b.Return(func, 2_i);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    if true [t: %b2] {  # if_1
+      %b2 = block {  # true
+        ret 1i
+      }
+    }
+    ret 2i
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, NoModify_If_ContinueInDiscardedBlock) {
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            auto* ifelse = b.If(false);
+            b.Append(ifelse->True(), [&] {  //
+                b.Continue(loop);
+            });
+            b.ExitLoop(loop);
+
+            b.Append(loop->Continuing(), [&] {  //
+                b.NextIteration(loop);
+            });
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%foo = func():void -> %b1 {
+  %b1 = block {
+    loop [b: %b2, c: %b3] {  # loop_1
+      %b2 = block {  # body
+        if false [t: %b4] {  # if_1
+          %b4 = block {  # true
+            continue %b3
+          }
+        }
+        exit_loop  # loop_1
+      }
+      %b3 = block {  # continuing
+        next_iteration %b2
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, If_SameExitValues) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({cond, x});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, x);
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, x);
+        });
+        b.Return(func, ifelse->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func(%cond:bool, %x:i32):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = if %cond [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if %x  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %x  # if_1
+      }
+    }
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%cond:bool, %x:i32):i32 -> %b1 {
+  %b1 = block {
+    ret %x
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, Switch_ConstantCondition) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* swtch = b.Switch(2_i);
+        swtch->SetResults(b.InstructionResult(ty.i32()));
+        auto* case_a = b.Case(swtch, Vector{Switch::CaseSelector{b.Constant(1_i)}});
+        b.Append(case_a, [&] {  //
+            b.ExitSwitch(swtch, 10_i);
+        });
+        auto* case_b = b.Case(swtch, Vector{Switch::CaseSelector{b.Constant(2_i)},
+                                            Switch::CaseSelector{b.Constant(3_i)}});
+        b.Append(case_b, [&] {  //
+            b.ExitSwitch(swtch, b.Multiply(ty.i32(), 20_i, 2_i));
+        });
+        auto* def_case = b.Case(swtch, Vector{Switch::CaseSelector()});
+        b.Append(def_case, [&] {  //
+            b.ExitSwitch(swtch, 30_i);
+        });
+        b.Return(func, swtch->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = switch 2i [c: (1i, %b2), c: (2i 3i, %b3), c: (default, %b4)] {  # switch_1
+      %b2 = block {  # case
+        exit_switch 10i  # switch_1
+      }
+      %b3 = block {  # case
+        %3:i32 = mul 20i, 2i
+        exit_switch %3  # switch_1
+      }
+      %b4 = block {  # case
+        exit_switch 30i  # switch_1
+      }
+    }
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = mul 20i, 2i
+    ret %2
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, Switch_ConstantCondition_Default) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* swtch = b.Switch(7_i);
+        swtch->SetResults(b.InstructionResult(ty.i32()));
+        auto* case_a = b.Case(swtch, Vector{Switch::CaseSelector{b.Constant(1_i)}});
+        b.Append(case_a, [&] {  //
+            b.ExitSwitch(swtch, 10_i);
+        });
+        auto* def_case = b.Case(swtch, Vector{Switch::CaseSelector()});
+        b.Append(def_case, [&] {  //
+            b.ExitSwitch(swtch, 30_i);
+        });
+        b.Return(func, swtch->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = switch 7i [c: (1i, %b2), c: (default, %b3)] {  # switch_1
+      %b2 = block {  # case
+        exit_switch 10i  # switch_1
+      }
+      %b3 = block {  # case
+        exit_switch 30i  # switch_1
+      }
+    }
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 30i
+  }
+}
+)";
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_BlockSimplificationTest, NoModify_Switch_NestedExit) {
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* var = b.Var("v", ty.ptr<private_, i32>());
+    b.RootBlock()->Append(var);
+
+    auto* func = b.Function("foo", ty.void_());
+    func->SetParams({cond});
+    b.Append(func->Block(), [&] {
+        auto* swtch = b.Switch(1_i);
+        auto* case_a = b.Case(swtch, Vector{Switch::CaseSelector{b.Constant(1_i)},
+                                            Switch::CaseSelector()});
+        b.Append(case_a, [&] {
+            auto* ifelse = b.If(cond);
+            b.Append(ifelse->True(), [&] {  //
+                b.ExitSwitch(swtch);
+            });
+            b.Store(var, 1_i);
+            b.ExitSwitch(swtch);
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func(%cond:bool):void -> %b2 {
+  %b2 = block {
+    switch 1i [c: (1i default, %b3)] {  # switch_1
+      %b3 = block {  # case
+        if %cond [t: %b4] {  # if_1
+          %b4 = block {  # true
+            exit_switch  # switch_1
+          }
+        }
+        store %v, 1i
+        exit_switch  # switch_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(BlockSimplification);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::ir::transform
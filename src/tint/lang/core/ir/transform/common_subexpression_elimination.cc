@@ -0,0 +1,172 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+
+#include <optional>
+#include <utility>
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/utils/containers/hashmap.h"
+
+namespace tint::ir::transform {
+
+namespace {
+
+/// Key describes the computation performed by a pure instruction.
+/// Two instructions with equal keys produce the same value.
+struct Key {
+    /// The type of the instruction
+    const tint::TypeInfo* kind = nullptr;
+    /// The operator, or builtin function, of the instruction
+    uint32_t op = 0;
+    /// The result type of the instruction
+    const core::type::Type* type = nullptr;
+    /// The operands of the instruction
+    Vector<Value*, 4> operands;
+    /// The swizzle indices of the instruction
+    Vector<uint32_t, 4> indices;
+
+    /// Equality operator
+    /// @param other the key to compare against
+    /// @returns true if this key and @p other are equal
+    bool operator==(const Key& other) const {
+        return kind == other.kind && op == other.op && type == other.type &&
+               operands == other.operands && indices == other.indices;
+    }
+
+    /// Hasher provides a hash function for the Key
+    struct Hasher {
+        /// @param key the key to hash
+        /// @returns a hash of the key
+        size_t operator()(const Key& key) const {
+            auto hash = Hash(key.kind, key.op, key.type, key.operands.Length());
+            for (auto* operand : key.operands) {
+                hash = HashCombine(hash, operand);
+            }
+            for (auto index : key.indices) {
+                hash = HashCombine(hash, index);
+            }
+            return hash;
+        }
+    };
+};
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module* ir = nullptr;
+
+    /// The map of the keys of the available pure instructions to their results.
+    Hashmap<Key, InstructionResult*, 32, Key::Hasher> available;
+
+    /// Constructor
+    /// @param mod the module
+    explicit State(Module* mod) : ir(mod) {}
+
+    /// Process the module.
+    void Process() {
+        for (auto* func : ir->functions) {
+            ProcessBlock(func->Block());
+        }
+    }
+
+    /// Eliminate the redundant instructions of a block, and of the blocks nested in it.
+    /// @param block the block to process
+    void ProcessBlock(Block* block) {
+        // The keys added by this block. These are removed when the block is exited, as the
+        // instructions of the block do not dominate the instructions that follow its parent.
+        Vector<Key, 8> added;
+
+        for (auto* inst = block->Front(); inst;) {
+            // As we're (potentially) removing the instruction that we're iterating over, grab a
+            // pointer to the next instruction before we make any changes.
+            auto* next = inst->next;
+            TINT_DEFER(inst = next);
+
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* blk) { ProcessBlock(blk); });
+                continue;
+            }
+
+            auto key = KeyOf(inst);
+            if (!key) {
+                continue;
+            }
+            if (auto existing = available.Get(*key)) {
+                inst->Result()->ReplaceAllUsesWith(*existing);
+                inst->Destroy();
+            } else {
+                available.Add(*key, inst->Result());
+                added.Push(std::move(*key));
+            }
+        }
+
+        for (auto& key : added) {
+            available.Remove(key);
+        }
+    }
+
+    /// @param inst the instruction
+    /// @returns the key of @p inst, or an empty optional if @p inst is not a pure instruction
+    std::optional<Key> KeyOf(Instruction* inst) {
+        std::optional<Key> key;
+        auto make_key = [&](uint32_t op) {
+            key = Key{&inst->TypeInfo(), op, inst->Result()->Type(), inst->Operands(), {}};
+        };
+        tint::Switch(
+            inst,  //
+            [&](Access*) { make_key(0); },
+            [&](Binary* binary) { make_key(static_cast<uint32_t>(binary->Kind())); },
+            [&](Bitcast*) { make_key(0); },
+            [&](Construct*) { make_key(0); },
+            [&](Convert*) { make_key(0); },
+            [&](Unary* unary) { make_key(static_cast<uint32_t>(unary->Kind())); },
+            [&](Swizzle* swizzle) {
+                make_key(0);
+                key->indices = swizzle->Indices();
+            },
+            [&](CoreBuiltinCall* call) {
+                if (IsPure(call->Func())) {
+                    make_key(static_cast<uint32_t>(call->Func()));
+                }
+            });
+        return key;
+    }
+
+    /// @param func the builtin function
+    /// @returns true if the result of @p func only depends on its arguments
+    bool IsPure(core::Function func) {
+        return !core::HasSideEffects(func) && !core::IsAtomicBuiltin(func) &&
+               !core::IsBarrierBuiltin(func) && !core::IsDerivativeBuiltin(func) &&
+               !core::IsTextureBuiltin(func) && !core::IsSubgroupBuiltin(func);
+    }
+};
+
+}  // namespace
+
+Result<SuccessType, std::string> CommonSubexpressionElimination(Module* ir) {
+    auto result = ValidateAndDumpIfNeeded(*ir, "CommonSubexpressionElimination transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::ir::transform
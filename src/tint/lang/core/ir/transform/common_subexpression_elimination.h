@@ -0,0 +1,39 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_COMMON_SUBEXPRESSION_ELIMINATION_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_COMMON_SUBEXPRESSION_ELIMINATION_H_
+
+#include <string>
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::ir {
+class Module;
+}
+
+namespace tint::ir::transform {
+
+/// CommonSubexpressionElimination is a transform that replaces the result of a pure instruction
+/// with the result of an identical instruction that dominates it. Only the instructions that
+/// precede the instruction in its own block and its enclosing blocks are considered, so the
+/// replacement value is always available where it is used.
+/// @param module the module to transform
+/// @returns an error string on failure
+Result<SuccessType, std::string> CommonSubexpressionElimination(Module* module);
+
+}  // namespace tint::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_COMMON_SUBEXPRESSION_ELIMINATION_H_
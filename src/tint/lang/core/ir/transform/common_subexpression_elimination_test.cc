@@ -0,0 +1,329 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+using IR_CommonSubexpressionEliminationTest = TransformTest;
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_DifferentOperations) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* y = b.FunctionParam("y", ty.i32());
+    auto* func = b.Function("foo", ty.void_());
+    func->SetParams({x, y});
+    b.Append(func->Block(), [&] {
+        b.Let("a", b.Add(ty.i32(), x, y));
+        b.Let("b", b.Add(ty.i32(), y, x));
+        b.Let("c", b.Subtract(ty.i32(), x, y));
+        b.Let("d", b.Convert(ty.f32(), x));
+        b.Let("e", b.Bitcast(ty.f32(), x));
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%foo = func(%x:i32, %y:i32):void -> %b1 {
+  %b1 = block {
+    %4:i32 = add %x, %y
+    %a:i32 = let %4
+    %6:i32 = add %y, %x
+    %b:i32 = let %6
+    %8:i32 = sub %x, %y
+    %c:i32 = let %8
+    %10:f32 = convert %x
+    %d:f32 = let %10
+    %12:f32 = bitcast %x
+    %e:f32 = let %12
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, SameBlock) {
+    auto* x = b.FunctionParam("x", ty.vec3<f32>());
+    auto* y = b.FunctionParam("y", ty.vec3<f32>());
+    auto* func = b.Function("foo", ty.f32());
+    func->SetParams({x, y});
+    b.Append(func->Block(), [&] {
+        auto* a = b.Multiply(ty.vec3<f32>(), x, y);
+        auto* c = b.Multiply(ty.vec3<f32>(), x, y);
+        auto* dot_a = b.Call(ty.f32(), core::Function::kDot, a, x);
+        auto* dot_c = b.Call(ty.f32(), core::Function::kDot, c, x);
+        b.Return(func, b.Add(ty.f32(), dot_a, dot_c));
+    });
+
+    auto* src = R"(
+%foo = func(%x:vec3<f32>, %y:vec3<f32>):f32 -> %b1 {
+  %b1 = block {
+    %4:vec3<f32> = mul %x, %y
+    %5:vec3<f32> = mul %x, %y
+    %6:f32 = dot %4, %x
+    %7:f32 = dot %5, %x
+    %8:f32 = add %6, %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%x:vec3<f32>, %y:vec3<f32>):f32 -> %b1 {
+  %b1 = block {
+    %4:vec3<f32> = mul %x, %y
+    %5:f32 = dot %4, %x
+    %6:f32 = add %5, %5
+    ret %6
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, Swizzle) {
+    auto* x = b.FunctionParam("x", ty.vec4<f32>());
+    auto* func = b.Function("foo", ty.void_());
+    func->SetParams({x});
+    b.Append(func->Block(), [&] {
+        b.Let("a", b.Swizzle(ty.vec2<f32>(), x, {0u, 1u}));
+        b.Let("b", b.Swizzle(ty.vec2<f32>(), x, {1u, 0u}));
+        b.Let("c", b.Swizzle(ty.vec2<f32>(), x, {0u, 1u}));
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%foo = func(%x:vec4<f32>):void -> %b1 {
+  %b1 = block {
+    %3:vec2<f32> = swizzle %x, xy
+    %a:vec2<f32> = let %3
+    %5:vec2<f32> = swizzle %x, yx
+    %b:vec2<f32> = let %5
+    %7:vec2<f32> = swizzle %x, xy
+    %c:vec2<f32> = let %7
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%x:vec4<f32>):void -> %b1 {
+  %b1 = block {
+    %3:vec2<f32> = swizzle %x, xy
+    %a:vec2<f32> = let %3
+    %5:vec2<f32> = swizzle %x, yx
+    %b:vec2<f32> = let %5
+    %c:vec2<f32> = let %3
+    ret
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, DominatingBlock) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({x, cond});
+    b.Append(func->Block(), [&] {
+        auto* outer = b.Multiply(ty.i32(), x, 3_i);
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Multiply(ty.i32(), x, 3_i));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, outer);
+        });
+        b.Return(func, ifelse->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func(%x:i32, %cond:bool):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = mul %x, 3i
+    %5:i32 = if %cond [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %6:i32 = mul %x, 3i
+        exit_if %6  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %4  # if_1
+      }
+    }
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%x:i32, %cond:bool):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = mul %x, 3i
+    %5:i32 = if %cond [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if %4  # if_1
+      }
+      %b3 = block {  # false
+        exit_if %4  # if_1
+      }
+    }
+    ret %5
+  }
+}
+)";
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_SiblingBlocks) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* cond = b.FunctionParam("cond", ty.bool_());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({x, cond});
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(cond);
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Multiply(ty.i32(), x, 3_i));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, b.Multiply(ty.i32(), x, 3_i));
+        });
+        auto* after = b.Multiply(ty.i32(), x, 3_i);
+        b.Return(func, b.Add(ty.i32(), ifelse->Result(0), after));
+    });
+
+    auto* src = R"(
+%foo = func(%x:i32, %cond:bool):i32 -> %b1 {
+  %b1 = block {
+    %4:i32 = if %cond [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %5:i32 = mul %x, 3i
+        exit_if %5  # if_1
+      }
+      %b3 = block {  # false
+        %6:i32 = mul %x, 3i
+        exit_if %6  # if_1
+      }
+    }
+    %7:i32 = mul %x, 3i
+    %8:i32 = add %4, %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_Loads) {
+    auto* var = b.Var("v", ty.ptr<private_, i32>());
+    b.RootBlock()->Append(var);
+
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* a = b.Load(var);
+        b.Store(var, 1_i);
+        auto* c = b.Load(var);
+        b.Return(func, b.Add(ty.i32(), a, c));
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %3:i32 = load %v
+    store %v, 1i
+    %4:i32 = load %v
+    %5:i32 = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_CommonSubexpressionEliminationTest, NoModify_Derivatives) {
+    auto* x = b.FunctionParam("x", ty.f32());
+    x->SetLocation(0, {});
+    auto* func = b.Function("foo", ty.f32(), Function::PipelineStage::kFragment);
+    func->SetParams({x});
+    func->SetReturnLocation(0_u, {});
+    b.Append(func->Block(), [&] {
+        auto* a = b.Call(ty.f32(), core::Function::kDpdx, x);
+        auto* c = b.Call(ty.f32(), core::Function::kDpdx, x);
+        b.Return(func, b.Add(ty.f32(), a, c));
+    });
+
+    auto* src = R"(
+%foo = @fragment func(%x:f32 [@location(0)]):f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %3:f32 = dpdx %x
+    %4:f32 = dpdx %x
+    %5:f32 = add %3, %4
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(CommonSubexpressionElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::ir::transform
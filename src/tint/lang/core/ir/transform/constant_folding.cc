@@ -0,0 +1,299 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/constant_folding.h"
+
+#include <memory>
+#include <utility>
+
+#include "src/tint/lang/core/constant/eval.h"
+#include "src/tint/lang/core/intrinsic/ctor_conv.h"
+#include "src/tint/lang/core/intrinsic/data/data.h"
+#include "src/tint/lang/core/intrinsic/table.h"
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/lang/core/type/array.h"
+#include "src/tint/lang/core/type/struct.h"
+#include "src/tint/utils/diagnostic/diagnostic.h"
+
+namespace tint::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module* ir = nullptr;
+
+    /// The IR builder.
+    Builder b{*ir};
+
+    /// The type manager.
+    core::type::Manager& ty{ir->Types()};
+
+    /// The diagnostics raised by the constant evaluator and the intrinsic table.
+    diag::List diags;
+
+    /// The constant evaluator. The instructions are evaluated with runtime semantics, as that is
+    /// when they would otherwise be executed.
+    core::constant::Eval eval{ir->constant_values, diags, /* use_runtime_semantics */ true};
+
+    /// The intrinsic table, used to find the constant evaluation functions of the operators,
+    /// builtins, value constructors and conversions.
+    std::unique_ptr<core::intrinsic::Table> intrinsics =
+        core::intrinsic::Table::Create(core::intrinsic::data::kData, ty, ir->symbols, diags);
+
+    /// Constructor
+    /// @param mod the module
+    explicit State(Module* mod) : ir(mod) {}
+
+    /// Process the module.
+    void Process() {
+        for (auto* func : ir->functions) {
+            ProcessBlock(func->Block());
+        }
+    }
+
+    /// Fold the instructions of a block, and of the blocks nested in it.
+    /// @param block the block to process
+    void ProcessBlock(Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            // As we're (potentially) removing the instruction that we're iterating over, grab a
+            // pointer to the next instruction before we make any changes.
+            auto* next = inst->next;
+            TINT_DEFER(inst = next);
+
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* blk) { ProcessBlock(blk); });
+                continue;
+            }
+
+            if (auto* let = inst->As<Let>()) {
+                // Propagate the value of a let that is initialized with a constant to its uses.
+                if (let->Value()->Is<ir::Constant>()) {
+                    let->Result()->ReplaceAllUsesWith(let->Value());
+                    let->Destroy();
+                }
+                continue;
+            }
+
+            if (auto* value = Fold(inst)) {
+                inst->Result()->ReplaceAllUsesWith(b.Constant(value));
+                inst->Destroy();
+            }
+        }
+    }
+
+    /// @param inst the instruction to fold
+    /// @returns the constant value of the result of @p inst, or nullptr if the instruction cannot
+    /// be folded.
+    const core::constant::Value* Fold(Instruction* inst) {
+        if (inst->HasMultiResults() || !inst->Result()) {
+            return nullptr;
+        }
+
+        // All the operands must be constants.
+        Vector<const core::constant::Value*, 4> args;
+        for (auto* operand : inst->Operands()) {
+            auto* constant = As<ir::Constant>(operand);
+            if (!constant) {
+                return nullptr;
+            }
+            args.Push(constant->Value());
+        }
+
+        auto* result_ty = inst->Result()->Type();
+        auto num_diags = diags.count();
+        auto result = tint::Switch(
+            inst,  //
+            [&](Binary* binary) {
+                return Call(intrinsics->Lookup(ToBinaryOp(binary->Kind()), args[0]->Type(),
+                                               args[1]->Type(), core::EvaluationStage::kRuntime,
+                                               Source{}, /* is_compound */ false),
+                            result_ty, args);
+            },
+            [&](Unary* unary) {
+                return Call(intrinsics->Lookup(ToUnaryOp(unary->Kind()), args[0]->Type(),
+                                               core::EvaluationStage::kRuntime, Source{}),
+                            result_ty, args);
+            },
+            [&](CoreBuiltinCall* call) {
+                return Call(intrinsics->Lookup(call->Func(), ArgTypes(args),
+                                               core::EvaluationStage::kRuntime, Source{}),
+                            result_ty, args);
+            },
+            [&](Construct*) { return EvalConstruct(result_ty, args); },
+            [&](Convert*) { return eval.Convert(result_ty, args[0], Source{}); },
+            [&](Bitcast*) { return eval.Bitcast(result_ty, args[0], Source{}); },
+            [&](Swizzle* swizzle) { return eval.Swizzle(result_ty, args[0], swizzle->Indices()); },
+            [&](Access*) {
+                core::constant::Eval::Result value{args[0]};
+                for (size_t i = 1; i < args.Length() && value && value.Get(); i++) {
+                    value = eval.Index(value.Get(), value.Get()->Type(), args[i], Source{});
+                }
+                return value;
+            },
+            [&](Default) { return core::constant::Eval::Result{nullptr}; });
+
+        // Leave the instruction unchanged if the evaluation failed, or raised any diagnostic.
+        if (!result || diags.count() != num_diags) {
+            diags = {};
+            return nullptr;
+        }
+        auto* value = result.Get();
+        if (!value || value->Type() != result_ty) {
+            return nullptr;
+        }
+        return value;
+    }
+
+    /// Calls the constant evaluation function of an intrinsic overload.
+    /// @param overload the result of the intrinsic table lookup
+    /// @param result_ty the result type
+    /// @param args the constant arguments
+    /// @returns the result of the evaluation, or nullptr if the overload has no constant
+    /// evaluation function.
+    core::constant::Eval::Result Call(
+        const tint::Result<core::intrinsic::Table::Overload>& overload,
+        const core::type::Type* result_ty,
+        VectorRef<const core::constant::Value*> args) {
+        if (!overload || !overload->const_eval_fn) {
+            return nullptr;
+        }
+        return eval.Call(overload->const_eval_fn, result_ty, args, Source{});
+    }
+
+    /// Evaluates a value constructor.
+    /// @param result_ty the type being constructed
+    /// @param args the constant arguments
+    /// @returns the result of the evaluation
+    core::constant::Eval::Result EvalConstruct(const core::type::Type* result_ty,
+                                           VectorRef<const core::constant::Value*> args) {
+        if (result_ty->IsAnyOf<core::type::Array, core::type::Struct>()) {
+            return eval.ArrayOrStructCtor(result_ty, std::move(args));
+        }
+        auto arg_tys = ArgTypes(args);
+        return Call(tint::Switch(
+                        result_ty,  //
+                        [&](const core::type::Vector* v) {
+                            return intrinsics->Lookup(
+                                v->Packed() ? core::intrinsic::CtorConv::kPackedVec3
+                                            : core::intrinsic::VectorCtorConv(v->Width()),
+                                v->type(), arg_tys, core::EvaluationStage::kRuntime, Source{});
+                        },
+                        [&](const core::type::Matrix* m) {
+                            return intrinsics->Lookup(
+                                core::intrinsic::MatrixCtorConv(m->columns(), m->rows()),
+                                m->type(), arg_tys, core::EvaluationStage::kRuntime, Source{});
+                        },
+                        [&](Default) {
+                            return intrinsics->Lookup(ScalarCtorConv(result_ty), nullptr, arg_tys,
+                                                      core::EvaluationStage::kRuntime, Source{});
+                        }),
+                    result_ty, args);
+    }
+
+    /// @param args the constant arguments
+    /// @returns the types of @p args
+    Vector<const core::type::Type*, 4> ArgTypes(VectorRef<const core::constant::Value*> args) {
+        Vector<const core::type::Type*, 4> types;
+        for (auto* arg : args) {
+            types.Push(arg->Type());
+        }
+        return types;
+    }
+
+    /// @param type a scalar type
+    /// @returns the CtorConv for the scalar type @p type
+    core::intrinsic::CtorConv ScalarCtorConv(const core::type::Type* type) {
+        return tint::Switch(
+            type,  //
+            [&](const core::type::I32*) { return core::intrinsic::CtorConv::kI32; },
+            [&](const core::type::U32*) { return core::intrinsic::CtorConv::kU32; },
+            [&](const core::type::F32*) { return core::intrinsic::CtorConv::kF32; },
+            [&](const core::type::F16*) { return core::intrinsic::CtorConv::kF16; },
+            [&](const core::type::Bool*) { return core::intrinsic::CtorConv::kBool; },
+            [&](Default) { return core::intrinsic::CtorConv::kNone; });
+    }
+
+    /// @param kind the IR binary instruction kind
+    /// @returns the binary operator for @p kind
+    core::BinaryOp ToBinaryOp(enum Binary::Kind kind) {
+        switch (kind) {
+            case Binary::Kind::kAdd:
+                return core::BinaryOp::kAdd;
+            case Binary::Kind::kSubtract:
+                return core::BinaryOp::kSubtract;
+            case Binary::Kind::kMultiply:
+                return core::BinaryOp::kMultiply;
+            case Binary::Kind::kDivide:
+                return core::BinaryOp::kDivide;
+            case Binary::Kind::kModulo:
+                return core::BinaryOp::kModulo;
+            case Binary::Kind::kAnd:
+                return core::BinaryOp::kAnd;
+            case Binary::Kind::kOr:
+                return core::BinaryOp::kOr;
+            case Binary::Kind::kXor:
+                return core::BinaryOp::kXor;
+            case Binary::Kind::kEqual:
+                return core::BinaryOp::kEqual;
+            case Binary::Kind::kNotEqual:
+                return core::BinaryOp::kNotEqual;
+            case Binary::Kind::kLessThan:
+                return core::BinaryOp::kLessThan;
+            case Binary::Kind::kGreaterThan:
+                return core::BinaryOp::kGreaterThan;
+            case Binary::Kind::kLessThanEqual:
+                return core::BinaryOp::kLessThanEqual;
+            case Binary::Kind::kGreaterThanEqual:
+                return core::BinaryOp::kGreaterThanEqual;
+            case Binary::Kind::kShiftLeft:
+                return core::BinaryOp::kShiftLeft;
+            case Binary::Kind::kShiftRight:
+                return core::BinaryOp::kShiftRight;
+        }
+        TINT_UNREACHABLE() << "unhandled binary kind: " << kind;
+        return core::BinaryOp::kAdd;
+    }
+
+    /// @param kind the IR unary instruction kind
+    /// @returns the unary operator for @p kind
+    core::UnaryOp ToUnaryOp(enum Unary::Kind kind) {
+        switch (kind) {
+            case Unary::Kind::kComplement:
+                return core::UnaryOp::kComplement;
+            case Unary::Kind::kNegation:
+                return core::UnaryOp::kNegation;
+        }
+        TINT_UNREACHABLE() << "unhandled unary kind";
+        return core::UnaryOp::kNegation;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType, std::string> ConstantFolding(Module* ir) {
+    auto result = ValidateAndDumpIfNeeded(*ir, "ConstantFolding transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::ir::transform
@@ -0,0 +1,41 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_FOLDING_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_FOLDING_H_
+
+#include <string>
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::ir {
+class Module;
+}
+
+namespace tint::ir::transform {
+
+/// ConstantFolding is a transform that replaces instructions whose operands are all constants with
+/// the constant value of their result. The values are calculated with the same constant evaluator
+/// that the resolver uses, with runtime semantics. Instructions that would raise a diagnostic when
+/// evaluated, such as an integer division by zero, are left unchanged.
+///
+/// Let instructions that are initialized with a constant are also replaced with their value.
+/// @param module the module to transform
+/// @returns an error string on failure
+Result<SuccessType, std::string> ConstantFolding(Module* module);
+
+}  // namespace tint::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_CONSTANT_FOLDING_H_
@@ -0,0 +1,530 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/constant_folding.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+using IR_ConstantFoldingTest = TransformTest;
+
+TEST_F(IR_ConstantFoldingTest, NoModify_NonConstantOperand) {
+    auto* param = b.FunctionParam("param", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), param, 1_i);
+        b.Return(func, add);
+    });
+
+    auto* src = R"(
+%foo = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %param, 1i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Binary) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), 1_i, 2_i);
+        auto* mul = b.Multiply(ty.i32(), add, 3_i);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 1i, 2i
+    %3:i32 = mul %2, 3i
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 9i
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Binary_VectorScalar) {
+    auto* func = b.Function("foo", ty.vec3<f32>());
+    b.Append(func->Block(), [&] {
+        auto* mul = b.Multiply(ty.vec3<f32>(), b.Composite(ty.vec3<f32>(), 1_f, 2_f, 3_f), 2_f);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func():vec3<f32> -> %b1 {
+  %b1 = block {
+    %2:vec3<f32> = mul vec3<f32>(1.0f, 2.0f, 3.0f), 2.0f
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():vec3<f32> -> %b1 {
+  %b1 = block {
+    ret vec3<f32>(2.0f, 4.0f, 6.0f)
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Comparison) {
+    auto* func = b.Function("foo", ty.bool_());
+    b.Append(func->Block(), [&] {
+        auto* lt = b.LessThan(ty.bool_(), 1_u, 2_u);
+        b.Return(func, lt);
+    });
+
+    auto* src = R"(
+%foo = func():bool -> %b1 {
+  %b1 = block {
+    %2:bool = lt 1u, 2u
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():bool -> %b1 {
+  %b1 = block {
+    ret true
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Unary) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* neg = b.Negation(ty.i32(), 4_i);
+        auto* cpl = b.Complement(ty.i32(), neg);
+        b.Return(func, cpl);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = negation 4i
+    %3:i32 = complement %2
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 3i
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, BuiltinCall) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* max = b.Call(ty.f32(), core::Function::kMax, 1_f, 2_f);
+        auto* sqrt = b.Call(ty.f32(), core::Function::kSqrt, max);
+        b.Return(func, sqrt);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %2:f32 = max 1.0f, 2.0f
+    %3:f32 = sqrt %2
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    ret 1.41421353816986083984f
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, NoModify_BuiltinCallWithoutConstEval) {
+    auto* func = b.Function("foo", ty.f32(), Function::PipelineStage::kFragment);
+    func->SetReturnLocation(0_u, {});
+    b.Append(func->Block(), [&] {
+        auto* dpdx = b.Call(ty.f32(), core::Function::kDpdx, 1_f);
+        b.Return(func, dpdx);
+    });
+
+    auto* src = R"(
+%foo = @fragment func():f32 [@location(0)] -> %b1 {
+  %b1 = block {
+    %2:f32 = dpdx 1.0f
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, ConstructAndSwizzle) {
+    auto* func = b.Function("foo", ty.vec2<f32>());
+    b.Append(func->Block(), [&] {
+        auto* construct = b.Construct(ty.vec3<f32>(), 1_f, 2_f, 3_f);
+        auto* swizzle = b.Swizzle(ty.vec2<f32>(), construct, {2u, 1u});
+        b.Return(func, swizzle);
+    });
+
+    auto* src = R"(
+%foo = func():vec2<f32> -> %b1 {
+  %b1 = block {
+    %2:vec3<f32> = construct 1.0f, 2.0f, 3.0f
+    %3:vec2<f32> = swizzle %2, zy
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():vec2<f32> -> %b1 {
+  %b1 = block {
+    ret vec2<f32>(3.0f, 2.0f)
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Construct_Splat) {
+    auto* func = b.Function("foo", ty.vec4<i32>());
+    b.Append(func->Block(), [&] {
+        auto* construct = b.Construct(ty.vec4<i32>(), 7_i);
+        b.Return(func, construct);
+    });
+
+    auto* src = R"(
+%foo = func():vec4<i32> -> %b1 {
+  %b1 = block {
+    %2:vec4<i32> = construct 7i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():vec4<i32> -> %b1 {
+  %b1 = block {
+    ret vec4<i32>(7i)
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Construct_Array) {
+    auto* func = b.Function("foo", ty.array<u32, 3>());
+    b.Append(func->Block(), [&] {
+        auto* construct = b.Construct(ty.array<u32, 3>(), 1_u, 2_u, 3_u);
+        b.Return(func, construct);
+    });
+
+    auto* src = R"(
+%foo = func():array<u32, 3> -> %b1 {
+  %b1 = block {
+    %2:array<u32, 3> = construct 1u, 2u, 3u
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():array<u32, 3> -> %b1 {
+  %b1 = block {
+    ret array<u32, 3>(1u, 2u, 3u)
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Access) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* mat = b.Composite(ty.mat2x2<f32>(), b.Composite(ty.vec2<f32>(), 1_f, 2_f),
+                                b.Composite(ty.vec2<f32>(), 3_f, 4_f));
+        auto* access = b.Access(ty.f32(), mat, 1_u, 0_u);
+        b.Return(func, access);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %2:f32 = access mat2x2<f32>(vec2<f32>(1.0f, 2.0f), vec2<f32>(3.0f, 4.0f)), 1u, 0u
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    ret 3.0f
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, ConvertAndBitcast) {
+    auto* func = b.Function("foo", ty.u32());
+    b.Append(func->Block(), [&] {
+        auto* convert = b.Convert(ty.i32(), 2.5_f);
+        auto* neg = b.Negation(ty.i32(), convert);
+        auto* bitcast = b.Bitcast(ty.u32(), neg);
+        b.Return(func, bitcast);
+    });
+
+    auto* src = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    %2:i32 = convert 2.5f
+    %3:i32 = negation %2
+    %4:u32 = bitcast %3
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():u32 -> %b1 {
+  %b1 = block {
+    ret 4294967294u
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, Let) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* let = b.Let("x", b.Add(ty.i32(), 1_i, 2_i));
+        auto* mul = b.Multiply(ty.i32(), let, 2_i);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 1i, 2i
+    %x:i32 = let %2
+    %4:i32 = mul %x, 2i
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    ret 6i
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, IfCondition) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* ifelse = b.If(b.GreaterThan(ty.bool_(), 2_i, 1_i));
+        ifelse->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(ifelse->True(), [&] {  //
+            b.ExitIf(ifelse, b.Add(ty.i32(), 1_i, 1_i));
+        });
+        b.Append(ifelse->False(), [&] {  //
+            b.ExitIf(ifelse, 3_i);
+        });
+        b.Return(func, ifelse->Result(0));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:bool = gt 2i, 1i
+    %3:i32 = if %2 [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        %4:i32 = add 1i, 1i
+        exit_if %4  # if_1
+      }
+      %b3 = block {  # false
+        exit_if 3i  # if_1
+      }
+    }
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = if true [t: %b2, f: %b3] {  # if_1
+      %b2 = block {  # true
+        exit_if 2i  # if_1
+      }
+      %b3 = block {  # false
+        exit_if 3i  # if_1
+      }
+    }
+    ret %2
+  }
+}
+)";
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, NoModify_IntegerDivideByZero) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* div = b.Divide(ty.i32(), 1_i, 0_i);
+        b.Return(func, div);
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = div 1i, 0i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_ConstantFoldingTest, NoModify_FloatOverflow) {
+    auto* func = b.Function("foo", ty.f32());
+    b.Append(func->Block(), [&] {
+        auto* mul = b.Multiply(ty.f32(), 3e38_f, 10_f);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func():f32 -> %b1 {
+  %b1 = block {
+    %2:f32 = mul 300000000549775575777803994281145270272.0f, 10.0f
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(ConstantFolding);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::ir::transform
@@ -0,0 +1,135 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+
+namespace tint::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The IR module.
+    Module* ir = nullptr;
+
+    /// True if an instruction was removed by the current pass over the module.
+    bool changed = false;
+
+    /// Constructor
+    /// @param mod the module
+    explicit State(Module* mod) : ir(mod) {}
+
+    /// Process the module.
+    void Process() {
+        // Removing an instruction can make the instructions that produce its operands dead, so
+        // repeat until there is nothing left to remove.
+        do {
+            changed = false;
+            for (auto* func : ir->functions) {
+                ProcessBlock(func->Block());
+            }
+        } while (changed);
+    }
+
+    /// Remove the dead instructions of a block, and of the blocks nested in it.
+    /// @param block the block to process
+    void ProcessBlock(Block* block) {
+        // Walk the instructions in reverse order, so that the users of a result are removed before
+        // the instruction that produces it is visited.
+        for (auto* inst = block->Back(); inst;) {
+            // As we're (potentially) removing the instruction that we're iterating over, grab a
+            // pointer to the previous instruction before we make any changes.
+            auto* prev = inst->prev;
+            TINT_DEFER(inst = prev);
+
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                Vector<Block*, 4> blocks;
+                ctrl->ForeachBlock([&](Block* blk) { blocks.Push(blk); });
+                blocks.Reverse();
+                for (auto* blk : blocks) {
+                    ProcessBlock(blk);
+                }
+                continue;
+            }
+
+            if (auto* var = inst->As<Var>()) {
+                // Remove variables that are never read, along with the stores to them.
+                if (var->Result()->Usages().All(
+                        [](const Usage& u) { return u.instruction->Is<Store>(); })) {
+                    var->DestroyIfOnlyAssigned();
+                    changed = true;
+                }
+                continue;
+            }
+
+            if (HasNoSideEffects(inst) && !HasUsedResults(inst)) {
+                inst->Destroy();
+                changed = true;
+            }
+        }
+    }
+
+    /// @param inst the instruction
+    /// @returns true if @p inst can be removed without changing the behavior of the program, when
+    /// its results are not used.
+    bool HasNoSideEffects(Instruction* inst) {
+        return tint::Switch(
+            inst,  //
+            [&](Access*) { return true; },
+            [&](Binary*) { return true; },
+            [&](Bitcast*) { return true; },
+            [&](Construct*) { return true; },
+            [&](Convert*) { return true; },
+            [&](Let*) { return true; },
+            [&](Load*) { return true; },
+            [&](LoadVectorElement*) { return true; },
+            [&](Swizzle*) { return true; },
+            [&](Unary*) { return true; },
+            [&](CoreBuiltinCall* call) {
+                return !core::HasSideEffects(call->Func()) &&
+                       !core::IsBarrierBuiltin(call->Func());
+            },
+            [&](Default) { return false; });
+    }
+
+    /// @param inst the instruction
+    /// @returns true if any of the results of @p inst are used
+    bool HasUsedResults(Instruction* inst) {
+        for (auto* result : inst->Results()) {
+            if (!result->Usages().IsEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+}  // namespace
+
+Result<SuccessType, std::string> DeadCodeElimination(Module* ir) {
+    auto result = ValidateAndDumpIfNeeded(*ir, "DeadCodeElimination transform");
+    if (!result) {
+        return result;
+    }
+
+    State{ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::ir::transform
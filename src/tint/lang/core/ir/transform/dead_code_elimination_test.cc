@@ -0,0 +1,299 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+using IR_DeadCodeEliminationTest = TransformTest;
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_AllUsed) {
+    auto* param = b.FunctionParam("param", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* add = b.Add(ty.i32(), param, 1_i);
+        auto* mul = b.Multiply(ty.i32(), add, param);
+        b.Return(func, mul);
+    });
+
+    auto* src = R"(
+%foo = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %param, 1i
+    %4:i32 = mul %3, %param
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedChain) {
+    auto* param = b.FunctionParam("param", ty.vec4<f32>());
+    auto* func = b.Function("foo", ty.f32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* swizzle = b.Swizzle(ty.vec2<f32>(), param, {0u, 1u});
+        auto* construct = b.Construct(ty.vec4<f32>(), swizzle, swizzle);
+        auto* add = b.Add(ty.vec4<f32>(), construct, param);
+        b.Let("unused", b.Call(ty.f32(), core::Function::kLength, add));
+        b.Return(func, b.Access(ty.f32(), param, 3_u));
+    });
+
+    auto* src = R"(
+%foo = func(%param:vec4<f32>):f32 -> %b1 {
+  %b1 = block {
+    %3:vec2<f32> = swizzle %param, xy
+    %4:vec4<f32> = construct %3, %3
+    %5:vec4<f32> = add %4, %param
+    %6:f32 = length %5
+    %unused:f32 = let %6
+    %8:f32 = access %param, 3u
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%param:vec4<f32>):f32 -> %b1 {
+  %b1 = block {
+    %3:f32 = access %param, 3u
+    ret %3
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedLoad) {
+    auto* var = b.Var("v", ty.ptr<private_, i32>());
+    b.RootBlock()->Append(var);
+
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        b.Load(var);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    %3:i32 = load %v
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    ret
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_SideEffects) {
+    auto* buffer = b.Var("buffer", ty.ptr(storage, ty.atomic<i32>()));
+    buffer->SetBindingPoint(0, 0);
+    b.RootBlock()->Append(buffer);
+
+    auto* callee = b.Function("callee", ty.i32());
+    b.Append(callee->Block(), [&] {  //
+        b.Return(callee, 1_i);
+    });
+
+    auto* func = b.Function("foo", ty.void_(), Function::PipelineStage::kCompute,
+                            std::array{1u, 1u, 1u});
+    b.Append(func->Block(), [&] {
+        b.Call(ty.i32(), core::Function::kAtomicAdd, buffer, 1_i);
+        b.Call(ty.void_(), core::Function::kWorkgroupBarrier);
+        b.Call(ty.i32(), callee);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %buffer:ptr<storage, atomic<i32>, read_write> = var @binding_point(0, 0)
+}
+
+%callee = func():i32 -> %b2 {
+  %b2 = block {
+    ret 1i
+  }
+}
+%foo = @compute @workgroup_size(1, 1, 1) func():void -> %b3 {
+  %b3 = block {
+    %4:i32 = atomicAdd %buffer, 1i
+    %5:void = workgroupBarrier 
+    %6:i32 = call %callee
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, VarOnlyStored) {
+    auto* param = b.FunctionParam("param", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* var = b.Var("v", ty.ptr<function, i32>());
+        var->SetInitializer(b.Add(ty.i32(), param, 1_i)->Result());
+        b.Store(var, b.Multiply(ty.i32(), param, 2_i));
+        b.Return(func, param);
+    });
+
+    auto* src = R"(
+%foo = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var, %4
+    %4:i32 = add %param, 1i
+    %5:i32 = mul %param, 2i
+    store %v, %5
+    ret %param
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%param:i32):i32 -> %b1 {
+  %b1 = block {
+    ret %param
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, NoModify_VarLoaded) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* var = b.Var("v", ty.ptr<function, i32>());
+        b.Store(var, 2_i);
+        b.Return(func, b.Load(var));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    store %v, 2i
+    %3:i32 = load %v
+    ret %3
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_DeadCodeEliminationTest, UnusedInNestedBlock) {
+    auto* param = b.FunctionParam("param", ty.bool_());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({param});
+    b.Append(func->Block(), [&] {
+        auto* value = b.Let("value", 42_i);
+        auto* ifelse = b.If(param);
+        b.Append(ifelse->True(), [&] {
+            b.Negation(ty.i32(), value);
+            b.ExitIf(ifelse);
+        });
+        b.Return(func, 0_i);
+    });
+
+    auto* src = R"(
+%foo = func(%param:bool):i32 -> %b1 {
+  %b1 = block {
+    %value:i32 = let 42i
+    if %param [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %4:i32 = negation %value
+        exit_if  # if_1
+      }
+    }
+    ret 0i
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%param:bool):i32 -> %b1 {
+  %b1 = block {
+    if %param [t: %b2] {  # if_1
+      %b2 = block {  # true
+        exit_if  # if_1
+      }
+    }
+    ret 0i
+  }
+}
+)";
+
+    Run(DeadCodeElimination);
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::ir::transform
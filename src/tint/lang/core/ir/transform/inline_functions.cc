@@ -0,0 +1,480 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/inline_functions.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/constant/eval.h"
+#include "src/tint/lang/core/ir/builder.h"
+#include "src/tint/lang/core/ir/module.h"
+#include "src/tint/lang/core/ir/validator.h"
+#include "src/tint/utils/containers/hashmap.h"
+#include "src/tint/utils/containers/hashset.h"
+
+namespace tint::ir::transform {
+
+namespace {
+
+/// PIMPL state for the transform.
+struct State {
+    /// The cost model configuration.
+    const InlineFunctionsConfig& config;
+
+    /// The IR module.
+    Module* ir = nullptr;
+
+    /// The IR builder.
+    Builder b{*ir};
+
+    /// The functions whose body can be inlined, and the cost of the body.
+    Hashmap<Function*, uint32_t, 16> inlinable_costs{};
+
+    /// The functions that have had calls to them inlined.
+    Hashset<Function*, 16> inlined{};
+
+    /// Map from the values of the function being inlined to the values of the call site.
+    Hashmap<Value*, Value*, 32> values{};
+
+    /// Map from the control instructions of the function being inlined to their copies.
+    Hashmap<ControlInstruction*, ControlInstruction*, 8> control_instructions{};
+
+    /// Whether the call being inlined is nested in a loop.
+    bool call_in_loop = false;
+
+    /// Process the module.
+    void Process() {
+        // Visit the functions from the leaves of the call graph upwards, so that the calls made by
+        // a function have been inlined before the function is considered for inlining.
+        Vector<Function*, 16> order;
+        Hashset<Function*, 16> visited;
+        for (auto* func : ir->functions) {
+            PostOrder(func, visited, order);
+        }
+        for (auto* func : order) {
+            InlineCalls(func->Block());
+            if (auto cost = InlinableCost(func)) {
+                inlinable_costs.Add(func, *cost);
+            }
+        }
+
+        // Remove the functions that are no longer called now that they have been inlined.
+        for (size_t i = 0; i < ir->functions.Length();) {
+            auto* func = ir->functions[i];
+            if (inlined.Contains(func) && CallCount(func) == 0) {
+                DestroyBlock(func->Block());
+                ir->functions.Erase(i);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    /// Appends @p func to @p order after the functions that it calls.
+    /// @param func the function
+    /// @param visited the functions that have already been visited
+    /// @param order the list of functions in post-order
+    void PostOrder(Function* func, Hashset<Function*, 16>& visited, Vector<Function*, 16>& order) {
+        if (!visited.Add(func)) {
+            return;
+        }
+        Vector<Function*, 8> callees;
+        CollectCallees(func->Block(), callees);
+        for (auto* callee : callees) {
+            PostOrder(callee, visited, order);
+        }
+        order.Push(func);
+    }
+
+    /// Collects the functions called by the instructions of a block.
+    /// @param block the block
+    /// @param callees the list of called functions
+    void CollectCallees(Block* block, Vector<Function*, 8>& callees) {
+        for (auto* inst : *block) {
+            if (auto* call = inst->As<UserCall>()) {
+                callees.Push(call->Func());
+            } else if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* blk) { CollectCallees(blk, callees); });
+            }
+        }
+    }
+
+    /// @param func the function
+    /// @returns the number of calls to @p func
+    uint32_t CallCount(Function* func) {
+        uint32_t count = 0;
+        for (auto& use : func->Usages()) {
+            if (use.instruction->Is<UserCall>()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /// @param func the function
+    /// @returns the cost of the body of @p func, or an empty optional if @p func cannot be inlined
+    std::optional<uint32_t> InlinableCost(Function* func) {
+        if (func->Stage() != Function::PipelineStage::kUndefined) {
+            return std::nullopt;
+        }
+
+        // The only return must be the terminator of the function block, so that the body falls
+        // through to the instructions that follow the call.
+        auto* ret = func->Block()->Terminator()->As<Return>();
+        if (!ret) {
+            return std::nullopt;
+        }
+        for (auto& use : func->Usages()) {
+            if (use.instruction->Is<Return>() && use.instruction != ret) {
+                return std::nullopt;
+            }
+        }
+
+        uint32_t cost = 0;
+        if (!BlockCost(func->Block(), cost)) {
+            return std::nullopt;
+        }
+        return cost;
+    }
+
+    /// Adds the cost of the instructions of a block to @p cost.
+    /// @param block the block
+    /// @param cost the accumulated cost
+    /// @returns false if the block contains an instruction that cannot be copied
+    bool BlockCost(Block* block, uint32_t& cost) {
+        for (auto* inst : *block) {
+            if (!CanCopy(inst)) {
+                return false;
+            }
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                bool ok = true;
+                ctrl->ForeachBlock([&](Block* blk) { ok = ok && BlockCost(blk, cost); });
+                if (!ok) {
+                    return false;
+                }
+            }
+            if (!inst->IsAnyOf<Let, Terminator>()) {
+                cost++;
+            }
+        }
+        return true;
+    }
+
+    /// @param inst the instruction
+    /// @returns true if Copy() supports @p inst
+    bool CanCopy(Instruction* inst) {
+        return inst->IsAnyOf<Access, Binary, Bitcast, BreakIf, Construct, Continue, Convert,
+                             CoreBuiltinCall, Discard, Exit, If, IntrinsicCall, Let, Load,
+                             LoadVectorElement, Loop, NextIteration, Return, Store,
+                             StoreVectorElement, Switch, Swizzle, TerminateInvocation, Unary,
+                             Unreachable, UserCall, Var>();
+    }
+
+    /// Inlines the calls made by the instructions of a block, and of the blocks nested in it.
+    /// @param block the block
+    void InlineCalls(Block* block) {
+        for (auto* inst = block->Front(); inst;) {
+            // As we're (potentially) replacing the instruction that we're iterating over, grab a
+            // pointer to the next instruction before we make any changes.
+            auto* next = inst->next;
+            TINT_DEFER(inst = next);
+
+            if (auto* call = inst->As<UserCall>()) {
+                if (ShouldInline(call->Func())) {
+                    Inline(call);
+                }
+            } else if (auto* ctrl = inst->As<ControlInstruction>()) {
+                ctrl->ForeachBlock([&](Block* blk) { InlineCalls(blk); });
+            }
+        }
+    }
+
+    /// @param func the called function
+    /// @returns true if the cost model selects the calls to @p func to be inlined
+    bool ShouldInline(Function* func) {
+        auto cost = inlinable_costs.Get(func);
+        if (!cost) {
+            return false;
+        }
+        if (*cost <= config.max_cost) {
+            return true;
+        }
+        return *cost <= config.max_single_call_cost && CallCount(func) == 1;
+    }
+
+    /// Replaces a call with a copy of the body of the called function.
+    /// @param call the call
+    void Inline(UserCall* call) {
+        auto* func = call->Func();
+        inlined.Add(func);
+
+        values.Clear();
+        control_instructions.Clear();
+        for (size_t i = 0; i < func->Params().Length(); i++) {
+            values.Add(func->Params()[i], call->Args()[i]);
+        }
+
+        call_in_loop = InLoop(call);
+        for (auto* inst : *func->Block()) {
+            if (auto* ret = inst->As<Return>()) {
+                if (auto* value = ret->Value()) {
+                    call->Result()->ReplaceAllUsesWith(Get(value));
+                }
+                break;
+            }
+            Copy(inst)->InsertBefore(call);
+        }
+        call->Destroy();
+    }
+
+    /// @param inst the instruction
+    /// @returns true if @p inst is nested in a loop
+    bool InLoop(Instruction* inst) {
+        for (auto* block = inst->Block(); block && block->Parent();) {
+            auto* ctrl = block->Parent();
+            if (ctrl->Is<Loop>()) {
+                return true;
+            }
+            block = ctrl->Block();
+        }
+        return false;
+    }
+
+    /// Sets the initializer of a variable to the zero value of its store type.
+    /// @param var the variable
+    void ZeroInitialize(Var* var) {
+        diag::List diags;
+        core::constant::Eval eval{ir->constant_values, diags};
+        auto* type = var->Result()->Type()->UnwrapPtr();
+        if (auto zero = eval.Zero(type, tint::Empty, Source{})) {
+            var->SetInitializer(b.Constant(zero.Get()));
+        }
+    }
+
+    /// @param value a value used by the function being inlined
+    /// @returns the value to use in place of @p value at the call site
+    Value* Get(Value* value) {
+        if (auto mapped = values.Get(value)) {
+            return *mapped;
+        }
+        return value;
+    }
+
+    /// @param args values used by the function being inlined
+    /// @returns the values to use in place of @p args at the call site
+    template <typename T>
+    Vector<Value*, 4> Get(tint::Slice<T> args) {
+        Vector<Value*, 4> out;
+        for (auto* arg : args) {
+            out.Push(Get(arg));
+        }
+        return out;
+    }
+
+    /// @param inst an instruction of the function being inlined
+    /// @returns a new result for the copy of @p inst
+    InstructionResult* Result(Instruction* inst) {
+        auto* result = b.InstructionResult(inst->Result()->Type());
+        values.Add(inst->Result(), result);
+        if (auto name = ir->NameOf(inst->Result())) {
+            ir->SetName(result, name);
+        }
+        return result;
+    }
+
+    /// @param ctrl a control instruction of the function being inlined
+    /// @returns the copy of @p ctrl
+    template <typename T>
+    T* Control(T* ctrl) {
+        return (*control_instructions.Get(ctrl))->template As<T>();
+    }
+
+    /// @param inst an instruction of the function being inlined
+    /// @returns a copy of @p inst, which uses the values of the call site
+    Instruction* Copy(Instruction* inst) {
+        auto& insts = ir->instructions;
+        return tint::Switch(
+            inst,  //
+            [&](Access* a) {
+                return insts.Create<Access>(Result(a), Get(a->Object()), Get(a->Indices()));
+            },
+            [&](Binary* bin) {
+                return insts.Create<Binary>(Result(bin), bin->Kind(), Get(bin->LHS()),
+                                            Get(bin->RHS()));
+            },
+            [&](Bitcast* bc) { return insts.Create<Bitcast>(Result(bc), Get(bc->Val())); },
+            [&](Construct* c) { return insts.Create<Construct>(Result(c), Get(c->Args())); },
+            [&](Convert* c) { return insts.Create<Convert>(Result(c), Get(c->Args()[0])); },
+            [&](CoreBuiltinCall* c) {
+                return insts.Create<CoreBuiltinCall>(Result(c), c->Func(), Get(c->Args()));
+            },
+            [&](IntrinsicCall* c) {
+                return insts.Create<IntrinsicCall>(Result(c), c->Kind(), Get(c->Args()));
+            },
+            [&](UserCall* c) {
+                return insts.Create<UserCall>(Result(c), c->Func(), Get(c->Args()));
+            },
+            [&](Discard*) { return insts.Create<Discard>(); },
+            [&](Let* l) { return insts.Create<Let>(Result(l), Get(l->Value())); },
+            [&](Load* l) { return insts.Create<Load>(Result(l), Get(l->From())); },
+            [&](LoadVectorElement* l) {
+                return insts.Create<LoadVectorElement>(Result(l), Get(l->From()),
+                                                       Get(l->Index()));
+            },
+            [&](Store* s) { return insts.Create<Store>(Get(s->To()), Get(s->From())); },
+            [&](StoreVectorElement* s) {
+                return insts.Create<StoreVectorElement>(Get(s->To()), Get(s->Index()),
+                                                        Get(s->Value()));
+            },
+            [&](Swizzle* s) {
+                return insts.Create<Swizzle>(Result(s), Get(s->Object()), s->Indices());
+            },
+            [&](Unary* u) { return insts.Create<Unary>(Result(u), u->Kind(), Get(u->Val())); },
+            [&](Var* v) {
+                auto* var = insts.Create<Var>(Result(v));
+                if (v->Initializer()) {
+                    var->SetInitializer(Get(v->Initializer()));
+                } else if (call_in_loop) {
+                    // A variable is zero-initialized each time that the function is called, so
+                    // the copy of it in a loop needs an explicit initializer. This includes the
+                    // variables declared in the blocks of the function's control instructions.
+                    ZeroInitialize(var);
+                }
+                return var;
+            },
+            [&](If* i) {
+                auto* copy = insts.Create<If>(Get(i->Condition()), b.Block(), b.Block());
+                CopyResults(i, copy);
+                CopyBlock(i->True(), copy->True());
+                CopyBlock(i->False(), copy->False());
+                return copy;
+            },
+            [&](Switch* s) {
+                auto* copy = insts.Create<Switch>(Get(s->Condition()));
+                CopyResults(s, copy);
+                for (auto& c : s->Cases()) {
+                    CopyBlock(c.Block(), b.Case(copy, c.selectors));
+                }
+                return copy;
+            },
+            [&](Loop* l) {
+                auto* copy = insts.Create<Loop>(b.Block(), b.MultiInBlock(), b.MultiInBlock());
+                CopyResults(l, copy);
+                CopyParams(l->Body(), copy->Body());
+                CopyParams(l->Continuing(), copy->Continuing());
+                CopyBlock(l->Initializer(), copy->Initializer());
+                CopyBlock(l->Body(), copy->Body());
+                CopyBlock(l->Continuing(), copy->Continuing());
+                return copy;
+            },
+            [&](ExitIf* e) { return insts.Create<ExitIf>(Control<If>(e->If()), Get(e->Args())); },
+            [&](ExitLoop* e) {
+                return insts.Create<ExitLoop>(Control<Loop>(e->Loop()), Get(e->Args()));
+            },
+            [&](ExitSwitch* e) {
+                return insts.Create<ExitSwitch>(Control<Switch>(e->Switch()), Get(e->Args()));
+            },
+            [&](NextIteration* n) {
+                return insts.Create<NextIteration>(Control<Loop>(n->Loop()), Get(n->Args()));
+            },
+            [&](Continue* c) {
+                return insts.Create<Continue>(Control<Loop>(c->Loop()), Get(c->Args()));
+            },
+            [&](BreakIf* bi) {
+                return insts.Create<BreakIf>(Get(bi->Condition()), Control<Loop>(bi->Loop()),
+                                             Get(bi->Args()));
+            },
+            [&](TerminateInvocation*) { return insts.Create<TerminateInvocation>(); },
+            [&](Unreachable*) { return insts.Create<Unreachable>(); },
+            [&](Default) {
+                TINT_ICE() << "unhandled instruction " << inst->FriendlyName();
+                return nullptr;
+            });
+    }
+
+    /// Creates the results of a copy of a control instruction.
+    /// @param ctrl the control instruction of the function being inlined
+    /// @param copy the copy of @p ctrl
+    void CopyResults(ControlInstruction* ctrl, ControlInstruction* copy) {
+        control_instructions.Add(ctrl, copy);
+        Vector<InstructionResult*, 4> results;
+        for (auto* res : ctrl->Results()) {
+            auto* result = b.InstructionResult(res->Type());
+            values.Add(res, result);
+            if (auto name = ir->NameOf(res)) {
+                ir->SetName(result, name);
+            }
+            results.Push(result);
+        }
+        copy->SetResults(std::move(results));
+    }
+
+    /// Creates the parameters of a copy of a block.
+    /// @param block the block of the function being inlined
+    /// @param copy the copy of @p block
+    void CopyParams(MultiInBlock* block, MultiInBlock* copy) {
+        Vector<BlockParam*, 4> params;
+        for (auto* param : block->Params()) {
+            auto* p = b.BlockParam(param->Type());
+            values.Add(param, p);
+            if (auto name = ir->NameOf(param)) {
+                ir->SetName(p, name);
+            }
+            params.Push(p);
+        }
+        copy->SetParams(std::move(params));
+    }
+
+    /// Appends copies of the instructions of a block to another block.
+    /// @param block the block of the function being inlined
+    /// @param copy the copy of @p block
+    void CopyBlock(Block* block, Block* copy) {
+        for (auto* inst : *block) {
+            copy->Append(Copy(inst));
+        }
+    }
+
+    /// Destroys the instructions of a block, and of the blocks nested in it.
+    /// @param block the block
+    void DestroyBlock(Block* block) {
+        // Destroy the instructions in reverse order, so that the users of a result are destroyed
+        // before the instruction that produces it.
+        while (auto* inst = block->Back()) {
+            if (auto* ctrl = inst->As<ControlInstruction>()) {
+                Vector<Block*, 4> blocks;
+                ctrl->ForeachBlock([&](Block* blk) { blocks.Push(blk); });
+                blocks.Reverse();
+                for (auto* blk : blocks) {
+                    DestroyBlock(blk);
+                }
+            }
+            inst->Destroy();
+        }
+    }
+};
+
+}  // namespace
+
+Result<SuccessType, std::string> InlineFunctions(Module* ir, const InlineFunctionsConfig& config) {
+    auto result = ValidateAndDumpIfNeeded(*ir, "InlineFunctions transform");
+    if (!result) {
+        return result;
+    }
+
+    State{config, ir}.Process();
+
+    return Success;
+}
+
+}  // namespace tint::ir::transform
@@ -0,0 +1,55 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
+#define SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "src/tint/utils/result/result.h"
+
+// Forward declarations.
+namespace tint::ir {
+class Module;
+}
+
+namespace tint::ir::transform {
+
+/// The cost model used to decide which functions are inlined.
+/// The cost of a function is the number of instructions in the function, excluding lets and
+/// terminators, which do not produce any code.
+struct InlineFunctionsConfig {
+    /// Functions with a cost of at most this value are inlined into all of their callers.
+    uint32_t max_cost = 32;
+    /// Functions that are only called once are inlined if their cost is at most this value. As
+    /// the function is removed once it is inlined, this does not grow the module.
+    uint32_t max_single_call_cost = 1024;
+};
+
+/// InlineFunctions is a transform that replaces calls to user functions with the body of the
+/// function, for the functions selected by the cost model. Functions are processed from the
+/// leaves of the call graph upwards, so a function is considered with its own calls already
+/// inlined. Functions that are no longer called once they have been inlined are removed.
+/// Only functions that have a single return, at the end of the function, are inlined. Run
+/// MergeReturn before this transform to make functions with early returns inlinable.
+/// @param module the module to transform
+/// @param config the cost model configuration
+/// @returns an error string on failure
+Result<SuccessType, std::string> InlineFunctions(Module* module,
+                                                 const InlineFunctionsConfig& config);
+
+}  // namespace tint::ir::transform
+
+#endif  // SRC_TINT_LANG_CORE_IR_TRANSFORM_INLINE_FUNCTIONS_H_
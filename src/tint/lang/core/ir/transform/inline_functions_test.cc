@@ -0,0 +1,881 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/core/ir/transform/inline_functions.h"
+
+#include <utility>
+
+#include "src/tint/lang/core/ir/transform/helper_test.h"
+
+namespace tint::ir::transform {
+namespace {
+
+using namespace tint::core::fluent_types;  // NOLINT
+using namespace tint::number_suffixes;     // NOLINT
+
+class IR_InlineFunctionsTest : public TransformTest {
+  protected:
+    /// @returns a function that returns `(x + 1) * 2`, which has a cost of 2
+    Function* AddOneTimesTwo() {
+        auto* x = b.FunctionParam("x", ty.i32());
+        auto* func = b.Function("add_one_times_two", ty.i32());
+        func->SetParams({x});
+        b.Append(func->Block(), [&] {
+            auto* add = b.Add(ty.i32(), x, 1_i);
+            b.Return(func, b.Multiply(ty.i32(), add, 2_i));
+        });
+        return func;
+    }
+};
+
+TEST_F(IR_InlineFunctionsTest, NoModify_NoCalls) {
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Add(ty.i32(), 1_i, 2_i));
+    });
+
+    auto* src = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 1i, 2i
+    ret %2
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, SingleCall) {
+    auto* callee = AddOneTimesTwo();
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* call = b.Call(ty.i32(), callee, 3_i);
+        b.Return(func, b.Subtract(ty.i32(), call, 1_i));
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one_times_two, 3i
+    %7:i32 = sub %6, 1i
+    ret %7
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 3i, 1i
+    %3:i32 = mul %2, 2i
+    %4:i32 = sub %3, 1i
+    ret %4
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, MultipleCalls) {
+    auto* callee = AddOneTimesTwo();
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {
+        auto* call_a = b.Call(ty.i32(), callee, a);
+        auto* call_b = b.Call(ty.i32(), callee, call_a);
+        b.Return(func, call_b);
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%foo = func(%a:i32):i32 -> %b2 {
+  %b2 = block {
+    %7:i32 = call %add_one_times_two, %a
+    %8:i32 = call %add_one_times_two, %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %a, 1i
+    %4:i32 = mul %3, 2i
+    %5:i32 = add %4, 1i
+    %6:i32 = mul %5, 2i
+    ret %6
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_MultipleCalls_OverCost) {
+    auto* callee = AddOneTimesTwo();
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {
+        auto* call_a = b.Call(ty.i32(), callee, a);
+        auto* call_b = b.Call(ty.i32(), callee, call_a);
+        b.Return(func, call_b);
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%foo = func(%a:i32):i32 -> %b2 {
+  %b2 = block {
+    %7:i32 = call %add_one_times_two, %a
+    %8:i32 = call %add_one_times_two, %7
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineFunctionsConfig config;
+    config.max_cost = 1;
+    Run(InlineFunctions, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, SingleCall_OverCost) {
+    auto* callee = AddOneTimesTwo();
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Call(ty.i32(), callee, 3_i));
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one_times_two, 3i
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 3i, 1i
+    %3:i32 = mul %2, 2i
+    ret %3
+  }
+}
+)";
+
+    InlineFunctionsConfig config;
+    config.max_cost = 1;
+    Run(InlineFunctions, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_SingleCall_OverSingleCallCost) {
+    auto* callee = AddOneTimesTwo();
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Call(ty.i32(), callee, 3_i));
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %6:i32 = call %add_one_times_two, 3i
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    InlineFunctionsConfig config;
+    config.max_cost = 1;
+    config.max_single_call_cost = 1;
+    Run(InlineFunctions, config);
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_EarlyReturn) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* callee = b.Function("clamp_negative", ty.i32());
+    callee->SetParams({x});
+    b.Append(callee->Block(), [&] {
+        auto* ifelse = b.If(b.LessThan(ty.bool_(), x, 0_i));
+        b.Append(ifelse->True(), [&] {  //
+            b.Return(callee, 0_i);
+        });
+        b.Return(callee, x);
+    });
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Call(ty.i32(), callee, -3_i));
+    });
+
+    auto* src = R"(
+%clamp_negative = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:bool = lt %x, 0i
+    if %3 [t: %b2] {  # if_1
+      %b2 = block {  # true
+        ret 0i
+      }
+    }
+    ret %x
+  }
+}
+%foo = func():i32 -> %b3 {
+  %b3 = block {
+    %5:i32 = call %clamp_negative, -3i
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NoModify_UnusedFunction) {
+    AddOneTimesTwo();
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = src;
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, VoidFunction) {
+    auto* v = b.RootBlock()->Append(b.Var("v", ty.ptr<private_, i32>()));
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* callee = b.Function("set", ty.void_());
+    callee->SetParams({x});
+    b.Append(callee->Block(), [&] {
+        b.Store(v, x);
+        b.Return(callee);
+    });
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        b.Call(ty.void_(), callee, 1_i);
+        b.Call(ty.void_(), callee, 2_i);
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%set = func(%x:i32):void -> %b2 {
+  %b2 = block {
+    store %v, %x
+    ret
+  }
+}
+%foo = func():void -> %b3 {
+  %b3 = block {
+    %5:void = call %set, 1i
+    %6:void = call %set, 2i
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%b1 = block {  # root
+  %v:ptr<private, i32, read_write> = var
+}
+
+%foo = func():void -> %b2 {
+  %b2 = block {
+    store %v, 1i
+    store %v, 2i
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, PointerParameter) {
+    auto* p = b.FunctionParam("p", ty.ptr<function, i32>());
+    auto* callee = b.Function("increment", ty.void_());
+    callee->SetParams({p});
+    b.Append(callee->Block(), [&] {
+        b.Store(p, b.Add(ty.i32(), b.Load(p), 1_i));
+        b.Return(callee);
+    });
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, i32>());
+        b.Call(ty.void_(), callee, v);
+        b.Return(func, b.Load(v));
+    });
+
+    auto* src = R"(
+%increment = func(%p:ptr<function, i32, read_write>):void -> %b1 {
+  %b1 = block {
+    %3:i32 = load %p
+    %4:i32 = add %3, 1i
+    store %p, %4
+    ret
+  }
+}
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %v:ptr<function, i32, read_write> = var
+    %7:void = call %increment, %v
+    %8:i32 = load %v
+    ret %8
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    %4:i32 = add %3, 1i
+    store %v, %4
+    %5:i32 = load %v
+    ret %5
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, NestedCalls) {
+    auto* inner = AddOneTimesTwo();
+    auto* y = b.FunctionParam("y", ty.i32());
+    auto* outer = b.Function("outer", ty.i32());
+    outer->SetParams({y});
+    b.Append(outer->Block(), [&] {
+        auto* call = b.Call(ty.i32(), inner, y);
+        b.Return(outer, b.Call(ty.i32(), inner, call));
+    });
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Call(ty.i32(), outer, 5_i));
+    });
+
+    auto* src = R"(
+%add_one_times_two = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = add %x, 1i
+    %4:i32 = mul %3, 2i
+    ret %4
+  }
+}
+%outer = func(%y:i32):i32 -> %b2 {
+  %b2 = block {
+    %7:i32 = call %add_one_times_two, %y
+    %8:i32 = call %add_one_times_two, %7
+    ret %8
+  }
+}
+%foo = func():i32 -> %b3 {
+  %b3 = block {
+    %10:i32 = call %outer, 5i
+    ret %10
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %2:i32 = add 5i, 1i
+    %3:i32 = mul %2, 2i
+    %4:i32 = add %3, 1i
+    %5:i32 = mul %4, 2i
+    ret %5
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, ControlFlow) {
+    // Sums the integers in [0, n), skipping odd numbers.
+    auto* n = b.FunctionParam("n", ty.i32());
+    auto* callee = b.Function("sum_even", ty.i32());
+    callee->SetParams({n});
+    b.Append(callee->Block(), [&] {
+        auto* sum = b.Var("sum", ty.ptr<function, i32>());
+        sum->SetInitializer(b.Constant(0_i));
+        auto* loop = b.Loop();
+        b.Append(loop->Initializer(), [&] {  //
+            b.NextIteration(loop, 0_i);
+        });
+        auto* i = b.BlockParam("i", ty.i32());
+        loop->Body()->SetParams({i});
+        b.Append(loop->Body(), [&] {
+            auto* done = b.If(b.GreaterThanEqual(ty.bool_(), i, n));
+            b.Append(done->True(), [&] {  //
+                b.ExitLoop(loop);
+            });
+            auto* odd = b.If(b.Equal(ty.bool_(), b.Modulo(ty.i32(), i, 2_i), 1_i));
+            odd->SetResults(b.InstructionResult(ty.i32()));
+            b.Append(odd->True(), [&] {  //
+                b.ExitIf(odd, 0_i);
+            });
+            b.Append(odd->False(), [&] {  //
+                b.ExitIf(odd, i);
+            });
+            b.Store(sum, b.Add(ty.i32(), b.Load(sum), odd->Result(0)));
+            b.Continue(loop);
+        });
+        b.Append(loop->Continuing(), [&] {  //
+            b.NextIteration(loop, b.Add(ty.i32(), i, 1_i));
+        });
+        b.Return(callee, b.Load(sum));
+    });
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* call_a = b.Call(ty.i32(), callee, 4_i);
+        auto* call_b = b.Call(ty.i32(), callee, 8_i);
+        b.Return(func, b.Add(ty.i32(), call_a, call_b));
+    });
+
+    auto* src = R"(
+%sum_even = func(%n:i32):i32 -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var, 0i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        next_iteration %b3 0i
+      }
+      %b3 = block (%i:i32) {  # body
+        %5:bool = gte %i:i32, %n
+        if %5 [t: %b5] {  # if_1
+          %b5 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %6:i32 = mod %i:i32, 2i
+        %7:bool = eq %6, 1i
+        %8:i32 = if %7 [t: %b6, f: %b7] {  # if_2
+          %b6 = block {  # true
+            exit_if 0i  # if_2
+          }
+          %b7 = block {  # false
+            exit_if %i:i32  # if_2
+          }
+        }
+        %9:i32 = load %sum
+        %10:i32 = add %9, %8
+        store %sum, %10
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %11:i32 = add %i:i32, 1i
+        next_iteration %b3 %11
+      }
+    }
+    %12:i32 = load %sum
+    ret %12
+  }
+}
+%foo = func():i32 -> %b8 {
+  %b8 = block {
+    %14:i32 = call %sum_even, 4i
+    %15:i32 = call %sum_even, 8i
+    %16:i32 = add %14, %15
+    ret %16
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %sum:ptr<function, i32, read_write> = var, 0i
+    loop [i: %b2, b: %b3, c: %b4] {  # loop_1
+      %b2 = block {  # initializer
+        next_iteration %b3 0i
+      }
+      %b3 = block (%i:i32) {  # body
+        %4:bool = gte %i:i32, 4i
+        if %4 [t: %b5] {  # if_1
+          %b5 = block {  # true
+            exit_loop  # loop_1
+          }
+        }
+        %5:i32 = mod %i:i32, 2i
+        %6:bool = eq %5, 1i
+        %7:i32 = if %6 [t: %b6, f: %b7] {  # if_2
+          %b6 = block {  # true
+            exit_if 0i  # if_2
+          }
+          %b7 = block {  # false
+            exit_if %i:i32  # if_2
+          }
+        }
+        %8:i32 = load %sum
+        %9:i32 = add %8, %7
+        store %sum, %9
+        continue %b4
+      }
+      %b4 = block {  # continuing
+        %10:i32 = add %i:i32, 1i
+        next_iteration %b3 %10
+      }
+    }
+    %11:i32 = load %sum
+    %sum_1:ptr<function, i32, read_write> = var, 0i  # %sum_1: 'sum'
+    loop [i: %b8, b: %b9, c: %b10] {  # loop_2
+      %b8 = block {  # initializer
+        next_iteration %b9 0i
+      }
+      %b9 = block (%i_1:i32) {  # body
+        %14:bool = gte %i_1:i32, 8i
+        if %14 [t: %b11] {  # if_3
+          %b11 = block {  # true
+            exit_loop  # loop_2
+          }
+        }
+        %15:i32 = mod %i_1:i32, 2i
+        %16:bool = eq %15, 1i
+        %17:i32 = if %16 [t: %b12, f: %b13] {  # if_4
+          %b12 = block {  # true
+            exit_if 0i  # if_4
+          }
+          %b13 = block {  # false
+            exit_if %i_1:i32  # if_4
+          }
+        }
+        %18:i32 = load %sum_1
+        %19:i32 = add %18, %17
+        store %sum_1, %19
+        continue %b10
+      }
+      %b10 = block {  # continuing
+        %20:i32 = add %i_1:i32, 1i
+        next_iteration %b9 %20
+      }
+    }
+    %21:i32 = load %sum_1
+    %22:i32 = add %11, %21
+    ret %22
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, Switch) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* callee = b.Function("select", ty.i32());
+    callee->SetParams({x});
+    b.Append(callee->Block(), [&] {
+        auto* swtch = b.Switch(x);
+        swtch->SetResults(b.InstructionResult(ty.i32()));
+        b.Append(b.Case(swtch, {Switch::CaseSelector{b.Constant(1_i)}}), [&] {  //
+            b.ExitSwitch(swtch, 10_i);
+        });
+        b.Append(b.Case(swtch, {Switch::CaseSelector{}}), [&] {  //
+            b.ExitSwitch(swtch, 20_i);
+        });
+        b.Return(callee, swtch->Result(0));
+    });
+    auto* a = b.FunctionParam("a", ty.i32());
+    auto* func = b.Function("foo", ty.i32());
+    func->SetParams({a});
+    b.Append(func->Block(), [&] {  //
+        b.Return(func, b.Call(ty.i32(), callee, a));
+    });
+
+    auto* src = R"(
+%select = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = switch %x [c: (1i, %b2), c: (default, %b3)] {  # switch_1
+      %b2 = block {  # case
+        exit_switch 10i  # switch_1
+      }
+      %b3 = block {  # case
+        exit_switch 20i  # switch_1
+      }
+    }
+    ret %3
+  }
+}
+%foo = func(%a:i32):i32 -> %b4 {
+  %b4 = block {
+    %6:i32 = call %select, %a
+    ret %6
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func(%a:i32):i32 -> %b1 {
+  %b1 = block {
+    %3:i32 = switch %a [c: (1i, %b2), c: (default, %b3)] {  # switch_1
+      %b2 = block {  # case
+        exit_switch 10i  # switch_1
+      }
+      %b3 = block {  # case
+        exit_switch 20i  # switch_1
+      }
+    }
+    ret %3
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, UninitializedVar_InLoop) {
+    auto* callee = b.Function("zero", ty.i32());
+    b.Append(callee->Block(), [&] {
+        auto* v = b.Var("v", ty.ptr<function, i32>());
+        b.Return(callee, b.Load(v));
+    });
+    auto* func = b.Function("foo", ty.i32());
+    b.Append(func->Block(), [&] {
+        auto* outside = b.Call(ty.i32(), callee);
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            b.Call(ty.i32(), callee);
+            b.ExitLoop(loop);
+        });
+        b.Return(func, outside);
+    });
+
+    auto* src = R"(
+%zero = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    ret %3
+  }
+}
+%foo = func():i32 -> %b2 {
+  %b2 = block {
+    %5:i32 = call %zero
+    loop [b: %b3] {  # loop_1
+      %b3 = block {  # body
+        %6:i32 = call %zero
+        exit_loop  # loop_1
+      }
+    }
+    ret %5
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():i32 -> %b1 {
+  %b1 = block {
+    %v:ptr<function, i32, read_write> = var
+    %3:i32 = load %v
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %v_1:ptr<function, i32, read_write> = var, 0i  # %v_1: 'v'
+        %5:i32 = load %v_1
+        exit_loop  # loop_1
+      }
+    }
+    ret %3
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+TEST_F(IR_InlineFunctionsTest, UninitializedVar_InIf_InLoop) {
+    auto* x = b.FunctionParam("x", ty.i32());
+    auto* callee = b.Function("f", ty.i32());
+    callee->SetParams({x});
+    b.Append(callee->Block(), [&] {
+        auto* r = b.Var("r", ty.ptr<function, i32>());
+        r->SetInitializer(x);
+        auto* ifelse = b.If(b.LessThan(ty.bool_(), x, 0_i));
+        b.Append(ifelse->True(), [&] {
+            auto* v = b.Var("v", ty.ptr<function, i32>());
+            b.Store(r, b.Load(v));
+            b.ExitIf(ifelse);
+        });
+        b.Return(callee, b.Load(r));
+    });
+    auto* func = b.Function("foo", ty.void_());
+    b.Append(func->Block(), [&] {
+        auto* loop = b.Loop();
+        b.Append(loop->Body(), [&] {
+            b.Call(ty.i32(), callee, -1_i);
+            b.ExitLoop(loop);
+        });
+        b.Return(func);
+    });
+
+    auto* src = R"(
+%f = func(%x:i32):i32 -> %b1 {
+  %b1 = block {
+    %r:ptr<function, i32, read_write> = var, %x
+    %4:bool = lt %x, 0i
+    if %4 [t: %b2] {  # if_1
+      %b2 = block {  # true
+        %v:ptr<function, i32, read_write> = var
+        %6:i32 = load %v
+        store %r, %6
+        exit_if  # if_1
+      }
+    }
+    %7:i32 = load %r
+    ret %7
+  }
+}
+%foo = func():void -> %b3 {
+  %b3 = block {
+    loop [b: %b4] {  # loop_1
+      %b4 = block {  # body
+        %9:i32 = call %f, -1i
+        exit_loop  # loop_1
+      }
+    }
+    ret
+  }
+}
+)";
+    EXPECT_EQ(src, str());
+
+    auto* expect = R"(
+%foo = func():void -> %b1 {
+  %b1 = block {
+    loop [b: %b2] {  # loop_1
+      %b2 = block {  # body
+        %r:ptr<function, i32, read_write> = var, -1i
+        %3:bool = lt -1i, 0i
+        if %3 [t: %b3] {  # if_1
+          %b3 = block {  # true
+            %v:ptr<function, i32, read_write> = var, 0i
+            %5:i32 = load %v
+            store %r, %5
+            exit_if  # if_1
+          }
+        }
+        %6:i32 = load %r
+        exit_loop  # loop_1
+      }
+    }
+    ret
+  }
+}
+)";
+
+    Run(InlineFunctions, InlineFunctionsConfig{});
+
+    EXPECT_EQ(expect, str());
+}
+
+}  // namespace
+}  // namespace tint::ir::transform
@@ -33,6 +33,11 @@ void BinaryWriter::WriteModule(const Module* module) {
     module->Iterate([this](const Instruction& inst) { this->process_instruction(inst); });
 }
 
+void BinaryWriter::WriteModule(const WordModule* module) {
+    out_.reserve(module->TotalSize());
+    module->Encode(out_);
+}
+
 void BinaryWriter::WriteInstruction(const Instruction& inst) {
     process_instruction(inst);
 }
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "src/tint/lang/spirv/writer/common/module.h"
+#include "src/tint/lang/spirv/writer/common/word_module.h"
 
 namespace tint::spirv::writer {
 
@@ -38,6 +39,11 @@ class BinaryWriter {
     /// @param module the module to assemble from
     void WriteModule(const Module* module);
 
+    /// Writes the given module data into a binary. Note, this does not emit the SPIR-V header. You
+    /// **must** call WriteHeader() before WriteModule() if you want the SPIR-V to be emitted.
+    /// @param module the module to assemble from
+    void WriteModule(const WordModule* module);
+
     /// Writes the given instruction into the binary.
     /// @param inst the instruction to assemble
     void WriteInstruction(const Instruction& inst);
@@ -55,6 +55,15 @@ struct Options {
 #if TINT_BUILD_IR
     /// Set to `true` to generate SPIR-V via the Tint IR instead of from the AST.
     bool use_tint_ir = false;
+
+    /// Set to `true` to run the IR optimization passes before generating SPIR-V via the Tint IR.
+    /// These fold constants, remove trivial control flow, and eliminate redundant and dead
+    /// instructions.
+    bool optimize_ir = false;
+
+    /// Set to `true` to inline calls to small user functions when generating SPIR-V via the Tint
+    /// IR, for drivers that handle function calls poorly.
+    bool inline_functions = false;
 #endif
 
     /// Reflect the fields of this class so that it can be used by tint::ForeachField()
@@ -78,4 +78,12 @@ std::string DumpInstructions(const InstructionList& insts) {
     return Disassemble(writer.Result());
 }
 
+std::string DumpInstructions(const WordStream& words) {
+    BinaryWriter writer;
+    writer.WriteHeader(kDefaultMaxIdBound);
+    auto& result = writer.Result();
+    result.insert(result.end(), words.Words().begin(), words.Words().end());
+    return Disassemble(result);
+}
+
 }  // namespace tint::spirv::writer
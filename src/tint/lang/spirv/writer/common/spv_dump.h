@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "src/tint/lang/spirv/writer/common/module.h"
+#include "src/tint/lang/spirv/writer/common/word_stream.h"
 
 namespace tint::spirv::writer {
 
@@ -43,6 +44,11 @@ std::string DumpInstruction(const Instruction& inst);
 /// @returns the instruction as a SPIR-V disassembly string
 std::string DumpInstructions(const InstructionList& insts);
 
+/// Dumps the given encoded instructions to a SPIR-V disassembly string
+/// @param words the instructions to dump
+/// @returns the instructions as a SPIR-V disassembly string
+std::string DumpInstructions(const WordStream& words);
+
 }  // namespace tint::spirv::writer
 
 #endif  // SRC_TINT_LANG_SPIRV_WRITER_COMMON_SPV_DUMP_H_
@@ -0,0 +1,49 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/spirv/writer/common/word_function.h"
+
+#include <utility>
+
+namespace tint::spirv::writer {
+
+WordFunction::WordFunction() = default;
+
+WordFunction::WordFunction(WordStream declaration, uint32_t label_id)
+    : declaration_(std::move(declaration)), label_id_(label_id) {}
+
+WordFunction::WordFunction(const WordFunction&) = default;
+
+WordFunction::WordFunction(WordFunction&&) = default;
+
+WordFunction::~WordFunction() = default;
+
+WordFunction& WordFunction::operator=(const WordFunction&) = default;
+
+WordFunction& WordFunction::operator=(WordFunction&&) = default;
+
+uint32_t WordFunction::WordCount() const {
+    // 2 for the Label and 1 for the FunctionEnd
+    return declaration_.WordCount() + 2 + vars_.WordCount() + instructions_.WordCount() + 1;
+}
+
+void WordFunction::Encode(WordStream& out) const {
+    out.Append(declaration_);
+    out.Push(spv::Op::OpLabel, {label_id_});
+    out.Append(vars_);
+    out.Append(instructions_);
+    out.Push(spv::Op::OpFunctionEnd, {});
+}
+
+}  // namespace tint::spirv::writer
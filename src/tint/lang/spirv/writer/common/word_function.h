@@ -0,0 +1,100 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_FUNCTION_H_
+#define SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_FUNCTION_H_
+
+#include <initializer_list>
+
+#include "src/tint/lang/spirv/writer/common/word_stream.h"
+
+namespace tint::spirv::writer {
+
+/// A SPIR-V function whose instructions are encoded into words as they are added.
+/// This is the counterpart of Function for a WordModule.
+class WordFunction {
+  public:
+    /// Constructor for an empty function, which won't generate correct SPIR-V.
+    WordFunction();
+
+    /// Constructor
+    /// @param declaration the OpFunction instruction, followed by the OpFunctionParameter
+    ///                    instructions of the function parameters
+    /// @param label_id the ID for function's entry block label
+    WordFunction(WordStream declaration, uint32_t label_id);
+
+    /// Copy constructor
+    WordFunction(const WordFunction&);
+    /// Move constructor
+    WordFunction(WordFunction&&);
+    /// Destructor
+    ~WordFunction();
+
+    /// Copy assignment operator
+    /// @returns this WordFunction
+    WordFunction& operator=(const WordFunction&);
+    /// Move assignment operator
+    /// @returns this WordFunction
+    WordFunction& operator=(WordFunction&&);
+
+    /// Adds an instruction to the body of the function.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushInst(spv::Op op, std::initializer_list<WordOperand> operands) {
+        instructions_.Push(op, operands);
+    }
+
+    /// Adds an instruction to the body of the function.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushInst(spv::Op op, VectorRef<WordOperand> operands) {
+        instructions_.Push(op, operands);
+    }
+
+    /// Adds a variable to the function variables, which are declared at the start of the entry
+    /// block.
+    /// @param operands the operands for the OpVariable instruction
+    void PushVar(std::initializer_list<WordOperand> operands) {
+        vars_.Push(spv::Op::OpVariable, operands);
+    }
+
+    /// @returns the instructions of the function body
+    const WordStream& Instructions() const { return instructions_; }
+
+    /// @returns the variables of the function
+    const WordStream& Variables() const { return vars_; }
+
+    /// @returns the label ID for the function entry block
+    uint32_t LabelId() const { return label_id_; }
+
+    /// @returns the word length of the function
+    uint32_t WordCount() const;
+
+    /// @returns true if the function has a declaration
+    explicit operator bool() const { return !declaration_.IsEmpty(); }
+
+    /// Appends the words of the whole function, from its declaration to its OpFunctionEnd.
+    /// @param out the stream to append the function to
+    void Encode(WordStream& out) const;
+
+  private:
+    WordStream declaration_;
+    uint32_t label_id_ = 0;
+    WordStream vars_;
+    WordStream instructions_;
+};
+
+}  // namespace tint::spirv::writer
+
+#endif  // SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_FUNCTION_H_
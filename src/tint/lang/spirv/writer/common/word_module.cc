@@ -0,0 +1,59 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/spirv/writer/common/word_module.h"
+
+namespace tint::spirv::writer {
+
+WordModule::WordModule() = default;
+
+WordModule::~WordModule() = default;
+
+uint32_t WordModule::TotalSize() const {
+    // The 5 covers the magic, version, generator, id bound and reserved.
+    uint32_t size = 5;
+
+    size += capabilities_.WordCount();
+    size += extensions_.WordCount();
+    size += ext_imports_.WordCount();
+    size += memory_model_.WordCount();
+    size += entry_points_.WordCount();
+    size += execution_modes_.WordCount();
+    size += debug_.WordCount();
+    size += annotations_.WordCount();
+    size += types_.WordCount();
+    size += functions_.WordCount();
+
+    return size;
+}
+
+void WordModule::Encode(std::vector<uint32_t>& out) const {
+    for (auto* section : {&capabilities_, &extensions_, &ext_imports_, &memory_model_,
+                          &entry_points_, &execution_modes_, &debug_, &annotations_, &types_,
+                          &functions_}) {
+        out.insert(out.end(), section->Words().begin(), section->Words().end());
+    }
+}
+
+void WordModule::PushCapability(uint32_t cap) {
+    if (capability_set_.Add(cap)) {
+        capabilities_.Push(spv::Op::OpCapability, {cap});
+    }
+}
+
+void WordModule::PushExtension(const char* extension) {
+    extensions_.Push(spv::Op::OpExtension, {extension});
+}
+
+}  // namespace tint::spirv::writer
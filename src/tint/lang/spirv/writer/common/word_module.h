@@ -0,0 +1,170 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_MODULE_H_
+#define SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_MODULE_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "src/tint/lang/spirv/writer/common/word_function.h"
+#include "src/tint/lang/spirv/writer/common/word_stream.h"
+#include "src/tint/utils/containers/hashset.h"
+
+namespace tint::spirv::writer {
+
+/// A SPIR-V module whose sections are encoded into contiguous words as instructions are added.
+/// It has the same sections as Module, but doesn't allocate memory for each instruction and its
+/// operands, which is used by the IR printer to generate large shaders. Module is still used by
+/// the AST printer and its tests, which inspect the instructions of each section.
+class WordModule {
+  public:
+    /// Constructor
+    WordModule();
+
+    /// Destructor
+    ~WordModule();
+
+    /// @returns the number of uint32_t's needed to make up the results
+    uint32_t TotalSize() const;
+
+    /// @returns the id bound for this program
+    uint32_t IdBound() const { return next_id_; }
+
+    /// @returns the next id to be used
+    uint32_t NextId() {
+        auto id = next_id_;
+        next_id_ += 1;
+        return id;
+    }
+
+    /// Appends the words of all the sections in the correct order, without the SPIR-V header.
+    /// @param out the words to append to
+    void Encode(std::vector<uint32_t>& out) const;
+
+    /// Add an instruction to the list of capabilities, if the capability hasn't already been added.
+    /// @param cap the capability to set
+    void PushCapability(uint32_t cap);
+
+    /// @returns the capabilities
+    const WordStream& Capabilities() const { return capabilities_; }
+
+    /// Add an instruction to the list of extensions.
+    /// @param extension the name of the extension
+    void PushExtension(const char* extension);
+
+    /// @returns the extensions
+    const WordStream& Extensions() const { return extensions_; }
+
+    /// Add an instruction to the list of imported extension instructions.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushExtImport(spv::Op op, std::initializer_list<WordOperand> operands) {
+        ext_imports_.Push(op, operands);
+    }
+
+    /// @returns the ext imports
+    const WordStream& ExtImports() const { return ext_imports_; }
+
+    /// Add an instruction to the memory model.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushMemoryModel(spv::Op op, std::initializer_list<WordOperand> operands) {
+        memory_model_.Push(op, operands);
+    }
+
+    /// @returns the memory model
+    const WordStream& MemoryModel() const { return memory_model_; }
+
+    /// Add an instruction to the list of entry points.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushEntryPoint(spv::Op op, VectorRef<WordOperand> operands) {
+        entry_points_.Push(op, operands);
+    }
+
+    /// @returns the entry points
+    const WordStream& EntryPoints() const { return entry_points_; }
+
+    /// Add an instruction to the execution mode declarations.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushExecutionMode(spv::Op op, std::initializer_list<WordOperand> operands) {
+        execution_modes_.Push(op, operands);
+    }
+
+    /// @returns the execution modes
+    const WordStream& ExecutionModes() const { return execution_modes_; }
+
+    /// Add an instruction to the debug declarations.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushDebug(spv::Op op, std::initializer_list<WordOperand> operands) {
+        debug_.Push(op, operands);
+    }
+
+    /// @returns the debug instructions
+    const WordStream& Debug() const { return debug_; }
+
+    /// Add an instruction to the type declarations.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushType(spv::Op op, std::initializer_list<WordOperand> operands) {
+        types_.Push(op, operands);
+    }
+
+    /// Add an instruction to the type declarations.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushType(spv::Op op, VectorRef<WordOperand> operands) { types_.Push(op, operands); }
+
+    /// @returns the type instructions
+    const WordStream& Types() const { return types_; }
+
+    /// Add an instruction to the annotations.
+    /// @param op the op to set
+    /// @param operands the operands for the instruction
+    void PushAnnot(spv::Op op, std::initializer_list<WordOperand> operands) {
+        annotations_.Push(op, operands);
+    }
+
+    /// @returns the annotations
+    const WordStream& Annots() const { return annotations_; }
+
+    /// Add a function to the module.
+    /// @param func the function to add
+    void PushFunction(const WordFunction& func) { func.Encode(functions_); }
+
+    /// @returns the functions
+    const WordStream& Functions() const { return functions_; }
+
+  private:
+    uint32_t next_id_ = 1;
+    WordStream capabilities_;
+    WordStream extensions_;
+    WordStream ext_imports_;
+    WordStream memory_model_;
+    WordStream entry_points_;
+    WordStream execution_modes_;
+    WordStream debug_;
+    WordStream types_;
+    WordStream annotations_;
+    WordStream functions_;
+    Hashset<uint32_t, 8> capability_set_;
+};
+
+}  // namespace tint::spirv::writer
+
+#endif  // SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_MODULE_H_
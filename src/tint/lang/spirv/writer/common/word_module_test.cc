@@ -0,0 +1,93 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/spirv/writer/common/word_module.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "spirv/unified1/spirv.h"
+#include "src/tint/lang/spirv/writer/common/binary_writer.h"
+
+namespace tint::spirv::writer {
+namespace {
+
+using SpirvWriterWordModuleTest = testing::Test;
+
+TEST_F(SpirvWriterWordModuleTest, TracksIdBounds) {
+    WordModule m;
+
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(m.NextId(), i + 1);
+    }
+
+    EXPECT_EQ(6u, m.IdBound());
+}
+
+TEST_F(SpirvWriterWordModuleTest, Capabilities_Dedup) {
+    WordModule m;
+
+    m.PushCapability(SpvCapabilityShader);
+    m.PushCapability(SpvCapabilityShader);
+    m.PushCapability(SpvCapabilityShader);
+
+    WordStream expected;
+    expected.Push(spv::Op::OpCapability, {SpvCapabilityShader});
+    EXPECT_EQ(m.Capabilities().Words(), expected.Words());
+}
+
+TEST_F(SpirvWriterWordModuleTest, MatchesModule) {
+    Module m;
+    WordModule wm;
+
+    m.PushCapability(SpvCapabilityShader);
+    wm.PushCapability(SpvCapabilityShader);
+    m.PushExtension("SPV_KHR_integer_dot_product");
+    wm.PushExtension("SPV_KHR_integer_dot_product");
+    m.PushMemoryModel(spv::Op::OpMemoryModel,
+                      {U32Operand(SpvAddressingModelLogical), U32Operand(SpvMemoryModelGLSL450)});
+    wm.PushMemoryModel(spv::Op::OpMemoryModel, {SpvAddressingModelLogical, SpvMemoryModelGLSL450});
+    m.PushDebug(spv::Op::OpName, {2u, Operand("main")});
+    wm.PushDebug(spv::Op::OpName, {2u, "main"});
+    m.PushType(spv::Op::OpTypeVoid, {1u});
+    wm.PushType(spv::Op::OpTypeVoid, {1u});
+    m.PushType(spv::Op::OpTypeFunction, {3u, 1u});
+    wm.PushType(spv::Op::OpTypeFunction, {3u, 1u});
+
+    Function func(Instruction(spv::Op::OpFunction,
+                              {1u, 2u, U32Operand(SpvFunctionControlMaskNone), 3u}),
+                  4u, {});
+    func.push_inst(spv::Op::OpReturn, {});
+    m.PushFunction(func);
+
+    WordStream decl;
+    decl.Push(spv::Op::OpFunction, {1u, 2u, SpvFunctionControlMaskNone, 3u});
+    WordFunction word_func(std::move(decl), 4u);
+    word_func.PushInst(spv::Op::OpReturn, {});
+    wm.PushFunction(word_func);
+
+    BinaryWriter expected;
+    expected.WriteHeader(m.IdBound());
+    expected.WriteModule(&m);
+
+    BinaryWriter result;
+    result.WriteHeader(wm.IdBound());
+    result.WriteModule(&wm);
+
+    EXPECT_EQ(wm.TotalSize(), result.Result().size());
+    EXPECT_EQ(result.Result(), expected.Result());
+}
+
+}  // namespace
+}  // namespace tint::spirv::writer
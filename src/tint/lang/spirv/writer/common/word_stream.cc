@@ -0,0 +1,43 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/spirv/writer/common/word_stream.h"
+
+namespace tint::spirv::writer {
+
+WordStream::WordStream() = default;
+
+WordStream::WordStream(const WordStream&) = default;
+
+WordStream::WordStream(WordStream&&) = default;
+
+WordStream::~WordStream() = default;
+
+WordStream& WordStream::operator=(const WordStream&) = default;
+
+WordStream& WordStream::operator=(WordStream&&) = default;
+
+void WordStream::Push(spv::Op op, const WordOperand* operands, size_t count) {
+    uint32_t word_count = 1;  // Initial 1 for the op and size
+    for (size_t i = 0; i < count; i++) {
+        word_count += operands[i].WordCount();
+    }
+
+    words_.push_back(word_count << 16 | static_cast<uint32_t>(op));
+    for (size_t i = 0; i < count; i++) {
+        operands[i].Encode(words_);
+    }
+}
+
+}  // namespace tint::spirv::writer
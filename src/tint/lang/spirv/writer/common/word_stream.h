@@ -0,0 +1,162 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_STREAM_H_
+#define SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_STREAM_H_
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "spirv/unified1/spirv.hpp11"
+#include "src/tint/utils/containers/vector.h"
+
+namespace tint::spirv::writer {
+
+/// A single SPIR-V instruction operand that is encoded directly into a WordStream.
+/// Unlike Operand, a WordOperand does not own the string it refers to, so it must only be used to
+/// push an instruction while the string is alive.
+class WordOperand {
+    template <typename T>
+    static constexpr bool IsOtherIntegerOrEnum =
+        (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, uint32_t>;
+
+  public:
+    /// Constructor
+    /// @param value the 32-bit value of the operand
+    WordOperand(uint32_t value) : word_(value) {}  // NOLINT(runtime/explicit)
+
+    /// Constructor
+    /// @param value the integer or enum value of the operand, truncated to 32 bits
+    template <typename T, typename = std::enable_if_t<IsOtherIntegerOrEnum<T>>>
+    WordOperand(T value)  // NOLINT(runtime/explicit)
+        : word_(static_cast<uint32_t>(value)) {}
+
+    /// Constructor
+    /// @param value the float value of the operand
+    WordOperand(float value) {  // NOLINT(runtime/explicit)
+        memcpy(&word_, &value, sizeof(word_));
+    }
+
+    /// Constructor
+    /// @param str the string operand, which must outlive the operand
+    WordOperand(std::string_view str)  // NOLINT(runtime/explicit)
+        : is_string_(true), str_(str) {}
+
+    /// Constructor
+    /// @param str the string operand, which must outlive the operand
+    WordOperand(const std::string& str)  // NOLINT(runtime/explicit)
+        : WordOperand(std::string_view(str)) {}
+
+    /// Constructor
+    /// @param str the string operand, which must outlive the operand
+    WordOperand(const char* str)  // NOLINT(runtime/explicit)
+        : WordOperand(std::string_view(str)) {}
+
+    /// @returns the number of uint32_t's needed for this operand
+    uint32_t WordCount() const {
+        // SPIR-V always nul-terminates strings. The length is rounded up to a multiple of 4 bytes
+        // with 0 bytes padding the end. Accounting for the nul terminator is why '+ 4u' is used
+        // here instead of '+ 3u'.
+        return is_string_ ? static_cast<uint32_t>((str_.length() + 4u) >> 2) : 1u;
+    }
+
+    /// Appends the words of the operand to `out`.
+    /// @param out the words to append to
+    void Encode(std::vector<uint32_t>& out) const {
+        if (!is_string_) {
+            out.push_back(word_);
+            return;
+        }
+        size_t offset = out.size();
+        out.resize(offset + WordCount(), 0u);
+        if (!str_.empty()) {
+            memcpy(out.data() + offset, str_.data(), str_.length());
+        }
+    }
+
+  private:
+    uint32_t word_ = 0;
+    bool is_string_ = false;
+    std::string_view str_;
+};
+
+/// A list of operands, for instructions with a number of operands only known at runtime.
+using WordOperandList = Vector<WordOperand, 8>;
+
+/// A sequence of SPIR-V instructions that are encoded into words as they are pushed, so that they
+/// are stored contiguously instead of as separately allocated instructions and operands.
+class WordStream {
+  public:
+    /// Constructor
+    WordStream();
+    /// Copy constructor
+    WordStream(const WordStream&);
+    /// Move constructor
+    WordStream(WordStream&&);
+    /// Destructor
+    ~WordStream();
+
+    /// Copy assignment operator
+    /// @returns this WordStream
+    WordStream& operator=(const WordStream&);
+    /// Move assignment operator
+    /// @returns this WordStream
+    WordStream& operator=(WordStream&&);
+
+    /// Encodes an instruction at the end of the stream.
+    /// @param op the op of the instruction
+    /// @param operands the operands of the instruction
+    void Push(spv::Op op, std::initializer_list<WordOperand> operands) {
+        Push(op, operands.begin(), operands.size());
+    }
+
+    /// Encodes an instruction at the end of the stream.
+    /// @param op the op of the instruction
+    /// @param operands the operands of the instruction
+    void Push(spv::Op op, VectorRef<WordOperand> operands) {
+        Push(op, operands.begin(), operands.Length());
+    }
+
+    /// Appends the instructions of another stream to the end of this stream.
+    /// @param other the stream to append
+    void Append(const WordStream& other) {
+        words_.insert(words_.end(), other.words_.begin(), other.words_.end());
+    }
+
+    /// Removes all the instructions, keeping the allocated memory.
+    void Clear() { words_.clear(); }
+
+    /// @returns true if the stream has no instructions
+    bool IsEmpty() const { return words_.empty(); }
+
+    /// @returns the number of words of the instructions in the stream
+    uint32_t WordCount() const { return static_cast<uint32_t>(words_.size()); }
+
+    /// @returns the encoded instructions
+    const std::vector<uint32_t>& Words() const { return words_; }
+
+  private:
+    void Push(spv::Op op, const WordOperand* operands, size_t count);
+
+    std::vector<uint32_t> words_;
+};
+
+}  // namespace tint::spirv::writer
+
+#endif  // SRC_TINT_LANG_SPIRV_WRITER_COMMON_WORD_STREAM_H_
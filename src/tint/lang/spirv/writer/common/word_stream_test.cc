@@ -0,0 +1,132 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/spirv/writer/common/word_stream.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "spirv/unified1/spirv.h"
+#include "src/tint/lang/spirv/writer/common/binary_writer.h"
+
+namespace tint::spirv::writer {
+namespace {
+
+using SpirvWriterWordStreamTest = testing::Test;
+
+/// @returns the words that BinaryWriter generates for the instruction @p inst
+std::vector<uint32_t> Expected(const Instruction& inst) {
+    BinaryWriter bw;
+    bw.WriteInstruction(inst);
+    return bw.Result();
+}
+
+TEST_F(SpirvWriterWordStreamTest, Empty) {
+    WordStream s;
+    EXPECT_TRUE(s.IsEmpty());
+    EXPECT_EQ(s.WordCount(), 0u);
+}
+
+TEST_F(SpirvWriterWordStreamTest, Int) {
+    WordStream s;
+    s.Push(spv::Op::OpKill, {2u});
+
+    EXPECT_FALSE(s.IsEmpty());
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpKill, {Operand(2u)})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, Enum) {
+    WordStream s;
+    s.Push(spv::Op::OpCapability, {SpvCapabilityShader});
+
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpCapability,
+                                              {U32Operand(SpvCapabilityShader)})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, Float) {
+    WordStream s;
+    s.Push(spv::Op::OpKill, {2.4f});
+
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpKill, {Operand(2.4f)})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, String) {
+    WordStream s;
+    s.Push(spv::Op::OpKill, {"my_string"});
+
+    EXPECT_EQ(s.WordCount(), 4u);
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpKill, {Operand("my_string")})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, String_Multiple4Length) {
+    std::string str = "mystring";
+    WordStream s;
+    s.Push(spv::Op::OpKill, {str});
+
+    EXPECT_EQ(s.WordCount(), 4u);
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpKill, {Operand(str)})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, String_Empty) {
+    WordStream s;
+    s.Push(spv::Op::OpKill, {""});
+
+    EXPECT_EQ(s.WordCount(), 2u);
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpKill, {Operand("")})));
+}
+
+TEST_F(SpirvWriterWordStreamTest, MixedOperands) {
+    WordStream s;
+    s.Push(spv::Op::OpMemberName, {1u, 2u, "member"});
+    s.Push(spv::Op::OpConstant, {3u, 4u, 1.5f});
+
+    BinaryWriter bw;
+    bw.WriteInstruction(Instruction(spv::Op::OpMemberName, {1u, 2u, Operand("member")}));
+    bw.WriteInstruction(Instruction(spv::Op::OpConstant, {3u, 4u, Operand(1.5f)}));
+    EXPECT_EQ(s.Words(), bw.Result());
+}
+
+TEST_F(SpirvWriterWordStreamTest, OperandList) {
+    WordOperandList operands = {1u, 2u};
+    for (uint32_t i = 3; i < 20; i++) {
+        operands.Push(i);
+    }
+    WordStream s;
+    s.Push(spv::Op::OpTypeStruct, operands);
+
+    OperandList expected_operands;
+    for (uint32_t i = 1; i < 20; i++) {
+        expected_operands.push_back(i);
+    }
+    EXPECT_EQ(s.Words(), Expected(Instruction(spv::Op::OpTypeStruct, expected_operands)));
+}
+
+TEST_F(SpirvWriterWordStreamTest, AppendAndClear) {
+    WordStream a;
+    a.Push(spv::Op::OpKill, {1u});
+    WordStream b;
+    b.Push(spv::Op::OpKill, {2u});
+    a.Append(b);
+
+    BinaryWriter bw;
+    bw.WriteInstruction(Instruction(spv::Op::OpKill, {1u}));
+    bw.WriteInstruction(Instruction(spv::Op::OpKill, {2u}));
+    EXPECT_EQ(a.Words(), bw.Result());
+
+    a.Clear();
+    EXPECT_TRUE(a.IsEmpty());
+}
+
+}  // namespace
+}  // namespace tint::spirv::writer
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <utility>
+
 #include "src/tint/lang/spirv/writer/common/helper_test.h"
 
 namespace tint::spirv::writer {
@@ -166,5 +168,20 @@ TEST_F(SpirvWriterTest, Constant_Deduplicate) {
     EXPECT_INST("%int_42 = OpConstant %int 42");
 }
 
+// Test that the elements of a dense array constant are deduplicated with other scalar constants.
+TEST_F(SpirvWriterTest, Constant_Deduplicate_DenseArray) {
+    Vector<i32, 0> values;
+    for (int32_t i = 1; i <= 16; i++) {
+        values.Push(i32(i));
+    }
+    writer_.Constant(b.Constant(1_i));
+    writer_.Constant(b.Constant(mod.constant_values.DenseComposite(ty.array<i32, 16>(), ty.i32(),
+                                                                   std::move(values))));
+    ASSERT_TRUE(Generate()) << Error() << output_;
+    EXPECT_INST(
+        "OpConstantComposite %_arr_int_uint_16 %int_1 %int_2 %int_3 %int_4 %int_5 %int_6 %int_7 "
+        "%int_8 %int_9 %int_10 %int_11 %int_12 %int_13 %int_14 %int_15 %int_16");
+}
+
 }  // namespace
 }  // namespace tint::spirv::writer
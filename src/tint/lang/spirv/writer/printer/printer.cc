@@ -161,8 +161,8 @@ Result<std::vector<uint32_t>, std::string> Printer::Generate() {
     // TODO(crbug.com/tint/1906): Check supported extensions.
 
     module_.PushCapability(SpvCapabilityShader);
-    module_.PushMemoryModel(spv::Op::OpMemoryModel, {U32Operand(SpvAddressingModelLogical),
-                                                     U32Operand(SpvMemoryModelGLSL450)});
+    module_.PushMemoryModel(spv::Op::OpMemoryModel, {SpvAddressingModelLogical,
+                                                     SpvMemoryModelGLSL450});
 
     // TODO(crbug.com/tint/1906): Emit extensions.
 
@@ -240,7 +240,7 @@ uint32_t Printer::Constant(ir::Constant* constant) {
 
     // Set the name for the SPIR-V result ID if provided in the module.
     if (auto name = ir_->NameOf(constant)) {
-        module_.PushDebug(spv::Op::OpName, {id, Operand(name.Name())});
+        module_.PushDebug(spv::Op::OpName, {id, name.Name()});
     }
 
     return id;
@@ -258,46 +258,47 @@ uint32_t Printer::Constant(const core::constant::Value* constant) {
                     {Type(ty), id});
             },
             [&](const core::type::I32*) {
-                module_.PushType(spv::Op::OpConstant, {Type(ty), id, constant->ValueAs<u32>()});
+                module_.PushType(spv::Op::OpConstant,
+                                 {Type(ty), id, constant->ValueAs<uint32_t>()});
             },
             [&](const core::type::U32*) {
                 module_.PushType(spv::Op::OpConstant,
-                                 {Type(ty), id, U32Operand(constant->ValueAs<i32>())});
+                                 {Type(ty), id, constant->ValueAs<uint32_t>()});
             },
             [&](const core::type::F32*) {
-                module_.PushType(spv::Op::OpConstant, {Type(ty), id, constant->ValueAs<f32>()});
+                module_.PushType(spv::Op::OpConstant, {Type(ty), id, constant->ValueAs<float>()});
             },
             [&](const core::type::F16*) {
                 module_.PushType(
                     spv::Op::OpConstant,
-                    {Type(ty), id, U32Operand(constant->ValueAs<f16>().BitsRepresentation())});
+                    {Type(ty), id, constant->ValueAs<f16>().BitsRepresentation()});
             },
             [&](const core::type::Vector* vec) {
-                OperandList operands = {Type(ty), id};
+                WordOperandList operands = {Type(ty), id};
                 for (uint32_t i = 0; i < vec->Width(); i++) {
-                    operands.push_back(Constant(constant->Index(i)));
+                    operands.Push(Constant(constant->Index(i)));
                 }
                 module_.PushType(spv::Op::OpConstantComposite, operands);
             },
             [&](const core::type::Matrix* mat) {
-                OperandList operands = {Type(ty), id};
+                WordOperandList operands = {Type(ty), id};
                 for (uint32_t i = 0; i < mat->columns(); i++) {
-                    operands.push_back(Constant(constant->Index(i)));
+                    operands.Push(Constant(constant->Index(i)));
                 }
                 module_.PushType(spv::Op::OpConstantComposite, operands);
             },
             [&](const core::type::Array* arr) {
                 TINT_ASSERT(arr->ConstantCount());
-                OperandList operands = {Type(ty), id};
+                WordOperandList operands = {Type(ty), id};
                 for (uint32_t i = 0; i < arr->ConstantCount(); i++) {
-                    operands.push_back(Constant(constant->Index(i)));
+                    operands.Push(Constant(constant->Index(i)));
                 }
                 module_.PushType(spv::Op::OpConstantComposite, operands);
             },
             [&](const core::type::Struct* str) {
-                OperandList operands = {Type(ty), id};
+                WordOperandList operands = {Type(ty), id};
                 for (uint32_t i = 0; i < str->Members().Length(); i++) {
-                    operands.push_back(Constant(constant->Index(i)));
+                    operands.Push(Constant(constant->Index(i)));
                 }
                 module_.PushType(spv::Op::OpConstantComposite, operands);
             },
@@ -364,11 +365,11 @@ uint32_t Printer::Type(const core::type::Type* ty,
                     module_.PushType(spv::Op::OpTypeRuntimeArray, {id, Type(arr->ElemType())});
                 }
                 module_.PushAnnot(spv::Op::OpDecorate,
-                                  {id, U32Operand(SpvDecorationArrayStride), arr->Stride()});
+                                  {id, SpvDecorationArrayStride, arr->Stride()});
             },
             [&](const core::type::Pointer* ptr) {
                 module_.PushType(spv::Op::OpTypePointer,
-                                 {id, U32Operand(StorageClass(ptr->AddressSpace())),
+                                 {id, StorageClass(ptr->AddressSpace()),
                                   Type(ptr->StoreType(), ptr->AddressSpace())});
             },
             [&](const core::type::Struct* str) { EmitStructType(id, str, addrspace); },
@@ -409,32 +410,32 @@ void Printer::EmitStructType(uint32_t id,
         return type->As<core::type::Matrix>();
     };
 
-    OperandList operands = {id};
+    WordOperandList operands = {id};
     for (auto* member : str->Members()) {
-        operands.push_back(Type(member->Type()));
+        operands.Push(Type(member->Type()));
 
         // Generate struct member offset decoration.
         module_.PushAnnot(
             spv::Op::OpMemberDecorate,
-            {operands[0], member->Index(), U32Operand(SpvDecorationOffset), member->Offset()});
+            {operands[0], member->Index(), SpvDecorationOffset, member->Offset()});
 
         // Generate shader IO decorations.
         const auto& attrs = member->Attributes();
         if (attrs.location) {
             module_.PushAnnot(
                 spv::Op::OpMemberDecorate,
-                {operands[0], member->Index(), U32Operand(SpvDecorationLocation), *attrs.location});
+                {operands[0], member->Index(), SpvDecorationLocation, *attrs.location});
             if (attrs.interpolation) {
                 switch (attrs.interpolation->type) {
                     case core::InterpolationType::kLinear:
                         module_.PushAnnot(
                             spv::Op::OpMemberDecorate,
-                            {operands[0], member->Index(), U32Operand(SpvDecorationNoPerspective)});
+                            {operands[0], member->Index(), SpvDecorationNoPerspective});
                         break;
                     case core::InterpolationType::kFlat:
                         module_.PushAnnot(
                             spv::Op::OpMemberDecorate,
-                            {operands[0], member->Index(), U32Operand(SpvDecorationFlat)});
+                            {operands[0], member->Index(), SpvDecorationFlat});
                         break;
                     case core::InterpolationType::kPerspective:
                     case core::InterpolationType::kUndefined:
@@ -444,13 +445,13 @@ void Printer::EmitStructType(uint32_t id,
                     case core::InterpolationSampling::kCentroid:
                         module_.PushAnnot(
                             spv::Op::OpMemberDecorate,
-                            {operands[0], member->Index(), U32Operand(SpvDecorationCentroid)});
+                            {operands[0], member->Index(), SpvDecorationCentroid});
                         break;
                     case core::InterpolationSampling::kSample:
                         module_.PushCapability(SpvCapabilitySampleRateShading);
                         module_.PushAnnot(
                             spv::Op::OpMemberDecorate,
-                            {operands[0], member->Index(), U32Operand(SpvDecorationSample)});
+                            {operands[0], member->Index(), SpvDecorationSample});
                         break;
                     case core::InterpolationSampling::kCenter:
                     case core::InterpolationSampling::kUndefined:
@@ -460,38 +461,38 @@ void Printer::EmitStructType(uint32_t id,
         }
         if (attrs.builtin) {
             module_.PushAnnot(spv::Op::OpMemberDecorate,
-                              {operands[0], member->Index(), U32Operand(SpvDecorationBuiltIn),
+                              {operands[0], member->Index(), SpvDecorationBuiltIn,
                                Builtin(*attrs.builtin, addrspace)});
         }
         if (attrs.invariant) {
             module_.PushAnnot(spv::Op::OpMemberDecorate,
-                              {operands[0], member->Index(), U32Operand(SpvDecorationInvariant)});
+                              {operands[0], member->Index(), SpvDecorationInvariant});
         }
 
         // Emit matrix layout decorations if necessary.
         if (auto* matrix_type = get_nested_matrix_type(member->Type())) {
             const uint32_t effective_row_count = (matrix_type->rows() == 2) ? 2 : 4;
             module_.PushAnnot(spv::Op::OpMemberDecorate,
-                              {id, member->Index(), U32Operand(SpvDecorationColMajor)});
+                              {id, member->Index(), SpvDecorationColMajor});
             module_.PushAnnot(spv::Op::OpMemberDecorate,
-                              {id, member->Index(), U32Operand(SpvDecorationMatrixStride),
-                               Operand(effective_row_count * matrix_type->type()->Size())});
+                              {id, member->Index(), SpvDecorationMatrixStride,
+                               effective_row_count * matrix_type->type()->Size()});
         }
 
         if (member->Name().IsValid()) {
             module_.PushDebug(spv::Op::OpMemberName,
-                              {operands[0], member->Index(), Operand(member->Name().Name())});
+                              {operands[0], member->Index(), member->Name().Name()});
         }
     }
     module_.PushType(spv::Op::OpTypeStruct, std::move(operands));
 
     // Add a Block decoration if necessary.
     if (str->StructFlags().Contains(core::type::StructFlag::kBlock)) {
-        module_.PushAnnot(spv::Op::OpDecorate, {id, U32Operand(SpvDecorationBlock)});
+        module_.PushAnnot(spv::Op::OpDecorate, {id, SpvDecorationBlock});
     }
 
     if (str->Name().IsValid()) {
-        module_.PushDebug(spv::Op::OpName, {operands[0], Operand(str->Name().Name())});
+        module_.PushDebug(spv::Op::OpName, {operands[0], str->Name().Name()});
     }
 }
 
@@ -572,7 +573,7 @@ void Printer::EmitFunction(ir::Function* func) {
     auto id = Value(func);
 
     // Emit the function name.
-    module_.PushDebug(spv::Op::OpName, {id, Operand(ir_->NameOf(func).Name())});
+    module_.PushDebug(spv::Op::OpName, {id, ir_->NameOf(func).Name()});
 
     // Emit OpEntryPoint and OpExecutionMode declarations if needed.
     if (func->Stage() != ir::Function::PipelineStage::kUndefined) {
@@ -583,38 +584,40 @@ void Printer::EmitFunction(ir::Function* func) {
     auto return_type_id = Type(func->ReturnType());
 
     FunctionType function_type{return_type_id, {}};
-    InstructionList params;
+    WordStream params;
 
     // Generate function parameter declarations and add their type IDs to the function signature.
     for (auto* param : func->Params()) {
         auto param_type_id = Type(param->Type());
         auto param_id = Value(param);
-        params.push_back(Instruction(spv::Op::OpFunctionParameter, {param_type_id, param_id}));
+        params.Push(spv::Op::OpFunctionParameter, {param_type_id, param_id});
         function_type.param_type_ids.Push(param_type_id);
         if (auto name = ir_->NameOf(param)) {
-            module_.PushDebug(spv::Op::OpName, {param_id, Operand(name.Name())});
+            module_.PushDebug(spv::Op::OpName, {param_id, name.Name()});
         }
     }
 
     // Get the ID for the function type (creating it if needed).
     auto function_type_id = function_types_.GetOrCreate(function_type, [&] {
         auto func_ty_id = module_.NextId();
-        OperandList operands = {func_ty_id, return_type_id};
-        operands.insert(operands.end(), function_type.param_type_ids.begin(),
-                        function_type.param_type_ids.end());
+        WordOperandList operands = {func_ty_id, return_type_id};
+        for (auto param_type_id : function_type.param_type_ids) {
+            operands.Push(param_type_id);
+        }
         module_.PushType(spv::Op::OpTypeFunction, operands);
         return func_ty_id;
     });
 
-    // Declare the function.
-    auto decl =
-        Instruction{spv::Op::OpFunction,
-                    {return_type_id, id, U32Operand(SpvFunctionControlMaskNone), function_type_id}};
+    // Declare the function, followed by its parameters.
+    WordStream decl;
+    decl.Push(spv::Op::OpFunction,
+              {return_type_id, id, SpvFunctionControlMaskNone, function_type_id});
+    decl.Append(params);
 
     // Create a function that we will add instructions to.
     auto entry_block = module_.NextId();
-    current_function_ = Function(decl, entry_block, std::move(params));
-    TINT_DEFER(current_function_ = Function());
+    current_function_ = WordFunction(std::move(decl), entry_block);
+    TINT_DEFER(current_function_ = WordFunction());
 
     // Emit the body of the function.
     EmitBlock(func->Block());
@@ -630,14 +633,14 @@ void Printer::EmitEntryPoint(ir::Function* func, uint32_t id) {
             stage = SpvExecutionModelGLCompute;
             module_.PushExecutionMode(
                 spv::Op::OpExecutionMode,
-                {id, U32Operand(SpvExecutionModeLocalSize), func->WorkgroupSize()->at(0),
+                {id, SpvExecutionModeLocalSize, func->WorkgroupSize()->at(0),
                  func->WorkgroupSize()->at(1), func->WorkgroupSize()->at(2)});
             break;
         }
         case ir::Function::PipelineStage::kFragment: {
             stage = SpvExecutionModelFragment;
             module_.PushExecutionMode(spv::Op::OpExecutionMode,
-                                      {id, U32Operand(SpvExecutionModeOriginUpperLeft)});
+                                      {id, SpvExecutionModeOriginUpperLeft});
             break;
         }
         case ir::Function::PipelineStage::kVertex: {
@@ -649,7 +652,9 @@ void Printer::EmitEntryPoint(ir::Function* func, uint32_t id) {
             return;
     }
 
-    OperandList operands = {U32Operand(stage), id, ir_->NameOf(func).Name()};
+    // The operands refer to the name, which must be alive until the instruction is pushed.
+    auto name = ir_->NameOf(func).Name();
+    WordOperandList operands = {stage, id, name};
 
     // Add the list of all referenced shader IO variables.
     if (ir_->root_block) {
@@ -680,14 +685,14 @@ void Printer::EmitEntryPoint(ir::Function* func, uint32_t id) {
             if (!used) {
                 continue;
             }
-            operands.push_back(Value(var));
+            operands.Push(Value(var));
 
             // Add the `DepthReplacing` execution mode if `frag_depth` is used.
             if (auto* str = ptr->StoreType()->As<core::type::Struct>()) {
                 for (auto* member : str->Members()) {
                     if (member->Attributes().builtin == core::BuiltinValue::kFragDepth) {
                         module_.PushExecutionMode(spv::Op::OpExecutionMode,
-                                                  {id, U32Operand(SpvExecutionModeDepthReplacing)});
+                                                  {id, SpvExecutionModeDepthReplacing});
                     }
                 }
             }
@@ -711,14 +716,14 @@ void Printer::EmitRootBlock(ir::Block* root_block) {
 void Printer::EmitBlock(ir::Block* block) {
     // Emit the label.
     // Skip if this is the function's entry block, as it will be emitted by the function object.
-    if (!current_function_.instructions().empty()) {
-        current_function_.push_inst(spv::Op::OpLabel, {Label(block)});
+    if (!current_function_.Instructions().IsEmpty()) {
+        current_function_.PushInst(spv::Op::OpLabel, {Label(block)});
     }
 
     // If there are no instructions in the block, it's a dead end, so we shouldn't be able to get
     // here to begin with.
     if (block->IsEmpty()) {
-        current_function_.push_inst(spv::Op::OpUnreachable, {});
+        current_function_.PushInst(spv::Op::OpUnreachable, {});
         return;
     }
 
@@ -735,15 +740,15 @@ void Printer::EmitIncomingPhis(ir::MultiInBlock* block) {
     // Emit Phi nodes for all the incoming block parameters
     for (size_t param_idx = 0; param_idx < block->Params().Length(); param_idx++) {
         auto* param = block->Params()[param_idx];
-        OperandList ops{Type(param->Type()), Value(param)};
+        WordOperandList ops{Type(param->Type()), Value(param)};
 
         for (auto* incoming : block->InboundSiblingBranches()) {
             auto* arg = incoming->Args()[param_idx];
-            ops.push_back(Value(arg));
-            ops.push_back(Label(incoming->Block()));
+            ops.Push(Value(arg));
+            ops.Push(Label(incoming->Block()));
         }
 
-        current_function_.push_inst(spv::Op::OpPhi, std::move(ops));
+        current_function_.PushInst(spv::Op::OpPhi, std::move(ops));
     }
 }
 
@@ -776,14 +781,14 @@ void Printer::EmitBlockInstructions(ir::Block* block) {
         // Set the name for the SPIR-V result ID if provided in the module.
         if (inst->Result() && !inst->Is<ir::Var>()) {
             if (auto name = ir_->NameOf(inst)) {
-                module_.PushDebug(spv::Op::OpName, {Value(inst), Operand(name.Name())});
+                module_.PushDebug(spv::Op::OpName, {Value(inst), name.Name()});
             }
         }
     }
 
     if (block->IsEmpty()) {
         // If the last emitted instruction is not a branch, then this should be unreachable.
-        current_function_.push_inst(spv::Op::OpUnreachable, {});
+        current_function_.PushInst(spv::Op::OpUnreachable, {});
     }
 }
 
@@ -793,16 +798,16 @@ void Printer::EmitTerminator(ir::Terminator* t) {
         [&](ir::Return*) {
             if (!t->Args().IsEmpty()) {
                 TINT_ASSERT(t->Args().Length() == 1u);
-                OperandList operands;
-                operands.push_back(Value(t->Args()[0]));
-                current_function_.push_inst(spv::Op::OpReturnValue, operands);
+                WordOperandList operands;
+                operands.Push(Value(t->Args()[0]));
+                current_function_.PushInst(spv::Op::OpReturnValue, operands);
             } else {
-                current_function_.push_inst(spv::Op::OpReturn, {});
+                current_function_.PushInst(spv::Op::OpReturn, {});
             }
             return;
         },
         [&](ir::BreakIf* breakif) {
-            current_function_.push_inst(spv::Op::OpBranchConditional,
+            current_function_.PushInst(spv::Op::OpBranchConditional,
                                         {
                                             Value(breakif->Condition()),
                                             loop_merge_label_,
@@ -810,18 +815,18 @@ void Printer::EmitTerminator(ir::Terminator* t) {
                                         });
         },
         [&](ir::Continue* cont) {
-            current_function_.push_inst(spv::Op::OpBranch, {Label(cont->Loop()->Continuing())});
+            current_function_.PushInst(spv::Op::OpBranch, {Label(cont->Loop()->Continuing())});
         },
-        [&](ir::ExitIf*) { current_function_.push_inst(spv::Op::OpBranch, {if_merge_label_}); },
-        [&](ir::ExitLoop*) { current_function_.push_inst(spv::Op::OpBranch, {loop_merge_label_}); },
+        [&](ir::ExitIf*) { current_function_.PushInst(spv::Op::OpBranch, {if_merge_label_}); },
+        [&](ir::ExitLoop*) { current_function_.PushInst(spv::Op::OpBranch, {loop_merge_label_}); },
         [&](ir::ExitSwitch*) {
-            current_function_.push_inst(spv::Op::OpBranch, {switch_merge_label_});
+            current_function_.PushInst(spv::Op::OpBranch, {switch_merge_label_});
         },
         [&](ir::NextIteration*) {
-            current_function_.push_inst(spv::Op::OpBranch, {loop_header_label_});
+            current_function_.PushInst(spv::Op::OpBranch, {loop_header_label_});
         },
-        [&](ir::TerminateInvocation*) { current_function_.push_inst(spv::Op::OpKill, {}); },
-        [&](ir::Unreachable*) { current_function_.push_inst(spv::Op::OpUnreachable, {}); },
+        [&](ir::TerminateInvocation*) { current_function_.PushInst(spv::Op::OpKill, {}); },
+        [&](ir::Unreachable*) { current_function_.PushInst(spv::Op::OpUnreachable, {}); },
 
         [&](Default) { TINT_ICE() << "unimplemented branch: " << t->TypeInfo().name; });
 }
@@ -850,9 +855,9 @@ void Printer::EmitIf(ir::If* i) {
     }
 
     // Emit the OpSelectionMerge and OpBranchConditional instructions.
-    current_function_.push_inst(spv::Op::OpSelectionMerge,
-                                {merge_label, U32Operand(SpvSelectionControlMaskNone)});
-    current_function_.push_inst(spv::Op::OpBranchConditional,
+    current_function_.PushInst(spv::Op::OpSelectionMerge,
+                                {merge_label, SpvSelectionControlMaskNone});
+    current_function_.PushInst(spv::Op::OpBranchConditional,
                                 {Value(i->Condition()), true_label, false_label});
 
     // Emit the `true` and `false` blocks, if they're not being skipped.
@@ -863,7 +868,7 @@ void Printer::EmitIf(ir::If* i) {
         EmitBlock(false_block);
     }
 
-    current_function_.push_inst(spv::Op::OpLabel, {merge_label});
+    current_function_.PushInst(spv::Op::OpLabel, {merge_label});
 
     // Emit the OpPhis for the ExitIfs
     EmitExitPhis(i);
@@ -873,14 +878,14 @@ void Printer::EmitAccess(ir::Access* access) {
     auto* ty = access->Result()->Type();
 
     auto id = Value(access);
-    OperandList operands = {Type(ty), id, Value(access->Object())};
+    WordOperandList operands = {Type(ty), id, Value(access->Object())};
 
     if (ty->Is<core::type::Pointer>()) {
         // Use OpAccessChain for accesses into pointer types.
         for (auto* idx : access->Indices()) {
-            operands.push_back(Value(idx));
+            operands.Push(Value(idx));
         }
-        current_function_.push_inst(spv::Op::OpAccessChain, std::move(operands));
+        current_function_.PushInst(spv::Op::OpAccessChain, std::move(operands));
         return;
     }
 
@@ -890,8 +895,8 @@ void Printer::EmitAccess(ir::Access* access) {
     for (auto* idx : access->Indices()) {
         if (auto* constant = idx->As<ir::Constant>()) {
             // Push the index to the chain and update the current type.
-            auto i = constant->Value()->ValueAs<u32>();
-            operands.push_back(i);
+            auto i = constant->Value()->ValueAs<uint32_t>();
+            operands.Push(i);
             source_ty = source_ty->Element(i);
         } else {
             // The VarForDynamicIndex transform ensures that only value types that are vectors
@@ -901,20 +906,20 @@ void Printer::EmitAccess(ir::Access* access) {
             // If this wasn't the first access in the chain then emit the chain so far as an
             // OpCompositeExtract, creating a new result ID for the resulting vector.
             auto vec_id = Value(access->Object());
-            if (operands.size() > 3) {
+            if (operands.Length() > 3) {
                 vec_id = module_.NextId();
                 operands[0] = Type(source_ty);
                 operands[1] = vec_id;
-                current_function_.push_inst(spv::Op::OpCompositeExtract, std::move(operands));
+                current_function_.PushInst(spv::Op::OpCompositeExtract, std::move(operands));
             }
 
             // Now emit the OpVectorExtractDynamic instruction.
             operands = {Type(ty), id, vec_id, Value(idx)};
-            current_function_.push_inst(spv::Op::OpVectorExtractDynamic, std::move(operands));
+            current_function_.PushInst(spv::Op::OpVectorExtractDynamic, std::move(operands));
             return;
         }
     }
-    current_function_.push_inst(spv::Op::OpCompositeExtract, std::move(operands));
+    current_function_.PushInst(spv::Op::OpCompositeExtract, std::move(operands));
 }
 
 void Printer::EmitBinary(ir::Binary* binary) {
@@ -1061,7 +1066,7 @@ void Printer::EmitBinary(ir::Binary* binary) {
     }
 
     // Emit the instruction.
-    current_function_.push_inst(op, {Type(ty), id, lhs, rhs});
+    current_function_.PushInst(op, {Type(ty), id, lhs, rhs});
 }
 
 void Printer::EmitBitcast(ir::Bitcast* bitcast) {
@@ -1070,7 +1075,7 @@ void Printer::EmitBitcast(ir::Bitcast* bitcast) {
         values_.Add(bitcast->Result(), Value(bitcast->Val()));
         return;
     }
-    current_function_.push_inst(spv::Op::OpBitcast,
+    current_function_.PushInst(spv::Op::OpBitcast,
                                 {Type(ty), Value(bitcast), Value(bitcast->Val())});
 }
 
@@ -1093,19 +1098,19 @@ void Printer::EmitCoreBuiltinCall(ir::CoreBuiltinCall* builtin) {
     auto id = Value(builtin);
 
     spv::Op op = spv::Op::Max;
-    OperandList operands = {Type(result_ty), id};
+    WordOperandList operands = {Type(result_ty), id};
 
     // Helper to set up the opcode and operand list for a GLSL extended instruction.
     auto glsl_ext_inst = [&](enum GLSLstd450 inst) {
         constexpr const char* kGLSLstd450 = "GLSL.std.450";
         op = spv::Op::OpExtInst;
-        operands.push_back(imports_.GetOrCreate(kGLSLstd450, [&] {
+        operands.Push(imports_.GetOrCreate(kGLSLstd450, [&] {
             // Import the instruction set the first time it is requested.
             auto import = module_.NextId();
-            module_.PushExtImport(spv::Op::OpExtInstImport, {import, Operand(kGLSLstd450)});
+            module_.PushExtImport(spv::Op::OpExtInstImport, {import, kGLSLstd450});
             return import;
         }));
-        operands.push_back(U32Operand(inst));
+        operands.Push(inst);
     };
 
     // Determine the opcode.
@@ -1340,18 +1345,18 @@ void Printer::EmitCoreBuiltinCall(ir::CoreBuiltinCall* builtin) {
             break;
         case core::Function::kStorageBarrier:
             op = spv::Op::OpControlBarrier;
-            operands.clear();
-            operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-            operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-            operands.push_back(
+            operands.Clear();
+            operands.Push(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+            operands.Push(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+            operands.Push(
                 Constant(b_.ConstantValue(u32(spv::MemorySemanticsMask::UniformMemory |
                                               spv::MemorySemanticsMask::AcquireRelease))));
             break;
         case core::Function::kSubgroupBallot:
             module_.PushCapability(SpvCapabilityGroupNonUniformBallot);
             op = spv::Op::OpGroupNonUniformBallot;
-            operands.push_back(Constant(ir_->constant_values.Get(u32(spv::Scope::Subgroup))));
-            operands.push_back(Constant(ir_->constant_values.Get(true)));
+            operands.Push(Constant(ir_->constant_values.Get(u32(spv::Scope::Subgroup))));
+            operands.Push(Constant(ir_->constant_values.Get(true)));
             break;
         case core::Function::kTan:
             glsl_ext_inst(GLSLstd450Tan);
@@ -1390,10 +1395,10 @@ void Printer::EmitCoreBuiltinCall(ir::CoreBuiltinCall* builtin) {
             break;
         case core::Function::kWorkgroupBarrier:
             op = spv::Op::OpControlBarrier;
-            operands.clear();
-            operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-            operands.push_back(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
-            operands.push_back(
+            operands.Clear();
+            operands.Push(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+            operands.Push(Constant(b_.ConstantValue(u32(spv::Scope::Workgroup))));
+            operands.Push(
                 Constant(b_.ConstantValue(u32(spv::MemorySemanticsMask::WorkgroupMemory |
                                               spv::MemorySemanticsMask::AcquireRelease))));
             break;
@@ -1404,11 +1409,11 @@ void Printer::EmitCoreBuiltinCall(ir::CoreBuiltinCall* builtin) {
 
     // Add the arguments to the builtin call.
     for (auto* arg : builtin->Args()) {
-        operands.push_back(Value(arg));
+        operands.Push(Value(arg));
     }
 
     // Emit the instruction.
-    current_function_.push_inst(op, operands);
+    current_function_.PushInst(op, operands);
 }
 
 void Printer::EmitConstruct(ir::Construct* construct) {
@@ -1420,20 +1425,20 @@ void Printer::EmitConstruct(ir::Construct* construct) {
         return;
     }
 
-    OperandList operands = {Type(construct->Result()->Type()), Value(construct)};
+    WordOperandList operands = {Type(construct->Result()->Type()), Value(construct)};
     for (auto* arg : construct->Args()) {
-        operands.push_back(Value(arg));
+        operands.Push(Value(arg));
     }
-    current_function_.push_inst(spv::Op::OpCompositeConstruct, std::move(operands));
+    current_function_.PushInst(spv::Op::OpCompositeConstruct, std::move(operands));
 }
 
 void Printer::EmitConvert(ir::Convert* convert) {
     auto* res_ty = convert->Result()->Type();
     auto* arg_ty = convert->Args()[0]->Type();
 
-    OperandList operands = {Type(convert->Result()->Type()), Value(convert)};
+    WordOperandList operands = {Type(convert->Result()->Type()), Value(convert)};
     for (auto* arg : convert->Args()) {
-        operands.push_back(Value(arg));
+        operands.Push(Value(arg));
     }
 
     spv::Op op = spv::Op::Max;
@@ -1468,7 +1473,7 @@ void Printer::EmitConvert(ir::Convert* convert) {
             // float to bool.
             op = spv::Op::OpFUnordNotEqual;
         }
-        operands.push_back(ConstantNull(arg_ty));
+        operands.Push(ConstantNull(arg_ty));
     } else if (arg_ty->is_bool_scalar_or_vector()) {
         // Select between constant one and zero, splatting them to vectors if necessary.
         ir::Constant* one = nullptr;
@@ -1500,13 +1505,13 @@ void Printer::EmitConvert(ir::Convert* convert) {
         }
 
         op = spv::Op::OpSelect;
-        operands.push_back(Constant(b_.ConstantValue(one)));
-        operands.push_back(Constant(b_.ConstantValue(zero)));
+        operands.Push(Constant(b_.ConstantValue(one)));
+        operands.Push(Constant(b_.ConstantValue(zero)));
     } else {
         TINT_ICE() << "unhandled convert instruction";
     }
 
-    current_function_.push_inst(op, std::move(operands));
+    current_function_.PushInst(op, std::move(operands));
 }
 
 void Printer::EmitIntrinsicCall(ir::IntrinsicCall* call) {
@@ -1614,18 +1619,18 @@ void Printer::EmitIntrinsicCall(ir::IntrinsicCall* call) {
             break;
     }
 
-    OperandList operands;
+    WordOperandList operands;
     if (!call->Result()->Type()->Is<core::type::Void>()) {
         operands = {Type(call->Result()->Type()), id};
     }
     for (auto* arg : call->Args()) {
-        operands.push_back(Value(arg));
+        operands.Push(Value(arg));
     }
-    current_function_.push_inst(op, operands);
+    current_function_.PushInst(op, operands);
 }
 
 void Printer::EmitLoad(ir::Load* load) {
-    current_function_.push_inst(spv::Op::OpLoad,
+    current_function_.PushInst(spv::Op::OpLoad,
                                 {Type(load->Result()->Type()), Value(load), Value(load->From())});
 }
 
@@ -1634,10 +1639,10 @@ void Printer::EmitLoadVectorElement(ir::LoadVectorElement* load) {
     auto* el_ty = load->Result()->Type();
     auto* el_ptr_ty = ir_->Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access());
     auto el_ptr_id = module_.NextId();
-    current_function_.push_inst(
+    current_function_.PushInst(
         spv::Op::OpAccessChain,
         {Type(el_ptr_ty), el_ptr_id, Value(load->From()), Value(load->Index())});
-    current_function_.push_inst(spv::Op::OpLoad,
+    current_function_.PushInst(spv::Op::OpLoad,
                                 {Type(load->Result()->Type()), Value(load), el_ptr_id});
 }
 
@@ -1654,23 +1659,23 @@ void Printer::EmitLoop(ir::Loop* loop) {
 
     if (init_label != 0) {
         // Emit the loop initializer.
-        current_function_.push_inst(spv::Op::OpBranch, {init_label});
+        current_function_.PushInst(spv::Op::OpBranch, {init_label});
         EmitBlock(loop->Initializer());
     } else {
         // No initializer. Branch to body.
-        current_function_.push_inst(spv::Op::OpBranch, {header_label});
+        current_function_.PushInst(spv::Op::OpBranch, {header_label});
     }
 
     // Emit the loop body header, which contains the OpLoopMerge and OpPhis.
     // This then unconditionally branches to body_label
-    current_function_.push_inst(spv::Op::OpLabel, {header_label});
+    current_function_.PushInst(spv::Op::OpLabel, {header_label});
     EmitIncomingPhis(loop->Body());
-    current_function_.push_inst(
-        spv::Op::OpLoopMerge, {merge_label, continuing_label, U32Operand(SpvLoopControlMaskNone)});
-    current_function_.push_inst(spv::Op::OpBranch, {body_label});
+    current_function_.PushInst(
+        spv::Op::OpLoopMerge, {merge_label, continuing_label, SpvLoopControlMaskNone});
+    current_function_.PushInst(spv::Op::OpBranch, {body_label});
 
     // Emit the loop body
-    current_function_.push_inst(spv::Op::OpLabel, {body_label});
+    current_function_.PushInst(spv::Op::OpLabel, {body_label});
     EmitBlockInstructions(loop->Body());
 
     // Emit the loop continuing block.
@@ -1678,12 +1683,12 @@ void Printer::EmitLoop(ir::Loop* loop) {
         EmitBlock(loop->Continuing());
     } else {
         // We still need to emit a continuing block with a back-edge, even if it is unreachable.
-        current_function_.push_inst(spv::Op::OpLabel, {continuing_label});
-        current_function_.push_inst(spv::Op::OpBranch, {header_label});
+        current_function_.PushInst(spv::Op::OpLabel, {continuing_label});
+        current_function_.PushInst(spv::Op::OpBranch, {header_label});
     }
 
     // Emit the loop merge block.
-    current_function_.push_inst(spv::Op::OpLabel, {merge_label});
+    current_function_.PushInst(spv::Op::OpLabel, {merge_label});
 
     // Emit the OpPhis for the ExitLoops
     EmitExitPhis(loop);
@@ -1702,15 +1707,15 @@ void Printer::EmitSwitch(ir::Switch* swtch) {
     TINT_ASSERT(default_label != 0u);
 
     // Build the operands to the OpSwitch instruction.
-    OperandList switch_operands = {Value(swtch->Condition()), default_label};
+    WordOperandList switch_operands = {Value(swtch->Condition()), default_label};
     for (auto& c : swtch->Cases()) {
         auto label = Label(c.Block());
         for (auto& sel : c.selectors) {
             if (sel.IsDefault()) {
                 continue;
             }
-            switch_operands.push_back(sel.val->Value()->ValueAs<uint32_t>());
-            switch_operands.push_back(label);
+            switch_operands.Push(sel.val->Value()->ValueAs<uint32_t>());
+            switch_operands.Push(label);
         }
     }
 
@@ -1718,9 +1723,9 @@ void Printer::EmitSwitch(ir::Switch* swtch) {
     TINT_SCOPED_ASSIGNMENT(switch_merge_label_, merge_label);
 
     // Emit the OpSelectionMerge and OpSwitch instructions.
-    current_function_.push_inst(spv::Op::OpSelectionMerge,
-                                {merge_label, U32Operand(SpvSelectionControlMaskNone)});
-    current_function_.push_inst(spv::Op::OpSwitch, switch_operands);
+    current_function_.PushInst(spv::Op::OpSelectionMerge,
+                                {merge_label, SpvSelectionControlMaskNone});
+    current_function_.PushInst(spv::Op::OpSwitch, switch_operands);
 
     // Emit the cases.
     for (auto& c : swtch->Cases()) {
@@ -1728,7 +1733,7 @@ void Printer::EmitSwitch(ir::Switch* swtch) {
     }
 
     // Emit the switch merge block.
-    current_function_.push_inst(spv::Op::OpLabel, {merge_label});
+    current_function_.PushInst(spv::Op::OpLabel, {merge_label});
 
     // Emit the OpPhis for the ExitSwitches
     EmitExitPhis(swtch);
@@ -1737,15 +1742,15 @@ void Printer::EmitSwitch(ir::Switch* swtch) {
 void Printer::EmitSwizzle(ir::Swizzle* swizzle) {
     auto id = Value(swizzle);
     auto obj = Value(swizzle->Object());
-    OperandList operands = {Type(swizzle->Result()->Type()), id, obj, obj};
+    WordOperandList operands = {Type(swizzle->Result()->Type()), id, obj, obj};
     for (auto idx : swizzle->Indices()) {
-        operands.push_back(idx);
+        operands.Push(idx);
     }
-    current_function_.push_inst(spv::Op::OpVectorShuffle, operands);
+    current_function_.PushInst(spv::Op::OpVectorShuffle, operands);
 }
 
 void Printer::EmitStore(ir::Store* store) {
-    current_function_.push_inst(spv::Op::OpStore, {Value(store->To()), Value(store->From())});
+    current_function_.PushInst(spv::Op::OpStore, {Value(store->To()), Value(store->From())});
 }
 
 void Printer::EmitStoreVectorElement(ir::StoreVectorElement* store) {
@@ -1753,10 +1758,10 @@ void Printer::EmitStoreVectorElement(ir::StoreVectorElement* store) {
     auto* el_ty = store->Value()->Type();
     auto* el_ptr_ty = ir_->Types().ptr(vec_ptr_ty->AddressSpace(), el_ty, vec_ptr_ty->Access());
     auto el_ptr_id = module_.NextId();
-    current_function_.push_inst(
+    current_function_.PushInst(
         spv::Op::OpAccessChain,
         {Type(el_ptr_ty), el_ptr_id, Value(store->To()), Value(store->Index())});
-    current_function_.push_inst(spv::Op::OpStore, {el_ptr_id, Value(store->Value())});
+    current_function_.PushInst(spv::Op::OpStore, {el_ptr_id, Value(store->Value())});
 }
 
 void Printer::EmitUnary(ir::Unary* unary) {
@@ -1775,16 +1780,16 @@ void Printer::EmitUnary(ir::Unary* unary) {
             }
             break;
     }
-    current_function_.push_inst(op, {Type(ty), id, Value(unary->Val())});
+    current_function_.PushInst(op, {Type(ty), id, Value(unary->Val())});
 }
 
 void Printer::EmitUserCall(ir::UserCall* call) {
     auto id = Value(call);
-    OperandList operands = {Type(call->Result()->Type()), id, Value(call->Func())};
+    WordOperandList operands = {Type(call->Result()->Type()), id, Value(call->Func())};
     for (auto* arg : call->Args()) {
-        operands.push_back(Value(arg));
+        operands.Push(Value(arg));
     }
-    current_function_.push_inst(spv::Op::OpFunctionCall, operands);
+    current_function_.PushInst(spv::Op::OpFunctionCall, operands);
 }
 
 void Printer::EmitVar(ir::Var* var) {
@@ -1795,23 +1800,23 @@ void Printer::EmitVar(ir::Var* var) {
     switch (ptr->AddressSpace()) {
         case core::AddressSpace::kFunction: {
             TINT_ASSERT(current_function_);
-            current_function_.push_var({ty, id, U32Operand(SpvStorageClassFunction)});
+            current_function_.PushVar({ty, id, SpvStorageClassFunction});
             if (var->Initializer()) {
-                current_function_.push_inst(spv::Op::OpStore, {id, Value(var->Initializer())});
+                current_function_.PushInst(spv::Op::OpStore, {id, Value(var->Initializer())});
             }
             break;
         }
         case core::AddressSpace::kIn: {
             TINT_ASSERT(!current_function_);
-            module_.PushType(spv::Op::OpVariable, {ty, id, U32Operand(SpvStorageClassInput)});
+            module_.PushType(spv::Op::OpVariable, {ty, id, SpvStorageClassInput});
             break;
         }
         case core::AddressSpace::kPrivate: {
             TINT_ASSERT(!current_function_);
-            OperandList operands = {ty, id, U32Operand(SpvStorageClassPrivate)};
+            WordOperandList operands = {ty, id, SpvStorageClassPrivate};
             if (var->Initializer()) {
                 TINT_ASSERT(var->Initializer()->Is<ir::Constant>());
-                operands.push_back(Value(var->Initializer()));
+                operands.Push(Value(var->Initializer()));
             }
             module_.PushType(spv::Op::OpVariable, operands);
             break;
@@ -1819,12 +1824,12 @@ void Printer::EmitVar(ir::Var* var) {
         case core::AddressSpace::kPushConstant: {
             TINT_ASSERT(!current_function_);
             module_.PushType(spv::Op::OpVariable,
-                             {ty, id, U32Operand(SpvStorageClassPushConstant)});
+                             {ty, id, SpvStorageClassPushConstant});
             break;
         }
         case core::AddressSpace::kOut: {
             TINT_ASSERT(!current_function_);
-            module_.PushType(spv::Op::OpVariable, {ty, id, U32Operand(SpvStorageClassOutput)});
+            module_.PushType(spv::Op::OpVariable, {ty, id, SpvStorageClassOutput});
             break;
         }
         case core::AddressSpace::kHandle:
@@ -1832,21 +1837,21 @@ void Printer::EmitVar(ir::Var* var) {
         case core::AddressSpace::kUniform: {
             TINT_ASSERT(!current_function_);
             module_.PushType(spv::Op::OpVariable,
-                             {ty, id, U32Operand(StorageClass(ptr->AddressSpace()))});
+                             {ty, id, StorageClass(ptr->AddressSpace())});
             auto bp = var->BindingPoint().value();
             module_.PushAnnot(spv::Op::OpDecorate,
-                              {id, U32Operand(SpvDecorationDescriptorSet), bp.group});
+                              {id, SpvDecorationDescriptorSet, bp.group});
             module_.PushAnnot(spv::Op::OpDecorate,
-                              {id, U32Operand(SpvDecorationBinding), bp.binding});
+                              {id, SpvDecorationBinding, bp.binding});
             break;
         }
         case core::AddressSpace::kWorkgroup: {
             TINT_ASSERT(!current_function_);
-            OperandList operands = {ty, id, U32Operand(SpvStorageClassWorkgroup)};
+            WordOperandList operands = {ty, id, SpvStorageClassWorkgroup};
             if (zero_init_workgroup_memory_) {
                 // If requested, use the VK_KHR_zero_initialize_workgroup_memory to zero-initialize
                 // the workgroup variable using an null constant initializer.
-                operands.push_back(ConstantNull(ptr->StoreType()));
+                operands.Push(ConstantNull(ptr->StoreType()));
             }
             module_.PushType(spv::Op::OpVariable, operands);
             break;
@@ -1858,7 +1863,7 @@ void Printer::EmitVar(ir::Var* var) {
 
     // Set the name if present.
     if (auto name = ir_->NameOf(var)) {
-        module_.PushDebug(spv::Op::OpName, {id, Operand(name.Name())});
+        module_.PushDebug(spv::Op::OpName, {id, name.Name()});
     }
 }
 
@@ -1886,16 +1891,16 @@ void Printer::EmitExitPhis(ir::ControlInstruction* inst) {
         }
         branches.Sort();  // Sort the branches by label to ensure deterministic output
 
-        OperandList ops{Type(ty), Value(result)};
+        WordOperandList ops{Type(ty), Value(result)};
         for (auto& branch : branches) {
             if (branch.value == nullptr) {
-                ops.push_back(Undef(ty));
+                ops.Push(Undef(ty));
             } else {
-                ops.push_back(Value(branch.value));
+                ops.Push(Value(branch.value));
             }
-            ops.push_back(branch.label);
+            ops.Push(branch.label);
         }
-        current_function_.push_inst(spv::Op::OpPhi, std::move(ops));
+        current_function_.PushInst(spv::Op::OpPhi, std::move(ops));
     }
 }
 
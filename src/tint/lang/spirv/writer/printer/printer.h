@@ -25,8 +25,8 @@
 #include "src/tint/lang/core/ir/constant.h"
 #include "src/tint/lang/core/texel_format.h"
 #include "src/tint/lang/spirv/writer/common/binary_writer.h"
-#include "src/tint/lang/spirv/writer/common/function.h"
-#include "src/tint/lang/spirv/writer/common/module.h"
+#include "src/tint/lang/spirv/writer/common/word_function.h"
+#include "src/tint/lang/spirv/writer/common/word_module.h"
 #include "src/tint/utils/containers/hashmap.h"
 #include "src/tint/utils/containers/vector.h"
 #include "src/tint/utils/diagnostic/diagnostic.h"
@@ -87,7 +87,7 @@ class Printer {
     tint::Result<std::vector<uint32_t>, std::string> Generate();
 
     /// @returns the module that this writer has produced
-    writer::Module& Module() { return module_; }
+    WordModule& Module() { return module_; }
 
     /// Get the result ID of the constant `constant`, emitting its instruction if necessary.
     /// @param constant the constant to get the ID for
@@ -268,7 +268,7 @@ class Printer {
 
     ir::Module* ir_;
     ir::Builder b_;
-    writer::Module module_;
+    WordModule module_;
     BinaryWriter writer_;
 
     /// A function type used for an OpTypeFunction declaration.
@@ -321,7 +321,7 @@ class Printer {
     Hashmap<std::string_view, uint32_t, 2> imports_;
 
     /// The current function that is being emitted.
-    Function current_function_;
+    WordFunction current_function_;
 
     /// The merge block for the current if statement
     uint32_t if_merge_label_ = 0;
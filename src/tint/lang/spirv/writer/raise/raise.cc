@@ -19,8 +19,13 @@
 #include "src/tint/lang/core/ir/transform/add_empty_entry_point.h"
 #include "src/tint/lang/core/ir/transform/bgra8unorm_polyfill.h"
 #include "src/tint/lang/core/ir/transform/block_decorated_structs.h"
+#include "src/tint/lang/core/ir/transform/block_simplification.h"
 #include "src/tint/lang/core/ir/transform/builtin_polyfill.h"
+#include "src/tint/lang/core/ir/transform/common_subexpression_elimination.h"
+#include "src/tint/lang/core/ir/transform/constant_folding.h"
+#include "src/tint/lang/core/ir/transform/dead_code_elimination.h"
 #include "src/tint/lang/core/ir/transform/demote_to_helper.h"
+#include "src/tint/lang/core/ir/transform/inline_functions.h"
 #include "src/tint/lang/core/ir/transform/std140.h"
 #include "src/tint/lang/spirv/writer/raise/builtin_polyfill.h"
 #include "src/tint/lang/spirv/writer/raise/expand_implicit_splats.h"
@@ -31,7 +36,7 @@
 
 namespace tint::spirv::writer::raise {
 
-Result<SuccessType, std::string> Raise(ir::Module* module) {
+Result<SuccessType, std::string> Raise(ir::Module* module, const Options& options) {
 #define RUN_TRANSFORM(name, ...)         \
     do {                                 \
         auto result = name(__VA_ARGS__); \
@@ -40,6 +45,15 @@ Result<SuccessType, std::string> Raise(ir::Module* module) {
         }                                \
     } while (false)
 
+    if (options.optimize_ir) {
+        // Shrink the core IR before it is lowered. Folding constants can make control flow
+        // trivial, and both can leave instructions that are redundant or unused.
+        RUN_TRANSFORM(ir::transform::ConstantFolding, module);
+        RUN_TRANSFORM(ir::transform::BlockSimplification, module);
+        RUN_TRANSFORM(ir::transform::CommonSubexpressionElimination, module);
+        RUN_TRANSFORM(ir::transform::DeadCodeElimination, module);
+    }
+
     ir::transform::BuiltinPolyfillConfig core_polyfills;
     core_polyfills.count_leading_zeros = true;
     core_polyfills.count_trailing_zeros = true;
@@ -57,6 +71,11 @@ Result<SuccessType, std::string> Raise(ir::Module* module) {
     RUN_TRANSFORM(ExpandImplicitSplats, module);
     RUN_TRANSFORM(HandleMatrixArithmetic, module);
     RUN_TRANSFORM(MergeReturn, module);
+    if (options.inline_functions) {
+        // Inline after MergeReturn, as only functions with a single return can be inlined.
+        RUN_TRANSFORM(ir::transform::InlineFunctions, module,
+                      ir::transform::InlineFunctionsConfig{});
+    }
     RUN_TRANSFORM(ShaderIO, module);
     RUN_TRANSFORM(ir::transform::Std140, module);
     RUN_TRANSFORM(VarForDynamicIndex, module);
@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #include <string>
+#include <utility>
 
 #include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/spirv/writer/common/binary_writer.h"
+#include "src/tint/lang/spirv/writer/common/module.h"
+#include "src/tint/lang/spirv/writer/common/word_module.h"
 
 namespace tint::spirv::writer {
 namespace {
@@ -30,7 +34,9 @@ void RunBenchmark(benchmark::State& state, std::string input_name, Options optio
         auto res = Generate(&program, options);
         if (!res) {
             state.SkipWithError(res.Failure());
+            return;
         }
+        state.counters["words"] = static_cast<double>(res->spirv.size());
     }
 }
 
@@ -44,8 +50,80 @@ void GenerateSPIRV_UseIR(benchmark::State& state, std::string input_name) {
     RunBenchmark(state, input_name, std::move(options));
 }
 
+void GenerateSPIRV_UseIR_Optimize(benchmark::State& state, std::string input_name) {
+    Options options;
+    options.use_tint_ir = true;
+    options.optimize_ir = true;
+    RunBenchmark(state, input_name, std::move(options));
+}
+
+void GenerateSPIRV_UseIR_Inline(benchmark::State& state, std::string input_name) {
+    Options options;
+    options.use_tint_ir = true;
+    options.inline_functions = true;
+    RunBenchmark(state, input_name, std::move(options));
+}
+
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV);
 TINT_BENCHMARK_PROGRAMS(GenerateSPIRV_UseIR);
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRV_UseIR_Optimize);
+TINT_BENCHMARK_PROGRAMS(GenerateSPIRV_UseIR_Inline);
+
+// The number of functions and instructions per function emitted by the encoding benchmarks below.
+constexpr uint32_t kEncodeFunctionCount = 100;
+constexpr uint32_t kEncodeInstructionsPerFunction = 1000;
+
+/// Emits a synthetic shader into a Module, which allocates each instruction and its operands, and
+/// then flattens it into words.
+void EncodeSPIRV_Module(benchmark::State& state) {
+    for (auto _ : state) {
+        Module module;
+        auto u32 = module.NextId();
+        module.PushType(spv::Op::OpTypeInt, {u32, 32u, 0u});
+        for (uint32_t f = 0; f < kEncodeFunctionCount; f++) {
+            auto func_id = module.NextId();
+            module.PushDebug(spv::Op::OpName, {func_id, Operand("function_" + std::to_string(f))});
+            Function func(Instruction(spv::Op::OpFunction, {u32, func_id, 0u, u32}),
+                          module.NextId(), {});
+            for (uint32_t i = 0; i < kEncodeInstructionsPerFunction; i++) {
+                func.push_inst(spv::Op::OpIAdd, {u32, module.NextId(), func_id, func_id});
+            }
+            module.PushFunction(func);
+        }
+        BinaryWriter writer;
+        writer.WriteHeader(module.IdBound());
+        writer.WriteModule(&module);
+        state.counters["words"] = static_cast<double>(writer.Result().size());
+    }
+}
+
+/// Emits the same shader as EncodeSPIRV_Module into a WordModule, which encodes each instruction
+/// into the words of its section as it is added.
+void EncodeSPIRV_WordModule(benchmark::State& state) {
+    for (auto _ : state) {
+        WordModule module;
+        auto u32 = module.NextId();
+        module.PushType(spv::Op::OpTypeInt, {u32, 32u, 0u});
+        for (uint32_t f = 0; f < kEncodeFunctionCount; f++) {
+            auto func_id = module.NextId();
+            module.PushDebug(spv::Op::OpName, {func_id, "function_" + std::to_string(f)});
+            WordStream decl;
+            decl.Push(spv::Op::OpFunction, {u32, func_id, 0u, u32});
+            WordFunction func(std::move(decl), module.NextId());
+            for (uint32_t i = 0; i < kEncodeInstructionsPerFunction; i++) {
+                func.PushInst(spv::Op::OpIAdd, {u32, module.NextId(), func_id, func_id});
+            }
+            module.PushFunction(func);
+        }
+        BinaryWriter writer;
+        writer.WriteHeader(module.IdBound());
+        writer.WriteModule(&module);
+        state.counters["words"] = static_cast<double>(writer.Result().size());
+    }
+}
+
+BENCHMARK(EncodeSPIRV_Module);
+BENCHMARK(EncodeSPIRV_WordModule);
 
 }  // namespace
 }  // namespace tint::spirv::writer
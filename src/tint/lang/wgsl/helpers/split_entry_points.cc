@@ -0,0 +1,72 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/wgsl/helpers/split_entry_points.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "src/tint/lang/wgsl/ast/transform/manager.h"
+#include "src/tint/lang/wgsl/ast/transform/single_entry_point.h"
+
+namespace tint::writer {
+
+void SplitEntryPoints(const Program& program,
+                      VectorRef<std::string> entry_points,
+                      uint32_t jobs,
+                      const SplitEntryPointsCallback& callback) {
+    auto split = [&](size_t index) {
+        ast::transform::Manager manager;
+        ast::transform::DataMap inputs;
+        ast::transform::DataMap outputs;
+        manager.Add<ast::transform::SingleEntryPoint>();
+        inputs.Add<ast::transform::SingleEntryPoint::Config>(entry_points[index]);
+        Program single_entry_point = manager.Run(&program, std::move(inputs), outputs);
+        callback(index, single_entry_point);
+    };
+
+    if (jobs == 0) {
+        jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    const size_t count = entry_points.Length();
+    const size_t num_threads = std::min<size_t>(jobs, count);
+    if (num_threads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            split(i);
+        }
+        return;
+    }
+
+    // The entry points are claimed dynamically, as their cost can vary widely.
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < count; i = next++) {
+            split(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace tint::writer
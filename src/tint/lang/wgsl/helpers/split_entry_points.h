@@ -0,0 +1,50 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_LANG_WGSL_HELPERS_SPLIT_ENTRY_POINTS_H_
+#define SRC_TINT_LANG_WGSL_HELPERS_SPLIT_ENTRY_POINTS_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "src/tint/lang/wgsl/program/program.h"
+#include "src/tint/utils/containers/vector.h"
+
+namespace tint::writer {
+
+/// The function called by SplitEntryPoints() for each entry point.
+/// The first parameter is the index of the entry point in the list passed to SplitEntryPoints().
+/// The second parameter is the program holding only that entry point, which may be invalid if the
+/// entry point could not be extracted.
+using SplitEntryPointsCallback = std::function<void(size_t, const Program&)>;
+
+/// SplitEntryPoints builds a program for each of the entry points of `program` that only contains
+/// that entry point and the declarations it uses, using the SingleEntryPoint transform, and calls
+/// `callback` with it.
+/// The entry points are processed concurrently on up to `jobs` threads which all share `program`,
+/// so `callback` may be called concurrently for different entry points. The calling thread is used
+/// as one of the threads, and SplitEntryPoints() returns once all the entry points are processed.
+/// @param program the program to split. Must be valid and must not be modified during the call.
+/// @param entry_points the names of the entry points to build programs for
+/// @param jobs the maximum number of threads to use. If zero, uses the number of hardware threads.
+/// @param callback the function called for each entry point
+void SplitEntryPoints(const Program& program,
+                      VectorRef<std::string> entry_points,
+                      uint32_t jobs,
+                      const SplitEntryPointsCallback& callback);
+
+}  // namespace tint::writer
+
+#endif  // SRC_TINT_LANG_WGSL_HELPERS_SPLIT_ENTRY_POINTS_H_
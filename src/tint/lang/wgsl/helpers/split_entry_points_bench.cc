@@ -0,0 +1,93 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <string>
+
+#include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/wgsl/helpers/split_entry_points.h"
+
+namespace tint::writer {
+namespace {
+
+/// @returns a WGSL module with `count` compute entry points that share a set of helper functions
+std::string MultipleEntryPointsWGSL(int64_t count) {
+    std::string wgsl = R"(
+@group(0) @binding(0) var<storage, read_write> data : array<vec4f>;
+
+fn hash(v : u32) -> u32 {
+  var x = v;
+  x ^= x >> 16u;
+  x *= 0x7feb352du;
+  x ^= x >> 15u;
+  x *= 0x846ca68bu;
+  return x ^ (x >> 16u);
+}
+
+fn shade(p : vec4f, seed : u32) -> vec4f {
+  var c = p;
+  for (var i = 0u; i < 8u; i++) {
+    let h = f32(hash(seed + i)) / 4294967296.0;
+    c = mix(c, vec4f(sin(c.x * h), cos(c.y * h), tan(c.z + h), c.w), 0.5);
+  }
+  return normalize(c);
+}
+)";
+    for (int64_t i = 0; i < count; i++) {
+        auto n = std::to_string(i);
+        wgsl += "@compute @workgroup_size(64)\nfn main" + n +
+                "(@builtin(global_invocation_id) id : vec3u) {\n"
+                "  let v = shade(data[id.x], " +
+                n +
+                "u);\n"
+                "  if (v.x > 0.5) { data[id.x] = v; } else { data[id.x] = v.wzyx; }\n"
+                "}\n";
+    }
+    return wgsl;
+}
+
+void SplitEntryPointsAndGenerateWGSL(benchmark::State& state) {
+    Source::File file("multiple_entry_points.wgsl", MultipleEntryPointsWGSL(state.range(0)));
+    Program program = wgsl::reader::Parse(&file);
+    if (!program.IsValid()) {
+        state.SkipWithError(program.Diagnostics().str().c_str());
+        return;
+    }
+    Vector<std::string, 32> entry_points;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        entry_points.Push("main" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        std::atomic<bool> failed{false};
+        SplitEntryPoints(program, entry_points, static_cast<uint32_t>(state.range(1)),
+                         [&](size_t, const Program& single) {
+                             auto result = wgsl::writer::Generate(&single, {});
+                             if (!result) {
+                                 failed = true;
+                             }
+                         });
+        if (failed) {
+            state.SkipWithError("failed to generate an entry point");
+        }
+    }
+}
+
+BENCHMARK(SplitEntryPointsAndGenerateWGSL)
+    ->ArgNames({"entry_points", "jobs"})
+    ->ArgsProduct({{32}, {1, 2, 4, 8}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace tint::writer
@@ -0,0 +1,100 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/lang/wgsl/helpers/split_entry_points.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/inspector/inspector.h"
+#include "src/tint/lang/wgsl/program/program_builder.h"
+#include "src/tint/lang/wgsl/resolver/resolve.h"
+
+namespace tint::writer {
+namespace {
+
+using namespace tint::number_suffixes;  // NOLINT
+
+class SplitEntryPointsTest : public ::testing::TestWithParam<uint32_t> {
+  protected:
+    /// Builds a program with `count` compute entry points, each using its own storage buffer.
+    Program BuildProgram(uint32_t count) {
+        ProgramBuilder b;
+        for (uint32_t i = 0; i < count; i++) {
+            auto buffer = "buffer" + std::to_string(i);
+            b.GlobalVar(buffer, b.ty.u32(), core::AddressSpace::kStorage, core::Access::kReadWrite,
+                        b.Group(0_a), b.Binding(AInt(i)));
+            b.Func("main" + std::to_string(i), tint::Empty, b.ty.void_(),
+                   tint::Vector{b.Assign(buffer, u32(i))},
+                   tint::Vector{b.Stage(ast::PipelineStage::kCompute), b.WorkgroupSize(1_a)});
+        }
+        return Program(resolver::Resolve(b));
+    }
+};
+
+TEST_P(SplitEntryPointsTest, EachEntryPointIsSplit) {
+    constexpr uint32_t kCount = 16;
+    Program program = BuildProgram(kCount);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics().str();
+
+    tint::Vector<std::string, kCount> entry_points;
+    for (uint32_t i = 0; i < kCount; i++) {
+        entry_points.Push("main" + std::to_string(i));
+    }
+
+    std::mutex mutex;
+    std::vector<uint32_t> calls(kCount, 0);
+    std::vector<std::vector<inspector::ResourceBinding>> bindings(kCount);
+    SplitEntryPoints(program, entry_points, GetParam(), [&](size_t index, const Program& single) {
+        ASSERT_TRUE(single.IsValid()) << single.Diagnostics().str();
+        inspector::Inspector inspector(&single);
+        auto single_entry_points = inspector.GetEntryPoints();
+        ASSERT_EQ(single_entry_points.size(), 1u);
+        EXPECT_EQ(single_entry_points[0].name, entry_points[index]);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        calls[index]++;
+        bindings[index] = inspector.GetResourceBindings(entry_points[index]);
+    });
+
+    for (uint32_t i = 0; i < kCount; i++) {
+        EXPECT_EQ(calls[i], 1u);
+        ASSERT_EQ(bindings[i].size(), 1u);
+        EXPECT_EQ(bindings[i][0].binding, i);
+    }
+}
+
+TEST_P(SplitEntryPointsTest, UnknownEntryPoint) {
+    Program program = BuildProgram(2);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics().str();
+
+    tint::Vector<std::string, 3> entry_points{"main0", "unknown", "main1"};
+    std::mutex mutex;
+    std::vector<bool> valid(entry_points.Length());
+    SplitEntryPoints(program, entry_points, GetParam(), [&](size_t index, const Program& single) {
+        std::lock_guard<std::mutex> lock(mutex);
+        valid[index] = single.IsValid();
+    });
+
+    EXPECT_TRUE(valid[0]);
+    EXPECT_FALSE(valid[1]);
+    EXPECT_TRUE(valid[2]);
+}
+
+INSTANTIATE_TEST_SUITE_P(Jobs, SplitEntryPointsTest, testing::Values(0u, 1u, 4u));
+
+}  // namespace
+}  // namespace tint::writer
@@ -0,0 +1,78 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/wgsl/reader/parser/lexer.h"
+#include "src/tint/utils/text/string_stream.h"
+
+namespace tint::wgsl::reader {
+namespace {
+
+void LexWGSL(benchmark::State& state, std::string input_name) {
+    auto res = bench::LoadInputFile(input_name);
+    if (auto err = std::get_if<bench::Error>(&res)) {
+        state.SkipWithError(err->msg.c_str());
+        return;
+    }
+    auto& file = std::get<Source::File>(res);
+    for (auto _ : state) {
+        Lexer l(&file);
+        auto tokens = l.Lex();
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file.content.data.size()));
+}
+
+TINT_BENCHMARK_PROGRAMS(LexWGSL);
+
+/// @returns a large ASCII shader, in the style of generated code: long identifiers, indentation,
+/// comments and many numeric literals.
+std::string GenerateLargeASCIIShader(size_t function_count) {
+    StringStream wgsl;
+    for (size_t i = 0; i < function_count; i++) {
+        wgsl << "// Generated function " << i << ", which accumulates a table of constants.\n";
+        wgsl << "/* Block comments are skipped too, including ones with * and / characters. */\n";
+        wgsl << "fn generated_function_with_a_long_name_" << i
+             << "(input_value_parameter : f32) -> f32 {\n";
+        wgsl << "        var accumulated_result_value = 0.0;\n";
+        for (size_t j = 0; j < 16; j++) {
+            wgsl << "        accumulated_result_value = accumulated_result_value * "
+                 << (i * 16 + j) << ".0625 + input_value_parameter * " << (j + 1) << "e-3;\n";
+        }
+        wgsl << "        return accumulated_result_value;\n";
+        wgsl << "}\n\n";
+    }
+    return wgsl.str();
+}
+
+// Measures only the lexing of a large generated ASCII shader.
+void LexLargeASCIIWGSL(benchmark::State& state) {
+    Source::File file("large.wgsl", GenerateLargeASCIIShader(2000));
+    for (auto _ : state) {
+        Lexer l(&file);
+        auto tokens = l.Lex();
+        if (tokens.back().IsError()) {
+            state.SkipWithError(tokens.back().to_str().c_str());
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file.content.data.size()));
+}
+
+BENCHMARK(LexLargeASCIIWGSL);
+
+}  // namespace
+}  // namespace tint::wgsl::reader
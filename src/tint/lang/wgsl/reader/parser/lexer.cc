@@ -14,6 +14,7 @@
 
 #include "src/tint/lang/wgsl/reader/parser/lexer.h"
 
+#include <algorithm>
 #include <cctype>
 #include <charconv>
 #include <cmath>
@@ -28,6 +29,7 @@
 #include "src/tint/lang/core/number.h"
 #include "src/tint/utils/ice/ice.h"
 #include "src/tint/utils/strconv/parse_num.h"
+#include "src/tint/utils/text/ascii_scan.h"
 #include "src/tint/utils/text/unicode.h"
 
 namespace tint::wgsl::reader {
@@ -43,6 +45,11 @@ static_assert(sizeof(decltype(tint::Source::FileContent::data[0])) == sizeof(uin
 // programs and being a bit bigger then those need (atan2-const-eval is the outlier here).
 static constexpr size_t kDefaultListSize = 4092;
 
+// Large generated shaders have a token for every ~8 bytes of source. The list for large sources is
+// reserved assuming half as many tokens, which avoids most of the reallocations of the list
+// without reserving much more memory than needed for sources with long comments or identifiers.
+static constexpr size_t kSourceBytesPerToken = 16;
+
 bool read_blankspace(std::string_view str, size_t i, bool* is_blankspace, size_t* blankspace_size) {
     // See https://www.w3.org/TR/WGSL/#blankspace
 
@@ -96,7 +103,7 @@ Lexer::~Lexer() = default;
 
 std::vector<Token> Lexer::Lex() {
     std::vector<Token> tokens;
-    tokens.reserve(kDefaultListSize);
+    tokens.reserve(std::max(kDefaultListSize, file_->content.data.size() / kSourceBytesPerToken));
 
     while (true) {
         tokens.emplace_back(next());
@@ -173,20 +180,24 @@ Token Lexer::next() {
         return std::move(t.value());
     }
 
-    if (auto t = try_hex_float(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+    // Numeric literals start with a digit or a '.', so identifiers and keywords, which are most of
+    // the tokens, don't need to attempt to parse them.
+    if (!ascii::IsIdentifierStart(at(pos()))) {
+        if (auto t = try_hex_float(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_hex_integer(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+        if (auto t = try_hex_integer(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_float(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
-    }
+        if (auto t = try_float(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
 
-    if (auto t = try_integer(); t.has_value() && !t->IsUninitialized()) {
-        return std::move(t.value());
+        if (auto t = try_integer(); t.has_value() && !t->IsUninitialized()) {
+            return std::move(t.value());
+        }
     }
 
     if (auto t = try_ident(); t.has_value() && !t->IsUninitialized()) {
@@ -248,6 +259,15 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
                 continue;
             }
 
+            // Fast path for ASCII blankspace, which doesn't need UTF-8 decoding.
+            if (auto end = ascii::SkipBlankspace(line(), pos()); end != pos()) {
+                set_pos(end);
+                continue;
+            }
+            if (ascii::IsASCII(at(pos()))) {
+                break;
+            }
+
             bool is_blankspace;
             size_t blankspace_size;
             if (!read_blankspace(line(), pos(), &is_blankspace, &blankspace_size)) {
@@ -281,12 +301,12 @@ std::optional<Token> Lexer::skip_blankspace_and_comments() {
 std::optional<Token> Lexer::skip_comment() {
     if (matches(pos(), "//")) {
         // Line comment: ignore everything until the end of line.
-        while (!is_eol()) {
-            if (is_null()) {
-                return Token{Token::Type::kError, begin_source(), "null character found"};
-            }
-            advance();
+        auto null_pos = line().find('\0', pos());
+        if (null_pos != std::string_view::npos) {
+            set_pos(null_pos);
+            return Token{Token::Type::kError, begin_source(), "null character found"};
         }
+        set_pos(length());
         return {};
     }
 
@@ -315,8 +335,8 @@ std::optional<Token> Lexer::skip_comment() {
             } else if (is_null()) {
                 return Token{Token::Type::kError, begin_source(), "null character found"};
             } else {
-                // Anything else: skip and update source location.
-                advance();
+                // Anything else: skip to the next character that may start or end a comment.
+                set_pos(ascii::FindFirstOf(line(), pos() + 1, '/', '*', '\0'));
             }
         }
         if (depth > 0) {
@@ -334,13 +354,13 @@ std::optional<Token> Lexer::try_float() {
     bool has_mantissa_digits = false;
 
     std::optional<size_t> first_significant_digit_position;
-    while (end < length() && is_digit(at(end))) {
-        if (!first_significant_digit_position.has_value() && (at(end) != '0')) {
-            first_significant_digit_position = end;
+    if (auto digits_end = ascii::SkipDigits(line(), end); digits_end != end) {
+        if (auto nonzero = line().find_first_not_of('0', end); nonzero < digits_end) {
+            first_significant_digit_position = nonzero;
         }
 
         has_mantissa_digits = true;
-        end++;
+        end = digits_end;
     }
 
     std::optional<size_t> dot_position;
@@ -350,17 +370,17 @@ std::optional<Token> Lexer::try_float() {
     }
 
     size_t zeros_before_digit = 0;
-    while (end < length() && is_digit(at(end))) {
+    if (auto digits_end = ascii::SkipDigits(line(), end); digits_end != end) {
         if (!first_significant_digit_position.has_value()) {
-            if (at(end) == '0') {
-                zeros_before_digit += 1;
-            } else {
-                first_significant_digit_position = end;
+            auto nonzero = std::min(line().find_first_not_of('0', end), digits_end);
+            zeros_before_digit = nonzero - end;
+            if (nonzero < digits_end) {
+                first_significant_digit_position = nonzero;
             }
         }
 
         has_mantissa_digits = true;
-        end++;
+        end = digits_end;
     }
 
     if (!has_mantissa_digits) {
@@ -378,11 +398,9 @@ std::optional<Token> Lexer::try_float() {
         }
         exponent_value_position = end;
 
-        bool has_digits = false;
-        while (end < length() && isdigit(at(end))) {
-            has_digits = true;
-            end++;
-        }
+        auto digits_end = ascii::SkipDigits(line(), end);
+        bool has_digits = digits_end != end;
+        end = digits_end;
 
         // If an 'e' or 'E' was present, then the number part must also be present.
         if (!has_digits) {
@@ -965,8 +983,18 @@ std::optional<Token> Lexer::try_ident() {
     auto source = begin_source();
     auto start = pos();
 
-    // Must begin with an XID_Source unicode character, or underscore
-    {
+    // ASCII characters are checked directly, without UTF-8 decoding and XID lookups.
+    if (ascii::IsASCII(at(pos()))) {
+        if (!ascii::IsIdentifierStart(at(pos()))) {
+            return {};
+        }
+        if (matches(start, "__")) {
+            // Identifiers prefixed with two or more underscores are not allowed.
+            return {};
+        }
+        advance();
+    } else {
+        // Must begin with an XID_Source unicode character, or underscore
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, length() - pos());
         if (n == 0) {
@@ -981,6 +1009,15 @@ std::optional<Token> Lexer::try_ident() {
     }
 
     while (!is_eol()) {
+        if (ascii::IsASCII(at(pos()))) {
+            auto end = ascii::SkipIdentifierContinue(line(), pos());
+            if (end == pos()) {
+                break;
+            }
+            set_pos(end);
+            continue;
+        }
+
         // Must continue with an XID_Continue unicode character
         auto* utf8 = reinterpret_cast<const uint8_t*>(&at(pos()));
         auto [code_point, n] = tint::utf8::Decode(utf8, line().size() - pos());
@@ -994,14 +1031,6 @@ std::optional<Token> Lexer::try_ident() {
 
         // Consume continuing codepoint
         advance(n);
-
-        if (pos() - start == 2 && substr(start, 2) == "__") {
-            // Identifiers prefixed with two or more underscores are not allowed.
-            // We check for these in the loop to bail early and prevent quadratic parse time for
-            // long sequences of ____.
-            set_pos(start);
-            return {};
-        }
     }
 
     auto str = substr(start, pos() - start);
@@ -261,6 +261,30 @@ text */ident)");
     }
 }
 
+TEST_F(LexerTest, Skips_Comments_Block_Long) {
+    Source::File file("", R"(/* a long comment, with * and / that don't end it, nor start a
+nested comment, and which spans lines longer than a vector register ** // */ident)");
+    Lexer l(&file);
+
+    auto list = l.Lex();
+    ASSERT_EQ(2u, list.size());
+
+    {
+        auto& t = list[0];
+        EXPECT_TRUE(t.IsIdentifier());
+        EXPECT_EQ(t.source().range.begin.line, 2u);
+        EXPECT_EQ(t.source().range.begin.column, 77u);
+        EXPECT_EQ(t.source().range.end.line, 2u);
+        EXPECT_EQ(t.source().range.end.column, 82u);
+        EXPECT_EQ(t.to_str(), "ident");
+    }
+
+    {
+        auto& t = list[1];
+        EXPECT_TRUE(t.IsEof());
+    }
+}
+
 TEST_F(LexerTest, Skips_Comments_Block_Nested) {
     Source::File file("", R"(/* comment
 text // nested line comments are ignored /* more text
@@ -620,7 +644,8 @@ INSTANTIATE_TEST_SUITE_P(LexerTest,
                                          "MiXeD_CaSe",
                                          "abcdefghijklmnopqrstuvwxyz",
                                          "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
-                                         "alldigits_0123456789"));
+                                         "alldigits_0123456789",
+                                         "an_identifier_longer_than_a_vector_0123456789"));
 
 struct UnicodeCase {
     const char* utf8;
@@ -679,6 +704,10 @@ INSTANTIATE_TEST_SUITE_P(
                     "\xf0\x9d\x96\x99\xf0\x9d\x96\x8e\xf0\x9d\x96\x8b\xf0\x9d\x96\x8e"
                     "\xf0\x9d\x96\x8a\xf0\x9d\x96\x97\x31\x32\x33",
                     43},
+        UnicodeCase{// "ascii_prefix_before_𝐢𝐝_and_ascii_suffix"
+                    "ascii_prefix_before_\xf0\x9d\x90\xa2\xf0\x9d\x90\x9d"
+                    "_and_ascii_suffix",
+                    45},
     }));
 
 using InvalidUnicodeIdentifierTest = testing::TestWithParam<const char*>;
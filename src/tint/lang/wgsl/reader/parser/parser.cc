@@ -14,7 +14,13 @@
 
 #include "src/tint/lang/wgsl/reader/parser/parser.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "src/tint/lang/core/attribute.h"
 #include "src/tint/lang/core/type/depth_texture.h"
@@ -40,6 +46,7 @@
 #include "src/tint/lang/wgsl/ast/unary_op_expression.h"
 #include "src/tint/lang/wgsl/ast/variable_decl_statement.h"
 #include "src/tint/lang/wgsl/ast/workgroup_attribute.h"
+#include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/reader/parser/classify_template_args.h"
 #include "src/tint/lang/wgsl/reader/parser/lexer.h"
 #include "src/tint/utils/containers/reverse.h"
@@ -314,14 +321,126 @@ void Parser::InitializeLex() {
 
 bool Parser::Parse() {
     InitializeLex();
-    translation_unit();
+    if (jobs_ != 1) {
+        ParseInParallel();
+    } else {
+        translation_unit();
+    }
     return !has_error();
 }
 
+void Parser::ParseInParallel() {
+    // Shards smaller than this aren't worth the cost of merging them into the builder.
+    constexpr size_t kMinTokensPerShard = 4096;
+    // Use more shards than threads, as the cost of the declarations varies widely.
+    constexpr size_t kShardsPerJob = 4;
+
+    // The global directives must precede all the global declarations, parse them first.
+    while (continue_parsing() && !peek().IsEof()) {
+        if (!global_directive(/* have_parsed_decl */ false).matched) {
+            break;
+        }
+    }
+
+    const uint32_t jobs = jobs_ == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : jobs_;
+    const size_t first = next_token_idx_;
+    const size_t eof = tokens_.size() - 1;
+    if (has_error() || jobs == 1 || !tokens_[eof].IsEof() ||
+        eof - first < 2 * kMinTokensPerShard) {
+        translation_unit();
+        return;
+    }
+
+    // Split the tokens at the end of top-level declarations: the semicolons and closing braces
+    // that aren't nested in braces.
+    const size_t shard_size = std::max(kMinTokensPerShard, (eof - first) / (jobs * kShardsPerJob));
+    std::vector<size_t> shard_ends;
+    size_t shard_start = first;
+    size_t depth = 0;
+    for (size_t i = first; i < eof; i++) {
+        auto type = tokens_[i].type();
+        if (type == Token::Type::kBraceLeft) {
+            depth++;
+        } else if (type == Token::Type::kBraceRight && depth > 0) {
+            depth--;
+        }
+        bool is_decl_end = type == Token::Type::kSemicolon || type == Token::Type::kBraceRight;
+        if (depth == 0 && is_decl_end && i + 1 - shard_start >= shard_size) {
+            shard_ends.push_back(i + 1);
+            shard_start = i + 1;
+        }
+    }
+    if (shard_start != eof) {
+        shard_ends.push_back(eof);
+    }
+    if (shard_ends.size() < 2) {
+        translation_unit();
+        return;
+    }
+
+    std::vector<std::unique_ptr<Parser>> shards;
+    shard_start = first;
+    for (size_t shard_end : shard_ends) {
+        auto shard = std::make_unique<Parser>(file_);
+        shard->is_shard_ = true;
+        shard->max_errors_ = max_errors_;
+        shard->tokens_.reserve(shard_end - shard_start + 1);
+        std::move(tokens_.begin() + static_cast<ptrdiff_t>(shard_start),
+                  tokens_.begin() + static_cast<ptrdiff_t>(shard_end),
+                  std::back_inserter(shard->tokens_));
+        shard->tokens_.emplace_back(Token::Type::kEOF, tokens_[shard_end].source());
+        shards.push_back(std::move(shard));
+        shard_start = shard_end;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < shards.size(); i = next++) {
+            shards[i]->translation_unit();
+        }
+    };
+    std::vector<std::thread> threads;
+    const size_t num_threads = std::min<size_t>(jobs, shards.size());
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Recovering from errors depends on the surrounding tokens, so parse erroneous inputs again
+    // sequentially to report the same diagnostics as without jobs.
+    for (auto& shard : shards) {
+        if (shard->has_error()) {
+            builder_ = ProgramBuilder{};
+            next_token_idx_ = 0;
+            last_source_idx_ = 0;
+            synchronized_ = true;
+            InitializeLex();
+            translation_unit();
+            return;
+        }
+    }
+
+    for (auto& shard : shards) {
+        Program program(std::move(shard->builder_));
+        builder_.Diagnostics().add(program.Diagnostics());
+        // The shards name the same builtins and declarations, so their symbols are registered by
+        // name instead of being made unique.
+        program::CloneContext ctx(&builder_, &program, /* auto_clone_symbols */ false);
+        ctx.ReplaceAll([&](Symbol symbol) { return builder_.Symbols().Register(symbol.Name()); });
+        for (auto* decl : program.AST().GlobalDeclarations()) {
+            builder_.AST().AddGlobalDeclaration(ctx.Clone(decl));
+        }
+    }
+}
+
 // translation_unit
 //  : global_directive* global_decl* EOF
 void Parser::translation_unit() {
-    bool after_global_decl = false;
+    bool after_global_decl = is_shard_;
     while (continue_parsing()) {
         auto& p = peek();
         if (p.IsEof()) {
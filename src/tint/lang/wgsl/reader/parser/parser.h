@@ -309,6 +309,13 @@ class Parser {
     /// parsing.
     size_t get_max_errors() const { return max_errors_; }
 
+    /// set_jobs sets the number of threads used by Parse(). With more than one job, the tokens
+    /// of the global declarations are split into shards that are parsed concurrently, and merged
+    /// into the program builder in declaration order. Inputs with parse errors are parsed again
+    /// sequentially, so the diagnostics do not depend on the number of jobs.
+    /// @param jobs the number of threads, 0 uses one thread per hardware thread.
+    void set_jobs(uint32_t jobs) { jobs_ = jobs; }
+
     /// @returns true if an error was encountered.
     bool has_error() const { return builder_.Diagnostics().contains_errors(); }
 
@@ -867,6 +874,10 @@ class Parser {
     Maybe<const ast::Statement*> for_header_initializer();
     Maybe<const ast::Statement*> for_header_continuing();
 
+    /// Parses the global directives, then the global declarations split into shards parsed on
+    /// up to `jobs_` threads.
+    void ParseInParallel();
+
     class MultiTokenSource;
     MultiTokenSource make_source_range();
     MultiTokenSource make_source_range_from(const Source& start);
@@ -890,6 +901,10 @@ class Parser {
     int silence_diags_ = 0;
     ProgramBuilder builder_;
     size_t max_errors_ = 25;
+    uint32_t jobs_ = 1;
+    /// True for the parsers of the shards of ParseInParallel(), whose tokens only contain global
+    /// declarations.
+    bool is_shard_ = false;
 };
 
 }  // namespace tint::wgsl::reader
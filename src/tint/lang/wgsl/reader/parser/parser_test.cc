@@ -14,6 +14,8 @@
 
 #include "src/tint/lang/wgsl/reader/parser/helper_test.h"
 
+#include "src/tint/utils/text/string_stream.h"
+
 namespace tint::wgsl::reader {
 namespace {
 
@@ -199,5 +201,78 @@ TEST_F(WGSLParserTest, Peek_AfterSplit) {
     EXPECT_TRUE(p->peek_is(Token::Type::kEqual)) << "expected: = got: " << p->peek().to_name();
 }
 
+// Returns a module with enough top-level declarations for Parser::set_jobs() to split it into
+// several shards. The function with index |error_at| is made invalid.
+std::string LargeModule(size_t error_at = ~0u) {
+    StringStream ss;
+    ss << "enable f16;\n";
+    for (size_t i = 0; i < 400; i++) {
+        ss << "struct S" << i << " { a : f32, b : vec4<f16>, }\n";
+        ss << "const c" << i << " = array(1, 2, 3, " << i << ");\n";
+        ss << "fn f" << i << "(s : S" << i << ") -> f32 {\n";
+        ss << "  var x = s.a + f32(c" << i << "[1]);\n";
+        ss << "  if (x > 1.0) { x = 2.0; } else { x = 3.0; }\n";
+        ss << "  return " << (i == error_at ? "x +" : "x") << ";\n";
+        ss << "}\n";
+    }
+    return ss.str();
+}
+
+TEST_F(WGSLParserTest, Parallel_MatchesSequential) {
+    auto source = LargeModule();
+
+    auto sequential = parser(source);
+    ASSERT_TRUE(sequential->Parse()) << sequential->error();
+    Program expected = sequential->program();
+
+    auto parallel = parser(source);
+    parallel->set_jobs(4);
+    ASSERT_TRUE(parallel->Parse()) << parallel->error();
+    Program got = parallel->program();
+
+    ASSERT_EQ(got.AST().Enables().Length(), expected.AST().Enables().Length());
+    ASSERT_EQ(got.AST().GlobalDeclarations().Length(),
+              expected.AST().GlobalDeclarations().Length());
+    ASSERT_EQ(got.AST().Functions().Length(), 400u);
+    ASSERT_EQ(got.AST().TypeDecls().Length(), 400u);
+    ASSERT_EQ(got.AST().GlobalVariables().Length(), 400u);
+    for (size_t i = 0; i < expected.AST().GlobalDeclarations().Length(); i++) {
+        auto* e = expected.AST().GlobalDeclarations()[i];
+        auto* g = got.AST().GlobalDeclarations()[i];
+        EXPECT_EQ(g->TypeInfo().name, e->TypeInfo().name);
+        EXPECT_EQ(g->source.range, e->source.range);
+    }
+    for (size_t i = 0; i < expected.AST().Functions().Length(); i++) {
+        auto* e = expected.AST().Functions()[i];
+        auto* g = got.AST().Functions()[i];
+        EXPECT_EQ(g->name->symbol.Name(), e->name->symbol.Name());
+        EXPECT_EQ(g->body->statements.Length(), e->body->statements.Length());
+    }
+}
+
+TEST_F(WGSLParserTest, Parallel_ErrorMatchesSequential) {
+    auto source = LargeModule(/* error_at */ 321);
+
+    auto sequential = parser(source);
+    ASSERT_FALSE(sequential->Parse());
+
+    auto parallel = parser(source);
+    parallel->set_jobs(4);
+    ASSERT_FALSE(parallel->Parse());
+    EXPECT_EQ(parallel->error(), sequential->error());
+}
+
+TEST_F(WGSLParserTest, Parallel_DirectiveAfterDeclaration) {
+    auto source = LargeModule() + "enable f16;\n" + LargeModule();
+
+    auto sequential = parser(source);
+    ASSERT_FALSE(sequential->Parse());
+
+    auto parallel = parser(source);
+    parallel->set_jobs(4);
+    ASSERT_FALSE(parallel->Parse());
+    EXPECT_EQ(parallel->error(), sequential->error());
+}
+
 }  // namespace
 }  // namespace tint::wgsl::reader
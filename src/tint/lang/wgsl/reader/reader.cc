@@ -22,7 +22,12 @@
 namespace tint::wgsl::reader {
 
 Program Parse(Source::File const* file) {
+    return Parse(file, Options{});
+}
+
+Program Parse(Source::File const* file, const Options& options) {
     Parser parser(file);
+    parser.set_jobs(options.jobs);
     parser.Parse();
     return resolver::Resolve(parser.builder());
 }
@@ -19,6 +19,13 @@
 
 namespace tint::wgsl::reader {
 
+/// Configuration options used for reading WGSL.
+struct Options {
+    /// The number of threads used to parse the global declarations. Only large sources are
+    /// split between threads. 0 uses one thread per hardware thread.
+    uint32_t jobs = 1;
+};
+
 /// Parses the WGSL source, returning the parsed program.
 /// If the source fails to parse then the returned
 /// `program.Diagnostics.contains_errors()` will be true, and the
@@ -27,6 +34,12 @@ namespace tint::wgsl::reader {
 /// @returns the parsed program
 Program Parse(Source::File const* file);
 
+/// Parses the WGSL source with the given options, returning the parsed program.
+/// @param file the source file
+/// @param options the configuration options to use when parsing WGSL
+/// @returns the parsed program
+Program Parse(Source::File const* file, const Options& options);
+
 }  // namespace tint::wgsl::reader
 
 #endif  // SRC_TINT_LANG_WGSL_READER_READER_H_
@@ -15,6 +15,8 @@
 #include <string>
 
 #include "src/tint/bench/benchmark.h"
+#include "src/tint/lang/wgsl/reader/parser/parser.h"
+#include "src/tint/utils/text/string_stream.h"
 
 namespace tint::wgsl::reader {
 namespace {
@@ -36,5 +38,41 @@ void ParseWGSL(benchmark::State& state, std::string input_name) {
 
 TINT_BENCHMARK_PROGRAMS(ParseWGSL);
 
+/// @returns a large generated shader, made of many functions using large constant tables.
+std::string GenerateLargeShader(size_t function_count) {
+    StringStream wgsl;
+    wgsl << "struct S {\n  a : vec4f,\n  b : array<u32, 4>,\n}\n";
+    for (size_t i = 0; i < function_count; i++) {
+        wgsl << "const table_" << i << " = array<f32, 32>(";
+        for (size_t j = 0; j < 32; j++) {
+            wgsl << (j == 0 ? "" : ", ") << (i * 32 + j) << ".5";
+        }
+        wgsl << ");\n";
+        wgsl << "fn f_" << i << "(x : f32, s : S) -> f32 {\n";
+        wgsl << "  var sum = 0.0;\n";
+        wgsl << "  for (var i = 0u; i < 32u; i++) {\n";
+        wgsl << "    sum += table_" << i << "[i] * x + s.a.x * f32(s.b[i % 4u]);\n";
+        wgsl << "  }\n";
+        wgsl << "  return select(sum, x, sum > 3.0);\n";
+        wgsl << "}\n";
+    }
+    return wgsl.str();
+}
+
+// Measures only the parsing (without resolving) of a large shader, with state.range(0) jobs.
+void ParseLargeWGSL(benchmark::State& state) {
+    Source::File file("large.wgsl", GenerateLargeShader(4000));
+    for (auto _ : state) {
+        Parser parser(&file);
+        parser.set_jobs(static_cast<uint32_t>(state.range(0)));
+        if (!parser.Parse()) {
+            state.SkipWithError(parser.error().c_str());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * file.content.data.size()));
+}
+
+BENCHMARK(ParseLargeWGSL)->ArgName("jobs")->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
 }  // namespace
 }  // namespace tint::wgsl::reader
@@ -2455,8 +2455,8 @@ sem::Call* Resolver::BuiltinCall(const ast::CallExpression* expr,
             return nullptr;
         }
         auto const_eval_fn = overload->const_eval_fn;
-        if (auto r = (const_eval_.*const_eval_fn)(target->ReturnType(), const_args.Get(),
-                                                  expr->source)) {
+        if (auto r = const_eval_.Call(const_eval_fn, target->ReturnType(), const_args.Get(),
+                                      expr->source)) {
             value = r.Get();
         } else {
             return nullptr;
@@ -0,0 +1,197 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/utils/text/ascii_scan.h"
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TINT_ASCII_SCAN_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TINT_ASCII_SCAN_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TINT_ASCII_SCAN_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace tint::ascii {
+namespace {
+
+/// @param bits a non-zero value
+/// @returns the number of trailing zero bits of `bits`
+[[maybe_unused]] inline uint32_t CountTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    if (_BitScanForward(&index, static_cast<unsigned long>(bits))) {
+        return index;
+    }
+    _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+    return index + 32;
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+#if TINT_ASCII_SCAN_AVX2
+
+/// Vector operations on 32 bytes, using AVX2.
+struct Simd {
+    using Vec = __m256i;
+    static constexpr size_t kWidth = 32;
+
+    static Vec Load(const char* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const Vec*>(ptr));
+    }
+    static Vec Splat(char ch) { return _mm256_set1_epi8(ch); }
+    static Vec Eq(Vec v, char ch) { return _mm256_cmpeq_epi8(v, Splat(ch)); }
+    static Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static Vec Not(Vec v) { return _mm256_xor_si256(v, Splat(-1)); }
+    // The comparisons are signed, so non-ASCII bytes are negative and below `lo`.
+    static Vec InRange(Vec v, char lo, char hi) {
+        return Not(Or(_mm256_cmpgt_epi8(Splat(lo), v), _mm256_cmpgt_epi8(v, Splat(hi))));
+    }
+    static size_t LeadingMatches(Vec matches) {
+        uint32_t misses = ~static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+        return misses == 0 ? kWidth : CountTrailingZeros(misses);
+    }
+};
+
+#elif TINT_ASCII_SCAN_SSE2
+
+/// Vector operations on 16 bytes, using SSE2.
+struct Simd {
+    using Vec = __m128i;
+    static constexpr size_t kWidth = 16;
+
+    static Vec Load(const char* ptr) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(ptr)); }
+    static Vec Splat(char ch) { return _mm_set1_epi8(ch); }
+    static Vec Eq(Vec v, char ch) { return _mm_cmpeq_epi8(v, Splat(ch)); }
+    static Vec Or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static Vec Not(Vec v) { return _mm_xor_si128(v, Splat(-1)); }
+    // The comparisons are signed, so non-ASCII bytes are negative and below `lo`.
+    static Vec InRange(Vec v, char lo, char hi) {
+        return Not(Or(_mm_cmplt_epi8(v, Splat(lo)), _mm_cmpgt_epi8(v, Splat(hi))));
+    }
+    static size_t LeadingMatches(Vec matches) {
+        uint32_t misses = ~static_cast<uint32_t>(_mm_movemask_epi8(matches)) & 0xffffu;
+        return misses == 0 ? kWidth : CountTrailingZeros(misses);
+    }
+};
+
+#elif TINT_ASCII_SCAN_NEON
+
+/// Vector operations on 16 bytes, using NEON.
+struct Simd {
+    using Vec = uint8x16_t;
+    static constexpr size_t kWidth = 16;
+
+    static Vec Load(const char* ptr) { return vld1q_u8(reinterpret_cast<const uint8_t*>(ptr)); }
+    static Vec Splat(char ch) { return vdupq_n_u8(static_cast<uint8_t>(ch)); }
+    static Vec Eq(Vec v, char ch) { return vceqq_u8(v, Splat(ch)); }
+    static Vec Or(Vec a, Vec b) { return vorrq_u8(a, b); }
+    static Vec Not(Vec v) { return vmvnq_u8(v); }
+    // The comparisons are unsigned, so non-ASCII bytes are above `hi`.
+    static Vec InRange(Vec v, char lo, char hi) {
+        return vandq_u8(vcgeq_u8(v, Splat(lo)), vcleq_u8(v, Splat(hi)));
+    }
+    static size_t LeadingMatches(Vec matches) {
+        // Narrow each byte of the mask to 4 bits, giving a 64-bit mask with a nibble per byte.
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        uint64_t misses = ~vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+        return misses == 0 ? kWidth : CountTrailingZeros(misses) / 4;
+    }
+};
+
+#else
+
+/// Scalar fallback, with a "vector" of a single byte.
+struct Simd {
+    static constexpr size_t kWidth = 1;
+
+    static char Load(const char* ptr) { return *ptr; }
+    static char Splat(char ch) { return ch; }
+    static bool Eq(char v, char ch) { return v == ch; }
+    static bool Or(bool a, bool b) { return a || b; }
+    static char Or(char a, char b) { return static_cast<char>(a | b); }
+    static bool Not(bool v) { return !v; }
+    static bool InRange(char v, char lo, char hi) { return v >= lo && v <= hi; }
+    static size_t LeadingMatches(bool matches) { return matches ? 1 : 0; }
+};
+
+#endif
+
+/// @returns the offset of the first character at or after `offset` in `str` for which `scalar`
+/// returns false. `simd` is the vector equivalent of `scalar`, used on whole vectors of `str`.
+template <typename SIMD_MATCH, typename SCALAR_MATCH>
+size_t Skip(std::string_view str,
+            size_t offset,
+            SIMD_MATCH&& simd,
+            SCALAR_MATCH&& scalar) {
+    const char* data = str.data();
+    size_t i = offset;
+    while (i + Simd::kWidth <= str.size()) {
+        size_t n = Simd::LeadingMatches(simd(Simd::Load(data + i)));
+        i += n;
+        if (n < Simd::kWidth) {
+            return i;
+        }
+    }
+    // Scan the remaining bytes that don't fill a vector.
+    while (i < str.size() && scalar(data[i])) {
+        i++;
+    }
+    return i;
+}
+
+}  // namespace
+
+size_t SkipBlankspace(std::string_view str, size_t offset) {
+    return Skip(
+        str, offset, [](auto v) { return Simd::Or(Simd::Eq(v, ' '), Simd::Eq(v, '\t')); },
+        IsBlankspace);
+}
+
+size_t SkipDigits(std::string_view str, size_t offset) {
+    return Skip(
+        str, offset, [](auto v) { return Simd::InRange(v, '0', '9'); }, IsDigit);
+}
+
+size_t SkipIdentifierContinue(std::string_view str, size_t offset) {
+    return Skip(
+        str, offset,
+        [](auto v) {
+            // Setting bit 5 maps 'A'-'Z' to 'a'-'z', and no other character to a lowercase letter.
+            auto letter = Simd::InRange(Simd::Or(v, Simd::Splat(0x20)), 'a', 'z');
+            auto digit = Simd::InRange(v, '0', '9');
+            return Simd::Or(Simd::Or(letter, digit), Simd::Eq(v, '_'));
+        },
+        IsIdentifierContinue);
+}
+
+size_t FindFirstOf(std::string_view str, size_t offset, char a, char b, char c) {
+    return Skip(
+        str, offset,
+        [&](auto v) {
+            return Simd::Not(Simd::Or(Simd::Or(Simd::Eq(v, a), Simd::Eq(v, b)), Simd::Eq(v, c)));
+        },
+        [&](char ch) { return ch != a && ch != b && ch != c; });
+}
+
+}  // namespace tint::ascii
@@ -0,0 +1,86 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SRC_TINT_UTILS_TEXT_ASCII_SCAN_H_
+#define SRC_TINT_UTILS_TEXT_ASCII_SCAN_H_
+
+#include <cstddef>
+#include <string_view>
+
+// Scanners for runs of ASCII characters of a given class. When the target supports it, these are
+// vectorized with AVX2, SSE2 or NEON and process 32 or 16 bytes at a time, otherwise they use a
+// scalar loop. Non-ASCII bytes (>= 0x80) never belong to any of the classes, so callers can use
+// them as a fast path and fall back to UTF-8 decoding where a scan stops on a non-ASCII byte.
+namespace tint::ascii {
+
+/// @param ch a character
+/// @returns true if `ch` is an ASCII space or horizontal tab
+inline bool IsBlankspace(char ch) {
+    return ch == ' ' || ch == '\t';
+}
+
+/// @param ch a character
+/// @returns true if `ch` is an ASCII decimal digit
+inline bool IsDigit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+/// @param ch a character
+/// @returns true if `ch` is an ASCII letter or an underscore
+inline bool IsIdentifierStart(char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+/// @param ch a character
+/// @returns true if `ch` is an ASCII letter, decimal digit or underscore
+inline bool IsIdentifierContinue(char ch) {
+    return IsIdentifierStart(ch) || IsDigit(ch);
+}
+
+/// @param ch a character
+/// @returns true if `ch` is an ASCII character (< 0x80)
+inline bool IsASCII(char ch) {
+    return static_cast<unsigned char>(ch) < 0x80;
+}
+
+/// @param str the string to scan
+/// @param offset the offset in `str` to start scanning from
+/// @returns the offset of the first character at or after `offset` that is not an ASCII space or
+/// horizontal tab, or `str.size()` if there is none.
+size_t SkipBlankspace(std::string_view str, size_t offset);
+
+/// @param str the string to scan
+/// @param offset the offset in `str` to start scanning from
+/// @returns the offset of the first character at or after `offset` that is not an ASCII decimal
+/// digit, or `str.size()` if there is none.
+size_t SkipDigits(std::string_view str, size_t offset);
+
+/// @param str the string to scan
+/// @param offset the offset in `str` to start scanning from
+/// @returns the offset of the first character at or after `offset` that is not an ASCII letter,
+/// decimal digit or underscore, or `str.size()` if there is none.
+size_t SkipIdentifierContinue(std::string_view str, size_t offset);
+
+/// @param str the string to scan
+/// @param offset the offset in `str` to start scanning from
+/// @param a the first character to search for
+/// @param b the second character to search for
+/// @param c the third character to search for
+/// @returns the offset of the first occurrence of `a`, `b` or `c` at or after `offset`, or
+/// `str.size()` if there is none.
+size_t FindFirstOf(std::string_view str, size_t offset, char a, char b, char c);
+
+}  // namespace tint::ascii
+
+#endif  // SRC_TINT_UTILS_TEXT_ASCII_SCAN_H_
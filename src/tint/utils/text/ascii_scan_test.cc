@@ -0,0 +1,101 @@
+// Copyright 2023 The Tint Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/tint/utils/text/ascii_scan.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tint::ascii {
+namespace {
+
+// The strings used by these tests are longer than the widest vector, so that both the vectorized
+// and the scalar parts of the scans are exercised.
+
+TEST(AsciiScanTest, SkipBlankspace) {
+    EXPECT_EQ(SkipBlankspace("", 0), 0u);
+    EXPECT_EQ(SkipBlankspace("a", 0), 0u);
+    EXPECT_EQ(SkipBlankspace("  \t a", 0), 4u);
+    EXPECT_EQ(SkipBlankspace("a  \t ", 1), 5u);
+    EXPECT_EQ(SkipBlankspace("  \n", 0), 2u);
+
+    for (size_t n = 0; n < 80; n++) {
+        std::string str(n, ' ');
+        EXPECT_EQ(SkipBlankspace(str, 0), n);
+        EXPECT_EQ(SkipBlankspace(str + "x" + std::string(40, ' '), 0), n);
+        EXPECT_EQ(SkipBlankspace(str + "\xe2\x80\x8e", 0), n);
+    }
+}
+
+TEST(AsciiScanTest, SkipDigits) {
+    EXPECT_EQ(SkipDigits("", 0), 0u);
+    EXPECT_EQ(SkipDigits("x", 0), 0u);
+    EXPECT_EQ(SkipDigits("0123456789x", 0), 10u);
+    EXPECT_EQ(SkipDigits("0x1234", 2), 6u);
+    EXPECT_EQ(SkipDigits("12/", 0), 2u);
+    EXPECT_EQ(SkipDigits("12:", 0), 2u);
+
+    for (size_t n = 0; n < 80; n++) {
+        std::string str;
+        for (size_t i = 0; i < n; i++) {
+            str += static_cast<char>('0' + (i % 10));
+        }
+        EXPECT_EQ(SkipDigits(str, 0), n);
+        EXPECT_EQ(SkipDigits(str + "." + std::string(40, '1'), 0), n);
+        EXPECT_EQ(SkipDigits(str + "\xc3\xa9" + std::string(40, '1'), 0), n);
+    }
+}
+
+TEST(AsciiScanTest, SkipIdentifierContinue) {
+    EXPECT_EQ(SkipIdentifierContinue("", 0), 0u);
+    EXPECT_EQ(SkipIdentifierContinue(" ", 0), 0u);
+    EXPECT_EQ(SkipIdentifierContinue("abc_XYZ_019 ", 0), 11u);
+    EXPECT_EQ(SkipIdentifierContinue("a.b", 0), 1u);
+
+    // Characters next to the ranges of identifier characters.
+    for (char ch : {'/', ':', '@', '[', '`', '{', '^', '\x7f', '\0'}) {
+        std::string str = std::string(40, 'a') + ch + std::string(40, 'a');
+        EXPECT_EQ(SkipIdentifierContinue(str, 0), 40u) << static_cast<int>(ch);
+    }
+
+    for (size_t n = 0; n < 80; n++) {
+        std::string str;
+        for (size_t i = 0; i < n; i++) {
+            const char kChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+            str += kChars[i % (sizeof(kChars) - 1)];
+        }
+        EXPECT_EQ(SkipIdentifierContinue(str, 0), n);
+        EXPECT_EQ(SkipIdentifierContinue(str + "(" + std::string(40, 'a'), 0), n);
+        EXPECT_EQ(SkipIdentifierContinue(str + "\xce\xb1" + std::string(40, 'a'), 0), n);
+    }
+}
+
+TEST(AsciiScanTest, FindFirstOf) {
+    EXPECT_EQ(FindFirstOf("", 0, '/', '*', '\0'), 0u);
+    EXPECT_EQ(FindFirstOf("abc", 0, '/', '*', '\0'), 3u);
+    EXPECT_EQ(FindFirstOf("ab/c", 0, '/', '*', '\0'), 2u);
+    EXPECT_EQ(FindFirstOf("ab/c*", 3, '/', '*', '\0'), 4u);
+    EXPECT_EQ(FindFirstOf(std::string_view("ab\0c", 4), 0, '/', '*', '\0'), 2u);
+
+    for (size_t n = 0; n < 80; n++) {
+        std::string str(n, 'x');
+        EXPECT_EQ(FindFirstOf(str, 0, '/', '*', '\0'), n);
+        EXPECT_EQ(FindFirstOf(str + "*" + std::string(40, '/'), 0, '/', '*', '\0'), n);
+        EXPECT_EQ(FindFirstOf(str + "\xe2\x80\x8e/", 0, '/', '*', '\0'), n + 3);
+    }
+}
+
+}  // namespace
+}  // namespace tint::ascii